@@ -2,9 +2,23 @@
 # Common optimization and warning CFLAGS for compiling all source files.
 COMMON_CFLAGS = -O3 -Wall -Wextra
 
+# Extra CFLAGS for the core library to enable SIMD kernels, for example
+# "-mavx2" or "-march=native".  The multi-lane permutations fall back to
+# portable C when no vector instruction set is enabled.  On x86, wider
+# kernels are selected at runtime unless "-DLW_NO_SIMD_DISPATCH" is given.
+# The tests are compiled with the same flags because some internal
+# structures are sized by the available kernels.
+VECTOR_CFLAGS =
+
 # Common linker flags.
 COMMON_LDFLAGS =
 
+# Flags for the optional multi-threaded code paths, such as the parallel
+# SATURNIN-CTR-Cascade functions.  Set both to empty to build without
+# POSIX threads; the parallel functions then run on the calling thread.
+THREAD_CFLAGS = -DLW_USE_PTHREADS -pthread
+THREAD_LDFLAGS = -pthread
+
 # Select the C or C++ standard to compile the core library with.
 STDC_CFLAGS = -std=c99
 STDC_CXXFLAGS = -std=c++11
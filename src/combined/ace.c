@@ -43,7 +43,13 @@ aead_cipher_t const ace_cipher = {
     ACE_TAG_SIZE,
     AEAD_FLAG_NONE,
     ace_aead_encrypt,
-    ace_aead_decrypt
+    ace_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_hash_algorithm_t const ace_hash_algorithm = {
@@ -0,0 +1,496 @@
+/*
+ * Copyright (C) 2020 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "aead-cache.h"
+#include "aead-random.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(LW_USE_PTHREADS)
+#include <pthread.h>
+#endif
+
+/**
+ * \brief Entry in a key context cache.
+ *
+ * The key context follows the entry header in memory, and the copy of
+ * the key follows the key context.
+ */
+typedef struct aead_key_cache_entry_s
+{
+    struct aead_key_cache_entry_s *chain; /**< Next entry in the bucket */
+    struct aead_key_cache_entry_s *newer; /**< Next more recently used */
+    struct aead_key_cache_entry_s *older; /**< Next less recently used */
+    const aead_cipher_t *cipher;          /**< Cipher the context is for */
+    uint64_t hash;                        /**< Hash of the cipher and key */
+    size_t size;                          /**< Total size of the entry */
+    unsigned refs;                        /**< Number of threads using it */
+    int stale;                            /**< Removed from the cache */
+
+} aead_key_cache_entry_t;
+
+/**
+ * \brief Size of the entry header, rounded up so that the key context
+ * that follows it is suitably aligned for any type.
+ */
+#define AEAD_KEY_CACHE_HEADER_SIZE \
+    ((sizeof(aead_key_cache_entry_t) + 15) & ~((size_t)15))
+
+/**
+ * \brief Gets a pointer to the key context for a cache entry.
+ */
+#define aead_key_cache_entry_ctx(entry) \
+    (((unsigned char *)(entry)) + AEAD_KEY_CACHE_HEADER_SIZE)
+
+/**
+ * \brief Gets a pointer to the copy of the key for a cache entry.
+ */
+#define aead_key_cache_entry_key(entry) \
+    (aead_key_cache_entry_ctx((entry)) + (entry)->cipher->context_size)
+
+/**
+ * \brief Approximate size of a typical entry, used to size the hash table.
+ */
+#define AEAD_KEY_CACHE_TYPICAL_ENTRY 256
+
+/**
+ * \brief Minimum number of buckets in the hash table.
+ */
+#define AEAD_KEY_CACHE_MIN_BUCKETS 16
+
+/**
+ * \brief Maximum number of buckets in the hash table.
+ */
+#define AEAD_KEY_CACHE_MAX_BUCKETS (1UL << 20)
+
+struct aead_key_cache_s
+{
+    aead_key_cache_entry_t **buckets;   /**< Hash table of entries */
+    unsigned long mask;                 /**< Number of buckets minus 1 */
+    aead_key_cache_entry_t *newest;     /**< Most recently used entry */
+    aead_key_cache_entry_t *oldest;     /**< Least recently used entry */
+    uint64_t seed;                      /**< Seed for the key hash */
+    aead_key_cache_stats_t stats;       /**< Statistics for the cache */
+#if defined(LW_USE_PTHREADS)
+    pthread_mutex_t mutex;              /**< Lock for the cache */
+#endif
+};
+
+#if defined(LW_USE_PTHREADS)
+#define aead_key_cache_lock(cache) pthread_mutex_lock(&((cache)->mutex))
+#define aead_key_cache_unlock(cache) pthread_mutex_unlock(&((cache)->mutex))
+#else
+#define aead_key_cache_lock(cache) do { } while (0)
+#define aead_key_cache_unlock(cache) do { } while (0)
+#endif
+
+/**
+ * \brief Wipes a region of memory in a way that the compiler will
+ * not optimise away.
+ *
+ * \param ptr Points to the memory to wipe.
+ * \param size Number of bytes to wipe.
+ */
+static void aead_key_cache_wipe(void *ptr, size_t size)
+{
+    volatile unsigned char *p = (volatile unsigned char *)ptr;
+    while (size > 0) {
+        *p++ = 0;
+        --size;
+    }
+}
+
+/**
+ * \brief Wipes and frees a cache entry.
+ *
+ * \param entry The entry to free.
+ */
+static void aead_key_cache_entry_free(aead_key_cache_entry_t *entry)
+{
+    aead_key_cache_wipe(entry, entry->size);
+    free(entry);
+}
+
+/**
+ * \brief Hashes a cipher and key to select a bucket in the hash table.
+ *
+ * \param cache The key context cache, which provides a random seed so
+ * that the bucket for a key cannot be predicted from the key alone.
+ * \param cipher The AEAD cipher.
+ * \param k Points to the key.
+ *
+ * \return The hash value.
+ */
+static uint64_t aead_key_cache_hash
+    (const aead_key_cache_t *cache, const aead_cipher_t *cipher,
+     const unsigned char *k)
+{
+    uint64_t h = cache->seed ^ (uint64_t)(uintptr_t)cipher;
+    unsigned index;
+    for (index = 0; index < cipher->key_len; ++index)
+        h = (h ^ k[index]) * 0x100000001B3ULL;
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    return h;
+}
+
+/**
+ * \brief Finds an entry in the hash table.
+ *
+ * \param cache The key context cache.
+ * \param cipher The AEAD cipher.
+ * \param k Points to the key.
+ * \param hash Hash of the cipher and key.
+ *
+ * \return A pointer to the entry or NULL if the key is not in the cache.
+ *
+ * The keys are compared in constant time.
+ */
+static aead_key_cache_entry_t *aead_key_cache_find
+    (const aead_key_cache_t *cache, const aead_cipher_t *cipher,
+     const unsigned char *k, uint64_t hash)
+{
+    aead_key_cache_entry_t *entry = cache->buckets[hash & cache->mask];
+    while (entry != 0) {
+        if (entry->hash == hash && entry->cipher == cipher) {
+            const unsigned char *key = aead_key_cache_entry_key(entry);
+            unsigned char diff = 0;
+            unsigned index;
+            for (index = 0; index < cipher->key_len; ++index)
+                diff |= key[index] ^ k[index];
+            if (!diff)
+                return entry;
+        }
+        entry = entry->chain;
+    }
+    return 0;
+}
+
+/**
+ * \brief Unlinks an entry from the least recently used list.
+ *
+ * \param cache The key context cache.
+ * \param entry The entry to unlink.
+ */
+static void aead_key_cache_unlink_lru
+    (aead_key_cache_t *cache, aead_key_cache_entry_t *entry)
+{
+    if (entry->newer)
+        entry->newer->older = entry->older;
+    else
+        cache->newest = entry->older;
+    if (entry->older)
+        entry->older->newer = entry->newer;
+    else
+        cache->oldest = entry->newer;
+    entry->newer = 0;
+    entry->older = 0;
+}
+
+/**
+ * \brief Links an entry into the least recently used list as the
+ * most recently used entry.
+ *
+ * \param cache The key context cache.
+ * \param entry The entry to link.
+ */
+static void aead_key_cache_link_lru
+    (aead_key_cache_t *cache, aead_key_cache_entry_t *entry)
+{
+    entry->newer = 0;
+    entry->older = cache->newest;
+    if (cache->newest)
+        cache->newest->newer = entry;
+    else
+        cache->oldest = entry;
+    cache->newest = entry;
+}
+
+/**
+ * \brief Removes an entry from the cache.
+ *
+ * \param cache The key context cache.
+ * \param entry The entry to remove.
+ *
+ * The caller is responsible for freeing the entry once it is no
+ * longer in use.
+ */
+static void aead_key_cache_remove
+    (aead_key_cache_t *cache, aead_key_cache_entry_t *entry)
+{
+    aead_key_cache_entry_t **link = &(cache->buckets[entry->hash & cache->mask]);
+    while (*link != entry)
+        link = &((*link)->chain);
+    *link = entry->chain;
+    entry->chain = 0;
+    aead_key_cache_unlink_lru(cache, entry);
+    entry->stale = 1;
+    cache->stats.bytes -= entry->size;
+    --(cache->stats.entries);
+}
+
+/**
+ * \brief Evicts the least recently used entries that are not in use
+ * until the cache is within its memory budget.
+ *
+ * \param cache The key context cache.
+ */
+static void aead_key_cache_evict(aead_key_cache_t *cache)
+{
+    aead_key_cache_entry_t *entry = cache->oldest;
+    aead_key_cache_entry_t *newer;
+    while (entry != 0 && cache->stats.bytes > cache->stats.budget) {
+        newer = entry->newer;
+        if (entry->refs == 0) {
+            aead_key_cache_remove(cache, entry);
+            aead_key_cache_entry_free(entry);
+            ++(cache->stats.evictions);
+        }
+        entry = newer;
+    }
+}
+
+/**
+ * \brief Acquires the cache entry for a cipher and key, setting up a
+ * new key context if necessary.
+ *
+ * \param cache The key context cache.
+ * \param cipher The AEAD cipher.
+ * \param k Points to the key.
+ *
+ * \return The entry, or NULL if the packet should bypass the cache.
+ *
+ * The key schedule is computed outside the lock so that other threads
+ * can continue to use the cache while a new context is set up.
+ */
+static aead_key_cache_entry_t *aead_key_cache_acquire
+    (aead_key_cache_t *cache, const aead_cipher_t *cipher,
+     const unsigned char *k)
+{
+    aead_key_cache_entry_t *entry;
+    aead_key_cache_entry_t *existing;
+    size_t size;
+    uint64_t hash;
+
+    /* Bypass the cache for ciphers without a key schedule and for
+     * contexts that are too big to ever fit in the budget */
+    size = AEAD_KEY_CACHE_HEADER_SIZE + cipher->context_size + cipher->key_len;
+    if (!cipher->setup_key || size > cache->stats.budget) {
+        aead_key_cache_lock(cache);
+        ++(cache->stats.bypasses);
+        aead_key_cache_unlock(cache);
+        return 0;
+    }
+
+    /* Look for an existing context for the key */
+    hash = aead_key_cache_hash(cache, cipher, k);
+    aead_key_cache_lock(cache);
+    entry = aead_key_cache_find(cache, cipher, k, hash);
+    if (entry) {
+        ++(cache->stats.hits);
+        ++(entry->refs);
+        aead_key_cache_unlink_lru(cache, entry);
+        aead_key_cache_link_lru(cache, entry);
+        aead_key_cache_unlock(cache);
+        return entry;
+    }
+    ++(cache->stats.misses);
+    aead_key_cache_unlock(cache);
+
+    /* Set up a new context for the key */
+    entry = (aead_key_cache_entry_t *)malloc(size);
+    if (!entry) {
+        aead_key_cache_lock(cache);
+        ++(cache->stats.bypasses);
+        aead_key_cache_unlock(cache);
+        return 0;
+    }
+    memset(entry, 0, sizeof(aead_key_cache_entry_t));
+    entry->cipher = cipher;
+    entry->hash = hash;
+    entry->size = size;
+    entry->refs = 1;
+    (*(cipher->setup_key))(aead_key_cache_entry_ctx(entry), k);
+    memcpy(aead_key_cache_entry_key(entry), k, cipher->key_len);
+
+    /* Another thread may have set up the same key while we were
+     * computing the key schedule, in which case we use theirs */
+    aead_key_cache_lock(cache);
+    existing = aead_key_cache_find(cache, cipher, k, hash);
+    if (existing) {
+        ++(existing->refs);
+        aead_key_cache_unlink_lru(cache, existing);
+        aead_key_cache_link_lru(cache, existing);
+        aead_key_cache_unlock(cache);
+        aead_key_cache_entry_free(entry);
+        return existing;
+    }
+
+    /* Insert the new entry and evict old entries to stay in budget */
+    entry->chain = cache->buckets[hash & cache->mask];
+    cache->buckets[hash & cache->mask] = entry;
+    aead_key_cache_link_lru(cache, entry);
+    cache->stats.bytes += size;
+    ++(cache->stats.entries);
+    aead_key_cache_evict(cache);
+    aead_key_cache_unlock(cache);
+    return entry;
+}
+
+/**
+ * \brief Releases a cache entry that was acquired with
+ * aead_key_cache_acquire().
+ *
+ * \param cache The key context cache.
+ * \param entry The entry to release.
+ */
+static void aead_key_cache_release
+    (aead_key_cache_t *cache, aead_key_cache_entry_t *entry)
+{
+    int free_entry;
+    aead_key_cache_lock(cache);
+    --(entry->refs);
+    free_entry = (entry->refs == 0 && entry->stale);
+    if (entry->refs == 0 && !entry->stale)
+        aead_key_cache_evict(cache);
+    aead_key_cache_unlock(cache);
+    if (free_entry)
+        aead_key_cache_entry_free(entry);
+}
+
+aead_key_cache_t *aead_key_cache_new(size_t budget)
+{
+    aead_key_cache_t *cache;
+    aead_random_ctx_t rng;
+    unsigned long buckets;
+
+    /* Size the hash table for the number of entries that are
+     * expected to fit within the budget */
+    buckets = AEAD_KEY_CACHE_MIN_BUCKETS;
+    while (buckets < AEAD_KEY_CACHE_MAX_BUCKETS &&
+           buckets < budget / AEAD_KEY_CACHE_TYPICAL_ENTRY)
+        buckets <<= 1;
+
+    /* Allocate and initialize the cache */
+    cache = (aead_key_cache_t *)calloc(1, sizeof(aead_key_cache_t));
+    if (!cache)
+        return 0;
+    cache->buckets = (aead_key_cache_entry_t **)
+        calloc(buckets, sizeof(aead_key_cache_entry_t *));
+    if (!cache->buckets) {
+        free(cache);
+        return 0;
+    }
+#if defined(LW_USE_PTHREADS)
+    if (pthread_mutex_init(&(cache->mutex), 0) != 0) {
+        free(cache->buckets);
+        free(cache);
+        return 0;
+    }
+#endif
+    cache->mask = buckets - 1;
+    cache->stats.budget = budget;
+
+    /* Seed the hash from a private context so that the caller's
+     * default random number generator is left as it was */
+    memset(&rng, 0, sizeof(rng));
+    aead_random_ctx_init(&rng);
+    cache->seed = aead_random_ctx_generate_64(&rng);
+    aead_random_ctx_finish(&rng);
+    return cache;
+}
+
+void aead_key_cache_free(aead_key_cache_t *cache)
+{
+    if (cache) {
+        aead_key_cache_clear(cache);
+#if defined(LW_USE_PTHREADS)
+        pthread_mutex_destroy(&(cache->mutex));
+#endif
+        free(cache->buckets);
+        aead_key_cache_wipe(cache, sizeof(aead_key_cache_t));
+        free(cache);
+    }
+}
+
+void aead_key_cache_clear(aead_key_cache_t *cache)
+{
+    aead_key_cache_entry_t *entry;
+    aead_key_cache_lock(cache);
+    while ((entry = cache->oldest) != 0) {
+        aead_key_cache_remove(cache, entry);
+        if (entry->refs == 0)
+            aead_key_cache_entry_free(entry);
+    }
+    aead_key_cache_unlock(cache);
+}
+
+int aead_key_cache_encrypt
+    (aead_key_cache_t *cache, const aead_cipher_t *cipher,
+     unsigned char *c, unsigned long long *clen,
+     const unsigned char *m, unsigned long long mlen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *npub, const unsigned char *k)
+{
+    aead_key_cache_entry_t *entry;
+    int result;
+    entry = aead_key_cache_acquire(cache, cipher, k);
+    if (!entry) {
+        return (*(cipher->encrypt))
+            (c, clen, m, mlen, ad, adlen, 0, npub, k);
+    }
+    result = (*(cipher->encrypt_with_context))
+        (c, clen, m, mlen, ad, adlen, 0, npub,
+         aead_key_cache_entry_ctx(entry));
+    aead_key_cache_release(cache, entry);
+    return result;
+}
+
+int aead_key_cache_decrypt
+    (aead_key_cache_t *cache, const aead_cipher_t *cipher,
+     unsigned char *m, unsigned long long *mlen,
+     const unsigned char *c, unsigned long long clen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *npub, const unsigned char *k)
+{
+    aead_key_cache_entry_t *entry;
+    int result;
+    entry = aead_key_cache_acquire(cache, cipher, k);
+    if (!entry) {
+        return (*(cipher->decrypt))
+            (m, mlen, 0, c, clen, ad, adlen, npub, k);
+    }
+    result = (*(cipher->decrypt_with_context))
+        (m, mlen, 0, c, clen, ad, adlen, npub,
+         aead_key_cache_entry_ctx(entry));
+    aead_key_cache_release(cache, entry);
+    return result;
+}
+
+void aead_key_cache_get_stats
+    (aead_key_cache_t *cache, aead_key_cache_stats_t *stats)
+{
+    aead_key_cache_lock(cache);
+    *stats = cache->stats;
+    aead_key_cache_unlock(cache);
+}
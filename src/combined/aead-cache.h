@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2020 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef LWCRYPTO_AEAD_CACHE_H
+#define LWCRYPTO_AEAD_CACHE_H
+
+#include "aead-common.h"
+
+/**
+ * \file aead-cache.h
+ * \brief Cache of precomputed key contexts for AEAD ciphers.
+ *
+ * Applications that encrypt with many different keys can route their
+ * packets through a key cache instead of managing key contexts themselves.
+ * The cache maps a cipher and a key to the context that is produced by
+ * aead_setup_key(), computing the context the first time that the key
+ * is seen and reusing it for later packets.
+ *
+ * The memory that is used by the cache is bounded by a budget that is
+ * supplied when the cache is created.  When the budget is exceeded,
+ * the least recently used contexts are evicted.  Evicted contexts and
+ * their keys are wiped before the memory is freed.
+ *
+ * If the library is built with LW_USE_PTHREADS, then a single cache can be
+ * shared between threads.  The lock on the cache is only held while
+ * looking up a context; the packet is encrypted or decrypted outside
+ * the lock, and contexts that are in use are never evicted.
+ *
+ * Ciphers without a key schedule to precompute bypass the cache and
+ * call the cipher's regular "encrypt" and "decrypt" functions directly.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Opaque type for a key context cache.
+ */
+typedef struct aead_key_cache_s aead_key_cache_t;
+
+/**
+ * \brief Statistics for a key context cache, which can be used to
+ * size the memory budget for an application's working set of keys.
+ */
+typedef struct
+{
+    unsigned long long hits;        /**< Lookups that found a context */
+    unsigned long long misses;      /**< Lookups that set up a new context */
+    unsigned long long evictions;   /**< Contexts evicted to stay in budget */
+    unsigned long long bypasses;    /**< Packets that did not use the cache */
+    size_t entries;                 /**< Number of contexts in the cache */
+    size_t bytes;                   /**< Bytes of memory used by contexts */
+    size_t budget;                  /**< Memory budget for the cache */
+
+} aead_key_cache_stats_t;
+
+/**
+ * \brief Creates a new key context cache.
+ *
+ * \param budget Maximum number of bytes of memory to use for cached
+ * key contexts, including the per-entry bookkeeping.
+ *
+ * \return A pointer to the new cache, or NULL if there is insufficient
+ * memory to create it.
+ *
+ * Contexts that are larger than the entire budget are never cached.
+ */
+aead_key_cache_t *aead_key_cache_new(size_t budget);
+
+/**
+ * \brief Frees a key context cache, wiping all cached contexts.
+ *
+ * \param cache The cache to free, which may be NULL.
+ *
+ * No other thread may be using the cache when it is freed.
+ */
+void aead_key_cache_free(aead_key_cache_t *cache);
+
+/**
+ * \brief Wipes and removes all contexts from a key context cache.
+ *
+ * \param cache The cache to clear.
+ *
+ * Contexts that are in use by other threads are removed from the cache
+ * straight away but are not wiped and freed until the other threads
+ * have finished with them.  The statistics are not reset.
+ */
+void aead_key_cache_clear(aead_key_cache_t *cache);
+
+/**
+ * \brief Encrypts and authenticates a packet with an AEAD cipher using
+ * a key context from a cache.
+ *
+ * \param cache The key context cache.
+ * \param cipher The AEAD cipher.
+ * \param c Buffer to receive the output.
+ * \param clen On exit, set to the length of the output which includes
+ * the ciphertext and the authentication tag.
+ * \param m Buffer that contains the plaintext message to encrypt.
+ * \param mlen Length of the plaintext message in bytes.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet.
+ * \param k Points to the key to use to encrypt the packet.
+ *
+ * \return 0 on success, or a negative value if there was an error in
+ * the parameters.
+ */
+int aead_key_cache_encrypt
+    (aead_key_cache_t *cache, const aead_cipher_t *cipher,
+     unsigned char *c, unsigned long long *clen,
+     const unsigned char *m, unsigned long long mlen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *npub, const unsigned char *k);
+
+/**
+ * \brief Decrypts and authenticates a packet with an AEAD cipher using
+ * a key context from a cache.
+ *
+ * \param cache The key context cache.
+ * \param cipher The AEAD cipher.
+ * \param m Buffer to receive the plaintext message on output.
+ * \param mlen Receives the length of the plaintext message on output.
+ * \param c Buffer that contains the ciphertext and authentication
+ * tag to decrypt.
+ * \param clen Length of the input data in bytes, which includes the
+ * ciphertext and the authentication tag.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet.
+ * \param k Points to the key to use to decrypt the packet.
+ *
+ * \return 0 on success, -1 if the authentication tag was incorrect,
+ * or some other negative number if there was an error in the parameters.
+ */
+int aead_key_cache_decrypt
+    (aead_key_cache_t *cache, const aead_cipher_t *cipher,
+     unsigned char *m, unsigned long long *mlen,
+     const unsigned char *c, unsigned long long clen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *npub, const unsigned char *k);
+
+/**
+ * \brief Gets the current statistics for a key context cache.
+ *
+ * \param cache The key context cache.
+ * \param stats Returns the statistics.
+ */
+void aead_key_cache_get_stats
+    (aead_key_cache_t *cache, aead_key_cache_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
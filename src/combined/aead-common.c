@@ -21,6 +21,8 @@
  */
 
 #include "aead-common.h"
+#include "internal-util.h"
+#include <string.h>
 
 int aead_check_tag
     (unsigned char *plaintext, unsigned long long plaintext_len,
@@ -67,3 +69,153 @@ int aead_check_tag_precheck
     /* If "accum" is 0, return -1, otherwise return 0 */
     return ~accum;
 }
+
+size_t aead_context_size(const aead_cipher_t *cipher)
+{
+    if (cipher->setup_key)
+        return cipher->context_size;
+    else
+        return cipher->key_len;
+}
+
+void aead_setup_key
+    (const aead_cipher_t *cipher, void *ctx, const unsigned char *k)
+{
+    if (cipher->setup_key)
+        (*(cipher->setup_key))(ctx, k);
+    else
+        memcpy(ctx, k, cipher->key_len);
+}
+
+int aead_encrypt_with_context
+    (const aead_cipher_t *cipher,
+     unsigned char *c, unsigned long long *clen,
+     const unsigned char *m, unsigned long long mlen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *npub, const void *ctx)
+{
+    if (cipher->setup_key) {
+        return (*(cipher->encrypt_with_context))
+            (c, clen, m, mlen, ad, adlen, 0, npub, ctx);
+    } else {
+        return (*(cipher->encrypt))
+            (c, clen, m, mlen, ad, adlen, 0, npub,
+             (const unsigned char *)ctx);
+    }
+}
+
+int aead_decrypt_with_context
+    (const aead_cipher_t *cipher,
+     unsigned char *m, unsigned long long *mlen,
+     const unsigned char *c, unsigned long long clen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *npub, const void *ctx)
+{
+    if (cipher->setup_key) {
+        return (*(cipher->decrypt_with_context))
+            (m, mlen, 0, c, clen, ad, adlen, npub, ctx);
+    } else {
+        return (*(cipher->decrypt))
+            (m, mlen, 0, c, clen, ad, adlen, npub,
+             (const unsigned char *)ctx);
+    }
+}
+
+/**
+ * \brief Encrypts or decrypts a single packet in a batch.
+ *
+ * \param cipher The AEAD cipher.
+ * \param item The packet to encrypt or decrypt.
+ * \param decrypt Non-zero to decrypt, zero to encrypt.
+ */
+static void aead_batch_single
+    (const aead_cipher_t *cipher, aead_batch_item_t *item, int decrypt)
+{
+    if (decrypt) {
+        if (item->key) {
+            item->status = (*(cipher->decrypt))
+                (item->out, &(item->outlen), 0, item->in, item->inlen,
+                 item->ad, item->adlen, item->npub, item->key);
+        } else {
+            item->status = aead_decrypt_with_context
+                (cipher, item->out, &(item->outlen), item->in, item->inlen,
+                 item->ad, item->adlen, item->npub, item->ctx);
+        }
+    } else {
+        if (item->key) {
+            item->status = (*(cipher->encrypt))
+                (item->out, &(item->outlen), item->in, item->inlen,
+                 item->ad, item->adlen, 0, item->npub, item->key);
+        } else {
+            item->status = aead_encrypt_with_context
+                (cipher, item->out, &(item->outlen), item->in, item->inlen,
+                 item->ad, item->adlen, item->npub, item->ctx);
+        }
+    }
+}
+
+/**
+ * \brief Encrypts or decrypts a batch of packets.
+ *
+ * \param cipher The AEAD cipher.
+ * \param items Points to the descriptors for the packets.
+ * \param count Number of packets in the batch.
+ * \param decrypt Non-zero to decrypt, zero to encrypt.
+ *
+ * \return 0 if all packets succeeded, or the first negative status.
+ */
+static int aead_batch_crypt
+    (const aead_cipher_t *cipher, aead_batch_item_t *items, size_t count,
+     int decrypt)
+{
+    size_t index;
+    int result = 0;
+    if (cipher->batch) {
+        if (decrypt)
+            (*(cipher->batch->decrypt))(items, count);
+        else
+            (*(cipher->batch->encrypt))(items, count);
+    } else {
+        for (index = 0; index < count; ++index)
+            aead_batch_single(cipher, &(items[index]), decrypt);
+    }
+    for (index = 0; index < count; ++index) {
+        if (items[index].status < 0 && result == 0)
+            result = items[index].status;
+    }
+    return result;
+}
+
+int aead_batch_encrypt
+    (const aead_cipher_t *cipher, aead_batch_item_t *items, size_t count)
+{
+    return aead_batch_crypt(cipher, items, count, 0);
+}
+
+int aead_batch_decrypt
+    (const aead_cipher_t *cipher, aead_batch_item_t *items, size_t count)
+{
+    return aead_batch_crypt(cipher, items, count, 1);
+}
+
+#if LW_SIMD_DISPATCH
+
+int lw_simd_level(void)
+{
+    /* Concurrent first calls race benignly as they store the same value */
+    static volatile int level = -1;
+    int value = level;
+    if (value < 0) {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f"))
+            value = LW_SIMD_LEVEL_AVX512;
+        else if (__builtin_cpu_supports("avx2"))
+            value = LW_SIMD_LEVEL_AVX2;
+        else
+            value = LW_SIMD_LEVEL_C;
+        level = value;
+    }
+    return value;
+}
+
+#endif
@@ -91,6 +91,77 @@ typedef int (*aead_cipher_decrypt_t)
      const unsigned char *npub,
      const unsigned char *k);
 
+/**
+ * \brief Sets up a precomputed key context for an AEAD scheme.
+ *
+ * \param ctx Points to the key context to set up, which must be at
+ * least "context_size" bytes in length and suitably aligned for any
+ * integer type; e.g. by allocating it with malloc().
+ * \param k Points to the key to expand into the context.
+ *
+ * The context can be reused with any number of nonces until the
+ * application destroys it.  The context holds key material so it
+ * should be cleaned when it is no longer required.
+ */
+typedef void (*aead_cipher_setup_key_t)(void *ctx, const unsigned char *k);
+
+/**
+ * \brief Encrypts and authenticates a packet with an AEAD scheme using
+ * a precomputed key context.
+ *
+ * \param c Buffer to receive the output.
+ * \param clen On exit, set to the length of the output which includes
+ * the ciphertext and the authentication tag.
+ * \param m Buffer that contains the plaintext message to encrypt.
+ * \param mlen Length of the plaintext message in bytes.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param nsec Secret nonce - normally not used by AEAD schemes.
+ * \param npub Points to the public nonce for the packet.
+ * \param ctx Points to the key context that was set up with the
+ * cipher's "setup_key" function.
+ *
+ * \return 0 on success, or a negative value if there was an error in
+ * the parameters.
+ */
+typedef int (*aead_cipher_encrypt_with_context_t)
+    (unsigned char *c, unsigned long long *clen,
+     const unsigned char *m, unsigned long long mlen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *nsec,
+     const unsigned char *npub,
+     const void *ctx);
+
+/**
+ * \brief Decrypts and authenticates a packet with an AEAD scheme using
+ * a precomputed key context.
+ *
+ * \param m Buffer to receive the plaintext message on output.
+ * \param mlen Receives the length of the plaintext message on output.
+ * \param nsec Secret nonce - normally not used by AEAD schemes.
+ * \param c Buffer that contains the ciphertext and authentication
+ * tag to decrypt.
+ * \param clen Length of the input data in bytes, which includes the
+ * ciphertext and the authentication tag.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet.
+ * \param ctx Points to the key context that was set up with the
+ * cipher's "setup_key" function.
+ *
+ * \return 0 on success, -1 if the authentication tag was incorrect,
+ * or some other negative number if there was an error in the parameters.
+ */
+typedef int (*aead_cipher_decrypt_with_context_t)
+    (unsigned char *m, unsigned long long *mlen,
+     unsigned char *nsec,
+     const unsigned char *c, unsigned long long clen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *npub,
+     const void *ctx);
+
 /**
  * \brief Hashes a block of input data.
  *
@@ -151,6 +222,73 @@ typedef void (*aead_xof_absorb_t)
 typedef void (*aead_xof_squeeze_t)
     (void *state, unsigned char *out, unsigned long long outlen);
 
+/**
+ * \brief Initializes the state for an incremental AEAD operation.
+ *
+ * \param state Incremental AEAD state to be initialized.
+ * \param npub Points to the public nonce for the packet.
+ * \param k Points to the key to use to encrypt or decrypt the packet.
+ *
+ * The state holds a copy of the key or key-derived material, so it
+ * should be cleaned when it is no longer required.
+ */
+typedef void (*aead_stream_init_t)
+    (void *state, const unsigned char *npub, const unsigned char *k);
+
+/**
+ * \brief Absorbs more associated data into an incremental AEAD state.
+ *
+ * \param state Incremental AEAD state to be updated.
+ * \param ad Points to the associated data to be absorbed.
+ * \param adlen Length of the associated data to be absorbed.
+ *
+ * The associated data can be supplied in fragments of any size, but all
+ * of it must be supplied before the first call to the "encrypt" or
+ * "decrypt" function for the packet.
+ */
+typedef void (*aead_stream_update_ad_t)
+    (void *state, const unsigned char *ad, unsigned long long adlen);
+
+/**
+ * \brief Encrypts or decrypts more payload data with an incremental
+ * AEAD state.
+ *
+ * \param state Incremental AEAD state to be updated.
+ * \param out Buffer to receive exactly \a len bytes of output.
+ * \param in Points to the input data to be encrypted or decrypted.
+ * \param len Length of the input data in bytes.
+ *
+ * The payload can be supplied in fragments of any size.  The \a in and
+ * \a out buffers can be the same buffer for in-place operation.
+ */
+typedef void (*aead_stream_crypt_t)
+    (void *state, unsigned char *out, const unsigned char *in,
+     unsigned long long len);
+
+/**
+ * \brief Finalizes an incremental AEAD encryption operation.
+ *
+ * \param state Incremental AEAD state to be finalized.
+ * \param tag Buffer to receive the authentication tag.
+ */
+typedef void (*aead_stream_encrypt_finalize_t)
+    (void *state, unsigned char *tag);
+
+/**
+ * \brief Finalizes an incremental AEAD decryption operation.
+ *
+ * \param state Incremental AEAD state to be finalized.
+ * \param tag Points to the authentication tag to be checked.
+ *
+ * \return 0 if the authentication tag is correct, or -1 otherwise.
+ *
+ * The plaintext has already been returned to the application by the
+ * time the tag is checked.  The application must not act upon the
+ * plaintext unless this function reports that the tag is correct.
+ */
+typedef int (*aead_stream_decrypt_finalize_t)
+    (void *state, const unsigned char *tag);
+
 /**
  * \brief No special AEAD features.
  */
@@ -179,8 +317,92 @@ typedef void (*aead_xof_squeeze_t)
  */
 #define AEAD_FLAG_SC_PROTECT_ALL    0x0004
 
+/**
+ * \brief Incremental AEAD functions for ciphers that can process the
+ * associated data and payload in fragments of arbitrary size.
+ *
+ * The application calls "init", then "update_ad" zero or more times,
+ * then either "encrypt" or "decrypt" zero or more times, and finally
+ * "encrypt_finalize" or "decrypt_finalize".  The result is identical
+ * to the all-in-one "encrypt" and "decrypt" functions of the cipher.
+ */
+typedef struct
+{
+    size_t state_size;                  /**< Size of the incremental state */
+    aead_stream_init_t init;            /**< Starts a new packet */
+    aead_stream_update_ad_t update_ad;  /**< Absorbs associated data */
+    aead_stream_crypt_t encrypt;        /**< Encrypts payload data */
+    aead_stream_crypt_t decrypt;        /**< Decrypts payload data */
+    aead_stream_encrypt_finalize_t encrypt_finalize; /**< Generates the tag */
+    aead_stream_decrypt_finalize_t decrypt_finalize; /**< Checks the tag */
+
+} aead_stream_cipher_t;
+
+/**
+ * \brief Describes a single packet in a batch AEAD operation.
+ *
+ * The application fills in all fields except "outlen" and "status",
+ * which are set on exit.  When encrypting, "in" and "inlen" refer to the
+ * plaintext and "out" must have space for "inlen" plus the tag length.
+ * When decrypting, "in" and "inlen" refer to the ciphertext including the
+ * tag and "out" must have space for "inlen" minus the tag length.
+ */
+typedef struct
+{
+    const unsigned char *key;   /**< Raw key, or NULL to use "ctx" */
+    const void *ctx;            /**< Key context from aead_setup_key() */
+    const unsigned char *npub;  /**< Public nonce for the packet */
+    const unsigned char *ad;    /**< Associated data for the packet */
+    unsigned long long adlen;   /**< Length of the associated data */
+    const unsigned char *in;    /**< Input data for the packet */
+    unsigned long long inlen;   /**< Length of the input data */
+    unsigned char *out;         /**< Output buffer for the packet */
+    unsigned long long outlen;  /**< Length of the output on exit */
+    int status;                 /**< Result for the packet on exit */
+
+} aead_batch_item_t;
+
+/**
+ * \brief Encrypts or decrypts a batch of packets with an AEAD cipher.
+ *
+ * \param items Points to the descriptors for the packets.
+ * \param count Number of packets in the batch.
+ *
+ * The function sets "outlen" and "status" for every item.  The status is
+ * 0 on success, -1 if the authentication tag was incorrect, or some other
+ * negative value if there was an error in the parameters.
+ */
+typedef void (*aead_cipher_batch_t)(aead_batch_item_t *items, size_t count);
+
+/**
+ * \brief Batch functions for ciphers that can process several independent
+ * packets at once with a multi-lane kernel.
+ */
+typedef struct
+{
+    aead_cipher_batch_t encrypt;    /**< Batch encryption function */
+    aead_cipher_batch_t decrypt;    /**< Batch decryption function */
+
+} aead_batch_cipher_t;
+
 /**
  * \brief Meta-information about an AEAD cipher.
+ *
+ * Ciphers with an expensive key schedule can provide the "setup_key",
+ * "encrypt_with_context", and "decrypt_with_context" functions so that
+ * the key schedule can be computed once and reused for many packets.
+ * These fields are NULL and "context_size" is zero for ciphers that
+ * have no key schedule to precompute.  The aead_context_size(),
+ * aead_setup_key(), aead_encrypt_with_context(), and
+ * aead_decrypt_with_context() functions provide a uniform interface
+ * across all ciphers, falling back to a copy of the raw key if the
+ * cipher does not have its own context support.
+ *
+ * Ciphers that can process data incrementally set "stream" to the
+ * functions for doing so, or NULL otherwise.  Similarly, ciphers that
+ * can process several packets at once set "batch".  The functions
+ * aead_batch_encrypt() and aead_batch_decrypt() fall back to one packet
+ * at a time if "batch" is NULL.
  */
 typedef struct
 {
@@ -191,6 +413,14 @@ typedef struct
     unsigned flags;                 /**< Flags for extra features */
     aead_cipher_encrypt_t encrypt;  /**< AEAD encryption function */
     aead_cipher_decrypt_t decrypt;  /**< AEAD decryption function */
+    size_t context_size;            /**< Size of the key context in bytes */
+    aead_cipher_setup_key_t setup_key; /**< Key context setup function */
+    aead_cipher_encrypt_with_context_t encrypt_with_context;
+                                    /**< Encryption with a key context */
+    aead_cipher_decrypt_with_context_t decrypt_with_context;
+                                    /**< Decryption with a key context */
+    const aead_stream_cipher_t *stream; /**< Incremental functions */
+    const aead_batch_cipher_t *batch;   /**< Multi-packet functions */
 
 } aead_cipher_t;
 
@@ -260,6 +490,126 @@ int aead_check_tag_precheck
      const unsigned char *tag1, const unsigned char *tag2,
      unsigned tag_len, int precheck);
 
+/**
+ * \brief Gets the size of the key context for an AEAD cipher.
+ *
+ * \param cipher The AEAD cipher.
+ *
+ * \return The number of bytes that need to be allocated for a key
+ * context for \a cipher.
+ *
+ * \sa aead_setup_key()
+ */
+size_t aead_context_size(const aead_cipher_t *cipher);
+
+/**
+ * \brief Sets up a precomputed key context for an AEAD cipher.
+ *
+ * \param cipher The AEAD cipher.
+ * \param ctx Points to the key context to set up, which must be at least
+ * aead_context_size() bytes in length and suitably aligned.
+ * \param k Points to the key.
+ *
+ * If the cipher does not have its own context support, then the
+ * raw key is copied into the context.
+ *
+ * \sa aead_encrypt_with_context(), aead_decrypt_with_context()
+ */
+void aead_setup_key
+    (const aead_cipher_t *cipher, void *ctx, const unsigned char *k);
+
+/**
+ * \brief Encrypts and authenticates a packet with an AEAD cipher using
+ * a precomputed key context.
+ *
+ * \param cipher The AEAD cipher.
+ * \param c Buffer to receive the output.
+ * \param clen On exit, set to the length of the output which includes
+ * the ciphertext and the authentication tag.
+ * \param m Buffer that contains the plaintext message to encrypt.
+ * \param mlen Length of the plaintext message in bytes.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet.
+ * \param ctx Points to the key context that was set up with
+ * aead_setup_key().
+ *
+ * \return 0 on success, or a negative value if there was an error in
+ * the parameters.
+ */
+int aead_encrypt_with_context
+    (const aead_cipher_t *cipher,
+     unsigned char *c, unsigned long long *clen,
+     const unsigned char *m, unsigned long long mlen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *npub, const void *ctx);
+
+/**
+ * \brief Decrypts and authenticates a packet with an AEAD cipher using
+ * a precomputed key context.
+ *
+ * \param cipher The AEAD cipher.
+ * \param m Buffer to receive the plaintext message on output.
+ * \param mlen Receives the length of the plaintext message on output.
+ * \param c Buffer that contains the ciphertext and authentication
+ * tag to decrypt.
+ * \param clen Length of the input data in bytes, which includes the
+ * ciphertext and the authentication tag.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet.
+ * \param ctx Points to the key context that was set up with
+ * aead_setup_key().
+ *
+ * \return 0 on success, -1 if the authentication tag was incorrect,
+ * or some other negative number if there was an error in the parameters.
+ */
+int aead_decrypt_with_context
+    (const aead_cipher_t *cipher,
+     unsigned char *m, unsigned long long *mlen,
+     const unsigned char *c, unsigned long long clen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *npub, const void *ctx);
+
+/**
+ * \brief Encrypts and authenticates a batch of packets with an AEAD cipher.
+ *
+ * \param cipher The AEAD cipher.
+ * \param items Points to the descriptors for the packets.
+ * \param count Number of packets in the batch.
+ *
+ * \return 0 if every packet was encrypted, or a negative value if at
+ * least one packet had an error.  The "status" field of each item
+ * reports the result for that packet.
+ *
+ * Each item may supply either a raw key or a key context from
+ * aead_setup_key().  The packets are independent and may have different
+ * keys, nonces, and lengths.
+ *
+ * \sa aead_batch_decrypt()
+ */
+int aead_batch_encrypt
+    (const aead_cipher_t *cipher, aead_batch_item_t *items, size_t count);
+
+/**
+ * \brief Decrypts and authenticates a batch of packets with an AEAD cipher.
+ *
+ * \param cipher The AEAD cipher.
+ * \param items Points to the descriptors for the packets.
+ * \param count Number of packets in the batch.
+ *
+ * \return 0 if every packet was authenticated, or a negative value if at
+ * least one packet failed.  The "status" field of each item reports the
+ * result for that packet; -1 means that the authentication tag was
+ * incorrect and the plaintext for that packet has been zeroed.
+ *
+ * \sa aead_batch_encrypt()
+ */
+int aead_batch_decrypt
+    (const aead_cipher_t *cipher, aead_batch_item_t *items, size_t count);
+
 #ifdef __cplusplus
 }
 #endif
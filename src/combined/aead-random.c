@@ -18,11 +18,15 @@
  * then it will be used to seed the PRNG with 256 bits of TRNG data
  * whenever aead_random_init() is called.
  *
- * WARNING: The functions in this file are not thread-safe!
+ * The PRNG state is kept in an aead_random_ctx_t context.  The functions
+ * that do not take a context use a default context for the calling thread
+ * when LW_USE_PTHREADS is defined, or a single global context otherwise.
+ * Contexts are reseeded and pools are emptied in the child after fork().
  */
 
 #define _GNU_SOURCE
 #include "aead-random.h"
+#include "internal-chacha-lanes.h"
 #include <string.h>
 #if defined(ARDUINO)
 #include <Arduino.h>
@@ -35,6 +39,9 @@
 #include <unistd.h>
 #include <fcntl.h>
 #endif
+#if defined(LW_USE_PTHREADS) || defined(__linux__)
+#include <pthread.h>
+#endif
 
 /**
  * \def AEAD_USE_PRNG
@@ -49,7 +56,7 @@
 /* Assume that we have the RDRAND instruction on x86-64 platforms */
 #include <immintrin.h> /* For _rdrand64_step() */
 #define aead_system_random_init() do { ; } while (0)
-#define aead_system_random(var, ready) \
+#define aead_system_random(var) \
     do { \
         unsigned long long temp = 0; \
         int count = 20; \
@@ -98,21 +105,89 @@ extern uint32_t esp_random(void);
 #define aead_system_random_init() do { ; } while (0)
 #endif /* !aead_system_random */
 
-#if defined(AEAD_USE_PRNG)
+/**
+ * \brief Default pool of masking words for the calling thread.
+ */
+AEAD_RANDOM_THREAD_LOCAL aead_random_pool_t aead_random_default_pool;
+
+/* Detect when the process has forked so that the child does not
+ * generate the same random data as the parent.  Contexts and pools
+ * record the fork count when they are filled and discard their
+ * buffered output when the count changes. */
+volatile uint32_t aead_random_fork_count = 0;
+
+#if defined(LW_USE_PTHREADS) || defined(__linux__)
+
+/**
+ * \brief Handles a fork() in the child process.
+ *
+ * The child is single-threaded at this point, so the fork count
+ * does not need to be updated atomically.
+ */
+static void aead_random_fork_child(void)
+{
+    ++aead_random_fork_count;
+}
 
-/* Load a little-endian 32-bit word from a byte buffer */
-#define le_load_word32(ptr) \
-    ((((uint32_t)((ptr)[3])) << 24) | \
-     (((uint32_t)((ptr)[2])) << 16) | \
-     (((uint32_t)((ptr)[1])) << 8) | \
-      ((uint32_t)((ptr)[0])))
+#if defined(LW_USE_PTHREADS)
+
+/**
+ * \brief Makes sure that the fork handler is only registered once.
+ */
+static pthread_once_t aead_random_fork_once = PTHREAD_ONCE_INIT;
 
-/* Rotate a word left by a specific number of bits */
-#define leftRotate(a, bits) \
-    (__extension__ ({ \
-        uint32_t _temp = (a); \
-        (_temp << (bits)) | (_temp >> (32 - (bits))); \
-    }))
+/**
+ * \brief Registers the fork handler with the system.
+ */
+static void aead_random_fork_register(void)
+{
+    pthread_atfork(0, 0, aead_random_fork_child);
+}
+
+#define aead_random_fork_init() \
+    pthread_once(&aead_random_fork_once, aead_random_fork_register)
+
+#else
+
+/**
+ * \brief Non-zero once the fork handler has been registered.
+ *
+ * The library is single-threaded without LW_USE_PTHREADS, so a plain
+ * flag is enough.  pthread_atfork() is provided by the C library itself
+ * on Linux, so this does not need to link against -pthread.
+ */
+static int aead_random_fork_registered = 0;
+
+#define aead_random_fork_init() \
+    do { \
+        if (!aead_random_fork_registered) { \
+            pthread_atfork(0, 0, aead_random_fork_child); \
+            aead_random_fork_registered = 1; \
+        } \
+    } while (0)
+
+#endif
+
+#else
+
+/* No fork() on this platform */
+#define aead_random_fork_init() do { ; } while (0)
+
+#endif
+
+/**
+ * \brief Gets the fork count when a context or pool is being filled,
+ * making sure that the fork handler is registered first.
+ *
+ * \return The current fork count.
+ */
+static uint32_t aead_random_fork_seed_id(void)
+{
+    aead_random_fork_init();
+    return aead_random_fork_count;
+}
+
+#if defined(AEAD_USE_PRNG)
 
 /* Perform a ChaCha quarter round operation */
 #define quarterRound(a, b, c, d)    \
@@ -167,144 +242,247 @@ static void aead_chacha_core(uint32_t output[16], const uint32_t input[16])
         output[posn] += input[posn];
 }
 
-/**
- * \brief Global PRNG state.
- *
- * The starting value is the string "expand 32-byte k" followed by zeroes.
- * It will not stay in this state for long as aead_random_init() will
- * reseed and re-key the PRNG when it is called.
- *
- * The last word is used as a block counter when multiple output blocks
- * are required.  The PRNG is reseeded every AEAD_PRNG_MAX_BLOCKS.
- */
-static uint32_t aead_chacha_state[16] = {
-    0x61707865, 0x3320646e, 0x79622d32, 0x6b206574,
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
-};
+/* 128-bit kernel for the baseline vector unit; SSE2 or NEON */
+#if CHACHA_HAVE_X4
+#define CHACHA_LANES_SUFFIX _x4
+#define CHACHA_LANES 4
+#define CHACHA_LANES_TARGET
+#include "internal-chacha-lanes.h"
+#endif
+
+/* 256-bit kernel for AVX2 */
+#if CHACHA_HAVE_X8
+#define CHACHA_LANES_SUFFIX _x8
+#define CHACHA_LANES 8
+#define CHACHA_LANES_TARGET LW_TARGET_AVX2
+#include "internal-chacha-lanes.h"
+#endif
 
 /**
- * \brief Temporary output for the generation of data between re-keying.
+ * \brief Automatically re-key every 16K of output data.  This can be adjusted.
  */
-static uint32_t aead_chacha_output[16];
+#define AEAD_PRNG_MAX_BLOCKS 256
 
 /**
- * \brief Position of the next word to return from the PRNG.
+ * \brief Initial state of the ChaCha20 input block, which is the string
+ * "expand 32-byte k" followed by zeroes.
  */
-static uint8_t aead_chacha_posn = 16;
+static const uint32_t aead_chacha_constants[4] = {
+    0x61707865, 0x3320646e, 0x79622d32, 0x6b206574
+};
 
 /**
- * \brief Number of blocks that have been generated since the last re-key.
+ * \brief Re-keys the PRNG state to enforce forward secrecy.
+ *
+ * \param ctx The PRNG context.
+ *
+ * This function generates a new output block and then copies the first
+ * 384 bits of the output to the last 384 bits of the state, which will
+ * destroy any chance of going backwards.
  */
-static uint16_t aead_chacha_blocks = 0;
+static void aead_chacha_rekey(aead_random_ctx_t *ctx)
+{
+    ++(ctx->state[15]);
+    aead_chacha_core(ctx->output, ctx->state);
+    memcpy(ctx->state + 4, ctx->output, 48);
+    ctx->posn = 16;
+    ctx->blocks = 0;
+}
 
 /**
- * \brief Automatically re-key every 16K of output data.  This can be adjusted.
+ * \brief Generates the next output block for a PRNG context and returns
+ * the first word, reseeding the context first if necessary.
+ *
+ * \param ctx The PRNG context.
+ *
+ * \return The first word of the new output block.
  */
-#define AEAD_PRNG_MAX_BLOCKS 256
+static uint32_t aead_chacha_refill(aead_random_ctx_t *ctx)
+{
+    /* Seed the context on first use and after fork() */
+    if (!ctx->seeded || ctx->fork_id != aead_random_fork_count)
+        aead_random_ctx_reseed(ctx);
+
+    /* Re-key if we have generated too many blocks since the last re-key */
+    ++(ctx->blocks);
+    if (ctx->blocks >= AEAD_PRNG_MAX_BLOCKS)
+        aead_chacha_rekey(ctx);
+
+    /* Increment the block counter and generate a new output block */
+    ++(ctx->state[15]);
+    aead_chacha_core(ctx->output, ctx->state);
+    ctx->posn = 1;
+    return ctx->output[0];
+}
 
 /**
- * \brief Re-keys the PRNG state to enforce forward secrecy.
+ * \brief Generates several output blocks from a PRNG context at once.
  *
- * This function generates a new output block and then copies the first
- * 384 bits of the output to the last 384 bits of aead_chacha_state,
- * which will destroy any chance of going backwards.
+ * \param ctx The PRNG context.
+ * \param output Output buffer for the blocks.
+ * \param blocks Number of blocks to generate.
+ *
+ * The blocks are generated directly into \a output without disturbing
+ * the buffered output words in \a ctx.  The multi-block kernels are used
+ * if they are available.  A batch never crosses the point where the
+ * context is re-keyed, so the output is the same as calling
+ * aead_chacha_refill() for each block in turn.
  */
-static void aead_chacha_rekey(void)
+static void aead_chacha_generate_blocks
+    (aead_random_ctx_t *ctx, uint32_t *output, unsigned blocks)
 {
-    ++(aead_chacha_state[15]);
-    aead_chacha_core(aead_chacha_output, aead_chacha_state);
-    memcpy(aead_chacha_state + 4, aead_chacha_output, 48);
-    aead_chacha_posn = 16;
-    aead_chacha_blocks = 0;
+    unsigned count;
+
+    /* Seed the context on first use and after fork() */
+    if (!ctx->seeded || ctx->fork_id != aead_random_fork_count)
+        aead_random_ctx_reseed(ctx);
+
+    /* Generate the blocks, re-keying every AEAD_PRNG_MAX_BLOCKS */
+    while (blocks > 0) {
+        /* Re-key at the same block as aead_chacha_refill() would */
+        if ((ctx->blocks + 1) >= AEAD_PRNG_MAX_BLOCKS) {
+            aead_chacha_rekey(ctx);
+            ++(ctx->state[15]);
+            aead_chacha_core(output, ctx->state);
+            output += 16;
+            --blocks;
+            continue;
+        }
+
+        /* Limit the batch to the blocks that are left before the re-key */
+        count = AEAD_PRNG_MAX_BLOCKS - 1 - ctx->blocks;
+        if (count > blocks)
+            count = blocks;
+#if CHACHA_HAVE_X8
+        if (count >= 8 && chacha_can_use_x8())
+            count = 8;
+        else
+#endif
+#if CHACHA_HAVE_X4
+        if (count >= 4)
+            count = 4;
+        else
+#endif
+            count = 1;
+        ctx->blocks += count;
+        ++(ctx->state[15]);
+#if CHACHA_HAVE_X8
+        if (count == 8)
+            chacha_core_lanes_x8(output, ctx->state, 15);
+        else
+#endif
+#if CHACHA_HAVE_X4
+        if (count == 4)
+            chacha_core_lanes_x4(output, ctx->state, 15);
+        else
+#endif
+            aead_chacha_core(output, ctx->state);
+        ctx->state[15] += count - 1;
+        output += 16 * count;
+        blocks -= count;
+    }
 }
 
 /* Defined if we are using the ChaCha20-based PRNG */
 #define aead_system_random_is_chacha 1
 
+/**
+ * \brief Default PRNG context for the calling thread.
+ *
+ * The context starts off unseeded and is seeded from the system the
+ * first time that it is used.
+ */
+static AEAD_RANDOM_THREAD_LOCAL aead_random_ctx_t aead_random_default_ctx;
+
 #endif /* AEAD_USE_PRNG */
 
-void aead_random_init(void)
+void aead_random_ctx_init(aead_random_ctx_t *ctx)
 {
+    /* Clear the context first so that the reseed below sets up the
+     * constants and counter regardless of the caller's prior contents */
     aead_system_random_init();
+    memset(ctx, 0, sizeof(aead_random_ctx_t));
 #if defined(aead_system_random_is_chacha)
-    aead_random_reseed();
+    aead_random_ctx_reseed(ctx);
 #endif
 }
 
-void aead_random_finish(void)
+void aead_random_ctx_finish(aead_random_ctx_t *ctx)
 {
 #if defined(aead_system_random_is_chacha)
-    /* Re-key the random number generator to enforce forward secrecy */
-    aead_chacha_rekey();
+    /* Re-key the random number generator to enforce forward secrecy,
+     * and then destroy the last output block which holds the new key */
+    if (ctx->seeded)
+        aead_chacha_rekey(ctx);
+    memset(ctx->output, 0, sizeof(ctx->output));
+#else
+    (void)ctx;
 #endif
 }
 
-uint32_t aead_random_generate_32(void)
+uint32_t aead_random_ctx_generate_32(aead_random_ctx_t *ctx)
 {
 #if defined(aead_system_random_is_chacha)
-    if (aead_chacha_posn < 16) {
+    if (ctx->posn < 16 && ctx->seeded &&
+            ctx->fork_id == aead_random_fork_count) {
         /* We still have data in the previous block */
-        return aead_chacha_output[aead_chacha_posn++];
-    } else {
-        /* Re-key if we have generated too many blocks since the last re-key */
-        ++aead_chacha_blocks;
-        if (aead_chacha_blocks >= AEAD_PRNG_MAX_BLOCKS)
-            aead_chacha_rekey();
-
-        /* Increment the block counter and generate a new output block */
-        ++(aead_chacha_state[15]);
-        aead_chacha_core(aead_chacha_output, aead_chacha_state);
-        aead_chacha_posn = 1;
-        return aead_chacha_output[0];
+        return ctx->output[ctx->posn++];
     }
+    return aead_chacha_refill(ctx);
 #elif defined(aead_system_random_is_64bit)
     uint64_t x;
+    (void)ctx;
     aead_system_random(x);
     return (uint32_t)x;
 #else
     uint32_t x;
+    (void)ctx;
     aead_system_random(x);
     return x;
 #endif
 }
 
-uint64_t aead_random_generate_64(void)
+uint64_t aead_random_ctx_generate_64(aead_random_ctx_t *ctx)
 {
 #if defined(aead_system_random_is_chacha)
     uint32_t x, y;
-    x = aead_random_generate_32();
-    y = aead_random_generate_32();
+    x = aead_random_ctx_generate_32(ctx);
+    y = aead_random_ctx_generate_32(ctx);
     return x | (((uint64_t)y) << 32);
 #elif defined(aead_system_random_is_64bit)
     uint64_t x;
+    (void)ctx;
     aead_system_random(x);
     return x;
 #else
     uint32_t x, y;
+    (void)ctx;
     aead_system_random(x);
     aead_system_random(y);
     return x | (((uint64_t)y) << 32);
 #endif
 }
 
-void aead_random_generate(void *buffer, unsigned size)
+void aead_random_ctx_generate
+    (aead_random_ctx_t *ctx, void *buffer, unsigned size)
 {
 #if defined(aead_system_random_is_chacha)
     unsigned char *buf = (unsigned char *)buffer;
     uint32_t x;
     while (size >= sizeof(uint32_t)) {
-        x = aead_random_generate_32();
+        x = aead_random_ctx_generate_32(ctx);
         memcpy(buf, &x, sizeof(x));
         buf += sizeof(uint32_t);
         size -= sizeof(uint32_t);
     }
     if (size > 0) {
-        x = aead_random_generate_32();
+        x = aead_random_ctx_generate_32(ctx);
         memcpy(buf, &x, size);
     }
 #elif defined(aead_system_random_is_64bit)
     unsigned char *buf = (unsigned char *)buffer;
     uint64_t x;
+    (void)ctx;
     while (size >= sizeof(uint64_t)) {
         aead_system_random(x);
         memcpy(buf, &x, sizeof(x));
@@ -318,6 +496,7 @@ void aead_random_generate(void *buffer, unsigned size)
 #else
     unsigned char *buf = (unsigned char *)buffer;
     uint32_t x;
+    (void)ctx;
     while (size >= sizeof(uint32_t)) {
         aead_system_random(x);
         memcpy(buf, &x, sizeof(x));
@@ -331,31 +510,39 @@ void aead_random_generate(void *buffer, unsigned size)
 #endif
 }
 
-void aead_random_reseed(void)
+void aead_random_ctx_reseed(aead_random_ctx_t *ctx)
 {
 #if defined(aead_system_random_is_chacha)
+    /* Set up the constants and counter if this is the first seeding */
+    if (!ctx->seeded) {
+        memcpy(ctx->state, aead_chacha_constants, sizeof(aead_chacha_constants));
+        memset(ctx->state + 4, 0, 48);
+        ctx->seeded = 1;
+    }
+    ctx->fork_id = aead_random_fork_seed_id();
+
     /* If we have a system TRNG, then use it to reseed the PRNG state */
 #if defined(aead_system_random) && defined(aead_system_random_is_64bit)
     uint8_t index;
     uint64_t x;
     for (index = 4; index < 12; index += 2) {
         aead_system_random(x);
-        aead_chacha_state[index] = (uint32_t)x;
-        aead_chacha_state[index + 1] = (uint32_t)(x >> 32);
+        ctx->state[index] = (uint32_t)x;
+        ctx->state[index + 1] = (uint32_t)(x >> 32);
     }
 #elif defined(aead_system_random)
     uint8_t index;
     for (index = 4; index < 12; ++index)
-        aead_system_random(aead_chacha_state[index]);
+        aead_system_random(ctx->state[index]);
 #elif defined(ARDUINO)
     /* XOR in the current Arduino time to provide a little jitter.
      * These values may be predictable but they are better than nothing. */
-    aead_chacha_state[4] ^= millis();
-    aead_chacha_state[5] ^= micros();
+    ctx->state[4] ^= millis();
+    ctx->state[5] ^= micros();
 #elif defined(__linux__)
     /* Use the getrandom() system call to seed the PRNG if we have it */
 #if defined(SYS_getrandom)
-    if (syscall(SYS_getrandom, aead_chacha_state + 4, 32, 0) != 32)
+    if (syscall(SYS_getrandom, ctx->state + 4, 32, 0) != 32)
 #endif
     {
         /* Fall back to /dev/urandom to seed the PRNG.  If for some reason
@@ -363,36 +550,135 @@ void aead_random_reseed(void)
         int seeded = 0;
         int fd = open("/dev/urandom", O_RDONLY);
         if (fd >= 0) {
-            if (read(fd, aead_chacha_state + 4, 32) == 32)
+            if (read(fd, ctx->state + 4, 32) == 32)
                 seeded = 1;
             close(fd);
         }
         if (!seeded) {
             struct timeval tv;
             gettimeofday(&tv, NULL);
-            aead_chacha_state[4] ^= (uint32_t)(tv.tv_sec);
-            aead_chacha_state[5] ^= (uint32_t)(tv.tv_usec);
+            ctx->state[4] ^= (uint32_t)(tv.tv_sec);
+            ctx->state[5] ^= (uint32_t)(tv.tv_usec);
         }
     }
 #endif
 
     /* Re-key the PRNG to enforce forward secrecy */
-    aead_chacha_rekey();
+    aead_chacha_rekey(ctx);
+#else
+    (void)ctx;
 #endif
 }
 
-void aead_random_set_seed(const unsigned char seed[32])
+void aead_random_ctx_set_seed
+    (aead_random_ctx_t *ctx, const unsigned char seed[32])
 {
 #if defined(aead_system_random_is_chacha)
     /* Copy the provided seed into place and then re-key the PRNG.
      * We load the seed in a way that ensures the same output on
      * both little-endian and big-endian machines. */
     int index;
+    memcpy(ctx->state, aead_chacha_constants, sizeof(aead_chacha_constants));
     for (index = 0; index < 8; ++index)
-        aead_chacha_state[index + 4] = le_load_word32(seed + index * 4);
-    memset(aead_chacha_state + 12, 0, 16);
-    aead_chacha_rekey();
+        ctx->state[index + 4] = le_load_word32(seed + index * 4);
+    memset(ctx->state + 12, 0, 16);
+    ctx->seeded = 1;
+    ctx->fork_id = aead_random_fork_seed_id();
+    aead_chacha_rekey(ctx);
 #else
+    (void)ctx;
     (void)seed;
 #endif
 }
+
+/* The functions without a context use the default context for the thread */
+#if defined(aead_system_random_is_chacha)
+#define AEAD_RANDOM_DEFAULT_CTX (&aead_random_default_ctx)
+#else
+#define AEAD_RANDOM_DEFAULT_CTX ((aead_random_ctx_t *)0)
+#endif
+
+void aead_random_pool_init(aead_random_pool_t *pool, aead_random_ctx_t *ctx)
+{
+    pool->posn = 0;
+    pool->count = 0;
+    pool->fork_id = 0;
+    pool->ctx = ctx;
+}
+
+void aead_random_pool_finish(aead_random_pool_t *pool)
+{
+    memset(pool->words, 0, sizeof(pool->words));
+    pool->posn = 0;
+    pool->count = 0;
+}
+
+uint32_t aead_random_pool_refill_32(aead_random_pool_t *pool)
+{
+    aead_random_ctx_t *ctx = pool->ctx ? pool->ctx : AEAD_RANDOM_DEFAULT_CTX;
+#if defined(aead_system_random_is_chacha)
+    aead_chacha_generate_blocks(ctx, pool->words, AEAD_RANDOM_POOL_BLOCKS);
+    pool->count = AEAD_RANDOM_POOL_WORDS;
+#else
+    /* There is no per-call cost to spread out when using the TRNG
+     * directly, so only fetch as many words as a single block holds */
+    aead_random_ctx_generate(ctx, pool->words, 16 * sizeof(uint32_t));
+    pool->count = 16;
+#endif
+    pool->posn = 1;
+    pool->fork_id = aead_random_fork_seed_id();
+    return pool->words[0];
+}
+
+void aead_random_init(void)
+{
+    aead_system_random_init();
+#if defined(aead_system_random_is_chacha)
+    aead_random_ctx_reseed(AEAD_RANDOM_DEFAULT_CTX);
+#endif
+    aead_random_pool_finish(&aead_random_default_pool);
+}
+
+void aead_random_finish(void)
+{
+#if defined(aead_system_random_is_chacha)
+    aead_random_ctx_finish(AEAD_RANDOM_DEFAULT_CTX);
+#endif
+    aead_random_pool_finish(&aead_random_default_pool);
+}
+
+uint32_t aead_random_generate_32(void)
+{
+    return aead_random_ctx_generate_32(AEAD_RANDOM_DEFAULT_CTX);
+}
+
+uint64_t aead_random_generate_64(void)
+{
+    return aead_random_ctx_generate_64(AEAD_RANDOM_DEFAULT_CTX);
+}
+
+void aead_random_generate(void *buffer, unsigned size)
+{
+    aead_random_ctx_generate(AEAD_RANDOM_DEFAULT_CTX, buffer, size);
+}
+
+void aead_random_reseed(void)
+{
+    aead_random_ctx_reseed(AEAD_RANDOM_DEFAULT_CTX);
+    aead_random_pool_finish(&aead_random_default_pool);
+}
+
+void aead_random_set_seed(const unsigned char seed[32])
+{
+    aead_random_ctx_set_seed(AEAD_RANDOM_DEFAULT_CTX, seed);
+    aead_random_pool_finish(&aead_random_default_pool);
+}
+
+int aead_random_is_prng(void)
+{
+#if defined(aead_system_random_is_chacha)
+    return 1;
+#else
+    return 0;
+#endif
+}
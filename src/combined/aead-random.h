@@ -19,9 +19,112 @@
 extern "C" {
 #endif
 
+/**
+ * \brief Context for a random number generator.
+ *
+ * If the random API is using a ChaCha20-based PRNG, then the state of
+ * the PRNG is kept in a context.  The functions that do not take a
+ * context, such as aead_random_generate_32(), use a default context.
+ * When the library is built with LW_USE_PTHREADS, each thread has its
+ * own default context so that threads do not need to share a lock.
+ *
+ * Applications can also create their own contexts and pass them to the
+ * aead_random_ctx_*() functions explicitly.  A context that is all-zeroes
+ * is seeded from the system automatically the first time that it is used.
+ *
+ * After a fork(), contexts in the child process discard their buffered
+ * output and are reseeded before they are next used so that the child
+ * does not repeat the parent's output.
+ *
+ * The fields in this structure are private.
+ */
+typedef struct
+{
+    uint32_t state[16];     /**< ChaCha20 input block for the PRNG */
+    uint32_t output[16];    /**< Current output block */
+    uint32_t fork_id;       /**< Fork count when the context was seeded */
+    uint16_t blocks;        /**< Number of blocks since the last re-key */
+    uint8_t posn;           /**< Position of the next output word */
+    uint8_t seeded;         /**< Non-zero if the context has been seeded */
+
+} aead_random_ctx_t;
+
+/**
+ * \def AEAD_RANDOM_THREAD_LOCAL
+ * \brief Storage class for the default random state, which is
+ * thread-local if the library is built with LW_USE_PTHREADS.
+ */
+#if defined(LW_USE_PTHREADS)
+#define AEAD_RANDOM_THREAD_LOCAL __thread
+#else
+#define AEAD_RANDOM_THREAD_LOCAL
+#endif
+
+/**
+ * \def AEAD_RANDOM_POOL_BLOCKS
+ * \brief Number of ChaCha20 blocks to generate each time a pool of
+ * random words is refilled.
+ *
+ * Each block is 64 bytes of pool storage, and the default pool is a
+ * static variable in every program that uses masking.  Larger pools
+ * spread the cost of a refill call over more words, and only pools of
+ * 8 blocks or more can use the 8-way ChaCha20 kernel.  AVR uses a single
+ * block to keep the pool small.  To override the default, define this
+ * on the command line for the library and for the code that uses it,
+ * because it changes the size of aead_random_pool_t.
+ *
+ * When the system TRNG is used directly, a refill only fetches 16 words
+ * from the TRNG, however large the pool is.
+ */
+#if !defined(AEAD_RANDOM_POOL_BLOCKS)
+#if defined(__AVR__)
+#define AEAD_RANDOM_POOL_BLOCKS 1
+#else
+#define AEAD_RANDOM_POOL_BLOCKS 8
+#endif
+#endif
+
+/**
+ * \brief Number of 32-bit words in a pool of random words.
+ */
+#define AEAD_RANDOM_POOL_WORDS (AEAD_RANDOM_POOL_BLOCKS * 16)
+
+/**
+ * \brief Pool of pre-generated random words for masking.
+ *
+ * Masked permutations consume hundreds of fresh random words per call.
+ * Rather than calling into the random number generator for every word,
+ * they take words from a pool that is refilled several blocks at a time.
+ * Taking a word from the pool is inline and only refills cost a call.
+ *
+ * A pool that is all-zeroes is empty and uses the default context.
+ * After a fork(), pools in the child process discard the words that
+ * were generated in the parent and are refilled before they are next used.
+ */
+typedef struct
+{
+    uint32_t words[AEAD_RANDOM_POOL_WORDS]; /**< Pre-generated words */
+    unsigned posn;                  /**< Position of the next word */
+    unsigned count;                 /**< Number of valid words in the pool */
+    uint32_t fork_id;               /**< Fork count when the pool was filled */
+    aead_random_ctx_t *ctx;         /**< Context to refill from, or NULL */
+
+} aead_random_pool_t;
+
+/**
+ * \brief Number of fork() calls between the original process and this one.
+ *
+ * This is private to the random API.  It is declared here so that the
+ * inline pool functions can detect a fork() without calling getpid().
+ */
+extern volatile uint32_t aead_random_fork_count;
+
+
 /**
  * \brief Initializes the system random number generator for the
  * generation of masking material.
+ *
+ * This reseeds the default context for the calling thread.
  */
 void aead_random_init(void);
 
@@ -61,6 +164,7 @@ void aead_random_generate(void *buffer, unsigned size);
  * This function does nothing if the random API is using the
  * system TRNG directly.
  *
+ * The pool of random words for the masked ciphers is emptied.
  * This function is called implicitly by aead_random_init().
  */
 void aead_random_reseed(void);
@@ -73,9 +177,145 @@ void aead_random_reseed(void);
  * This function does nothing if the random API is using the system
  * TRNG directly.  This function is useful for creating reproducible
  * random numbers for test purposes.  It should not be used for real work.
+ *
+ * Any random words that were pre-generated for the masked ciphers are
+ * discarded so that they also come from the new seed.
  */
 void aead_random_set_seed(const unsigned char seed[32]);
 
+/**
+ * \brief Determines if the random API is using the ChaCha20-based PRNG.
+ *
+ * \return Non-zero if the PRNG is in use, or zero if the random API is
+ * using the system TRNG directly.
+ *
+ * The seeding functions aead_random_set_seed() and aead_random_ctx_set_seed()
+ * only produce reproducible output if this function returns non-zero.
+ */
+int aead_random_is_prng(void);
+
+/**
+ * \brief Initializes a random number generator context and seeds it
+ * from the system.
+ *
+ * \param ctx The context to initialize.
+ */
+void aead_random_ctx_init(aead_random_ctx_t *ctx);
+
+/**
+ * \brief Finishes using a random number generator context.
+ *
+ * \param ctx The context.
+ *
+ * The context is re-keyed to protect forward secrecy.  It can continue
+ * to be used afterwards.
+ */
+void aead_random_ctx_finish(aead_random_ctx_t *ctx);
+
+/**
+ * \brief Generates a single random 32-bit word using a context.
+ *
+ * \param ctx The context.
+ *
+ * \return The random word.
+ */
+uint32_t aead_random_ctx_generate_32(aead_random_ctx_t *ctx);
+
+/**
+ * \brief Generates a single random 64-bit word using a context.
+ *
+ * \param ctx The context.
+ *
+ * \return The random word.
+ */
+uint64_t aead_random_ctx_generate_64(aead_random_ctx_t *ctx);
+
+/**
+ * \brief Generates a number of bytes into a buffer using a context.
+ *
+ * \param ctx The context.
+ * \param buffer The buffer to generate into.
+ * \param size The number of bytes to be generated.
+ */
+void aead_random_ctx_generate
+    (aead_random_ctx_t *ctx, void *buffer, unsigned size);
+
+/**
+ * \brief Reseeds a random number generator context from the system TRNG.
+ *
+ * \param ctx The context.
+ */
+void aead_random_ctx_reseed(aead_random_ctx_t *ctx);
+
+/**
+ * \brief Restarts a random number generator context with a specific
+ * 256-bit seed.
+ *
+ * \param ctx The context.
+ * \param seed The seed material.
+ *
+ * This function is useful for creating reproducible random numbers
+ * for test purposes.  It should not be used for real work.
+ */
+void aead_random_ctx_set_seed
+    (aead_random_ctx_t *ctx, const unsigned char seed[32]);
+
+/**
+ * \brief Initializes a pool of random words.
+ *
+ * \param pool The pool to initialize.
+ * \param ctx The context to refill the pool from, or NULL to use the
+ * default context for the thread that refills the pool.
+ */
+void aead_random_pool_init(aead_random_pool_t *pool, aead_random_ctx_t *ctx);
+
+/**
+ * \brief Wipes the words in a pool of random words and empties it.
+ *
+ * \param pool The pool to wipe.
+ */
+void aead_random_pool_finish(aead_random_pool_t *pool);
+
+/**
+ * \brief Refills a pool of random words and returns the first word.
+ *
+ * \param pool The pool to refill.
+ *
+ * \return The first random word from the refilled pool.
+ *
+ * This is normally called via aead_random_pool_generate_32() when the
+ * pool runs out of words.
+ */
+uint32_t aead_random_pool_refill_32(aead_random_pool_t *pool);
+
+/**
+ * \brief Takes a single random 32-bit word from a pool.
+ *
+ * \param pool The pool.
+ *
+ * \return The random word.
+ */
+static inline uint32_t aead_random_pool_generate_32(aead_random_pool_t *pool)
+{
+    if (pool->posn < pool->count && pool->fork_id == aead_random_fork_count)
+        return pool->words[pool->posn++];
+    return aead_random_pool_refill_32(pool);
+}
+
+/**
+ * \brief Takes a single random 64-bit word from a pool.
+ *
+ * \param pool The pool.
+ *
+ * \return The random word.
+ */
+static inline uint64_t aead_random_pool_generate_64(aead_random_pool_t *pool)
+{
+    uint32_t x = aead_random_pool_generate_32(pool);
+    uint32_t y = aead_random_pool_generate_32(pool);
+    return x | (((uint64_t)y) << 32);
+}
+
 #ifdef __cplusplus
 }
 #endif
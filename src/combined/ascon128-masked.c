@@ -20,6 +20,7 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include "internal-masking.h"
 #include "ascon128-masked.h"
 #include "internal-ascon.h"
 #include "internal-ascon-m.h"
@@ -41,7 +42,7 @@
 #define ASCON80PQ_MASKED_IV 0xa0400c0600000000ULL
 
 aead_cipher_t const ascon128_masked_cipher = {
-    "ASCON-128-Masked",
+    AEAD_MASKING_CIPHER_NAME("ASCON-128-Masked"),
     ASCON128_MASKED_KEY_SIZE,
     ASCON128_MASKED_NONCE_SIZE,
     ASCON128_MASKED_TAG_SIZE,
@@ -51,11 +52,17 @@ aead_cipher_t const ascon128_masked_cipher = {
     AEAD_FLAG_SC_PROTECT_ALL,
 #endif
     ascon128_masked_aead_encrypt,
-    ascon128_masked_aead_decrypt
+    ascon128_masked_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_cipher_t const ascon128a_masked_cipher = {
-    "ASCON-128a-Masked",
+    AEAD_MASKING_CIPHER_NAME("ASCON-128a-Masked"),
     ASCON128_MASKED_KEY_SIZE,
     ASCON128_MASKED_NONCE_SIZE,
     ASCON128_MASKED_TAG_SIZE,
@@ -65,11 +72,17 @@ aead_cipher_t const ascon128a_masked_cipher = {
     AEAD_FLAG_SC_PROTECT_ALL,
 #endif
     ascon128a_masked_aead_encrypt,
-    ascon128a_masked_aead_decrypt
+    ascon128a_masked_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_cipher_t const ascon80pq_masked_cipher = {
-    "ASCON-80pq-Masked",
+    AEAD_MASKING_CIPHER_NAME("ASCON-80pq-Masked"),
     ASCON80PQ_MASKED_KEY_SIZE,
     ASCON80PQ_MASKED_NONCE_SIZE,
     ASCON80PQ_MASKED_TAG_SIZE,
@@ -79,7 +92,13 @@ aead_cipher_t const ascon80pq_masked_cipher = {
     AEAD_FLAG_SC_PROTECT_ALL,
 #endif
     ascon80pq_masked_aead_encrypt,
-    ascon80pq_masked_aead_decrypt
+    ascon80pq_masked_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 #if AEAD_MASKING_KEY_ONLY
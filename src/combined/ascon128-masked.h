@@ -81,16 +81,70 @@ extern "C" {
  */
 extern aead_cipher_t const ascon128_masked_cipher;
 
+/**
+ * \brief Meta-information block for the masked ASCON-128 cipher with
+ * 2 shares.
+ */
+extern aead_cipher_t const ascon128_masked_cipher_x2;
+
+/**
+ * \brief Meta-information block for the masked ASCON-128 cipher with
+ * 3 shares.
+ */
+extern aead_cipher_t const ascon128_masked_cipher_x3;
+
+/**
+ * \brief Meta-information block for the masked ASCON-128 cipher with
+ * 4 shares.
+ */
+extern aead_cipher_t const ascon128_masked_cipher_x4;
+
 /**
  * \brief Meta-information block for the masked ASCON-128a cipher.
  */
 extern aead_cipher_t const ascon128a_masked_cipher;
 
+/**
+ * \brief Meta-information block for the masked ASCON-128a cipher with
+ * 2 shares.
+ */
+extern aead_cipher_t const ascon128a_masked_cipher_x2;
+
+/**
+ * \brief Meta-information block for the masked ASCON-128a cipher with
+ * 3 shares.
+ */
+extern aead_cipher_t const ascon128a_masked_cipher_x3;
+
+/**
+ * \brief Meta-information block for the masked ASCON-128a cipher with
+ * 4 shares.
+ */
+extern aead_cipher_t const ascon128a_masked_cipher_x4;
+
 /**
  * \brief Meta-information block for the masked ASCON-80pq cipher.
  */
 extern aead_cipher_t const ascon80pq_masked_cipher;
 
+/**
+ * \brief Meta-information block for the masked ASCON-80pq cipher with
+ * 2 shares.
+ */
+extern aead_cipher_t const ascon80pq_masked_cipher_x2;
+
+/**
+ * \brief Meta-information block for the masked ASCON-80pq cipher with
+ * 3 shares.
+ */
+extern aead_cipher_t const ascon80pq_masked_cipher_x3;
+
+/**
+ * \brief Meta-information block for the masked ASCON-80pq cipher with
+ * 4 shares.
+ */
+extern aead_cipher_t const ascon80pq_masked_cipher_x4;
+
 /**
  * \brief Encrypts and authenticates a packet with masked ASCON-128.
  *
@@ -39,6 +39,69 @@
  */
 #define ASCON80PQ_IV    0xa0400c06U
 
+/**
+ * \brief Incremental AEAD functions for ASCON-128.
+ */
+static aead_stream_cipher_t const ascon128_stream_cipher = {
+    sizeof(ascon_aead_state_t),
+    (aead_stream_init_t)ascon128_aead_stream_init,
+    (aead_stream_update_ad_t)ascon_aead_stream_update_ad,
+    (aead_stream_crypt_t)ascon_aead_stream_encrypt,
+    (aead_stream_crypt_t)ascon_aead_stream_decrypt,
+    (aead_stream_encrypt_finalize_t)ascon_aead_stream_encrypt_finalize,
+    (aead_stream_decrypt_finalize_t)ascon_aead_stream_decrypt_finalize
+};
+
+/**
+ * \brief Incremental AEAD functions for ASCON-128a.
+ */
+static aead_stream_cipher_t const ascon128a_stream_cipher = {
+    sizeof(ascon_aead_state_t),
+    (aead_stream_init_t)ascon128a_aead_stream_init,
+    (aead_stream_update_ad_t)ascon_aead_stream_update_ad,
+    (aead_stream_crypt_t)ascon_aead_stream_encrypt,
+    (aead_stream_crypt_t)ascon_aead_stream_decrypt,
+    (aead_stream_encrypt_finalize_t)ascon_aead_stream_encrypt_finalize,
+    (aead_stream_decrypt_finalize_t)ascon_aead_stream_decrypt_finalize
+};
+
+/**
+ * \brief Incremental AEAD functions for ASCON-80pq.
+ */
+static aead_stream_cipher_t const ascon80pq_stream_cipher = {
+    sizeof(ascon_aead_state_t),
+    (aead_stream_init_t)ascon80pq_aead_stream_init,
+    (aead_stream_update_ad_t)ascon_aead_stream_update_ad,
+    (aead_stream_crypt_t)ascon_aead_stream_encrypt,
+    (aead_stream_crypt_t)ascon_aead_stream_decrypt,
+    (aead_stream_encrypt_finalize_t)ascon_aead_stream_encrypt_finalize,
+    (aead_stream_decrypt_finalize_t)ascon_aead_stream_decrypt_finalize
+};
+
+/**
+ * \brief Encrypts a batch of packets with ASCON-128.
+ *
+ * \param items Points to the descriptors for the packets.
+ * \param count Number of packets in the batch.
+ */
+static void ascon128_batch_encrypt(aead_batch_item_t *items, size_t count);
+
+/**
+ * \brief Decrypts a batch of packets with ASCON-128.
+ *
+ * \param items Points to the descriptors for the packets.
+ * \param count Number of packets in the batch.
+ */
+static void ascon128_batch_decrypt(aead_batch_item_t *items, size_t count);
+
+/**
+ * \brief Batch AEAD functions for ASCON-128.
+ */
+static aead_batch_cipher_t const ascon128_batch_cipher = {
+    ascon128_batch_encrypt,
+    ascon128_batch_decrypt
+};
+
 aead_cipher_t const ascon128_cipher = {
     "ASCON-128",
     ASCON128_KEY_SIZE,
@@ -46,7 +109,13 @@ aead_cipher_t const ascon128_cipher = {
     ASCON128_TAG_SIZE,
     AEAD_FLAG_NONE,
     ascon128_aead_encrypt,
-    ascon128_aead_decrypt
+    ascon128_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    &ascon128_stream_cipher,
+    &ascon128_batch_cipher
 };
 
 aead_cipher_t const ascon128a_cipher = {
@@ -56,7 +125,13 @@ aead_cipher_t const ascon128a_cipher = {
     ASCON128_TAG_SIZE,
     AEAD_FLAG_NONE,
     ascon128a_aead_encrypt,
-    ascon128a_aead_decrypt
+    ascon128a_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    &ascon128a_stream_cipher,
+    0  /* batch */
 };
 
 aead_cipher_t const ascon80pq_cipher = {
@@ -66,7 +141,13 @@ aead_cipher_t const ascon80pq_cipher = {
     ASCON80PQ_TAG_SIZE,
     AEAD_FLAG_NONE,
     ascon80pq_aead_encrypt,
-    ascon80pq_aead_decrypt
+    ascon80pq_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    &ascon80pq_stream_cipher,
+    0  /* batch */
 };
 
 /**
@@ -437,6 +518,298 @@ int ascon128_aead_decrypt
         (m, *mlen, state.B + 24, c + *mlen, ASCON128_TAG_SIZE);
 }
 
+#if ASCON_MAX_LANES == 8
+typedef ascon_x8_state_t ascon128_batch_state_t;
+#define ascon128_batch_permute(state, first_round) \
+    ascon_permute_x8((state), (first_round))
+#else
+typedef ascon_x4_state_t ascon128_batch_state_t;
+#define ascon128_batch_permute(state, first_round) \
+    ascon_permute_x4((state), (first_round))
+#endif
+
+/**
+ * \brief Loads a partial block of up to 7 bytes and pads it.
+ *
+ * \param data Points to the data to load.
+ * \param len Number of bytes to load, between 0 and 7.
+ *
+ * \return The padded 64-bit block.
+ */
+static uint64_t ascon128_batch_load_padded
+    (const unsigned char *data, unsigned len)
+{
+    uint64_t x = 0x80ULL << (56 - len * 8);
+    unsigned index;
+    for (index = 0; index < len; ++index)
+        x |= ((uint64_t)(data[index])) << (56 - index * 8);
+    return x;
+}
+
+/**
+ * \brief Stores the leading bytes of a 64-bit block.
+ *
+ * \param data Points to the buffer to store to.
+ * \param x The 64-bit block to store from.
+ * \param len Number of bytes to store, between 0 and 7.
+ */
+static void ascon128_batch_store_partial
+    (unsigned char *data, uint64_t x, unsigned len)
+{
+    unsigned index;
+    for (index = 0; index < len; ++index)
+        data[index] = (unsigned char)(x >> (56 - index * 8));
+}
+
+/**
+ * \brief Encrypts or decrypts ASCON_MAX_LANES packets in parallel.
+ *
+ * \param out Points to the output buffers for the packets.
+ * \param in Points to the input buffers for the packets.
+ * \param len Length of the payload of each packet, excluding the tag.
+ * \param ad Points to the associated data buffers for the packets.
+ * \param adlen Length of the associated data for each packet.
+ * \param npub Points to the nonces for the packets.
+ * \param k Points to the keys for the packets.
+ * \param tags Receives the computed authentication tags.
+ * \param decrypt Non-zero to decrypt, zero to encrypt.
+ */
+static void ascon128_batch_crypt
+    (unsigned char * const *out, const unsigned char * const *in,
+     unsigned long long len,
+     const unsigned char * const *ad, unsigned long long adlen,
+     const unsigned char * const *npub, const unsigned char * const *k,
+     unsigned char tags[ASCON_MAX_LANES][ASCON128_TAG_SIZE], int decrypt)
+{
+    ascon128_batch_state_t state;
+    unsigned long long posn;
+    unsigned lane, temp;
+    uint64_t x;
+
+    /* Initialize the ASCON states */
+    for (lane = 0; lane < ASCON_MAX_LANES; ++lane) {
+        state.S[0][lane] = ASCON128_IV;
+        state.S[1][lane] = be_load_word64(k[lane]);
+        state.S[2][lane] = be_load_word64(k[lane] + 8);
+        state.S[3][lane] = be_load_word64(npub[lane]);
+        state.S[4][lane] = be_load_word64(npub[lane] + 8);
+    }
+    ascon128_batch_permute(&state, 0);
+    for (lane = 0; lane < ASCON_MAX_LANES; ++lane) {
+        state.S[3][lane] ^= be_load_word64(k[lane]);
+        state.S[4][lane] ^= be_load_word64(k[lane] + 8);
+    }
+
+    /* Absorb the associated data into the states */
+    if (adlen > 0) {
+        for (posn = 0; (posn + 8) <= adlen; posn += 8) {
+            for (lane = 0; lane < ASCON_MAX_LANES; ++lane)
+                state.S[0][lane] ^= be_load_word64(ad[lane] + posn);
+            ascon128_batch_permute(&state, 6);
+        }
+        temp = (unsigned)(adlen - posn);
+        for (lane = 0; lane < ASCON_MAX_LANES; ++lane) {
+            state.S[0][lane] ^=
+                ascon128_batch_load_padded(ad[lane] + posn, temp);
+        }
+        ascon128_batch_permute(&state, 6);
+    }
+
+    /* Separator between the associated data and the payload */
+    for (lane = 0; lane < ASCON_MAX_LANES; ++lane)
+        state.S[4][lane] ^= 1;
+
+    /* Encrypt or decrypt the payload */
+    for (posn = 0; (posn + 8) <= len; posn += 8) {
+        for (lane = 0; lane < ASCON_MAX_LANES; ++lane) {
+            x = be_load_word64(in[lane] + posn);
+            be_store_word64(out[lane] + posn, state.S[0][lane] ^ x);
+            if (decrypt)
+                state.S[0][lane] = x;
+            else
+                state.S[0][lane] ^= x;
+        }
+        ascon128_batch_permute(&state, 6);
+    }
+    temp = (unsigned)(len - posn);
+    for (lane = 0; lane < ASCON_MAX_LANES; ++lane) {
+        x = ascon128_batch_load_padded(in[lane] + posn, temp);
+        ascon128_batch_store_partial
+            (out[lane] + posn, state.S[0][lane] ^ x, temp);
+        if (decrypt) {
+            /* Replace the leading bytes of the rate with the ciphertext
+             * and then add the padding after it */
+            state.S[0][lane] = (state.S[0][lane] & (~0ULL >> (temp * 8))) ^ x;
+        } else {
+            state.S[0][lane] ^= x;
+        }
+    }
+
+    /* Finalize and compute the authentication tags */
+    for (lane = 0; lane < ASCON_MAX_LANES; ++lane) {
+        state.S[1][lane] ^= be_load_word64(k[lane]);
+        state.S[2][lane] ^= be_load_word64(k[lane] + 8);
+    }
+    ascon128_batch_permute(&state, 0);
+    for (lane = 0; lane < ASCON_MAX_LANES; ++lane) {
+        be_store_word64(tags[lane], state.S[3][lane]);
+        be_store_word64(tags[lane] + 8, state.S[4][lane]);
+        lw_xor_block(tags[lane], k[lane], ASCON128_TAG_SIZE);
+    }
+}
+
+void ascon128_aead_encrypt_batch
+    (unsigned char * const *c,
+     const unsigned char * const *m, unsigned long long mlen,
+     const unsigned char * const *ad, unsigned long long adlen,
+     const unsigned char * const *npub,
+     const unsigned char * const *k, size_t count)
+{
+    unsigned char tags[ASCON_MAX_LANES][ASCON128_TAG_SIZE];
+    unsigned long long clen;
+    unsigned lane;
+    while (count >= ASCON_MAX_LANES) {
+        ascon128_batch_crypt
+            (c, m, mlen, ad, adlen, npub, k, tags, 0);
+        for (lane = 0; lane < ASCON_MAX_LANES; ++lane)
+            memcpy(c[lane] + mlen, tags[lane], ASCON128_TAG_SIZE);
+        c += ASCON_MAX_LANES;
+        m += ASCON_MAX_LANES;
+        if (adlen)
+            ad += ASCON_MAX_LANES;
+        npub += ASCON_MAX_LANES;
+        k += ASCON_MAX_LANES;
+        count -= ASCON_MAX_LANES;
+    }
+    while (count > 0) {
+        ascon128_aead_encrypt
+            (*c++, &clen, *m++, mlen, adlen ? *ad++ : 0, adlen,
+             0, *npub++, *k++);
+        --count;
+    }
+}
+
+int ascon128_aead_decrypt_batch
+    (unsigned char * const *m,
+     const unsigned char * const *c, unsigned long long clen,
+     const unsigned char * const *ad, unsigned long long adlen,
+     const unsigned char * const *npub,
+     const unsigned char * const *k, int *results, size_t count)
+{
+    unsigned char tags[ASCON_MAX_LANES][ASCON128_TAG_SIZE];
+    unsigned long long mlen;
+    unsigned lane;
+    int result = 0;
+    int lane_result;
+    if (clen < ASCON128_TAG_SIZE) {
+        while (count-- > 0) {
+            if (results)
+                *results++ = -1;
+        }
+        return -1;
+    }
+    mlen = clen - ASCON128_TAG_SIZE;
+    while (count >= ASCON_MAX_LANES) {
+        ascon128_batch_crypt
+            (m, c, mlen, ad, adlen, npub, k, tags, 1);
+        for (lane = 0; lane < ASCON_MAX_LANES; ++lane) {
+            lane_result = aead_check_tag
+                (m[lane], mlen, tags[lane], c[lane] + mlen,
+                 ASCON128_TAG_SIZE);
+            if (results)
+                *results++ = lane_result;
+            result |= lane_result;
+        }
+        m += ASCON_MAX_LANES;
+        c += ASCON_MAX_LANES;
+        if (adlen)
+            ad += ASCON_MAX_LANES;
+        npub += ASCON_MAX_LANES;
+        k += ASCON_MAX_LANES;
+        count -= ASCON_MAX_LANES;
+    }
+    while (count > 0) {
+        lane_result = ascon128_aead_decrypt
+            (*m++, &mlen, 0, *c++, clen, adlen ? *ad++ : 0, adlen,
+             *npub++, *k++);
+        if (results)
+            *results++ = lane_result;
+        result |= lane_result;
+        --count;
+    }
+    return result;
+}
+
+/**
+ * \brief Encrypts or decrypts a batch of packets with ASCON-128, using
+ * the multi-lane code for runs of packets that have the same lengths.
+ *
+ * \param items Points to the descriptors for the packets.
+ * \param count Number of packets in the batch.
+ * \param decrypt Non-zero to decrypt, zero to encrypt.
+ */
+static void ascon128_batch_items
+    (aead_batch_item_t *items, size_t count, int decrypt)
+{
+    unsigned char *out[ASCON_MAX_LANES];
+    const unsigned char *in[ASCON_MAX_LANES];
+    const unsigned char *ad[ASCON_MAX_LANES];
+    const unsigned char *npub[ASCON_MAX_LANES];
+    const unsigned char *k[ASCON_MAX_LANES];
+    int results[ASCON_MAX_LANES];
+    unsigned long long inlen, adlen;
+    unsigned lanes, lane;
+    while (count > 0) {
+        /* Collect a run of packets with the same lengths */
+        inlen = items[0].inlen;
+        adlen = items[0].adlen;
+        lanes = 0;
+        do {
+            out[lanes] = items[lanes].out;
+            in[lanes] = items[lanes].in;
+            ad[lanes] = items[lanes].ad;
+            npub[lanes] = items[lanes].npub;
+            if (items[lanes].key)
+                k[lanes] = items[lanes].key;
+            else
+                k[lanes] = (const unsigned char *)(items[lanes].ctx);
+            ++lanes;
+        } while (lanes < ASCON_MAX_LANES && lanes < count &&
+                 items[lanes].inlen == inlen && items[lanes].adlen == adlen);
+
+        /* Process the run of packets */
+        if (decrypt) {
+            ascon128_aead_decrypt_batch
+                (out, in, inlen, ad, adlen, npub, k, results, lanes);
+            for (lane = 0; lane < lanes; ++lane) {
+                items[lane].outlen =
+                    (inlen >= ASCON128_TAG_SIZE) ?
+                        (inlen - ASCON128_TAG_SIZE) : 0;
+                items[lane].status = results[lane];
+            }
+        } else {
+            ascon128_aead_encrypt_batch
+                (out, in, inlen, ad, adlen, npub, k, lanes);
+            for (lane = 0; lane < lanes; ++lane) {
+                items[lane].outlen = inlen + ASCON128_TAG_SIZE;
+                items[lane].status = 0;
+            }
+        }
+        items += lanes;
+        count -= lanes;
+    }
+}
+
+static void ascon128_batch_encrypt(aead_batch_item_t *items, size_t count)
+{
+    ascon128_batch_items(items, count, 0);
+}
+
+static void ascon128_batch_decrypt(aead_batch_item_t *items, size_t count)
+{
+    ascon128_batch_items(items, count, 1);
+}
+
 int ascon128a_aead_encrypt
     (unsigned char *c, unsigned long long *clen,
      const unsigned char *m, unsigned long long mlen,
@@ -654,3 +1027,329 @@ int ascon80pq_aead_decrypt
     return aead_check_tag
         (m, *mlen, state.B + 24, c + *mlen, ASCON80PQ_TAG_SIZE);
 }
+
+/**
+ * \brief Mode value for an incremental ASCON state that has not
+ * absorbed any associated data yet.
+ */
+#define ASCON_STREAM_MODE_INIT 0
+
+/**
+ * \brief Mode value for an incremental ASCON state that is absorbing
+ * associated data.
+ */
+#define ASCON_STREAM_MODE_AD 1
+
+/**
+ * \brief Mode value for an incremental ASCON state that is encrypting
+ * or decrypting the payload.
+ */
+#define ASCON_STREAM_MODE_PAYLOAD 2
+
+/**
+ * \brief Permutes an incremental ASCON state, which is kept in
+ * byte form in between calls.
+ *
+ * \param state The state to be permuted.
+ * \param first_round The first round of the permutation to apply.
+ */
+static void ascon_stream_permute(ascon_state_t *state, uint8_t first_round)
+{
+#if ASCON_SLICED
+    ascon_to_sliced(state);
+    ascon_permute_sliced(state, first_round);
+    ascon_from_sliced(state);
+#else
+    ascon_permute(state, first_round);
+#endif
+}
+
+/**
+ * \brief Starts an incremental ASCON operation once the IV has been
+ * stored into the leading bytes of the state.
+ *
+ * \param state The incremental AEAD state.
+ * \param npub Points to the 16 bytes of the nonce.
+ * \param k Points to the key.
+ * \param key_size Size of the key in bytes.
+ * \param rate Number of bytes in each block.
+ * \param first_round First round of the permutation to apply each block.
+ */
+static void ascon_aead_stream_start
+    (ascon_aead_state_t *state, const unsigned char *npub,
+     const unsigned char *k, unsigned key_size, unsigned rate,
+     uint8_t first_round)
+{
+    ascon_state_t *st = (ascon_state_t *)(state->s.state);
+    memcpy(st->B + 24 - key_size, k, key_size);
+    memcpy(st->B + 24, npub, ASCON128_NONCE_SIZE);
+    ascon_stream_permute(st, 0);
+    lw_xor_block(st->B + 40 - key_size, k, key_size);
+    memcpy(state->s.key, k, key_size);
+    state->s.count = 0;
+    state->s.mode = ASCON_STREAM_MODE_INIT;
+    state->s.rate = (unsigned char)rate;
+    state->s.first_round = first_round;
+    state->s.key_size = (unsigned char)key_size;
+}
+
+void ascon128_aead_stream_init
+    (ascon_aead_state_t *state, const unsigned char *npub,
+     const unsigned char *k)
+{
+    be_store_word64(state->s.state, ASCON128_IV);
+    ascon_aead_stream_start(state, npub, k, ASCON128_KEY_SIZE, 8, 6);
+}
+
+void ascon128a_aead_stream_init
+    (ascon_aead_state_t *state, const unsigned char *npub,
+     const unsigned char *k)
+{
+    be_store_word64(state->s.state, ASCON128a_IV);
+    ascon_aead_stream_start(state, npub, k, ASCON128_KEY_SIZE, 16, 4);
+}
+
+void ascon80pq_aead_stream_init
+    (ascon_aead_state_t *state, const unsigned char *npub,
+     const unsigned char *k)
+{
+    be_store_word32(state->s.state, ASCON80PQ_IV);
+    ascon_aead_stream_start(state, npub, k, ASCON80PQ_KEY_SIZE, 8, 6);
+}
+
+void ascon_aead_stream_update_ad
+    (ascon_aead_state_t *state, const unsigned char *ad,
+     unsigned long long adlen)
+{
+    ascon_state_t *st = (ascon_state_t *)(state->s.state);
+    unsigned rate = state->s.rate;
+    unsigned temp;
+
+    /* Nothing to do if there is no associated data */
+    if (!adlen)
+        return;
+    state->s.mode = ASCON_STREAM_MODE_AD;
+
+    /* Fill up a left-over partial block from last time */
+    if (state->s.count) {
+        temp = rate - state->s.count;
+        if (temp > adlen) {
+            temp = (unsigned)adlen;
+            lw_xor_block(st->B + state->s.count, ad, temp);
+            state->s.count += temp;
+            return;
+        }
+        lw_xor_block(st->B + state->s.count, ad, temp);
+        ascon_stream_permute(st, state->s.first_round);
+        state->s.count = 0;
+        ad += temp;
+        adlen -= temp;
+    }
+
+    /* Absorb full blocks */
+#if ASCON_SLICED
+    if (adlen >= rate) {
+        ascon_to_sliced(st);
+        do {
+            ascon_absorb_sliced(st, ad, 0);
+            if (rate == 16)
+                ascon_absorb_sliced(st, ad + 8, 1);
+            ascon_permute_sliced(st, state->s.first_round);
+            ad += rate;
+            adlen -= rate;
+        } while (adlen >= rate);
+        ascon_from_sliced(st);
+    }
+#else
+    while (adlen >= rate) {
+        lw_xor_block(st->B, ad, rate);
+        ascon_permute(st, state->s.first_round);
+        ad += rate;
+        adlen -= rate;
+    }
+#endif
+
+    /* Absorb the left-over partial block; padding is deferred */
+    temp = (unsigned)adlen;
+    lw_xor_block(st->B, ad, temp);
+    state->s.count = temp;
+}
+
+/**
+ * \brief Switches an incremental ASCON state into payload mode if
+ * it is not already in payload mode.
+ *
+ * \param state The incremental AEAD state.
+ */
+static void ascon_aead_stream_start_payload(ascon_aead_state_t *state)
+{
+    ascon_state_t *st = (ascon_state_t *)(state->s.state);
+    if (state->s.mode == ASCON_STREAM_MODE_PAYLOAD)
+        return;
+
+    /* Pad and absorb the last block of associated data */
+    if (state->s.mode == ASCON_STREAM_MODE_AD) {
+        st->B[state->s.count] ^= 0x80;
+        ascon_stream_permute(st, state->s.first_round);
+        state->s.count = 0;
+    }
+
+    /* Separator between the associated data and the payload */
+    st->B[39] ^= 0x01;
+    state->s.mode = ASCON_STREAM_MODE_PAYLOAD;
+}
+
+void ascon_aead_stream_encrypt
+    (ascon_aead_state_t *state, unsigned char *c,
+     const unsigned char *m, unsigned long long len)
+{
+    ascon_state_t *st = (ascon_state_t *)(state->s.state);
+    unsigned rate = state->s.rate;
+    unsigned temp;
+
+    /* Make sure that we are in payload mode */
+    ascon_aead_stream_start_payload(state);
+
+    /* Fill up a left-over partial block from last time */
+    if (state->s.count) {
+        temp = rate - state->s.count;
+        if (temp > len) {
+            temp = (unsigned)len;
+            lw_xor_block_2_dest(c, st->B + state->s.count, m, temp);
+            state->s.count += temp;
+            return;
+        }
+        lw_xor_block_2_dest(c, st->B + state->s.count, m, temp);
+        ascon_stream_permute(st, state->s.first_round);
+        state->s.count = 0;
+        c += temp;
+        m += temp;
+        len -= temp;
+    }
+
+    /* Encrypt full blocks */
+#if ASCON_SLICED
+    if (len >= rate) {
+        ascon_to_sliced(st);
+        do {
+            ascon_encrypt_sliced(st, c, m, 0);
+            if (rate == 16)
+                ascon_encrypt_sliced(st, c + 8, m + 8, 1);
+            ascon_permute_sliced(st, state->s.first_round);
+            c += rate;
+            m += rate;
+            len -= rate;
+        } while (len >= rate);
+        ascon_from_sliced(st);
+    }
+#else
+    while (len >= rate) {
+        lw_xor_block_2_dest(c, st->B, m, rate);
+        ascon_permute(st, state->s.first_round);
+        c += rate;
+        m += rate;
+        len -= rate;
+    }
+#endif
+
+    /* Encrypt the left-over partial block */
+    temp = (unsigned)len;
+    lw_xor_block_2_dest(c, st->B, m, temp);
+    state->s.count = temp;
+}
+
+void ascon_aead_stream_decrypt
+    (ascon_aead_state_t *state, unsigned char *m,
+     const unsigned char *c, unsigned long long len)
+{
+    ascon_state_t *st = (ascon_state_t *)(state->s.state);
+    unsigned rate = state->s.rate;
+    unsigned temp;
+
+    /* Make sure that we are in payload mode */
+    ascon_aead_stream_start_payload(state);
+
+    /* Fill up a left-over partial block from last time */
+    if (state->s.count) {
+        temp = rate - state->s.count;
+        if (temp > len) {
+            temp = (unsigned)len;
+            lw_xor_block_swap(m, st->B + state->s.count, c, temp);
+            state->s.count += temp;
+            return;
+        }
+        lw_xor_block_swap(m, st->B + state->s.count, c, temp);
+        ascon_stream_permute(st, state->s.first_round);
+        state->s.count = 0;
+        c += temp;
+        m += temp;
+        len -= temp;
+    }
+
+    /* Decrypt full blocks */
+#if ASCON_SLICED
+    if (len >= rate) {
+        ascon_to_sliced(st);
+        do {
+            ascon_decrypt_sliced(st, m, c, 0);
+            if (rate == 16)
+                ascon_decrypt_sliced(st, m + 8, c + 8, 1);
+            ascon_permute_sliced(st, state->s.first_round);
+            c += rate;
+            m += rate;
+            len -= rate;
+        } while (len >= rate);
+        ascon_from_sliced(st);
+    }
+#else
+    while (len >= rate) {
+        lw_xor_block_swap(m, st->B, c, rate);
+        ascon_permute(st, state->s.first_round);
+        c += rate;
+        m += rate;
+        len -= rate;
+    }
+#endif
+
+    /* Decrypt the left-over partial block */
+    temp = (unsigned)len;
+    lw_xor_block_swap(m, st->B, c, temp);
+    state->s.count = temp;
+}
+
+/**
+ * \brief Computes the authentication tag for an incremental ASCON state.
+ *
+ * \param state The incremental AEAD state.
+ * \param tag Buffer to receive the 16 byte authentication tag.
+ */
+static void ascon_aead_stream_compute_tag
+    (ascon_aead_state_t *state, unsigned char *tag)
+{
+    ascon_state_t *st = (ascon_state_t *)(state->s.state);
+    unsigned key_size = state->s.key_size;
+
+    /* Pad the final payload block */
+    ascon_aead_stream_start_payload(state);
+    st->B[state->s.count] ^= 0x80;
+
+    /* Finalize and compute the authentication tag */
+    lw_xor_block(st->B + state->s.rate, state->s.key, key_size);
+    ascon_stream_permute(st, 0);
+    lw_xor_block_2_src
+        (tag, st->B + 24, state->s.key + key_size - 16, 16);
+}
+
+void ascon_aead_stream_encrypt_finalize
+    (ascon_aead_state_t *state, unsigned char *tag)
+{
+    ascon_aead_stream_compute_tag(state, tag);
+}
+
+int ascon_aead_stream_decrypt_finalize
+    (ascon_aead_state_t *state, const unsigned char *tag)
+{
+    unsigned char computed[16];
+    ascon_aead_stream_compute_tag(state, computed);
+    return aead_check_tag(0, 0, computed, tag, 16);
+}
@@ -97,6 +97,24 @@ typedef union
 
 } ascon_hash_state_t;
 
+/**
+ * \brief State information for the incremental ASCON AEAD modes.
+ */
+typedef union
+{
+    struct {
+        unsigned char state[40]; /**< Current permutation state */
+        unsigned char key[20];   /**< Key to use during finalization */
+        unsigned char count;     /**< Number of bytes in the current block */
+        unsigned char mode;      /**< Associated data or payload mode */
+        unsigned char rate;      /**< Number of bytes in each block */
+        unsigned char first_round; /**< First round for block permutations */
+        unsigned char key_size;  /**< Size of the key in bytes */
+    } s;                         /**< State */
+    unsigned long long align;    /**< For alignment of this structure */
+
+} ascon_aead_state_t;
+
 /**
  * \brief Meta-information block for the ASCON-128 cipher.
  */
@@ -181,6 +199,66 @@ int ascon128_aead_decrypt
      const unsigned char *npub,
      const unsigned char *k);
 
+/**
+ * \brief Encrypts and authenticates a batch of same-length packets
+ * with ASCON-128.
+ *
+ * \param c Array of \a count buffers to receive the output.  Each buffer
+ * must have space for \a mlen bytes of ciphertext plus the 16 byte tag.
+ * \param m Array of \a count plaintext messages, each \a mlen bytes.
+ * \param mlen Length of every plaintext message in bytes.
+ * \param ad Array of \a count associated data buffers, each \a adlen
+ * bytes.  May be NULL if \a adlen is zero.
+ * \param adlen Length of every associated data buffer in bytes.
+ * \param npub Array of \a count 16 byte nonces.
+ * \param k Array of \a count 16 byte keys.
+ * \param count Number of packets in the batch.
+ *
+ * The packets are independent and may use different keys.  Groups of
+ * ASCON_MAX_LANES packets are processed together with the multi-lane
+ * ASCON permutation and any left-over packets are processed one at a time.
+ * The output is identical to calling ascon128_aead_encrypt() on each packet.
+ *
+ * \sa ascon128_aead_decrypt_batch()
+ */
+void ascon128_aead_encrypt_batch
+    (unsigned char * const *c,
+     const unsigned char * const *m, unsigned long long mlen,
+     const unsigned char * const *ad, unsigned long long adlen,
+     const unsigned char * const *npub,
+     const unsigned char * const *k, size_t count);
+
+/**
+ * \brief Decrypts and authenticates a batch of same-length packets
+ * with ASCON-128.
+ *
+ * \param m Array of \a count buffers to receive the plaintext, each of
+ * which must have space for \a clen - 16 bytes.
+ * \param c Array of \a count ciphertext packets, each \a clen bytes in
+ * length including the 16 byte authentication tag.
+ * \param clen Length of every ciphertext packet in bytes.
+ * \param ad Array of \a count associated data buffers, each \a adlen
+ * bytes.  May be NULL if \a adlen is zero.
+ * \param adlen Length of every associated data buffer in bytes.
+ * \param npub Array of \a count 16 byte nonces.
+ * \param k Array of \a count 16 byte keys.
+ * \param results Array of \a count entries that receive the result for
+ * each packet: 0 on success or -1 if the tag was incorrect.  May be NULL.
+ * \param count Number of packets in the batch.
+ *
+ * \return 0 if every packet was authenticated, or -1 if at least one
+ * packet failed or \a clen is too short.  The plaintext of a packet that
+ * fails authentication is zeroed, as with ascon128_aead_decrypt().
+ *
+ * \sa ascon128_aead_encrypt_batch()
+ */
+int ascon128_aead_decrypt_batch
+    (unsigned char * const *m,
+     const unsigned char * const *c, unsigned long long clen,
+     const unsigned char * const *ad, unsigned long long adlen,
+     const unsigned char * const *npub,
+     const unsigned char * const *k, int *results, size_t count);
+
 /**
  * \brief Encrypts and authenticates a packet with ASCON-128a.
  *
@@ -299,6 +377,118 @@ int ascon80pq_aead_decrypt
      const unsigned char *npub,
      const unsigned char *k);
 
+/**
+ * \brief Initializes the state for an incremental ASCON-128 operation.
+ *
+ * \param state Incremental AEAD state to be initialized.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 16 bytes of the key to use to encrypt or
+ * decrypt the packet.
+ *
+ * \sa ascon_aead_stream_update_ad(), ascon_aead_stream_encrypt(),
+ * ascon_aead_stream_decrypt()
+ */
+void ascon128_aead_stream_init
+    (ascon_aead_state_t *state, const unsigned char *npub,
+     const unsigned char *k);
+
+/**
+ * \brief Initializes the state for an incremental ASCON-128a operation.
+ *
+ * \param state Incremental AEAD state to be initialized.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 16 bytes of the key to use to encrypt or
+ * decrypt the packet.
+ *
+ * \sa ascon_aead_stream_update_ad(), ascon_aead_stream_encrypt(),
+ * ascon_aead_stream_decrypt()
+ */
+void ascon128a_aead_stream_init
+    (ascon_aead_state_t *state, const unsigned char *npub,
+     const unsigned char *k);
+
+/**
+ * \brief Initializes the state for an incremental ASCON-80pq operation.
+ *
+ * \param state Incremental AEAD state to be initialized.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 20 bytes of the key to use to encrypt or
+ * decrypt the packet.
+ *
+ * \sa ascon_aead_stream_update_ad(), ascon_aead_stream_encrypt(),
+ * ascon_aead_stream_decrypt()
+ */
+void ascon80pq_aead_stream_init
+    (ascon_aead_state_t *state, const unsigned char *npub,
+     const unsigned char *k);
+
+/**
+ * \brief Absorbs more associated data into an incremental ASCON state.
+ *
+ * \param state Incremental AEAD state to be updated.
+ * \param ad Points to the associated data to be absorbed.
+ * \param adlen Length of the associated data in bytes.
+ *
+ * All associated data must be absorbed before the payload is encrypted
+ * or decrypted.
+ */
+void ascon_aead_stream_update_ad
+    (ascon_aead_state_t *state, const unsigned char *ad,
+     unsigned long long adlen);
+
+/**
+ * \brief Encrypts more payload data with an incremental ASCON state.
+ *
+ * \param state Incremental AEAD state to be updated.
+ * \param c Buffer to receive \a len bytes of ciphertext.
+ * \param m Points to the plaintext to be encrypted.
+ * \param len Number of bytes to be encrypted.
+ *
+ * \sa ascon_aead_stream_encrypt_finalize()
+ */
+void ascon_aead_stream_encrypt
+    (ascon_aead_state_t *state, unsigned char *c,
+     const unsigned char *m, unsigned long long len);
+
+/**
+ * \brief Decrypts more payload data with an incremental ASCON state.
+ *
+ * \param state Incremental AEAD state to be updated.
+ * \param m Buffer to receive \a len bytes of plaintext.
+ * \param c Points to the ciphertext to be decrypted.
+ * \param len Number of bytes to be decrypted.
+ *
+ * \sa ascon_aead_stream_decrypt_finalize()
+ */
+void ascon_aead_stream_decrypt
+    (ascon_aead_state_t *state, unsigned char *m,
+     const unsigned char *c, unsigned long long len);
+
+/**
+ * \brief Finalizes an incremental ASCON encryption operation.
+ *
+ * \param state Incremental AEAD state to be finalized.
+ * \param tag Buffer to receive the 16 byte authentication tag.
+ */
+void ascon_aead_stream_encrypt_finalize
+    (ascon_aead_state_t *state, unsigned char *tag);
+
+/**
+ * \brief Finalizes an incremental ASCON decryption operation.
+ *
+ * \param state Incremental AEAD state to be finalized.
+ * \param tag Points to the 16 byte authentication tag to be checked.
+ *
+ * \return 0 if the authentication tag is correct, or -1 otherwise.
+ * The plaintext that was returned by ascon_aead_stream_decrypt() must
+ * be discarded if the authentication tag is incorrect.
+ */
+int ascon_aead_stream_decrypt_finalize
+    (ascon_aead_state_t *state, const unsigned char *tag);
+
 /**
  * \brief Hashes a block of input data with ASCON-HASH.
  *
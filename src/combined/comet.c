@@ -33,7 +33,13 @@ aead_cipher_t const comet_128_cham_cipher = {
     COMET_128_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN,
     comet_128_cham_aead_encrypt,
-    comet_128_cham_aead_decrypt
+    comet_128_cham_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_cipher_t const comet_64_cham_cipher = {
@@ -43,7 +49,13 @@ aead_cipher_t const comet_64_cham_cipher = {
     COMET_64_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN,
     comet_64_cham_aead_encrypt,
-    comet_64_cham_aead_decrypt
+    comet_64_cham_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_cipher_t const comet_64_speck_cipher = {
@@ -53,7 +65,13 @@ aead_cipher_t const comet_64_speck_cipher = {
     COMET_64_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN,
     comet_64_speck_aead_encrypt,
-    comet_64_speck_aead_decrypt
+    comet_64_speck_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 /**
@@ -31,7 +31,13 @@ aead_cipher_t const drygascon128k32_cipher = {
     DRYGASCON128_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN | AEAD_FLAG_SC_PROTECT_ALL,
     drygascon128k32_aead_encrypt,
-    drygascon128k32_aead_decrypt
+    drygascon128k32_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_cipher_t const drygascon128_cipher = {
@@ -41,7 +47,13 @@ aead_cipher_t const drygascon128_cipher = {
     DRYGASCON128_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN,
     drygascon128k32_aead_encrypt,
-    drygascon128k32_aead_decrypt
+    drygascon128k32_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_cipher_t const drygascon128k56_cipher = {
@@ -51,7 +63,13 @@ aead_cipher_t const drygascon128k56_cipher = {
     DRYGASCON128_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN | AEAD_FLAG_SC_PROTECT_ALL,
     drygascon128k56_aead_encrypt,
-    drygascon128k56_aead_decrypt
+    drygascon128k56_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_cipher_t const drygascon128k16_cipher = {
@@ -61,7 +79,13 @@ aead_cipher_t const drygascon128k16_cipher = {
     DRYGASCON128_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN | AEAD_FLAG_SC_PROTECT_ALL,
     drygascon128k16_aead_encrypt,
-    drygascon128k16_aead_decrypt
+    drygascon128k16_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_cipher_t const drygascon256_cipher = {
@@ -71,7 +95,13 @@ aead_cipher_t const drygascon256_cipher = {
     DRYGASCON256_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN | AEAD_FLAG_SC_PROTECT_ALL,
     drygascon256_aead_encrypt,
-    drygascon256_aead_decrypt
+    drygascon256_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_hash_algorithm_t const drygascon128_hash_algorithm = {
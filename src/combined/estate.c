@@ -25,6 +25,32 @@
 #include "internal-util.h"
 #include <string.h>
 
+/**
+ * \brief Encrypts a batch of packets with ESTATE_TweGIFT-128.
+ *
+ * \param items Points to the descriptors for the packets.
+ * \param count Number of packets in the batch.
+ */
+static void estate_twegift_batch_encrypt
+    (aead_batch_item_t *items, size_t count);
+
+/**
+ * \brief Decrypts a batch of packets with ESTATE_TweGIFT-128.
+ *
+ * \param items Points to the descriptors for the packets.
+ * \param count Number of packets in the batch.
+ */
+static void estate_twegift_batch_decrypt
+    (aead_batch_item_t *items, size_t count);
+
+/**
+ * \brief Batch AEAD functions for ESTATE_TweGIFT-128.
+ */
+static aead_batch_cipher_t const estate_twegift_batch_cipher = {
+    estate_twegift_batch_encrypt,
+    estate_twegift_batch_decrypt
+};
+
 aead_cipher_t const estate_twegift_cipher = {
     "ESTATE_TweGIFT-128",
     ESTATE_TWEGIFT_KEY_SIZE,
@@ -32,7 +58,13 @@ aead_cipher_t const estate_twegift_cipher = {
     ESTATE_TWEGIFT_TAG_SIZE,
     AEAD_FLAG_NONE,
     estate_twegift_aead_encrypt,
-    estate_twegift_aead_decrypt
+    estate_twegift_aead_decrypt,
+    sizeof(gift128n_key_schedule_t),
+    estate_twegift_aead_setup_key,
+    estate_twegift_aead_encrypt_with_context,
+    estate_twegift_aead_decrypt_with_context,
+    0, /* stream */
+    &estate_twegift_batch_cipher
 };
 
 /**
@@ -137,45 +169,48 @@ static void estate_twegift_encrypt
     }
 }
 
-int estate_twegift_aead_encrypt
+int estate_twegift_aead_encrypt_with_context
     (unsigned char *c, unsigned long long *clen,
      const unsigned char *m, unsigned long long mlen,
      const unsigned char *ad, unsigned long long adlen,
      const unsigned char *nsec,
      const unsigned char *npub,
-     const unsigned char *k)
+     const void *ctx)
 {
-    gift128n_key_schedule_t ks;
+    gift128n_key_schedule_t temp;
+    const gift128n_key_schedule_t *ks = gift128b_expand_schedule
+        ((const gift128n_key_schedule_t *)ctx, &temp);
     unsigned char tag[16];
     (void)nsec;
 
     /* Set the length of the returned ciphertext */
     *clen = mlen + ESTATE_TWEGIFT_TAG_SIZE;
 
-    /* Set up the key schedule and copy the nonce into the tag */
-    gift128n_init(&ks, k);
+    /* Copy the nonce into the tag */
     memcpy(tag, npub, 16);
 
     /* Authenticate the associated data and plaintext */
-    estate_twegift_authenticate(&ks, tag, m, mlen, ad, adlen);
+    estate_twegift_authenticate(ks, tag, m, mlen, ad, adlen);
 
     /* Encrypt the plaintext to generate the ciphertext */
-    estate_twegift_encrypt(&ks, tag, c, m, mlen);
+    estate_twegift_encrypt(ks, tag, c, m, mlen);
 
     /* Generate the authentication tag */
     memcpy(c + mlen, tag, 16);
     return 0;
 }
 
-int estate_twegift_aead_decrypt
+int estate_twegift_aead_decrypt_with_context
     (unsigned char *m, unsigned long long *mlen,
      unsigned char *nsec,
      const unsigned char *c, unsigned long long clen,
      const unsigned char *ad, unsigned long long adlen,
      const unsigned char *npub,
-     const unsigned char *k)
+     const void *ctx)
 {
-    gift128n_key_schedule_t ks;
+    gift128n_key_schedule_t temp;
+    const gift128n_key_schedule_t *ks = gift128b_expand_schedule
+        ((const gift128n_key_schedule_t *)ctx, &temp);
     unsigned char tag[16];
     (void)nsec;
 
@@ -184,16 +219,284 @@ int estate_twegift_aead_decrypt
         return -1;
     *mlen = clen - ESTATE_TWEGIFT_TAG_SIZE;
 
-    /* Set up the key schedule and copy the nonce into the tag */
-    gift128n_init(&ks, k);
+    /* Copy the nonce into the tag */
     memcpy(tag, npub, 16);
 
     /* Decrypt the ciphertext to generate the plaintext */
-    estate_twegift_encrypt(&ks, c + *mlen, m, c, *mlen);
+    estate_twegift_encrypt(ks, c + *mlen, m, c, *mlen);
 
     /* Authenticate the associated data and plaintext */
-    estate_twegift_authenticate(&ks, tag, m, *mlen, ad, adlen);
+    estate_twegift_authenticate(ks, tag, m, *mlen, ad, adlen);
 
     /* Check the authentication tag */
     return aead_check_tag(m, *mlen, tag, c + *mlen, 16);
 }
+
+void estate_twegift_aead_setup_key(void *ctx, const unsigned char *k)
+{
+    gift128n_init((gift128n_key_schedule_t *)ctx, k);
+}
+
+int estate_twegift_aead_encrypt
+    (unsigned char *c, unsigned long long *clen,
+     const unsigned char *m, unsigned long long mlen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *nsec,
+     const unsigned char *npub,
+     const unsigned char *k)
+{
+    gift128n_key_schedule_t ks;
+    gift128n_init(&ks, k);
+    return estate_twegift_aead_encrypt_with_context
+        (c, clen, m, mlen, ad, adlen, nsec, npub, &ks);
+}
+
+int estate_twegift_aead_decrypt
+    (unsigned char *m, unsigned long long *mlen,
+     unsigned char *nsec,
+     const unsigned char *c, unsigned long long clen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *npub,
+     const unsigned char *k)
+{
+    gift128n_key_schedule_t ks;
+    gift128n_init(&ks, k);
+    return estate_twegift_aead_decrypt_with_context
+        (m, mlen, nsec, c, clen, ad, adlen, npub, &ks);
+}
+
+/**
+ * \brief Generates the FCBC MAC for all packets in a batch.
+ *
+ * \param ks Key schedules for the packets, one per lane.
+ * \param tag Rolling state of the authentication tag for each packet.
+ * \param m Points to the messages to be authenticated.
+ * \param mlen Length of the messages to be authenticated; must be >= 1.
+ * \param tweak1 Tweak value to use when the last block is full.
+ * \param tweak2 Tweak value to use when the last block is partial.
+ */
+static void estate_twegift_batch_fcbc
+    (const gift128b_multi_key_schedule_t *ks, unsigned char tag[][16],
+     const unsigned char * const *m, unsigned long long mlen,
+     uint32_t tweak1, uint32_t tweak2)
+{
+    unsigned long long posn;
+    unsigned lane, temp;
+    for (posn = 0; (posn + 16) < mlen; posn += 16) {
+        for (lane = 0; lane < ks->lanes; ++lane)
+            lw_xor_block(tag[lane], m[lane] + posn, 16);
+        gift128n_encrypt_multi(ks, tag[0]);
+    }
+    temp = (unsigned)(mlen - posn);
+    for (lane = 0; lane < ks->lanes; ++lane) {
+        lw_xor_block(tag[lane], m[lane] + posn, temp);
+        if (temp < 16)
+            tag[lane][temp] ^= 0x01;
+    }
+    gift128t_encrypt_multi(ks, tag[0], temp == 16 ? tweak1 : tweak2);
+}
+
+/**
+ * \brief Generates the MAC for all packets in a batch.
+ *
+ * \param ks Key schedules for the packets, one per lane.
+ * \param tag Rolling state of the authentication tag for each packet.
+ * \param m Points to the messages to be authenticated.
+ * \param mlen Length of the messages to be authenticated.
+ * \param ad Points to the associated data to be authenticated.
+ * \param adlen Length of the associated data to be authenticated.
+ */
+static void estate_twegift_batch_authenticate
+    (const gift128b_multi_key_schedule_t *ks, unsigned char tag[][16],
+     const unsigned char * const *m, unsigned long long mlen,
+     const unsigned char * const *ad, unsigned long long adlen)
+{
+    /* Handle the case where both the message and associated data are empty */
+    if (mlen == 0 && adlen == 0) {
+        gift128t_encrypt_multi(ks, tag[0], GIFT128T_TWEAK_8);
+        return;
+    }
+
+    /* Encrypt the nonces */
+    gift128t_encrypt_multi(ks, tag[0], GIFT128T_TWEAK_1);
+
+    /* Compute the FCBC MAC over the associated data */
+    if (adlen != 0) {
+        if (mlen != 0) {
+            estate_twegift_batch_fcbc
+                (ks, tag, ad, adlen, GIFT128T_TWEAK_2, GIFT128T_TWEAK_3);
+        } else {
+            estate_twegift_batch_fcbc
+                (ks, tag, ad, adlen, GIFT128T_TWEAK_6, GIFT128T_TWEAK_7);
+        }
+    }
+
+    /* Compute the FCBC MAC over the message data */
+    if (mlen != 0) {
+        estate_twegift_batch_fcbc
+            (ks, tag, m, mlen, GIFT128T_TWEAK_4, GIFT128T_TWEAK_5);
+    }
+}
+
+/**
+ * \brief Encrypts (or decrypts) the payloads of all packets in a batch.
+ *
+ * \param ks Key schedules for the packets, one per lane.
+ * \param tag Pre-computed authentication tag for each packet.
+ * \param out Points to the output buffers for the packets.
+ * \param in Points to the input buffers for the packets.
+ * \param len Length of the payload of each packet.
+ */
+static void estate_twegift_batch_payload
+    (const gift128b_multi_key_schedule_t *ks, unsigned char tag[][16],
+     unsigned char * const *out, const unsigned char * const *in,
+     unsigned long long len)
+{
+    unsigned char block[GIFT128_MAX_LANES][16];
+    unsigned long long posn;
+    unsigned lane;
+    memcpy(block, tag, ks->lanes * 16);
+    for (posn = 0; (posn + 16) <= len; posn += 16) {
+        gift128n_encrypt_multi(ks, block[0]);
+        for (lane = 0; lane < ks->lanes; ++lane)
+            lw_xor_block_2_src
+                (out[lane] + posn, block[lane], in[lane] + posn, 16);
+    }
+    if (posn < len) {
+        gift128n_encrypt_multi(ks, block[0]);
+        for (lane = 0; lane < ks->lanes; ++lane) {
+            lw_xor_block_2_src
+                (out[lane] + posn, block[lane], in[lane] + posn,
+                 (unsigned)(len - posn));
+        }
+    }
+}
+
+/**
+ * \brief Encrypts or decrypts up to GIFT128_MAX_LANES packets in parallel.
+ *
+ * \param ks Key schedules for the packets, one per lane.
+ * \param out Points to the output buffers for the packets.
+ * \param in Points to the input buffers for the packets.
+ * \param len Length of the payload of each packet, excluding the tag.
+ * \param ad Points to the associated data buffers for the packets.
+ * \param adlen Length of the associated data for each packet.
+ * \param npub Points to the nonces for the packets.
+ * \param status Returns the tag check result for each packet on decrypt.
+ * \param decrypt Non-zero to decrypt, zero to encrypt.
+ */
+static void estate_twegift_batch_crypt
+    (const gift128b_multi_key_schedule_t *ks,
+     unsigned char * const *out, const unsigned char * const *in,
+     unsigned long long len,
+     const unsigned char * const *ad, unsigned long long adlen,
+     const unsigned char * const *npub, int *status, int decrypt)
+{
+    unsigned char tag[GIFT128_MAX_LANES][16];
+    unsigned char expected[GIFT128_MAX_LANES][16];
+    unsigned lane;
+
+    /* Copy the nonces into the tags */
+    for (lane = 0; lane < ks->lanes; ++lane)
+        memcpy(tag[lane], npub[lane], 16);
+
+    /* Authenticate and encrypt, or decrypt and authenticate */
+    if (decrypt) {
+        for (lane = 0; lane < ks->lanes; ++lane)
+            memcpy(expected[lane], in[lane] + len, 16);
+        estate_twegift_batch_payload(ks, expected, out, in, len);
+        estate_twegift_batch_authenticate
+            (ks, tag, (const unsigned char * const *)out, len, ad, adlen);
+        for (lane = 0; lane < ks->lanes; ++lane) {
+            status[lane] = aead_check_tag
+                (out[lane], len, tag[lane], expected[lane], 16);
+        }
+    } else {
+        estate_twegift_batch_authenticate(ks, tag, in, len, ad, adlen);
+        estate_twegift_batch_payload(ks, tag, out, in, len);
+        for (lane = 0; lane < ks->lanes; ++lane) {
+            memcpy(out[lane] + len, tag[lane], 16);
+            status[lane] = 0;
+        }
+    }
+}
+
+/**
+ * \brief Encrypts or decrypts a batch of packets with ESTATE_TweGIFT-128,
+ * using the multi-block GIFT-128 kernels for runs of packets that have
+ * the same lengths.
+ *
+ * \param items Points to the descriptors for the packets.
+ * \param count Number of packets in the batch.
+ * \param decrypt Non-zero to decrypt, zero to encrypt.
+ */
+static void estate_twegift_batch_items
+    (aead_batch_item_t *items, size_t count, int decrypt)
+{
+    gift128n_key_schedule_t schedules[GIFT128_MAX_LANES];
+    const gift128n_key_schedule_t *keys[GIFT128_MAX_LANES];
+    gift128b_multi_key_schedule_t ks;
+    unsigned char *out[GIFT128_MAX_LANES];
+    const unsigned char *in[GIFT128_MAX_LANES];
+    const unsigned char *ad[GIFT128_MAX_LANES];
+    const unsigned char *npub[GIFT128_MAX_LANES];
+    int status[GIFT128_MAX_LANES];
+    unsigned long long inlen, adlen, len;
+    unsigned lanes, lane;
+    while (count > 0) {
+        /* A ciphertext that is too short to contain a tag fails by itself */
+        inlen = items[0].inlen;
+        adlen = items[0].adlen;
+        if (decrypt && inlen < ESTATE_TWEGIFT_TAG_SIZE) {
+            items[0].outlen = 0;
+            items[0].status = -1;
+            ++items;
+            --count;
+            continue;
+        }
+
+        /* Collect a run of packets with the same lengths */
+        lanes = 0;
+        do {
+            out[lanes] = items[lanes].out;
+            in[lanes] = items[lanes].in;
+            ad[lanes] = items[lanes].ad;
+            npub[lanes] = items[lanes].npub;
+            if (items[lanes].key) {
+                gift128n_init(&(schedules[lanes]), items[lanes].key);
+                keys[lanes] = &(schedules[lanes]);
+            } else {
+                keys[lanes] = gift128b_expand_schedule
+                    ((const gift128n_key_schedule_t *)(items[lanes].ctx),
+                     &(schedules[lanes]));
+            }
+            ++lanes;
+        } while (lanes < GIFT128_MAX_LANES && lanes < count &&
+                 items[lanes].inlen == inlen && items[lanes].adlen == adlen);
+
+        /* Process the run of packets */
+        gift128b_multi_init(&ks, keys, lanes);
+        len = decrypt ? (inlen - ESTATE_TWEGIFT_TAG_SIZE) : inlen;
+        estate_twegift_batch_crypt
+            (&ks, out, in, len, ad, adlen, npub, status, decrypt);
+        for (lane = 0; lane < lanes; ++lane) {
+            items[lane].outlen =
+                decrypt ? len : (len + ESTATE_TWEGIFT_TAG_SIZE);
+            items[lane].status = status[lane];
+        }
+        items += lanes;
+        count -= lanes;
+    }
+}
+
+static void estate_twegift_batch_encrypt
+    (aead_batch_item_t *items, size_t count)
+{
+    estate_twegift_batch_items(items, count, 0);
+}
+
+static void estate_twegift_batch_decrypt
+    (aead_batch_item_t *items, size_t count)
+{
+    estate_twegift_batch_items(items, count, 1);
+}
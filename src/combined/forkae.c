@@ -31,7 +31,13 @@ aead_cipher_t const forkae_paef_64_192_cipher = {
     FORKAE_PAEF_64_192_TAG_SIZE,
     AEAD_FLAG_NONE,
     forkae_paef_64_192_aead_encrypt,
-    forkae_paef_64_192_aead_decrypt
+    forkae_paef_64_192_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_cipher_t const forkae_paef_128_192_cipher = {
@@ -41,7 +47,13 @@ aead_cipher_t const forkae_paef_128_192_cipher = {
     FORKAE_PAEF_128_192_TAG_SIZE,
     AEAD_FLAG_NONE,
     forkae_paef_128_192_aead_encrypt,
-    forkae_paef_128_192_aead_decrypt
+    forkae_paef_128_192_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_cipher_t const forkae_paef_128_256_cipher = {
@@ -51,7 +63,13 @@ aead_cipher_t const forkae_paef_128_256_cipher = {
     FORKAE_PAEF_128_256_TAG_SIZE,
     AEAD_FLAG_NONE,
     forkae_paef_128_256_aead_encrypt,
-    forkae_paef_128_256_aead_decrypt
+    forkae_paef_128_256_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_cipher_t const forkae_paef_128_288_cipher = {
@@ -61,7 +79,13 @@ aead_cipher_t const forkae_paef_128_288_cipher = {
     FORKAE_PAEF_128_288_TAG_SIZE,
     AEAD_FLAG_NONE,
     forkae_paef_128_288_aead_encrypt,
-    forkae_paef_128_288_aead_decrypt
+    forkae_paef_128_288_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_cipher_t const forkae_saef_128_192_cipher = {
@@ -71,7 +95,13 @@ aead_cipher_t const forkae_saef_128_192_cipher = {
     FORKAE_SAEF_128_192_TAG_SIZE,
     AEAD_FLAG_NONE,
     forkae_saef_128_192_aead_encrypt,
-    forkae_saef_128_192_aead_decrypt
+    forkae_saef_128_192_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_cipher_t const forkae_saef_128_256_cipher = {
@@ -81,7 +111,13 @@ aead_cipher_t const forkae_saef_128_256_cipher = {
     FORKAE_SAEF_128_256_TAG_SIZE,
     AEAD_FLAG_NONE,
     forkae_saef_128_256_aead_encrypt,
-    forkae_saef_128_256_aead_decrypt
+    forkae_saef_128_256_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 /* PAEF-ForkSkinny-64-192 */
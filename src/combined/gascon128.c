@@ -39,6 +39,45 @@
  */
 #define GASCON80PQ_IV    0xa0400c06U
 
+/**
+ * \brief Incremental AEAD functions for GASCON-128.
+ */
+static aead_stream_cipher_t const gascon128_stream_cipher = {
+    sizeof(gascon_aead_state_t),
+    (aead_stream_init_t)gascon128_aead_stream_init,
+    (aead_stream_update_ad_t)gascon_aead_stream_update_ad,
+    (aead_stream_crypt_t)gascon_aead_stream_encrypt,
+    (aead_stream_crypt_t)gascon_aead_stream_decrypt,
+    (aead_stream_encrypt_finalize_t)gascon_aead_stream_encrypt_finalize,
+    (aead_stream_decrypt_finalize_t)gascon_aead_stream_decrypt_finalize
+};
+
+/**
+ * \brief Incremental AEAD functions for GASCON-128a.
+ */
+static aead_stream_cipher_t const gascon128a_stream_cipher = {
+    sizeof(gascon_aead_state_t),
+    (aead_stream_init_t)gascon128a_aead_stream_init,
+    (aead_stream_update_ad_t)gascon_aead_stream_update_ad,
+    (aead_stream_crypt_t)gascon_aead_stream_encrypt,
+    (aead_stream_crypt_t)gascon_aead_stream_decrypt,
+    (aead_stream_encrypt_finalize_t)gascon_aead_stream_encrypt_finalize,
+    (aead_stream_decrypt_finalize_t)gascon_aead_stream_decrypt_finalize
+};
+
+/**
+ * \brief Incremental AEAD functions for GASCON-80pq.
+ */
+static aead_stream_cipher_t const gascon80pq_stream_cipher = {
+    sizeof(gascon_aead_state_t),
+    (aead_stream_init_t)gascon80pq_aead_stream_init,
+    (aead_stream_update_ad_t)gascon_aead_stream_update_ad,
+    (aead_stream_crypt_t)gascon_aead_stream_encrypt,
+    (aead_stream_crypt_t)gascon_aead_stream_decrypt,
+    (aead_stream_encrypt_finalize_t)gascon_aead_stream_encrypt_finalize,
+    (aead_stream_decrypt_finalize_t)gascon_aead_stream_decrypt_finalize
+};
+
 aead_cipher_t const gascon128_cipher = {
     "GASCON-128",
     GASCON128_KEY_SIZE,
@@ -46,7 +85,13 @@ aead_cipher_t const gascon128_cipher = {
     GASCON128_TAG_SIZE,
     AEAD_FLAG_NONE,
     gascon128_aead_encrypt,
-    gascon128_aead_decrypt
+    gascon128_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    &gascon128_stream_cipher,
+    0  /* batch */
 };
 
 aead_cipher_t const gascon128a_cipher = {
@@ -56,7 +101,13 @@ aead_cipher_t const gascon128a_cipher = {
     GASCON128_TAG_SIZE,
     AEAD_FLAG_NONE,
     gascon128a_aead_encrypt,
-    gascon128a_aead_decrypt
+    gascon128a_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    &gascon128a_stream_cipher,
+    0  /* batch */
 };
 
 aead_cipher_t const gascon80pq_cipher = {
@@ -66,7 +117,13 @@ aead_cipher_t const gascon80pq_cipher = {
     GASCON80PQ_TAG_SIZE,
     AEAD_FLAG_NONE,
     gascon80pq_aead_encrypt,
-    gascon80pq_aead_decrypt
+    gascon80pq_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    &gascon80pq_stream_cipher,
+    0  /* batch */
 };
 
 /**
@@ -504,3 +561,263 @@ int gascon80pq_aead_decrypt
     return aead_check_tag
         (m, *mlen, state.B + 24, c + *mlen, GASCON80PQ_TAG_SIZE);
 }
+/**
+ * \brief Mode value for an incremental GASCON state that has not
+ * absorbed any associated data yet.
+ */
+#define GASCON_STREAM_MODE_INIT 0
+
+/**
+ * \brief Mode value for an incremental GASCON state that is absorbing
+ * associated data.
+ */
+#define GASCON_STREAM_MODE_AD 1
+
+/**
+ * \brief Mode value for an incremental GASCON state that is encrypting
+ * or decrypting the payload.
+ */
+#define GASCON_STREAM_MODE_PAYLOAD 2
+
+/**
+ * \brief Starts an incremental GASCON operation once the IV has been
+ * stored into the leading bytes of the state.
+ *
+ * \param state The incremental AEAD state.
+ * \param npub Points to the 16 bytes of the nonce.
+ * \param k Points to the key.
+ * \param key_size Size of the key in bytes.
+ * \param rate Number of bytes in each block.
+ * \param first_round First round of the permutation to apply each block.
+ */
+static void gascon_aead_stream_start
+    (gascon_aead_state_t *state, const unsigned char *npub,
+     const unsigned char *k, unsigned key_size, unsigned rate,
+     uint8_t first_round)
+{
+    gascon_state_t *st = (gascon_state_t *)(state->s.state);
+    memcpy(st->B + 24 - key_size, k, key_size);
+    memcpy(st->B + 24, npub, GASCON128_NONCE_SIZE);
+    gascon_permute(st, 0);
+    lw_xor_block(st->B + 40 - key_size, k, key_size);
+    memcpy(state->s.key, k, key_size);
+    state->s.count = 0;
+    state->s.mode = GASCON_STREAM_MODE_INIT;
+    state->s.rate = (unsigned char)rate;
+    state->s.first_round = first_round;
+    state->s.key_size = (unsigned char)key_size;
+}
+
+void gascon128_aead_stream_init
+    (gascon_aead_state_t *state, const unsigned char *npub,
+     const unsigned char *k)
+{
+    le_store_word64(state->s.state, GASCON128_IV);
+    gascon_aead_stream_start(state, npub, k, GASCON128_KEY_SIZE, 8, 6);
+}
+
+void gascon128a_aead_stream_init
+    (gascon_aead_state_t *state, const unsigned char *npub,
+     const unsigned char *k)
+{
+    le_store_word64(state->s.state, GASCON128a_IV);
+    gascon_aead_stream_start(state, npub, k, GASCON128_KEY_SIZE, 16, 4);
+}
+
+void gascon80pq_aead_stream_init
+    (gascon_aead_state_t *state, const unsigned char *npub,
+     const unsigned char *k)
+{
+    le_store_word32(state->s.state, GASCON80PQ_IV);
+    gascon_aead_stream_start(state, npub, k, GASCON80PQ_KEY_SIZE, 8, 6);
+}
+
+void gascon_aead_stream_update_ad
+    (gascon_aead_state_t *state, const unsigned char *ad,
+     unsigned long long adlen)
+{
+    gascon_state_t *st = (gascon_state_t *)(state->s.state);
+    unsigned rate = state->s.rate;
+    unsigned temp;
+
+    /* Nothing to do if there is no associated data */
+    if (!adlen)
+        return;
+    state->s.mode = GASCON_STREAM_MODE_AD;
+
+    /* Fill up a left-over partial block from last time */
+    if (state->s.count) {
+        temp = rate - state->s.count;
+        if (temp > adlen) {
+            temp = (unsigned)adlen;
+            lw_xor_block(st->B + state->s.count, ad, temp);
+            state->s.count += temp;
+            return;
+        }
+        lw_xor_block(st->B + state->s.count, ad, temp);
+        gascon_permute(st, state->s.first_round);
+        state->s.count = 0;
+        ad += temp;
+        adlen -= temp;
+    }
+
+    /* Absorb full blocks */
+    while (adlen >= rate) {
+        lw_xor_block(st->B, ad, rate);
+        gascon_permute(st, state->s.first_round);
+        ad += rate;
+        adlen -= rate;
+    }
+
+    /* Absorb the left-over partial block; padding is deferred */
+    temp = (unsigned)adlen;
+    lw_xor_block(st->B, ad, temp);
+    state->s.count = temp;
+}
+
+/**
+ * \brief Switches an incremental GASCON state into payload mode if
+ * it is not already in payload mode.
+ *
+ * \param state The incremental AEAD state.
+ */
+static void gascon_aead_stream_start_payload(gascon_aead_state_t *state)
+{
+    gascon_state_t *st = (gascon_state_t *)(state->s.state);
+    if (state->s.mode == GASCON_STREAM_MODE_PAYLOAD)
+        return;
+
+    /* Pad and absorb the last block of associated data */
+    if (state->s.mode == GASCON_STREAM_MODE_AD) {
+        st->B[state->s.count] ^= 0x80;
+        gascon_permute(st, state->s.first_round);
+        state->s.count = 0;
+    }
+
+    /* Separator between the associated data and the payload */
+    st->B[39] ^= 0x01;
+    state->s.mode = GASCON_STREAM_MODE_PAYLOAD;
+}
+
+void gascon_aead_stream_encrypt
+    (gascon_aead_state_t *state, unsigned char *c,
+     const unsigned char *m, unsigned long long len)
+{
+    gascon_state_t *st = (gascon_state_t *)(state->s.state);
+    unsigned rate = state->s.rate;
+    unsigned temp;
+
+    /* Make sure that we are in payload mode */
+    gascon_aead_stream_start_payload(state);
+
+    /* Fill up a left-over partial block from last time */
+    if (state->s.count) {
+        temp = rate - state->s.count;
+        if (temp > len) {
+            temp = (unsigned)len;
+            lw_xor_block_2_dest(c, st->B + state->s.count, m, temp);
+            state->s.count += temp;
+            return;
+        }
+        lw_xor_block_2_dest(c, st->B + state->s.count, m, temp);
+        gascon_permute(st, state->s.first_round);
+        state->s.count = 0;
+        c += temp;
+        m += temp;
+        len -= temp;
+    }
+
+    /* Encrypt full blocks */
+    while (len >= rate) {
+        lw_xor_block_2_dest(c, st->B, m, rate);
+        gascon_permute(st, state->s.first_round);
+        c += rate;
+        m += rate;
+        len -= rate;
+    }
+
+    /* Encrypt the left-over partial block */
+    temp = (unsigned)len;
+    lw_xor_block_2_dest(c, st->B, m, temp);
+    state->s.count = temp;
+}
+
+void gascon_aead_stream_decrypt
+    (gascon_aead_state_t *state, unsigned char *m,
+     const unsigned char *c, unsigned long long len)
+{
+    gascon_state_t *st = (gascon_state_t *)(state->s.state);
+    unsigned rate = state->s.rate;
+    unsigned temp;
+
+    /* Make sure that we are in payload mode */
+    gascon_aead_stream_start_payload(state);
+
+    /* Fill up a left-over partial block from last time */
+    if (state->s.count) {
+        temp = rate - state->s.count;
+        if (temp > len) {
+            temp = (unsigned)len;
+            lw_xor_block_swap(m, st->B + state->s.count, c, temp);
+            state->s.count += temp;
+            return;
+        }
+        lw_xor_block_swap(m, st->B + state->s.count, c, temp);
+        gascon_permute(st, state->s.first_round);
+        state->s.count = 0;
+        c += temp;
+        m += temp;
+        len -= temp;
+    }
+
+    /* Decrypt full blocks */
+    while (len >= rate) {
+        lw_xor_block_swap(m, st->B, c, rate);
+        gascon_permute(st, state->s.first_round);
+        c += rate;
+        m += rate;
+        len -= rate;
+    }
+
+    /* Decrypt the left-over partial block */
+    temp = (unsigned)len;
+    lw_xor_block_swap(m, st->B, c, temp);
+    state->s.count = temp;
+}
+
+/**
+ * \brief Computes the authentication tag for an incremental GASCON state.
+ *
+ * \param state The incremental AEAD state.
+ * \param tag Buffer to receive the 16 byte authentication tag.
+ */
+static void gascon_aead_stream_compute_tag
+    (gascon_aead_state_t *state, unsigned char *tag)
+{
+    gascon_state_t *st = (gascon_state_t *)(state->s.state);
+    unsigned key_size = state->s.key_size;
+
+    /* Pad the final payload block */
+    gascon_aead_stream_start_payload(state);
+    st->B[state->s.count] ^= 0x80;
+
+    /* Finalize and compute the authentication tag */
+    lw_xor_block(st->B + state->s.rate, state->s.key, key_size);
+    gascon_permute(st, 0);
+    lw_xor_block_2_src
+        (tag, st->B + 24, state->s.key + key_size - 16, 16);
+}
+
+void gascon_aead_stream_encrypt_finalize
+    (gascon_aead_state_t *state, unsigned char *tag)
+{
+    gascon_aead_stream_compute_tag(state, tag);
+}
+
+int gascon_aead_stream_decrypt_finalize
+    (gascon_aead_state_t *state, const unsigned char *tag)
+{
+    unsigned char computed[16];
+    gascon_aead_stream_compute_tag(state, computed);
+    return aead_check_tag(0, 0, computed, tag, 16);
+}
@@ -97,6 +97,24 @@ typedef union
 
 } gascon_hash_state_t;
 
+/**
+ * \brief State information for the incremental GASCON AEAD modes.
+ */
+typedef union
+{
+    struct {
+        unsigned char state[40]; /**< Current permutation state */
+        unsigned char key[20];   /**< Key to use during finalization */
+        unsigned char count;     /**< Number of bytes in the current block */
+        unsigned char mode;      /**< Associated data or payload mode */
+        unsigned char rate;      /**< Number of bytes in each block */
+        unsigned char first_round; /**< First round for block permutations */
+        unsigned char key_size;  /**< Size of the key in bytes */
+    } s;                         /**< State */
+    unsigned long long align;    /**< For alignment of this structure */
+
+} gascon_aead_state_t;
+
 /**
  * \brief Meta-information block for the GASCON-128 cipher.
  */
@@ -299,6 +317,118 @@ int gascon80pq_aead_decrypt
      const unsigned char *npub,
      const unsigned char *k);
 
+/**
+ * \brief Initializes the state for an incremental GASCON-128 operation.
+ *
+ * \param state Incremental AEAD state to be initialized.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 16 bytes of the key to use to encrypt or
+ * decrypt the packet.
+ *
+ * \sa gascon_aead_stream_update_ad(), gascon_aead_stream_encrypt(),
+ * gascon_aead_stream_decrypt()
+ */
+void gascon128_aead_stream_init
+    (gascon_aead_state_t *state, const unsigned char *npub,
+     const unsigned char *k);
+
+/**
+ * \brief Initializes the state for an incremental GASCON-128a operation.
+ *
+ * \param state Incremental AEAD state to be initialized.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 16 bytes of the key to use to encrypt or
+ * decrypt the packet.
+ *
+ * \sa gascon_aead_stream_update_ad(), gascon_aead_stream_encrypt(),
+ * gascon_aead_stream_decrypt()
+ */
+void gascon128a_aead_stream_init
+    (gascon_aead_state_t *state, const unsigned char *npub,
+     const unsigned char *k);
+
+/**
+ * \brief Initializes the state for an incremental GASCON-80pq operation.
+ *
+ * \param state Incremental AEAD state to be initialized.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 20 bytes of the key to use to encrypt or
+ * decrypt the packet.
+ *
+ * \sa gascon_aead_stream_update_ad(), gascon_aead_stream_encrypt(),
+ * gascon_aead_stream_decrypt()
+ */
+void gascon80pq_aead_stream_init
+    (gascon_aead_state_t *state, const unsigned char *npub,
+     const unsigned char *k);
+
+/**
+ * \brief Absorbs more associated data into an incremental GASCON state.
+ *
+ * \param state Incremental AEAD state to be updated.
+ * \param ad Points to the associated data to be absorbed.
+ * \param adlen Length of the associated data in bytes.
+ *
+ * All associated data must be absorbed before the payload is encrypted
+ * or decrypted.
+ */
+void gascon_aead_stream_update_ad
+    (gascon_aead_state_t *state, const unsigned char *ad,
+     unsigned long long adlen);
+
+/**
+ * \brief Encrypts more payload data with an incremental GASCON state.
+ *
+ * \param state Incremental AEAD state to be updated.
+ * \param c Buffer to receive \a len bytes of ciphertext.
+ * \param m Points to the plaintext to be encrypted.
+ * \param len Number of bytes to be encrypted.
+ *
+ * \sa gascon_aead_stream_encrypt_finalize()
+ */
+void gascon_aead_stream_encrypt
+    (gascon_aead_state_t *state, unsigned char *c,
+     const unsigned char *m, unsigned long long len);
+
+/**
+ * \brief Decrypts more payload data with an incremental GASCON state.
+ *
+ * \param state Incremental AEAD state to be updated.
+ * \param m Buffer to receive \a len bytes of plaintext.
+ * \param c Points to the ciphertext to be decrypted.
+ * \param len Number of bytes to be decrypted.
+ *
+ * \sa gascon_aead_stream_decrypt_finalize()
+ */
+void gascon_aead_stream_decrypt
+    (gascon_aead_state_t *state, unsigned char *m,
+     const unsigned char *c, unsigned long long len);
+
+/**
+ * \brief Finalizes an incremental GASCON encryption operation.
+ *
+ * \param state Incremental AEAD state to be finalized.
+ * \param tag Buffer to receive the 16 byte authentication tag.
+ */
+void gascon_aead_stream_encrypt_finalize
+    (gascon_aead_state_t *state, unsigned char *tag);
+
+/**
+ * \brief Finalizes an incremental GASCON decryption operation.
+ *
+ * \param state Incremental AEAD state to be finalized.
+ * \param tag Points to the 16 byte authentication tag to be checked.
+ *
+ * \return 0 if the authentication tag is correct, or -1 otherwise.
+ * The plaintext that was returned by gascon_aead_stream_decrypt() must
+ * be discarded if the authentication tag is incorrect.
+ */
+int gascon_aead_stream_decrypt_finalize
+    (gascon_aead_state_t *state, const unsigned char *tag);
+
 /**
  * \brief Hashes a block of input data with GASCON-HASH.
  *
@@ -20,19 +20,26 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include "internal-masking.h"
 #include "gift-cofb-masked.h"
 #include "internal-gift128-m.h"
 #include "internal-util.h"
 #include <string.h>
 
 aead_cipher_t const gift_cofb_masked_cipher = {
-    "GIFT-COFB-Masked",
+    AEAD_MASKING_CIPHER_NAME("GIFT-COFB-Masked"),
     GIFT_COFB_MASKED_KEY_SIZE,
     GIFT_COFB_MASKED_NONCE_SIZE,
     GIFT_COFB_MASKED_TAG_SIZE,
     AEAD_FLAG_SC_PROTECT_ALL,
     gift_cofb_masked_aead_encrypt,
-    gift_cofb_masked_aead_decrypt
+    gift_cofb_masked_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 /**
@@ -25,6 +25,30 @@
 #include "internal-util.h"
 #include <string.h>
 
+/**
+ * \brief Encrypts a batch of packets with GIFT-COFB.
+ *
+ * \param items Points to the descriptors for the packets.
+ * \param count Number of packets in the batch.
+ */
+static void gift_cofb_batch_encrypt(aead_batch_item_t *items, size_t count);
+
+/**
+ * \brief Decrypts a batch of packets with GIFT-COFB.
+ *
+ * \param items Points to the descriptors for the packets.
+ * \param count Number of packets in the batch.
+ */
+static void gift_cofb_batch_decrypt(aead_batch_item_t *items, size_t count);
+
+/**
+ * \brief Batch AEAD functions for GIFT-COFB.
+ */
+static aead_batch_cipher_t const gift_cofb_batch_cipher = {
+    gift_cofb_batch_encrypt,
+    gift_cofb_batch_decrypt
+};
+
 aead_cipher_t const gift_cofb_cipher = {
     "GIFT-COFB",
     GIFT_COFB_KEY_SIZE,
@@ -32,7 +56,13 @@ aead_cipher_t const gift_cofb_cipher = {
     GIFT_COFB_TAG_SIZE,
     AEAD_FLAG_NONE,
     gift_cofb_aead_encrypt,
-    gift_cofb_aead_decrypt
+    gift_cofb_aead_decrypt,
+    sizeof(gift128b_key_schedule_t),
+    gift_cofb_aead_setup_key,
+    gift_cofb_aead_encrypt_with_context,
+    gift_cofb_aead_decrypt_with_context,
+    0, /* stream */
+    &gift_cofb_batch_cipher
 };
 
 /**
@@ -94,18 +124,18 @@ typedef union
 /**
  * \brief Applies the GIFT-COFB feedback function to Y.
  *
- * \param Y The value to be modified with the feedback function.
+ * \param Y The words of the value to be modified with the feedback function.
  *
  * Y is divided into L and R halves and then (R, L <<< 1) is returned.
  */
 #define gift_cofb_feedback(Y) \
     do { \
-        uint32_t lx = (Y)->x[0]; \
-        uint32_t ly = (Y)->x[1]; \
-        (Y)->x[0] = (Y)->x[2]; \
-        (Y)->x[1] = (Y)->x[3]; \
-        (Y)->x[2] = (lx << 1) | (ly >> 31); \
-        (Y)->x[3] = (ly << 1) | (lx >> 31); \
+        uint32_t lx = (Y)[0]; \
+        uint32_t ly = (Y)[1]; \
+        (Y)[0] = (Y)[2]; \
+        (Y)[1] = (Y)[3]; \
+        (Y)[2] = (lx << 1) | (ly >> 31); \
+        (Y)[3] = (ly << 1) | (lx >> 31); \
     } while (0)
 
 /**
@@ -119,13 +149,14 @@ typedef union
  * \param mlen Length of the plaintext in bytes.
  */
 static void gift_cofb_assoc_data
-    (gift128b_key_schedule_t *ks, gift_cofb_block_t *Y, gift_cofb_l_t *L,
-     const unsigned char *ad, unsigned long long adlen, unsigned long long mlen)
+    (const gift128b_key_schedule_t *ks, gift_cofb_block_t *Y,
+     gift_cofb_l_t *L, const unsigned char *ad, unsigned long long adlen,
+     unsigned long long mlen)
 {
     /* Deal with all associated data blocks except the last */
     while (adlen > 16) {
         gift_cofb_double_L(L);
-        gift_cofb_feedback(Y);
+        gift_cofb_feedback(Y->x);
         Y->x[0] ^= L->x ^ be_load_word32(ad);
         Y->x[1] ^= L->y ^ be_load_word32(ad + 4);
         Y->x[2] ^= be_load_word32(ad + 8);
@@ -136,7 +167,7 @@ static void gift_cofb_assoc_data
     }
 
     /* Pad and deal with the last block */
-    gift_cofb_feedback(Y);
+    gift_cofb_feedback(Y->x);
     if (adlen == 16) {
         Y->x[0] ^= be_load_word32(ad);
         Y->x[1] ^= be_load_word32(ad + 4);
@@ -188,15 +219,17 @@ static void gift_cofb_assoc_data
 
 /** @endcond */
 
-int gift_cofb_aead_encrypt
+int gift_cofb_aead_encrypt_with_context
     (unsigned char *c, unsigned long long *clen,
      const unsigned char *m, unsigned long long mlen,
      const unsigned char *ad, unsigned long long adlen,
      const unsigned char *nsec,
      const unsigned char *npub,
-     const unsigned char *k)
+     const void *ctx)
 {
-    gift128b_key_schedule_t ks;
+    gift128b_key_schedule_t temp;
+    const gift128b_key_schedule_t *ks = gift128b_expand_schedule
+        ((const gift128b_key_schedule_t *)ctx, &temp);
     gift_cofb_block_t Y;
     gift_cofb_l_t L;
     gift_cofb_block_t P;
@@ -205,18 +238,17 @@ int gift_cofb_aead_encrypt
     /* Set the length of the returned ciphertext */
     *clen = mlen + GIFT_COFB_TAG_SIZE;
 
-    /* Set up the key schedule and use it to encrypt the nonce */
-    gift128b_init(&ks, k);
+    /* Use the key schedule to encrypt the nonce */
     Y.x[0] = be_load_word32(npub);
     Y.x[1] = be_load_word32(npub + 4);
     Y.x[2] = be_load_word32(npub + 8);
     Y.x[3] = be_load_word32(npub + 12);
-    gift128b_encrypt_preloaded(&ks, Y.x, Y.x);
+    gift128b_encrypt_preloaded(ks, Y.x, Y.x);
     L.x = Y.x[0];
     L.y = Y.x[1];
 
     /* Authenticate the associated data */
-    gift_cofb_assoc_data(&ks, &Y, &L, ad, adlen, mlen);
+    gift_cofb_assoc_data(ks, &Y, &L, ad, adlen, mlen);
 
     /* Encrypt the plaintext to produce the ciphertext */
     if (mlen > 0) {
@@ -231,12 +263,12 @@ int gift_cofb_aead_encrypt
             be_store_word32(c + 8,  Y.x[2] ^ P.x[2]);
             be_store_word32(c + 12, Y.x[3] ^ P.x[3]);
             gift_cofb_double_L(&L);
-            gift_cofb_feedback(&Y);
+            gift_cofb_feedback(Y.x);
             Y.x[0] ^= L.x ^ P.x[0];
             Y.x[1] ^= L.y ^ P.x[1];
             Y.x[2] ^= P.x[2];
             Y.x[3] ^= P.x[3];
-            gift128b_encrypt_preloaded(&ks, Y.x, Y.x);
+            gift128b_encrypt_preloaded(ks, Y.x, Y.x);
             c += 16;
             m += 16;
             mlen -= 16;
@@ -252,7 +284,7 @@ int gift_cofb_aead_encrypt
             be_store_word32(c + 4,  Y.x[1] ^ P.x[1]);
             be_store_word32(c + 8,  Y.x[2] ^ P.x[2]);
             be_store_word32(c + 12, Y.x[3] ^ P.x[3]);
-            gift_cofb_feedback(&Y);
+            gift_cofb_feedback(Y.x);
             Y.x[0] ^= P.x[0];
             Y.x[1] ^= P.x[1];
             Y.x[2] ^= P.x[2];
@@ -276,7 +308,7 @@ int gift_cofb_aead_encrypt
             padded.x[3] ^= Y.x[3];
             gift_cofb_byte_swap(padded.x);
             memcpy(c, padded.y, temp);
-            gift_cofb_feedback(&Y);
+            gift_cofb_feedback(Y.x);
             Y.x[0] ^= P.x[0];
             Y.x[1] ^= P.x[1];
             Y.x[2] ^= P.x[2];
@@ -287,7 +319,7 @@ int gift_cofb_aead_encrypt
         }
         Y.x[0] ^= L.x;
         Y.x[1] ^= L.y;
-        gift128b_encrypt_preloaded(&ks, Y.x, Y.x);
+        gift128b_encrypt_preloaded(ks, Y.x, Y.x);
     }
 
     /* Generate the final authentication tag */
@@ -298,15 +330,17 @@ int gift_cofb_aead_encrypt
     return 0;
 }
 
-int gift_cofb_aead_decrypt
+int gift_cofb_aead_decrypt_with_context
     (unsigned char *m, unsigned long long *mlen,
      unsigned char *nsec,
      const unsigned char *c, unsigned long long clen,
      const unsigned char *ad, unsigned long long adlen,
      const unsigned char *npub,
-     const unsigned char *k)
+     const void *ctx)
 {
-    gift128b_key_schedule_t ks;
+    gift128b_key_schedule_t temp;
+    const gift128b_key_schedule_t *ks = gift128b_expand_schedule
+        ((const gift128b_key_schedule_t *)ctx, &temp);
     gift_cofb_block_t Y;
     gift_cofb_l_t L;
     gift_cofb_block_t P;
@@ -318,18 +352,17 @@ int gift_cofb_aead_decrypt
         return -1;
     *mlen = clen - GIFT_COFB_TAG_SIZE;
 
-    /* Set up the key schedule and use it to encrypt the nonce */
-    gift128b_init(&ks, k);
+    /* Use the key schedule to encrypt the nonce */
     Y.x[0] = be_load_word32(npub);
     Y.x[1] = be_load_word32(npub + 4);
     Y.x[2] = be_load_word32(npub + 8);
     Y.x[3] = be_load_word32(npub + 12);
-    gift128b_encrypt_preloaded(&ks, Y.x, Y.x);
+    gift128b_encrypt_preloaded(ks, Y.x, Y.x);
     L.x = Y.x[0];
     L.y = Y.x[1];
 
     /* Authenticate the associated data */
-    gift_cofb_assoc_data(&ks, &Y, &L, ad, adlen, *mlen);
+    gift_cofb_assoc_data(ks, &Y, &L, ad, adlen, *mlen);
 
     /* Decrypt the ciphertext to produce the plaintext */
     mtemp = m;
@@ -346,12 +379,12 @@ int gift_cofb_aead_decrypt
             be_store_word32(m + 8,  P.x[2]);
             be_store_word32(m + 12, P.x[3]);
             gift_cofb_double_L(&L);
-            gift_cofb_feedback(&Y);
+            gift_cofb_feedback(Y.x);
             Y.x[0] ^= L.x ^ P.x[0];
             Y.x[1] ^= L.y ^ P.x[1];
             Y.x[2] ^= P.x[2];
             Y.x[3] ^= P.x[3];
-            gift128b_encrypt_preloaded(&ks, Y.x, Y.x);
+            gift128b_encrypt_preloaded(ks, Y.x, Y.x);
             c += 16;
             m += 16;
             clen -= 16;
@@ -367,7 +400,7 @@ int gift_cofb_aead_decrypt
             be_store_word32(m + 4,  P.x[1]);
             be_store_word32(m + 8,  P.x[2]);
             be_store_word32(m + 12, P.x[3]);
-            gift_cofb_feedback(&Y);
+            gift_cofb_feedback(Y.x);
             Y.x[0] ^= P.x[0];
             Y.x[1] ^= P.x[1];
             Y.x[2] ^= P.x[2];
@@ -385,7 +418,7 @@ int gift_cofb_aead_decrypt
             P.y[temp] = 0x80;
             memset(P.y + temp + 1, 0, 16 - temp - 1);
             gift_cofb_byte_swap(P.x);
-            gift_cofb_feedback(&Y);
+            gift_cofb_feedback(Y.x);
             Y.x[0] ^= P.x[0];
             Y.x[1] ^= P.x[1];
             Y.x[2] ^= P.x[2];
@@ -396,10 +429,303 @@ int gift_cofb_aead_decrypt
         }
         Y.x[0] ^= L.x;
         Y.x[1] ^= L.y;
-        gift128b_encrypt_preloaded(&ks, Y.x, Y.x);
+        gift128b_encrypt_preloaded(ks, Y.x, Y.x);
     }
 
     /* Check the authentication tag at the end of the packet */
     gift_cofb_byte_swap(Y.x);
     return aead_check_tag(mtemp, *mlen, Y.y, c, GIFT_COFB_TAG_SIZE);
 }
+
+void gift_cofb_aead_setup_key(void *ctx, const unsigned char *k)
+{
+    gift128b_init((gift128b_key_schedule_t *)ctx, k);
+}
+
+int gift_cofb_aead_encrypt
+    (unsigned char *c, unsigned long long *clen,
+     const unsigned char *m, unsigned long long mlen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *nsec,
+     const unsigned char *npub,
+     const unsigned char *k)
+{
+    gift128b_key_schedule_t ks;
+    gift128b_init(&ks, k);
+    return gift_cofb_aead_encrypt_with_context
+        (c, clen, m, mlen, ad, adlen, nsec, npub, &ks);
+}
+
+int gift_cofb_aead_decrypt
+    (unsigned char *m, unsigned long long *mlen,
+     unsigned char *nsec,
+     const unsigned char *c, unsigned long long clen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *npub,
+     const unsigned char *k)
+{
+    gift128b_key_schedule_t ks;
+    gift128b_init(&ks, k);
+    return gift_cofb_aead_decrypt_with_context
+        (m, mlen, nsec, c, clen, ad, adlen, npub, &ks);
+}
+
+/**
+ * \brief Loads a block of up to 16 bytes for a packet in a batch and
+ * pads it if it is less than 16 bytes in length.
+ *
+ * \param P Returns the words of the padded block.
+ * \param data Points to the data to load.
+ * \param len Number of bytes to load, between 0 and 16.
+ */
+static void gift_cofb_batch_load
+    (uint32_t P[4], const unsigned char *data, unsigned len)
+{
+    unsigned char padded[16];
+    memcpy(padded, data, len);
+    if (len < 16) {
+        padded[len] = 0x80;
+        memset(padded + len + 1, 0, 16 - len - 1);
+    }
+    P[0] = be_load_word32(padded);
+    P[1] = be_load_word32(padded + 4);
+    P[2] = be_load_word32(padded + 8);
+    P[3] = be_load_word32(padded + 12);
+}
+
+/**
+ * \brief Encrypts or decrypts a block of up to 16 bytes for a packet
+ * in a batch.
+ *
+ * \param Y GIFT-COFB internal state for the packet.
+ * \param P Returns the words of the padded plaintext block.
+ * \param out Points to the output buffer.
+ * \param in Points to the input buffer.
+ * \param len Number of bytes to encrypt or decrypt, between 1 and 16.
+ * \param decrypt Non-zero to decrypt, zero to encrypt.
+ */
+static void gift_cofb_batch_xor
+    (const uint32_t Y[4], uint32_t P[4], unsigned char *out,
+     const unsigned char *in, unsigned len, int decrypt)
+{
+    unsigned char block[16];
+    unsigned char plaintext[16];
+    be_store_word32(block,      Y[0]);
+    be_store_word32(block + 4,  Y[1]);
+    be_store_word32(block + 8,  Y[2]);
+    be_store_word32(block + 12, Y[3]);
+    if (decrypt)
+        lw_xor_block_2_src(plaintext, in, block, len);
+    else
+        memcpy(plaintext, in, len);
+    lw_xor_block_2_src(out, in, block, len);
+    gift_cofb_batch_load(P, plaintext, len);
+}
+
+/**
+ * \brief Encrypts or decrypts up to GIFT128_MAX_LANES packets in parallel.
+ *
+ * \param ks Key schedules for the packets, one per lane.
+ * \param out Points to the output buffers for the packets.
+ * \param in Points to the input buffers for the packets.
+ * \param len Length of the payload of each packet, excluding the tag.
+ * \param ad Points to the associated data buffers for the packets.
+ * \param adlen Length of the associated data for each packet.
+ * \param npub Points to the nonces for the packets.
+ * \param tags Receives the computed authentication tags.
+ * \param decrypt Non-zero to decrypt, zero to encrypt.
+ */
+static void gift_cofb_batch_crypt
+    (const gift128b_multi_key_schedule_t *ks,
+     unsigned char * const *out, const unsigned char * const *in,
+     unsigned long long len,
+     const unsigned char * const *ad, unsigned long long adlen,
+     const unsigned char * const *npub,
+     unsigned char tags[][GIFT_COFB_TAG_SIZE], int decrypt)
+{
+    uint32_t Y[GIFT128_MAX_LANES][4];
+    gift_cofb_l_t L[GIFT128_MAX_LANES];
+    uint32_t P[4];
+    unsigned long long posn;
+    unsigned lane, temp;
+
+    /* Use the key schedules to encrypt the nonces */
+    for (lane = 0; lane < ks->lanes; ++lane) {
+        Y[lane][0] = be_load_word32(npub[lane]);
+        Y[lane][1] = be_load_word32(npub[lane] + 4);
+        Y[lane][2] = be_load_word32(npub[lane] + 8);
+        Y[lane][3] = be_load_word32(npub[lane] + 12);
+    }
+    gift128b_encrypt_preloaded_multi(ks, Y);
+    for (lane = 0; lane < ks->lanes; ++lane) {
+        L[lane].x = Y[lane][0];
+        L[lane].y = Y[lane][1];
+    }
+
+    /* Authenticate the associated data, all blocks except the last */
+    for (posn = 0; (posn + 16) < adlen; posn += 16) {
+        for (lane = 0; lane < ks->lanes; ++lane) {
+            gift_cofb_batch_load(P, ad[lane] + posn, 16);
+            gift_cofb_double_L(&(L[lane]));
+            gift_cofb_feedback(Y[lane]);
+            Y[lane][0] ^= L[lane].x ^ P[0];
+            Y[lane][1] ^= L[lane].y ^ P[1];
+            Y[lane][2] ^= P[2];
+            Y[lane][3] ^= P[3];
+        }
+        gift128b_encrypt_preloaded_multi(ks, Y);
+    }
+
+    /* Pad and deal with the last associated data block */
+    temp = (unsigned)(adlen - posn);
+    for (lane = 0; lane < ks->lanes; ++lane) {
+        gift_cofb_batch_load(P, ad[lane] + posn, temp);
+        gift_cofb_feedback(Y[lane]);
+        Y[lane][0] ^= P[0];
+        Y[lane][1] ^= P[1];
+        Y[lane][2] ^= P[2];
+        Y[lane][3] ^= P[3];
+        gift_cofb_triple_L(&(L[lane]));
+        if (temp < 16)
+            gift_cofb_triple_L(&(L[lane]));
+        if (len == 0) {
+            gift_cofb_triple_L(&(L[lane]));
+            gift_cofb_triple_L(&(L[lane]));
+        }
+        Y[lane][0] ^= L[lane].x;
+        Y[lane][1] ^= L[lane].y;
+    }
+    gift128b_encrypt_preloaded_multi(ks, Y);
+
+    /* Encrypt or decrypt the payload */
+    if (len > 0) {
+        /* Deal with all blocks except the last */
+        for (posn = 0; (posn + 16) < len; posn += 16) {
+            for (lane = 0; lane < ks->lanes; ++lane) {
+                gift_cofb_batch_xor
+                    (Y[lane], P, out[lane] + posn, in[lane] + posn, 16,
+                     decrypt);
+                gift_cofb_double_L(&(L[lane]));
+                gift_cofb_feedback(Y[lane]);
+                Y[lane][0] ^= L[lane].x ^ P[0];
+                Y[lane][1] ^= L[lane].y ^ P[1];
+                Y[lane][2] ^= P[2];
+                Y[lane][3] ^= P[3];
+            }
+            gift128b_encrypt_preloaded_multi(ks, Y);
+        }
+
+        /* Pad and deal with the last block */
+        temp = (unsigned)(len - posn);
+        for (lane = 0; lane < ks->lanes; ++lane) {
+            gift_cofb_batch_xor
+                (Y[lane], P, out[lane] + posn, in[lane] + posn, temp,
+                 decrypt);
+            gift_cofb_feedback(Y[lane]);
+            Y[lane][0] ^= P[0];
+            Y[lane][1] ^= P[1];
+            Y[lane][2] ^= P[2];
+            Y[lane][3] ^= P[3];
+            gift_cofb_triple_L(&(L[lane]));
+            if (temp < 16)
+                gift_cofb_triple_L(&(L[lane]));
+            Y[lane][0] ^= L[lane].x;
+            Y[lane][1] ^= L[lane].y;
+        }
+        gift128b_encrypt_preloaded_multi(ks, Y);
+    }
+
+    /* Generate the authentication tags */
+    for (lane = 0; lane < ks->lanes; ++lane) {
+        unsigned char *tag = tags[lane];
+        be_store_word32(tag,      Y[lane][0]);
+        be_store_word32(tag + 4,  Y[lane][1]);
+        be_store_word32(tag + 8,  Y[lane][2]);
+        be_store_word32(tag + 12, Y[lane][3]);
+    }
+}
+
+/**
+ * \brief Encrypts or decrypts a batch of packets with GIFT-COFB, using
+ * the multi-block GIFT-128 kernels for runs of packets that have the
+ * same lengths.
+ *
+ * \param items Points to the descriptors for the packets.
+ * \param count Number of packets in the batch.
+ * \param decrypt Non-zero to decrypt, zero to encrypt.
+ */
+static void gift_cofb_batch_items
+    (aead_batch_item_t *items, size_t count, int decrypt)
+{
+    gift128b_key_schedule_t schedules[GIFT128_MAX_LANES];
+    const gift128b_key_schedule_t *keys[GIFT128_MAX_LANES];
+    gift128b_multi_key_schedule_t ks;
+    unsigned char *out[GIFT128_MAX_LANES];
+    const unsigned char *in[GIFT128_MAX_LANES];
+    const unsigned char *ad[GIFT128_MAX_LANES];
+    const unsigned char *npub[GIFT128_MAX_LANES];
+    unsigned char tags[GIFT128_MAX_LANES][GIFT_COFB_TAG_SIZE];
+    unsigned long long inlen, adlen, len;
+    unsigned lanes, lane;
+    while (count > 0) {
+        /* A ciphertext that is too short to contain a tag fails by itself */
+        inlen = items[0].inlen;
+        adlen = items[0].adlen;
+        if (decrypt && inlen < GIFT_COFB_TAG_SIZE) {
+            items[0].outlen = 0;
+            items[0].status = -1;
+            ++items;
+            --count;
+            continue;
+        }
+
+        /* Collect a run of packets with the same lengths */
+        lanes = 0;
+        do {
+            out[lanes] = items[lanes].out;
+            in[lanes] = items[lanes].in;
+            ad[lanes] = items[lanes].ad;
+            npub[lanes] = items[lanes].npub;
+            if (items[lanes].key) {
+                gift128b_init(&(schedules[lanes]), items[lanes].key);
+                keys[lanes] = &(schedules[lanes]);
+            } else {
+                keys[lanes] = gift128b_expand_schedule
+                    ((const gift128b_key_schedule_t *)(items[lanes].ctx),
+                     &(schedules[lanes]));
+            }
+            ++lanes;
+        } while (lanes < GIFT128_MAX_LANES && lanes < count &&
+                 items[lanes].inlen == inlen && items[lanes].adlen == adlen);
+
+        /* Process the run of packets */
+        gift128b_multi_init(&ks, keys, lanes);
+        len = decrypt ? (inlen - GIFT_COFB_TAG_SIZE) : inlen;
+        gift_cofb_batch_crypt
+            (&ks, out, in, len, ad, adlen, npub, tags, decrypt);
+        for (lane = 0; lane < lanes; ++lane) {
+            if (decrypt) {
+                items[lane].outlen = len;
+                items[lane].status = aead_check_tag
+                    (out[lane], len, tags[lane], in[lane] + len,
+                     GIFT_COFB_TAG_SIZE);
+            } else {
+                memcpy(out[lane] + len, tags[lane], GIFT_COFB_TAG_SIZE);
+                items[lane].outlen = len + GIFT_COFB_TAG_SIZE;
+                items[lane].status = 0;
+            }
+        }
+        items += lanes;
+        count -= lanes;
+    }
+}
+
+static void gift_cofb_batch_encrypt(aead_batch_item_t *items, size_t count)
+{
+    gift_cofb_batch_items(items, count, 0);
+}
+
+static void gift_cofb_batch_decrypt(aead_batch_item_t *items, size_t count)
+{
+    gift_cofb_batch_items(items, count, 1);
+}
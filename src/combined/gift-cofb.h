@@ -120,6 +120,82 @@ int gift_cofb_aead_decrypt
      const unsigned char *npub,
      const unsigned char *k);
 
+/**
+ * \brief Sets up a precomputed key context for GIFT-COFB.
+ *
+ * \param ctx Points to the key context to set up, which must be at least
+ * gift_cofb_cipher.context_size bytes in length and suitably aligned for any
+ * integer type.
+ * \param k Points to the 16 bytes of the key.
+ *
+ * \sa gift_cofb_aead_encrypt_with_context(),
+ * gift_cofb_aead_decrypt_with_context()
+ */
+void gift_cofb_aead_setup_key(void *ctx, const unsigned char *k);
+
+/**
+ * \brief Encrypts and authenticates a packet with GIFT-COFB using a
+ * precomputed key context.
+ *
+ * \param c Buffer to receive the output.
+ * \param clen On exit, set to the length of the output which includes
+ * the ciphertext and the 16 byte authentication tag.
+ * \param m Buffer that contains the plaintext message to encrypt.
+ * \param mlen Length of the plaintext message in bytes.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param nsec Secret nonce - not used by this algorithm.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param ctx Points to the key context that was set up by
+ * gift_cofb_aead_setup_key().
+ *
+ * \return 0 on success, or a negative value if there was an error in
+ * the parameters.
+ *
+ * \sa gift_cofb_aead_decrypt_with_context(), gift_cofb_aead_setup_key()
+ */
+int gift_cofb_aead_encrypt_with_context
+    (unsigned char *c, unsigned long long *clen,
+     const unsigned char *m, unsigned long long mlen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *nsec,
+     const unsigned char *npub,
+     const void *ctx);
+
+/**
+ * \brief Decrypts and authenticates a packet with GIFT-COFB using a
+ * precomputed key context.
+ *
+ * \param m Buffer to receive the plaintext message on output.
+ * \param mlen Receives the length of the plaintext message on output.
+ * \param nsec Secret nonce - not used by this algorithm.
+ * \param c Buffer that contains the ciphertext and authentication
+ * tag to decrypt.
+ * \param clen Length of the input data in bytes, which includes the
+ * ciphertext and the 16 byte authentication tag.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param ctx Points to the key context that was set up by
+ * gift_cofb_aead_setup_key().
+ *
+ * \return 0 on success, -1 if the authentication tag was incorrect,
+ * or some other negative number if there was an error in the parameters.
+ *
+ * \sa gift_cofb_aead_encrypt_with_context(), gift_cofb_aead_setup_key()
+ */
+int gift_cofb_aead_decrypt_with_context
+    (unsigned char *m, unsigned long long *mlen,
+     unsigned char *nsec,
+     const unsigned char *c, unsigned long long clen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *npub,
+     const void *ctx);
+
 #ifdef __cplusplus
 }
 #endif
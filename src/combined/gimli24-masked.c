@@ -20,13 +20,14 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include "internal-masking.h"
 #include "gimli24-masked.h"
 #include "internal-gimli24.h"
 #include "internal-gimli24-m.h"
 #include <string.h>
 
 aead_cipher_t const gimli24_masked_cipher = {
-    "GIMLI-24-Masked",
+    AEAD_MASKING_CIPHER_NAME("GIMLI-24-Masked"),
     GIMLI24_MASKED_KEY_SIZE,
     GIMLI24_MASKED_NONCE_SIZE,
     GIMLI24_MASKED_TAG_SIZE,
@@ -36,7 +37,13 @@ aead_cipher_t const gimli24_masked_cipher = {
     AEAD_FLAG_LITTLE_ENDIAN | AEAD_FLAG_SC_PROTECT_ALL,
 #endif
     gimli24_masked_aead_encrypt,
-    gimli24_masked_aead_decrypt
+    gimli24_masked_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 /**
@@ -65,6 +65,24 @@ extern "C" {
  */
 extern aead_cipher_t const gimli24_masked_cipher;
 
+/**
+ * \brief Meta-information block for the masked GIMLI-24 cipher with
+ * 2 shares.
+ */
+extern aead_cipher_t const gimli24_masked_cipher_x2;
+
+/**
+ * \brief Meta-information block for the masked GIMLI-24 cipher with
+ * 3 shares.
+ */
+extern aead_cipher_t const gimli24_masked_cipher_x3;
+
+/**
+ * \brief Meta-information block for the masked GIMLI-24 cipher with
+ * 4 shares.
+ */
+extern aead_cipher_t const gimli24_masked_cipher_x4;
+
 /**
  * \brief Encrypts and authenticates a packet with masked GIMLI-24 using the
  * full AEAD mode.
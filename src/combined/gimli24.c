@@ -24,6 +24,43 @@
 #include "internal-gimli24.h"
 #include <string.h>
 
+/**
+ * \brief Encrypts a batch of packets with GIMLI-24.
+ *
+ * \param items Points to the descriptors for the packets.
+ * \param count Number of packets in the batch.
+ */
+static void gimli24_batch_encrypt(aead_batch_item_t *items, size_t count);
+
+/**
+ * \brief Decrypts a batch of packets with GIMLI-24.
+ *
+ * \param items Points to the descriptors for the packets.
+ * \param count Number of packets in the batch.
+ */
+static void gimli24_batch_decrypt(aead_batch_item_t *items, size_t count);
+
+/**
+ * \brief Batch AEAD functions for GIMLI-24.
+ */
+static aead_batch_cipher_t const gimli24_batch_cipher = {
+    gimli24_batch_encrypt,
+    gimli24_batch_decrypt
+};
+
+/**
+ * \brief Incremental AEAD functions for GIMLI-24.
+ */
+static aead_stream_cipher_t const gimli24_stream_cipher = {
+    sizeof(gimli24_aead_state_t),
+    (aead_stream_init_t)gimli24_aead_stream_init,
+    (aead_stream_update_ad_t)gimli24_aead_stream_update_ad,
+    (aead_stream_crypt_t)gimli24_aead_stream_encrypt,
+    (aead_stream_crypt_t)gimli24_aead_stream_decrypt,
+    (aead_stream_encrypt_finalize_t)gimli24_aead_stream_encrypt_finalize,
+    (aead_stream_decrypt_finalize_t)gimli24_aead_stream_decrypt_finalize
+};
+
 aead_cipher_t const gimli24_cipher = {
     "GIMLI-24",
     GIMLI24_KEY_SIZE,
@@ -31,7 +68,13 @@ aead_cipher_t const gimli24_cipher = {
     GIMLI24_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN,
     gimli24_aead_encrypt,
-    gimli24_aead_decrypt
+    gimli24_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    &gimli24_stream_cipher,
+    &gimli24_batch_cipher
 };
 
 aead_hash_algorithm_t const gimli24_hash_algorithm = {
@@ -225,6 +268,201 @@ int gimli24_hash
     return 0;
 }
 
+/**
+ * \brief Permutes several GIMLI-24 states with the multi-state kernels.
+ *
+ * \param states Points to the states.
+ * \param lanes Number of states.
+ */
+#define gimli24_permute_states(states, lanes) \
+    gimli24_permute_n((uint32_t (*)[12])((states)[0].words), (lanes))
+
+/**
+ * \brief Absorbs data into several GIMLI-24 states in lock-step.
+ *
+ * \param states Points to the states to absorb the data into.
+ * \param lanes Number of states.
+ * \param data Points to the data to be absorbed for each state.
+ * \param len Length of the data to be absorbed for every state.
+ *
+ * This is equivalent to calling gimli24_absorb() on each state.
+ */
+static void gimli24_absorb_n
+    (gimli24_state_t *states, unsigned lanes,
+     const unsigned char * const *data, unsigned long long len)
+{
+    unsigned long long posn;
+    unsigned temp, lane;
+    for (posn = 0; (len - posn) >= GIMLI24_BLOCK_SIZE;
+            posn += GIMLI24_BLOCK_SIZE) {
+        for (lane = 0; lane < lanes; ++lane) {
+            lw_xor_block(states[lane].bytes, data[lane] + posn,
+                         GIMLI24_BLOCK_SIZE);
+        }
+        gimli24_permute_states(states, lanes);
+    }
+    temp = (unsigned)(len - posn);
+    for (lane = 0; lane < lanes; ++lane) {
+        lw_xor_block(states[lane].bytes, data[lane] + posn, temp);
+        states[lane].bytes[temp] ^= 0x01; /* Padding */
+        states[lane].bytes[47] ^= 0x01;
+    }
+    gimli24_permute_states(states, lanes);
+}
+
+/**
+ * \brief Encrypts or decrypts a single packet from a batch with GIMLI-24.
+ *
+ * \param item The packet to process.
+ * \param decrypt Non-zero to decrypt, zero to encrypt.
+ */
+static void gimli24_batch_single(aead_batch_item_t *item, int decrypt)
+{
+    /* GIMLI-24 has no key schedule, so a key context is a raw key */
+    const unsigned char *k = item->key;
+    if (!k)
+        k = (const unsigned char *)(item->ctx);
+    if (decrypt) {
+        item->status = gimli24_aead_decrypt
+            (item->out, &(item->outlen), 0, item->in, item->inlen,
+             item->ad, item->adlen, item->npub, k);
+    } else {
+        item->status = gimli24_aead_encrypt
+            (item->out, &(item->outlen), item->in, item->inlen,
+             item->ad, item->adlen, 0, item->npub, k);
+    }
+}
+
+/**
+ * \brief Encrypts or decrypts a batch of packets with GIMLI-24, permuting
+ * the states for runs of packets with the same lengths side by side.
+ *
+ * \param items Points to the descriptors for the packets.
+ * \param count Number of packets in the batch.
+ * \param decrypt Non-zero to decrypt, zero to encrypt.
+ */
+static void gimli24_batch_items
+    (aead_batch_item_t *items, size_t count, int decrypt)
+{
+    gimli24_state_t states[GIMLI24_MAX_LANES];
+    const unsigned char *ad[GIMLI24_MAX_LANES];
+    const unsigned char *k;
+    unsigned long long inlen, adlen, len, posn;
+    unsigned lanes, lane, temp;
+    while (count > 0) {
+        /* Measure the run of packets with the same lengths */
+        inlen = items[0].inlen;
+        adlen = items[0].adlen;
+        lanes = 1;
+        while (lanes < GIMLI24_MAX_LANES && lanes < count &&
+                items[lanes].inlen == inlen && items[lanes].adlen == adlen)
+            ++lanes;
+
+        /* Lone packets and invalid lengths are handled one at a time */
+        if (lanes == 1 || (decrypt && inlen < GIMLI24_TAG_SIZE)) {
+            for (lane = 0; lane < lanes; ++lane)
+                gimli24_batch_single(&(items[lane]), decrypt);
+            items += lanes;
+            count -= lanes;
+            continue;
+        }
+
+        /* Format the initial GIMLI states from the nonces and the keys */
+        for (lane = 0; lane < lanes; ++lane) {
+            k = items[lane].key;
+            if (!k)
+                k = (const unsigned char *)(items[lane].ctx);
+            memcpy(states[lane].words, items[lane].npub, GIMLI24_NONCE_SIZE);
+            memcpy(states[lane].words + 4, k, GIMLI24_KEY_SIZE);
+            ad[lane] = items[lane].ad;
+        }
+        gimli24_permute_states(states, lanes);
+
+        /* Absorb the associated data */
+        gimli24_absorb_n(states, lanes, ad, adlen);
+
+        /* Encrypt or decrypt the payloads */
+        len = decrypt ? (inlen - GIMLI24_TAG_SIZE) : inlen;
+        for (posn = 0;; posn += GIMLI24_BLOCK_SIZE) {
+            temp = ((len - posn) >= GIMLI24_BLOCK_SIZE)
+                ? GIMLI24_BLOCK_SIZE : (unsigned)(len - posn);
+            for (lane = 0; lane < lanes; ++lane) {
+                if (decrypt) {
+                    lw_xor_block_swap
+                        (items[lane].out + posn, states[lane].bytes,
+                         items[lane].in + posn, temp);
+                } else {
+                    lw_xor_block_2_dest
+                        (items[lane].out + posn, states[lane].bytes,
+                         items[lane].in + posn, temp);
+                }
+                if (temp < GIMLI24_BLOCK_SIZE) {
+                    states[lane].bytes[temp] ^= 0x01; /* Padding */
+                    states[lane].bytes[47] ^= 0x01;
+                }
+            }
+            gimli24_permute_states(states, lanes);
+            if (temp < GIMLI24_BLOCK_SIZE)
+                break;
+        }
+
+        /* Generate or check the authentication tags */
+        for (lane = 0; lane < lanes; ++lane) {
+            if (decrypt) {
+                items[lane].outlen = len;
+                items[lane].status = aead_check_tag
+                    (items[lane].out, len, states[lane].bytes,
+                     items[lane].in + len, GIMLI24_TAG_SIZE);
+            } else {
+                memcpy(items[lane].out + len, states[lane].bytes,
+                       GIMLI24_TAG_SIZE);
+                items[lane].outlen = len + GIMLI24_TAG_SIZE;
+                items[lane].status = 0;
+            }
+        }
+        items += lanes;
+        count -= lanes;
+    }
+}
+
+static void gimli24_batch_encrypt(aead_batch_item_t *items, size_t count)
+{
+    gimli24_batch_items(items, count, 0);
+}
+
+static void gimli24_batch_decrypt(aead_batch_item_t *items, size_t count)
+{
+    gimli24_batch_items(items, count, 1);
+}
+
+void gimli24_hash_batch
+    (unsigned char * const *out, const unsigned char * const *in,
+     unsigned long long inlen, size_t count)
+{
+    gimli24_state_t states[GIMLI24_MAX_LANES];
+    unsigned lanes, lane;
+    while (count > 0) {
+        lanes = (count < GIMLI24_MAX_LANES) ? (unsigned)count
+                                            : GIMLI24_MAX_LANES;
+
+        /* Initialize the hash states to all zeroes and absorb the input */
+        memset(states, 0, sizeof(gimli24_state_t) * lanes);
+        gimli24_absorb_n(states, lanes, in, inlen);
+
+        /* Generate the output hashes */
+        for (lane = 0; lane < lanes; ++lane)
+            memcpy(out[lane], states[lane].bytes, GIMLI24_HASH_SIZE / 2);
+        gimli24_permute_states(states, lanes);
+        for (lane = 0; lane < lanes; ++lane) {
+            memcpy(out[lane] + GIMLI24_HASH_SIZE / 2, states[lane].bytes,
+                   GIMLI24_HASH_SIZE / 2);
+        }
+        out += lanes;
+        in += lanes;
+        count -= lanes;
+    }
+}
+
 void gimli24_hash_init(gimli24_hash_state_t *state)
 {
     memset(state, 0, sizeof(gimli24_hash_state_t));
@@ -328,3 +566,197 @@ void gimli24_hash_finalize
 {
     gimli24_hash_squeeze(state, out, GIMLI24_HASH_SIZE);
 }
+
+/**
+ * \brief Mode value for an incremental GIMLI-24 state that is absorbing
+ * associated data.
+ */
+#define GIMLI24_STREAM_MODE_AD 0
+
+/**
+ * \brief Mode value for an incremental GIMLI-24 state that is encrypting
+ * or decrypting the payload.
+ */
+#define GIMLI24_STREAM_MODE_PAYLOAD 1
+
+void gimli24_aead_stream_init
+    (gimli24_aead_state_t *state, const unsigned char *npub,
+     const unsigned char *k)
+{
+    /* Format the initial GIMLI state from the nonce and the key */
+    memcpy(state->s.state, npub, GIMLI24_NONCE_SIZE);
+    memcpy(state->s.state + GIMLI24_NONCE_SIZE, k, GIMLI24_KEY_SIZE);
+    state->s.count = 0;
+    state->s.mode = GIMLI24_STREAM_MODE_AD;
+
+    /* Permute the initial state */
+    gimli24_permute((uint32_t *)(state->s.state));
+}
+
+void gimli24_aead_stream_update_ad
+    (gimli24_aead_state_t *state, const unsigned char *ad,
+     unsigned long long adlen)
+{
+    gimli24_state_t *st = (gimli24_state_t *)(state->s.state);
+    unsigned temp;
+
+    /* Handle the partial left-over block from last time */
+    if (state->s.count) {
+        temp = GIMLI24_BLOCK_SIZE - state->s.count;
+        if (temp > adlen) {
+            temp = (unsigned)adlen;
+            lw_xor_block(st->bytes + state->s.count, ad, temp);
+            state->s.count += temp;
+            return;
+        }
+        lw_xor_block(st->bytes + state->s.count, ad, temp);
+        gimli24_permute(st->words);
+        state->s.count = 0;
+        ad += temp;
+        adlen -= temp;
+    }
+
+    /* Process full blocks that are aligned at state->s.count == 0 */
+    while (adlen >= GIMLI24_BLOCK_SIZE) {
+        lw_xor_block(st->bytes, ad, GIMLI24_BLOCK_SIZE);
+        gimli24_permute(st->words);
+        ad += GIMLI24_BLOCK_SIZE;
+        adlen -= GIMLI24_BLOCK_SIZE;
+    }
+
+    /* Process the left-over block; padding is deferred */
+    temp = (unsigned)adlen;
+    lw_xor_block(st->bytes, ad, temp);
+    state->s.count = temp;
+}
+
+/**
+ * \brief Pads the last block of associated data and switches an
+ * incremental GIMLI-24 state into payload mode if necessary.
+ *
+ * \param state The incremental AEAD state.
+ */
+static void gimli24_aead_stream_start_payload(gimli24_aead_state_t *state)
+{
+    gimli24_state_t *st = (gimli24_state_t *)(state->s.state);
+    if (state->s.mode == GIMLI24_STREAM_MODE_AD) {
+        st->bytes[state->s.count] ^= 0x01; /* Padding */
+        st->bytes[47] ^= 0x01;
+        gimli24_permute(st->words);
+        state->s.count = 0;
+        state->s.mode = GIMLI24_STREAM_MODE_PAYLOAD;
+    }
+}
+
+void gimli24_aead_stream_encrypt
+    (gimli24_aead_state_t *state, unsigned char *c,
+     const unsigned char *m, unsigned long long len)
+{
+    gimli24_state_t *st = (gimli24_state_t *)(state->s.state);
+    unsigned temp;
+
+    /* Make sure that we are in payload mode */
+    gimli24_aead_stream_start_payload(state);
+
+    /* Handle the partial left-over block from last time */
+    if (state->s.count) {
+        temp = GIMLI24_BLOCK_SIZE - state->s.count;
+        if (temp > len) {
+            temp = (unsigned)len;
+            lw_xor_block_2_dest(c, st->bytes + state->s.count, m, temp);
+            state->s.count += temp;
+            return;
+        }
+        lw_xor_block_2_dest(c, st->bytes + state->s.count, m, temp);
+        gimli24_permute(st->words);
+        state->s.count = 0;
+        c += temp;
+        m += temp;
+        len -= temp;
+    }
+
+    /* Process full blocks that are aligned at state->s.count == 0 */
+    while (len >= GIMLI24_BLOCK_SIZE) {
+        lw_xor_block_2_dest(c, st->bytes, m, GIMLI24_BLOCK_SIZE);
+        gimli24_permute(st->words);
+        c += GIMLI24_BLOCK_SIZE;
+        m += GIMLI24_BLOCK_SIZE;
+        len -= GIMLI24_BLOCK_SIZE;
+    }
+
+    /* Process the left-over block at the end of the input */
+    temp = (unsigned)len;
+    lw_xor_block_2_dest(c, st->bytes, m, temp);
+    state->s.count = temp;
+}
+
+void gimli24_aead_stream_decrypt
+    (gimli24_aead_state_t *state, unsigned char *m,
+     const unsigned char *c, unsigned long long len)
+{
+    gimli24_state_t *st = (gimli24_state_t *)(state->s.state);
+    unsigned temp;
+
+    /* Make sure that we are in payload mode */
+    gimli24_aead_stream_start_payload(state);
+
+    /* Handle the partial left-over block from last time */
+    if (state->s.count) {
+        temp = GIMLI24_BLOCK_SIZE - state->s.count;
+        if (temp > len) {
+            temp = (unsigned)len;
+            lw_xor_block_swap(m, st->bytes + state->s.count, c, temp);
+            state->s.count += temp;
+            return;
+        }
+        lw_xor_block_swap(m, st->bytes + state->s.count, c, temp);
+        gimli24_permute(st->words);
+        state->s.count = 0;
+        c += temp;
+        m += temp;
+        len -= temp;
+    }
+
+    /* Process full blocks that are aligned at state->s.count == 0 */
+    while (len >= GIMLI24_BLOCK_SIZE) {
+        lw_xor_block_swap(m, st->bytes, c, GIMLI24_BLOCK_SIZE);
+        gimli24_permute(st->words);
+        c += GIMLI24_BLOCK_SIZE;
+        m += GIMLI24_BLOCK_SIZE;
+        len -= GIMLI24_BLOCK_SIZE;
+    }
+
+    /* Process the left-over block at the end of the input */
+    temp = (unsigned)len;
+    lw_xor_block_swap(m, st->bytes, c, temp);
+    state->s.count = temp;
+}
+
+/**
+ * \brief Pads the final payload block of an incremental GIMLI-24 state
+ * and computes the authentication tag.
+ *
+ * \param state The incremental AEAD state.
+ */
+static void gimli24_aead_stream_compute_tag(gimli24_aead_state_t *state)
+{
+    gimli24_state_t *st = (gimli24_state_t *)(state->s.state);
+    gimli24_aead_stream_start_payload(state);
+    st->bytes[state->s.count] ^= 0x01; /* Padding */
+    st->bytes[47] ^= 0x01;
+    gimli24_permute(st->words);
+}
+
+void gimli24_aead_stream_encrypt_finalize
+    (gimli24_aead_state_t *state, unsigned char *tag)
+{
+    gimli24_aead_stream_compute_tag(state);
+    memcpy(tag, state->s.state, GIMLI24_TAG_SIZE);
+}
+
+int gimli24_aead_stream_decrypt_finalize
+    (gimli24_aead_state_t *state, const unsigned char *tag)
+{
+    gimli24_aead_stream_compute_tag(state);
+    return aead_check_tag(0, 0, state->s.state, tag, GIMLI24_TAG_SIZE);
+}
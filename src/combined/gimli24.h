@@ -77,6 +77,20 @@ typedef union
 
 } gimli24_hash_state_t;
 
+/**
+ * \brief State information for the incremental GIMLI-24 AEAD mode.
+ */
+typedef union
+{
+    struct {
+        unsigned char state[48]; /**< Current permutation state */
+        unsigned char count;     /**< Number of bytes in the current block */
+        unsigned char mode;      /**< Associated data or payload mode */
+    } s;                         /**< State */
+    unsigned long long align;    /**< For alignment of this structure */
+
+} gimli24_aead_state_t;
+
 /**
  * \brief Meta-information block for the GIMLI-24 cipher.
  */
@@ -150,6 +164,86 @@ int gimli24_aead_decrypt
      const unsigned char *npub,
      const unsigned char *k);
 
+/**
+ * \brief Initializes the state for an incremental GIMLI-24 operation.
+ *
+ * \param state Incremental AEAD state to be initialized.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 32 bytes of the key to use to encrypt or
+ * decrypt the packet.
+ *
+ * \sa gimli24_aead_stream_update_ad(), gimli24_aead_stream_encrypt(),
+ * gimli24_aead_stream_decrypt()
+ */
+void gimli24_aead_stream_init
+    (gimli24_aead_state_t *state, const unsigned char *npub,
+     const unsigned char *k);
+
+/**
+ * \brief Absorbs more associated data into an incremental GIMLI-24 state.
+ *
+ * \param state Incremental AEAD state to be updated.
+ * \param ad Points to the associated data to be absorbed.
+ * \param adlen Length of the associated data in bytes.
+ *
+ * All associated data must be absorbed before the payload is encrypted
+ * or decrypted.
+ */
+void gimli24_aead_stream_update_ad
+    (gimli24_aead_state_t *state, const unsigned char *ad,
+     unsigned long long adlen);
+
+/**
+ * \brief Encrypts more payload data with an incremental GIMLI-24 state.
+ *
+ * \param state Incremental AEAD state to be updated.
+ * \param c Buffer to receive \a len bytes of ciphertext.
+ * \param m Points to the plaintext to be encrypted.
+ * \param len Number of bytes to be encrypted.
+ *
+ * \sa gimli24_aead_stream_encrypt_finalize()
+ */
+void gimli24_aead_stream_encrypt
+    (gimli24_aead_state_t *state, unsigned char *c,
+     const unsigned char *m, unsigned long long len);
+
+/**
+ * \brief Decrypts more payload data with an incremental GIMLI-24 state.
+ *
+ * \param state Incremental AEAD state to be updated.
+ * \param m Buffer to receive \a len bytes of plaintext.
+ * \param c Points to the ciphertext to be decrypted.
+ * \param len Number of bytes to be decrypted.
+ *
+ * \sa gimli24_aead_stream_decrypt_finalize()
+ */
+void gimli24_aead_stream_decrypt
+    (gimli24_aead_state_t *state, unsigned char *m,
+     const unsigned char *c, unsigned long long len);
+
+/**
+ * \brief Finalizes an incremental GIMLI-24 encryption operation.
+ *
+ * \param state Incremental AEAD state to be finalized.
+ * \param tag Buffer to receive the 16 byte authentication tag.
+ */
+void gimli24_aead_stream_encrypt_finalize
+    (gimli24_aead_state_t *state, unsigned char *tag);
+
+/**
+ * \brief Finalizes an incremental GIMLI-24 decryption operation.
+ *
+ * \param state Incremental AEAD state to be finalized.
+ * \param tag Points to the 16 byte authentication tag to be checked.
+ *
+ * \return 0 if the authentication tag is correct, or -1 otherwise.
+ * The plaintext that was returned by gimli24_aead_stream_decrypt() must
+ * be discarded if the authentication tag is incorrect.
+ */
+int gimli24_aead_stream_decrypt_finalize
+    (gimli24_aead_state_t *state, const unsigned char *tag);
+
 /**
  * \brief Hashes a block of input data with GIMLI-24 to generate a hash value.
  *
@@ -164,6 +258,25 @@ int gimli24_aead_decrypt
 int gimli24_hash
     (unsigned char *out, const unsigned char *in, unsigned long long inlen);
 
+/**
+ * \brief Hashes several messages of the same length with GIMLI-24.
+ *
+ * \param out Array of \a count pointers to buffers that receive the
+ * hash outputs, each at least GIMLI24_HASH_SIZE bytes in length.
+ * \param in Array of \a count pointers to the messages to be hashed.
+ * \param inlen Length of every message in bytes.
+ * \param count Number of messages to hash.
+ *
+ * The messages are hashed side by side so that the GIMLI-24 permutations
+ * for different messages can share the multi-state kernels.  The results
+ * are the same as calling gimli24_hash() on each message.
+ *
+ * \sa gimli24_hash()
+ */
+void gimli24_hash_batch
+    (unsigned char * const *out, const unsigned char * const *in,
+     unsigned long long inlen, size_t count);
+
 /**
  * \brief Initializes the state for a GIMLI-24-HASH hashing operation.
  *
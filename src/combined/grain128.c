@@ -24,6 +24,30 @@
 #include "internal-grain128.h"
 #include <string.h>
 
+/**
+ * \brief Encrypts a batch of packets with Grain-128AEAD.
+ *
+ * \param items Points to the descriptors for the packets.
+ * \param count Number of packets in the batch.
+ */
+static void grain128_batch_encrypt(aead_batch_item_t *items, size_t count);
+
+/**
+ * \brief Decrypts a batch of packets with Grain-128AEAD.
+ *
+ * \param items Points to the descriptors for the packets.
+ * \param count Number of packets in the batch.
+ */
+static void grain128_batch_decrypt(aead_batch_item_t *items, size_t count);
+
+/**
+ * \brief Batch AEAD functions for Grain-128AEAD.
+ */
+static aead_batch_cipher_t const grain128_batch_cipher = {
+    grain128_batch_encrypt,
+    grain128_batch_decrypt
+};
+
 aead_cipher_t const grain128_aead_cipher = {
     "Grain-128AEAD",
     GRAIN128_KEY_SIZE,
@@ -31,7 +55,13 @@ aead_cipher_t const grain128_aead_cipher = {
     GRAIN128_TAG_SIZE,
     AEAD_FLAG_NONE,
     grain128_aead_encrypt,
-    grain128_aead_decrypt
+    grain128_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    &grain128_batch_cipher
 };
 
 /**
@@ -149,3 +179,140 @@ int grain128_aead_decrypt
     grain128_compute_tag(&state);
     return aead_check_tag(m, clen, state.ks, c + clen, GRAIN128_TAG_SIZE);
 }
+
+/**
+ * \brief Encrypts or decrypts a single packet from a batch.
+ *
+ * \param item The packet to process.
+ * \param decrypt Non-zero to decrypt, zero to encrypt.
+ */
+static void grain128_batch_single(aead_batch_item_t *item, int decrypt)
+{
+    /* Grain-128AEAD has no key schedule, so a key context is a raw key */
+    const unsigned char *k = item->key;
+    if (!k)
+        k = (const unsigned char *)(item->ctx);
+    if (decrypt) {
+        item->status = grain128_aead_decrypt
+            (item->out, &(item->outlen), 0, item->in, item->inlen,
+             item->ad, item->adlen, item->npub, k);
+    } else {
+        item->status = grain128_aead_encrypt
+            (item->out, &(item->outlen), item->in, item->inlen,
+             item->ad, item->adlen, 0, item->npub, k);
+    }
+}
+
+#if GRAIN128_MULTI
+
+/**
+ * \brief Encrypts or decrypts a batch of packets with Grain-128AEAD,
+ * using the bit-sliced multi-session kernels for long runs of packets
+ * that have the same lengths.
+ *
+ * \param items Points to the descriptors for the packets.
+ * \param count Number of packets in the batch.
+ * \param decrypt Non-zero to decrypt, zero to encrypt.
+ *
+ * The kernels clock every session in lock-step, so a run of packets
+ * costs the same no matter how many of the sessions are in use.  Runs
+ * that are shorter than a quarter of the sessions are processed one
+ * packet at a time instead.
+ */
+static void grain128_batch_items
+    (aead_batch_item_t *items, size_t count, int decrypt)
+{
+    grain128_multi_state_t state;
+    const unsigned char *keys[GRAIN128_MULTI_MAX_LANES];
+    const unsigned char *npub[GRAIN128_MULTI_MAX_LANES];
+    const unsigned char *ad[GRAIN128_MULTI_MAX_LANES];
+    const unsigned char *in[GRAIN128_MULTI_MAX_LANES];
+    unsigned char *out[GRAIN128_MULTI_MAX_LANES];
+    const unsigned char *ders[GRAIN128_MULTI_MAX_LANES];
+    unsigned char tags[GRAIN128_MULTI_MAX_LANES][GRAIN128_TAG_SIZE];
+    unsigned char der[5];
+    unsigned long long inlen, adlen, len;
+    unsigned max_lanes = grain128_multi_lanes();
+    unsigned derlen, lanes, lane;
+    while (count > 0) {
+        /* Measure the run of packets with the same lengths */
+        inlen = items[0].inlen;
+        adlen = items[0].adlen;
+        lanes = 1;
+        while (lanes < max_lanes && lanes < count &&
+                items[lanes].inlen == inlen && items[lanes].adlen == adlen)
+            ++lanes;
+
+        /* Short runs and invalid lengths are handled one at a time */
+        if (lanes < (max_lanes / 4) || adlen >= 0x100000000ULL ||
+                (decrypt && inlen < GRAIN128_TAG_SIZE)) {
+            for (lane = 0; lane < lanes; ++lane)
+                grain128_batch_single(&(items[lane]), decrypt);
+            items += lanes;
+            count -= lanes;
+            continue;
+        }
+
+        /* Set up the sessions for the run */
+        derlen = grain128_encode_adlen(der, adlen);
+        for (lane = 0; lane < lanes; ++lane) {
+            keys[lane] = items[lane].key;
+            if (!keys[lane])
+                keys[lane] = (const unsigned char *)(items[lane].ctx);
+            npub[lane] = items[lane].npub;
+            ad[lane] = items[lane].ad;
+            in[lane] = items[lane].in;
+            out[lane] = items[lane].out;
+            ders[lane] = der;
+        }
+        grain128_multi_setup(&state, keys, npub, lanes);
+
+        /* Authenticate the associated data, prefixed with the DER length */
+        grain128_multi_authenticate(&state, ders, derlen);
+        grain128_multi_authenticate(&state, ad, adlen);
+
+        /* Encrypt or decrypt the payloads and compute the tags */
+        len = decrypt ? (inlen - GRAIN128_TAG_SIZE) : inlen;
+        if (decrypt)
+            grain128_multi_decrypt(&state, out, in, len);
+        else
+            grain128_multi_encrypt(&state, out, in, len);
+        grain128_multi_compute_tag(&state, tags);
+        for (lane = 0; lane < lanes; ++lane) {
+            if (decrypt) {
+                items[lane].outlen = len;
+                items[lane].status = aead_check_tag
+                    (out[lane], len, tags[lane], in[lane] + len,
+                     GRAIN128_TAG_SIZE);
+            } else {
+                memcpy(out[lane] + len, tags[lane], GRAIN128_TAG_SIZE);
+                items[lane].outlen = len + GRAIN128_TAG_SIZE;
+                items[lane].status = 0;
+            }
+        }
+        items += lanes;
+        count -= lanes;
+    }
+}
+
+#else /* !GRAIN128_MULTI */
+
+static void grain128_batch_items
+    (aead_batch_item_t *items, size_t count, int decrypt)
+{
+    size_t index;
+    for (index = 0; index < count; ++index)
+        grain128_batch_single(&(items[index]), decrypt);
+}
+
+#endif /* !GRAIN128_MULTI */
+
+static void grain128_batch_encrypt(aead_batch_item_t *items, size_t count)
+{
+    grain128_batch_items(items, count, 0);
+}
+
+static void grain128_batch_decrypt(aead_batch_item_t *items, size_t count)
+{
+    grain128_batch_items(items, count, 1);
+}
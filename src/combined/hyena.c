@@ -25,6 +25,21 @@
 #include "internal-util.h"
 #include <string.h>
 
+/**
+ * \brief Declares the batch AEAD functions for a HYENA variant.
+ *
+ * \param name Name of the variant; e.g. hyena_v1.
+ */
+#define HYENA_BATCH_CIPHER(name) \
+    static void name##_batch_encrypt(aead_batch_item_t *items, size_t count); \
+    static void name##_batch_decrypt(aead_batch_item_t *items, size_t count); \
+    static aead_batch_cipher_t const name##_batch_cipher = { \
+        name##_batch_encrypt, \
+        name##_batch_decrypt \
+    }
+HYENA_BATCH_CIPHER(hyena_v1);
+HYENA_BATCH_CIPHER(hyena_v2);
+
 aead_cipher_t const hyena_v1_cipher = {
     "HYENA-v1",
     HYENA_KEY_SIZE,
@@ -32,7 +47,13 @@ aead_cipher_t const hyena_v1_cipher = {
     HYENA_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN,
     hyena_v1_aead_encrypt,
-    hyena_v1_aead_decrypt
+    hyena_v1_aead_decrypt,
+    sizeof(gift128n_key_schedule_t),
+    hyena_aead_setup_key,
+    hyena_v1_aead_encrypt_with_context,
+    hyena_v1_aead_decrypt_with_context,
+    0, /* stream */
+    &hyena_v1_batch_cipher
 };
 
 aead_cipher_t const hyena_v2_cipher = {
@@ -42,7 +63,13 @@ aead_cipher_t const hyena_v2_cipher = {
     HYENA_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN,
     hyena_v2_aead_encrypt,
-    hyena_v2_aead_decrypt
+    hyena_v2_aead_decrypt,
+    sizeof(gift128n_key_schedule_t),
+    hyena_aead_setup_key,
+    hyena_v2_aead_encrypt_with_context,
+    hyena_v2_aead_decrypt_with_context,
+    0, /* stream */
+    &hyena_v2_batch_cipher
 };
 
 /**
@@ -124,15 +151,17 @@ static void hyena_v1_process_ad
     }
 }
 
-int hyena_v1_aead_encrypt
+int hyena_v1_aead_encrypt_with_context
     (unsigned char *c, unsigned long long *clen,
      const unsigned char *m, unsigned long long mlen,
      const unsigned char *ad, unsigned long long adlen,
      const unsigned char *nsec,
      const unsigned char *npub,
-     const unsigned char *k)
+     const void *ctx)
 {
-    gift128n_key_schedule_t ks;
+    gift128n_key_schedule_t temp;
+    const gift128n_key_schedule_t *ks = gift128b_expand_schedule
+        ((const gift128n_key_schedule_t *)ctx, &temp);
     unsigned char Y[16];
     unsigned char D[8];
     unsigned char feedback[16];
@@ -142,8 +171,7 @@ int hyena_v1_aead_encrypt
     /* Set the length of the returned ciphertext */
     *clen = mlen + HYENA_TAG_SIZE;
 
-    /* Set up the key schedule and use it to encrypt the nonce */
-    gift128n_init(&ks, k);
+    /* Use the key schedule to encrypt the nonce */
     Y[0] = 0;
     if (adlen == 0)
         Y[0] |= 0x01;
@@ -153,16 +181,16 @@ int hyena_v1_aead_encrypt
     Y[2] = 0;
     Y[3] = 0;
     memcpy(Y + 4, npub, HYENA_NONCE_SIZE);
-    gift128n_encrypt(&ks, Y, Y);
+    gift128n_encrypt(ks, Y, Y);
     memcpy(D, Y + 8, 8);
 
     /* Process the associated data */
-    hyena_v1_process_ad(&ks, Y, D, ad, adlen);
+    hyena_v1_process_ad(ks, Y, D, ad, adlen);
 
     /* Encrypt the plaintext to produce the ciphertext */
     if (mlen > 0) {
         while (mlen > 16) {
-            gift128n_encrypt(&ks, Y, Y);
+            gift128n_encrypt(ks, Y, Y);
             hyena_double_delta(D);
             memcpy(feedback, m, 16);
             lw_xor_block(feedback + 8, Y + 8, 8);
@@ -173,7 +201,7 @@ int hyena_v1_aead_encrypt
             m += 16;
             mlen -= 16;
         }
-        gift128n_encrypt(&ks, Y, Y);
+        gift128n_encrypt(ks, Y, Y);
         if (mlen == 16) {
             hyena_double_delta(D);
             hyena_double_delta(D);
@@ -207,19 +235,21 @@ int hyena_v1_aead_encrypt
         Y[index] = temp2;
         Y[index + 8] = temp1;
     }
-    gift128n_encrypt(&ks, c, Y);
+    gift128n_encrypt(ks, c, Y);
     return 0;
 }
 
-int hyena_v1_aead_decrypt
+int hyena_v1_aead_decrypt_with_context
     (unsigned char *m, unsigned long long *mlen,
      unsigned char *nsec,
      const unsigned char *c, unsigned long long clen,
      const unsigned char *ad, unsigned long long adlen,
      const unsigned char *npub,
-     const unsigned char *k)
+     const void *ctx)
 {
-    gift128n_key_schedule_t ks;
+    gift128n_key_schedule_t temp;
+    const gift128n_key_schedule_t *ks = gift128b_expand_schedule
+        ((const gift128n_key_schedule_t *)ctx, &temp);
     unsigned char Y[16];
     unsigned char D[8];
     unsigned char feedback[16];
@@ -232,8 +262,7 @@ int hyena_v1_aead_decrypt
         return -1;
     *mlen = clen - HYENA_TAG_SIZE;
 
-    /* Set up the key schedule and use it to encrypt the nonce */
-    gift128n_init(&ks, k);
+    /* Use the key schedule to encrypt the nonce */
     Y[0] = 0;
     if (adlen == 0)
         Y[0] |= 0x01;
@@ -243,18 +272,18 @@ int hyena_v1_aead_decrypt
     Y[2] = 0;
     Y[3] = 0;
     memcpy(Y + 4, npub, HYENA_NONCE_SIZE);
-    gift128n_encrypt(&ks, Y, Y);
+    gift128n_encrypt(ks, Y, Y);
     memcpy(D, Y + 8, 8);
 
     /* Process the associated data */
-    hyena_v1_process_ad(&ks, Y, D, ad, adlen);
+    hyena_v1_process_ad(ks, Y, D, ad, adlen);
 
     /* Decrypt the ciphertext to produce the plaintext */
     clen -= HYENA_TAG_SIZE;
     mtemp = m;
     if (clen > 0) {
         while (clen > 16) {
-            gift128n_encrypt(&ks, Y, Y);
+            gift128n_encrypt(ks, Y, Y);
             hyena_double_delta(D);
             memcpy(feedback + 8, c + 8, 8);
             lw_xor_block_2_src(m, c, Y, 16);
@@ -265,7 +294,7 @@ int hyena_v1_aead_decrypt
             m += 16;
             clen -= 16;
         }
-        gift128n_encrypt(&ks, Y, Y);
+        gift128n_encrypt(ks, Y, Y);
         if (clen == 16) {
             hyena_double_delta(D);
             hyena_double_delta(D);
@@ -303,7 +332,7 @@ int hyena_v1_aead_decrypt
         Y[index] = temp2;
         Y[index + 8] = temp1;
     }
-    gift128n_encrypt(&ks, Y, Y);
+    gift128n_encrypt(ks, Y, Y);
     return aead_check_tag(mtemp, *mlen, Y, c, HYENA_TAG_SIZE);
 }
 
@@ -352,15 +381,17 @@ static void hyena_v2_process_ad
     }
 }
 
-int hyena_v2_aead_encrypt
+int hyena_v2_aead_encrypt_with_context
     (unsigned char *c, unsigned long long *clen,
      const unsigned char *m, unsigned long long mlen,
      const unsigned char *ad, unsigned long long adlen,
      const unsigned char *nsec,
      const unsigned char *npub,
-     const unsigned char *k)
+     const void *ctx)
 {
-    gift128n_key_schedule_t ks;
+    gift128n_key_schedule_t temp;
+    const gift128n_key_schedule_t *ks = gift128b_expand_schedule
+        ((const gift128n_key_schedule_t *)ctx, &temp);
     unsigned char Y[16];
     unsigned char D[8];
     unsigned char feedback[16];
@@ -370,8 +401,7 @@ int hyena_v2_aead_encrypt
     /* Set the length of the returned ciphertext */
     *clen = mlen + HYENA_TAG_SIZE;
 
-    /* Set up the key schedule and use it to encrypt the nonce */
-    gift128n_init(&ks, k);
+    /* Use the key schedule to encrypt the nonce */
     Y[0] = 0;
     if (adlen == 0)
         Y[0] |= 0x01;
@@ -381,16 +411,16 @@ int hyena_v2_aead_encrypt
     Y[2] = 0;
     Y[3] = 0;
     memcpy(Y + 4, npub, HYENA_NONCE_SIZE);
-    gift128n_encrypt(&ks, Y, Y);
+    gift128n_encrypt(ks, Y, Y);
     memcpy(D, Y + 8, 8);
 
     /* Process the associated data */
-    hyena_v2_process_ad(&ks, Y, D, ad, adlen);
+    hyena_v2_process_ad(ks, Y, D, ad, adlen);
 
     /* Encrypt the plaintext to produce the ciphertext */
     if (mlen > 0) {
         while (mlen > 16) {
-            gift128n_encrypt(&ks, Y, Y);
+            gift128n_encrypt(ks, Y, Y);
             hyena_double_delta(D);
             memcpy(feedback, m, 16);
             lw_xor_block(feedback + 8, Y + 8, 8);
@@ -401,7 +431,7 @@ int hyena_v2_aead_encrypt
             m += 16;
             mlen -= 16;
         }
-        gift128n_encrypt(&ks, Y, Y);
+        gift128n_encrypt(ks, Y, Y);
         if (mlen == 16) {
             hyena_triple_delta(D);
             memcpy(feedback, m, 16);
@@ -433,19 +463,21 @@ int hyena_v2_aead_encrypt
         Y[index] = temp2;
         Y[index + 8] = temp1;
     }
-    gift128n_encrypt(&ks, c, Y);
+    gift128n_encrypt(ks, c, Y);
     return 0;
 }
 
-int hyena_v2_aead_decrypt
+int hyena_v2_aead_decrypt_with_context
     (unsigned char *m, unsigned long long *mlen,
      unsigned char *nsec,
      const unsigned char *c, unsigned long long clen,
      const unsigned char *ad, unsigned long long adlen,
      const unsigned char *npub,
-     const unsigned char *k)
+     const void *ctx)
 {
-    gift128n_key_schedule_t ks;
+    gift128n_key_schedule_t temp;
+    const gift128n_key_schedule_t *ks = gift128b_expand_schedule
+        ((const gift128n_key_schedule_t *)ctx, &temp);
     unsigned char Y[16];
     unsigned char D[8];
     unsigned char feedback[16];
@@ -458,8 +490,7 @@ int hyena_v2_aead_decrypt
         return -1;
     *mlen = clen - HYENA_TAG_SIZE;
 
-    /* Set up the key schedule and use it to encrypt the nonce */
-    gift128n_init(&ks, k);
+    /* Use the key schedule to encrypt the nonce */
     Y[0] = 0;
     if (adlen == 0)
         Y[0] |= 0x01;
@@ -469,18 +500,18 @@ int hyena_v2_aead_decrypt
     Y[2] = 0;
     Y[3] = 0;
     memcpy(Y + 4, npub, HYENA_NONCE_SIZE);
-    gift128n_encrypt(&ks, Y, Y);
+    gift128n_encrypt(ks, Y, Y);
     memcpy(D, Y + 8, 8);
 
     /* Process the associated data */
-    hyena_v2_process_ad(&ks, Y, D, ad, adlen);
+    hyena_v2_process_ad(ks, Y, D, ad, adlen);
 
     /* Decrypt the ciphertext to produce the plaintext */
     clen -= HYENA_TAG_SIZE;
     mtemp = m;
     if (clen > 0) {
         while (clen > 16) {
-            gift128n_encrypt(&ks, Y, Y);
+            gift128n_encrypt(ks, Y, Y);
             hyena_double_delta(D);
             memcpy(feedback + 8, c + 8, 8);
             lw_xor_block_2_src(m, c, Y, 16);
@@ -491,7 +522,7 @@ int hyena_v2_aead_decrypt
             m += 16;
             clen -= 16;
         }
-        gift128n_encrypt(&ks, Y, Y);
+        gift128n_encrypt(ks, Y, Y);
         if (clen == 16) {
             hyena_triple_delta(D);
             memcpy(feedback + 8, c + 8, 8);
@@ -527,6 +558,346 @@ int hyena_v2_aead_decrypt
         Y[index] = temp2;
         Y[index + 8] = temp1;
     }
-    gift128n_encrypt(&ks, Y, Y);
+    gift128n_encrypt(ks, Y, Y);
     return aead_check_tag(mtemp, *mlen, Y, c, HYENA_TAG_SIZE);
 }
+
+void hyena_aead_setup_key(void *ctx, const unsigned char *k)
+{
+    gift128n_init((gift128n_key_schedule_t *)ctx, k);
+}
+
+int hyena_v1_aead_encrypt
+    (unsigned char *c, unsigned long long *clen,
+     const unsigned char *m, unsigned long long mlen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *nsec,
+     const unsigned char *npub,
+     const unsigned char *k)
+{
+    gift128n_key_schedule_t ks;
+    gift128n_init(&ks, k);
+    return hyena_v1_aead_encrypt_with_context
+        (c, clen, m, mlen, ad, adlen, nsec, npub, &ks);
+}
+
+int hyena_v1_aead_decrypt
+    (unsigned char *m, unsigned long long *mlen,
+     unsigned char *nsec,
+     const unsigned char *c, unsigned long long clen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *npub,
+     const unsigned char *k)
+{
+    gift128n_key_schedule_t ks;
+    gift128n_init(&ks, k);
+    return hyena_v1_aead_decrypt_with_context
+        (m, mlen, nsec, c, clen, ad, adlen, npub, &ks);
+}
+
+int hyena_v2_aead_encrypt
+    (unsigned char *c, unsigned long long *clen,
+     const unsigned char *m, unsigned long long mlen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *nsec,
+     const unsigned char *npub,
+     const unsigned char *k)
+{
+    gift128n_key_schedule_t ks;
+    gift128n_init(&ks, k);
+    return hyena_v2_aead_encrypt_with_context
+        (c, clen, m, mlen, ad, adlen, nsec, npub, &ks);
+}
+
+int hyena_v2_aead_decrypt
+    (unsigned char *m, unsigned long long *mlen,
+     unsigned char *nsec,
+     const unsigned char *c, unsigned long long clen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *npub,
+     const unsigned char *k)
+{
+    gift128n_key_schedule_t ks;
+    gift128n_init(&ks, k);
+    return hyena_v2_aead_decrypt_with_context
+        (m, mlen, nsec, c, clen, ad, adlen, npub, &ks);
+}
+
+/**
+ * \brief Absorbs a block into the HYENA state for one packet in a batch.
+ *
+ * \param Y Internal hash state of HYENA for the packet.
+ * \param D Delta value for the packet, already updated for this block.
+ * \param out Output buffer for the block, or NULL for associated data.
+ * \param in Input data for the block.
+ * \param len Length of the block, between 0 and 16.
+ * \param decrypt Non-zero if "in" is ciphertext, zero if it is plaintext.
+ *
+ * When \a out is not NULL, the block is also encrypted or decrypted with
+ * the current value of \a Y before the feedback is absorbed.  The feedback
+ * is the first 8 bytes of plaintext followed by the rest of the ciphertext.
+ */
+static void hyena_batch_absorb
+    (unsigned char Y[16], const unsigned char D[8], unsigned char *out,
+     const unsigned char *in, unsigned len, int decrypt)
+{
+    unsigned char feedback[16];
+    unsigned char scratch[16];
+
+    /* Callers never pass more than 16 bytes, but making the limit explicit
+     * lets the compiler see that "feedback" cannot overflow */
+    if (len > 16)
+        len = 16;
+    if (!out) {
+        /* Associated data is absorbed like plaintext whose output
+         * is discarded */
+        out = scratch;
+        decrypt = 0;
+    }
+    if (decrypt) {
+        if (len > 8) {
+            memcpy(feedback + 8, in + 8, len - 8);
+            lw_xor_block_2_src(out, in, Y, len);
+            memcpy(feedback, out, 8);
+        } else {
+            lw_xor_block_2_src(out, in, Y, len);
+            memcpy(feedback, out, len);
+        }
+    } else {
+        memcpy(feedback, in, len);
+        lw_xor_block_2_src(out, in, Y, len);
+        if (len > 8)
+            memcpy(feedback + 8, out + 8, len - 8);
+    }
+    if (len < 16) {
+        feedback[len] = 0x01;
+        memset(feedback + len + 1, 0, 15 - len);
+    }
+    lw_xor_block(feedback + 8, D, 8);
+    lw_xor_block(Y, feedback, 16);
+}
+
+/**
+ * \brief Updates the delta values of all packets in a batch for the
+ * last block of the associated data or payload.
+ *
+ * \param D Delta values for the packets.
+ * \param lanes Number of packets in the batch.
+ * \param count Number of times to double or triple the delta values.
+ * \param v2 Non-zero to triple the delta values for HYENA-v2, or zero
+ * to double them for HYENA-v1.
+ */
+static void hyena_batch_final_delta
+    (unsigned char D[][8], unsigned lanes, unsigned count, int v2)
+{
+    unsigned lane, index;
+    for (lane = 0; lane < lanes; ++lane) {
+        for (index = 0; index < count; ++index) {
+            if (v2)
+                hyena_triple_delta(D[lane]);
+            else
+                hyena_double_delta(D[lane]);
+        }
+    }
+}
+
+/**
+ * \brief Encrypts or decrypts up to GIFT128_MAX_LANES packets in parallel.
+ *
+ * \param ks Key schedules for the packets, one per lane.
+ * \param out Points to the output buffers for the packets.
+ * \param in Points to the input buffers for the packets.
+ * \param len Length of the payload of each packet, excluding the tag.
+ * \param ad Points to the associated data buffers for the packets.
+ * \param adlen Length of the associated data for each packet.
+ * \param npub Points to the nonces for the packets.
+ * \param status Returns the tag check result for each packet on decrypt.
+ * \param v2 Non-zero for HYENA-v2, zero for HYENA-v1.
+ * \param decrypt Non-zero to decrypt, zero to encrypt.
+ */
+static void hyena_batch_crypt
+    (const gift128b_multi_key_schedule_t *ks,
+     unsigned char * const *out, const unsigned char * const *in,
+     unsigned long long len,
+     const unsigned char * const *ad, unsigned long long adlen,
+     const unsigned char * const *npub, int *status, int v2, int decrypt)
+{
+    unsigned char Y[GIFT128_MAX_LANES][16];
+    unsigned char D[GIFT128_MAX_LANES][8];
+    unsigned long long posn;
+    unsigned lanes = ks->lanes;
+    unsigned lane, index, temp;
+
+    /* The multi-key schedule never has more than GIFT128_MAX_LANES lanes,
+     * but making the limit explicit lets the compiler see that the arrays
+     * cannot overflow */
+    if (lanes > GIFT128_MAX_LANES)
+        lanes = GIFT128_MAX_LANES;
+
+    /* Use the key schedules to encrypt the nonces */
+    for (lane = 0; lane < lanes; ++lane) {
+        Y[lane][0] = 0;
+        if (adlen == 0)
+            Y[lane][0] |= 0x01;
+        if (adlen == 0 && len == 0)
+            Y[lane][0] |= 0x02;
+        Y[lane][1] = 0;
+        Y[lane][2] = 0;
+        Y[lane][3] = 0;
+        memcpy(Y[lane] + 4, npub[lane], HYENA_NONCE_SIZE);
+    }
+    gift128n_encrypt_multi(ks, Y[0]);
+    for (lane = 0; lane < lanes; ++lane) {
+        memcpy(D[lane], Y[lane] + 8, 8);
+        if (!v2)
+            hyena_double_delta(D[lane]);
+    }
+
+    /* Process the associated data */
+    for (posn = 0; (adlen - posn) > 16; posn += 16) {
+        for (lane = 0; lane < lanes; ++lane) {
+            if (v2)
+                hyena_double_delta(D[lane]);
+            hyena_batch_absorb(Y[lane], D[lane], 0, ad[lane] + posn, 16, 0);
+            if (!v2)
+                hyena_double_delta(D[lane]);
+        }
+        gift128n_encrypt_multi(ks, Y[0]);
+    }
+    temp = (unsigned)(adlen - posn);
+    hyena_batch_final_delta(D, lanes, temp == 16 ? 1 : 2, v2);
+    for (lane = 0; lane < lanes; ++lane)
+        hyena_batch_absorb(Y[lane], D[lane], 0, ad[lane] + posn, temp, 0);
+
+    /* Encrypt or decrypt the payload */
+    if (len > 0) {
+        for (posn = 0; (len - posn) > 16; posn += 16) {
+            gift128n_encrypt_multi(ks, Y[0]);
+            for (lane = 0; lane < lanes; ++lane) {
+                hyena_double_delta(D[lane]);
+                hyena_batch_absorb
+                    (Y[lane], D[lane], out[lane] + posn, in[lane] + posn,
+                     16, decrypt);
+            }
+        }
+        gift128n_encrypt_multi(ks, Y[0]);
+        temp = (unsigned)(len - posn);
+        if (v2)
+            hyena_batch_final_delta(D, lanes, temp == 16 ? 1 : 2, v2);
+        else
+            hyena_batch_final_delta(D, lanes, temp == 16 ? 2 : 3, v2);
+        for (lane = 0; lane < lanes; ++lane) {
+            hyena_batch_absorb
+                (Y[lane], D[lane], out[lane] + posn, in[lane] + posn,
+                 temp, decrypt);
+        }
+    }
+
+    /* Swap the two halves of Y and generate the authentication tags */
+    for (lane = 0; lane < lanes; ++lane) {
+        for (index = 0; index < 8; ++index) {
+            unsigned char temp1 = Y[lane][index];
+            unsigned char temp2 = Y[lane][index + 8];
+            Y[lane][index] = temp2;
+            Y[lane][index + 8] = temp1;
+        }
+    }
+    gift128n_encrypt_multi(ks, Y[0]);
+    for (lane = 0; lane < lanes; ++lane) {
+        if (decrypt) {
+            status[lane] = aead_check_tag
+                (out[lane], len, Y[lane], in[lane] + len, HYENA_TAG_SIZE);
+        } else {
+            memcpy(out[lane] + len, Y[lane], HYENA_TAG_SIZE);
+            status[lane] = 0;
+        }
+    }
+}
+
+/**
+ * \brief Encrypts or decrypts a batch of packets with HYENA, using the
+ * multi-block GIFT-128 kernels for runs of packets that have the same
+ * lengths.
+ *
+ * \param items Points to the descriptors for the packets.
+ * \param count Number of packets in the batch.
+ * \param v2 Non-zero for HYENA-v2, zero for HYENA-v1.
+ * \param decrypt Non-zero to decrypt, zero to encrypt.
+ */
+static void hyena_batch_items
+    (aead_batch_item_t *items, size_t count, int v2, int decrypt)
+{
+    gift128n_key_schedule_t schedules[GIFT128_MAX_LANES];
+    const gift128n_key_schedule_t *keys[GIFT128_MAX_LANES];
+    gift128b_multi_key_schedule_t ks;
+    unsigned char *out[GIFT128_MAX_LANES];
+    const unsigned char *in[GIFT128_MAX_LANES];
+    const unsigned char *ad[GIFT128_MAX_LANES];
+    const unsigned char *npub[GIFT128_MAX_LANES];
+    int status[GIFT128_MAX_LANES] = {0};
+    unsigned long long inlen, adlen, len;
+    unsigned lanes, lane;
+    while (count > 0) {
+        /* A ciphertext that is too short to contain a tag fails by itself */
+        inlen = items[0].inlen;
+        adlen = items[0].adlen;
+        if (decrypt && inlen < HYENA_TAG_SIZE) {
+            items[0].outlen = 0;
+            items[0].status = -1;
+            ++items;
+            --count;
+            continue;
+        }
+
+        /* Collect a run of packets with the same lengths */
+        lanes = 0;
+        do {
+            out[lanes] = items[lanes].out;
+            in[lanes] = items[lanes].in;
+            ad[lanes] = items[lanes].ad;
+            npub[lanes] = items[lanes].npub;
+            if (items[lanes].key) {
+                gift128n_init(&(schedules[lanes]), items[lanes].key);
+                keys[lanes] = &(schedules[lanes]);
+            } else {
+                keys[lanes] = gift128b_expand_schedule
+                    ((const gift128n_key_schedule_t *)(items[lanes].ctx),
+                     &(schedules[lanes]));
+            }
+            ++lanes;
+        } while (lanes < GIFT128_MAX_LANES && lanes < count &&
+                 items[lanes].inlen == inlen && items[lanes].adlen == adlen);
+
+        /* Process the run of packets */
+        gift128b_multi_init(&ks, keys, lanes);
+        len = decrypt ? (inlen - HYENA_TAG_SIZE) : inlen;
+        hyena_batch_crypt
+            (&ks, out, in, len, ad, adlen, npub, status, v2, decrypt);
+        for (lane = 0; lane < lanes; ++lane) {
+            items[lane].outlen = decrypt ? len : (len + HYENA_TAG_SIZE);
+            items[lane].status = status[lane];
+        }
+        items += lanes;
+        count -= lanes;
+    }
+}
+
+static void hyena_v1_batch_encrypt(aead_batch_item_t *items, size_t count)
+{
+    hyena_batch_items(items, count, 0, 0);
+}
+
+static void hyena_v1_batch_decrypt(aead_batch_item_t *items, size_t count)
+{
+    hyena_batch_items(items, count, 0, 1);
+}
+
+static void hyena_v2_batch_encrypt(aead_batch_item_t *items, size_t count)
+{
+    hyena_batch_items(items, count, 1, 0);
+}
+
+static void hyena_v2_batch_decrypt(aead_batch_item_t *items, size_t count)
+{
+    hyena_batch_items(items, count, 1, 1);
+}
@@ -23,11 +23,227 @@
 #include "internal-ascon-m.h"
 #include "internal-util.h"
 
+#if ASCON_MASKED_VECTOR
+
+/** @cond ascon_masked_vector */
+
+/* Vector with one 64-bit lane per share.  With 3 shares, the last lane
+ * is always zero.  Two shares fit in a 128-bit vector and three or four
+ * shares fit in a 256-bit AVX2 vector */
+#if AEAD_MASKING_SHARES == 2
+#define ASCON_MASKED_LANES 2
+#define ASCON_MASKED_TARGET
+#define ascon_masked_can_use_vector() 1
+#else
+#define ASCON_MASKED_LANES 4
+#if defined(__AVX2__)
+#define ASCON_MASKED_TARGET
+#define ascon_masked_can_use_vector() 1
+#else
+#define ASCON_MASKED_TARGET LW_TARGET_AVX2
+#define ascon_masked_can_use_vector() \
+    (lw_simd_level() >= LW_SIMD_LEVEL_AVX2)
+#endif
+#endif
+typedef uint64_t ascon_masked_vec_t
+    __attribute__((vector_size(ASCON_MASKED_LANES * 8)));
+
+/* Rearrange the shares within a vector */
+#if ASCON_MASKED_LANES == 2
+#if defined(__clang__)
+#define ascon_vec_shuffle(x, i0, i1) __builtin_shufflevector((x), (x), i0, i1)
+#else
+#define ascon_vec_shuffle(x, i0, i1) \
+    __builtin_shuffle((x), (ascon_masked_vec_t){i0, i1})
+#endif
+#else
+#if defined(__clang__)
+#define ascon_vec_shuffle(x, i0, i1, i2, i3) \
+    __builtin_shufflevector((x), (x), i0, i1, i2, i3)
+#else
+#define ascon_vec_shuffle(x, i0, i1, i2, i3) \
+    __builtin_shuffle((x), (ascon_masked_vec_t){i0, i1, i2, i3})
+#endif
+#endif
+
+/* Right rotate the shares of a masked word */
+#define ascon_vec_ror(x, bits) (((x) >> (bits)) | ((x) << (64 - (bits))))
+
+/* Loads and stores the shares of a masked word */
+#if AEAD_MASKING_SHARES == 2
+#define ascon_vec_load(value) ((ascon_masked_vec_t){(value).a, (value).b})
+#define ascon_vec_store(value, x) \
+    do { \
+        (value).a = (x)[0]; \
+        (value).b = (x)[1]; \
+    } while (0)
+#elif AEAD_MASKING_SHARES == 3
+#define ascon_vec_load(value) \
+    ((ascon_masked_vec_t){(value).a, (value).b, (value).c, 0})
+#define ascon_vec_store(value, x) \
+    do { \
+        (value).a = (x)[0]; \
+        (value).b = (x)[1]; \
+        (value).c = (x)[2]; \
+    } while (0)
+#else
+#define ascon_vec_load(value) \
+    ((ascon_masked_vec_t){(value).a, (value).b, (value).c, (value).d})
+#define ascon_vec_store(value, x) \
+    do { \
+        (value).a = (x)[0]; \
+        (value).b = (x)[1]; \
+        (value).c = (x)[2]; \
+        (value).d = (x)[3]; \
+    } while (0)
+#endif
+
+/* Performs "x1 ^= (~x2) & x3" on vectors of shares.
+ *
+ * This is the same ISW gadget as mask_and_not(), with each pair of shares
+ * i < j given a fresh random word r that is added to share i and to
+ * "(r ^ (a[j] & b[i])) ^ (a[i] & b[j])" in share j.  Instead of working
+ * through the pairs one at a time, all pairs that are the same distance
+ * apart are handled at once by rotating the shares between the lanes.
+ *
+ * With 3 or 4 shares, the pairs (i, i + 1 mod 3) or (i, i + 1 mod 4)
+ * cover every distance-1 pair exactly once.  The pairs at distance 2
+ * with 4 shares, and the only pair with 2 shares, would be counted twice
+ * by a full rotation so the cross products are only added to the upper
+ * half of the lanes and the random words are duplicated in both halves */
+#if AEAD_MASKING_SHARES == 2
+#define ascon_vec_and_not(x1, x2, x3) \
+    do { \
+        a = (x2) ^ not_mask; \
+        temp = mask_random_64(); \
+        r = (ascon_masked_vec_t){temp, temp}; \
+        u = a & ascon_vec_shuffle((x3), 1, 0); \
+        (x1) ^= a & (x3); \
+        (x1) ^= (r ^ (u & high_mask)) ^ \
+                (ascon_vec_shuffle(u, 1, 0) & high_mask); \
+    } while (0)
+#elif AEAD_MASKING_SHARES == 3
+#define ascon_vec_and_not(x1, x2, x3) \
+    do { \
+        a = (x2) ^ not_mask; \
+        r = (ascon_masked_vec_t) \
+            {mask_random_64(), mask_random_64(), mask_random_64(), 0}; \
+        u = (r ^ (a & ascon_vec_shuffle((x3), 1, 2, 0, 3))) ^ \
+            (ascon_vec_shuffle(a, 1, 2, 0, 3) & (x3)); \
+        (x1) ^= a & (x3); \
+        (x1) ^= r; \
+        (x1) ^= ascon_vec_shuffle(u, 2, 0, 1, 3); \
+    } while (0)
+#else
+#define ascon_vec_and_not(x1, x2, x3) \
+    do { \
+        a = (x2) ^ not_mask; \
+        r = (ascon_masked_vec_t) \
+            {mask_random_64(), mask_random_64(), \
+             mask_random_64(), mask_random_64()}; \
+        u = (r ^ (a & ascon_vec_shuffle((x3), 1, 2, 3, 0))) ^ \
+            (ascon_vec_shuffle(a, 1, 2, 3, 0) & (x3)); \
+        (x1) ^= a & (x3); \
+        (x1) ^= r; \
+        (x1) ^= ascon_vec_shuffle(u, 3, 0, 1, 2); \
+        r = (ascon_masked_vec_t){mask_random_64(), mask_random_64(), 0, 0}; \
+        r = ascon_vec_shuffle(r, 0, 1, 0, 1); \
+        u = a & ascon_vec_shuffle((x3), 2, 3, 0, 1); \
+        (x1) ^= (r ^ (u & high_mask)) ^ \
+                (ascon_vec_shuffle(u, 2, 3, 0, 1) & high_mask); \
+    } while (0)
+#endif
+
+/** @endcond */
+
+/**
+ * \brief Permutes the masked ASCON state with all shares of each word
+ * in a single vector.
+ *
+ * \param state The masked ASCON state to be permuted.
+ * \param first_round The first round (of 12) to be performed.
+ */
+static ASCON_MASKED_TARGET void ascon_permute_masked_vector
+    (ascon_masked_state_t *state, uint8_t first_round)
+{
+    ascon_masked_vec_t x0 = ascon_vec_load(state->S[0]);
+    ascon_masked_vec_t x1 = ascon_vec_load(state->S[1]);
+    ascon_masked_vec_t x2 = ascon_vec_load(state->S[2]);
+    ascon_masked_vec_t x3 = ascon_vec_load(state->S[3]);
+    ascon_masked_vec_t x4 = ascon_vec_load(state->S[4]);
+    ascon_masked_vec_t t0, t1, a, r, u;
+    ascon_masked_vec_t not_mask = {0};
+    ascon_masked_vec_t rc = {0};
+#if ASCON_MASKED_LANES == 2 || AEAD_MASKING_SHARES == 4
+    ascon_masked_vec_t high_mask = {0};
+#endif
+#if AEAD_MASKING_SHARES == 2
+    uint64_t temp;
+#endif
+
+    /* Constants and NOT's only apply to the first share */
+    not_mask[0] = ~((uint64_t)0);
+#if ASCON_MASKED_LANES == 2
+    high_mask[1] = ~((uint64_t)0);
+#elif AEAD_MASKING_SHARES == 4
+    high_mask[2] = ~((uint64_t)0);
+    high_mask[3] = ~((uint64_t)0);
+#endif
+
+    /* Perform all requested rounds */
+    while (first_round < 12) {
+        /* Add the round constant to the state */
+        rc[0] = ((0x0F - first_round) << 4) | first_round;
+        x2 ^= rc;
+
+        /* Substitution layer */
+        x0 ^= x4;
+        x4 ^= x3;
+        x2 ^= x1;
+        t1 = x0;
+        t0 = x0 ^ x0;
+        ascon_vec_and_not(t0, x0, x1);
+        ascon_vec_and_not(x0, x1, x2);
+        ascon_vec_and_not(x1, x2, x3);
+        ascon_vec_and_not(x2, x3, x4);
+        ascon_vec_and_not(x3, x4, t1);
+        x4 ^= t0;
+        x1 ^= x0;
+        x0 ^= x4;
+        x3 ^= x2;
+        x2 ^= not_mask;
+
+        /* Linear diffusion layer */
+        x0 ^= ascon_vec_ror(x0, 19) ^ ascon_vec_ror(x0, 28);
+        x1 ^= ascon_vec_ror(x1, 61) ^ ascon_vec_ror(x1, 39);
+        x2 ^= ascon_vec_ror(x2, 1)  ^ ascon_vec_ror(x2, 6);
+        x3 ^= ascon_vec_ror(x3, 10) ^ ascon_vec_ror(x3, 17);
+        x4 ^= ascon_vec_ror(x4, 7)  ^ ascon_vec_ror(x4, 41);
+
+        /* Move onto the next round */
+        ++first_round;
+    }
+    ascon_vec_store(state->S[0], x0);
+    ascon_vec_store(state->S[1], x1);
+    ascon_vec_store(state->S[2], x2);
+    ascon_vec_store(state->S[3], x3);
+    ascon_vec_store(state->S[4], x4);
+}
+
+#endif /* ASCON_MASKED_VECTOR */
+
 void ascon_permute_masked(ascon_masked_state_t *state, uint8_t first_round)
 {
     mask_uint64_t t0, t1;
     uint64_t temp;
 
+#if ASCON_MASKED_VECTOR
+    if (ascon_masked_can_use_vector()) {
+        ascon_permute_masked_vector(state, first_round);
+        return;
+    }
+#endif
+
     /* Create aliases for the masked state words */
     #define x0 (state->S[0])
     #define x1 (state->S[1])
@@ -89,6 +305,17 @@ void ascon_permute_masked(ascon_masked_state_t *state, uint8_t first_round)
     }
 }
 
+const char *ascon_masked_variant(void)
+{
+#if ASCON_MASKED_VECTOR && ASCON_MASKED_LANES == 2
+    return "128-bit vector";
+#elif ASCON_MASKED_VECTOR
+    return ascon_masked_can_use_vector() ? "AVX2" : "C";
+#else
+    return "C";
+#endif
+}
+
 void ascon_mask(ascon_masked_state_t *output, const ascon_state_t *input)
 {
 #if defined(LW_UTIL_LITTLE_ENDIAN)
@@ -38,6 +38,34 @@
 extern "C" {
 #endif
 
+/**
+ * \brief Defined to 1 if the masked ASCON permutation keeps all shares
+ * of a state word in a single vector.
+ *
+ * This is off by default and is enabled by defining
+ * ASCON_MASKED_VECTOR_SHARES when compiling the library.  Placing all of
+ * the shares in one register means that the power consumption of that
+ * register may depend upon the unmasked value, which weakens the
+ * protection that masking is supposed to provide.  See the masking
+ * documentation for more information.
+ *
+ * Two shares fit in a 128-bit SSE2 or NEON vector.  Three or four shares
+ * need a 256-bit AVX2 vector, which is selected at runtime if the library
+ * was not compiled with AVX2 enabled.  Otherwise the shares are kept in
+ * separate words as for the other masked ciphers.
+ */
+#if !defined(__AVR__) && (defined(__GNUC__) || defined(__clang__)) && \
+        defined(ASCON_MASKED_VECTOR_SHARES) && \
+        ((AEAD_MASKING_SHARES == 2 && \
+            (defined(__SSE2__) || defined(__ARM_NEON) || \
+             defined(__ARM_NEON__))) || \
+         ((AEAD_MASKING_SHARES == 3 || AEAD_MASKING_SHARES == 4) && \
+            (defined(__AVX2__) || LW_SIMD_DISPATCH)))
+#define ASCON_MASKED_VECTOR 1
+#else
+#define ASCON_MASKED_VECTOR 0
+#endif
+
 /**
  * \brief Structure of the internal state of the masked ASCON permutation.
  */
@@ -57,6 +85,15 @@ typedef struct
  */
 void ascon_permute_masked(ascon_masked_state_t *state, uint8_t first_round);
 
+/**
+ * \brief Gets the name of the masked ASCON permutation variant that is
+ * in use on this CPU.
+ *
+ * \return "C" if the shares are kept in separate words, or the name of
+ * the vector instruction set if all shares of a word are kept in a vector.
+ */
+const char *ascon_masked_variant(void);
+
 /**
  * \brief Converts an unmasked ASCON state into a masked state.
  *
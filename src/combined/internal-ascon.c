@@ -21,6 +21,9 @@
  */
 
 #include "internal-ascon.h"
+#if defined(__AVX2__) || defined(__AVX512F__) || ASCON_SIMD_DISPATCH
+#include <immintrin.h>
+#endif
 
 /* Determine which versions should be accelerated with assembly code */
 #if defined(__AVR__)
@@ -91,6 +94,223 @@ void ascon_permute(ascon_state_t *state, uint8_t first_round)
 
 #endif /* !ASCON_ASM_REGULAR */
 
+#if defined(__AVX2__) || ASCON_SIMD_DISPATCH
+
+/** @cond ascon_avx2 */
+
+#define ascon_ror_x4(x, bits) \
+    _mm256_or_si256(_mm256_srli_epi64((x), (bits)), \
+                    _mm256_slli_epi64((x), 64 - (bits)))
+
+/** @endcond */
+
+/**
+ * \brief Permutes four ASCON states using 256-bit AVX2 vectors.
+ *
+ * \param S Points to the first lane of word 0 of the states.
+ * \param stride Distance between consecutive words of the same lane.
+ * \param first_round The first round (of 12) to be performed.
+ */
+static LW_TARGET_AVX2 void ascon_permute_avx2
+    (uint64_t *S, unsigned stride, uint8_t first_round)
+{
+    __m256i x0 = _mm256_loadu_si256((const __m256i *)(S));
+    __m256i x1 = _mm256_loadu_si256((const __m256i *)(S + stride));
+    __m256i x2 = _mm256_loadu_si256((const __m256i *)(S + stride * 2));
+    __m256i x3 = _mm256_loadu_si256((const __m256i *)(S + stride * 3));
+    __m256i x4 = _mm256_loadu_si256((const __m256i *)(S + stride * 4));
+    __m256i t0, t1, t2, t3, t4;
+    __m256i ones = _mm256_set1_epi64x(-1);
+    while (first_round < 12) {
+        /* Add the round constant to the state */
+        x2 = _mm256_xor_si256
+            (x2, _mm256_set1_epi64x(((0x0F - first_round) << 4) | first_round));
+
+        /* Substitution layer */
+        x0 = _mm256_xor_si256(x0, x4);
+        x4 = _mm256_xor_si256(x4, x3);
+        x2 = _mm256_xor_si256(x2, x1);
+        t0 = _mm256_andnot_si256(x0, x1);
+        t1 = _mm256_andnot_si256(x1, x2);
+        t2 = _mm256_andnot_si256(x2, x3);
+        t3 = _mm256_andnot_si256(x3, x4);
+        t4 = _mm256_andnot_si256(x4, x0);
+        x0 = _mm256_xor_si256(x0, t1);
+        x1 = _mm256_xor_si256(x1, t2);
+        x2 = _mm256_xor_si256(x2, t3);
+        x3 = _mm256_xor_si256(x3, t4);
+        x4 = _mm256_xor_si256(x4, t0);
+        x1 = _mm256_xor_si256(x1, x0);
+        x0 = _mm256_xor_si256(x0, x4);
+        x3 = _mm256_xor_si256(x3, x2);
+        x2 = _mm256_xor_si256(x2, ones);
+
+        /* Linear diffusion layer */
+        x0 = _mm256_xor_si256
+            (x0, _mm256_xor_si256(ascon_ror_x4(x0, 19), ascon_ror_x4(x0, 28)));
+        x1 = _mm256_xor_si256
+            (x1, _mm256_xor_si256(ascon_ror_x4(x1, 61), ascon_ror_x4(x1, 39)));
+        x2 = _mm256_xor_si256
+            (x2, _mm256_xor_si256(ascon_ror_x4(x2, 1), ascon_ror_x4(x2, 6)));
+        x3 = _mm256_xor_si256
+            (x3, _mm256_xor_si256(ascon_ror_x4(x3, 10), ascon_ror_x4(x3, 17)));
+        x4 = _mm256_xor_si256
+            (x4, _mm256_xor_si256(ascon_ror_x4(x4, 7), ascon_ror_x4(x4, 41)));
+
+        /* Move onto the next round */
+        ++first_round;
+    }
+    _mm256_storeu_si256((__m256i *)(S), x0);
+    _mm256_storeu_si256((__m256i *)(S + stride), x1);
+    _mm256_storeu_si256((__m256i *)(S + stride * 2), x2);
+    _mm256_storeu_si256((__m256i *)(S + stride * 3), x3);
+    _mm256_storeu_si256((__m256i *)(S + stride * 4), x4);
+}
+
+#endif /* __AVX2__ || ASCON_SIMD_DISPATCH */
+
+#if defined(__AVX512F__) || ASCON_SIMD_DISPATCH
+
+/**
+ * \brief Permutes eight ASCON states using 512-bit AVX-512 vectors.
+ *
+ * \param S Points to the first lane of word 0 of the states.
+ * \param first_round The first round (of 12) to be performed.
+ */
+static LW_TARGET_AVX512 void ascon_permute_avx512
+    (uint64_t *S, uint8_t first_round)
+{
+    __m512i x0 = _mm512_loadu_si512((const void *)(S));
+    __m512i x1 = _mm512_loadu_si512((const void *)(S + 8));
+    __m512i x2 = _mm512_loadu_si512((const void *)(S + 16));
+    __m512i x3 = _mm512_loadu_si512((const void *)(S + 24));
+    __m512i x4 = _mm512_loadu_si512((const void *)(S + 32));
+    __m512i t0, t1, t2, t3, t4;
+    __m512i ones = _mm512_set1_epi64(-1);
+    while (first_round < 12) {
+        /* Add the round constant to the state */
+        x2 = _mm512_xor_si512
+            (x2, _mm512_set1_epi64(((0x0F - first_round) << 4) | first_round));
+
+        /* Substitution layer */
+        x0 = _mm512_xor_si512(x0, x4);
+        x4 = _mm512_xor_si512(x4, x3);
+        x2 = _mm512_xor_si512(x2, x1);
+        t0 = _mm512_andnot_si512(x0, x1);
+        t1 = _mm512_andnot_si512(x1, x2);
+        t2 = _mm512_andnot_si512(x2, x3);
+        t3 = _mm512_andnot_si512(x3, x4);
+        t4 = _mm512_andnot_si512(x4, x0);
+        x0 = _mm512_xor_si512(x0, t1);
+        x1 = _mm512_xor_si512(x1, t2);
+        x2 = _mm512_xor_si512(x2, t3);
+        x3 = _mm512_xor_si512(x3, t4);
+        x4 = _mm512_xor_si512(x4, t0);
+        x1 = _mm512_xor_si512(x1, x0);
+        x0 = _mm512_xor_si512(x0, x4);
+        x3 = _mm512_xor_si512(x3, x2);
+        x2 = _mm512_xor_si512(x2, ones);
+
+        /* Linear diffusion layer */
+        x0 = _mm512_ternarylogic_epi64
+            (x0, _mm512_ror_epi64(x0, 19), _mm512_ror_epi64(x0, 28), 0x96);
+        x1 = _mm512_ternarylogic_epi64
+            (x1, _mm512_ror_epi64(x1, 61), _mm512_ror_epi64(x1, 39), 0x96);
+        x2 = _mm512_ternarylogic_epi64
+            (x2, _mm512_ror_epi64(x2, 1), _mm512_ror_epi64(x2, 6), 0x96);
+        x3 = _mm512_ternarylogic_epi64
+            (x3, _mm512_ror_epi64(x3, 10), _mm512_ror_epi64(x3, 17), 0x96);
+        x4 = _mm512_ternarylogic_epi64
+            (x4, _mm512_ror_epi64(x4, 7), _mm512_ror_epi64(x4, 41), 0x96);
+
+        /* Move onto the next round */
+        ++first_round;
+    }
+    _mm512_storeu_si512((void *)(S), x0);
+    _mm512_storeu_si512((void *)(S + 8), x1);
+    _mm512_storeu_si512((void *)(S + 16), x2);
+    _mm512_storeu_si512((void *)(S + 24), x3);
+    _mm512_storeu_si512((void *)(S + 32), x4);
+}
+
+#endif /* __AVX512F__ || ASCON_SIMD_DISPATCH */
+
+#if (!defined(__AVX2__) && !defined(__AVX512F__)) || ASCON_SIMD_DISPATCH
+
+/**
+ * \brief Permutes several interleaved ASCON states one lane at a time.
+ *
+ * \param S Points to the first lane of word 0 of the states.
+ * \param stride Distance between consecutive words of the same lane.
+ * \param lanes Number of lanes to permute.
+ * \param first_round The first round (of 12) to be performed.
+ */
+static void ascon_permute_lanes
+    (uint64_t *S, unsigned stride, unsigned lanes, uint8_t first_round)
+{
+    ascon_state_t state;
+    unsigned lane, word;
+    for (lane = 0; lane < lanes; ++lane) {
+        for (word = 0; word < 5; ++word)
+            be_store_word64(state.B + word * 8, S[word * stride + lane]);
+        ascon_permute(&state, first_round);
+        for (word = 0; word < 5; ++word)
+            S[word * stride + lane] = be_load_word64(state.B + word * 8);
+    }
+}
+
+#endif /* (!__AVX2__ && !__AVX512F__) || ASCON_SIMD_DISPATCH */
+
+void ascon_permute_x4(ascon_x4_state_t *state, uint8_t first_round)
+{
+#if defined(__AVX2__)
+    ascon_permute_avx2(state->S[0], 4, first_round);
+#elif ASCON_SIMD_DISPATCH
+    if (lw_simd_level() >= LW_SIMD_LEVEL_AVX2)
+        ascon_permute_avx2(state->S[0], 4, first_round);
+    else
+        ascon_permute_lanes(state->S[0], 4, 4, first_round);
+#else
+    ascon_permute_lanes(state->S[0], 4, 4, first_round);
+#endif
+}
+
+void ascon_permute_x8(ascon_x8_state_t *state, uint8_t first_round)
+{
+#if defined(__AVX512F__)
+    ascon_permute_avx512(state->S[0], first_round);
+#elif ASCON_SIMD_DISPATCH
+    int level = lw_simd_level();
+    if (level == LW_SIMD_LEVEL_AVX512) {
+        ascon_permute_avx512(state->S[0], first_round);
+    } else if (level == LW_SIMD_LEVEL_AVX2) {
+        ascon_permute_avx2(state->S[0], 8, first_round);
+        ascon_permute_avx2(state->S[0] + 4, 8, first_round);
+    } else {
+        ascon_permute_lanes(state->S[0], 8, 8, first_round);
+    }
+#elif defined(__AVX2__)
+    ascon_permute_avx2(state->S[0], 8, first_round);
+    ascon_permute_avx2(state->S[0] + 4, 8, first_round);
+#else
+    ascon_permute_lanes(state->S[0], 8, 8, first_round);
+#endif
+}
+
+const char *ascon_multi_lane_variant(void)
+{
+#if defined(__AVX512F__)
+    return "AVX-512";
+#elif ASCON_SIMD_DISPATCH
+    static const char * const names[] = {"C", "AVX2", "AVX-512"};
+    return names[lw_simd_level()];
+#elif defined(__AVX2__)
+    return "AVX2";
+#else
+    return "C";
+#endif
+}
+
 #if ASCON_SLICED && !ASCON_ASM_SLICED
 
 void ascon_to_sliced(ascon_state_t *state)
@@ -67,6 +67,90 @@ typedef union
  */
 void ascon_permute(ascon_state_t *state, uint8_t first_round);
 
+/**
+ * \brief Defined to 1 if the multi-lane ASCON kernels are selected at
+ * runtime according to the features of the CPU.
+ *
+ * This is the case on x86 with GCC or clang unless the library was
+ * compiled with AVX-512 enabled, in which case the best kernel is
+ * already known at compile time.
+ */
+#if LW_SIMD_DISPATCH && !defined(ASCON_NO_SIMD_DISPATCH)
+#define ASCON_SIMD_DISPATCH 1
+#else
+#define ASCON_SIMD_DISPATCH 0
+#endif
+
+/**
+ * \brief Number of ASCON states that are permuted in parallel by the
+ * widest multi-lane kernel available on this platform.
+ *
+ * This is 8 when AVX-512 may be available and 4 otherwise.  The portable
+ * fallbacks for ascon_permute_x4() and ascon_permute_x8() permute the
+ * lanes one after the other with ascon_permute().
+ */
+#if defined(__AVX512F__) || ASCON_SIMD_DISPATCH
+#define ASCON_MAX_LANES 8
+#else
+#define ASCON_MAX_LANES 4
+#endif
+
+/**
+ * \brief Four ASCON states interleaved for parallel permutation.
+ *
+ * Word \a w of lane \a i is stored at S[w][i] as a 64-bit value in host
+ * byte order; i.e. S[w][i] is the big-endian interpretation of bytes
+ * 8 * w to 8 * w + 7 of the corresponding byte-form ascon_state_t.
+ */
+typedef struct
+{
+    uint64_t S[5][4];   /**< 64-bit words of the states */
+
+} ascon_x4_state_t;
+
+/**
+ * \brief Eight ASCON states interleaved for parallel permutation.
+ *
+ * The layout is the same as ascon_x4_state_t, with eight lanes per word.
+ */
+typedef struct
+{
+    uint64_t S[5][8];   /**< 64-bit words of the states */
+
+} ascon_x8_state_t;
+
+/**
+ * \brief Permutes four independent ASCON states in parallel.
+ *
+ * \param state The four ASCON states to be permuted.
+ * \param first_round The first round (of 12) to be performed; 0, 4, or 6.
+ *
+ * Uses 256-bit AVX2 vectors if the library was compiled with AVX2
+ * enabled or if ASCON_SIMD_DISPATCH is set and the CPU supports AVX2.
+ */
+void ascon_permute_x4(ascon_x4_state_t *state, uint8_t first_round);
+
+/**
+ * \brief Permutes eight independent ASCON states in parallel.
+ *
+ * \param state The eight ASCON states to be permuted.
+ * \param first_round The first round (of 12) to be performed; 0, 4, or 6.
+ *
+ * Uses 512-bit AVX-512 vectors if available, or two passes of 256-bit
+ * AVX2 vectors otherwise.
+ */
+void ascon_permute_x8(ascon_x8_state_t *state, uint8_t first_round);
+
+/**
+ * \brief Gets the name of the multi-lane ASCON kernel in use.
+ *
+ * \return "AVX-512", "AVX2", or "C".
+ *
+ * When ASCON_SIMD_DISPATCH is set, the kernel is chosen on first use by
+ * querying the running CPU; otherwise it is fixed at compile time.
+ */
+const char *ascon_multi_lane_variant(void);
+
 #if ASCON_SLICED
 
 /**
@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2020 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* Multi-block ChaCha20 kernels that are shared between the ChaChaPoly
+ * baseline cipher and the ChaCha20-based PRNG in aead-random.c.
+ *
+ * The first part of this file is only included once and determines which
+ * kernels are available.  After that, we expect a number of macros to be
+ * defined before each inclusion to configure a multi-block kernel:
+ *
+ * CHACHA_LANES_SUFFIX      Suffix to append to the kernel name; e.g. _x4.
+ * CHACHA_LANES             Number of blocks that are generated in parallel.
+ * CHACHA_LANES_TARGET      Function attributes for the kernel, such as
+ *                          the instruction set to compile it for.
+ *
+ * The kernel places one block in each 32-bit lane of a vector so that
+ * the quarter rounds for all blocks run at once.
+ */
+
+#ifndef LW_INTERNAL_CHACHA_LANES_H
+#define LW_INTERNAL_CHACHA_LANES_H
+
+#include "internal-util.h"
+
+/**
+ * \brief Defined to 1 if the multi-block ChaCha20 kernels are selected at
+ * runtime according to the features of the CPU.
+ */
+#if LW_SIMD_DISPATCH && !defined(CHACHA_NO_SIMD_DISPATCH)
+#define CHACHA_SIMD_DISPATCH 1
+#else
+#define CHACHA_SIMD_DISPATCH 0
+#endif
+
+/**
+ * \brief Defined to 1 if there is a 4-block kernel for the baseline
+ * 128-bit vector unit; SSE2 or NEON.
+ */
+#if !defined(__AVR__) && (defined(__GNUC__) || defined(__clang__)) && \
+        (defined(__SSE2__) || defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define CHACHA_HAVE_X4 1
+#else
+#define CHACHA_HAVE_X4 0
+#endif
+
+/**
+ * \brief Defined to 1 if there is an 8-block kernel for AVX2.
+ */
+#if (defined(__GNUC__) || defined(__clang__)) && \
+        (defined(__AVX2__) || CHACHA_SIMD_DISPATCH)
+#define CHACHA_HAVE_X8 1
+#else
+#define CHACHA_HAVE_X8 0
+#endif
+
+/**
+ * \brief Defined to 1 if any multi-block ChaCha20 kernels are available.
+ */
+#define CHACHA_VECTOR (CHACHA_HAVE_X4 || CHACHA_HAVE_X8)
+
+/**
+ * \brief Maximum number of blocks that are generated by a single call
+ * to a multi-block ChaCha20 kernel.
+ */
+#if CHACHA_HAVE_X8
+#define CHACHA_MAX_LANES 8
+#elif CHACHA_HAVE_X4
+#define CHACHA_MAX_LANES 4
+#else
+#define CHACHA_MAX_LANES 1
+#endif
+
+/**
+ * \brief Determine if the 8-block kernel can be used on this CPU.
+ */
+#if CHACHA_SIMD_DISPATCH && !defined(__AVX2__)
+#define chacha_can_use_x8() (lw_simd_level() >= LW_SIMD_LEVEL_AVX2)
+#else
+#define chacha_can_use_x8() (CHACHA_HAVE_X8)
+#endif
+
+#endif /* LW_INTERNAL_CHACHA_LANES_H */
+
+#if defined(CHACHA_LANES_SUFFIX)
+
+#define CHACHA_CONCAT_INNER(name,suffix) name##suffix
+#define CHACHA_CONCAT(name,suffix) CHACHA_CONCAT_INNER(name,suffix)
+#define CHACHA_VEC_T CHACHA_CONCAT(chacha_vec,CHACHA_LANES_SUFFIX)
+#define CHACHA_SET_T CHACHA_CONCAT(chacha_set,CHACHA_LANES_SUFFIX)
+
+/* Vector type with one 32-bit lane per block */
+typedef uint32_t CHACHA_VEC_T __attribute__((vector_size(CHACHA_LANES * 4)));
+
+/* Words of the state for all blocks, as vectors or as individual words */
+typedef union
+{
+    CHACHA_VEC_T v[16];
+    uint32_t w[16][CHACHA_LANES];
+
+} CHACHA_SET_T;
+
+/* Perform a ChaCha quarter round operation on all lanes */
+#define chacha_vec_rotl(x, bits) (((x) << (bits)) | ((x) >> (32 - (bits))))
+#define chacha_vec_quarter_round(a, b, c, d) \
+    do { \
+        (a) += (b); \
+        (d) = chacha_vec_rotl((d) ^ (a), 16); \
+        (c) += (d); \
+        (b) = chacha_vec_rotl((b) ^ (c), 12); \
+        (a) += (b); \
+        (d) = chacha_vec_rotl((d) ^ (a), 8); \
+        (c) += (d); \
+        (b) = chacha_vec_rotl((b) ^ (c), 7); \
+    } while (0)
+
+/**
+ * \brief Executes the ChaCha20 hash core on CHACHA_LANES consecutive blocks.
+ *
+ * \param output Output for the blocks, 16 words per block one after the
+ * other, in host byte order.
+ * \param input Input block in host byte order.
+ * \param counter Index of the block counter word in \a input.  Block i
+ * is generated with the counter word set to input[counter] + i.
+ */
+static CHACHA_LANES_TARGET void CHACHA_CONCAT
+    (chacha_core_lanes,CHACHA_LANES_SUFFIX)
+    (uint32_t *output, const uint32_t input[16], unsigned counter)
+{
+    CHACHA_SET_T set;
+    CHACHA_VEC_T x[16];
+    CHACHA_VEC_T ctr;
+    unsigned posn, lane, round;
+
+    /* Broadcast the input block to all lanes, with consecutive counters */
+    for (lane = 0; lane < CHACHA_LANES; ++lane)
+        set.w[0][lane] = input[counter] + lane;
+    ctr = set.v[0];
+    for (posn = 0; posn < 16; ++posn)
+        x[posn] = (CHACHA_VEC_T){0} + input[posn];
+    x[counter] = ctr;
+
+    /* Perform the ChaCha rounds in sets of two */
+    for (round = 0; round < 10; ++round) {
+        /* Column round */
+        chacha_vec_quarter_round(x[0], x[4], x[8],  x[12]);
+        chacha_vec_quarter_round(x[1], x[5], x[9],  x[13]);
+        chacha_vec_quarter_round(x[2], x[6], x[10], x[14]);
+        chacha_vec_quarter_round(x[3], x[7], x[11], x[15]);
+
+        /* Diagonal round */
+        chacha_vec_quarter_round(x[0], x[5], x[10], x[15]);
+        chacha_vec_quarter_round(x[1], x[6], x[11], x[12]);
+        chacha_vec_quarter_round(x[2], x[7], x[8],  x[13]);
+        chacha_vec_quarter_round(x[3], x[4], x[9],  x[14]);
+    }
+
+    /* Add the original input to the final output */
+    for (posn = 0; posn < 16; ++posn)
+        set.v[posn] = x[posn] + input[posn];
+    set.v[counter] = x[counter] + ctr;
+
+    /* Transpose the lanes into consecutive output blocks */
+    for (lane = 0; lane < CHACHA_LANES; ++lane) {
+        for (posn = 0; posn < 16; ++posn)
+            output[posn] = set.w[posn][lane];
+        output += 16;
+    }
+}
+
+#undef chacha_vec_rotl
+#undef chacha_vec_quarter_round
+
+#endif /* CHACHA_LANES_SUFFIX */
+
+/* Now undefine everything so that we can include this file again for
+ * another kernel width */
+#undef CHACHA_LANES_SUFFIX
+#undef CHACHA_LANES
+#undef CHACHA_LANES_TARGET
+#undef CHACHA_CONCAT_INNER
+#undef CHACHA_CONCAT
+#undef CHACHA_VEC_T
+#undef CHACHA_SET_T
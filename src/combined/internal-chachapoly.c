@@ -21,6 +21,7 @@
  */
 
 #include "internal-chachapoly.h"
+#include "internal-chacha-lanes.h"
 #include "internal-util.h"
 #include <string.h>
 
@@ -31,7 +32,13 @@ aead_cipher_t const internal_chachapoly_cipher = {
     CHACHAPOLY_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN,
     internal_chachapoly_aead_encrypt,
-    internal_chachapoly_aead_decrypt
+    internal_chachapoly_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 /**
@@ -112,6 +119,34 @@ static void chachaCore(uint32_t *output, const uint32_t *input)
 #endif
 }
 
+/* The multi-block kernels work on words in host byte order, which is
+ * the same as the state's byte order on little-endian platforms */
+#if CHACHA_VECTOR && defined(LW_UTIL_LITTLE_ENDIAN)
+#define CHACHAPOLY_VECTOR 1
+#else
+#define CHACHAPOLY_VECTOR 0
+#endif
+
+#if CHACHAPOLY_VECTOR
+
+/* 128-bit kernel for the baseline vector unit; SSE2 or NEON */
+#if CHACHA_HAVE_X4
+#define CHACHA_LANES_SUFFIX _x4
+#define CHACHA_LANES 4
+#define CHACHA_LANES_TARGET
+#include "internal-chacha-lanes.h"
+#endif
+
+/* 256-bit kernel for AVX2 */
+#if CHACHA_HAVE_X8
+#define CHACHA_LANES_SUFFIX _x8
+#define CHACHA_LANES 8
+#define CHACHA_LANES_TARGET LW_TARGET_AVX2
+#include "internal-chacha-lanes.h"
+#endif
+
+#endif /* CHACHAPOLY_VECTOR */
+
 static const char tag256[] = "expand 32-byte k";
 
 #if defined(LW_UTIL_LITTLE_ENDIAN)
@@ -127,6 +162,36 @@ STATIC_INLINE void chacha_encrypt
     /* Note: For simplicity we limit the block counter to 32-bit which
      * limits the maximum packet size to 256Gb.  This should be OK. */
     uint32_t counter = 1;
+#if CHACHAPOLY_VECTOR
+    uint32_t blocks[CHACHA_MAX_LANES * 16];
+    unsigned size;
+#if CHACHA_HAVE_X8
+    if (chacha_can_use_x8()) {
+        size = 8 * 64;
+        while (len >= size) {
+            set_counter(counter);
+            chacha_core_lanes_x8(blocks, state->words, 12);
+            lw_xor_block_2_src(out, (const unsigned char *)blocks, in, size);
+            in += size;
+            out += size;
+            len -= size;
+            counter += 8;
+        }
+    }
+#endif
+#if CHACHA_HAVE_X4
+    size = 4 * 64;
+    while (len >= size) {
+        set_counter(counter);
+        chacha_core_lanes_x4(blocks, state->words, 12);
+        lw_xor_block_2_src(out, (const unsigned char *)blocks, in, size);
+        in += size;
+        out += size;
+        len -= size;
+        counter += 4;
+    }
+#endif
+#endif
     while (len >= 64) {
         set_counter(counter);
         chachaCore(stream->words, state->words);
@@ -0,0 +1,286 @@
+/*
+ * Copyright (C) 2020 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* We expect a number of macros to be defined before this file
+ * is included to configure the underlying Elephant variant.
+ *
+ * ELEPHANT_ALG_NAME        Name of the Elephant algorithm; e.g. dumbo
+ * ELEPHANT_STATE_SIZE      Size of the permutation state and blocks in bytes.
+ * ELEPHANT_STATE           Type for the permutation state.
+ * ELEPHANT_KEY_SIZE        Size of the key in bytes.
+ * ELEPHANT_NONCE_SIZE      Size of the nonce in bytes.
+ * ELEPHANT_TAG_SIZE        Size of the authentication tag in bytes.
+ * ELEPHANT_LANES           Number of blocks to process at once.
+ * ELEPHANT_PERMUTE(s)      Permutes the state "s".
+ * ELEPHANT_PERMUTE_N(s,n)  Permutes the "n" states in the array "s".
+ * ELEPHANT_LFSR(out,in)    Applies the mask LFSR to "in" to produce "out".
+ *
+ * Every encryption and authentication block in Elephant is processed with
+ * its own permutation call, using a mask that depends only upon the key
+ * and the block's position.  So we generate the masks for up to
+ * ELEPHANT_LANES blocks ahead of time and then permute all of those
+ * blocks in parallel.
+ */
+#if defined(ELEPHANT_ALG_NAME)
+
+#define ELEPHANT_CONCAT_INNER(name,suffix) name##suffix
+#define ELEPHANT_CONCAT(name,suffix) ELEPHANT_CONCAT_INNER(name,suffix)
+
+/**
+ * \brief Hashes the key to generate the initial mask.
+ *
+ * \param state Temporary permutation state.
+ * \param mask Receives the initial mask.
+ * \param k Points to the key.
+ */
+static void ELEPHANT_CONCAT(ELEPHANT_ALG_NAME,_init_mask)
+    (ELEPHANT_STATE *state, unsigned char mask[ELEPHANT_STATE_SIZE],
+     const unsigned char *k)
+{
+    memcpy(state->B, k, ELEPHANT_KEY_SIZE);
+    memset(state->B + ELEPHANT_KEY_SIZE, 0,
+           sizeof(state->B) - ELEPHANT_KEY_SIZE);
+    ELEPHANT_PERMUTE(state);
+    memcpy(mask, state->B, ELEPHANT_KEY_SIZE);
+    memset(mask + ELEPHANT_KEY_SIZE, 0,
+           ELEPHANT_STATE_SIZE - ELEPHANT_KEY_SIZE);
+}
+
+/**
+ * \brief Authenticates a padded stream of data.
+ *
+ * \param states Array of ELEPHANT_LANES temporary permutation states.
+ * \param tag Points to the ongoing tag that is being computed.
+ * \param mask Points to the initial mask value.
+ * \param prefix Points to a prefix to authenticate before the data.
+ * \param prefix_len Length of the prefix, less than ELEPHANT_STATE_SIZE.
+ * \param data Points to the data to authenticate after the prefix.
+ * \param len Length of the data.
+ * \param distance Distance between the two masks for each block; 2 for
+ * the associated data and 1 for the ciphertext.
+ *
+ * Block i of the stream is XOR'ed with mask i and mask i + distance
+ * before and after the permutation.  The stream is always padded with
+ * 0x01, even if it is a multiple of the block size.
+ */
+static void ELEPHANT_CONCAT(ELEPHANT_ALG_NAME,_authenticate)
+    (ELEPHANT_STATE *states, unsigned char tag[ELEPHANT_TAG_SIZE],
+     const unsigned char mask[ELEPHANT_STATE_SIZE],
+     const unsigned char *prefix, unsigned prefix_len,
+     const unsigned char *data, unsigned long long len, unsigned distance)
+{
+    unsigned char masks[ELEPHANT_LANES + 3][ELEPHANT_STATE_SIZE];
+    unsigned long long total = prefix_len + len;
+    unsigned long long blocks = total / ELEPHANT_STATE_SIZE + 1;
+    unsigned long long posn = 0;
+    unsigned lanes, lane, index, size;
+    unsigned char *block;
+
+    /* Generate the first set of masks */
+    memcpy(masks[0], mask, ELEPHANT_STATE_SIZE);
+    for (index = 1; index <= distance; ++index)
+        ELEPHANT_LFSR(masks[index], masks[index - 1]);
+
+    /* Process the blocks ELEPHANT_LANES at a time */
+    while (blocks > 0) {
+        lanes = (blocks < ELEPHANT_LANES) ? (unsigned)blocks : ELEPHANT_LANES;
+        for (index = distance + 1; index <= lanes + distance; ++index)
+            ELEPHANT_LFSR(masks[index], masks[index - 1]);
+        for (lane = 0; lane < lanes; ++lane) {
+            /* Gather the next block from the prefix and data */
+            block = states[lane].B;
+            if (posn < prefix_len) {
+                memcpy(block, prefix, prefix_len);
+                size = ELEPHANT_STATE_SIZE - prefix_len;
+                if (size > len)
+                    size = (unsigned)len;
+                if (size)
+                    memcpy(block + prefix_len, data, size);
+                size += prefix_len;
+            } else {
+                size = ELEPHANT_STATE_SIZE;
+                if (size > (total - posn))
+                    size = (unsigned)(total - posn);
+                memcpy(block, data + (posn - prefix_len), size);
+            }
+            if (size < ELEPHANT_STATE_SIZE) {
+                block[size] = 0x01;
+                memset(block + size + 1, 0, ELEPHANT_STATE_SIZE - size - 1);
+            }
+            posn += ELEPHANT_STATE_SIZE;
+
+            /* Mask the block */
+            lw_xor_block(block, masks[lane], ELEPHANT_STATE_SIZE);
+            lw_xor_block(block, masks[lane + distance], ELEPHANT_STATE_SIZE);
+        }
+        ELEPHANT_PERMUTE_N(states, lanes);
+        for (lane = 0; lane < lanes; ++lane) {
+            block = states[lane].B;
+            lw_xor_block(block, masks[lane], ELEPHANT_TAG_SIZE);
+            lw_xor_block(block, masks[lane + distance], ELEPHANT_TAG_SIZE);
+            lw_xor_block(tag, block, ELEPHANT_TAG_SIZE);
+        }
+
+        /* Slide the mask window along to the next set of blocks */
+        memmove(masks[0], masks[lanes], (distance + 1) * ELEPHANT_STATE_SIZE);
+        blocks -= lanes;
+    }
+}
+
+/**
+ * \brief Encrypts or decrypts the payload.
+ *
+ * \param states Array of ELEPHANT_LANES temporary permutation states.
+ * \param out Points to the output buffer.
+ * \param in Points to the input buffer.
+ * \param len Length of the input and output.
+ * \param npub Points to the nonce.
+ * \param mask Points to the initial mask value.
+ */
+static void ELEPHANT_CONCAT(ELEPHANT_ALG_NAME,_encrypt)
+    (ELEPHANT_STATE *states, unsigned char *out, const unsigned char *in,
+     unsigned long long len, const unsigned char *npub,
+     const unsigned char mask[ELEPHANT_STATE_SIZE])
+{
+    unsigned char masks[ELEPHANT_LANES + 1][ELEPHANT_STATE_SIZE];
+    unsigned lanes, lane, size;
+
+    memcpy(masks[0], mask, ELEPHANT_STATE_SIZE);
+    while (len > 0) {
+        /* Encrypt the nonce with the masks for the next set of blocks */
+        lanes = (unsigned)((len + ELEPHANT_STATE_SIZE - 1) /
+                           ELEPHANT_STATE_SIZE);
+        if (lanes > ELEPHANT_LANES)
+            lanes = ELEPHANT_LANES;
+        for (lane = 0; lane < lanes; ++lane) {
+            ELEPHANT_LFSR(masks[lane + 1], masks[lane]);
+            memcpy(states[lane].B, masks[lane], ELEPHANT_STATE_SIZE);
+            lw_xor_block(states[lane].B, npub, ELEPHANT_NONCE_SIZE);
+        }
+        ELEPHANT_PERMUTE_N(states, lanes);
+
+        /* XOR the encrypted nonces with the input */
+        for (lane = 0; lane < lanes; ++lane) {
+            size = ELEPHANT_STATE_SIZE;
+            if (size > len)
+                size = (unsigned)len;
+            lw_xor_block(states[lane].B, masks[lane], size);
+            lw_xor_block_2_src(out, states[lane].B, in, size);
+            out += size;
+            in += size;
+            len -= size;
+        }
+        memcpy(masks[0], masks[lanes], ELEPHANT_STATE_SIZE);
+    }
+}
+
+int ELEPHANT_CONCAT(ELEPHANT_ALG_NAME,_aead_encrypt)
+    (unsigned char *c, unsigned long long *clen,
+     const unsigned char *m, unsigned long long mlen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *nsec,
+     const unsigned char *npub,
+     const unsigned char *k)
+{
+    ELEPHANT_STATE states[ELEPHANT_LANES];
+    unsigned char mask[ELEPHANT_STATE_SIZE];
+    unsigned char tag[ELEPHANT_TAG_SIZE];
+    (void)nsec;
+
+    /* Set the length of the returned ciphertext */
+    *clen = mlen + ELEPHANT_TAG_SIZE;
+
+    /* Hash the key and generate the initial mask */
+    memset(states, 0, sizeof(states));
+    ELEPHANT_CONCAT(ELEPHANT_ALG_NAME,_init_mask)(&(states[0]), mask, k);
+
+    /* Authenticate the nonce and the associated data */
+    memset(tag, 0, sizeof(tag));
+    ELEPHANT_CONCAT(ELEPHANT_ALG_NAME,_authenticate)
+        (states, tag, mask, npub, ELEPHANT_NONCE_SIZE, ad, adlen, 2);
+
+    /* Encrypt and authenticate the payload */
+    ELEPHANT_CONCAT(ELEPHANT_ALG_NAME,_encrypt)(states, c, m, mlen, npub, mask);
+    if (mlen > 0) {
+        ELEPHANT_CONCAT(ELEPHANT_ALG_NAME,_authenticate)
+            (states, tag, mask, 0, 0, c, mlen, 1);
+    }
+
+    /* Generate the authentication tag */
+    memcpy(c + mlen, tag, ELEPHANT_TAG_SIZE);
+    return 0;
+}
+
+int ELEPHANT_CONCAT(ELEPHANT_ALG_NAME,_aead_decrypt)
+    (unsigned char *m, unsigned long long *mlen,
+     unsigned char *nsec,
+     const unsigned char *c, unsigned long long clen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *npub,
+     const unsigned char *k)
+{
+    ELEPHANT_STATE states[ELEPHANT_LANES];
+    unsigned char mask[ELEPHANT_STATE_SIZE];
+    unsigned char tag[ELEPHANT_TAG_SIZE];
+    (void)nsec;
+
+    /* Validate the ciphertext length and set the return "mlen" value */
+    if (clen < ELEPHANT_TAG_SIZE)
+        return -1;
+    *mlen = clen - ELEPHANT_TAG_SIZE;
+
+    /* Hash the key and generate the initial mask */
+    memset(states, 0, sizeof(states));
+    ELEPHANT_CONCAT(ELEPHANT_ALG_NAME,_init_mask)(&(states[0]), mask, k);
+
+    /* Authenticate the nonce, the associated data, and the ciphertext.
+     * This is done before decryption in case "m" and "c" overlap */
+    memset(tag, 0, sizeof(tag));
+    ELEPHANT_CONCAT(ELEPHANT_ALG_NAME,_authenticate)
+        (states, tag, mask, npub, ELEPHANT_NONCE_SIZE, ad, adlen, 2);
+    if (*mlen > 0) {
+        ELEPHANT_CONCAT(ELEPHANT_ALG_NAME,_authenticate)
+            (states, tag, mask, 0, 0, c, *mlen, 1);
+    }
+
+    /* Decrypt the ciphertext and check the authentication tag */
+    ELEPHANT_CONCAT(ELEPHANT_ALG_NAME,_encrypt)
+        (states, m, c, *mlen, npub, mask);
+    return aead_check_tag(m, *mlen, tag, c + *mlen, ELEPHANT_TAG_SIZE);
+}
+
+#endif /* ELEPHANT_ALG_NAME */
+
+/* Now undefine everything so that we can include this file again for
+ * another variant on the Elephant algorithm */
+#undef ELEPHANT_ALG_NAME
+#undef ELEPHANT_STATE_SIZE
+#undef ELEPHANT_STATE
+#undef ELEPHANT_KEY_SIZE
+#undef ELEPHANT_NONCE_SIZE
+#undef ELEPHANT_TAG_SIZE
+#undef ELEPHANT_LANES
+#undef ELEPHANT_PERMUTE
+#undef ELEPHANT_PERMUTE_N
+#undef ELEPHANT_LFSR
+#undef ELEPHANT_CONCAT_INNER
+#undef ELEPHANT_CONCAT
@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2020 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* We expect a number of macros to be defined before this file
+ * is included to configure the multi-block GIFT-128 kernel.
+ *
+ * GIFT128_LANES_SUFFIX     Suffix to append to the kernel name; e.g. _x4.
+ * GIFT128_LANES            Number of blocks that are processed in parallel.
+ * GIFT128_LANES_TARGET     Function attributes for the kernel, such as
+ *                          the instruction set to compile it for.
+ *
+ * The kernel is built from the same fixsliced round macros as the
+ * single-block functions, applied to vectors with one block in each
+ * 32-bit lane.  Each lane can have its own key.
+ */
+#if defined(GIFT128_LANES_SUFFIX)
+
+#define GIFT128_CONCAT_INNER(name,suffix) name##suffix
+#define GIFT128_CONCAT(name,suffix) GIFT128_CONCAT_INNER(name,suffix)
+#define GIFT128_VEC_T GIFT128_CONCAT(gift128_vec,GIFT128_LANES_SUFFIX)
+#define GIFT128_SET_T GIFT128_CONCAT(gift128_set,GIFT128_LANES_SUFFIX)
+
+/* Vector type with one 32-bit lane per block */
+typedef uint32_t GIFT128_VEC_T __attribute__((vector_size(GIFT128_LANES * 4)));
+
+/* Words of the state for all blocks, as vectors or as individual words */
+typedef union
+{
+    GIFT128_VEC_T v[4];
+    uint32_t w[4][GIFT128_LANES];
+
+} GIFT128_SET_T;
+
+/* Redirect the round macros to the vector type */
+#undef GIFT128_WORD
+#undef gift128b_rotl
+#define GIFT128_WORD GIFT128_VEC_T
+#define gift128b_rotl(x, bits) (((x) << (bits)) | ((x) >> (32 - (bits))))
+
+/**
+ * \brief Encrypts GIFT128_LANES pre-loaded blocks in parallel with
+ * TweGIFT-128 in the fixsliced representation.
+ *
+ * \param rk Points to round key 0 for the first lane in a transposed
+ * key schedule, with a stride of GIFT128_MAX_LANES words between keys.
+ * \param blocks The blocks to encrypt in-place, one per lane.
+ * \param tweak Tweak to add to the state every 5 rounds, or zero for
+ * plain GIFT-128.
+ */
+static GIFT128_LANES_TARGET void GIFT128_CONCAT
+    (gift128b_encrypt_lanes,GIFT128_LANES_SUFFIX)
+    (const uint32_t *rk, uint32_t (*blocks)[4], uint32_t tweak)
+{
+    GIFT128_SET_T set;
+    GIFT128_VEC_T s0, s1, s2, s3;
+    GIFT128_VEC_T k[10];
+    unsigned lane, round, index;
+
+    /* Transpose the blocks into the vector lanes */
+    for (lane = 0; lane < GIFT128_LANES; ++lane) {
+        set.w[0][lane] = blocks[lane][0];
+        set.w[1][lane] = blocks[lane][1];
+        set.w[2][lane] = blocks[lane][2];
+        set.w[3][lane] = blocks[lane][3];
+    }
+    s0 = set.v[0];
+    s1 = set.v[1];
+    s2 = set.v[2];
+    s3 = set.v[3];
+
+    /* Perform all 40 rounds five at a time, adding the tweak to the
+     * state between each group of five rounds */
+    for (round = 0; round < 40; round += 5) {
+        for (index = 0; index < 10; ++index) {
+            memcpy(&(k[index]), rk + (round * 2 + index) * GIFT128_MAX_LANES,
+                   sizeof(GIFT128_VEC_T));
+        }
+        if (round != 0)
+            s0 ^= tweak;
+        gift128b_encrypt_5_rounds(k, GIFT128_RC_fixsliced + round);
+    }
+
+    /* Transpose the vector lanes back into the blocks */
+    set.v[0] = s0;
+    set.v[1] = s1;
+    set.v[2] = s2;
+    set.v[3] = s3;
+    for (lane = 0; lane < GIFT128_LANES; ++lane) {
+        blocks[lane][0] = set.w[0][lane];
+        blocks[lane][1] = set.w[1][lane];
+        blocks[lane][2] = set.w[2][lane];
+        blocks[lane][3] = set.w[3][lane];
+    }
+}
+
+/* Restore the single-block definitions of the round macros */
+#undef GIFT128_WORD
+#undef gift128b_rotl
+#define GIFT128_WORD uint32_t
+#define gift128b_rotl(x, bits) (leftRotate##bits((x)))
+
+#endif /* GIFT128_LANES_SUFFIX */
+
+/* Now undefine everything so that we can include this file again for
+ * another kernel width */
+#undef GIFT128_LANES_SUFFIX
+#undef GIFT128_LANES
+#undef GIFT128_LANES_TARGET
+#undef GIFT128_CONCAT_INNER
+#undef GIFT128_CONCAT
+#undef GIFT128_VEC_T
+#undef GIFT128_SET_T
@@ -22,6 +22,12 @@
 
 #include "internal-gift128.h"
 #include "internal-util.h"
+#include <string.h>
+
+/* Type of the words in the state and rotations on them, which the
+ * multi-block kernels redefine to operate on vectors of blocks */
+#define GIFT128_WORD uint32_t
+#define gift128b_rotl(x, bits) (leftRotate##bits((x)))
 
 #if !GIFT128_VARIANT_ASM
 
@@ -288,7 +294,7 @@ void gift128n_decrypt
  */
 #define gift128b_swap_move(a, b, mask, shift) \
     do { \
-        uint32_t tmp = ((b) ^ ((a) >> (shift))) & (mask); \
+        GIFT128_WORD tmp = ((b) ^ ((a) >> (shift))) & (mask); \
         (b) ^= tmp; \
         (a) ^= tmp << (shift); \
     } while (0)
@@ -364,6 +370,10 @@ static void gift128b_compute_round_keys
     unsigned index;
     uint32_t temp;
 
+#if GIFT128_VARIANT_RUNTIME
+    ks->variant = GIFT128_VARIANT_FULL;
+#endif
+
     /* Set the regular key with k0 and k3 pre-swapped for the round function */
     ks->k[0] = k3;
     ks->k[1] = k1;
@@ -469,6 +479,23 @@ void gift128n_init(gift128n_key_schedule_t *ks, const unsigned char *key)
              le_load_word32(key + 4), le_load_word32(key));
 }
 
+#if GIFT128_VARIANT_RUNTIME
+
+const gift128b_key_schedule_t *gift128b_expand_schedule
+    (const gift128b_key_schedule_t *ks, gift128b_key_schedule_t *temp)
+{
+    if (ks->variant != GIFT128_VARIANT_TINY)
+        return ks;
+
+    /* The tiny key schedule holds the key words in the fixsliced order
+     * of 3, 1, 2, 0 for both the bit-sliced and nibble-based versions */
+    gift128b_compute_round_keys
+        (temp, ks->k[3], ks->k[1], ks->k[2], ks->k[0]);
+    return temp;
+}
+
+#endif
+
 /**
  * \brief Performs the GIFT-128 S-box on the bit-sliced state.
  *
@@ -548,9 +575,9 @@ void gift128n_init(gift128n_key_schedule_t *ks, const unsigned char *key)
 #define gift128b_permute_state_3(s0, s1, s2, s3) \
     do { \
         gift128b_swap_move(s1, s1, 0x55555555U, 1); \
-        s2 = leftRotate16(s2); \
+        s2 = gift128b_rotl(s2, 16); \
         gift128b_swap_move(s2, s2, 0x00005555U, 1); \
-        s3 = leftRotate16(s3); \
+        s3 = gift128b_rotl(s3, 16); \
         gift128b_swap_move(s3, s3, 0x55550000U, 1); \
     } while (0);
 
@@ -579,9 +606,9 @@ void gift128n_init(gift128n_key_schedule_t *ks, const unsigned char *key)
  */
 #define gift128b_permute_state_5(s0, s1, s2, s3) \
     do { \
-        s1 = leftRotate16(s1); \
-        s2 = rightRotate8(s2); \
-        s3 = leftRotate8(s3); \
+        s1 = gift128b_rotl(s1, 16); \
+        s2 = gift128b_rotl(s2, 24); \
+        s3 = gift128b_rotl(s3, 8); \
     } while (0);
 
 /**
@@ -626,9 +653,9 @@ void gift128n_init(gift128n_key_schedule_t *ks, const unsigned char *key)
     do { \
         gift128b_swap_move(s1, s1, 0x55555555U, 1); \
         gift128b_swap_move(s2, s2, 0x00005555U, 1); \
-        s2 = leftRotate16(s2); \
+        s2 = gift128b_rotl(s2, 16); \
         gift128b_swap_move(s3, s3, 0x55550000U, 1); \
-        s3 = leftRotate16(s3); \
+        s3 = gift128b_rotl(s3, 16); \
     } while (0);
 
 /**
@@ -656,9 +683,9 @@ void gift128n_init(gift128n_key_schedule_t *ks, const unsigned char *key)
  */
 #define gift128b_inv_permute_state_5(s0, s1, s2, s3) \
     do { \
-        s1 = leftRotate16(s1); \
-        s2 = leftRotate8(s2); \
-        s3 = rightRotate8(s3); \
+        s1 = gift128b_rotl(s1, 16); \
+        s2 = gift128b_rotl(s2, 8); \
+        s3 = gift128b_rotl(s3, 24); \
     } while (0);
 
 /**
@@ -920,8 +947,12 @@ void gift128b_encrypt
     (const gift128b_key_schedule_t *ks, unsigned char *output,
      const unsigned char *input)
 {
+    gift128b_key_schedule_t temp;
     uint32_t s0, s1, s2, s3;
 
+    /* Expand the key schedule if it is the tiny variant */
+    ks = gift128b_expand_schedule(ks, &temp);
+
     /* Copy the plaintext into the state buffer and convert from big endian */
     s0 = be_load_word32(input);
     s1 = be_load_word32(input + 4);
@@ -949,8 +980,12 @@ void gift128b_encrypt_preloaded
     (const gift128b_key_schedule_t *ks, uint32_t output[4],
      const uint32_t input[4])
 {
+    gift128b_key_schedule_t temp;
     uint32_t s0, s1, s2, s3;
 
+    /* Expand the key schedule if it is the tiny variant */
+    ks = gift128b_expand_schedule(ks, &temp);
+
     /* Copy the plaintext into local variables */
     s0 = input[0];
     s1 = input[1];
@@ -978,8 +1013,12 @@ void gift128t_encrypt
     (const gift128n_key_schedule_t *ks, unsigned char *output,
      const unsigned char *input, uint32_t tweak)
 {
+    gift128b_key_schedule_t temp;
     uint32_t s0, s1, s2, s3;
 
+    /* Expand the key schedule if it is the tiny variant */
+    ks = gift128b_expand_schedule(ks, &temp);
+
     /* Copy the plaintext into the state buffer and convert from nibbles */
     gift128n_to_words(output, input);
     s0 = be_load_word32(output);
@@ -1215,8 +1254,12 @@ void gift128b_decrypt
     (const gift128b_key_schedule_t *ks, unsigned char *output,
      const unsigned char *input)
 {
+    gift128b_key_schedule_t temp;
     uint32_t s0, s1, s2, s3;
 
+    /* Expand the key schedule if it is the tiny variant */
+    ks = gift128b_expand_schedule(ks, &temp);
+
     /* Copy the plaintext into the state buffer and convert from big endian */
     s0 = be_load_word32(input);
     s1 = be_load_word32(input + 4);
@@ -1244,8 +1287,12 @@ void gift128t_decrypt
     (const gift128n_key_schedule_t *ks, unsigned char *output,
      const unsigned char *input, uint32_t tweak)
 {
+    gift128b_key_schedule_t temp;
     uint32_t s0, s1, s2, s3;
 
+    /* Expand the key schedule if it is the tiny variant */
+    ks = gift128b_expand_schedule(ks, &temp);
+
     /* Copy the ciphertext into the state buffer and convert from nibbles */
     gift128n_to_words(output, input);
     s0 = be_load_word32(output);
@@ -1496,3 +1543,265 @@ void gift128t_decrypt
 #endif /* GIFT128_VARIANT_SMALL || GIFT128_VARIANT_TINY */
 
 #endif /* !GIFT128_VARIANT_ASM */
+
+size_t gift128b_key_schedule_size(int variant)
+{
+#if GIFT128_VARIANT_RUNTIME
+    if (variant == GIFT128_VARIANT_TINY)
+        return offsetof(gift128b_key_schedule_t, k) + 4 * sizeof(uint32_t);
+#else
+    (void)variant;
+#endif
+    return sizeof(gift128b_key_schedule_t);
+}
+
+void gift128b_init_variant
+    (gift128b_key_schedule_t *ks, const unsigned char *key, int variant)
+{
+#if GIFT128_VARIANT_RUNTIME
+    if (variant == GIFT128_VARIANT_TINY) {
+        /* Mirror the fixslicing word order of 3, 1, 2, 0 */
+        ks->variant = GIFT128_VARIANT_TINY;
+        ks->k[0] = be_load_word32(key + 12);
+        ks->k[1] = be_load_word32(key + 4);
+        ks->k[2] = be_load_word32(key + 8);
+        ks->k[3] = be_load_word32(key);
+        return;
+    }
+#else
+    (void)variant;
+#endif
+    gift128b_init(ks, key);
+}
+
+void gift128n_init_variant
+    (gift128n_key_schedule_t *ks, const unsigned char *key, int variant)
+{
+#if GIFT128_VARIANT_RUNTIME
+    if (variant == GIFT128_VARIANT_TINY) {
+        /* Use the little-endian key byte order from the HYENA submission
+         * and mirror the fixslicing word order of 3, 1, 2, 0 */
+        ks->variant = GIFT128_VARIANT_TINY;
+        ks->k[0] = le_load_word32(key);
+        ks->k[1] = le_load_word32(key + 8);
+        ks->k[2] = le_load_word32(key + 4);
+        ks->k[3] = le_load_word32(key + 12);
+        return;
+    }
+#else
+    (void)variant;
+#endif
+    gift128n_init(ks, key);
+}
+
+#if GIFT128_VECTOR
+
+/* The lanes template redefines GIFT128_WORD and gift128b_rotl(), so the
+ * kernels must come after all of the single-block functions above */
+
+/* 128-bit kernel for the baseline vector unit; SSE2 or NEON */
+#if defined(__SSE2__) || defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define GIFT128_HAVE_X4 1
+#define GIFT128_LANES_SUFFIX _x4
+#define GIFT128_LANES 4
+#define GIFT128_LANES_TARGET
+#include "internal-gift128-lanes.h"
+#else
+#define GIFT128_HAVE_X4 0
+#endif
+
+/* 256-bit kernel for AVX2 */
+#if defined(__AVX2__) || GIFT128_SIMD_DISPATCH
+#define GIFT128_HAVE_X8 1
+#define GIFT128_LANES_SUFFIX _x8
+#define GIFT128_LANES 8
+#define GIFT128_LANES_TARGET LW_TARGET_AVX2
+#include "internal-gift128-lanes.h"
+#else
+#define GIFT128_HAVE_X8 0
+#endif
+
+/* 512-bit kernel for AVX-512 */
+#if defined(__AVX512F__) || GIFT128_SIMD_DISPATCH
+#define GIFT128_HAVE_X16 1
+#define GIFT128_LANES_SUFFIX _x16
+#define GIFT128_LANES 16
+#define GIFT128_LANES_TARGET LW_TARGET_AVX512
+#include "internal-gift128-lanes.h"
+#else
+#define GIFT128_HAVE_X16 0
+#endif
+
+/* Runs a kernel of "width" lanes while more than "min" lanes are left.
+ * The last run may extend past ks->lanes into the padding lanes */
+#define gift128_multi_run(kernel, width, min) \
+    do { \
+        while (lane < ks->lanes && (ks->lanes - lane) > (min)) { \
+            kernel(&(ks->k[0][lane]), words + lane, tweak); \
+            lane += (width); \
+        } \
+    } while (0)
+
+/**
+ * \brief Encrypts pre-loaded blocks with the widest vector kernels that
+ * are available on this CPU.
+ *
+ * \param ks Points to the multi-block key schedule.
+ * \param words The blocks to encrypt, with room for GIFT128_MAX_LANES.
+ * \param tweak Tweak for TweGIFT-128, or zero for plain GIFT-128.
+ *
+ * \return The number of lanes from the start of \a words that were
+ * encrypted, which is either zero or at least ks->lanes.
+ */
+static unsigned gift128b_encrypt_words_multi
+    (const gift128b_multi_key_schedule_t *ks,
+     uint32_t words[GIFT128_MAX_LANES][4], uint32_t tweak)
+{
+    unsigned lane = 0;
+
+    /* Clear the padding lanes that a kernel may run over at the end */
+    memset(words + ks->lanes, 0,
+           (GIFT128_MAX_LANES - ks->lanes) * sizeof(words[0]));
+
+    /* Run the kernels from widest to narrowest */
+#if GIFT128_SIMD_DISPATCH
+    int level = lw_simd_level();
+    if (level == LW_SIMD_LEVEL_AVX512)
+        gift128_multi_run(gift128b_encrypt_lanes_x16, 16, 8);
+    if (level >= LW_SIMD_LEVEL_AVX2)
+        gift128_multi_run(gift128b_encrypt_lanes_x8, 8, 4);
+#else
+#if GIFT128_HAVE_X16
+    gift128_multi_run(gift128b_encrypt_lanes_x16, 16, 8);
+#endif
+#if GIFT128_HAVE_X8
+    gift128_multi_run(gift128b_encrypt_lanes_x8, 8, 4);
+#endif
+#endif
+#if GIFT128_HAVE_X4
+    gift128_multi_run(gift128b_encrypt_lanes_x4, 4, 0);
+#endif
+    return lane;
+}
+
+#endif /* GIFT128_VECTOR */
+
+void gift128b_multi_init
+    (gift128b_multi_key_schedule_t *ks,
+     const gift128b_key_schedule_t * const *keys, unsigned count)
+{
+    unsigned lane;
+#if GIFT128_VECTOR
+    gift128b_key_schedule_t temp;
+    unsigned index;
+#endif
+    ks->lanes = count;
+    for (lane = 0; lane < count; ++lane)
+        ks->keys[lane] = keys[lane];
+#if GIFT128_VECTOR
+    /* The padding lanes get a copy of the first key so that a kernel
+     * that extends past the last lane has valid round keys to work on */
+    for (lane = 0; lane < GIFT128_MAX_LANES; ++lane) {
+        const uint32_t *k = gift128b_expand_schedule
+            (keys[lane < count ? lane : 0], &temp)->k;
+        for (index = 0; index < GIFT128_ROUND_KEYS; ++index)
+            ks->k[index][lane] = k[index];
+    }
+#endif
+}
+
+void gift128b_encrypt_preloaded_multi
+    (const gift128b_multi_key_schedule_t *ks, uint32_t (*blocks)[4])
+{
+    unsigned lane;
+#if GIFT128_VECTOR
+    uint32_t words[GIFT128_MAX_LANES][4];
+    memcpy(words, blocks, ks->lanes * sizeof(words[0]));
+    if (gift128b_encrypt_words_multi(ks, words, 0) != 0) {
+        memcpy(blocks, words, ks->lanes * sizeof(words[0]));
+        return;
+    }
+#endif
+    for (lane = 0; lane < ks->lanes; ++lane)
+        gift128b_encrypt_preloaded(ks->keys[lane], blocks[lane], blocks[lane]);
+}
+
+void gift128b_encrypt_multi
+    (const gift128b_multi_key_schedule_t *ks, unsigned char *blocks)
+{
+    unsigned lane;
+#if GIFT128_VECTOR
+    uint32_t words[GIFT128_MAX_LANES][4];
+    for (lane = 0; lane < ks->lanes; ++lane) {
+        words[lane][0] = be_load_word32(blocks + lane * 16);
+        words[lane][1] = be_load_word32(blocks + lane * 16 + 4);
+        words[lane][2] = be_load_word32(blocks + lane * 16 + 8);
+        words[lane][3] = be_load_word32(blocks + lane * 16 + 12);
+    }
+    if (gift128b_encrypt_words_multi(ks, words, 0) != 0) {
+        for (lane = 0; lane < ks->lanes; ++lane) {
+            be_store_word32(blocks + lane * 16,      words[lane][0]);
+            be_store_word32(blocks + lane * 16 + 4,  words[lane][1]);
+            be_store_word32(blocks + lane * 16 + 8,  words[lane][2]);
+            be_store_word32(blocks + lane * 16 + 12, words[lane][3]);
+        }
+        return;
+    }
+#endif
+    for (lane = 0; lane < ks->lanes; ++lane) {
+        gift128b_encrypt(ks->keys[lane], blocks + lane * 16,
+                         blocks + lane * 16);
+    }
+}
+
+void gift128t_encrypt_multi
+    (const gift128b_multi_key_schedule_t *ks, unsigned char *blocks,
+     uint32_t tweak)
+{
+    unsigned lane;
+#if GIFT128_VECTOR
+    uint32_t words[GIFT128_MAX_LANES][4];
+    unsigned char temp[16];
+    for (lane = 0; lane < ks->lanes; ++lane) {
+        gift128n_to_words(temp, blocks + lane * 16);
+        words[lane][0] = be_load_word32(temp);
+        words[lane][1] = be_load_word32(temp + 4);
+        words[lane][2] = be_load_word32(temp + 8);
+        words[lane][3] = be_load_word32(temp + 12);
+    }
+    if (gift128b_encrypt_words_multi(ks, words, tweak) != 0) {
+        for (lane = 0; lane < ks->lanes; ++lane) {
+            be_store_word32(temp,      words[lane][0]);
+            be_store_word32(temp + 4,  words[lane][1]);
+            be_store_word32(temp + 8,  words[lane][2]);
+            be_store_word32(temp + 12, words[lane][3]);
+            gift128n_to_nibbles(blocks + lane * 16, temp);
+        }
+        return;
+    }
+#endif
+    for (lane = 0; lane < ks->lanes; ++lane) {
+        gift128t_encrypt(ks->keys[lane], blocks + lane * 16,
+                         blocks + lane * 16, tweak);
+    }
+}
+
+const char *gift128_multi_block_variant(void)
+{
+#if defined(__AVX512F__) && GIFT128_VECTOR
+    return "AVX-512";
+#elif GIFT128_SIMD_DISPATCH && GIFT128_VECTOR
+    static const char * const names[] = {"C", "AVX2", "AVX-512"};
+#if GIFT128_HAVE_X4
+    if (lw_simd_level() == LW_SIMD_LEVEL_C)
+        return "Vector";
+#endif
+    return names[lw_simd_level()];
+#elif defined(__AVX2__) && GIFT128_VECTOR
+    return "AVX2";
+#elif GIFT128_VECTOR
+    return "Vector";
+#else
+    return "C";
+#endif
+}
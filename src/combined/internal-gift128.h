@@ -51,6 +51,7 @@
  * https://giftcipher.github.io/gift/
  */
 
+#include "internal-util.h"
 #include <stddef.h>
 #include <stdint.h>
 #include "internal-gift128-config.h"
@@ -76,11 +77,32 @@ extern "C" {
 #define GIFT128_ROUND_KEYS 80
 #endif
 
+/**
+ * \brief Defined to 1 if the variant of the GIFT-128 key schedule can be
+ * chosen for each key at runtime with gift128b_init_variant().
+ *
+ * This is only possible with the full variant in C, which can expand a
+ * tiny key schedule into the full fixsliced form when it is used.
+ */
+#if GIFT128_VARIANT == GIFT128_VARIANT_FULL && !GIFT128_VARIANT_ASM && \
+        !defined(GIFT128_NO_VARIANT_RUNTIME)
+#define GIFT128_VARIANT_RUNTIME 1
+#else
+#define GIFT128_VARIANT_RUNTIME 0
+#endif
+
 /**
  * \brief Structure of the key schedule for GIFT-128 (bit-sliced).
  */
 typedef struct
 {
+#if GIFT128_VARIANT_RUNTIME
+    /** Variant of this key schedule, GIFT128_VARIANT_FULL or
+     *  GIFT128_VARIANT_TINY.  This comes first so that a tiny key
+     *  schedule can be stored in less memory than the full structure */
+    uint32_t variant;
+#endif
+
     /** Pre-computed round keys for bit-sliced GIFT-128 */
     uint32_t k[GIFT128_ROUND_KEYS];
 
@@ -239,6 +261,210 @@ void gift128t_decrypt
     (const gift128n_key_schedule_t *ks, unsigned char *output,
      const unsigned char *input, uint32_t tweak);
 
+/**
+ * \brief Gets the number of bytes that are needed to store a GIFT-128
+ * key schedule of a specific variant.
+ *
+ * \param variant GIFT128_VARIANT_FULL or GIFT128_VARIANT_TINY.
+ *
+ * \return The size of the key schedule in bytes.
+ *
+ * If GIFT128_VARIANT_RUNTIME is zero, then all key schedules have the
+ * variant that was selected at compile time and this function returns
+ * sizeof(gift128b_key_schedule_t) for every \a variant.
+ */
+size_t gift128b_key_schedule_size(int variant);
+
+/**
+ * \brief Initializes a GIFT-128 (bit-sliced) key schedule of a specific
+ * variant at runtime.
+ *
+ * \param ks Points to the key schedule to initialize, which must be at
+ * least gift128b_key_schedule_size(variant) bytes in length.
+ * \param key Points to the 16 bytes of the key data.
+ * \param variant GIFT128_VARIANT_FULL to pre-compute all of the fixsliced
+ * round keys, or GIFT128_VARIANT_TINY to store only the key and expand the
+ * round keys on the fly whenever the key schedule is used.
+ *
+ * The full variant suits long-lived keys that encrypt a lot of data and
+ * the tiny variant suits large numbers of keys that are used rarely.
+ * Both can be passed to all of the GIFT-128 functions in this file, and
+ * as the key context for the GIFT-COFB and SUNDAE-GIFT modes.
+ */
+void gift128b_init_variant
+    (gift128b_key_schedule_t *ks, const unsigned char *key, int variant);
+
+/**
+ * \brief Initializes a GIFT-128 (nibble-based) key schedule of a specific
+ * variant at runtime.
+ *
+ * \param ks Points to the key schedule to initialize, which must be at
+ * least gift128b_key_schedule_size(variant) bytes in length.
+ * \param key Points to the 16 bytes of the key data.
+ * \param variant GIFT128_VARIANT_FULL or GIFT128_VARIANT_TINY.
+ *
+ * The key schedule can be passed to all of the GIFT-128 nibble-based and
+ * TweGIFT-128 functions in this file, and as the key context for the
+ * ESTATE and HYENA modes.
+ */
+void gift128n_init_variant
+    (gift128n_key_schedule_t *ks, const unsigned char *key, int variant);
+
+/**
+ * \fn gift128b_expand_schedule
+ * \brief Expands a GIFT-128 key schedule into the full variant if necessary.
+ *
+ * \param ks Points to the key schedule to expand.
+ * \param temp Temporary key schedule to expand a tiny key schedule into.
+ *
+ * \return Either \a ks if it is already a full key schedule, or \a temp.
+ *
+ * Modes call this once per packet so that a tiny key schedule is only
+ * expanded once rather than for every block.
+ */
+#if GIFT128_VARIANT_RUNTIME
+const gift128b_key_schedule_t *gift128b_expand_schedule
+    (const gift128b_key_schedule_t *ks, gift128b_key_schedule_t *temp);
+#else
+#define gift128b_expand_schedule(ks, temp) ((void)(temp), (ks))
+#endif
+
+/**
+ * \brief Defined to 1 if the multi-block GIFT-128 kernels are selected at
+ * runtime according to the features of the CPU.
+ */
+#if LW_SIMD_DISPATCH && !defined(GIFT128_NO_SIMD_DISPATCH)
+#define GIFT128_SIMD_DISPATCH 1
+#else
+#define GIFT128_SIMD_DISPATCH 0
+#endif
+
+/**
+ * \brief Defined to 1 if the multi-block GIFT-128 kernels can be built
+ * with the vector extensions of GCC and clang.
+ *
+ * The kernels place one block in each 32-bit lane of a vector register
+ * and run the fixsliced rounds on all lanes at once.  They need the
+ * fully expanded key schedule, so they are only available with the
+ * full variant of GIFT-128 in C.
+ */
+#if !defined(__AVR__) && (defined(__GNUC__) || defined(__clang__)) && \
+        (defined(__SSE2__) || defined(__ARM_NEON) || defined(__ARM_NEON__) || \
+         GIFT128_SIMD_DISPATCH) && \
+        GIFT128_VARIANT == GIFT128_VARIANT_FULL && !GIFT128_VARIANT_ASM
+#define GIFT128_VECTOR 1
+#else
+#define GIFT128_VECTOR 0
+#endif
+
+/**
+ * \brief Number of blocks that are processed in parallel by the widest
+ * multi-block GIFT-128 kernel available on this platform.
+ *
+ * Modes that chain every block to the one before, such as GIFT-COFB,
+ * use this to decide how many independent packets to process in lock-step.
+ */
+#if GIFT128_VECTOR && (defined(__AVX512F__) || GIFT128_SIMD_DISPATCH)
+#define GIFT128_MAX_LANES 16
+#elif GIFT128_VECTOR && defined(__AVX2__)
+#define GIFT128_MAX_LANES 8
+#elif GIFT128_VECTOR
+#define GIFT128_MAX_LANES 4
+#else
+#define GIFT128_MAX_LANES 1
+#endif
+
+/**
+ * \brief Key schedules for encrypting up to GIFT128_MAX_LANES blocks
+ * in parallel, one block per key.
+ *
+ * The same key can appear in more than one lane.
+ */
+typedef struct
+{
+    /** Key schedules for the lanes */
+    const gift128b_key_schedule_t *keys[GIFT128_MAX_LANES];
+
+#if GIFT128_VECTOR
+    /** Round keys for all lanes, transposed so that a vector kernel can
+     *  load round key i for a run of lanes from k[i] in one operation */
+    uint32_t k[GIFT128_ROUND_KEYS][GIFT128_MAX_LANES];
+#endif
+
+    /** Number of lanes that are in use */
+    unsigned lanes;
+
+} gift128b_multi_key_schedule_t;
+
+/**
+ * \brief Initializes a multi-block key schedule for GIFT-128.
+ *
+ * \param ks Points to the multi-block key schedule to initialize.
+ * \param keys Points to the key schedules for each of the lanes.
+ * \param count Number of lanes, between 1 and GIFT128_MAX_LANES.
+ *
+ * The key schedules in \a keys must remain valid while \a ks is in use.
+ */
+void gift128b_multi_init
+    (gift128b_multi_key_schedule_t *ks,
+     const gift128b_key_schedule_t * const *keys, unsigned count);
+
+/**
+ * \brief Encrypts one pre-loaded block per lane with GIFT-128 (bit-sliced).
+ *
+ * \param ks Points to the multi-block key schedule.
+ * \param blocks The blocks to encrypt in-place, one per lane.
+ *
+ * The result is the same as calling gift128b_encrypt_preloaded() on
+ * each block with the key schedule for its lane.
+ */
+void gift128b_encrypt_preloaded_multi
+    (const gift128b_multi_key_schedule_t *ks, uint32_t (*blocks)[4]);
+
+/**
+ * \brief Encrypts one block per lane with GIFT-128 (bit-sliced).
+ *
+ * \param ks Points to the multi-block key schedule.
+ * \param blocks The blocks to encrypt in-place, 16 bytes per lane.
+ *
+ * The result is the same as calling gift128b_encrypt() on each block
+ * with the key schedule for its lane.
+ */
+void gift128b_encrypt_multi
+    (const gift128b_multi_key_schedule_t *ks, unsigned char *blocks);
+
+/**
+ * \brief Encrypts one block per lane with TweGIFT-128 (tweakable variant).
+ *
+ * \param ks Points to the multi-block key schedule.
+ * \param blocks The blocks to encrypt in-place, 16 bytes per lane.
+ * \param tweak 4-bit tweak value expanded to 32-bit, the same for all lanes.
+ *
+ * The result is the same as calling gift128t_encrypt() on each block
+ * with the key schedule for its lane.
+ */
+void gift128t_encrypt_multi
+    (const gift128b_multi_key_schedule_t *ks, unsigned char *blocks,
+     uint32_t tweak);
+
+/**
+ * \brief Encrypts one block per lane with GIFT-128 (nibble-based).
+ *
+ * \param ks Points to the multi-block key schedule.
+ * \param blocks The blocks to encrypt in-place, 16 bytes per lane.
+ */
+#define gift128n_encrypt_multi(ks, blocks) \
+    gift128t_encrypt_multi((ks), (blocks), GIFT128T_TWEAK_0)
+
+/**
+ * \brief Gets the name of the multi-block kernel that is in use.
+ *
+ * \return One of "AVX-512", "AVX2", "Vector", or "C".
+ *
+ * This function is intended for tests and benchmarks.
+ */
+const char *gift128_multi_block_variant(void);
+
 #ifdef __cplusplus
 }
 #endif
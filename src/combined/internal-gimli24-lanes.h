@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2020 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* Multi-state GIMLI-24 kernels.  We expect a number of macros to be
+ * defined before each inclusion of this file to configure a kernel:
+ *
+ * GIMLI24_LANES_SUFFIX     Suffix to append to the kernel name; e.g. _x4.
+ * GIMLI24_LANES            Number of states that are permuted in parallel.
+ * GIMLI24_LANES_TARGET     Function attributes for the kernel, such as
+ *                          the instruction set to compile it for.
+ *
+ * The kernel places one state in each 32-bit lane of a vector.  The small
+ * and big swaps become renames of the vector registers, so each round is
+ * nothing more than the SP-box on twelve vectors.
+ */
+
+#if defined(GIMLI24_LANES_SUFFIX)
+
+#define GIMLI24_CONCAT_INNER(name,suffix) name##suffix
+#define GIMLI24_CONCAT(name,suffix) GIMLI24_CONCAT_INNER(name,suffix)
+#define GIMLI24_VEC_T GIMLI24_CONCAT(gimli24_vec,GIMLI24_LANES_SUFFIX)
+#define GIMLI24_SET_T GIMLI24_CONCAT(gimli24_set,GIMLI24_LANES_SUFFIX)
+
+/* Vector type with one 32-bit lane per state */
+typedef uint32_t GIMLI24_VEC_T
+    __attribute__((vector_size(GIMLI24_LANES * 4)));
+
+/* Words of all states, as vectors or as individual words */
+typedef union
+{
+    GIMLI24_VEC_T v[12];
+    uint32_t w[12][GIMLI24_LANES];
+
+} GIMLI24_SET_T;
+
+/* Apply the SP-box to a column of all states */
+#define gimli24_vec_rotl(x, bits) (((x) << (bits)) | ((x) >> (32 - (bits))))
+#define GIMLI24_VEC_SP(s0, s4, s8) \
+    do { \
+        x = gimli24_vec_rotl(s0, 24); \
+        y = gimli24_vec_rotl(s4, 9); \
+        s4 = y ^ x ^ ((x | s8) << 1); \
+        s0 = s8 ^ y ^ ((x & y) << 3); \
+        s8 = x ^ (s8 << 1) ^ ((y & s8) << 2); \
+    } while (0)
+
+/**
+ * \brief Permutes up to GIMLI24_LANES GIMLI-24 states in parallel.
+ *
+ * \param states Points to the states to be permuted, in little-endian
+ * byte order.
+ * \param count Number of states to permute, between 1 and GIMLI24_LANES.
+ */
+static GIMLI24_LANES_TARGET void GIMLI24_CONCAT
+    (gimli24_permute_lanes,GIMLI24_LANES_SUFFIX)
+    (uint32_t (*states)[12], unsigned count)
+{
+    GIMLI24_SET_T set;
+    GIMLI24_VEC_T s0, s1, s2, s3, s4,  s5;
+    GIMLI24_VEC_T s6, s7, s8, s9, s10, s11;
+    GIMLI24_VEC_T x, y;
+    unsigned lane, posn, round;
+
+    /* Transpose the states so that each vector holds one word of every
+     * state.  Unused lanes are zeroed and then discarded at the end */
+    if (count < GIMLI24_LANES)
+        memset(&set, 0, sizeof(set));
+    for (lane = 0; lane < count; ++lane) {
+        for (posn = 0; posn < 12; ++posn) {
+#if defined(LW_UTIL_LITTLE_ENDIAN)
+            set.w[posn][lane] = states[lane][posn];
+#else
+            set.w[posn][lane] = le_load_word32
+                ((const unsigned char *)(&(states[lane][posn])));
+#endif
+        }
+    }
+    s0  = set.v[0];
+    s1  = set.v[1];
+    s2  = set.v[2];
+    s3  = set.v[3];
+    s4  = set.v[4];
+    s5  = set.v[5];
+    s6  = set.v[6];
+    s7  = set.v[7];
+    s8  = set.v[8];
+    s9  = set.v[9];
+    s10 = set.v[10];
+    s11 = set.v[11];
+
+    /* Unroll and perform the rounds 4 at a time */
+    for (round = 24; round > 0; round -= 4) {
+        /* Round 0: SP-box, small swap, add round constant */
+        GIMLI24_VEC_SP(s0, s4, s8);
+        GIMLI24_VEC_SP(s1, s5, s9);
+        GIMLI24_VEC_SP(s2, s6, s10);
+        GIMLI24_VEC_SP(s3, s7, s11);
+        x = s0;
+        y = s2;
+        s0 = s1 ^ (0x9e377900U ^ round);
+        s1 = x;
+        s2 = s3;
+        s3 = y;
+
+        /* Round 1: SP-box only */
+        GIMLI24_VEC_SP(s0, s4, s8);
+        GIMLI24_VEC_SP(s1, s5, s9);
+        GIMLI24_VEC_SP(s2, s6, s10);
+        GIMLI24_VEC_SP(s3, s7, s11);
+
+        /* Round 2: SP-box, big swap */
+        GIMLI24_VEC_SP(s0, s4, s8);
+        GIMLI24_VEC_SP(s1, s5, s9);
+        GIMLI24_VEC_SP(s2, s6, s10);
+        GIMLI24_VEC_SP(s3, s7, s11);
+        x = s0;
+        y = s1;
+        s0 = s2;
+        s1 = s3;
+        s2 = x;
+        s3 = y;
+
+        /* Round 3: SP-box only */
+        GIMLI24_VEC_SP(s0, s4, s8);
+        GIMLI24_VEC_SP(s1, s5, s9);
+        GIMLI24_VEC_SP(s2, s6, s10);
+        GIMLI24_VEC_SP(s3, s7, s11);
+    }
+
+    /* Transpose the words back into the states */
+    set.v[0]  = s0;
+    set.v[1]  = s1;
+    set.v[2]  = s2;
+    set.v[3]  = s3;
+    set.v[4]  = s4;
+    set.v[5]  = s5;
+    set.v[6]  = s6;
+    set.v[7]  = s7;
+    set.v[8]  = s8;
+    set.v[9]  = s9;
+    set.v[10] = s10;
+    set.v[11] = s11;
+    for (lane = 0; lane < count; ++lane) {
+        for (posn = 0; posn < 12; ++posn) {
+#if defined(LW_UTIL_LITTLE_ENDIAN)
+            states[lane][posn] = set.w[posn][lane];
+#else
+            le_store_word32((unsigned char *)(&(states[lane][posn])),
+                            set.w[posn][lane]);
+#endif
+        }
+    }
+}
+
+#undef gimli24_vec_rotl
+#undef GIMLI24_VEC_SP
+
+#endif /* GIMLI24_LANES_SUFFIX */
+
+/* Now undefine everything so that we can include this file again for
+ * another kernel width */
+#undef GIMLI24_LANES_SUFFIX
+#undef GIMLI24_LANES
+#undef GIMLI24_LANES_TARGET
+#undef GIMLI24_CONCAT_INNER
+#undef GIMLI24_CONCAT
+#undef GIMLI24_VEC_T
+#undef GIMLI24_SET_T
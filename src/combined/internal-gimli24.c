@@ -21,6 +21,7 @@
  */
 
 #include "internal-gimli24.h"
+#include <string.h>
 
 #if defined(__AVR__)
 #define GIMLI24_ASM 1
@@ -30,7 +31,78 @@
 #define GIMLI24_ASM 0
 #endif
 
-#if !GIMLI24_ASM
+/* Use the vector kernel for single states if the vector unit is available;
+ * it keeps the four columns of each row of the state in one vector */
+#if !GIMLI24_ASM && GIMLI24_HAVE_X4 && defined(LW_UTIL_LITTLE_ENDIAN)
+#define GIMLI24_ROW_VECTOR 1
+#else
+#define GIMLI24_ROW_VECTOR 0
+#endif
+
+#if GIMLI24_ROW_VECTOR
+
+/** @cond gimli24_row_vector */
+
+/* Vector with one 32-bit lane for each column of the state */
+typedef uint32_t gimli24_row_t __attribute__((vector_size(16)));
+
+/* Rearrange the columns within a row */
+#if defined(__clang__)
+#define gimli24_row_shuffle(x, i0, i1, i2, i3) \
+    __builtin_shufflevector((x), (x), i0, i1, i2, i3)
+#else
+#define gimli24_row_shuffle(x, i0, i1, i2, i3) \
+    __builtin_shuffle((x), (gimli24_row_t){i0, i1, i2, i3})
+#endif
+
+/* Apply the SP-box to all columns of the state at once */
+#define gimli24_row_rotl(x, bits) (((x) << (bits)) | ((x) >> (32 - (bits))))
+#define GIMLI24_ROW_SP() \
+    do { \
+        x = gimli24_row_rotl(r0, 24); \
+        y = gimli24_row_rotl(r1, 9); \
+        r1 = y ^ x ^ ((x | r2) << 1); \
+        r0 = r2 ^ y ^ ((x & y) << 3); \
+        r2 = x ^ (r2 << 1) ^ ((y & r2) << 2); \
+    } while (0)
+
+/** @endcond */
+
+void gimli24_permute(uint32_t state[12])
+{
+    gimli24_row_t r0, r1, r2, x, y;
+    unsigned round;
+
+    /* Load the rows of the state; the host is known to be little-endian */
+    memcpy(&r0, state, sizeof(r0));
+    memcpy(&r1, state + 4, sizeof(r1));
+    memcpy(&r2, state + 8, sizeof(r2));
+
+    /* Unroll and perform the rounds 4 at a time */
+    for (round = 24; round > 0; round -= 4) {
+        /* Round 0: SP-box, small swap, add round constant */
+        GIMLI24_ROW_SP();
+        r0 = gimli24_row_shuffle(r0, 1, 0, 3, 2) ^
+             (gimli24_row_t){0x9e377900U ^ round, 0, 0, 0};
+
+        /* Round 1: SP-box only */
+        GIMLI24_ROW_SP();
+
+        /* Round 2: SP-box, big swap */
+        GIMLI24_ROW_SP();
+        r0 = gimli24_row_shuffle(r0, 2, 3, 0, 1);
+
+        /* Round 3: SP-box only */
+        GIMLI24_ROW_SP();
+    }
+
+    /* Store the rows back into the state */
+    memcpy(state, &r0, sizeof(r0));
+    memcpy(state + 4, &r1, sizeof(r1));
+    memcpy(state + 8, &r2, sizeof(r2));
+}
+
+#elif !GIMLI24_ASM
 
 /* Apply the SP-box to a specific column in the state array */
 #define GIMLI24_SP(s0, s4, s8) \
@@ -148,3 +220,94 @@ void gimli24_permute(uint32_t state[12])
 }
 
 #endif /* !GIMLI24_ASM */
+
+/* 4-state kernel for 128-bit vector units */
+#if GIMLI24_HAVE_X4
+#define GIMLI24_LANES_SUFFIX _x4
+#define GIMLI24_LANES 4
+#define GIMLI24_LANES_TARGET
+#include "internal-gimli24-lanes.h"
+#endif
+
+/* 8-state kernel for AVX2 */
+#if GIMLI24_HAVE_X8
+#define GIMLI24_LANES_SUFFIX _x8
+#define GIMLI24_LANES 8
+#if defined(__AVX2__)
+#define GIMLI24_LANES_TARGET
+#else
+#define GIMLI24_LANES_TARGET LW_TARGET_AVX2
+#endif
+#include "internal-gimli24-lanes.h"
+#endif
+
+/**
+ * \brief Determine if the 8-state kernel can be used on this CPU.
+ */
+#if GIMLI24_SIMD_DISPATCH && !defined(__AVX2__)
+#define gimli24_can_use_x8() (lw_simd_level() >= LW_SIMD_LEVEL_AVX2)
+#else
+#define gimli24_can_use_x8() (GIMLI24_HAVE_X8)
+#endif
+
+void gimli24_permute_x4(uint32_t states[4][12])
+{
+#if GIMLI24_HAVE_X4
+    gimli24_permute_lanes_x4(states, 4);
+#else
+    gimli24_permute(states[0]);
+    gimli24_permute(states[1]);
+    gimli24_permute(states[2]);
+    gimli24_permute(states[3]);
+#endif
+}
+
+void gimli24_permute_x8(uint32_t states[8][12])
+{
+#if GIMLI24_HAVE_X8
+    if (gimli24_can_use_x8()) {
+        gimli24_permute_lanes_x8(states, 8);
+        return;
+    }
+#endif
+    gimli24_permute_x4(states);
+    gimli24_permute_x4(states + 4);
+}
+
+void gimli24_permute_n(uint32_t (*states)[12], unsigned count)
+{
+#if GIMLI24_HAVE_X8
+    unsigned n;
+    if (gimli24_can_use_x8()) {
+        while (count > 4) {
+            n = (count < 8) ? count : 8;
+            gimli24_permute_lanes_x8(states, n);
+            states += n;
+            count -= n;
+        }
+    }
+#endif
+#if GIMLI24_HAVE_X4
+    /* Fewer than four states are faster with the single-state kernel */
+    while (count >= 4) {
+        gimli24_permute_lanes_x4(states, 4);
+        states += 4;
+        count -= 4;
+    }
+#endif
+    while (count > 0) {
+        gimli24_permute(states[0]);
+        ++states;
+        --count;
+    }
+}
+
+const char *gimli24_multi_variant(void)
+{
+    if (gimli24_can_use_x8())
+        return "AVX2";
+    else if (GIMLI24_HAVE_X4)
+        return "Vector";
+    else
+        return "C";
+}
@@ -45,6 +45,94 @@ extern "C" {
  */
 void gimli24_permute(uint32_t state[12]);
 
+/**
+ * \brief Defined to 1 if the multi-state GIMLI-24 kernels are selected
+ * at runtime according to the features of the CPU.
+ */
+#if LW_SIMD_DISPATCH && !defined(GIMLI24_NO_SIMD_DISPATCH)
+#define GIMLI24_SIMD_DISPATCH 1
+#else
+#define GIMLI24_SIMD_DISPATCH 0
+#endif
+
+/**
+ * \brief Defined to 1 if there are vector kernels for the baseline
+ * 128-bit vector unit; SSE2 or NEON.
+ *
+ * This covers both the 4-state kernel and the single-state kernel that
+ * keeps the four columns of the state in the lanes of a vector.
+ */
+#if !defined(__AVR__) && (defined(__GNUC__) || defined(__clang__)) && \
+        (defined(__SSE2__) || defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define GIMLI24_HAVE_X4 1
+#else
+#define GIMLI24_HAVE_X4 0
+#endif
+
+/**
+ * \brief Defined to 1 if there is an 8-state GIMLI-24 kernel for AVX2.
+ */
+#if (defined(__GNUC__) || defined(__clang__)) && \
+        (defined(__AVX2__) || GIMLI24_SIMD_DISPATCH)
+#define GIMLI24_HAVE_X8 1
+#else
+#define GIMLI24_HAVE_X8 0
+#endif
+
+/**
+ * \brief Maximum number of GIMLI-24 states that are permuted in parallel
+ * by the widest multi-state kernel available on this platform.
+ */
+#if GIMLI24_HAVE_X8
+#define GIMLI24_MAX_LANES 8
+#elif GIMLI24_HAVE_X4
+#define GIMLI24_MAX_LANES 4
+#else
+#define GIMLI24_MAX_LANES 1
+#endif
+
+/**
+ * \brief Permutes four GIMLI-24 states in parallel.
+ *
+ * \param states Points to the four states, which are assumed to be
+ * in little-endian byte order.
+ *
+ * Each of the twelve words of the states is placed in a 32-bit lane
+ * of a 128-bit vector so that the four permutations run side by side.
+ * Platforms without a suitable vector unit permute the states one
+ * at a time.
+ */
+void gimli24_permute_x4(uint32_t states[4][12]);
+
+/**
+ * \brief Permutes eight GIMLI-24 states in parallel.
+ *
+ * \param states Points to the eight states, which are assumed to be
+ * in little-endian byte order.
+ *
+ * This uses 256-bit vectors if the CPU supports AVX2, or two calls
+ * to gimli24_permute_x4() otherwise.
+ */
+void gimli24_permute_x8(uint32_t states[8][12]);
+
+/**
+ * \brief Permutes several GIMLI-24 states.
+ *
+ * \param states Points to an array of states to be permuted, which are
+ * assumed to be in little-endian byte order.
+ * \param count Number of states in the array.
+ *
+ * The states are processed up to GIMLI24_MAX_LANES at a time.
+ */
+void gimli24_permute_n(uint32_t (*states)[12], unsigned count);
+
+/**
+ * \brief Gets the name of the multi-state GIMLI-24 kernels that are in use.
+ *
+ * \return One of "AVX2", "Vector", or "C".
+ */
+const char *gimli24_multi_variant(void);
+
 #ifdef __cplusplus
 }
 #endif
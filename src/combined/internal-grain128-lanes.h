@@ -0,0 +1,260 @@
+/*
+ * Copyright (C) 2020 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+/* We expect a number of macros to be defined before this file
+ * is included to configure the bit-sliced multi-session Grain-128 kernel:
+ *
+ * GRAIN128_LANES_SUFFIX    Suffix to append to the kernel name; e.g. _x128.
+ * GRAIN128_LANES           Number of sessions that are run in parallel.
+ * GRAIN128_LANES_TARGET    Function attributes for the kernel, such as
+ *                          the instruction set to compile it for.
+ *
+ * Each bit of a vector holds the state of a different session, so every
+ * clock of the registers is the same handful of logical operations as
+ * a single clock of one session.  The first GRAIN128_LANES / 64 words of
+ * each row of a grain128_multi_state_t are loaded into the vectors.
+ */
+#if defined(GRAIN128_LANES_SUFFIX)
+
+#define GRAIN128_CONCAT_INNER(name,suffix) name##suffix
+#define GRAIN128_CONCAT(name,suffix) GRAIN128_CONCAT_INNER(name,suffix)
+#define GRAIN128_VEC_T GRAIN128_CONCAT(grain128_vec,GRAIN128_LANES_SUFFIX)
+#define grain128_vec_load GRAIN128_CONCAT(grain128_vec_load,GRAIN128_LANES_SUFFIX)
+#define grain128_vec_store GRAIN128_CONCAT(grain128_vec_store,GRAIN128_LANES_SUFFIX)
+#define grain128_vec_clock GRAIN128_CONCAT(grain128_vec_clock,GRAIN128_LANES_SUFFIX)
+
+/* Vector type with one session per bit */
+typedef uint64_t GRAIN128_VEC_T __attribute__((vector_size(GRAIN128_LANES / 8)));
+
+/* Loads and stores rows of the bit-sliced state */
+static GRAIN128_LANES_TARGET inline GRAIN128_VEC_T grain128_vec_load
+    (const uint64_t *row)
+{
+    GRAIN128_VEC_T x;
+    memcpy(&x, row, sizeof(x));
+    return x;
+}
+static GRAIN128_LANES_TARGET inline void grain128_vec_store
+    (uint64_t *row, GRAIN128_VEC_T x)
+{
+    memcpy(row, &x, sizeof(x));
+}
+
+/**
+ * \brief Clocks the registers of all sessions once.
+ *
+ * \param state Multi-session Grain-128 state.
+ * \param x Bits to add to the LFSR feedback, or zero.
+ * \param x2 Bits to add to the NFSR feedback, or zero.
+ * \param feedback Non-zero to also add the pre-output to the feedback
+ * of both registers, as is done during initialization.
+ *
+ * \return The pre-output bits for the clock.
+ */
+static GRAIN128_LANES_TARGET inline GRAIN128_VEC_T grain128_vec_clock
+    (grain128_multi_state_t *state, GRAIN128_VEC_T x, GRAIN128_VEC_T x2,
+     int feedback)
+{
+    uint64_t (*s)[GRAIN128_MULTI_WORDS] = state->lfsr + state->posn;
+    uint64_t (*b)[GRAIN128_MULTI_WORDS] = state->nfsr + state->posn;
+    GRAIN128_VEC_T y, b12, b95;
+
+    /* See grain128_core() and grain128_preoutput() for the bit-level
+     * details of the feedback functions and the pre-output */
+    #define S(i) grain128_vec_load(s[(i)])
+    #define B(i) grain128_vec_load(b[(i)])
+    b12 = B(12);
+    b95 = B(95);
+    y = (b12 & S(8)) ^ (S(13) & S(20)) ^ (b95 & S(42)) ^
+        (S(60) & S(79)) ^ (b12 & b95 & S(94)) ^ S(93) ^
+        B(2) ^ B(15) ^ B(36) ^ B(45) ^ B(64) ^ B(73) ^ B(89);
+    if (feedback) {
+        x ^= y;
+        x2 ^= y;
+    }
+    x ^= S(0) ^ S(7) ^ S(38) ^ S(70) ^ S(81) ^ S(96);
+    x2 ^= S(0) ^ B(0) ^ B(26) ^ B(56) ^ B(91) ^ B(96) ^
+          (B(3) & B(67)) ^ (B(11) & B(13)) ^ (B(17) & B(18)) ^
+          (B(27) & B(59)) ^ (B(40) & B(48)) ^ (B(61) & B(65)) ^
+          (B(68) & B(84)) ^ (B(22) & B(24) & B(25)) ^
+          (B(70) & B(78) & B(82)) ^ (B(88) & B(92) & B(93) & b95);
+    #undef S
+    #undef B
+    grain128_vec_store(s[128], x);
+    grain128_vec_store(b[128], x2);
+
+    /* Shift the registers down once the slack at the end is used up */
+    if (++(state->posn) == GRAIN128_MULTI_SLACK) {
+        memmove(state->lfsr, state->lfsr + GRAIN128_MULTI_SLACK,
+                128 * sizeof(state->lfsr[0]));
+        memmove(state->nfsr, state->nfsr + GRAIN128_MULTI_SLACK,
+                128 * sizeof(state->nfsr[0]));
+        state->posn = 0;
+    }
+    return y;
+}
+
+/**
+ * \brief Transposes the 64 x 64 bit matrices in the words of 64 rows.
+ *
+ * \param rows The rows to transpose in-place.  Bit j of word w in row i
+ * is swapped with bit i of word w in row j.
+ *
+ * This converts 8 bytes of data for each session into bit-sliced form,
+ * and back again.
+ */
+static GRAIN128_LANES_TARGET void GRAIN128_CONCAT
+    (grain128_multi_transpose,GRAIN128_LANES_SUFFIX)
+    (uint64_t (*rows)[GRAIN128_MULTI_WORDS])
+{
+    GRAIN128_VEC_T a[64];
+    GRAIN128_VEC_T t;
+    uint64_t mask = 0x00000000FFFFFFFFULL;
+    unsigned j, k;
+    for (k = 0; k < 64; ++k)
+        a[k] = grain128_vec_load(rows[k]);
+    for (j = 32; j != 0; j >>= 1, mask ^= (mask << j)) {
+        for (k = 0; k < 64; k = ((k | j) + 1) & ~j) {
+            t = ((a[k] >> j) ^ a[k | j]) & mask;
+            a[k] ^= t << j;
+            a[k | j] ^= t;
+        }
+    }
+    for (k = 0; k < 64; ++k)
+        grain128_vec_store(rows[k], a[k]);
+}
+
+/**
+ * \brief Runs the initialization clocks for all sessions, after the key
+ * and nonce have been loaded into the registers.
+ *
+ * \param state Multi-session Grain-128 state.
+ */
+static GRAIN128_LANES_TARGET void GRAIN128_CONCAT
+    (grain128_multi_init,GRAIN128_LANES_SUFFIX)
+    (grain128_multi_state_t *state)
+{
+    GRAIN128_VEC_T key[128];
+    GRAIN128_VEC_T zero = {0};
+    unsigned round;
+
+    /* The key is added to the LFSR again after the first 256 clocks */
+    for (round = 0; round < 128; ++round)
+        key[round] = grain128_vec_load(state->nfsr[round]);
+
+    /* Perform 256 clocks with the pre-output fed back into the registers */
+    state->posn = 0;
+    for (round = 0; round < 256; ++round)
+        grain128_vec_clock(state, zero, zero, 1);
+
+    /* Absorb the key into the LFSR while generating the initial state
+     * of the accumulator and then the shift register */
+    for (round = 0; round < 64; ++round) {
+        grain128_vec_store
+            (state->accum[round],
+             grain128_vec_clock(state, key[round], zero, 0));
+    }
+    for (round = 0; round < 64; ++round) {
+        grain128_vec_store
+            (state->sr[round],
+             grain128_vec_clock(state, key[round + 64], zero, 0));
+    }
+}
+
+/**
+ * \brief Encrypts or decrypts, and authenticates, up to 64 bits of
+ * bit-sliced data for all sessions.
+ *
+ * \param state Multi-session Grain-128 state.
+ * \param data Bit-sliced data, one row per bit, which is replaced with
+ * the ciphertext or plaintext if \a mode is not GRAIN128_MULTI_AUTH.
+ * \param nbits Number of bits in \a data, between 1 and 64.
+ * \param mode One of GRAIN128_MULTI_AUTH, GRAIN128_MULTI_ENCRYPT, or
+ * GRAIN128_MULTI_DECRYPT.
+ */
+static GRAIN128_LANES_TARGET void GRAIN128_CONCAT
+    (grain128_multi_bits,GRAIN128_LANES_SUFFIX)
+    (grain128_multi_state_t *state, uint64_t (*data)[GRAIN128_MULTI_WORDS],
+     unsigned nbits, int mode)
+{
+    GRAIN128_VEC_T m[64];
+    GRAIN128_VEC_T z[128];
+    GRAIN128_VEC_T zero = {0};
+    GRAIN128_VEC_T z0, mbit, a0, a1, a2, a3;
+    unsigned bit, index;
+
+    /* Generate two bits of keystream for every bit of data.  The even
+     * bits encrypt and the odd bits are shifted into the register */
+    for (bit = 0; bit < nbits; ++bit) {
+        m[bit] = grain128_vec_load(data[bit]);
+        z0 = grain128_vec_clock(state, zero, zero, 0);
+        z[bit + 64] = grain128_vec_clock(state, zero, zero, 0);
+        if (mode == GRAIN128_MULTI_ENCRYPT) {
+            grain128_vec_store(data[bit], m[bit] ^ z0);
+        } else if (mode == GRAIN128_MULTI_DECRYPT) {
+            m[bit] ^= z0;
+            grain128_vec_store(data[bit], m[bit]);
+        }
+    }
+
+    /* For every plaintext bit that is 1, XOR the shift register into the
+     * accumulator.  Bit j of the shift register when authenticating data
+     * bit i is bit i + j of the shift register followed by the odd bits */
+    for (index = 0; index < 64; ++index)
+        z[index] = grain128_vec_load(state->sr[index]);
+    for (index = 0; index < 64; index += 4) {
+        /* Update four bits of the accumulator at a time so that each
+         * data bit is loaded once for all four */
+        a0 = grain128_vec_load(state->accum[index]);
+        a1 = grain128_vec_load(state->accum[index + 1]);
+        a2 = grain128_vec_load(state->accum[index + 2]);
+        a3 = grain128_vec_load(state->accum[index + 3]);
+        for (bit = 0; bit < nbits; ++bit) {
+            mbit = m[bit];
+            a0 ^= z[bit + index] & mbit;
+            a1 ^= z[bit + index + 1] & mbit;
+            a2 ^= z[bit + index + 2] & mbit;
+            a3 ^= z[bit + index + 3] & mbit;
+        }
+        grain128_vec_store(state->accum[index], a0);
+        grain128_vec_store(state->accum[index + 1], a1);
+        grain128_vec_store(state->accum[index + 2], a2);
+        grain128_vec_store(state->accum[index + 3], a3);
+    }
+    for (index = 0; index < 64; ++index)
+        grain128_vec_store(state->sr[index], z[index + nbits]);
+}
+
+#endif /* GRAIN128_LANES_SUFFIX */
+
+/* Now undefine everything so that we can include this file again for
+ * another kernel width */
+#undef GRAIN128_LANES_SUFFIX
+#undef GRAIN128_LANES
+#undef GRAIN128_LANES_TARGET
+#undef GRAIN128_CONCAT_INNER
+#undef GRAIN128_CONCAT
+#undef GRAIN128_VEC_T
+#undef grain128_vec_load
+#undef grain128_vec_store
+#undef grain128_vec_clock
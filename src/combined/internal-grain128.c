@@ -21,6 +21,7 @@
  */
 
 #include "internal-grain128.h"
+#include <string.h>
 
 /* Determine which primitives should be accelerated with assembly code */
 #if defined(__AVR__)
@@ -33,6 +34,183 @@
 #define GRAIN128_ASM_HELPERS 0
 #endif
 
+#if GRAIN128_WORD64
+
+/* Extracts the 32 bits starting at "start_bit" from a 64-bit word of the
+ * Grain state that starts at bit "word_start".  The 32 bits must be
+ * entirely contained within the 64-bit word */
+#define GWORD64(word, word_start, start_bit) \
+        ((uint32_t)((word) >> ((word_start) + 32 - (start_bit))))
+
+/* Within the functions below, s0, sm, and s1 are the LFSR bits 0..63,
+ * 32..95, and 64..127.  Similarly, b0, bm, and b1 are the NFSR bits.
+ * Every 32-bit tap is then a single shift of one of these words */
+
+/* Computes 32 bits of LFSR feedback into x; see grain128_core() below */
+#define grain128_lfsr_feedback(x) \
+    do { \
+        (x) ^= GWORD64(s0, 0, 0);           /* s[0] */ \
+        (x) ^= GWORD64(s0, 0, 7);           /* s[7] */ \
+        (x) ^= GWORD64(sm, 32, 38);         /* s[38] */ \
+        (x) ^= GWORD64(s1, 64, 70);         /* s[70] */ \
+        (x) ^= GWORD64(s1, 64, 81);         /* s[81] */ \
+        (x) ^= GWORD64(s1, 64, 96);         /* s[96] */ \
+    } while (0)
+
+/* Computes 32 bits of NFSR feedback into x2 */
+#define grain128_nfsr_feedback(x2) \
+    do { \
+        (x2) ^= GWORD64(s0, 0, 0);                          /* s[0] */ \
+        (x2) ^= GWORD64(b0, 0, 0);                          /* b[0] */ \
+        (x2) ^= GWORD64(b0, 0, 26);                         /* b[26] */ \
+        (x2) ^= GWORD64(bm, 32, 56);                        /* b[56] */ \
+        (x2) ^= GWORD64(b1, 64, 91);                        /* b[91] */ \
+        (x2) ^= GWORD64(b1, 64, 96);                        /* b[96] */ \
+        (x2) ^= GWORD64(b0, 0, 3) & GWORD64(b1, 64, 67);    /* b[3] & b[67] */ \
+        (x2) ^= GWORD64(b0, 0, 11) & GWORD64(b0, 0, 13);    /* b[11] & b[13] */ \
+        (x2) ^= GWORD64(b0, 0, 17) & GWORD64(b0, 0, 18);    /* b[17] & b[18] */ \
+        (x2) ^= GWORD64(b0, 0, 27) & GWORD64(bm, 32, 59);   /* b[27] & b[59] */ \
+        (x2) ^= GWORD64(bm, 32, 40) & GWORD64(bm, 32, 48);  /* b[40] & b[48] */ \
+        (x2) ^= GWORD64(bm, 32, 61) & GWORD64(b1, 64, 65);  /* b[61] & b[65] */ \
+        (x2) ^= GWORD64(b1, 64, 68) & GWORD64(b1, 64, 84);  /* b[68] & b[84] */ \
+        (x2) ^= GWORD64(b0, 0, 22) & GWORD64(b0, 0, 24) &   /* b[22] & b[24] */ \
+                GWORD64(b0, 0, 25);                         /* & b[25] */ \
+        (x2) ^= GWORD64(b1, 64, 70) & GWORD64(b1, 64, 78) & /* b[70] & b[78] */ \
+                GWORD64(b1, 64, 82);                        /* & b[82] */ \
+        (x2) ^= GWORD64(b1, 64, 88) & GWORD64(b1, 64, 92) & /* b[88] & b[92] */ \
+                GWORD64(b1, 64, 93) & GWORD64(b1, 64, 95);  /* & b[93] & b[95] */ \
+    } while (0)
+
+/* Computes 32 bits of pre-output into y; see grain128_preoutput() below */
+#define grain128_preoutput_bits(y) \
+    do { \
+        uint32_t x0 = GWORD64(b0, 0, 12); \
+        uint32_t x4 = GWORD64(b1, 64, 95); \
+        (y)  = (x0 & GWORD64(s0, 0, 8));                    /* x[0] & x[1] */ \
+        (y) ^= (GWORD64(s0, 0, 13) & GWORD64(s0, 0, 20));   /* x[2] & x[3] */ \
+        (y) ^= (x4 & GWORD64(sm, 32, 42));                  /* x[4] & x[5] */ \
+        (y) ^= (GWORD64(sm, 32, 60) & GWORD64(s1, 64, 79)); /* x[6] & x[7] */ \
+        (y) ^= (x0 & x4 & GWORD64(s1, 64, 94));             /* x[0] & x[4] & x[8] */ \
+        (y) ^= GWORD64(s1, 64, 93);                         /* s[93] */ \
+        (y) ^= GWORD64(b0, 0, 2);                           /* b[2] */ \
+        (y) ^= GWORD64(b0, 0, 15);                          /* b[15] */ \
+        (y) ^= GWORD64(bm, 32, 36);                         /* b[36] */ \
+        (y) ^= GWORD64(bm, 32, 45);                         /* b[45] */ \
+        (y) ^= GWORD64(b1, 64, 64);                         /* b[64] */ \
+        (y) ^= GWORD64(b1, 64, 73);                         /* b[73] */ \
+        (y) ^= GWORD64(b1, 64, 89);                         /* b[89] */ \
+    } while (0)
+
+/* Shifts 32 bits of LFSR and NFSR feedback into the state words */
+#define grain128_shift_in(x, x2) \
+    do { \
+        s0 = sm; \
+        sm = s1; \
+        s1 = (s1 << 32) | (x); \
+        b0 = bm; \
+        bm = b1; \
+        b1 = (b1 << 32) | (x2); \
+    } while (0)
+
+/* Loads the state into local variables */
+#define grain128_load_state(state) \
+    do { \
+        s0 = (state)->lfsr[0]; \
+        s1 = (state)->lfsr[1]; \
+        sm = (s0 << 32) | (s1 >> 32); \
+        b0 = (state)->nfsr[0]; \
+        b1 = (state)->nfsr[1]; \
+        bm = (b0 << 32) | (b1 >> 32); \
+    } while (0)
+
+void grain128_core
+    (grain128_state_t *state, uint32_t x, uint32_t x2)
+{
+    uint64_t s0, sm, s1, b0, bm, b1;
+
+    /* From the Grain-128AEAD specification, the LFSR feedback algorithm is:
+     *
+     *      s'[i] = s[i + 1]
+     *      s'[127] = s[0] ^ s[7] ^ s[38] ^ s[70] ^ s[81] ^ s[96] ^ x
+     *
+     * and the NFSR feedback algorithm is:
+     *
+     *      b'[i] = b[i + 1]
+     *      b'[127] = s[0] ^ b[0] ^ b[26] ^ b[56] ^ b[91] ^ b[96]
+     *              ^ (b[3] & b[67]) ^ (b[11] & b[13]) ^ (b[17] & b[18])
+     *              ^ (b[27] & b[59]) ^ (b[40] & b[48]) ^ (b[61] & b[65])
+     *              ^ (b[68] & b[84]) ^ (b[22] & b[24] & b[25])
+     *              ^ (b[70] & b[78] & b[82])
+     *              ^ (b[88] & b[92] & b[93] & b[95]) ^ x2
+     *
+     * The highest tap is 96, so 32 feedback bits can be computed at once.
+     */
+    grain128_load_state(state);
+    grain128_lfsr_feedback(x);
+    grain128_nfsr_feedback(x2);
+    state->lfsr[0] = sm;
+    state->lfsr[1] = (s1 << 32) | x;
+    state->nfsr[0] = bm;
+    state->nfsr[1] = (b1 << 32) | x2;
+}
+
+uint32_t grain128_preoutput(const grain128_state_t *state)
+{
+    uint64_t s0, sm, s1, b0, bm, b1;
+    uint32_t y;
+
+    /* From the Grain-128AEAD specification, each pre-output bit y is given by:
+     *
+     *      x[0..8] = b[12], s[8], s[13], s[20], b[95],
+     *                s[42], s[60], s[79], s[94]
+     *      h(x) = (x[0] & x[1]) ^ (x[2] & x[3]) ^ (x[4] & x[5])
+     *           ^ (x[6] & x[7]) ^ (x[0] & x[4] & x[8])
+     *      y = h(x) ^ s[93] ^ b[2] ^ b[15] ^ b[36] ^ b[45]
+     *               ^ b[64] ^ b[73] ^ b[89]
+     *
+     * Calculate 32 pre-output bits in parallel.
+     */
+    grain128_load_state(state);
+    grain128_preoutput_bits(y);
+    return y;
+}
+
+/**
+ * \brief Generates 64 bits of pre-output and then clocks the state 64 times.
+ *
+ * \param state Grain-128 state.
+ * \param feedback Non-zero to also feed the pre-output back into the LFSR
+ * and NFSR, as is done during initialization.
+ *
+ * \return The 64 pre-output bits, with the first bit in the most
+ * significant position.
+ */
+static uint64_t grain128_step64(grain128_state_t *state, int feedback)
+{
+    uint64_t s0, sm, s1, b0, bm, b1;
+    uint32_t y0, y1, x, x2;
+
+    /* The highest tap is 96, so the 64 clocks are performed as two sets
+     * of 32 with the state held in registers in between */
+    grain128_load_state(state);
+    grain128_preoutput_bits(y0);
+    x = x2 = feedback ? y0 : 0;
+    grain128_lfsr_feedback(x);
+    grain128_nfsr_feedback(x2);
+    grain128_shift_in(x, x2);
+    grain128_preoutput_bits(y1);
+    x = x2 = feedback ? y1 : 0;
+    grain128_lfsr_feedback(x);
+    grain128_nfsr_feedback(x2);
+    state->lfsr[0] = sm;
+    state->lfsr[1] = (s1 << 32) | x;
+    state->nfsr[0] = bm;
+    state->nfsr[1] = (b1 << 32) | x2;
+    return (((uint64_t)y0) << 32) | y1;
+}
+
+#else /* !GRAIN128_WORD64 */
+
 /* Extracts 32 bits from the Grain state that are not word-aligned */
 #define GWORD(a, b, start_bit) \
         (((a) << ((start_bit) % 32)) ^ ((b) >> (32 - ((start_bit) % 32))))
@@ -161,6 +339,8 @@ uint32_t grain128_preoutput(const grain128_state_t *state)
 
 #endif /* !GRAIN128_ASM_PREOUTPUT */
 
+#endif /* !GRAIN128_WORD64 */
+
 /* http://programming.sirrida.de/perm_fn.html#bit_permute_step */
 #define bit_permute_step(_y, mask, shift) \
     do { \
@@ -169,6 +349,14 @@ uint32_t grain128_preoutput(const grain128_state_t *state)
         (_y) = (y ^ t) ^ (t << (shift)); \
     } while (0)
 
+/* 64-bit version of bit_permute_step() */
+#define bit_permute_step_64(_y, mask, shift) \
+    do { \
+        uint64_t y = (_y); \
+        uint64_t t = ((y >> (shift)) ^ y) & (mask); \
+        (_y) = (y ^ t) ^ (t << (shift)); \
+    } while (0)
+
 /* http://programming.sirrida.de/perm_fn.html#bit_permute_step_simple */
 #define bit_permute_step_simple(_y, mask, shift) \
     do { \
@@ -229,6 +417,27 @@ void grain128_setup
         } while (0)
     #endif
 
+#if GRAIN128_WORD64
+    /* Initialize the LFSR state with the nonce and padding */
+    SWAP_BITS(k[0], nonce);
+    SWAP_BITS(k[1], nonce + 4);
+    SWAP_BITS(k[2], nonce + 8);
+    state->lfsr[0] = (((uint64_t)(k[0])) << 32) | k[1];
+    state->lfsr[1] = (((uint64_t)(k[2])) << 32) | 0xFFFFFFFEU;
+
+    /* Initialize the NFSR state with the key */
+    SWAP_BITS(k[0], key);
+    SWAP_BITS(k[1], key + 4);
+    SWAP_BITS(k[2], key + 8);
+    SWAP_BITS(k[3], key + 12);
+    state->nfsr[0] = (((uint64_t)(k[0])) << 32) | k[1];
+    state->nfsr[1] = (((uint64_t)(k[2])) << 32) | k[3];
+
+    /* Perform 256 rounds of Grain-128 to mix up the initial state.
+     * The rounds can be performed 64 at a time: 64 * 4 = 256 */
+    for (round = 0; round < 4; ++round)
+        grain128_step64(state, 1);
+#else
     /* Initialize the LFSR state with the nonce and padding */
     SWAP_BITS(state->lfsr[0], nonce);
     SWAP_BITS(state->lfsr[1], nonce + 4);
@@ -251,6 +460,7 @@ void grain128_setup
         uint32_t y = grain128_preoutput(state);
         grain128_core(state, y, y);
     }
+#endif
 
     /* Absorb the key into the state again and generate the initial
      * state of the accumulator and the shift register */
@@ -274,7 +484,19 @@ void grain128_setup
  */
 static void grain128_next_keystream(grain128_state_t *state)
 {
-#if !GRAIN128_ASM_HELPERS
+#if GRAIN128_WORD64
+    unsigned posn;
+    for (posn = 0; posn < sizeof(state->ks); posn += 8) {
+        /* Generate 64 bits of pre-output at a time and then swap and
+         * separate the bits as for the 32-bit version below */
+        uint64_t x = grain128_step64(state, 0);
+        bit_permute_step_64(x, 0x1111111111111111ULL, 3);
+        bit_permute_step_64(x, 0x0303030303030303ULL, 6);
+        bit_permute_step_64(x, 0x000f000f000f000fULL, 12);
+        bit_permute_step_simple(x, 0x00ff00ff00ff00ffULL, 8);
+        be_store_word64(state->ks + posn, x);
+    }
+#elif !GRAIN128_ASM_HELPERS
     unsigned posn;
     for (posn = 0; posn < sizeof(state->ks); posn += 4) {
         /* Get the next word of pre-output and run the Grain-128 core */
@@ -457,3 +679,240 @@ void grain128_compute_tag(grain128_state_t *state)
 }
 
 #endif /* !__AVR__ */
+
+#if GRAIN128_MULTI
+
+/* Modes for processing data with the multi-session kernels */
+#define GRAIN128_MULTI_AUTH     0
+#define GRAIN128_MULTI_ENCRYPT  1
+#define GRAIN128_MULTI_DECRYPT  2
+
+/* 128-session kernel for the baseline vector unit; SSE2 or NEON */
+#define GRAIN128_LANES_SUFFIX _x128
+#define GRAIN128_LANES 128
+#define GRAIN128_LANES_TARGET
+#include "internal-grain128-lanes.h"
+
+/* 256-session kernel for AVX2 */
+#if GRAIN128_MULTI_MAX_LANES == 256
+#define GRAIN128_HAVE_X256 1
+#define GRAIN128_LANES_SUFFIX _x256
+#define GRAIN128_LANES 256
+#define GRAIN128_LANES_TARGET LW_TARGET_AVX2
+#include "internal-grain128-lanes.h"
+#else
+#define GRAIN128_HAVE_X256 0
+#endif
+
+/* Determine if the 256-session kernel can be used on this CPU */
+#if GRAIN128_SIMD_DISPATCH && !defined(__AVX2__)
+#define grain128_can_use_x256() (lw_simd_level() >= LW_SIMD_LEVEL_AVX2)
+#else
+#define grain128_can_use_x256() (GRAIN128_HAVE_X256)
+#endif
+
+/**
+ * \brief Transposes the 64 x 64 bit matrices in the words of 64 rows with
+ * the multi-session kernel for a state.
+ *
+ * \param state Multi-session Grain-128 state.
+ * \param rows The rows to transpose in-place.
+ */
+static void grain128_multi_transpose
+    (const grain128_multi_state_t *state,
+     uint64_t (*rows)[GRAIN128_MULTI_WORDS])
+{
+#if GRAIN128_HAVE_X256
+    if (state->lanes == 256) {
+        grain128_multi_transpose_x256(rows);
+        return;
+    }
+#else
+    (void)state;
+#endif
+    grain128_multi_transpose_x128(rows);
+}
+
+/**
+ * \brief Loads up to 8 bytes of data for every session and converts
+ * it into bit-sliced form.
+ *
+ * \param state Multi-session Grain-128 state.
+ * \param rows Returns the 64 bit-sliced rows, with zeroes past \a len
+ * bytes and in the sessions that are not in use.
+ * \param data Points to the data for each session.
+ * \param offset Offset of the bytes to load from each of \a data.
+ * \param len Number of bytes to load, between 1 and 8.
+ */
+static void grain128_multi_load
+    (const grain128_multi_state_t *state,
+     uint64_t (*rows)[GRAIN128_MULTI_WORDS],
+     const unsigned char * const *data, unsigned long long offset,
+     unsigned len)
+{
+    unsigned char temp[8];
+    unsigned word, index, lane;
+    for (word = 0; word < (state->lanes / 64); ++word) {
+        for (index = 0; index < 64; ++index) {
+            lane = word * 64 + index;
+            if (lane >= state->count) {
+                rows[index][word] = 0;
+            } else if (len == 8) {
+                rows[index][word] = le_load_word64(data[lane] + offset);
+            } else {
+                memset(temp, 0, sizeof(temp));
+                memcpy(temp, data[lane] + offset, len);
+                rows[index][word] = le_load_word64(temp);
+            }
+        }
+    }
+    grain128_multi_transpose(state, rows);
+}
+
+/**
+ * \brief Converts bit-sliced data back into up to 8 bytes of data for
+ * every session and stores it.
+ *
+ * \param state Multi-session Grain-128 state.
+ * \param rows The 64 bit-sliced rows, which are destroyed.
+ * \param data Points to the output buffers for each session.
+ * \param offset Offset of the bytes to store in each of \a data.
+ * \param len Number of bytes to store, between 1 and 8.
+ */
+static void grain128_multi_store
+    (const grain128_multi_state_t *state,
+     uint64_t (*rows)[GRAIN128_MULTI_WORDS],
+     unsigned char * const *data, unsigned long long offset, unsigned len)
+{
+    unsigned char temp[8];
+    unsigned word, index, lane;
+    grain128_multi_transpose(state, rows);
+    for (word = 0; word < (state->lanes / 64); ++word) {
+        for (index = 0; index < 64; ++index) {
+            lane = word * 64 + index;
+            if (lane >= state->count) {
+                break;
+            } else if (len == 8) {
+                le_store_word64(data[lane] + offset, rows[index][word]);
+            } else {
+                le_store_word64(temp, rows[index][word]);
+                memcpy(data[lane] + offset, temp, len);
+            }
+        }
+    }
+}
+
+/**
+ * \brief Encrypts, decrypts, or authenticates data with all sessions.
+ *
+ * \param state Multi-session Grain-128 state.
+ * \param out Points to the output buffers, or NULL for GRAIN128_MULTI_AUTH.
+ * \param in Points to the input buffers.
+ * \param len Length of the data, which is the same for all sessions.
+ * \param mode One of GRAIN128_MULTI_AUTH, GRAIN128_MULTI_ENCRYPT, or
+ * GRAIN128_MULTI_DECRYPT.
+ */
+static void grain128_multi_process
+    (grain128_multi_state_t *state, unsigned char * const *out,
+     const unsigned char * const *in, unsigned long long len, int mode)
+{
+    uint64_t rows[64][GRAIN128_MULTI_WORDS];
+    unsigned long long offset = 0;
+    unsigned chunk;
+    while (len > 0) {
+        chunk = len < 8 ? (unsigned)len : 8;
+        grain128_multi_load(state, rows, in, offset, chunk);
+#if GRAIN128_HAVE_X256
+        if (state->lanes == 256)
+            grain128_multi_bits_x256(state, rows, chunk * 8, mode);
+        else
+#endif
+        grain128_multi_bits_x128(state, rows, chunk * 8, mode);
+        if (mode != GRAIN128_MULTI_AUTH)
+            grain128_multi_store(state, rows, out, offset, chunk);
+        offset += chunk;
+        len -= chunk;
+    }
+}
+
+unsigned grain128_multi_lanes(void)
+{
+    return grain128_can_use_x256() ? 256 : 128;
+}
+
+void grain128_multi_setup
+    (grain128_multi_state_t *state, const unsigned char * const *keys,
+     const unsigned char * const *nonces, unsigned count)
+{
+    unsigned index, word;
+
+    /* Load the keys into the NFSR and the nonces into the LFSR.  The bit
+     * order of the NIST functions already puts the first bit of each word
+     * into the least significant position, so no bit swapping is needed */
+    state->lanes = grain128_multi_lanes();
+    state->count = count;
+    state->posn = 0;
+    grain128_multi_load(state, state->nfsr, keys, 0, 8);
+    grain128_multi_load(state, state->nfsr + 64, keys, 8, 8);
+    grain128_multi_load(state, state->lfsr, nonces, 0, 8);
+    grain128_multi_load(state, state->lfsr + 64, nonces, 8, 4);
+
+    /* Pad the LFSR with all-1s and a terminating 0 */
+    for (index = 96; index < 127; ++index) {
+        for (word = 0; word < (state->lanes / 64); ++word)
+            state->lfsr[index][word] = ~((uint64_t)0);
+    }
+
+    /* Mix up the initial state and absorb the key again */
+#if GRAIN128_HAVE_X256
+    if (state->lanes == 256)
+        grain128_multi_init_x256(state);
+    else
+#endif
+    grain128_multi_init_x128(state);
+}
+
+void grain128_multi_authenticate
+    (grain128_multi_state_t *state, const unsigned char * const *data,
+     unsigned long long len)
+{
+    grain128_multi_process(state, 0, data, len, GRAIN128_MULTI_AUTH);
+}
+
+void grain128_multi_encrypt
+    (grain128_multi_state_t *state, unsigned char * const *c,
+     const unsigned char * const *m, unsigned long long len)
+{
+    grain128_multi_process(state, c, m, len, GRAIN128_MULTI_ENCRYPT);
+}
+
+void grain128_multi_decrypt
+    (grain128_multi_state_t *state, unsigned char * const *m,
+     const unsigned char * const *c, unsigned long long len)
+{
+    grain128_multi_process(state, m, c, len, GRAIN128_MULTI_DECRYPT);
+}
+
+void grain128_multi_compute_tag
+    (grain128_multi_state_t *state, unsigned char (*tags)[8])
+{
+    unsigned word, index, lane;
+
+    /* Authenticate a final 1 bit as padding on the stream */
+    for (index = 0; index < 64; ++index) {
+        for (word = 0; word < (state->lanes / 64); ++word)
+            state->accum[index][word] ^= state->sr[index][word];
+    }
+
+    /* Bit j of each session's tag is bit j of its accumulator */
+    grain128_multi_transpose(state, state->accum);
+    for (lane = 0; lane < state->count; ++lane)
+        le_store_word64(tags[lane], state->accum[lane % 64][lane / 64]);
+}
+
+const char *grain128_multi_variant(void)
+{
+    return grain128_can_use_x256() ? "AVX2" : "Vector";
+}
+
+#endif /* GRAIN128_MULTI */
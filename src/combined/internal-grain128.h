@@ -36,6 +36,22 @@
 extern "C" {
 #endif
 
+/**
+ * \brief Defined to 1 if the Grain-128 state is held in 64-bit words.
+ *
+ * This is the case on 64-bit hosts, where the keystream is generated
+ * 64 clocks at a time.  Otherwise the state is held in 32-bit words,
+ * which is what the AVR assembly code expects.  Define GRAIN128_NO_WORD64
+ * to force the use of 32-bit words.
+ */
+#if !defined(__AVR__) && !defined(GRAIN128_NO_WORD64) && \
+        (defined(__LP64__) || defined(_WIN64) || defined(__x86_64__) || \
+         defined(__aarch64__))
+#define GRAIN128_WORD64 1
+#else
+#define GRAIN128_WORD64 0
+#endif
+
 /**
  * \brief Representation of the state of Grain-128.
  *
@@ -44,8 +60,13 @@ extern "C" {
  */
 typedef struct
 {
+#if GRAIN128_WORD64
+    uint64_t lfsr[2];       /**< 128-bit LFSR state for Grain-128 */
+    uint64_t nfsr[2];       /**< 128-bit NFSR state for Grain-128 */
+#else
     uint32_t lfsr[4];       /**< 128-bit LFSR state for Grain-128 */
     uint32_t nfsr[4];       /**< 128-bit NFSR state for Grain-128 */
+#endif
     uint64_t accum;         /**< 64-bit accumulator for authentication */
     uint64_t sr;            /**< 64-bit shift register for authentication */
     unsigned char ks[16];   /**< Keystream block for auth or encrypt mode */
@@ -127,6 +148,173 @@ void grain128_decrypt
  */
 void grain128_compute_tag(grain128_state_t *state);
 
+/**
+ * \brief Defined to 1 if the multi-session Grain-128 kernels are selected
+ * at runtime according to the features of the CPU.
+ */
+#if LW_SIMD_DISPATCH && !defined(GRAIN128_NO_SIMD_DISPATCH)
+#define GRAIN128_SIMD_DISPATCH 1
+#else
+#define GRAIN128_SIMD_DISPATCH 0
+#endif
+
+/**
+ * \brief Defined to 1 if the bit-sliced multi-session Grain-128 kernels
+ * can be built with the vector extensions of GCC and clang.
+ *
+ * The kernels run a separate Grain-128 session in each bit of a vector,
+ * so that every clock of the registers advances all sessions at once.
+ */
+#if !defined(__AVR__) && (defined(__GNUC__) || defined(__clang__)) && \
+        (defined(__SSE2__) || defined(__ARM_NEON) || defined(__ARM_NEON__) || \
+         GRAIN128_SIMD_DISPATCH)
+#define GRAIN128_MULTI 1
+#else
+#define GRAIN128_MULTI 0
+#endif
+
+#if GRAIN128_MULTI
+
+/**
+ * \brief Maximum number of sessions in a multi-session Grain-128 state.
+ *
+ * This is 256 if there is an AVX2 kernel and 128 otherwise.  The number
+ * that is actually used on this CPU is returned by grain128_multi_lanes().
+ */
+#if defined(__AVX2__) || GRAIN128_SIMD_DISPATCH
+#define GRAIN128_MULTI_MAX_LANES 256
+#else
+#define GRAIN128_MULTI_MAX_LANES 128
+#endif
+
+/**
+ * \brief Number of 64-bit words in each bit-sliced row of the state.
+ */
+#define GRAIN128_MULTI_WORDS (GRAIN128_MULTI_MAX_LANES / 64)
+
+/**
+ * \brief Number of clocks between shifts of the bit-sliced registers.
+ */
+#define GRAIN128_MULTI_SLACK 64
+
+/**
+ * \brief Bit-sliced state of up to GRAIN128_MULTI_MAX_LANES Grain-128
+ * sessions that run in lock-step.
+ *
+ * Each row holds one bit of the state for every session, with the bit
+ * for session i in bit (i % 64) of word (i / 64).  Bit j of the LFSR
+ * and NFSR is in row (posn + j) so that the registers only need to be
+ * shifted down once every GRAIN128_MULTI_SLACK clocks.
+ */
+typedef struct
+{
+    /** Bit-sliced LFSR with room for new bits after the end */
+    uint64_t lfsr[128 + GRAIN128_MULTI_SLACK][GRAIN128_MULTI_WORDS];
+
+    /** Bit-sliced NFSR with room for new bits after the end */
+    uint64_t nfsr[128 + GRAIN128_MULTI_SLACK][GRAIN128_MULTI_WORDS];
+
+    /** Bit-sliced accumulator, starting with the most significant bit */
+    uint64_t accum[64][GRAIN128_MULTI_WORDS];
+
+    /** Bit-sliced shift register, starting with the most significant bit */
+    uint64_t sr[64][GRAIN128_MULTI_WORDS];
+
+    unsigned posn;  /**< Row of the first bit of the LFSR and NFSR */
+    unsigned lanes; /**< Number of sessions that the kernel runs */
+    unsigned count; /**< Number of sessions that are in use */
+
+} __attribute__((aligned(32))) grain128_multi_state_t;
+
+/**
+ * \brief Gets the number of sessions that are run in lock-step by the
+ * multi-session Grain-128 kernel on this CPU.
+ *
+ * \return 128 or 256.
+ */
+unsigned grain128_multi_lanes(void);
+
+/**
+ * \brief Sets up a multi-session Grain-128 state with a key and nonce
+ * for each session.
+ *
+ * \param state Multi-session Grain-128 state to be initialized.
+ * \param keys Points to the 128-bit keys for the sessions.
+ * \param nonces Points to the 96-bit nonces for the sessions.
+ * \param count Number of sessions, between 1 and grain128_multi_lanes().
+ *
+ * The result for each session is the same as grain128_setup().
+ */
+void grain128_multi_setup
+    (grain128_multi_state_t *state, const unsigned char * const *keys,
+     const unsigned char * const *nonces, unsigned count);
+
+/**
+ * \brief Authenticates data with all sessions of a multi-session
+ * Grain-128 state.
+ *
+ * \param state Multi-session Grain-128 state.
+ * \param data Points to the data to be authenticated for each session.
+ * \param len Length of the data to be authenticated, which is the same
+ * for all sessions.
+ */
+void grain128_multi_authenticate
+    (grain128_multi_state_t *state, const unsigned char * const *data,
+     unsigned long long len);
+
+/**
+ * \brief Encrypts and authenticates data with all sessions of a
+ * multi-session Grain-128 state.
+ *
+ * \param state Multi-session Grain-128 state.
+ * \param c Points to the ciphertext output buffers.
+ * \param m Points to the plaintext input buffers.
+ * \param len Length of the data to be encrypted, which is the same
+ * for all sessions.
+ *
+ * The buffers for a session may be the same for in-place encryption.
+ */
+void grain128_multi_encrypt
+    (grain128_multi_state_t *state, unsigned char * const *c,
+     const unsigned char * const *m, unsigned long long len);
+
+/**
+ * \brief Decrypts and authenticates data with all sessions of a
+ * multi-session Grain-128 state.
+ *
+ * \param state Multi-session Grain-128 state.
+ * \param m Points to the plaintext output buffers.
+ * \param c Points to the ciphertext input buffers.
+ * \param len Length of the data to be decrypted, which is the same
+ * for all sessions.
+ *
+ * The buffers for a session may be the same for in-place decryption.
+ */
+void grain128_multi_decrypt
+    (grain128_multi_state_t *state, unsigned char * const *m,
+     const unsigned char * const *c, unsigned long long len);
+
+/**
+ * \brief Computes the final authentication tags for all sessions of a
+ * multi-session Grain-128 state.
+ *
+ * \param state Multi-session Grain-128 state.
+ * \param tags Receives the 8-byte authentication tag for each session.
+ */
+void grain128_multi_compute_tag
+    (grain128_multi_state_t *state, unsigned char (*tags)[8]);
+
+/**
+ * \brief Gets the name of the multi-session kernel that is in use.
+ *
+ * \return One of "AVX2" or "Vector".
+ *
+ * This function is intended for tests and benchmarks.
+ */
+const char *grain128_multi_variant(void);
+
+#endif /* GRAIN128_MULTI */
+
 #ifdef __cplusplus
 }
 #endif
@@ -32,6 +32,12 @@
  * ISAP_STATE           Type for the permuation state; e.g. ascon_state_t
  * ISAP_PERMUTE(s,r)    Permutes the state "s" with number of rounds "r".
  * ISAP_PERMUTE_SLICED(s,r) Defined if using the sliced version of ASCON.
+ * ISAP_PERMUTE_N(s,n,r) Defined to permute the "n" states in the array "s"
+ *                      in parallel, to generate batch encryption functions.
+ * ISAP_ABSORB_BITS_N(s,n,d,b,r) Absorbs "b" bits from each of the buffers
+ *                      in "d" into the "n" states in "s", permuting each
+ *                      state with "r" rounds after every bit.
+ * ISAP_BATCH_LANES     Number of packets to process at once in a batch.
  */
 #if defined(ISAP_ALG_NAME)
 
@@ -112,6 +118,89 @@ static void ISAP_CONCAT(ISAP_ALG_NAME,_rekey)
 #endif
 }
 
+#if !defined(ISAP_PERMUTE_SLICED)
+
+/**
+ * \brief Encrypts (or decrypts) a message payload with a re-keyed state.
+ *
+ * \param state ISAP permutation state, which has already been re-keyed.
+ * \param npub Points to the 128-bit nonce for the ISAP cipher.
+ * \param c Buffer to receive the output ciphertext.
+ * \param m Buffer to receive the input plaintext.
+ * \param mlen Length of the input plaintext.
+ */
+static void ISAP_CONCAT(ISAP_ALG_NAME,_encrypt_payload)
+    (ISAP_STATE *state, const unsigned char *npub,
+     unsigned char *c, const unsigned char *m, unsigned long long mlen)
+{
+    /* Set up the nonce in the state */
+    memcpy(state->B + sizeof(ISAP_STATE) - ISAP_NONCE_SIZE,
+           npub, ISAP_NONCE_SIZE);
+
+    /* Encrypt the plaintext to produce the ciphertext */
+    while (mlen >= ISAP_RATE) {
+        ISAP_PERMUTE(state, ISAP_sE);
+        lw_xor_block_2_src(c, state->B, m, ISAP_RATE);
+        c += ISAP_RATE;
+        m += ISAP_RATE;
+        mlen -= ISAP_RATE;
+    }
+    if (mlen > 0) {
+        ISAP_PERMUTE(state, ISAP_sE);
+        lw_xor_block_2_src(c, state->B, m, (unsigned)mlen);
+    }
+}
+
+/**
+ * \brief Absorbs the associated data and ciphertext to produce the
+ * pre-tag for ISAP.
+ *
+ * \param state ISAP permutation state.
+ * \param npub Points to the 128-bit nonce for the ISAP cipher.
+ * \param ad Buffer containing the associated data.
+ * \param adlen Length of the associated data.
+ * \param c Buffer containing the ciphertext.
+ * \param clen Length of the ciphertext.
+ */
+static void ISAP_CONCAT(ISAP_ALG_NAME,_mac_absorb)
+    (ISAP_STATE *state, const unsigned char *npub,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *c, unsigned long long clen)
+{
+    unsigned temp;
+
+    /* Absorb the associated data */
+    memcpy(state->B, npub, ISAP_NONCE_SIZE);
+    memcpy(state->B + ISAP_NONCE_SIZE, ISAP_CONCAT(ISAP_ALG_NAME,_IV_A),
+           sizeof(state->B) - ISAP_NONCE_SIZE);
+    ISAP_PERMUTE(state, ISAP_sH);
+    while (adlen >= ISAP_RATE) {
+        lw_xor_block(state->B, ad, ISAP_RATE);
+        ISAP_PERMUTE(state, ISAP_sH);
+        ad += ISAP_RATE;
+        adlen -= ISAP_RATE;
+    }
+    temp = (unsigned)adlen;
+    lw_xor_block(state->B, ad, temp);
+    state->B[temp] ^= 0x80; /* padding */
+    ISAP_PERMUTE(state, ISAP_sH);
+    state->B[sizeof(state->B) - 1] ^= 0x01; /* domain separation */
+
+    /* Absorb the ciphertext */
+    while (clen >= ISAP_RATE) {
+        lw_xor_block(state->B, c, ISAP_RATE);
+        ISAP_PERMUTE(state, ISAP_sH);
+        c += ISAP_RATE;
+        clen -= ISAP_RATE;
+    }
+    temp = (unsigned)clen;
+    lw_xor_block(state->B, c, temp);
+    state->B[temp] ^= 0x80; /* padding */
+    ISAP_PERMUTE(state, ISAP_sH);
+}
+
+#endif /* !ISAP_PERMUTE_SLICED */
+
 /**
  * \brief Encrypts (or decrypts) a message payload with ISAP.
  *
@@ -150,24 +239,12 @@ static void ISAP_CONCAT(ISAP_ALG_NAME,_encrypt)
         lw_xor_block_2_src(c, block, m, (unsigned)mlen);
     }
 #else
-    /* Set up the re-keyed encryption key and nonce in the state */
+    /* Set up the re-keyed encryption key in the state */
     ISAP_CONCAT(ISAP_ALG_NAME,_rekey)
         (state, k, ISAP_CONCAT(ISAP_ALG_NAME,_IV_KE), npub, ISAP_NONCE_SIZE);
-    memcpy(state->B + sizeof(ISAP_STATE) - ISAP_NONCE_SIZE,
-           npub, ISAP_NONCE_SIZE);
 
     /* Encrypt the plaintext to produce the ciphertext */
-    while (mlen >= ISAP_RATE) {
-        ISAP_PERMUTE(state, ISAP_sE);
-        lw_xor_block_2_src(c, state->B, m, ISAP_RATE);
-        c += ISAP_RATE;
-        m += ISAP_RATE;
-        mlen -= ISAP_RATE;
-    }
-    if (mlen > 0) {
-        ISAP_PERMUTE(state, ISAP_sE);
-        lw_xor_block_2_src(c, state->B, m, (unsigned)mlen);
-    }
+    ISAP_CONCAT(ISAP_ALG_NAME,_encrypt_payload)(state, npub, c, m, mlen);
 #endif
 }
 
@@ -241,36 +318,9 @@ static void ISAP_CONCAT(ISAP_ALG_NAME,_mac)
     ascon_squeeze_sliced(state, tag + 8, 1);
 #else
     unsigned char preserve[sizeof(ISAP_STATE) - ISAP_TAG_SIZE];
-    unsigned temp;
-
-    /* Absorb the associated data */
-    memcpy(state->B, npub, ISAP_NONCE_SIZE);
-    memcpy(state->B + ISAP_NONCE_SIZE, ISAP_CONCAT(ISAP_ALG_NAME,_IV_A),
-           sizeof(state->B) - ISAP_NONCE_SIZE);
-    ISAP_PERMUTE(state, ISAP_sH);
-    while (adlen >= ISAP_RATE) {
-        lw_xor_block(state->B, ad, ISAP_RATE);
-        ISAP_PERMUTE(state, ISAP_sH);
-        ad += ISAP_RATE;
-        adlen -= ISAP_RATE;
-    }
-    temp = (unsigned)adlen;
-    lw_xor_block(state->B, ad, temp);
-    state->B[temp] ^= 0x80; /* padding */
-    ISAP_PERMUTE(state, ISAP_sH);
-    state->B[sizeof(state->B) - 1] ^= 0x01; /* domain separation */
 
-    /* Absorb the ciphertext */
-    while (clen >= ISAP_RATE) {
-        lw_xor_block(state->B, c, ISAP_RATE);
-        ISAP_PERMUTE(state, ISAP_sH);
-        c += ISAP_RATE;
-        clen -= ISAP_RATE;
-    }
-    temp = (unsigned)clen;
-    lw_xor_block(state->B, c, temp);
-    state->B[temp] ^= 0x80; /* padding */
-    ISAP_PERMUTE(state, ISAP_sH);
+    /* Absorb the associated data and the ciphertext */
+    ISAP_CONCAT(ISAP_ALG_NAME,_mac_absorb)(state, npub, ad, adlen, c, clen);
 
     /* Re-key the state and generate the authentication tag */
     memcpy(tag, state->B, ISAP_TAG_SIZE);
@@ -333,6 +383,198 @@ int ISAP_CONCAT(ISAP_ALG_NAME,_aead_decrypt)
     return aead_check_tag(m, *mlen, tag, c + *mlen, ISAP_TAG_SIZE);
 }
 
+#if defined(ISAP_PERMUTE_N)
+
+/**
+ * \brief Re-keys several ISAP permutation states in parallel.
+ *
+ * \param states The permutation states to be re-keyed.
+ * \param count Number of states to re-key, up to ISAP_BATCH_LANES.
+ * \param keys Points to the 128-bit keys for each of the states.
+ * \param iv Points to the initialization vector for this re-keying operation.
+ * \param data Points to the data to be absorbed into each of the states.
+ * \param data_len Length of the data to be absorbed into each state.
+ *
+ * The output keys will be left in the leading bytes of \a states.
+ */
+static void ISAP_CONCAT(ISAP_ALG_NAME,_rekey_n)
+    (ISAP_STATE *states, unsigned count, const unsigned char * const *keys,
+     const unsigned char *iv, const unsigned char * const *data,
+     unsigned data_len)
+{
+    unsigned num_bits, index;
+
+    /* Initialize the states with the keys and IV */
+    for (index = 0; index < count; ++index) {
+        memcpy(states[index].B, keys[index], ISAP_KEY_SIZE);
+        memcpy(states[index].B + ISAP_KEY_SIZE, iv,
+               sizeof(states[index].B) - ISAP_KEY_SIZE);
+    }
+    ISAP_PERMUTE_N(states, count, ISAP_sK);
+
+    /* Absorb all of the bits of the data buffers one by one */
+    num_bits = data_len * 8 - 1;
+    ISAP_ABSORB_BITS_N(states, count, data, num_bits, ISAP_sB);
+    for (index = 0; index < count; ++index) {
+        states[index].B[0] ^=
+            (data[index][num_bits / 8] << (num_bits % 8)) & 0x80;
+    }
+    ISAP_PERMUTE_N(states, count, ISAP_sK);
+}
+
+/**
+ * \brief Encrypts or decrypts a group of packets in a batch.
+ *
+ * \param items Points to the descriptors for the packets.
+ * \param count Number of packets in the group, up to ISAP_BATCH_LANES.
+ * \param decrypt Non-zero to decrypt, zero to encrypt.
+ *
+ * The re-keying operations dominate the cost of ISAP for short packets,
+ * so they are performed in parallel across all packets in the group.
+ * The payloads are encrypted and hashed one packet at a time.
+ */
+static void ISAP_CONCAT(ISAP_ALG_NAME,_batch_group)
+    (aead_batch_item_t * const *items, unsigned count, int decrypt)
+{
+    ISAP_STATE states[ISAP_BATCH_LANES];
+    unsigned char tags[ISAP_BATCH_LANES][ISAP_TAG_SIZE];
+    unsigned char preserve[ISAP_BATCH_LANES]
+                          [sizeof(ISAP_STATE) - ISAP_TAG_SIZE];
+    const unsigned char *keys[ISAP_BATCH_LANES] = {0};
+    const unsigned char *data[ISAP_BATCH_LANES] = {0};
+    const unsigned char *c;
+    unsigned long long mlen;
+    aead_batch_item_t *item;
+    unsigned index;
+
+    /* Find the keys and the nonces for the packets.  The caller never
+     * passes more than ISAP_BATCH_LANES packets, but making the limit
+     * explicit lets the compiler see that the arrays cannot overflow */
+    if (count > ISAP_BATCH_LANES)
+        count = ISAP_BATCH_LANES;
+    for (index = 0; index < count; ++index) {
+        item = items[index];
+        if (item->key)
+            keys[index] = item->key;
+        else
+            keys[index] = (const unsigned char *)(item->ctx);
+        data[index] = item->npub;
+    }
+
+    /* Encrypt the plaintext to produce the ciphertext */
+    if (!decrypt) {
+        ISAP_CONCAT(ISAP_ALG_NAME,_rekey_n)
+            (states, count, keys, ISAP_CONCAT(ISAP_ALG_NAME,_IV_KE),
+             data, ISAP_NONCE_SIZE);
+        for (index = 0; index < count; ++index) {
+            item = items[index];
+            item->outlen = item->inlen + ISAP_TAG_SIZE;
+            ISAP_CONCAT(ISAP_ALG_NAME,_encrypt_payload)
+                (&(states[index]), item->npub, item->out, item->in,
+                 item->inlen);
+        }
+    }
+
+    /* Absorb the associated data and ciphertext for each packet */
+    for (index = 0; index < count; ++index) {
+        item = items[index];
+        if (decrypt) {
+            mlen = item->inlen - ISAP_TAG_SIZE;
+            c = item->in;
+        } else {
+            mlen = item->inlen;
+            c = item->out;
+        }
+        ISAP_CONCAT(ISAP_ALG_NAME,_mac_absorb)
+            (&(states[index]), item->npub, item->ad, item->adlen, c, mlen);
+        memcpy(tags[index], states[index].B, ISAP_TAG_SIZE);
+        memcpy(preserve[index], states[index].B + ISAP_TAG_SIZE,
+               sizeof(preserve[index]));
+        data[index] = tags[index];
+    }
+
+    /* Re-key the states and generate the authentication tags */
+    ISAP_CONCAT(ISAP_ALG_NAME,_rekey_n)
+        (states, count, keys, ISAP_CONCAT(ISAP_ALG_NAME,_IV_KA),
+         data, ISAP_TAG_SIZE);
+    for (index = 0; index < count; ++index) {
+        memcpy(states[index].B + ISAP_TAG_SIZE, preserve[index],
+               sizeof(preserve[index]));
+    }
+    ISAP_PERMUTE_N(states, count, ISAP_sH);
+    if (!decrypt) {
+        for (index = 0; index < count; ++index) {
+            item = items[index];
+            memcpy(item->out + item->inlen, states[index].B, ISAP_TAG_SIZE);
+            item->status = 0;
+        }
+        return;
+    }
+    for (index = 0; index < count; ++index)
+        memcpy(tags[index], states[index].B, ISAP_TAG_SIZE);
+
+    /* Decrypt the ciphertext and check the authentication tags */
+    for (index = 0; index < count; ++index)
+        data[index] = items[index]->npub;
+    ISAP_CONCAT(ISAP_ALG_NAME,_rekey_n)
+        (states, count, keys, ISAP_CONCAT(ISAP_ALG_NAME,_IV_KE),
+         data, ISAP_NONCE_SIZE);
+    for (index = 0; index < count; ++index) {
+        item = items[index];
+        item->outlen = item->inlen - ISAP_TAG_SIZE;
+        ISAP_CONCAT(ISAP_ALG_NAME,_encrypt_payload)
+            (&(states[index]), item->npub, item->out, item->in,
+             item->outlen);
+        item->status = aead_check_tag
+            (item->out, item->outlen, tags[index],
+             item->in + item->outlen, ISAP_TAG_SIZE);
+    }
+}
+
+/**
+ * \brief Encrypts or decrypts a batch of packets.
+ *
+ * \param items Points to the descriptors for the packets.
+ * \param count Number of packets in the batch.
+ * \param decrypt Non-zero to decrypt, zero to encrypt.
+ */
+static void ISAP_CONCAT(ISAP_ALG_NAME,_batch_crypt)
+    (aead_batch_item_t *items, size_t count, int decrypt)
+{
+    aead_batch_item_t *group[ISAP_BATCH_LANES];
+    unsigned group_size = 0;
+    size_t index;
+    for (index = 0; index < count; ++index) {
+        if (decrypt && items[index].inlen < ISAP_TAG_SIZE) {
+            /* Ciphertext is too short to contain the tag */
+            items[index].outlen = 0;
+            items[index].status = -1;
+            continue;
+        }
+        group[group_size++] = &(items[index]);
+        if (group_size == ISAP_BATCH_LANES) {
+            ISAP_CONCAT(ISAP_ALG_NAME,_batch_group)(group, group_size, decrypt);
+            group_size = 0;
+        }
+    }
+    if (group_size > 0)
+        ISAP_CONCAT(ISAP_ALG_NAME,_batch_group)(group, group_size, decrypt);
+}
+
+static void ISAP_CONCAT(ISAP_ALG_NAME,_batch_encrypt)
+    (aead_batch_item_t *items, size_t count)
+{
+    ISAP_CONCAT(ISAP_ALG_NAME,_batch_crypt)(items, count, 0);
+}
+
+static void ISAP_CONCAT(ISAP_ALG_NAME,_batch_decrypt)
+    (aead_batch_item_t *items, size_t count)
+{
+    ISAP_CONCAT(ISAP_ALG_NAME,_batch_crypt)(items, count, 1);
+}
+
+#endif /* ISAP_PERMUTE_N */
+
 #endif /* ISAP_ALG_NAME */
 
 /* Now undefine everything so that we can include this file again for
@@ -346,5 +588,8 @@ int ISAP_CONCAT(ISAP_ALG_NAME,_aead_decrypt)
 #undef ISAP_STATE
 #undef ISAP_PERMUTE
 #undef ISAP_PERMUTE_SLICED
+#undef ISAP_PERMUTE_N
+#undef ISAP_ABSORB_BITS_N
+#undef ISAP_BATCH_LANES
 #undef ISAP_CONCAT_INNER
 #undef ISAP_CONCAT
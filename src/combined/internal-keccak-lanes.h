@@ -0,0 +1,268 @@
+/*
+ * Copyright (C) 2020 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* We expect a number of macros to be defined before this file
+ * is included to configure the multi-lane Keccak-p kernels.
+ *
+ * KECCAK_LANES_NAME        Prefix for the names of the kernel functions.
+ * KECCAK_LANES             Number of states that are permuted in parallel.
+ * KECCAK_LANES_STATE       Type of the Keccak-p state; e.g. keccakp_200_state_t
+ * KECCAK_LANES_WORD        Type of a single lane in the Keccak-p state.
+ * KECCAK_LANES_BITS        Number of bits in a single lane; 8 or 16.
+ * KECCAK_LANES_TYPE        Type that holds the same lane from all states.
+ * KECCAK_LANES_ROT(x,n)    Rotates every lane in "x" left by "n" bits,
+ *                          where 0 <= n < KECCAK_LANES_BITS.
+ * KECCAK_LANES_BCAST(x)    Broadcasts the scalar "x" to every lane.
+ * KECCAK_LANES_LOAD(s,i)   Loads lane "i" from the state "s".
+ * KECCAK_LANES_STORE(s,i,x) Stores "x" to lane "i" of the state "s".
+ * KECCAK_LANES_RC          Table of round constants.
+ * KECCAK_LANES_MAX_ROUNDS  Maximum number of rounds.
+ * KECCAK_LANES_TARGET      Function attributes for the kernels, such as
+ *                          the instruction set to compile them for.
+ * KECCAK_LANES_ABSORB_BITS Defined to also generate a kernel that absorbs
+ *                          data one bit at a time, as in ISAP re-keying.
+ *
+ * KECCAK_LANES_TYPE may be a vector type with KECCAK_LANES elements, or
+ * a 64-bit word that holds KECCAK_LANES lanes side by side.
+ */
+#if defined(KECCAK_LANES_NAME)
+
+#define KECCAK_LANES_CONCAT_INNER(name,suffix) name##suffix
+#define KECCAK_LANES_CONCAT(name,suffix) KECCAK_LANES_CONCAT_INNER(name,suffix)
+#define KECCAK_LANES_SET KECCAK_LANES_CONCAT(KECCAK_LANES_NAME,_set_t)
+
+/* Access to a lane of the interleaved state by row and column */
+#define KECCAK_LANES_A(row, col) (s->v[(row) * 5 + (col)])
+
+/* XOR's together all lanes in a column */
+#define KECCAK_LANES_COLUMN(col) \
+    (KECCAK_LANES_A(0, (col)) ^ KECCAK_LANES_A(1, (col)) ^ \
+     KECCAK_LANES_A(2, (col)) ^ KECCAK_LANES_A(3, (col)) ^ \
+     KECCAK_LANES_A(4, (col)))
+
+/* XOR's a value into all lanes in a column */
+#define KECCAK_LANES_THETA(col, value) \
+    do { \
+        D = (value); \
+        KECCAK_LANES_A(0, (col)) ^= D; \
+        KECCAK_LANES_A(1, (col)) ^= D; \
+        KECCAK_LANES_A(2, (col)) ^= D; \
+        KECCAK_LANES_A(3, (col)) ^= D; \
+        KECCAK_LANES_A(4, (col)) ^= D; \
+    } while (0)
+
+/* Rotates a lane by an offset from the Keccak-p specification */
+#define KECCAK_LANES_RHO(x, offset) \
+    KECCAK_LANES_ROT((x), (offset) % KECCAK_LANES_BITS)
+
+/* Set of states with the same lane from every state in one word */
+typedef union
+{
+    KECCAK_LANES_TYPE v[25];
+    KECCAK_LANES_WORD w[25][KECCAK_LANES];
+
+} KECCAK_LANES_SET;
+
+/**
+ * \brief Transposes up to KECCAK_LANES Keccak-p states into a set.
+ *
+ * \param s The set of states to load.
+ * \param states Points to the states to be transposed.
+ * \param count Number of states, between 1 and KECCAK_LANES.
+ */
+static KECCAK_LANES_TARGET void KECCAK_LANES_CONCAT(KECCAK_LANES_NAME,_load)
+    (KECCAK_LANES_SET *s, const KECCAK_LANES_STATE *states, unsigned count)
+{
+    unsigned lane, index;
+    if (count < KECCAK_LANES)
+        memset(s, 0, sizeof(KECCAK_LANES_SET));
+    for (lane = 0; lane < count; ++lane) {
+        for (index = 0; index < 25; ++index)
+            s->w[index][lane] = KECCAK_LANES_LOAD(&(states[lane]), index);
+    }
+}
+
+/**
+ * \brief Transposes a set back into up to KECCAK_LANES Keccak-p states.
+ *
+ * \param s The set of states to store.
+ * \param states Points to the states to receive the result.
+ * \param count Number of states, between 1 and KECCAK_LANES.
+ */
+static KECCAK_LANES_TARGET void KECCAK_LANES_CONCAT(KECCAK_LANES_NAME,_store)
+    (const KECCAK_LANES_SET *s, KECCAK_LANES_STATE *states, unsigned count)
+{
+    unsigned lane, index;
+    for (lane = 0; lane < count; ++lane) {
+        for (index = 0; index < 25; ++index)
+            KECCAK_LANES_STORE(&(states[lane]), index, s->w[index][lane]);
+    }
+}
+
+/**
+ * \brief Permutes all states in a set.
+ *
+ * \param s The set of states to permute.
+ * \param rounds Number of rounds to perform, up to KECCAK_LANES_MAX_ROUNDS.
+ */
+static KECCAK_LANES_TARGET void KECCAK_LANES_CONCAT(KECCAK_LANES_NAME,_rounds)
+    (KECCAK_LANES_SET *s, unsigned rounds)
+{
+    KECCAK_LANES_TYPE C0, C1, C2, C3, C4, D;
+    unsigned index, round;
+
+    /* Perform all permutation rounds */
+    for (round = KECCAK_LANES_MAX_ROUNDS - rounds;
+            round < KECCAK_LANES_MAX_ROUNDS; ++round) {
+        /* Step mapping theta.  The specification mentions two temporary
+         * arrays of size 5 called C and D.  Compute D on the fly */
+        C0 = KECCAK_LANES_COLUMN(0);
+        C1 = KECCAK_LANES_COLUMN(1);
+        C2 = KECCAK_LANES_COLUMN(2);
+        C3 = KECCAK_LANES_COLUMN(3);
+        C4 = KECCAK_LANES_COLUMN(4);
+        KECCAK_LANES_THETA(0, C4 ^ KECCAK_LANES_ROT(C1, 1));
+        KECCAK_LANES_THETA(1, C0 ^ KECCAK_LANES_ROT(C2, 1));
+        KECCAK_LANES_THETA(2, C1 ^ KECCAK_LANES_ROT(C3, 1));
+        KECCAK_LANES_THETA(3, C2 ^ KECCAK_LANES_ROT(C4, 1));
+        KECCAK_LANES_THETA(4, C3 ^ KECCAK_LANES_ROT(C0, 1));
+
+        /* Step mapping rho and pi combined into a single step */
+        D = KECCAK_LANES_A(0, 1);
+        KECCAK_LANES_A(0, 1) = KECCAK_LANES_RHO(KECCAK_LANES_A(1, 1), 44);
+        KECCAK_LANES_A(1, 1) = KECCAK_LANES_RHO(KECCAK_LANES_A(1, 4), 20);
+        KECCAK_LANES_A(1, 4) = KECCAK_LANES_RHO(KECCAK_LANES_A(4, 2), 61);
+        KECCAK_LANES_A(4, 2) = KECCAK_LANES_RHO(KECCAK_LANES_A(2, 4), 39);
+        KECCAK_LANES_A(2, 4) = KECCAK_LANES_RHO(KECCAK_LANES_A(4, 0), 18);
+        KECCAK_LANES_A(4, 0) = KECCAK_LANES_RHO(KECCAK_LANES_A(0, 2), 62);
+        KECCAK_LANES_A(0, 2) = KECCAK_LANES_RHO(KECCAK_LANES_A(2, 2), 43);
+        KECCAK_LANES_A(2, 2) = KECCAK_LANES_RHO(KECCAK_LANES_A(2, 3), 25);
+        KECCAK_LANES_A(2, 3) = KECCAK_LANES_RHO(KECCAK_LANES_A(3, 4), 8);
+        KECCAK_LANES_A(3, 4) = KECCAK_LANES_RHO(KECCAK_LANES_A(4, 3), 56);
+        KECCAK_LANES_A(4, 3) = KECCAK_LANES_RHO(KECCAK_LANES_A(3, 0), 41);
+        KECCAK_LANES_A(3, 0) = KECCAK_LANES_RHO(KECCAK_LANES_A(0, 4), 27);
+        KECCAK_LANES_A(0, 4) = KECCAK_LANES_RHO(KECCAK_LANES_A(4, 4), 14);
+        KECCAK_LANES_A(4, 4) = KECCAK_LANES_RHO(KECCAK_LANES_A(4, 1), 2);
+        KECCAK_LANES_A(4, 1) = KECCAK_LANES_RHO(KECCAK_LANES_A(1, 3), 55);
+        KECCAK_LANES_A(1, 3) = KECCAK_LANES_RHO(KECCAK_LANES_A(3, 1), 45);
+        KECCAK_LANES_A(3, 1) = KECCAK_LANES_RHO(KECCAK_LANES_A(1, 0), 36);
+        KECCAK_LANES_A(1, 0) = KECCAK_LANES_RHO(KECCAK_LANES_A(0, 3), 28);
+        KECCAK_LANES_A(0, 3) = KECCAK_LANES_RHO(KECCAK_LANES_A(3, 3), 21);
+        KECCAK_LANES_A(3, 3) = KECCAK_LANES_RHO(KECCAK_LANES_A(3, 2), 15);
+        KECCAK_LANES_A(3, 2) = KECCAK_LANES_RHO(KECCAK_LANES_A(2, 1), 10);
+        KECCAK_LANES_A(2, 1) = KECCAK_LANES_RHO(KECCAK_LANES_A(1, 2), 6);
+        KECCAK_LANES_A(1, 2) = KECCAK_LANES_RHO(KECCAK_LANES_A(2, 0), 3);
+        KECCAK_LANES_A(2, 0) = KECCAK_LANES_RHO(D, 1);
+
+        /* Step mapping chi.  Combine each lane with two others in its row */
+        for (index = 0; index < 5; ++index) {
+            C0 = KECCAK_LANES_A(index, 0);
+            C1 = KECCAK_LANES_A(index, 1);
+            C2 = KECCAK_LANES_A(index, 2);
+            C3 = KECCAK_LANES_A(index, 3);
+            C4 = KECCAK_LANES_A(index, 4);
+            KECCAK_LANES_A(index, 0) = C0 ^ ((~C1) & C2);
+            KECCAK_LANES_A(index, 1) = C1 ^ ((~C2) & C3);
+            KECCAK_LANES_A(index, 2) = C2 ^ ((~C3) & C4);
+            KECCAK_LANES_A(index, 3) = C3 ^ ((~C4) & C0);
+            KECCAK_LANES_A(index, 4) = C4 ^ ((~C0) & C1);
+        }
+
+        /* Step mapping iota.  XOR A[0][0] with the round constant */
+        KECCAK_LANES_A(0, 0) ^= KECCAK_LANES_BCAST(KECCAK_LANES_RC[round]);
+    }
+}
+
+/**
+ * \brief Permutes up to KECCAK_LANES Keccak-p states in parallel.
+ *
+ * \param states Points to the states to be permuted.
+ * \param count Number of states to permute, between 1 and KECCAK_LANES.
+ * \param rounds Number of rounds to perform, up to KECCAK_LANES_MAX_ROUNDS.
+ */
+static KECCAK_LANES_TARGET void KECCAK_LANES_CONCAT(KECCAK_LANES_NAME,_permute)
+    (KECCAK_LANES_STATE *states, unsigned count, unsigned rounds)
+{
+    KECCAK_LANES_SET s;
+    KECCAK_LANES_CONCAT(KECCAK_LANES_NAME,_load)(&s, states, count);
+    KECCAK_LANES_CONCAT(KECCAK_LANES_NAME,_rounds)(&s, rounds);
+    KECCAK_LANES_CONCAT(KECCAK_LANES_NAME,_store)(&s, states, count);
+}
+
+#if defined(KECCAK_LANES_ABSORB_BITS)
+
+/**
+ * \brief Absorbs data into up to KECCAK_LANES Keccak-p states one bit
+ * at a time, permuting after every bit.
+ *
+ * \param states Points to the states to absorb the data into.
+ * \param count Number of states, between 1 and KECCAK_LANES.
+ * \param data Points to the data to absorb into each of the states.
+ * \param num_bits Number of bits to absorb from each data buffer.
+ * \param rounds Number of rounds to perform after each bit.
+ *
+ * The states stay interleaved across all of the permutation calls.
+ */
+static KECCAK_LANES_TARGET void KECCAK_LANES_CONCAT
+    (KECCAK_LANES_NAME,_absorb_bits)
+    (KECCAK_LANES_STATE *states, unsigned count,
+     const unsigned char * const *data, unsigned num_bits, unsigned rounds)
+{
+    KECCAK_LANES_SET s;
+    unsigned bit, lane;
+    KECCAK_LANES_CONCAT(KECCAK_LANES_NAME,_load)(&s, states, count);
+    for (bit = 0; bit < num_bits; ++bit) {
+        /* The bit is XOR'ed into the high bit of the first byte */
+        for (lane = 0; lane < count; ++lane)
+            s.w[0][lane] ^= (data[lane][bit / 8] << (bit % 8)) & 0x80;
+        KECCAK_LANES_CONCAT(KECCAK_LANES_NAME,_rounds)(&s, rounds);
+    }
+    KECCAK_LANES_CONCAT(KECCAK_LANES_NAME,_store)(&s, states, count);
+}
+
+#endif /* KECCAK_LANES_ABSORB_BITS */
+
+#endif /* KECCAK_LANES_NAME */
+
+/* Now undefine everything so that we can include this file again for
+ * another kernel */
+#undef KECCAK_LANES_NAME
+#undef KECCAK_LANES
+#undef KECCAK_LANES_STATE
+#undef KECCAK_LANES_WORD
+#undef KECCAK_LANES_BITS
+#undef KECCAK_LANES_TYPE
+#undef KECCAK_LANES_ROT
+#undef KECCAK_LANES_BCAST
+#undef KECCAK_LANES_LOAD
+#undef KECCAK_LANES_STORE
+#undef KECCAK_LANES_RC
+#undef KECCAK_LANES_MAX_ROUNDS
+#undef KECCAK_LANES_TARGET
+#undef KECCAK_LANES_ABSORB_BITS
+#undef KECCAK_LANES_CONCAT_INNER
+#undef KECCAK_LANES_CONCAT
+#undef KECCAK_LANES_SET
+#undef KECCAK_LANES_A
+#undef KECCAK_LANES_COLUMN
+#undef KECCAK_LANES_THETA
+#undef KECCAK_LANES_RHO
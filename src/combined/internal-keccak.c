@@ -21,9 +21,24 @@
  */
 
 #include "internal-keccak.h"
+#include <string.h>
 
 #if !defined(__AVR__)
 
+/* Round constants for Keccak-p[200] */
+static uint8_t const keccakp_200_rc[18] = {
+    0x01, 0x82, 0x8A, 0x00, 0x8B, 0x01, 0x81, 0x09,
+    0x8A, 0x88, 0x09, 0x0A, 0x8B, 0x8B, 0x89, 0x03,
+    0x02, 0x80
+};
+
+/* Round constants for Keccak-p[400] */
+static uint16_t const keccakp_400_rc[20] = {
+    0x0001, 0x8082, 0x808A, 0x8000, 0x808B, 0x0001, 0x8081, 0x8009,
+    0x008A, 0x0088, 0x8009, 0x000A, 0x808B, 0x008B, 0x8089, 0x8003,
+    0x8002, 0x0080, 0x800A, 0x000A
+};
+
 /* Faster method to compute ((x + y) % 5) that avoids the division */
 static unsigned char const addMod5Table[9] = {
     0, 1, 2, 3, 4, 0, 1, 2, 3
@@ -32,11 +47,7 @@ static unsigned char const addMod5Table[9] = {
 
 void keccakp_200_permute(keccakp_200_state_t *state)
 {
-    static uint8_t const RC[18] = {
-        0x01, 0x82, 0x8A, 0x00, 0x8B, 0x01, 0x81, 0x09,
-        0x8A, 0x88, 0x09, 0x0A, 0x8B, 0x8B, 0x89, 0x03,
-        0x02, 0x80
-    };
+    const uint8_t *RC = keccakp_200_rc;
     uint8_t C[5];
     uint8_t D;
     unsigned round;
@@ -110,11 +121,7 @@ void keccakp_200_permute(keccakp_200_state_t *state)
 /* Keccak-p[400] that assumes that the input is already in host byte order */
 void keccakp_400_permute_host(keccakp_400_state_t *state, unsigned rounds)
 {
-    static uint16_t const RC[20] = {
-        0x0001, 0x8082, 0x808A, 0x8000, 0x808B, 0x0001, 0x8081, 0x8009,
-        0x008A, 0x0088, 0x8009, 0x000A, 0x808B, 0x008B, 0x8089, 0x8003,
-        0x8002, 0x0080, 0x800A, 0x000A
-    };
+    const uint16_t *RC = keccakp_400_rc;
     uint16_t C[5];
     uint16_t D;
     unsigned round;
@@ -211,4 +218,267 @@ void keccakp_400_permute(keccakp_400_state_t *state, unsigned rounds)
 
 #endif
 
+/* Load and store lanes of the Keccak-p states for the multi-lane kernels */
+#define keccakp_200_load_lane(s, i) ((s)->B[(i)])
+#define keccakp_200_store_lane(s, i, x) ((s)->B[(i)] = (x))
+#define keccakp_400_load_lane(s, i) (le_load_word16((s)->B + (i) * 2))
+#define keccakp_400_store_lane(s, i, x) le_store_word16((s)->B + (i) * 2, (x))
+
+/* Rotates all 8-bit or 16-bit lanes that are packed into a 64-bit word */
+#define KECCAK_REP8  0x0101010101010101ULL
+#define KECCAK_REP16 0x0001000100010001ULL
+#define keccak_rotate_packed(x, n, bits, rep, mask) \
+    ((((x) << (n)) & ((rep) * (((mask) << (n)) & (mask)))) | \
+     (((x) >> ((bits) - (n))) & ((rep) * ((mask) >> ((bits) - (n))))))
+#define keccak_rotate_packed8(x, n) \
+    keccak_rotate_packed((x), (n), 8, KECCAK_REP8, 0xFFU)
+#define keccak_rotate_packed16(x, n) \
+    keccak_rotate_packed((x), (n), 16, KECCAK_REP16, 0xFFFFU)
+
+/* Keccak-p[200] with 8 states packed into 64-bit words */
+#define KECCAK_LANES_NAME keccakp_200_x8
+#define KECCAK_LANES 8
+#define KECCAK_LANES_STATE keccakp_200_state_t
+#define KECCAK_LANES_WORD uint8_t
+#define KECCAK_LANES_BITS 8
+#define KECCAK_LANES_TYPE uint64_t
+#define KECCAK_LANES_ROT(x,n) keccak_rotate_packed8((x), (n))
+#define KECCAK_LANES_BCAST(x) (KECCAK_REP8 * (x))
+#define KECCAK_LANES_LOAD(s,i) keccakp_200_load_lane((s), (i))
+#define KECCAK_LANES_STORE(s,i,x) keccakp_200_store_lane((s), (i), (x))
+#define KECCAK_LANES_RC keccakp_200_rc
+#define KECCAK_LANES_MAX_ROUNDS 18
+#define KECCAK_LANES_TARGET
+#include "internal-keccak-lanes.h"
+
+/* Keccak-p[400] with 4 states packed into 64-bit words */
+#define KECCAK_LANES_NAME keccakp_400_x4
+#define KECCAK_LANES 4
+#define KECCAK_LANES_STATE keccakp_400_state_t
+#define KECCAK_LANES_WORD uint16_t
+#define KECCAK_LANES_BITS 16
+#define KECCAK_LANES_TYPE uint64_t
+#define KECCAK_LANES_ROT(x,n) keccak_rotate_packed16((x), (n))
+#define KECCAK_LANES_BCAST(x) (KECCAK_REP16 * (x))
+#define KECCAK_LANES_LOAD(s,i) keccakp_400_load_lane((s), (i))
+#define KECCAK_LANES_STORE(s,i,x) keccakp_400_store_lane((s), (i), (x))
+#define KECCAK_LANES_RC keccakp_400_rc
+#define KECCAK_LANES_MAX_ROUNDS 20
+#define KECCAK_LANES_TARGET
+#define KECCAK_LANES_ABSORB_BITS 1
+#include "internal-keccak-lanes.h"
+
+#if KECCAK_VECTOR
+
+/* Vector types with one Keccak-p lane in each element */
+typedef uint8_t keccak_u8x16_t __attribute__((vector_size(16)));
+typedef uint16_t keccak_u16x8_t __attribute__((vector_size(16)));
+typedef uint16_t keccak_u16x16_t __attribute__((vector_size(32)));
+
+/* Rotates all elements of a vector */
+#define keccak_rotate_vector(x, n, bits) \
+    (((x) << (n)) | ((x) >> (((bits) - (n)) % (bits))))
+
+/* Keccak-p[200] with 16 states in 128-bit vectors */
+#define KECCAK_LANES_NAME keccakp_200_x16
+#define KECCAK_LANES 16
+#define KECCAK_LANES_STATE keccakp_200_state_t
+#define KECCAK_LANES_WORD uint8_t
+#define KECCAK_LANES_BITS 8
+#define KECCAK_LANES_TYPE keccak_u8x16_t
+#define KECCAK_LANES_ROT(x,n) keccak_rotate_vector((x), (n), 8)
+#define KECCAK_LANES_BCAST(x) ((uint8_t)(x))
+#define KECCAK_LANES_LOAD(s,i) keccakp_200_load_lane((s), (i))
+#define KECCAK_LANES_STORE(s,i,x) keccakp_200_store_lane((s), (i), (x))
+#define KECCAK_LANES_RC keccakp_200_rc
+#define KECCAK_LANES_MAX_ROUNDS 18
+#define KECCAK_LANES_TARGET
+#include "internal-keccak-lanes.h"
+
+/* Keccak-p[400] with 8 states in 128-bit vectors */
+#define KECCAK_LANES_NAME keccakp_400_x8
+#define KECCAK_LANES 8
+#define KECCAK_LANES_STATE keccakp_400_state_t
+#define KECCAK_LANES_WORD uint16_t
+#define KECCAK_LANES_BITS 16
+#define KECCAK_LANES_TYPE keccak_u16x8_t
+#define KECCAK_LANES_ROT(x,n) keccak_rotate_vector((x), (n), 16)
+#define KECCAK_LANES_BCAST(x) ((uint16_t)(x))
+#define KECCAK_LANES_LOAD(s,i) keccakp_400_load_lane((s), (i))
+#define KECCAK_LANES_STORE(s,i,x) keccakp_400_store_lane((s), (i), (x))
+#define KECCAK_LANES_RC keccakp_400_rc
+#define KECCAK_LANES_MAX_ROUNDS 20
+#define KECCAK_LANES_TARGET
+#define KECCAK_LANES_ABSORB_BITS 1
+#include "internal-keccak-lanes.h"
+
+/* Keccak-p[400] with 16 states in 256-bit vectors for AVX2 */
+#if defined(__AVX2__) || KECCAK_SIMD_DISPATCH
+#define KECCAK_HAVE_400_X16 1
+#define KECCAK_LANES_NAME keccakp_400_x16
+#define KECCAK_LANES 16
+#define KECCAK_LANES_STATE keccakp_400_state_t
+#define KECCAK_LANES_WORD uint16_t
+#define KECCAK_LANES_BITS 16
+#define KECCAK_LANES_TYPE keccak_u16x16_t
+#define KECCAK_LANES_ROT(x,n) keccak_rotate_vector((x), (n), 16)
+#define KECCAK_LANES_BCAST(x) ((uint16_t)(x))
+#define KECCAK_LANES_LOAD(s,i) keccakp_400_load_lane((s), (i))
+#define KECCAK_LANES_STORE(s,i,x) keccakp_400_store_lane((s), (i), (x))
+#define KECCAK_LANES_RC keccakp_400_rc
+#define KECCAK_LANES_MAX_ROUNDS 20
+#define KECCAK_LANES_TARGET LW_TARGET_AVX2
+#define KECCAK_LANES_ABSORB_BITS 1
+#include "internal-keccak-lanes.h"
+#else
+#define KECCAK_HAVE_400_X16 0
+#endif
+
+#endif /* KECCAK_VECTOR */
+
+#endif /* !__AVR__ */
+
+void keccakp_200_permute_n(keccakp_200_state_t *states, unsigned count)
+{
+#if !defined(__AVR__)
+    unsigned n;
+#if KECCAK_VECTOR
+    while (count > 8) {
+        n = (count < 16) ? count : 16;
+        keccakp_200_x16_permute(states, n, 18);
+        states += n;
+        count -= n;
+    }
+#endif
+    while (count > 0) {
+        n = (count < 8) ? count : 8;
+        keccakp_200_x8_permute(states, n, 18);
+        states += n;
+        count -= n;
+    }
+#else
+    while (count > 0) {
+        keccakp_200_permute(states);
+        ++states;
+        --count;
+    }
+#endif
+}
+
+#if !defined(__AVR__)
+
+/**
+ * \brief Selects the width of the Keccak-p[400] kernel to use.
+ *
+ * \param count Number of states that are left to be processed.
+ *
+ * \return The number of lanes in the kernel; 16, 8, or 4.
+ */
+static unsigned keccakp_400_width(unsigned count)
+{
+#if KECCAK_VECTOR && KECCAK_HAVE_400_X16
+#if KECCAK_SIMD_DISPATCH
+    if (count > 8 && lw_simd_level() >= LW_SIMD_LEVEL_AVX2)
+        return 16;
+#else
+    if (count > 8)
+        return 16;
+#endif
+#endif
+#if KECCAK_VECTOR
+    if (count > 4)
+        return 8;
+#endif
+    (void)count;
+    return 4;
+}
+
 #endif /* !__AVR__ */
+
+void keccakp_400_permute_n
+    (keccakp_400_state_t *states, unsigned count, unsigned rounds)
+{
+#if !defined(__AVR__)
+    unsigned width, n;
+    while (count > 0) {
+        width = keccakp_400_width(count);
+        n = (count < width) ? count : width;
+        switch (width) {
+#if KECCAK_VECTOR && KECCAK_HAVE_400_X16
+        case 16: keccakp_400_x16_permute(states, n, rounds); break;
+#endif
+#if KECCAK_VECTOR
+        case 8:  keccakp_400_x8_permute(states, n, rounds); break;
+#endif
+        default: keccakp_400_x4_permute(states, n, rounds); break;
+        }
+        states += n;
+        count -= n;
+    }
+#else
+    while (count > 0) {
+        keccakp_400_permute(states, rounds);
+        ++states;
+        --count;
+    }
+#endif
+}
+
+void keccakp_400_absorb_bits_n
+    (keccakp_400_state_t *states, unsigned count,
+     const unsigned char * const *data, unsigned num_bits, unsigned rounds)
+{
+#if !defined(__AVR__)
+    unsigned width, n;
+    while (count > 0) {
+        width = keccakp_400_width(count);
+        n = (count < width) ? count : width;
+        switch (width) {
+#if KECCAK_VECTOR && KECCAK_HAVE_400_X16
+        case 16:
+            keccakp_400_x16_absorb_bits(states, n, data, num_bits, rounds);
+            break;
+#endif
+#if KECCAK_VECTOR
+        case 8:
+            keccakp_400_x8_absorb_bits(states, n, data, num_bits, rounds);
+            break;
+#endif
+        default:
+            keccakp_400_x4_absorb_bits(states, n, data, num_bits, rounds);
+            break;
+        }
+        states += n;
+        data += n;
+        count -= n;
+    }
+#else
+    unsigned bit;
+    while (count > 0) {
+        for (bit = 0; bit < num_bits; ++bit) {
+            states->B[0] ^= ((*data)[bit / 8] << (bit % 8)) & 0x80;
+            keccakp_400_permute(states, rounds);
+        }
+        ++states;
+        ++data;
+        --count;
+    }
+#endif
+}
+
+const char *keccak_multi_lane_variant(void)
+{
+#if KECCAK_VECTOR && KECCAK_SIMD_DISPATCH
+    if (lw_simd_level() >= LW_SIMD_LEVEL_AVX2)
+        return "AVX2";
+    return "Vector";
+#elif KECCAK_VECTOR && defined(__AVX2__)
+    return "AVX2";
+#elif KECCAK_VECTOR
+    return "Vector";
+#elif !defined(__AVR__)
+    return "64-bit";
+#else
+    return "C";
+#endif
+}
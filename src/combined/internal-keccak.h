@@ -80,6 +80,110 @@ void keccakp_200_permute(keccakp_200_state_t *state);
  */
 void keccakp_400_permute(keccakp_400_state_t *state, unsigned rounds);
 
+/**
+ * \brief Defined to 1 if the multi-lane Keccak-p kernels are selected
+ * at runtime according to the features of the CPU.
+ */
+#if LW_SIMD_DISPATCH && !defined(KECCAK_NO_SIMD_DISPATCH)
+#define KECCAK_SIMD_DISPATCH 1
+#else
+#define KECCAK_SIMD_DISPATCH 0
+#endif
+
+/**
+ * \brief Defined to 1 if the multi-lane Keccak-p kernels can be built
+ * with the vector extensions of GCC and clang.
+ */
+#if !defined(__AVR__) && (defined(__GNUC__) || defined(__clang__)) && \
+        (defined(__SSE2__) || defined(__ARM_NEON) || defined(__ARM_NEON__) || \
+         KECCAK_SIMD_DISPATCH)
+#define KECCAK_VECTOR 1
+#else
+#define KECCAK_VECTOR 0
+#endif
+
+/**
+ * \brief Number of Keccak-p[200] states that are permuted in parallel by
+ * the widest multi-lane kernel available on this platform.
+ *
+ * This is 16 for 128-bit vector units, 8 when the states are packed
+ * into 64-bit words, and 1 on AVR.
+ */
+#if KECCAK_VECTOR
+#define KECCAKP_200_MAX_LANES 16
+#elif !defined(__AVR__)
+#define KECCAKP_200_MAX_LANES 8
+#else
+#define KECCAKP_200_MAX_LANES 1
+#endif
+
+/**
+ * \brief Number of Keccak-p[400] states that are permuted in parallel by
+ * the widest multi-lane kernel available on this platform.
+ *
+ * This is 16 when AVX2 may be available, 8 for other 128-bit vector units,
+ * 4 when the states are packed into 64-bit words, and 1 on AVR.
+ */
+#if (defined(__AVX2__) && KECCAK_VECTOR) || KECCAK_SIMD_DISPATCH
+#define KECCAKP_400_MAX_LANES 16
+#elif KECCAK_VECTOR
+#define KECCAKP_400_MAX_LANES 8
+#elif !defined(__AVR__)
+#define KECCAKP_400_MAX_LANES 4
+#else
+#define KECCAKP_400_MAX_LANES 1
+#endif
+
+/**
+ * \brief Permutes several Keccak-p[200] states.
+ *
+ * \param states Points to an array of states to be permuted.
+ * \param count Number of states in the array.
+ *
+ * The states are processed up to KECCAKP_200_MAX_LANES at a time.
+ */
+void keccakp_200_permute_n(keccakp_200_state_t *states, unsigned count);
+
+/**
+ * \brief Permutes several Keccak-p[400] states, which are assumed to be
+ * in little-endian byte order.
+ *
+ * \param states Points to an array of states to be permuted.
+ * \param count Number of states in the array.
+ * \param rounds The number of rounds to perform (up to 20).
+ *
+ * The states are processed up to KECCAKP_400_MAX_LANES at a time.
+ */
+void keccakp_400_permute_n
+    (keccakp_400_state_t *states, unsigned count, unsigned rounds);
+
+/**
+ * \brief Absorbs data into several Keccak-p[400] states one bit at a time.
+ *
+ * \param states Points to an array of states, which are assumed to be
+ * in little-endian byte order.
+ * \param count Number of states in the array.
+ * \param data Points to an array of \a count data buffers, one per state.
+ * \param num_bits Number of bits to absorb from each data buffer.
+ * \param rounds The number of rounds to perform after each bit (up to 20).
+ *
+ * Each bit is XOR'ed into the high bit of the first byte of its state,
+ * starting with the high bit of the first data byte, and then the state
+ * is permuted.  This is the bulk of the re-keying operation in ISAP.
+ * The states stay interleaved between permutations, which avoids the
+ * cost of transposing them on every call to keccakp_400_permute_n().
+ */
+void keccakp_400_absorb_bits_n
+    (keccakp_400_state_t *states, unsigned count,
+     const unsigned char * const *data, unsigned num_bits, unsigned rounds);
+
+/**
+ * \brief Gets the name of the multi-lane Keccak-p kernels that are in use.
+ *
+ * \return One of "AVX2", "Vector", "64-bit", or "C".
+ */
+const char *keccak_multi_lane_variant(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2020 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* Renames the external symbols of the masked ciphers and permutations for
+ * an extra instance of the masked code with a fixed number of shares.
+ *
+ * This file is included by internal-masking.h when AEAD_MASKING_INSTANCE
+ * is defined to the number of shares.  Each masked source file includes
+ * internal-masking.h before any other header so that the declarations in
+ * the public headers are renamed along with the definitions.  Every
+ * external symbol that is defined by a masked source file must be listed
+ * here, or else the instances will clash with each other at link time.
+ */
+
+#ifndef LW_INTERNAL_MASKING_INSTANCE_H
+#define LW_INTERNAL_MASKING_INSTANCE_H
+
+#define AEAD_MASKING_RENAME_INNER(name, shares) name##_x##shares
+#define AEAD_MASKING_RENAME_OUTER(name, shares) \
+    AEAD_MASKING_RENAME_INNER(name, shares)
+#define AEAD_MASKING_RENAME(name) \
+    AEAD_MASKING_RENAME_OUTER(name, AEAD_MASKING_INSTANCE)
+
+/* ASCON */
+#define ascon128_masked_cipher AEAD_MASKING_RENAME(ascon128_masked_cipher)
+#define ascon128a_masked_cipher AEAD_MASKING_RENAME(ascon128a_masked_cipher)
+#define ascon80pq_masked_cipher AEAD_MASKING_RENAME(ascon80pq_masked_cipher)
+#define ascon128_masked_aead_encrypt AEAD_MASKING_RENAME(ascon128_masked_aead_encrypt)
+#define ascon128_masked_aead_decrypt AEAD_MASKING_RENAME(ascon128_masked_aead_decrypt)
+#define ascon128a_masked_aead_encrypt AEAD_MASKING_RENAME(ascon128a_masked_aead_encrypt)
+#define ascon128a_masked_aead_decrypt AEAD_MASKING_RENAME(ascon128a_masked_aead_decrypt)
+#define ascon80pq_masked_aead_encrypt AEAD_MASKING_RENAME(ascon80pq_masked_aead_encrypt)
+#define ascon80pq_masked_aead_decrypt AEAD_MASKING_RENAME(ascon80pq_masked_aead_decrypt)
+#define ascon_permute_masked AEAD_MASKING_RENAME(ascon_permute_masked)
+#define ascon_masked_variant AEAD_MASKING_RENAME(ascon_masked_variant)
+#define ascon_mask AEAD_MASKING_RENAME(ascon_mask)
+#define ascon_unmask AEAD_MASKING_RENAME(ascon_unmask)
+#define ascon_mask_sliced AEAD_MASKING_RENAME(ascon_mask_sliced)
+#define ascon_unmask_sliced AEAD_MASKING_RENAME(ascon_unmask_sliced)
+
+/* GIFT-COFB and GIFT-128 */
+#define gift_cofb_masked_cipher AEAD_MASKING_RENAME(gift_cofb_masked_cipher)
+#define gift_cofb_masked_aead_encrypt AEAD_MASKING_RENAME(gift_cofb_masked_aead_encrypt)
+#define gift_cofb_masked_aead_decrypt AEAD_MASKING_RENAME(gift_cofb_masked_aead_decrypt)
+#define gift128b_init_masked AEAD_MASKING_RENAME(gift128b_init_masked)
+#define gift128b_encrypt_masked AEAD_MASKING_RENAME(gift128b_encrypt_masked)
+#define gift128b_encrypt_preloaded_masked AEAD_MASKING_RENAME(gift128b_encrypt_preloaded_masked)
+#define gift128b_decrypt_masked AEAD_MASKING_RENAME(gift128b_decrypt_masked)
+#define gift128n_init_masked AEAD_MASKING_RENAME(gift128n_init_masked)
+#define gift128n_encrypt_masked AEAD_MASKING_RENAME(gift128n_encrypt_masked)
+#define gift128n_decrypt_masked AEAD_MASKING_RENAME(gift128n_decrypt_masked)
+#define gift128t_encrypt_masked AEAD_MASKING_RENAME(gift128t_encrypt_masked)
+#define gift128t_decrypt_masked AEAD_MASKING_RENAME(gift128t_decrypt_masked)
+
+/* GIMLI-24 */
+#define gimli24_masked_cipher AEAD_MASKING_RENAME(gimli24_masked_cipher)
+#define gimli24_masked_aead_encrypt AEAD_MASKING_RENAME(gimli24_masked_aead_encrypt)
+#define gimli24_masked_aead_decrypt AEAD_MASKING_RENAME(gimli24_masked_aead_decrypt)
+#define gimli24_permute_masked AEAD_MASKING_RENAME(gimli24_permute_masked)
+#define gimli24_mask AEAD_MASKING_RENAME(gimli24_mask)
+#define gimli24_unmask AEAD_MASKING_RENAME(gimli24_unmask)
+
+/* KNOT */
+#define knot_aead_128_256_masked_cipher AEAD_MASKING_RENAME(knot_aead_128_256_masked_cipher)
+#define knot_aead_128_384_masked_cipher AEAD_MASKING_RENAME(knot_aead_128_384_masked_cipher)
+#define knot_aead_192_384_masked_cipher AEAD_MASKING_RENAME(knot_aead_192_384_masked_cipher)
+#define knot_aead_256_512_masked_cipher AEAD_MASKING_RENAME(knot_aead_256_512_masked_cipher)
+#define knot_masked_128_256_aead_encrypt AEAD_MASKING_RENAME(knot_masked_128_256_aead_encrypt)
+#define knot_masked_128_256_aead_decrypt AEAD_MASKING_RENAME(knot_masked_128_256_aead_decrypt)
+#define knot_masked_128_384_aead_encrypt AEAD_MASKING_RENAME(knot_masked_128_384_aead_encrypt)
+#define knot_masked_128_384_aead_decrypt AEAD_MASKING_RENAME(knot_masked_128_384_aead_decrypt)
+#define knot_masked_192_384_aead_encrypt AEAD_MASKING_RENAME(knot_masked_192_384_aead_encrypt)
+#define knot_masked_192_384_aead_decrypt AEAD_MASKING_RENAME(knot_masked_192_384_aead_decrypt)
+#define knot_masked_256_512_aead_encrypt AEAD_MASKING_RENAME(knot_masked_256_512_aead_encrypt)
+#define knot_masked_256_512_aead_decrypt AEAD_MASKING_RENAME(knot_masked_256_512_aead_decrypt)
+#define knot256_masked_permute_6 AEAD_MASKING_RENAME(knot256_masked_permute_6)
+#define knot256_masked_permute_7 AEAD_MASKING_RENAME(knot256_masked_permute_7)
+#define knot384_masked_permute_7 AEAD_MASKING_RENAME(knot384_masked_permute_7)
+#define knot512_masked_permute_7 AEAD_MASKING_RENAME(knot512_masked_permute_7)
+#define knot512_masked_permute_8 AEAD_MASKING_RENAME(knot512_masked_permute_8)
+#define knot256_mask AEAD_MASKING_RENAME(knot256_mask)
+#define knot256_unmask AEAD_MASKING_RENAME(knot256_unmask)
+#define knot384_mask AEAD_MASKING_RENAME(knot384_mask)
+#define knot384_unmask AEAD_MASKING_RENAME(knot384_unmask)
+#define knot512_mask AEAD_MASKING_RENAME(knot512_mask)
+#define knot512_unmask AEAD_MASKING_RENAME(knot512_unmask)
+
+/* Pyjamask */
+#define pyjamask_masked_128_cipher AEAD_MASKING_RENAME(pyjamask_masked_128_cipher)
+#define pyjamask_masked_96_cipher AEAD_MASKING_RENAME(pyjamask_masked_96_cipher)
+#define pyjamask_masked_128_aead_encrypt AEAD_MASKING_RENAME(pyjamask_masked_128_aead_encrypt)
+#define pyjamask_masked_128_aead_decrypt AEAD_MASKING_RENAME(pyjamask_masked_128_aead_decrypt)
+#define pyjamask_masked_96_aead_encrypt AEAD_MASKING_RENAME(pyjamask_masked_96_aead_encrypt)
+#define pyjamask_masked_96_aead_decrypt AEAD_MASKING_RENAME(pyjamask_masked_96_aead_decrypt)
+#define pyjamask_masked_128_setup_key AEAD_MASKING_RENAME(pyjamask_masked_128_setup_key)
+#define pyjamask_masked_128_encrypt AEAD_MASKING_RENAME(pyjamask_masked_128_encrypt)
+#define pyjamask_masked_128_decrypt AEAD_MASKING_RENAME(pyjamask_masked_128_decrypt)
+#define pyjamask_masked_96_setup_key AEAD_MASKING_RENAME(pyjamask_masked_96_setup_key)
+#define pyjamask_masked_96_encrypt AEAD_MASKING_RENAME(pyjamask_masked_96_encrypt)
+#define pyjamask_masked_96_decrypt AEAD_MASKING_RENAME(pyjamask_masked_96_decrypt)
+
+/* SPIX, SpoC, and sLiSCP-light */
+#define spix_masked_cipher AEAD_MASKING_RENAME(spix_masked_cipher)
+#define spix_masked_aead_encrypt AEAD_MASKING_RENAME(spix_masked_aead_encrypt)
+#define spix_masked_aead_decrypt AEAD_MASKING_RENAME(spix_masked_aead_decrypt)
+#define spoc_128_masked_cipher AEAD_MASKING_RENAME(spoc_128_masked_cipher)
+#define spoc_64_masked_cipher AEAD_MASKING_RENAME(spoc_64_masked_cipher)
+#define spoc_128_masked_aead_encrypt AEAD_MASKING_RENAME(spoc_128_masked_aead_encrypt)
+#define spoc_128_masked_aead_decrypt AEAD_MASKING_RENAME(spoc_128_masked_aead_decrypt)
+#define spoc_64_masked_aead_encrypt AEAD_MASKING_RENAME(spoc_64_masked_aead_encrypt)
+#define spoc_64_masked_aead_decrypt AEAD_MASKING_RENAME(spoc_64_masked_aead_decrypt)
+#define sliscp_light192_permute_masked AEAD_MASKING_RENAME(sliscp_light192_permute_masked)
+#define sliscp_light192_reduce_masked AEAD_MASKING_RENAME(sliscp_light192_reduce_masked)
+#define sliscp_light192_mask AEAD_MASKING_RENAME(sliscp_light192_mask)
+#define sliscp_light192_unmask AEAD_MASKING_RENAME(sliscp_light192_unmask)
+#define sliscp_light256_permute_masked AEAD_MASKING_RENAME(sliscp_light256_permute_masked)
+#define sliscp_light256_mask AEAD_MASKING_RENAME(sliscp_light256_mask)
+#define sliscp_light256_unmask AEAD_MASKING_RENAME(sliscp_light256_unmask)
+#define sliscp_light320_permute_masked AEAD_MASKING_RENAME(sliscp_light320_permute_masked)
+#define sliscp_light320_mask AEAD_MASKING_RENAME(sliscp_light320_mask)
+#define sliscp_light320_unmask AEAD_MASKING_RENAME(sliscp_light320_unmask)
+
+/* Spook and Clyde-128 */
+#define spook_128_512_su_masked_cipher AEAD_MASKING_RENAME(spook_128_512_su_masked_cipher)
+#define spook_128_384_su_masked_cipher AEAD_MASKING_RENAME(spook_128_384_su_masked_cipher)
+#define spook_128_512_mu_masked_cipher AEAD_MASKING_RENAME(spook_128_512_mu_masked_cipher)
+#define spook_128_384_mu_masked_cipher AEAD_MASKING_RENAME(spook_128_384_mu_masked_cipher)
+#define spook_128_512_su_masked_aead_encrypt AEAD_MASKING_RENAME(spook_128_512_su_masked_aead_encrypt)
+#define spook_128_512_su_masked_aead_decrypt AEAD_MASKING_RENAME(spook_128_512_su_masked_aead_decrypt)
+#define spook_128_384_su_masked_aead_encrypt AEAD_MASKING_RENAME(spook_128_384_su_masked_aead_encrypt)
+#define spook_128_384_su_masked_aead_decrypt AEAD_MASKING_RENAME(spook_128_384_su_masked_aead_decrypt)
+#define spook_128_512_mu_masked_aead_encrypt AEAD_MASKING_RENAME(spook_128_512_mu_masked_aead_encrypt)
+#define spook_128_512_mu_masked_aead_decrypt AEAD_MASKING_RENAME(spook_128_512_mu_masked_aead_decrypt)
+#define spook_128_384_mu_masked_aead_encrypt AEAD_MASKING_RENAME(spook_128_384_mu_masked_aead_encrypt)
+#define spook_128_384_mu_masked_aead_decrypt AEAD_MASKING_RENAME(spook_128_384_mu_masked_aead_decrypt)
+#define clyde128_encrypt_masked AEAD_MASKING_RENAME(clyde128_encrypt_masked)
+#define clyde128_decrypt_masked AEAD_MASKING_RENAME(clyde128_decrypt_masked)
+
+/* TinyJAMBU */
+#define tiny_jambu_128_masked_cipher AEAD_MASKING_RENAME(tiny_jambu_128_masked_cipher)
+#define tiny_jambu_192_masked_cipher AEAD_MASKING_RENAME(tiny_jambu_192_masked_cipher)
+#define tiny_jambu_256_masked_cipher AEAD_MASKING_RENAME(tiny_jambu_256_masked_cipher)
+#define tiny_jambu_128_masked_aead_encrypt AEAD_MASKING_RENAME(tiny_jambu_128_masked_aead_encrypt)
+#define tiny_jambu_128_masked_aead_decrypt AEAD_MASKING_RENAME(tiny_jambu_128_masked_aead_decrypt)
+#define tiny_jambu_192_masked_aead_encrypt AEAD_MASKING_RENAME(tiny_jambu_192_masked_aead_encrypt)
+#define tiny_jambu_192_masked_aead_decrypt AEAD_MASKING_RENAME(tiny_jambu_192_masked_aead_decrypt)
+#define tiny_jambu_256_masked_aead_encrypt AEAD_MASKING_RENAME(tiny_jambu_256_masked_aead_encrypt)
+#define tiny_jambu_256_masked_aead_decrypt AEAD_MASKING_RENAME(tiny_jambu_256_masked_aead_decrypt)
+#define tiny_jambu_permutation_masked AEAD_MASKING_RENAME(tiny_jambu_permutation_masked)
+
+/* Xoodyak and Xoodoo */
+#define xoodyak_masked_cipher AEAD_MASKING_RENAME(xoodyak_masked_cipher)
+#define xoodyak_masked_aead_encrypt AEAD_MASKING_RENAME(xoodyak_masked_aead_encrypt)
+#define xoodyak_masked_aead_decrypt AEAD_MASKING_RENAME(xoodyak_masked_aead_decrypt)
+#define xoodoo_permute_masked AEAD_MASKING_RENAME(xoodoo_permute_masked)
+#define xoodoo_mask AEAD_MASKING_RENAME(xoodoo_mask)
+#define xoodoo_unmask AEAD_MASKING_RENAME(xoodoo_unmask)
+
+#endif
@@ -43,10 +43,35 @@ extern "C" {
  *
  * This value should be between 2 and 6.  If left undefined, the default is 4.
  */
-#if !defined(AEAD_MASKING_SHARES)
+#if defined(AEAD_MASKING_INSTANCE)
+#undef AEAD_MASKING_SHARES
+#define AEAD_MASKING_SHARES AEAD_MASKING_INSTANCE
+#elif !defined(AEAD_MASKING_SHARES)
 #define AEAD_MASKING_SHARES 4
 #endif
 
+/**
+ * \def AEAD_MASKING_CIPHER_NAME
+ * \brief Name of a masked cipher in its meta-information block.
+ *
+ * \param name The name of the cipher, as a string literal.
+ *
+ * The masked ciphers are compiled once with AEAD_MASKING_SHARES shares and
+ * then once more for each of 2, 3, and 4 shares with AEAD_MASKING_INSTANCE
+ * defined to the number of shares.  The extra instances have "_x2", "_x3",
+ * or "_x4" appended to their symbol names by internal-masking-instance.h
+ * and "-x2", "-x3", or "-x4" appended to their cipher names.
+ */
+#if defined(AEAD_MASKING_INSTANCE)
+#define AEAD_MASKING_STR_INNER(value) #value
+#define AEAD_MASKING_STR(value) AEAD_MASKING_STR_INNER(value)
+#define AEAD_MASKING_CIPHER_NAME(name) \
+    name "-x" AEAD_MASKING_STR(AEAD_MASKING_INSTANCE)
+#include "internal-masking-instance.h"
+#else
+#define AEAD_MASKING_CIPHER_NAME(name) name
+#endif
+
 /**
  * \def AEAD_MASKING_KEY_ONLY
  * \brief Degree of masking to apply to AEAD modes.
@@ -65,6 +90,31 @@ extern "C" {
 #define AEAD_MASKING_KEY_ONLY 0
 #endif
 
+/**
+ * \brief Default pool of random words for the calling thread, which is
+ * refilled from the default context in aead-random.c.
+ *
+ * The pool is emptied by aead_random_init() and wiped by
+ * aead_random_finish().  Code that includes this file must be compiled
+ * with the same LW_USE_PTHREADS setting as the library.
+ */
+extern AEAD_RANDOM_THREAD_LOCAL aead_random_pool_t aead_random_default_pool;
+
+/**
+ * \brief Generates a fresh random 32-bit word for masking.
+ *
+ * Words are taken from the calling thread's pool of pre-generated
+ * random words so that most calls do not need to enter the generator.
+ */
+#define mask_random_32() \
+    (aead_random_pool_generate_32(&aead_random_default_pool))
+
+/**
+ * \brief Generates a fresh random 64-bit word for masking.
+ */
+#define mask_random_64() \
+    (aead_random_pool_generate_64(&aead_random_default_pool))
+
 /**
  * \brief Masked 16-bit word with two shares.
  */
@@ -254,9 +304,9 @@ typedef struct
 #define mask_x2_input(value, input) \
     do { \
         if (sizeof((value).b) <= 4) \
-            (value).b = aead_random_generate_32(); \
+            (value).b = mask_random_32(); \
         else \
-            (value).b = aead_random_generate_64(); \
+            (value).b = mask_random_64(); \
         (value).a = (input) ^ (value).b; \
     } while (0)
 
@@ -340,9 +390,9 @@ typedef struct
 #define mask_mix_and(x2, x1, x0, y2, y1, y0) \
     do { \
         if (sizeof(temp) <= 4) \
-            temp = aead_random_generate_32(); \
+            temp = mask_random_32(); \
         else \
-            temp = aead_random_generate_64(); \
+            temp = mask_random_64(); \
         (x2) ^= temp; \
         temp ^= ((y0) & (x1)); \
         (y2) = ((y2) ^ temp) ^ ((y1) & (x0)); \
@@ -523,11 +573,11 @@ typedef struct
 #define mask_x3_input(value, input) \
     do { \
         if (sizeof((value).b) <= 4) { \
-            (value).b = aead_random_generate_32(); \
-            (value).c = aead_random_generate_32(); \
+            (value).b = mask_random_32(); \
+            (value).c = mask_random_32(); \
         } else { \
-            (value).b = aead_random_generate_64(); \
-            (value).c = aead_random_generate_64(); \
+            (value).b = mask_random_64(); \
+            (value).c = mask_random_64(); \
         } \
         (value).a = (input) ^ (value).b ^ (value).c; \
     } while (0)
@@ -796,13 +846,13 @@ typedef struct
 #define mask_x4_input(value, input) \
     do { \
         if (sizeof((value).b) <= 4) { \
-            (value).b = aead_random_generate_32(); \
-            (value).c = aead_random_generate_32(); \
-            (value).d = aead_random_generate_32(); \
+            (value).b = mask_random_32(); \
+            (value).c = mask_random_32(); \
+            (value).d = mask_random_32(); \
         } else { \
-            (value).b = aead_random_generate_64(); \
-            (value).c = aead_random_generate_64(); \
-            (value).d = aead_random_generate_64(); \
+            (value).b = mask_random_64(); \
+            (value).c = mask_random_64(); \
+            (value).d = mask_random_64(); \
         } \
         (value).a = (input) ^ (value).b ^ (value).c ^ (value).d; \
     } while (0)
@@ -1105,15 +1155,15 @@ typedef struct
 #define mask_x5_input(value, input) \
     do { \
         if (sizeof((value).b) <= 4) { \
-            (value).b = aead_random_generate_32(); \
-            (value).c = aead_random_generate_32(); \
-            (value).d = aead_random_generate_32(); \
-            (value).e = aead_random_generate_32(); \
+            (value).b = mask_random_32(); \
+            (value).c = mask_random_32(); \
+            (value).d = mask_random_32(); \
+            (value).e = mask_random_32(); \
         } else { \
-            (value).b = aead_random_generate_64(); \
-            (value).c = aead_random_generate_64(); \
-            (value).d = aead_random_generate_64(); \
-            (value).e = aead_random_generate_64(); \
+            (value).b = mask_random_64(); \
+            (value).c = mask_random_64(); \
+            (value).d = mask_random_64(); \
+            (value).e = mask_random_64(); \
         } \
         (value).a = (input) ^ (value).b ^ (value).c ^ (value).d ^ (value).e; \
     } while (0)
@@ -1457,17 +1507,17 @@ typedef struct
 #define mask_x6_input(value, input) \
     do { \
         if (sizeof((value).b) <= 4) { \
-            (value).b = aead_random_generate_32(); \
-            (value).c = aead_random_generate_32(); \
-            (value).d = aead_random_generate_32(); \
-            (value).e = aead_random_generate_32(); \
-            (value).f = aead_random_generate_32(); \
+            (value).b = mask_random_32(); \
+            (value).c = mask_random_32(); \
+            (value).d = mask_random_32(); \
+            (value).e = mask_random_32(); \
+            (value).f = mask_random_32(); \
         } else { \
-            (value).b = aead_random_generate_64(); \
-            (value).c = aead_random_generate_64(); \
-            (value).d = aead_random_generate_64(); \
-            (value).e = aead_random_generate_64(); \
-            (value).f = aead_random_generate_64(); \
+            (value).b = mask_random_64(); \
+            (value).c = mask_random_64(); \
+            (value).d = mask_random_64(); \
+            (value).e = mask_random_64(); \
+            (value).f = mask_random_64(); \
         } \
         (value).a = (input) ^ (value).b ^ (value).c ^ \
                   (value).d ^ (value).e ^ (value).f; \
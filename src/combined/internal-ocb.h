@@ -37,7 +37,16 @@
  * OCB_SETUP_KEY        Name of the key schedule setup function.
  * OCB_ENCRYPT_BLOCK    Name of the block cipher ECB encrypt function.
  * OCB_DECRYPT_BLOCK    Name of the block cipher ECB decrypt function.
+ * OCB_ENCRYPT_BLOCKS   Name of a function that encrypts several blocks
+ *                      at once: (ks, output, input, count) (optional).
+ * OCB_DECRYPT_BLOCKS   Name of a function that decrypts several blocks
+ *                      at once: (ks, output, input, count) (optional).
+ * OCB_PARALLEL_BLOCKS  Maximum number of blocks to pass to
+ *                      OCB_ENCRYPT_BLOCKS and OCB_DECRYPT_BLOCKS.
+ * OCB_L_TABLE_SIZE     Number of L_i values to precompute (optional).
  * OCB_DOUBLE_L         Name of the function to double L (optional).
+ * OCB_KEY_CONTEXT      Defined to 1 to generate the functions for the
+ *                      precomputed key context API (optional).
  */
 #if defined(OCB_ENCRYPT_BLOCK)
 
@@ -58,6 +67,24 @@
 #define OCB_CONCAT_INNER(name,suffix) name##suffix
 #define OCB_CONCAT(name,suffix) OCB_CONCAT_INNER(name,suffix)
 
+#if !defined(OCB_ENCRYPT_BLOCKS)
+/* No multi-block support, so process a single block at a time */
+#undef OCB_PARALLEL_BLOCKS
+#define OCB_PARALLEL_BLOCKS 1
+#define OCB_ENCRYPT_BLOCKS(ks,out,in,count) OCB_ENCRYPT_BLOCK((ks),(out),(in))
+#define OCB_DECRYPT_BLOCKS(ks,out,in,count) OCB_DECRYPT_BLOCK((ks),(out),(in))
+#endif
+
+#if !defined(OCB_L_TABLE_SIZE)
+#if defined(__AVR__)
+/* Only cache L_0 and L_1 to keep the key context small on AVR */
+#define OCB_L_TABLE_SIZE 2
+#else
+/* Cache L_0 ... L_15 which covers messages of up to 2^16 blocks */
+#define OCB_L_TABLE_SIZE 16
+#endif
+#endif
+
 #if !defined(OCB_DOUBLE_L)
 
 #define OCB_DOUBLE_L OCB_CONCAT(OCB_ALG_NAME,_double_l)
@@ -94,34 +121,41 @@ static void OCB_DOUBLE_L
 
 #endif
 
-/* State information for OCB functions */
+/* State information for OCB functions, which is also the key context */
 #define OCB_STATE OCB_CONCAT(OCB_ALG_NAME,_state_t)
 typedef struct
 {
     OCB_KEY_SCHEDULE ks;
     unsigned char Lstar[OCB_BLOCK_SIZE];
     unsigned char Ldollar[OCB_BLOCK_SIZE];
-    unsigned char L0[OCB_BLOCK_SIZE];
-    unsigned char L1[OCB_BLOCK_SIZE];
+    unsigned char L[OCB_L_TABLE_SIZE][OCB_BLOCK_SIZE];
 
 } OCB_STATE;
 
-/* Initializes the OCB state from the key and nonce */
-static void OCB_CONCAT(OCB_ALG_NAME,_init)
-    (OCB_STATE *state, const unsigned char *k, const unsigned char *nonce,
-     unsigned char offset[OCB_BLOCK_SIZE])
+/* Initializes the OCB state from the key */
+static void OCB_CONCAT(OCB_ALG_NAME,_init_key)
+    (OCB_STATE *state, const unsigned char *k)
 {
-    unsigned bottom;
+    unsigned index;
 
     /* Set up the key schedule */
     OCB_SETUP_KEY(&(state->ks), k);
 
-    /* Derive the values of L*, L$, L0, and L1 */
+    /* Derive the values of L*, L$, and the table of L_i values */
     memset(state->Lstar, 0, sizeof(state->Lstar));
     OCB_ENCRYPT_BLOCK(&(state->ks), state->Lstar, state->Lstar);
     OCB_DOUBLE_L(state->Ldollar, state->Lstar);
-    OCB_DOUBLE_L(state->L0, state->Ldollar);
-    OCB_DOUBLE_L(state->L1, state->L0);
+    OCB_DOUBLE_L(state->L[0], state->Ldollar);
+    for (index = 1; index < OCB_L_TABLE_SIZE; ++index)
+        OCB_DOUBLE_L(state->L[index], state->L[index - 1]);
+}
+
+/* Derives the initial offset from the nonce */
+static void OCB_CONCAT(OCB_ALG_NAME,_init_nonce)
+    (const OCB_STATE *state, const unsigned char *nonce,
+     unsigned char offset[OCB_BLOCK_SIZE])
+{
+    unsigned bottom;
 
     /* Derive the initial offset from the nonce */
     memset(offset, 0, OCB_BLOCK_SIZE);
@@ -165,45 +199,62 @@ static void OCB_CONCAT(OCB_ALG_NAME,_init)
     }
 }
 
-/* Calculate L_{ntz(i)} when the last two bits of i are zero */
-static void OCB_CONCAT(OCB_ALG_NAME,_calculate_L)
-    (OCB_STATE *state, unsigned char L[OCB_BLOCK_SIZE], unsigned long long i)
+/* Gets L_{ntz(i)} from the table, or calculates it in L if it is
+ * beyond the end of the table */
+static const unsigned char *OCB_CONCAT(OCB_ALG_NAME,_get_L)
+    (const OCB_STATE *state, unsigned char L[OCB_BLOCK_SIZE],
+     unsigned long long i)
 {
-    OCB_DOUBLE_L(L, state->L1);
-    i >>= 2;
+    unsigned ntz = 0;
     while ((i & 1) == 0) {
-        OCB_DOUBLE_L(L, L);
+        ++ntz;
         i >>= 1;
     }
+    if (ntz < OCB_L_TABLE_SIZE)
+        return state->L[ntz];
+    ntz -= OCB_L_TABLE_SIZE - 1;
+    OCB_DOUBLE_L(L, state->L[OCB_L_TABLE_SIZE - 1]);
+    while (--ntz > 0)
+        OCB_DOUBLE_L(L, L);
+    return L;
 }
 
+/* Advances the offset for the next full block and copies it to "out" */
+#define OCB_NEXT_OFFSET(out) \
+    do { \
+        lw_xor_block \
+            (offset, OCB_CONCAT(OCB_ALG_NAME,_get_L) \
+                (state, L, block_number), OCB_BLOCK_SIZE); \
+        memcpy((out), offset, OCB_BLOCK_SIZE); \
+        ++block_number; \
+    } while (0)
+
 /* Process associated data with OCB */
 static void OCB_CONCAT(OCB_ALG_NAME,_process_ad)
-    (OCB_STATE *state, unsigned char tag[OCB_BLOCK_SIZE],
+    (const OCB_STATE *state, unsigned char tag[OCB_BLOCK_SIZE],
      const unsigned char *ad, unsigned long long adlen)
 {
     unsigned char offset[OCB_BLOCK_SIZE];
-    unsigned char block[OCB_BLOCK_SIZE];
+    unsigned char block[OCB_PARALLEL_BLOCKS * OCB_BLOCK_SIZE];
+    unsigned char L[OCB_BLOCK_SIZE];
     unsigned long long block_number;
+    unsigned count, index;
 
-    /* Process all full blocks */
+    /* Process all full blocks, up to OCB_PARALLEL_BLOCKS at a time */
     memset(offset, 0, sizeof(offset));
     block_number = 1;
     while (adlen >= OCB_BLOCK_SIZE) {
-        if (block_number & 1) {
-            lw_xor_block(offset, state->L0, OCB_BLOCK_SIZE);
-        } else if ((block_number & 3) == 2) {
-            lw_xor_block(offset, state->L1, OCB_BLOCK_SIZE);
-        } else {
-            OCB_CONCAT(OCB_ALG_NAME,_calculate_L)(state, block, block_number);
-            lw_xor_block(offset, block, OCB_BLOCK_SIZE);
-        }
-        lw_xor_block_2_src(block, offset, ad, OCB_BLOCK_SIZE);
-        OCB_ENCRYPT_BLOCK(&(state->ks), block, block);
-        lw_xor_block(tag, block, OCB_BLOCK_SIZE);
-        ad += OCB_BLOCK_SIZE;
-        adlen -= OCB_BLOCK_SIZE;
-        ++block_number;
+        count = OCB_PARALLEL_BLOCKS;
+        if ((adlen / OCB_BLOCK_SIZE) < count)
+            count = (unsigned)(adlen / OCB_BLOCK_SIZE);
+        for (index = 0; index < count; ++index)
+            OCB_NEXT_OFFSET(block + index * OCB_BLOCK_SIZE);
+        lw_xor_block(block, ad, count * OCB_BLOCK_SIZE);
+        OCB_ENCRYPT_BLOCKS(&(state->ks), block, block, count);
+        for (index = 0; index < count; ++index)
+            lw_xor_block(tag, block + index * OCB_BLOCK_SIZE, OCB_BLOCK_SIZE);
+        ad += count * OCB_BLOCK_SIZE;
+        adlen -= count * OCB_BLOCK_SIZE;
     }
 
     /* Pad and process the last partial block */
@@ -217,47 +268,45 @@ static void OCB_CONCAT(OCB_ALG_NAME,_process_ad)
     }
 }
 
-int OCB_CONCAT(OCB_ALG_NAME,_aead_encrypt)
-    (unsigned char *c, unsigned long long *clen,
+/* Encrypts a packet with OCB using a previously initialized state */
+static int OCB_CONCAT(OCB_ALG_NAME,_encrypt_with_state)
+    (const OCB_STATE *state, unsigned char *c, unsigned long long *clen,
      const unsigned char *m, unsigned long long mlen,
      const unsigned char *ad, unsigned long long adlen,
-     const unsigned char *nsec,
-     const unsigned char *npub,
-     const unsigned char *k)
+     const unsigned char *npub)
 {
-    OCB_STATE state;
     unsigned char offset[OCB_BLOCK_SIZE];
     unsigned char sum[OCB_BLOCK_SIZE];
-    unsigned char block[OCB_BLOCK_SIZE];
+    unsigned char block[OCB_PARALLEL_BLOCKS * OCB_BLOCK_SIZE];
+    unsigned char offsets[OCB_PARALLEL_BLOCKS * OCB_BLOCK_SIZE];
+    unsigned char L[OCB_BLOCK_SIZE];
     unsigned long long block_number;
-    (void)nsec;
+    unsigned count, index;
 
     /* Set the length of the returned ciphertext */
     *clen = mlen + OCB_TAG_SIZE;
 
-    /* Initialize the OCB state */
-    OCB_CONCAT(OCB_ALG_NAME,_init)(&state, k, npub, offset);
+    /* Derive the initial offset from the nonce */
+    OCB_CONCAT(OCB_ALG_NAME,_init_nonce)(state, npub, offset);
 
-    /* Process all plaintext blocks except the last */
+    /* Process all full plaintext blocks, up to OCB_PARALLEL_BLOCKS
+     * at a time */
     memset(sum, 0, sizeof(sum));
     block_number = 1;
     while (mlen >= OCB_BLOCK_SIZE) {
-        if (block_number & 1) {
-            lw_xor_block(offset, state.L0, OCB_BLOCK_SIZE);
-        } else if ((block_number & 3) == 2) {
-            lw_xor_block(offset, state.L1, OCB_BLOCK_SIZE);
-        } else {
-            OCB_CONCAT(OCB_ALG_NAME,_calculate_L)(&state, block, block_number);
-            lw_xor_block(offset, block, OCB_BLOCK_SIZE);
+        count = OCB_PARALLEL_BLOCKS;
+        if ((mlen / OCB_BLOCK_SIZE) < count)
+            count = (unsigned)(mlen / OCB_BLOCK_SIZE);
+        for (index = 0; index < count; ++index) {
+            OCB_NEXT_OFFSET(offsets + index * OCB_BLOCK_SIZE);
+            lw_xor_block(sum, m + index * OCB_BLOCK_SIZE, OCB_BLOCK_SIZE);
         }
-        lw_xor_block(sum, m, OCB_BLOCK_SIZE);
-        lw_xor_block_2_src(block, offset, m, OCB_BLOCK_SIZE);
-        OCB_ENCRYPT_BLOCK(&(state.ks), block, block);
-        lw_xor_block_2_src(c, block, offset, OCB_BLOCK_SIZE);
-        c += OCB_BLOCK_SIZE;
-        m += OCB_BLOCK_SIZE;
-        mlen -= OCB_BLOCK_SIZE;
-        ++block_number;
+        lw_xor_block_2_src(block, offsets, m, count * OCB_BLOCK_SIZE);
+        OCB_ENCRYPT_BLOCKS(&(state->ks), block, block, count);
+        lw_xor_block_2_src(c, block, offsets, count * OCB_BLOCK_SIZE);
+        c += count * OCB_BLOCK_SIZE;
+        m += count * OCB_BLOCK_SIZE;
+        mlen -= count * OCB_BLOCK_SIZE;
     }
 
     /* Pad and process the last plaintext block */
@@ -265,75 +314,73 @@ int OCB_CONCAT(OCB_ALG_NAME,_aead_encrypt)
         unsigned temp = (unsigned)mlen;
         lw_xor_block(sum, m, temp);
         sum[temp] ^= 0x80;
-        lw_xor_block(offset, state.Lstar, OCB_BLOCK_SIZE);
-        OCB_ENCRYPT_BLOCK(&(state.ks), block, offset);
+        lw_xor_block(offset, state->Lstar, OCB_BLOCK_SIZE);
+        OCB_ENCRYPT_BLOCK(&(state->ks), block, offset);
         lw_xor_block_2_src(c, block, m, temp);
         c += temp;
     }
 
     /* Finalize the encryption phase */
     lw_xor_block(sum, offset, OCB_BLOCK_SIZE);
-    lw_xor_block(sum, state.Ldollar, OCB_BLOCK_SIZE);
-    OCB_ENCRYPT_BLOCK(&(state.ks), sum, sum);
+    lw_xor_block(sum, state->Ldollar, OCB_BLOCK_SIZE);
+    OCB_ENCRYPT_BLOCK(&(state->ks), sum, sum);
 
     /* Process the associated data and compute the final authentication tag */
-    OCB_CONCAT(OCB_ALG_NAME,_process_ad)(&state, sum, ad, adlen);
+    OCB_CONCAT(OCB_ALG_NAME,_process_ad)(state, sum, ad, adlen);
     memcpy(c, sum, OCB_TAG_SIZE);
     return 0;
 }
 
-int OCB_CONCAT(OCB_ALG_NAME,_aead_decrypt)
-    (unsigned char *m, unsigned long long *mlen,
-     unsigned char *nsec,
+/* Decrypts a packet with OCB using a previously initialized state */
+static int OCB_CONCAT(OCB_ALG_NAME,_decrypt_with_state)
+    (const OCB_STATE *state, unsigned char *m, unsigned long long *mlen,
      const unsigned char *c, unsigned long long clen,
      const unsigned char *ad, unsigned long long adlen,
-     const unsigned char *npub,
-     const unsigned char *k)
+     const unsigned char *npub)
 {
-    OCB_STATE state;
     unsigned char *mtemp = m;
     unsigned char offset[OCB_BLOCK_SIZE];
     unsigned char sum[OCB_BLOCK_SIZE];
-    unsigned char block[OCB_BLOCK_SIZE];
+    unsigned char block[OCB_PARALLEL_BLOCKS * OCB_BLOCK_SIZE];
+    unsigned char offsets[OCB_PARALLEL_BLOCKS * OCB_BLOCK_SIZE];
+    unsigned char L[OCB_BLOCK_SIZE];
     unsigned long long block_number;
-    (void)nsec;
+    unsigned count, index;
 
     /* Validate the ciphertext length and set the return "mlen" value */
     if (clen < OCB_TAG_SIZE)
         return -1;
     *mlen = clen - OCB_TAG_SIZE;
 
-    /* Initialize the OCB state */
-    OCB_CONCAT(OCB_ALG_NAME,_init)(&state, k, npub, offset);
+    /* Derive the initial offset from the nonce */
+    OCB_CONCAT(OCB_ALG_NAME,_init_nonce)(state, npub, offset);
 
-    /* Process all ciphertext blocks except the last */
+    /* Process all full ciphertext blocks, up to OCB_PARALLEL_BLOCKS
+     * at a time */
     memset(sum, 0, sizeof(sum));
     block_number = 1;
     clen -= OCB_TAG_SIZE;
     while (clen >= OCB_BLOCK_SIZE) {
-        if (block_number & 1) {
-            lw_xor_block(offset, state.L0, OCB_BLOCK_SIZE);
-        } else if ((block_number & 3) == 2) {
-            lw_xor_block(offset, state.L1, OCB_BLOCK_SIZE);
-        } else {
-            OCB_CONCAT(OCB_ALG_NAME,_calculate_L)(&state, block, block_number);
-            lw_xor_block(offset, block, OCB_BLOCK_SIZE);
-        }
-        lw_xor_block_2_src(block, offset, c, OCB_BLOCK_SIZE);
-        OCB_DECRYPT_BLOCK(&(state.ks), block, block);
-        lw_xor_block_2_src(m, block, offset, OCB_BLOCK_SIZE);
-        lw_xor_block(sum, m, OCB_BLOCK_SIZE);
-        c += OCB_BLOCK_SIZE;
-        m += OCB_BLOCK_SIZE;
-        clen -= OCB_BLOCK_SIZE;
-        ++block_number;
+        count = OCB_PARALLEL_BLOCKS;
+        if ((clen / OCB_BLOCK_SIZE) < count)
+            count = (unsigned)(clen / OCB_BLOCK_SIZE);
+        for (index = 0; index < count; ++index)
+            OCB_NEXT_OFFSET(offsets + index * OCB_BLOCK_SIZE);
+        lw_xor_block_2_src(block, offsets, c, count * OCB_BLOCK_SIZE);
+        OCB_DECRYPT_BLOCKS(&(state->ks), block, block, count);
+        lw_xor_block_2_src(m, block, offsets, count * OCB_BLOCK_SIZE);
+        for (index = 0; index < count; ++index)
+            lw_xor_block(sum, m + index * OCB_BLOCK_SIZE, OCB_BLOCK_SIZE);
+        c += count * OCB_BLOCK_SIZE;
+        m += count * OCB_BLOCK_SIZE;
+        clen -= count * OCB_BLOCK_SIZE;
     }
 
     /* Pad and process the last ciphertext block */
     if (clen > 0) {
         unsigned temp = (unsigned)clen;
-        lw_xor_block(offset, state.Lstar, OCB_BLOCK_SIZE);
-        OCB_ENCRYPT_BLOCK(&(state.ks), block, offset);
+        lw_xor_block(offset, state->Lstar, OCB_BLOCK_SIZE);
+        OCB_ENCRYPT_BLOCK(&(state->ks), block, offset);
         lw_xor_block_2_src(m, block, c, temp);
         lw_xor_block(sum, m, temp);
         sum[temp] ^= 0x80;
@@ -342,14 +389,80 @@ int OCB_CONCAT(OCB_ALG_NAME,_aead_decrypt)
 
     /* Finalize the decryption phase */
     lw_xor_block(sum, offset, OCB_BLOCK_SIZE);
-    lw_xor_block(sum, state.Ldollar, OCB_BLOCK_SIZE);
-    OCB_ENCRYPT_BLOCK(&(state.ks), sum, sum);
+    lw_xor_block(sum, state->Ldollar, OCB_BLOCK_SIZE);
+    OCB_ENCRYPT_BLOCK(&(state->ks), sum, sum);
 
     /* Process the associated data and check the final authentication tag */
-    OCB_CONCAT(OCB_ALG_NAME,_process_ad)(&state, sum, ad, adlen);
+    OCB_CONCAT(OCB_ALG_NAME,_process_ad)(state, sum, ad, adlen);
     return aead_check_tag(mtemp, *mlen, sum, c, OCB_TAG_SIZE);
 }
 
+int OCB_CONCAT(OCB_ALG_NAME,_aead_encrypt)
+    (unsigned char *c, unsigned long long *clen,
+     const unsigned char *m, unsigned long long mlen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *nsec,
+     const unsigned char *npub,
+     const unsigned char *k)
+{
+    OCB_STATE state;
+    (void)nsec;
+    OCB_CONCAT(OCB_ALG_NAME,_init_key)(&state, k);
+    return OCB_CONCAT(OCB_ALG_NAME,_encrypt_with_state)
+        (&state, c, clen, m, mlen, ad, adlen, npub);
+}
+
+int OCB_CONCAT(OCB_ALG_NAME,_aead_decrypt)
+    (unsigned char *m, unsigned long long *mlen,
+     unsigned char *nsec,
+     const unsigned char *c, unsigned long long clen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *npub,
+     const unsigned char *k)
+{
+    OCB_STATE state;
+    (void)nsec;
+    OCB_CONCAT(OCB_ALG_NAME,_init_key)(&state, k);
+    return OCB_CONCAT(OCB_ALG_NAME,_decrypt_with_state)
+        (&state, m, mlen, c, clen, ad, adlen, npub);
+}
+
+#if defined(OCB_KEY_CONTEXT) && OCB_KEY_CONTEXT
+
+void OCB_CONCAT(OCB_ALG_NAME,_aead_setup_key)
+    (void *ctx, const unsigned char *k)
+{
+    OCB_CONCAT(OCB_ALG_NAME,_init_key)((OCB_STATE *)ctx, k);
+}
+
+int OCB_CONCAT(OCB_ALG_NAME,_aead_encrypt_with_context)
+    (unsigned char *c, unsigned long long *clen,
+     const unsigned char *m, unsigned long long mlen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *nsec,
+     const unsigned char *npub,
+     const void *ctx)
+{
+    (void)nsec;
+    return OCB_CONCAT(OCB_ALG_NAME,_encrypt_with_state)
+        ((const OCB_STATE *)ctx, c, clen, m, mlen, ad, adlen, npub);
+}
+
+int OCB_CONCAT(OCB_ALG_NAME,_aead_decrypt_with_context)
+    (unsigned char *m, unsigned long long *mlen,
+     unsigned char *nsec,
+     const unsigned char *c, unsigned long long clen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *npub,
+     const void *ctx)
+{
+    (void)nsec;
+    return OCB_CONCAT(OCB_ALG_NAME,_decrypt_with_state)
+        ((const OCB_STATE *)ctx, m, mlen, c, clen, ad, adlen, npub);
+}
+
+#endif /* OCB_KEY_CONTEXT */
+
 #endif /* OCB_ENCRYPT_BLOCK */
 
 #endif /* LW_INTERNAL_OCB_H */
@@ -0,0 +1,275 @@
+/*
+ * Copyright (C) 2020 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* We expect a number of macros to be defined before this file
+ * is included to configure the multi-block Pyjamask kernels.
+ *
+ * PYJAMASK_LANES_SUFFIX    Suffix to append to the kernel names; e.g. _x4.
+ * PYJAMASK_LANES           Number of blocks that are processed in parallel.
+ * PYJAMASK_LANES_TARGET    Function attributes for the kernels, such as
+ *                          the instruction set to compile them for.
+ *
+ * The kernels are built from the same round macros as the single-block
+ * functions, applied to vectors with one block in each 32-bit lane.
+ */
+#if defined(PYJAMASK_LANES_SUFFIX)
+
+#define PYJAMASK_CONCAT_INNER(name,suffix) name##suffix
+#define PYJAMASK_CONCAT(name,suffix) PYJAMASK_CONCAT_INNER(name,suffix)
+#define PYJAMASK_VEC_T PYJAMASK_CONCAT(pyjamask_vec,PYJAMASK_LANES_SUFFIX)
+#define PYJAMASK_SET_T PYJAMASK_CONCAT(pyjamask_set,PYJAMASK_LANES_SUFFIX)
+
+/* Vector type with one 32-bit lane per block */
+typedef uint32_t PYJAMASK_VEC_T
+    __attribute__((vector_size(PYJAMASK_LANES * 4)));
+
+/* Rows of the state for all blocks, as vectors or as individual words */
+typedef union
+{
+    PYJAMASK_VEC_T v[4];
+    uint32_t w[4][PYJAMASK_LANES];
+
+} PYJAMASK_SET_T;
+
+/* Redirect the matrix macros to the vector type */
+#undef PYJAMASK_WORD
+#undef pyjamask_rotr
+#define PYJAMASK_WORD PYJAMASK_VEC_T
+#define pyjamask_rotr(y, bits) (((y) >> (bits)) | ((y) << (32 - (bits))))
+
+/**
+ * \brief Transposes PYJAMASK_LANES blocks into vector lanes.
+ *
+ * \param set The set of rows on output.
+ * \param input Input buffer for all blocks.
+ * \param rows Number of 32-bit rows in each block; 4 or 3.
+ */
+static PYJAMASK_LANES_TARGET void PYJAMASK_CONCAT
+    (pyjamask_load,PYJAMASK_LANES_SUFFIX)
+    (PYJAMASK_SET_T *set, const unsigned char *input, unsigned rows)
+{
+    unsigned lane, row;
+    for (lane = 0; lane < PYJAMASK_LANES; ++lane) {
+        for (row = 0; row < rows; ++row)
+            set->w[row][lane] = be_load_word32(input + row * 4);
+        input += rows * 4;
+    }
+}
+
+/**
+ * \brief Transposes vector lanes back into PYJAMASK_LANES blocks.
+ *
+ * \param set The set of rows to store.
+ * \param output Output buffer for all blocks.
+ * \param rows Number of 32-bit rows in each block; 4 or 3.
+ */
+static PYJAMASK_LANES_TARGET void PYJAMASK_CONCAT
+    (pyjamask_store,PYJAMASK_LANES_SUFFIX)
+    (const PYJAMASK_SET_T *set, unsigned char *output, unsigned rows)
+{
+    unsigned lane, row;
+    for (lane = 0; lane < PYJAMASK_LANES; ++lane) {
+        for (row = 0; row < rows; ++row)
+            be_store_word32(output + row * 4, set->w[row][lane]);
+        output += rows * 4;
+    }
+}
+
+#if !PYJAMASK_128_ASM
+
+/**
+ * \brief Encrypts PYJAMASK_LANES blocks in parallel with Pyjamask-128.
+ *
+ * \param ks Points to the key schedule.
+ * \param output Output buffer for all blocks.
+ * \param input Input buffer for all blocks.
+ */
+static PYJAMASK_LANES_TARGET void PYJAMASK_CONCAT
+    (pyjamask_128_encrypt,PYJAMASK_LANES_SUFFIX)
+    (const pyjamask_128_key_schedule_t *ks, unsigned char *output,
+     const unsigned char *input)
+{
+    const uint32_t *rk = ks->k;
+    PYJAMASK_SET_T set;
+    PYJAMASK_VEC_T s0, s1, s2, s3;
+    uint8_t round;
+
+    /* Load the plaintext blocks into the vector lanes */
+    PYJAMASK_CONCAT(pyjamask_load,PYJAMASK_LANES_SUFFIX)(&set, input, 4);
+    s0 = set.v[0];
+    s1 = set.v[1];
+    s2 = set.v[2];
+    s3 = set.v[3];
+
+    /* Perform all encryption rounds */
+    for (round = 0; round < PYJAMASK_ROUNDS; ++round, rk += 4) {
+        s0 ^= rk[0];
+        s1 ^= rk[1];
+        s2 ^= rk[2];
+        s3 ^= rk[3];
+        pyjamask_128_round(s0, s1, s2, s3);
+    }
+
+    /* Mix in the key one last time and write the ciphertext blocks */
+    set.v[0] = s0 ^ rk[0];
+    set.v[1] = s1 ^ rk[1];
+    set.v[2] = s2 ^ rk[2];
+    set.v[3] = s3 ^ rk[3];
+    PYJAMASK_CONCAT(pyjamask_store,PYJAMASK_LANES_SUFFIX)(&set, output, 4);
+}
+
+/**
+ * \brief Decrypts PYJAMASK_LANES blocks in parallel with Pyjamask-128.
+ *
+ * \param ks Points to the key schedule.
+ * \param output Output buffer for all blocks.
+ * \param input Input buffer for all blocks.
+ */
+static PYJAMASK_LANES_TARGET void PYJAMASK_CONCAT
+    (pyjamask_128_decrypt,PYJAMASK_LANES_SUFFIX)
+    (const pyjamask_128_key_schedule_t *ks, unsigned char *output,
+     const unsigned char *input)
+{
+    const uint32_t *rk = ks->k + 4 * PYJAMASK_ROUNDS;
+    PYJAMASK_SET_T set;
+    PYJAMASK_VEC_T s0, s1, s2, s3;
+    uint8_t round;
+
+    /* Load the ciphertext blocks and mix in the last round key */
+    PYJAMASK_CONCAT(pyjamask_load,PYJAMASK_LANES_SUFFIX)(&set, input, 4);
+    s0 = set.v[0] ^ rk[0];
+    s1 = set.v[1] ^ rk[1];
+    s2 = set.v[2] ^ rk[2];
+    s3 = set.v[3] ^ rk[3];
+    rk -= 4;
+
+    /* Perform all decryption rounds */
+    for (round = 0; round < PYJAMASK_ROUNDS; ++round, rk -= 4) {
+        pyjamask_128_inv_round(s0, s1, s2, s3);
+        s0 ^= rk[0];
+        s1 ^= rk[1];
+        s2 ^= rk[2];
+        s3 ^= rk[3];
+    }
+
+    /* Write the plaintext blocks */
+    set.v[0] = s0;
+    set.v[1] = s1;
+    set.v[2] = s2;
+    set.v[3] = s3;
+    PYJAMASK_CONCAT(pyjamask_store,PYJAMASK_LANES_SUFFIX)(&set, output, 4);
+}
+
+#endif /* !PYJAMASK_128_ASM */
+
+#if !PYJAMASK_96_ASM
+
+/**
+ * \brief Encrypts PYJAMASK_LANES blocks in parallel with Pyjamask-96.
+ *
+ * \param ks Points to the key schedule.
+ * \param output Output buffer for all blocks.
+ * \param input Input buffer for all blocks.
+ */
+static PYJAMASK_LANES_TARGET void PYJAMASK_CONCAT
+    (pyjamask_96_encrypt,PYJAMASK_LANES_SUFFIX)
+    (const pyjamask_96_key_schedule_t *ks, unsigned char *output,
+     const unsigned char *input)
+{
+    const uint32_t *rk = ks->k;
+    PYJAMASK_SET_T set;
+    PYJAMASK_VEC_T s0, s1, s2;
+    uint8_t round;
+
+    /* Load the plaintext blocks into the vector lanes */
+    PYJAMASK_CONCAT(pyjamask_load,PYJAMASK_LANES_SUFFIX)(&set, input, 3);
+    s0 = set.v[0];
+    s1 = set.v[1];
+    s2 = set.v[2];
+
+    /* Perform all encryption rounds */
+    for (round = 0; round < PYJAMASK_ROUNDS; ++round, rk += 3) {
+        s0 ^= rk[0];
+        s1 ^= rk[1];
+        s2 ^= rk[2];
+        pyjamask_96_round(s0, s1, s2);
+    }
+
+    /* Mix in the key one last time and write the ciphertext blocks */
+    set.v[0] = s0 ^ rk[0];
+    set.v[1] = s1 ^ rk[1];
+    set.v[2] = s2 ^ rk[2];
+    PYJAMASK_CONCAT(pyjamask_store,PYJAMASK_LANES_SUFFIX)(&set, output, 3);
+}
+
+/**
+ * \brief Decrypts PYJAMASK_LANES blocks in parallel with Pyjamask-96.
+ *
+ * \param ks Points to the key schedule.
+ * \param output Output buffer for all blocks.
+ * \param input Input buffer for all blocks.
+ */
+static PYJAMASK_LANES_TARGET void PYJAMASK_CONCAT
+    (pyjamask_96_decrypt,PYJAMASK_LANES_SUFFIX)
+    (const pyjamask_96_key_schedule_t *ks, unsigned char *output,
+     const unsigned char *input)
+{
+    const uint32_t *rk = ks->k + 3 * PYJAMASK_ROUNDS;
+    PYJAMASK_SET_T set;
+    PYJAMASK_VEC_T s0, s1, s2;
+    uint8_t round;
+
+    /* Load the ciphertext blocks and mix in the last round key */
+    PYJAMASK_CONCAT(pyjamask_load,PYJAMASK_LANES_SUFFIX)(&set, input, 3);
+    s0 = set.v[0] ^ rk[0];
+    s1 = set.v[1] ^ rk[1];
+    s2 = set.v[2] ^ rk[2];
+    rk -= 3;
+
+    /* Perform all decryption rounds */
+    for (round = 0; round < PYJAMASK_ROUNDS; ++round, rk -= 3) {
+        pyjamask_96_inv_round(s0, s1, s2);
+        s0 ^= rk[0];
+        s1 ^= rk[1];
+        s2 ^= rk[2];
+    }
+
+    /* Write the plaintext blocks */
+    set.v[0] = s0;
+    set.v[1] = s1;
+    set.v[2] = s2;
+    PYJAMASK_CONCAT(pyjamask_store,PYJAMASK_LANES_SUFFIX)(&set, output, 3);
+}
+
+#endif /* !PYJAMASK_96_ASM */
+
+#endif /* PYJAMASK_LANES_SUFFIX */
+
+/* Now undefine everything so that we can include this file again for
+ * another kernel width */
+#undef PYJAMASK_LANES_SUFFIX
+#undef PYJAMASK_LANES
+#undef PYJAMASK_LANES_TARGET
+#undef PYJAMASK_CONCAT_INNER
+#undef PYJAMASK_CONCAT
+#undef PYJAMASK_VEC_T
+#undef PYJAMASK_SET_T
@@ -34,164 +34,243 @@
 
 #if !PYJAMASK_128_ASM || !PYJAMASK_96_ASM
 
+/* Word type and rotation for the matrix macros.  The multi-block kernels
+ * in internal-pyjamask-lanes.h redefine these to operate on vectors */
+#define PYJAMASK_WORD uint32_t
+#define pyjamask_rotr(y, bits) (rightRotate##bits((y)))
+
 /* Macros for specific matrix values */
 #define pyjamask_matrix_multiply_b881b9ca(y) \
     do { \
-        uint32_t result; \
+        PYJAMASK_WORD result; \
         result  = (y); \
-        result ^= rightRotate2((y)); \
-        result ^= rightRotate3((y)); \
-        result ^= rightRotate4((y)); \
-        result ^= rightRotate8((y)); \
-        result ^= rightRotate15((y)); \
-        result ^= rightRotate16((y)); \
-        result ^= rightRotate18((y)); \
-        result ^= rightRotate19((y)); \
-        result ^= rightRotate20((y)); \
-        result ^= rightRotate23((y)); \
-        result ^= rightRotate24((y)); \
-        result ^= rightRotate25((y)); \
-        result ^= rightRotate28((y)); \
-        result ^= rightRotate30((y)); \
+        result ^= pyjamask_rotr((y), 2); \
+        result ^= pyjamask_rotr((y), 3); \
+        result ^= pyjamask_rotr((y), 4); \
+        result ^= pyjamask_rotr((y), 8); \
+        result ^= pyjamask_rotr((y), 15); \
+        result ^= pyjamask_rotr((y), 16); \
+        result ^= pyjamask_rotr((y), 18); \
+        result ^= pyjamask_rotr((y), 19); \
+        result ^= pyjamask_rotr((y), 20); \
+        result ^= pyjamask_rotr((y), 23); \
+        result ^= pyjamask_rotr((y), 24); \
+        result ^= pyjamask_rotr((y), 25); \
+        result ^= pyjamask_rotr((y), 28); \
+        result ^= pyjamask_rotr((y), 30); \
         (y) = result; \
     } while (0)
 #define pyjamask_matrix_multiply_a3861085(y) \
     do { \
-        uint32_t result; \
+        PYJAMASK_WORD result; \
         result  = (y); \
-        result ^= rightRotate2((y)); \
-        result ^= rightRotate6((y)); \
-        result ^= rightRotate7((y)); \
-        result ^= rightRotate8((y)); \
-        result ^= rightRotate13((y)); \
-        result ^= rightRotate14((y)); \
-        result ^= rightRotate19((y)); \
-        result ^= rightRotate24((y)); \
-        result ^= rightRotate29((y)); \
-        result ^= rightRotate31((y)); \
+        result ^= pyjamask_rotr((y), 2); \
+        result ^= pyjamask_rotr((y), 6); \
+        result ^= pyjamask_rotr((y), 7); \
+        result ^= pyjamask_rotr((y), 8); \
+        result ^= pyjamask_rotr((y), 13); \
+        result ^= pyjamask_rotr((y), 14); \
+        result ^= pyjamask_rotr((y), 19); \
+        result ^= pyjamask_rotr((y), 24); \
+        result ^= pyjamask_rotr((y), 29); \
+        result ^= pyjamask_rotr((y), 31); \
         (y) = result; \
     } while (0)
 #define pyjamask_matrix_multiply_63417021(y) \
     do { \
-        uint32_t result; \
-        result  = rightRotate1((y)); \
-        result ^= rightRotate2((y)); \
-        result ^= rightRotate6((y)); \
-        result ^= rightRotate7((y)); \
-        result ^= rightRotate9((y)); \
-        result ^= rightRotate15((y)); \
-        result ^= rightRotate17((y)); \
-        result ^= rightRotate18((y)); \
-        result ^= rightRotate19((y)); \
-        result ^= rightRotate26((y)); \
-        result ^= rightRotate31((y)); \
+        PYJAMASK_WORD result; \
+        result  = pyjamask_rotr((y), 1); \
+        result ^= pyjamask_rotr((y), 2); \
+        result ^= pyjamask_rotr((y), 6); \
+        result ^= pyjamask_rotr((y), 7); \
+        result ^= pyjamask_rotr((y), 9); \
+        result ^= pyjamask_rotr((y), 15); \
+        result ^= pyjamask_rotr((y), 17); \
+        result ^= pyjamask_rotr((y), 18); \
+        result ^= pyjamask_rotr((y), 19); \
+        result ^= pyjamask_rotr((y), 26); \
+        result ^= pyjamask_rotr((y), 31); \
         (y) = result; \
     } while (0)
 #define pyjamask_matrix_multiply_692cf280(y) \
     do { \
-        uint32_t result; \
-        result  = rightRotate1((y)); \
-        result ^= rightRotate2((y)); \
-        result ^= rightRotate4((y)); \
-        result ^= rightRotate7((y)); \
-        result ^= rightRotate10((y)); \
-        result ^= rightRotate12((y)); \
-        result ^= rightRotate13((y)); \
-        result ^= rightRotate16((y)); \
-        result ^= rightRotate17((y)); \
-        result ^= rightRotate18((y)); \
-        result ^= rightRotate19((y)); \
-        result ^= rightRotate22((y)); \
-        result ^= rightRotate24((y)); \
+        PYJAMASK_WORD result; \
+        result  = pyjamask_rotr((y), 1); \
+        result ^= pyjamask_rotr((y), 2); \
+        result ^= pyjamask_rotr((y), 4); \
+        result ^= pyjamask_rotr((y), 7); \
+        result ^= pyjamask_rotr((y), 10); \
+        result ^= pyjamask_rotr((y), 12); \
+        result ^= pyjamask_rotr((y), 13); \
+        result ^= pyjamask_rotr((y), 16); \
+        result ^= pyjamask_rotr((y), 17); \
+        result ^= pyjamask_rotr((y), 18); \
+        result ^= pyjamask_rotr((y), 19); \
+        result ^= pyjamask_rotr((y), 22); \
+        result ^= pyjamask_rotr((y), 24); \
         (y) = result; \
     } while (0)
 #define pyjamask_matrix_multiply_48a54813(y) \
     do { \
-        uint32_t result; \
-        result  = rightRotate1((y)); \
-        result ^= rightRotate4((y)); \
-        result ^= rightRotate8((y)); \
-        result ^= rightRotate10((y)); \
-        result ^= rightRotate13((y)); \
-        result ^= rightRotate15((y)); \
-        result ^= rightRotate17((y)); \
-        result ^= rightRotate20((y)); \
-        result ^= rightRotate27((y)); \
-        result ^= rightRotate30((y)); \
-        result ^= rightRotate31((y)); \
+        PYJAMASK_WORD result; \
+        result  = pyjamask_rotr((y), 1); \
+        result ^= pyjamask_rotr((y), 4); \
+        result ^= pyjamask_rotr((y), 8); \
+        result ^= pyjamask_rotr((y), 10); \
+        result ^= pyjamask_rotr((y), 13); \
+        result ^= pyjamask_rotr((y), 15); \
+        result ^= pyjamask_rotr((y), 17); \
+        result ^= pyjamask_rotr((y), 20); \
+        result ^= pyjamask_rotr((y), 27); \
+        result ^= pyjamask_rotr((y), 30); \
+        result ^= pyjamask_rotr((y), 31); \
         (y) = result; \
     } while (0)
 #define pyjamask_matrix_multiply_2037a121(y) \
     do { \
-        uint32_t result; \
-        result  = rightRotate2((y)); \
-        result ^= rightRotate10((y)); \
-        result ^= rightRotate11((y)); \
-        result ^= rightRotate13((y)); \
-        result ^= rightRotate14((y)); \
-        result ^= rightRotate15((y)); \
-        result ^= rightRotate16((y)); \
-        result ^= rightRotate18((y)); \
-        result ^= rightRotate23((y)); \
-        result ^= rightRotate26((y)); \
-        result ^= rightRotate31((y)); \
+        PYJAMASK_WORD result; \
+        result  = pyjamask_rotr((y), 2); \
+        result ^= pyjamask_rotr((y), 10); \
+        result ^= pyjamask_rotr((y), 11); \
+        result ^= pyjamask_rotr((y), 13); \
+        result ^= pyjamask_rotr((y), 14); \
+        result ^= pyjamask_rotr((y), 15); \
+        result ^= pyjamask_rotr((y), 16); \
+        result ^= pyjamask_rotr((y), 18); \
+        result ^= pyjamask_rotr((y), 23); \
+        result ^= pyjamask_rotr((y), 26); \
+        result ^= pyjamask_rotr((y), 31); \
         (y) = result; \
     } while (0)
 #define pyjamask_matrix_multiply_108ff2a0(y) \
     do { \
-        uint32_t result; \
-        result  = rightRotate3((y)); \
-        result ^= rightRotate8((y)); \
-        result ^= rightRotate12((y)); \
-        result ^= rightRotate13((y)); \
-        result ^= rightRotate14((y)); \
-        result ^= rightRotate15((y)); \
-        result ^= rightRotate16((y)); \
-        result ^= rightRotate17((y)); \
-        result ^= rightRotate18((y)); \
-        result ^= rightRotate19((y)); \
-        result ^= rightRotate22((y)); \
-        result ^= rightRotate24((y)); \
-        result ^= rightRotate26((y)); \
+        PYJAMASK_WORD result; \
+        result  = pyjamask_rotr((y), 3); \
+        result ^= pyjamask_rotr((y), 8); \
+        result ^= pyjamask_rotr((y), 12); \
+        result ^= pyjamask_rotr((y), 13); \
+        result ^= pyjamask_rotr((y), 14); \
+        result ^= pyjamask_rotr((y), 15); \
+        result ^= pyjamask_rotr((y), 16); \
+        result ^= pyjamask_rotr((y), 17); \
+        result ^= pyjamask_rotr((y), 18); \
+        result ^= pyjamask_rotr((y), 19); \
+        result ^= pyjamask_rotr((y), 22); \
+        result ^= pyjamask_rotr((y), 24); \
+        result ^= pyjamask_rotr((y), 26); \
         (y) = result; \
     } while (0)
 #define pyjamask_matrix_multiply_9054d8c0(y) \
     do { \
-        uint32_t result; \
+        PYJAMASK_WORD result; \
         result  = (y); \
-        result ^= rightRotate3((y)); \
-        result ^= rightRotate9((y)); \
-        result ^= rightRotate11((y)); \
-        result ^= rightRotate13((y)); \
-        result ^= rightRotate16((y)); \
-        result ^= rightRotate17((y)); \
-        result ^= rightRotate19((y)); \
-        result ^= rightRotate20((y)); \
-        result ^= rightRotate24((y)); \
-        result ^= rightRotate25((y)); \
+        result ^= pyjamask_rotr((y), 3); \
+        result ^= pyjamask_rotr((y), 9); \
+        result ^= pyjamask_rotr((y), 11); \
+        result ^= pyjamask_rotr((y), 13); \
+        result ^= pyjamask_rotr((y), 16); \
+        result ^= pyjamask_rotr((y), 17); \
+        result ^= pyjamask_rotr((y), 19); \
+        result ^= pyjamask_rotr((y), 20); \
+        result ^= pyjamask_rotr((y), 24); \
+        result ^= pyjamask_rotr((y), 25); \
         (y) = result; \
     } while (0)
 #define pyjamask_matrix_multiply_3354b117(y) \
     do { \
-        uint32_t result; \
-        result  = rightRotate2((y)); \
-        result ^= rightRotate3((y)); \
-        result ^= rightRotate6((y)); \
-        result ^= rightRotate7((y)); \
-        result ^= rightRotate9((y)); \
-        result ^= rightRotate11((y)); \
-        result ^= rightRotate13((y)); \
-        result ^= rightRotate16((y)); \
-        result ^= rightRotate18((y)); \
-        result ^= rightRotate19((y)); \
-        result ^= rightRotate23((y)); \
-        result ^= rightRotate27((y)); \
-        result ^= rightRotate29((y)); \
-        result ^= rightRotate30((y)); \
-        result ^= rightRotate31((y)); \
+        PYJAMASK_WORD result; \
+        result  = pyjamask_rotr((y), 2); \
+        result ^= pyjamask_rotr((y), 3); \
+        result ^= pyjamask_rotr((y), 6); \
+        result ^= pyjamask_rotr((y), 7); \
+        result ^= pyjamask_rotr((y), 9); \
+        result ^= pyjamask_rotr((y), 11); \
+        result ^= pyjamask_rotr((y), 13); \
+        result ^= pyjamask_rotr((y), 16); \
+        result ^= pyjamask_rotr((y), 18); \
+        result ^= pyjamask_rotr((y), 19); \
+        result ^= pyjamask_rotr((y), 23); \
+        result ^= pyjamask_rotr((y), 27); \
+        result ^= pyjamask_rotr((y), 29); \
+        result ^= pyjamask_rotr((y), 30); \
+        result ^= pyjamask_rotr((y), 31); \
         (y) = result; \
     } while (0)
 
+/* Applies the 128-bit Pyjamask sbox and mixes the rows of the state */
+#define pyjamask_128_round(s0, s1, s2, s3) \
+    do { \
+        (s0) ^= (s3); \
+        (s3) ^= (s0) & (s1); \
+        (s0) ^= (s1) & (s2); \
+        (s1) ^= (s2) & (s3); \
+        (s2) ^= (s0) & (s3); \
+        (s2) ^= (s1); \
+        (s1) ^= (s0); \
+        (s3) = ~(s3); \
+        (s2) ^= (s3); \
+        (s3) ^= (s2); \
+        (s2) ^= (s3); \
+        pyjamask_matrix_multiply_a3861085((s0)); \
+        pyjamask_matrix_multiply_63417021((s1)); \
+        pyjamask_matrix_multiply_692cf280((s2)); \
+        pyjamask_matrix_multiply_48a54813((s3)); \
+    } while (0)
+
+/* Inverse of pyjamask_128_round() */
+#define pyjamask_128_inv_round(s0, s1, s2, s3) \
+    do { \
+        pyjamask_matrix_multiply_2037a121((s0)); \
+        pyjamask_matrix_multiply_108ff2a0((s1)); \
+        pyjamask_matrix_multiply_9054d8c0((s2)); \
+        pyjamask_matrix_multiply_3354b117((s3)); \
+        (s2) ^= (s3); \
+        (s3) ^= (s2); \
+        (s2) ^= (s3); \
+        (s3) = ~(s3); \
+        (s1) ^= (s0); \
+        (s2) ^= (s1); \
+        (s2) ^= (s0) & (s3); \
+        (s1) ^= (s2) & (s3); \
+        (s0) ^= (s1) & (s2); \
+        (s3) ^= (s0) & (s1); \
+        (s0) ^= (s3); \
+    } while (0)
+
+/* Applies the 96-bit Pyjamask sbox and mixes the rows of the state */
+#define pyjamask_96_round(s0, s1, s2) \
+    do { \
+        (s0) ^= (s1); \
+        (s1) ^= (s2); \
+        (s2) ^= (s0) & (s1); \
+        (s0) ^= (s1) & (s2); \
+        (s1) ^= (s0) & (s2); \
+        (s2) ^= (s0); \
+        (s2) = ~(s2); \
+        (s1) ^= (s0); \
+        (s0) ^= (s1); \
+        pyjamask_matrix_multiply_a3861085((s0)); \
+        pyjamask_matrix_multiply_63417021((s1)); \
+        pyjamask_matrix_multiply_692cf280((s2)); \
+    } while (0)
+
+/* Inverse of pyjamask_96_round() */
+#define pyjamask_96_inv_round(s0, s1, s2) \
+    do { \
+        pyjamask_matrix_multiply_2037a121((s0)); \
+        pyjamask_matrix_multiply_108ff2a0((s1)); \
+        pyjamask_matrix_multiply_9054d8c0((s2)); \
+        (s0) ^= (s1); \
+        (s1) ^= (s0); \
+        (s2) = ~(s2); \
+        (s2) ^= (s0); \
+        (s1) ^= (s0) & (s2); \
+        (s0) ^= (s1) & (s2); \
+        (s2) ^= (s0) & (s1); \
+        (s1) ^= (s2); \
+        (s0) ^= (s1); \
+    } while (0)
+
 #endif
 
 #if !PYJAMASK_128_ASM
@@ -267,24 +346,8 @@ void pyjamask_128_encrypt
         s2 ^= rk[2];
         s3 ^= rk[3];
 
-        /* Apply the 128-bit Pyjamask sbox */
-        s0 ^= s3;
-        s3 ^= s0 & s1;
-        s0 ^= s1 & s2;
-        s1 ^= s2 & s3;
-        s2 ^= s0 & s3;
-        s2 ^= s1;
-        s1 ^= s0;
-        s3 = ~s3;
-        s2 ^= s3;
-        s3 ^= s2;
-        s2 ^= s3;
-
-        /* Mix the rows of the state */
-        pyjamask_matrix_multiply_a3861085(s0);
-        pyjamask_matrix_multiply_63417021(s1);
-        pyjamask_matrix_multiply_692cf280(s2);
-        pyjamask_matrix_multiply_48a54813(s3);
+        /* Apply the sbox and mix the rows of the state */
+        pyjamask_128_round(s0, s1, s2, s3);
     }
 
     /* Mix in the key one last time */
@@ -323,24 +386,8 @@ void pyjamask_128_decrypt
 
     /* Perform all decryption rounds */
     for (round = 0; round < PYJAMASK_ROUNDS; ++round, rk -= 4) {
-        /* Inverse mix of the rows in the state */
-        pyjamask_matrix_multiply_2037a121(s0);
-        pyjamask_matrix_multiply_108ff2a0(s1);
-        pyjamask_matrix_multiply_9054d8c0(s2);
-        pyjamask_matrix_multiply_3354b117(s3);
-
-        /* Apply the inverse of the 128-bit Pyjamask sbox */
-        s2 ^= s3;
-        s3 ^= s2;
-        s2 ^= s3;
-        s3 = ~s3;
-        s1 ^= s0;
-        s2 ^= s1;
-        s2 ^= s0 & s3;
-        s1 ^= s2 & s3;
-        s0 ^= s1 & s2;
-        s3 ^= s0 & s1;
-        s0 ^= s3;
+        /* Inverse mix of the rows and inverse of the sbox */
+        pyjamask_128_inv_round(s0, s1, s2, s3);
 
         /* Add the round key to the state */
         s0 ^= rk[0];
@@ -427,21 +474,8 @@ void pyjamask_96_encrypt
         s1 ^= rk[1];
         s2 ^= rk[2];
 
-        /* Apply the 96-bit Pyjamask sbox */
-        s0 ^= s1;
-        s1 ^= s2;
-        s2 ^= s0 & s1;
-        s0 ^= s1 & s2;
-        s1 ^= s0 & s2;
-        s2 ^= s0;
-        s2 = ~s2;
-        s1 ^= s0;
-        s0 ^= s1;
-
-        /* Mix the rows of the state */
-        pyjamask_matrix_multiply_a3861085(s0);
-        pyjamask_matrix_multiply_63417021(s1);
-        pyjamask_matrix_multiply_692cf280(s2);
+        /* Apply the sbox and mix the rows of the state */
+        pyjamask_96_round(s0, s1, s2);
     }
 
     /* Mix in the key one last time */
@@ -476,21 +510,8 @@ void pyjamask_96_decrypt
 
     /* Perform all encryption rounds */
     for (round = 0; round < PYJAMASK_ROUNDS; ++round, rk -= 3) {
-        /* Inverse mix of the rows in the state */
-        pyjamask_matrix_multiply_2037a121(s0);
-        pyjamask_matrix_multiply_108ff2a0(s1);
-        pyjamask_matrix_multiply_9054d8c0(s2);
-
-        /* Apply the inverse of the 96-bit Pyjamask sbox */
-        s0 ^= s1;
-        s1 ^= s0;
-        s2 = ~s2;
-        s2 ^= s0;
-        s1 ^= s0 & s2;
-        s0 ^= s1 & s2;
-        s2 ^= s0 & s1;
-        s1 ^= s2;
-        s0 ^= s1;
+        /* Inverse mix of the rows and inverse of the sbox */
+        pyjamask_96_inv_round(s0, s1, s2);
 
         /* Add the round key to the state */
         s0 ^= rk[0];
@@ -505,3 +526,148 @@ void pyjamask_96_decrypt
 }
 
 #endif
+
+#if PYJAMASK_VECTOR
+
+/* The lanes template redefines PYJAMASK_WORD and pyjamask_rotr(), so the
+ * kernels must come after all of the single-block functions above */
+
+/* 128-bit kernels for the baseline vector unit; SSE2 or NEON */
+#if defined(__SSE2__) || defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define PYJAMASK_HAVE_X4 1
+#define PYJAMASK_LANES_SUFFIX _x4
+#define PYJAMASK_LANES 4
+#define PYJAMASK_LANES_TARGET
+#include "internal-pyjamask-lanes.h"
+#else
+#define PYJAMASK_HAVE_X4 0
+#endif
+
+/* 256-bit kernels for AVX2 */
+#if defined(__AVX2__) || PYJAMASK_SIMD_DISPATCH
+#define PYJAMASK_HAVE_X8 1
+#define PYJAMASK_LANES_SUFFIX _x8
+#define PYJAMASK_LANES 8
+#define PYJAMASK_LANES_TARGET LW_TARGET_AVX2
+#include "internal-pyjamask-lanes.h"
+#else
+#define PYJAMASK_HAVE_X8 0
+#endif
+
+/* 512-bit kernels for AVX-512 */
+#if defined(__AVX512F__) || PYJAMASK_SIMD_DISPATCH
+#define PYJAMASK_HAVE_X16 1
+#define PYJAMASK_LANES_SUFFIX _x16
+#define PYJAMASK_LANES 16
+#define PYJAMASK_LANES_TARGET LW_TARGET_AVX512
+#include "internal-pyjamask-lanes.h"
+#else
+#define PYJAMASK_HAVE_X16 0
+#endif
+
+#else /* !PYJAMASK_VECTOR */
+
+#define PYJAMASK_HAVE_X4 0
+#define PYJAMASK_HAVE_X8 0
+#define PYJAMASK_HAVE_X16 0
+
+#endif /* !PYJAMASK_VECTOR */
+
+/* Processes a run of "width" blocks at a time with a multi-block kernel */
+#define pyjamask_blocks_run(kernel, width, block_size) \
+    do { \
+        while (count >= (width)) { \
+            kernel(ks, output, input); \
+            output += (width) * (block_size); \
+            input += (width) * (block_size); \
+            count -= (width); \
+        } \
+    } while (0)
+
+/* Processes "count" blocks with the widest kernels that are available */
+#if PYJAMASK_SIMD_DISPATCH
+#define pyjamask_blocks(name, block_size) \
+    do { \
+        int level = lw_simd_level(); \
+        if (level == LW_SIMD_LEVEL_AVX512) \
+            pyjamask_blocks_run(name##_x16, 16, (block_size)); \
+        if (level >= LW_SIMD_LEVEL_AVX2) \
+            pyjamask_blocks_run(name##_x8, 8, (block_size)); \
+        pyjamask_blocks_x4(name, (block_size)); \
+        pyjamask_blocks_run(name, 1, (block_size)); \
+    } while (0)
+#else
+#define pyjamask_blocks(name, block_size) \
+    do { \
+        pyjamask_blocks_x16(name, (block_size)); \
+        pyjamask_blocks_x8(name, (block_size)); \
+        pyjamask_blocks_x4(name, (block_size)); \
+        pyjamask_blocks_run(name, 1, (block_size)); \
+    } while (0)
+#endif
+#if PYJAMASK_HAVE_X16 && !PYJAMASK_SIMD_DISPATCH
+#define pyjamask_blocks_x16(name, block_size) \
+    pyjamask_blocks_run(name##_x16, 16, (block_size))
+#else
+#define pyjamask_blocks_x16(name, block_size) do { ; } while (0)
+#endif
+#if PYJAMASK_HAVE_X8 && !PYJAMASK_SIMD_DISPATCH
+#define pyjamask_blocks_x8(name, block_size) \
+    pyjamask_blocks_run(name##_x8, 8, (block_size))
+#else
+#define pyjamask_blocks_x8(name, block_size) do { ; } while (0)
+#endif
+#if PYJAMASK_HAVE_X4
+#define pyjamask_blocks_x4(name, block_size) \
+    pyjamask_blocks_run(name##_x4, 4, (block_size))
+#else
+#define pyjamask_blocks_x4(name, block_size) do { ; } while (0)
+#endif
+
+void pyjamask_128_encrypt_blocks
+    (const pyjamask_128_key_schedule_t *ks, unsigned char *output,
+     const unsigned char *input, unsigned count)
+{
+    pyjamask_blocks(pyjamask_128_encrypt, 16);
+}
+
+void pyjamask_128_decrypt_blocks
+    (const pyjamask_128_key_schedule_t *ks, unsigned char *output,
+     const unsigned char *input, unsigned count)
+{
+    pyjamask_blocks(pyjamask_128_decrypt, 16);
+}
+
+void pyjamask_96_encrypt_blocks
+    (const pyjamask_96_key_schedule_t *ks, unsigned char *output,
+     const unsigned char *input, unsigned count)
+{
+    pyjamask_blocks(pyjamask_96_encrypt, 12);
+}
+
+void pyjamask_96_decrypt_blocks
+    (const pyjamask_96_key_schedule_t *ks, unsigned char *output,
+     const unsigned char *input, unsigned count)
+{
+    pyjamask_blocks(pyjamask_96_decrypt, 12);
+}
+
+const char *pyjamask_multi_block_variant(void)
+{
+#if defined(__AVX512F__) && PYJAMASK_VECTOR
+    return "AVX-512";
+#elif PYJAMASK_SIMD_DISPATCH
+    static const char * const names[] = {"C", "AVX2", "AVX-512"};
+#if PYJAMASK_HAVE_X4
+    if (lw_simd_level() == LW_SIMD_LEVEL_C)
+        return "Vector";
+#endif
+    return names[lw_simd_level()];
+#elif defined(__AVX2__) && PYJAMASK_VECTOR
+    return "AVX2";
+#elif PYJAMASK_VECTOR
+    return "Vector";
+#else
+    return "C";
+#endif
+}
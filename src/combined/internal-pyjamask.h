@@ -139,6 +139,128 @@ void pyjamask_96_decrypt
     (const pyjamask_96_key_schedule_t *ks, unsigned char *output,
      const unsigned char *input);
 
+/**
+ * \brief Defined to 1 if the multi-block Pyjamask kernels are selected at
+ * runtime according to the features of the CPU.
+ */
+#if LW_SIMD_DISPATCH && !defined(PYJAMASK_NO_SIMD_DISPATCH)
+#define PYJAMASK_SIMD_DISPATCH 1
+#else
+#define PYJAMASK_SIMD_DISPATCH 0
+#endif
+
+/**
+ * \brief Defined to 1 if the multi-block Pyjamask kernels can be built
+ * with the vector extensions of GCC and clang.
+ *
+ * The kernels place one block in each 32-bit lane of a vector register.
+ */
+#if !defined(__AVR__) && (defined(__GNUC__) || defined(__clang__)) && \
+        (defined(__SSE2__) || defined(__ARM_NEON) || defined(__ARM_NEON__) || \
+         PYJAMASK_SIMD_DISPATCH)
+#define PYJAMASK_VECTOR 1
+#else
+#define PYJAMASK_VECTOR 0
+#endif
+
+/**
+ * \brief Number of blocks that are processed in parallel by the widest
+ * multi-block Pyjamask kernel available on this platform.
+ *
+ * Modes such as OCB can use this to decide how many blocks to gather
+ * before calling pyjamask_128_encrypt_blocks() and friends.
+ */
+#if defined(__AVX512F__) || PYJAMASK_SIMD_DISPATCH
+#define PYJAMASK_MAX_LANES 16
+#elif defined(__AVX2__) && PYJAMASK_VECTOR
+#define PYJAMASK_MAX_LANES 8
+#elif PYJAMASK_VECTOR
+#define PYJAMASK_MAX_LANES 4
+#else
+#define PYJAMASK_MAX_LANES 1
+#endif
+
+/**
+ * \brief Encrypts several 128-bit blocks with Pyjamask-128.
+ *
+ * \param ks Points to the key schedule.
+ * \param output Output buffer which must be at least 16 * \a count bytes
+ * in length.
+ * \param input Input buffer which must be at least 16 * \a count bytes
+ * in length.
+ * \param count Number of blocks to encrypt.
+ *
+ * The blocks are processed PYJAMASK_MAX_LANES at a time where possible,
+ * with any left-over blocks encrypted one at a time.  The result is the
+ * same as calling pyjamask_128_encrypt() on each block.
+ *
+ * The \a input and \a output buffers can be the same buffer for
+ * in-place encryption.
+ */
+void pyjamask_128_encrypt_blocks
+    (const pyjamask_128_key_schedule_t *ks, unsigned char *output,
+     const unsigned char *input, unsigned count);
+
+/**
+ * \brief Decrypts several 128-bit blocks with Pyjamask-128.
+ *
+ * \param ks Points to the key schedule.
+ * \param output Output buffer which must be at least 16 * \a count bytes
+ * in length.
+ * \param input Input buffer which must be at least 16 * \a count bytes
+ * in length.
+ * \param count Number of blocks to decrypt.
+ *
+ * The \a input and \a output buffers can be the same buffer for
+ * in-place decryption.
+ */
+void pyjamask_128_decrypt_blocks
+    (const pyjamask_128_key_schedule_t *ks, unsigned char *output,
+     const unsigned char *input, unsigned count);
+
+/**
+ * \brief Encrypts several 96-bit blocks with Pyjamask-96.
+ *
+ * \param ks Points to the key schedule.
+ * \param output Output buffer which must be at least 12 * \a count bytes
+ * in length.
+ * \param input Input buffer which must be at least 12 * \a count bytes
+ * in length.
+ * \param count Number of blocks to encrypt.
+ *
+ * The \a input and \a output buffers can be the same buffer for
+ * in-place encryption.
+ */
+void pyjamask_96_encrypt_blocks
+    (const pyjamask_96_key_schedule_t *ks, unsigned char *output,
+     const unsigned char *input, unsigned count);
+
+/**
+ * \brief Decrypts several 96-bit blocks with Pyjamask-96.
+ *
+ * \param ks Points to the key schedule.
+ * \param output Output buffer which must be at least 12 * \a count bytes
+ * in length.
+ * \param input Input buffer which must be at least 12 * \a count bytes
+ * in length.
+ * \param count Number of blocks to decrypt.
+ *
+ * The \a input and \a output buffers can be the same buffer for
+ * in-place decryption.
+ */
+void pyjamask_96_decrypt_blocks
+    (const pyjamask_96_key_schedule_t *ks, unsigned char *output,
+     const unsigned char *input, unsigned count);
+
+/**
+ * \brief Gets the name of the multi-block kernel that is in use.
+ *
+ * \return One of "AVX-512", "AVX2", "Vector", or "C".
+ *
+ * This function is intended for tests and benchmarks.
+ */
+const char *pyjamask_multi_block_variant(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2020 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* We expect a number of macros to be defined before this file
+ * is included to configure the multi-block Saturnin kernel.
+ *
+ * SATURNIN_LANES_NAME      Name of the kernel function to define.
+ * SATURNIN_LANES           Number of blocks that are encrypted in parallel.
+ * SATURNIN_LANES_TARGET    Function attributes for the kernel, such as
+ *                          the instruction set to compile it for.
+ *
+ * The kernel is built from the same macros as saturnin_encrypt_block(),
+ * applied to vectors with one block in each 32-bit lane.
+ */
+#if defined(SATURNIN_LANES_NAME)
+
+#define SATURNIN_CONCAT_INNER(name,suffix) name##suffix
+#define SATURNIN_CONCAT(name,suffix) SATURNIN_CONCAT_INNER(name,suffix)
+#define SATURNIN_VEC_T SATURNIN_CONCAT(SATURNIN_LANES_NAME,_vec_t)
+
+/* Vector type with one 32-bit lane per block */
+typedef uint32_t SATURNIN_VEC_T
+    __attribute__((vector_size(SATURNIN_LANES * 4)));
+
+/**
+ * \brief Encrypts SATURNIN_LANES blocks in parallel.
+ *
+ * \param schedules Points to the key schedule for the first block.
+ * \param ks_step Number of key schedules to advance by for each block;
+ * zero if all blocks use the same key, or 1 for a key per block.
+ * \param output Output buffer for all blocks.
+ * \param input Input buffer for all blocks.
+ * \param domain Domain separator and round count indicator.
+ */
+static SATURNIN_LANES_TARGET void SATURNIN_LANES_NAME
+    (const saturnin_key_schedule_t *schedules, unsigned ks_step,
+     unsigned char *output, const unsigned char *input, unsigned domain)
+{
+    unsigned rounds = (domain >= SATURNIN_DOMAIN_16_7) ? 8 : 5;
+    const uint32_t *rc = saturnin_rc + domain;
+    union {
+        SATURNIN_VEC_T k[16];
+        uint32_t w[16][SATURNIN_LANES];
+    } keys, *ks = &keys;
+    union {
+        SATURNIN_VEC_T v[8];
+        uint32_t w[8][SATURNIN_LANES];
+    } state;
+    SATURNIN_VEC_T x0, x1, x2, x3, x4, x5, x6, x7;
+    unsigned lane, word;
+
+    /* Transpose the key schedules and input blocks into vector lanes */
+    if (ks_step == 0) {
+        for (word = 0; word < 16; ++word) {
+            keys.k[word] = (SATURNIN_VEC_T){0};
+            keys.k[word] ^= schedules->k[word];
+        }
+    } else {
+        for (lane = 0; lane < SATURNIN_LANES; ++lane) {
+            for (word = 0; word < 16; ++word)
+                keys.w[word][lane] = schedules[lane].k[word];
+        }
+    }
+    for (lane = 0; lane < SATURNIN_LANES; ++lane) {
+        for (word = 0; word < 8; ++word) {
+            state.w[word][lane] =
+                saturnin_load_word32(input + lane * 32 + word * 2);
+        }
+    }
+    x0 = state.v[0];
+    x1 = state.v[1];
+    x2 = state.v[2];
+    x3 = state.v[3];
+    x4 = state.v[4];
+    x5 = state.v[5];
+    x6 = state.v[6];
+    x7 = state.v[7];
+
+    /* XOR the key into the state and perform all encryption rounds */
+    saturnin_xor_key(x0, x1, x2, x3, x4, x5, x6, x7);
+    saturnin_encrypt_rounds(x0, x1, x2, x3, x4, x5, x6, x7);
+
+    /* Transpose the vector lanes back into output blocks */
+    state.v[0] = x0;
+    state.v[1] = x1;
+    state.v[2] = x2;
+    state.v[3] = x3;
+    state.v[4] = x4;
+    state.v[5] = x5;
+    state.v[6] = x6;
+    state.v[7] = x7;
+    for (lane = 0; lane < SATURNIN_LANES; ++lane) {
+        for (word = 0; word < 8; ++word) {
+            saturnin_store_word32
+                (output + lane * 32 + word * 2, state.w[word][lane]);
+        }
+    }
+}
+
+#endif /* SATURNIN_LANES_NAME */
+
+/* Now undefine everything so that we can include this file again for
+ * another kernel width */
+#undef SATURNIN_LANES_NAME
+#undef SATURNIN_LANES
+#undef SATURNIN_LANES_TARGET
+#undef SATURNIN_CONCAT_INNER
+#undef SATURNIN_CONCAT
+#undef SATURNIN_VEC_T
@@ -349,6 +349,50 @@ static uint32_t const saturnin_rc[] = {
         leftRotate16_N(x7, 0x000FU, 12, 0x0FFF, 4); \
     } while (0)
 
+/**
+ * \brief Performs all encryption rounds on the Saturnin state.
+ *
+ * \param x0 First word of the bit-sliced state.
+ * \param x1 Second word of the bit-sliced state.
+ * \param x2 Third word of the bit-sliced state.
+ * \param x3 Fourth word of the bit-sliced state.
+ * \param x4 Fifth word of the bit-sliced state.
+ * \param x5 Sixth word of the bit-sliced state.
+ * \param x6 Seventh word of the bit-sliced state.
+ * \param x7 Eighth word of the bit-sliced state.
+ *
+ * The variables "ks", "rc", and "rounds" must be in scope.  The rounds
+ * are performed two at a time.  The state words may be scalars or vectors.
+ */
+#define saturnin_encrypt_rounds(x0, x1, x2, x3, x4, x5, x6, x7) \
+    do { \
+        for (; rounds > 0; --rounds, rc += 2) { \
+            /* Even rounds */ \
+            saturnin_sbox(x0, x1, x2, x3); \
+            saturnin_sbox(x4, x5, x6, x7); \
+            saturnin_mds(x1, x2, x3, x0, x7, x5, x4, x6); \
+            saturnin_sbox(x3, x0, x1, x2); \
+            saturnin_sbox(x5, x4, x6, x7); \
+            saturnin_slice(x0, x1, x2, x3, x7, x4, x5, x6); \
+            saturnin_mds(x0, x1, x2, x3, x7, x4, x5, x6); \
+            saturnin_slice_inverse(x2, x3, x0, x1, x4, x5, x6, x7); \
+            x2 ^= rc[0]; \
+            saturnin_xor_key_rotated(x2, x3, x0, x1, x4, x5, x6, x7); \
+            \
+            /* Odd rounds */ \
+            saturnin_sbox(x2, x3, x0, x1); \
+            saturnin_sbox(x4, x5, x6, x7); \
+            saturnin_mds(x3, x0, x1, x2, x7, x5, x4, x6); \
+            saturnin_sbox(x1, x2, x3, x0); \
+            saturnin_sbox(x5, x4, x6, x7); \
+            saturnin_sheet(x2, x3, x0, x1, x7, x4, x5, x6); \
+            saturnin_mds(x2, x3, x0, x1, x7, x4, x5, x6); \
+            saturnin_sheet_inverse(x0, x1, x2, x3, x4, x5, x6, x7); \
+            x0 ^= rc[1]; \
+            saturnin_xor_key(x0, x1, x2, x3, x4, x5, x6, x7); \
+        } \
+    } while (0)
+
 void saturnin_setup_key
     (saturnin_key_schedule_t *ks, const unsigned char *key)
 {
@@ -383,32 +427,8 @@ void saturnin_encrypt_block
     /* XOR the key into the state */
     saturnin_xor_key(x0, x1, x2, x3, x4, x5, x6, x7);
 
-    /* Perform all encryption rounds, two at a time */
-    for (; rounds > 0; --rounds, rc += 2) {
-        /* Even rounds */
-        saturnin_sbox(x0, x1, x2, x3);
-        saturnin_sbox(x4, x5, x6, x7);
-        saturnin_mds(x1, x2, x3, x0, x7, x5, x4, x6);
-        saturnin_sbox(x3, x0, x1, x2);
-        saturnin_sbox(x5, x4, x6, x7);
-        saturnin_slice(x0, x1, x2, x3, x7, x4, x5, x6);
-        saturnin_mds(x0, x1, x2, x3, x7, x4, x5, x6);
-        saturnin_slice_inverse(x2, x3, x0, x1, x4, x5, x6, x7);
-        x2 ^= rc[0];
-        saturnin_xor_key_rotated(x2, x3, x0, x1, x4, x5, x6, x7);
-
-        /* Odd rounds */
-        saturnin_sbox(x2, x3, x0, x1);
-        saturnin_sbox(x4, x5, x6, x7);
-        saturnin_mds(x3, x0, x1, x2, x7, x5, x4, x6);
-        saturnin_sbox(x1, x2, x3, x0);
-        saturnin_sbox(x5, x4, x6, x7);
-        saturnin_sheet(x2, x3, x0, x1, x7, x4, x5, x6);
-        saturnin_mds(x2, x3, x0, x1, x7, x4, x5, x6);
-        saturnin_sheet_inverse(x0, x1, x2, x3, x4, x5, x6, x7);
-        x0 ^= rc[1];
-        saturnin_xor_key(x0, x1, x2, x3, x4, x5, x6, x7);
-    }
+    /* Perform all encryption rounds */
+    saturnin_encrypt_rounds(x0, x1, x2, x3, x4, x5, x6, x7);
 
     /* Store the local variables to the output buffer */
     saturnin_store_word32(output,      x0);
@@ -480,4 +500,148 @@ void saturnin_decrypt_block
     saturnin_store_word32(output + 14, x7);
 }
 
+#if SATURNIN_VECTOR
+
+/* 128-bit kernel for the baseline vector unit; SSE2 or NEON */
+#if defined(__SSE2__) || defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SATURNIN_HAVE_X4 1
+#define SATURNIN_LANES_NAME saturnin_encrypt_x4
+#define SATURNIN_LANES 4
+#define SATURNIN_LANES_TARGET
+#include "internal-saturnin-lanes.h"
+#else
+#define SATURNIN_HAVE_X4 0
+#endif
+
+/* 256-bit kernel for AVX2 */
+#if defined(__AVX2__) || SATURNIN_SIMD_DISPATCH
+#define SATURNIN_HAVE_X8 1
+#define SATURNIN_LANES_NAME saturnin_encrypt_x8
+#define SATURNIN_LANES 8
+#define SATURNIN_LANES_TARGET LW_TARGET_AVX2
+#include "internal-saturnin-lanes.h"
+#else
+#define SATURNIN_HAVE_X8 0
+#endif
+
+/* 512-bit kernel for AVX-512 */
+#if defined(__AVX512F__) || SATURNIN_SIMD_DISPATCH
+#define SATURNIN_HAVE_X16 1
+#define SATURNIN_LANES_NAME saturnin_encrypt_x16
+#define SATURNIN_LANES 16
+#define SATURNIN_LANES_TARGET LW_TARGET_AVX512
+#include "internal-saturnin-lanes.h"
+#else
+#define SATURNIN_HAVE_X16 0
+#endif
+
+#endif /* SATURNIN_VECTOR */
+
 #endif /* !__AVR__ */
+
+/**
+ * \brief Encrypts several blocks with the widest kernels available.
+ *
+ * \param ks Points to the key schedule for the first block.
+ * \param ks_step Number of key schedules to advance by for each block.
+ * \param output Output buffer for all blocks.
+ * \param input Input buffer for all blocks.
+ * \param count Number of blocks to encrypt.
+ * \param domain Domain separator and round count indicator.
+ */
+static void saturnin_encrypt_lanes
+    (const saturnin_key_schedule_t *ks, unsigned ks_step,
+     unsigned char *output, const unsigned char *input,
+     unsigned count, unsigned domain)
+{
+#if SATURNIN_SIMD_DISPATCH
+    int level = lw_simd_level();
+    if (level == LW_SIMD_LEVEL_AVX512) {
+        while (count >= 16) {
+            saturnin_encrypt_x16(ks, ks_step, output, input, domain);
+            ks += ks_step * 16;
+            output += 16 * SATURNIN_BLOCK_SIZE;
+            input += 16 * SATURNIN_BLOCK_SIZE;
+            count -= 16;
+        }
+    }
+    if (level >= LW_SIMD_LEVEL_AVX2) {
+        while (count >= 8) {
+            saturnin_encrypt_x8(ks, ks_step, output, input, domain);
+            ks += ks_step * 8;
+            output += 8 * SATURNIN_BLOCK_SIZE;
+            input += 8 * SATURNIN_BLOCK_SIZE;
+            count -= 8;
+        }
+    }
+#else
+#if SATURNIN_VECTOR && SATURNIN_HAVE_X16
+    while (count >= 16) {
+        saturnin_encrypt_x16(ks, ks_step, output, input, domain);
+        ks += ks_step * 16;
+        output += 16 * SATURNIN_BLOCK_SIZE;
+        input += 16 * SATURNIN_BLOCK_SIZE;
+        count -= 16;
+    }
+#endif
+#if SATURNIN_VECTOR && SATURNIN_HAVE_X8
+    while (count >= 8) {
+        saturnin_encrypt_x8(ks, ks_step, output, input, domain);
+        ks += ks_step * 8;
+        output += 8 * SATURNIN_BLOCK_SIZE;
+        input += 8 * SATURNIN_BLOCK_SIZE;
+        count -= 8;
+    }
+#endif
+#endif
+#if SATURNIN_VECTOR && SATURNIN_HAVE_X4
+    while (count >= 4) {
+        saturnin_encrypt_x4(ks, ks_step, output, input, domain);
+        ks += ks_step * 4;
+        output += 4 * SATURNIN_BLOCK_SIZE;
+        input += 4 * SATURNIN_BLOCK_SIZE;
+        count -= 4;
+    }
+#endif
+    while (count > 0) {
+        saturnin_encrypt_block(ks, output, input, domain);
+        ks += ks_step;
+        output += SATURNIN_BLOCK_SIZE;
+        input += SATURNIN_BLOCK_SIZE;
+        --count;
+    }
+}
+
+void saturnin_encrypt_blocks
+    (const saturnin_key_schedule_t *ks, unsigned char *output,
+     const unsigned char *input, unsigned count, unsigned domain)
+{
+    saturnin_encrypt_lanes(ks, 0, output, input, count, domain);
+}
+
+void saturnin_encrypt_blocks_multi_key
+    (const saturnin_key_schedule_t *ks, unsigned char *output,
+     const unsigned char *input, unsigned count, unsigned domain)
+{
+    saturnin_encrypt_lanes(ks, 1, output, input, count, domain);
+}
+
+const char *saturnin_multi_block_variant(void)
+{
+#if defined(__AVX512F__) && SATURNIN_VECTOR
+    return "AVX-512";
+#elif SATURNIN_SIMD_DISPATCH
+    static const char * const names[] = {"C", "AVX2", "AVX-512"};
+#if SATURNIN_HAVE_X4
+    if (lw_simd_level() == LW_SIMD_LEVEL_C)
+        return "Vector";
+#endif
+    return names[lw_simd_level()];
+#elif defined(__AVX2__) && SATURNIN_VECTOR
+    return "AVX2";
+#elif SATURNIN_VECTOR
+    return "Vector";
+#else
+    return "C";
+#endif
+}
@@ -130,6 +130,108 @@ void saturnin_decrypt_block
     (const saturnin_key_schedule_t *ks, unsigned char *output,
      const unsigned char *input, unsigned domain);
 
+/**
+ * \brief Defined to 1 if the multi-block Saturnin kernels are selected at
+ * runtime according to the features of the CPU.
+ *
+ * This is the case on x86 with GCC or clang unless the library was
+ * compiled with AVX-512 enabled, in which case the best kernel is
+ * already known at compile time.
+ */
+#if LW_SIMD_DISPATCH && !defined(SATURNIN_NO_SIMD_DISPATCH)
+#define SATURNIN_SIMD_DISPATCH 1
+#else
+#define SATURNIN_SIMD_DISPATCH 0
+#endif
+
+/**
+ * \brief Defined to 1 if the multi-block Saturnin kernels can be built
+ * with the vector extensions of GCC and clang.
+ *
+ * The kernels place one block in each 32-bit lane of a vector register,
+ * so they need at least 128-bit vectors to be worthwhile.
+ */
+#if !defined(__AVR__) && (defined(__GNUC__) || defined(__clang__)) && \
+        (defined(__SSE2__) || defined(__ARM_NEON) || defined(__ARM_NEON__) || \
+         SATURNIN_SIMD_DISPATCH)
+#define SATURNIN_VECTOR 1
+#else
+#define SATURNIN_VECTOR 0
+#endif
+
+/**
+ * \brief Number of Saturnin blocks that are encrypted in parallel by the
+ * widest multi-block kernel available on this platform.
+ *
+ * This is 16 when AVX-512 may be available, 8 for AVX2, 4 for other
+ * 128-bit vector units, and 1 when there are no vector kernels.  Callers
+ * can use this to size the buffers that they pass to
+ * saturnin_encrypt_blocks().
+ */
+#if defined(__AVX512F__) || SATURNIN_SIMD_DISPATCH
+#define SATURNIN_MAX_LANES 16
+#elif defined(__AVX2__) && SATURNIN_VECTOR
+#define SATURNIN_MAX_LANES 8
+#elif SATURNIN_VECTOR
+#define SATURNIN_MAX_LANES 4
+#else
+#define SATURNIN_MAX_LANES 1
+#endif
+
+/**
+ * \brief Encrypts several 256-bit blocks with Saturnin and the same key.
+ *
+ * \param ks Points to the Saturnin key schedule.
+ * \param output Output buffer which must be at least 32 * \a count bytes
+ * in length.
+ * \param input Input buffer which must be at least 32 * \a count bytes
+ * in length.
+ * \param count Number of blocks to encrypt.
+ * \param domain Domain separator and round count indicator.
+ *
+ * The blocks are processed SATURNIN_MAX_LANES at a time where possible,
+ * with any left-over blocks encrypted one at a time.  The result is the
+ * same as calling saturnin_encrypt_block() on each block.
+ *
+ * The \a input and \a output buffers can be the same buffer for
+ * in-place encryption.
+ */
+void saturnin_encrypt_blocks
+    (const saturnin_key_schedule_t *ks, unsigned char *output,
+     const unsigned char *input, unsigned count, unsigned domain);
+
+/**
+ * \brief Encrypts several 256-bit blocks with Saturnin, each with its
+ * own key.
+ *
+ * \param ks Points to an array of \a count key schedules, one per block.
+ * \param output Output buffer which must be at least 32 * \a count bytes
+ * in length.
+ * \param input Input buffer which must be at least 32 * \a count bytes
+ * in length.
+ * \param count Number of blocks to encrypt.
+ * \param domain Domain separator and round count indicator.
+ *
+ * This is used for hashing several messages at once, where the key for
+ * each block is the chaining value of a different message.
+ *
+ * The \a input and \a output buffers can be the same buffer for
+ * in-place encryption.
+ */
+void saturnin_encrypt_blocks_multi_key
+    (const saturnin_key_schedule_t *ks, unsigned char *output,
+     const unsigned char *input, unsigned count, unsigned domain);
+
+/**
+ * \brief Gets the name of the multi-block kernel that is in use.
+ *
+ * \return One of "AVX-512", "AVX2", "Vector", or "C".
+ *
+ * When SATURNIN_SIMD_DISPATCH is set, the kernel is chosen on first use by
+ * querying the CPU.  This function is intended for tests and benchmarks.
+ */
+const char *saturnin_multi_block_variant(void);
+
 #ifdef __cplusplus
 }
 #endif
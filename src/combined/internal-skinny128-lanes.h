@@ -0,0 +1,268 @@
+/*
+ * Copyright (C) 2020 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* We expect a number of macros to be defined before this file
+ * is included to configure the multi-block SKINNY-128 kernels.
+ *
+ * SKINNY128_LANES_SUFFIX   Suffix to append to the kernel names; e.g. _x4.
+ * SKINNY128_LANES          Number of blocks that are processed in parallel.
+ * SKINNY128_LANES_TARGET   Function attributes for the kernels, such as
+ *                          the instruction set to compile them for.
+ *
+ * The kernels place one block in each 32-bit lane of a vector.  TK2 and
+ * TK3 come from the shared precomputed key schedule, but every block has
+ * its own TK1 value which is permuted in the vector lanes alongside the
+ * state.  This suits modes like SKINNY-AEAD where the blocks only differ
+ * in the counter that is stored in TK1.
+ */
+#if defined(SKINNY128_LANES_SUFFIX)
+
+#define SKINNY128_CONCAT_INNER(name,suffix) name##suffix
+#define SKINNY128_CONCAT(name,suffix) SKINNY128_CONCAT_INNER(name,suffix)
+#define SKINNY128_VEC_T SKINNY128_CONCAT(skinny128_vec,SKINNY128_LANES_SUFFIX)
+#define SKINNY128_SET_T SKINNY128_CONCAT(skinny128_set,SKINNY128_LANES_SUFFIX)
+
+/* Vector type with one 32-bit lane per block */
+typedef uint32_t SKINNY128_VEC_T
+    __attribute__((vector_size(SKINNY128_LANES * 4)));
+
+/* Rows of the state or TK1 for all blocks, as vectors or as words */
+typedef union
+{
+    SKINNY128_VEC_T v[4];
+    uint32_t w[4][SKINNY128_LANES];
+
+} SKINNY128_SET_T;
+
+/* Redirect the sbox and tweakey permutation macros to the vector type */
+#undef SKINNY128_WORD
+#define SKINNY128_WORD SKINNY128_VEC_T
+
+/* Rotates every lane of a vector left */
+#define skinny128_lanes_rotate(x, bits) \
+    (((x) << (bits)) | ((x) >> (32 - (bits))))
+
+/* Vector version of skinny_128_384_round() */
+#define skinny128_lanes_round(s0, s1, s2, s3, half, offset) \
+    do { \
+        skinny128_sbox(s0); \
+        skinny128_sbox(s1); \
+        skinny128_sbox(s2); \
+        skinny128_sbox(s3); \
+        s0 ^= TK1[half * 2]     ^ schedule[offset * 2]; \
+        s1 ^= TK1[half * 2 + 1] ^ schedule[offset * 2 + 1]; \
+        s2 ^= 0x02; \
+        s1 = skinny128_lanes_rotate(s1, 8); \
+        s2 = skinny128_lanes_rotate(s2, 16); \
+        s3 = skinny128_lanes_rotate(s3, 24); \
+        s1 ^= s2; \
+        s2 ^= s0; \
+        s3 ^= s2; \
+        skinny128_permute_tk_half \
+            (TK1[(1 - half) * 2], TK1[(1 - half) * 2 + 1]); \
+    } while (0)
+
+/* Vector version of skinny_128_384_inv_round() */
+#define skinny128_lanes_inv_round(s0, s1, s2, s3, half, offset) \
+    do { \
+        skinny128_inv_permute_tk_half \
+            (TK1[(1 - half) * 2], TK1[(1 - half) * 2 + 1]); \
+        s0 ^= s3; \
+        s3 ^= s1; \
+        s2 ^= s3; \
+        s2 = skinny128_lanes_rotate(s2, 24); \
+        s3 = skinny128_lanes_rotate(s3, 16); \
+        s0 = skinny128_lanes_rotate(s0, 8); \
+        s1 ^= TK1[half * 2]     ^ schedule[offset * 2]; \
+        s2 ^= TK1[half * 2 + 1] ^ schedule[offset * 2 + 1]; \
+        s3 ^= 0x02; \
+        skinny128_inv_sbox(s0); \
+        skinny128_inv_sbox(s1); \
+        skinny128_inv_sbox(s2); \
+        skinny128_inv_sbox(s3); \
+    } while (0)
+
+/**
+ * \brief Transposes SKINNY128_LANES 16-byte values into vector lanes.
+ *
+ * \param set The set of rows on output.
+ * \param input Input buffer for all blocks.
+ */
+static SKINNY128_LANES_TARGET void SKINNY128_CONCAT
+    (skinny128_load,SKINNY128_LANES_SUFFIX)
+    (SKINNY128_SET_T *set, const unsigned char *input)
+{
+    unsigned lane, row;
+    for (lane = 0; lane < SKINNY128_LANES; ++lane, input += 16) {
+        for (row = 0; row < 4; ++row)
+            set->w[row][lane] = le_load_word32(input + row * 4);
+    }
+}
+
+/**
+ * \brief Transposes vector lanes back into SKINNY128_LANES blocks.
+ *
+ * \param set The set of rows to store.
+ * \param output Output buffer for all blocks.
+ */
+static SKINNY128_LANES_TARGET void SKINNY128_CONCAT
+    (skinny128_store,SKINNY128_LANES_SUFFIX)
+    (const SKINNY128_SET_T *set, unsigned char *output)
+{
+    unsigned lane, row;
+    for (lane = 0; lane < SKINNY128_LANES; ++lane, output += 16) {
+        for (row = 0; row < 4; ++row)
+            le_store_word32(output + row * 4, set->w[row][lane]);
+    }
+}
+
+/**
+ * \brief Encrypts SKINNY128_LANES blocks in parallel with SKINNY-128-256
+ * or SKINNY-128-384.
+ *
+ * \param schedule Points to the precomputed TK2/TK3 key schedule.
+ * \param rounds Number of rounds; a multiple of 4.
+ * \param tk1 Points to the TK1 values for all blocks, 16 bytes each.
+ * \param output Output buffer for all blocks.
+ * \param input Input buffer for all blocks.
+ */
+static SKINNY128_LANES_TARGET void SKINNY128_CONCAT
+    (skinny_128_encrypt,SKINNY128_LANES_SUFFIX)
+    (const uint32_t *schedule, unsigned rounds, const unsigned char *tk1,
+     unsigned char *output, const unsigned char *input)
+{
+    SKINNY128_SET_T set;
+    SKINNY128_VEC_T s0, s1, s2, s3;
+    SKINNY128_VEC_T TK1[4];
+    unsigned round;
+
+    /* Load TK1 and the plaintext blocks into the vector lanes */
+    SKINNY128_CONCAT(skinny128_load,SKINNY128_LANES_SUFFIX)(&set, tk1);
+    TK1[0] = set.v[0];
+    TK1[1] = set.v[1];
+    TK1[2] = set.v[2];
+    TK1[3] = set.v[3];
+    SKINNY128_CONCAT(skinny128_load,SKINNY128_LANES_SUFFIX)(&set, input);
+    s0 = set.v[0];
+    s1 = set.v[1];
+    s2 = set.v[2];
+    s3 = set.v[3];
+
+    /* Perform all encryption rounds four at a time */
+    for (round = 0; round < rounds; round += 4, schedule += 8) {
+        skinny128_lanes_round(s0, s1, s2, s3, 0, 0);
+        skinny128_lanes_round(s3, s0, s1, s2, 1, 1);
+        skinny128_lanes_round(s2, s3, s0, s1, 0, 2);
+        skinny128_lanes_round(s1, s2, s3, s0, 1, 3);
+    }
+
+    /* Write the ciphertext blocks */
+    set.v[0] = s0;
+    set.v[1] = s1;
+    set.v[2] = s2;
+    set.v[3] = s3;
+    SKINNY128_CONCAT(skinny128_store,SKINNY128_LANES_SUFFIX)(&set, output);
+}
+
+/**
+ * \brief Decrypts SKINNY128_LANES blocks in parallel with SKINNY-128-256
+ * or SKINNY-128-384.
+ *
+ * \param schedule Points to the precomputed TK2/TK3 key schedule.
+ * \param rounds Number of rounds; a multiple of 4.
+ * \param tk1 Points to the TK1 values for all blocks, 16 bytes each.
+ * \param output Output buffer for all blocks.
+ * \param input Input buffer for all blocks.
+ */
+static SKINNY128_LANES_TARGET void SKINNY128_CONCAT
+    (skinny_128_decrypt,SKINNY128_LANES_SUFFIX)
+    (const uint32_t *schedule, unsigned rounds, const unsigned char *tk1,
+     unsigned char *output, const unsigned char *input)
+{
+    SKINNY128_SET_T set;
+    SKINNY128_VEC_T s0, s1, s2, s3;
+    SKINNY128_VEC_T TK1[4];
+    unsigned round, lane;
+
+    /* Load TK1 and fast-forward it to the end of the key schedule.  The
+     * tweak permutation repeats every 16 rounds, so this is only needed
+     * when the number of rounds is not a multiple of 16 */
+    SKINNY128_CONCAT(skinny128_load,SKINNY128_LANES_SUFFIX)(&set, tk1);
+    if ((rounds % 16) != 0) {
+        for (lane = 0; lane < SKINNY128_LANES; ++lane) {
+            uint32_t tk[4];
+            tk[0] = set.w[0][lane];
+            tk[1] = set.w[1][lane];
+            tk[2] = set.w[2][lane];
+            tk[3] = set.w[3][lane];
+            skinny128_fast_forward_tk(tk);
+            set.w[0][lane] = tk[0];
+            set.w[1][lane] = tk[1];
+            set.w[2][lane] = tk[2];
+            set.w[3][lane] = tk[3];
+        }
+    }
+    TK1[0] = set.v[0];
+    TK1[1] = set.v[1];
+    TK1[2] = set.v[2];
+    TK1[3] = set.v[3];
+
+    /* Load the ciphertext blocks into the vector lanes */
+    SKINNY128_CONCAT(skinny128_load,SKINNY128_LANES_SUFFIX)(&set, input);
+    s0 = set.v[0];
+    s1 = set.v[1];
+    s2 = set.v[2];
+    s3 = set.v[3];
+
+    /* Perform all decryption rounds four at a time */
+    schedule += rounds * 2 - 8;
+    for (round = 0; round < rounds; round += 4, schedule -= 8) {
+        skinny128_lanes_inv_round(s0, s1, s2, s3, 1, 3);
+        skinny128_lanes_inv_round(s1, s2, s3, s0, 0, 2);
+        skinny128_lanes_inv_round(s2, s3, s0, s1, 1, 1);
+        skinny128_lanes_inv_round(s3, s0, s1, s2, 0, 0);
+    }
+
+    /* Write the plaintext blocks */
+    set.v[0] = s0;
+    set.v[1] = s1;
+    set.v[2] = s2;
+    set.v[3] = s3;
+    SKINNY128_CONCAT(skinny128_store,SKINNY128_LANES_SUFFIX)(&set, output);
+}
+
+#endif /* SKINNY128_LANES_SUFFIX */
+
+/* Now undefine everything so that we can include this file again for
+ * another kernel width */
+#undef SKINNY128_LANES_SUFFIX
+#undef SKINNY128_LANES
+#undef SKINNY128_LANES_TARGET
+#undef SKINNY128_CONCAT_INNER
+#undef SKINNY128_CONCAT
+#undef SKINNY128_VEC_T
+#undef SKINNY128_SET_T
+#undef skinny128_lanes_rotate
+#undef skinny128_lanes_round
+#undef skinny128_lanes_inv_round
+#undef SKINNY128_WORD
+#define SKINNY128_WORD uint32_t
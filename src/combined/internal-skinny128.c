@@ -126,6 +126,40 @@ void skinny_128_384_init
 #endif
 }
 
+void skinny_128_384_xor_tk2
+    (skinny_128_384_key_schedule_t *ks, const unsigned char tk2[16])
+{
+#if SKINNY_128_SMALL_SCHEDULE
+    lw_xor_block(ks->TK2, tk2, 16);
+#else
+    uint32_t TK2[4];
+    uint32_t *schedule;
+    unsigned round;
+
+    /* Load the initial state of TK2 */
+    TK2[0] = le_load_word32(tk2);
+    TK2[1] = le_load_word32(tk2 + 4);
+    TK2[2] = le_load_word32(tk2 + 8);
+    TK2[3] = le_load_word32(tk2 + 12);
+
+    /* XOR the TK2 part of each round into the key schedule.  The round
+     * constants and TK3 are already present from skinny_128_384_init() */
+    schedule = ks->k;
+    for (round = 0; round < SKINNY_128_384_ROUNDS; round += 2, schedule += 4) {
+        schedule[0] ^= TK2[0];
+        schedule[1] ^= TK2[1];
+        skinny128_permute_tk_half(TK2[2], TK2[3]);
+        skinny128_LFSR2(TK2[2]);
+        skinny128_LFSR2(TK2[3]);
+        schedule[2] ^= TK2[2];
+        schedule[3] ^= TK2[3];
+        skinny128_permute_tk_half(TK2[0], TK2[1]);
+        skinny128_LFSR2(TK2[0]);
+        skinny128_LFSR2(TK2[1]);
+    }
+#endif
+}
+
 /**
  * \brief Performs an unrolled round for Skinny-128-384 when only TK1 is
  * computed on the fly.
@@ -931,6 +965,12 @@ void skinny_128_256_encrypt_tk_full
 
 #else /* __AVR__ */
 
+void skinny_128_384_xor_tk2
+    (skinny_128_384_key_schedule_t *ks, const unsigned char tk2[16])
+{
+    lw_xor_block(ks->TK2, tk2, 16);
+}
+
 void skinny_128_384_encrypt_tk2
     (skinny_128_384_key_schedule_t *ks, unsigned char *output,
      const unsigned char *input, const unsigned char *tk2)
@@ -940,3 +980,162 @@ void skinny_128_384_encrypt_tk2
 }
 
 #endif /* __AVR__ */
+
+#if SKINNY_128_VECTOR
+
+/* 128-bit kernels for the baseline vector unit; SSE2 or NEON */
+#if defined(__SSE2__) || defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SKINNY_128_HAVE_X4 1
+#define SKINNY128_LANES_SUFFIX _x4
+#define SKINNY128_LANES 4
+#define SKINNY128_LANES_TARGET
+#include "internal-skinny128-lanes.h"
+#else
+#define SKINNY_128_HAVE_X4 0
+#endif
+
+/* 256-bit kernels for AVX2 */
+#if defined(__AVX2__) || SKINNY_128_SIMD_DISPATCH
+#define SKINNY_128_HAVE_X8 1
+#define SKINNY128_LANES_SUFFIX _x8
+#define SKINNY128_LANES 8
+#define SKINNY128_LANES_TARGET LW_TARGET_AVX2
+#include "internal-skinny128-lanes.h"
+#else
+#define SKINNY_128_HAVE_X8 0
+#endif
+
+/* 512-bit kernels for AVX-512 */
+#if defined(__AVX512F__) || SKINNY_128_SIMD_DISPATCH
+#define SKINNY_128_HAVE_X16 1
+#define SKINNY128_LANES_SUFFIX _x16
+#define SKINNY128_LANES 16
+#define SKINNY128_LANES_TARGET LW_TARGET_AVX512
+#include "internal-skinny128-lanes.h"
+#else
+#define SKINNY_128_HAVE_X16 0
+#endif
+
+#else /* !SKINNY_128_VECTOR */
+
+#define SKINNY_128_HAVE_X4 0
+#define SKINNY_128_HAVE_X8 0
+#define SKINNY_128_HAVE_X16 0
+
+#endif /* !SKINNY_128_VECTOR */
+
+/* Processes a run of "width" blocks at a time with a multi-block kernel */
+#define skinny_128_blocks_run(kernel, width, rounds) \
+    do { \
+        while (count >= (width)) { \
+            kernel(ks->k, (rounds), tk1, output, input); \
+            tk1 += (width) * 16; \
+            output += (width) * 16; \
+            input += (width) * 16; \
+            count -= (width); \
+        } \
+    } while (0)
+#if SKINNY_128_HAVE_X16 && !SKINNY_128_SIMD_DISPATCH
+#define skinny_128_blocks_x16(name, rounds) \
+    skinny_128_blocks_run(name##_x16, 16, (rounds))
+#else
+#define skinny_128_blocks_x16(name, rounds) do { ; } while (0)
+#endif
+#if SKINNY_128_HAVE_X8 && !SKINNY_128_SIMD_DISPATCH
+#define skinny_128_blocks_x8(name, rounds) \
+    skinny_128_blocks_run(name##_x8, 8, (rounds))
+#else
+#define skinny_128_blocks_x8(name, rounds) do { ; } while (0)
+#endif
+#if SKINNY_128_HAVE_X4
+#define skinny_128_blocks_x4(name, rounds) \
+    skinny_128_blocks_run(name##_x4, 4, (rounds))
+#else
+#define skinny_128_blocks_x4(name, rounds) do { ; } while (0)
+#endif
+
+/* Processes "count" blocks with the widest kernels that are available,
+ * and then the left-over blocks with the single-block function "single" */
+#if SKINNY_128_SIMD_DISPATCH
+#define skinny_128_blocks(name, rounds, single) \
+    do { \
+        int level = lw_simd_level(); \
+        if (level == LW_SIMD_LEVEL_AVX512) \
+            skinny_128_blocks_run(name##_x16, 16, (rounds)); \
+        if (level >= LW_SIMD_LEVEL_AVX2) \
+            skinny_128_blocks_run(name##_x8, 8, (rounds)); \
+        skinny_128_blocks_x4(name, (rounds)); \
+        skinny_128_blocks_single(single); \
+    } while (0)
+#else
+#define skinny_128_blocks(name, rounds, single) \
+    do { \
+        skinny_128_blocks_x16(name, (rounds)); \
+        skinny_128_blocks_x8(name, (rounds)); \
+        skinny_128_blocks_x4(name, (rounds)); \
+        skinny_128_blocks_single(single); \
+    } while (0)
+#endif
+#define skinny_128_blocks_single(single) \
+    do { \
+        while (count > 0) { \
+            memcpy(ks->TK1, tk1, 16); \
+            single(ks, output, input); \
+            tk1 += 16; \
+            output += 16; \
+            input += 16; \
+            --count; \
+        } \
+    } while (0)
+
+void skinny_128_384_encrypt_blocks
+    (skinny_128_384_key_schedule_t *ks, const unsigned char *tk1,
+     unsigned char *output, const unsigned char *input, unsigned count)
+{
+    skinny_128_blocks(skinny_128_encrypt, SKINNY_128_384_ROUNDS,
+                      skinny_128_384_encrypt);
+}
+
+void skinny_128_384_decrypt_blocks
+    (skinny_128_384_key_schedule_t *ks, const unsigned char *tk1,
+     unsigned char *output, const unsigned char *input, unsigned count)
+{
+    skinny_128_blocks(skinny_128_decrypt, SKINNY_128_384_ROUNDS,
+                      skinny_128_384_decrypt);
+}
+
+void skinny_128_256_encrypt_blocks
+    (skinny_128_256_key_schedule_t *ks, const unsigned char *tk1,
+     unsigned char *output, const unsigned char *input, unsigned count)
+{
+    skinny_128_blocks(skinny_128_encrypt, SKINNY_128_256_ROUNDS,
+                      skinny_128_256_encrypt);
+}
+
+void skinny_128_256_decrypt_blocks
+    (skinny_128_256_key_schedule_t *ks, const unsigned char *tk1,
+     unsigned char *output, const unsigned char *input, unsigned count)
+{
+    skinny_128_blocks(skinny_128_decrypt, SKINNY_128_256_ROUNDS,
+                      skinny_128_256_decrypt);
+}
+
+const char *skinny_128_multi_block_variant(void)
+{
+#if defined(__AVX512F__) && SKINNY_128_VECTOR
+    return "AVX-512";
+#elif SKINNY_128_SIMD_DISPATCH
+    static const char * const names[] = {"C", "AVX2", "AVX-512"};
+#if SKINNY_128_HAVE_X4
+    if (lw_simd_level() == LW_SIMD_LEVEL_C)
+        return "Vector";
+#endif
+    return names[lw_simd_level()];
+#elif defined(__AVX2__) && SKINNY_128_VECTOR
+    return "AVX2";
+#elif SKINNY_128_VECTOR
+    return "Vector";
+#else
+    return "C";
+#endif
+}
@@ -31,6 +31,7 @@
  * https://sites.google.com/site/skinnycipher/
  */
 
+#include "internal-util.h"
 #include <stddef.h>
 #include <stdint.h>
 
@@ -88,6 +89,20 @@ typedef struct
 void skinny_128_384_init
     (skinny_128_384_key_schedule_t *ks, const unsigned char key[48]);
 
+/**
+ * \brief XOR's a TK2 value into a SKINNY-128-384 key schedule.
+ *
+ * \param ks Points to the key schedule to modify.
+ * \param tk2 Points to the 16 bytes of the TK2 value.
+ *
+ * The key schedule is linear in TK2, so if \a ks was initialized by
+ * skinny_128_384_init() with TK2 set to zero, then this produces the
+ * same key schedule as initializing it with \a tk2 directly.  This is
+ * useful when TK3 is fixed but TK2 changes from packet to packet.
+ */
+void skinny_128_384_xor_tk2
+    (skinny_128_384_key_schedule_t *ks, const unsigned char tk2[16]);
+
 /**
  * \brief Encrypts a 128-bit block with SKINNY-128-384.
  *
@@ -237,6 +252,147 @@ void skinny_128_256_encrypt_tk_full
     (const unsigned char key[32], unsigned char *output,
      const unsigned char *input);
 
+/**
+ * \brief Defined to 1 if the multi-block SKINNY-128 kernels are selected
+ * at runtime according to the features of the CPU.
+ */
+#if LW_SIMD_DISPATCH && !defined(SKINNY_128_NO_SIMD_DISPATCH)
+#define SKINNY_128_SIMD_DISPATCH 1
+#else
+#define SKINNY_128_SIMD_DISPATCH 0
+#endif
+
+/**
+ * \brief Defined to 1 if the multi-block SKINNY-128 kernels can be built
+ * with the vector extensions of GCC and clang.
+ *
+ * The kernels place one block in each 32-bit lane of a vector register
+ * and need the full precomputed key schedule.
+ */
+#if !SKINNY_128_SMALL_SCHEDULE && \
+        (defined(__GNUC__) || defined(__clang__)) && \
+        (defined(__SSE2__) || defined(__ARM_NEON) || defined(__ARM_NEON__) || \
+         SKINNY_128_SIMD_DISPATCH)
+#define SKINNY_128_VECTOR 1
+#else
+#define SKINNY_128_VECTOR 0
+#endif
+
+/**
+ * \brief Number of blocks that are processed in parallel by the widest
+ * multi-block SKINNY-128 kernel available on this platform.
+ *
+ * Modes can use this to decide how many blocks and TK1 values to gather
+ * before calling skinny_128_384_encrypt_blocks() and friends.
+ */
+#if defined(__AVX512F__) || SKINNY_128_SIMD_DISPATCH
+#define SKINNY_128_MAX_LANES 16
+#elif defined(__AVX2__) && SKINNY_128_VECTOR
+#define SKINNY_128_MAX_LANES 8
+#elif SKINNY_128_VECTOR
+#define SKINNY_128_MAX_LANES 4
+#else
+#define SKINNY_128_MAX_LANES 1
+#endif
+
+/**
+ * \brief Encrypts several 128-bit blocks with SKINNY-128-384, each with
+ * its own TK1 value.
+ *
+ * \param ks Points to the SKINNY-128-384 key schedule.
+ * \param tk1 Points to \a count TK1 values, 16 bytes for each block.
+ * \param output Output buffer which must be at least 16 * \a count bytes
+ * in length.
+ * \param input Input buffer which must be at least 16 * \a count bytes
+ * in length.
+ * \param count Number of blocks to encrypt.
+ *
+ * The result is the same as copying each TK1 value into the key schedule
+ * and then calling skinny_128_384_encrypt() on the corresponding block.
+ *
+ * The \a input and \a output buffers can be the same buffer for
+ * in-place encryption.
+ *
+ * \note Blocks that are not handled by a multi-block kernel are encrypted
+ * one at a time by copying their TK1 value into \a ks, so the TK1 field
+ * of the key schedule may be modified on exit.
+ */
+void skinny_128_384_encrypt_blocks
+    (skinny_128_384_key_schedule_t *ks, const unsigned char *tk1,
+     unsigned char *output, const unsigned char *input, unsigned count);
+
+/**
+ * \brief Decrypts several 128-bit blocks with SKINNY-128-384, each with
+ * its own TK1 value.
+ *
+ * \param ks Points to the SKINNY-128-384 key schedule.
+ * \param tk1 Points to \a count TK1 values, 16 bytes for each block.
+ * \param output Output buffer which must be at least 16 * \a count bytes
+ * in length.
+ * \param input Input buffer which must be at least 16 * \a count bytes
+ * in length.
+ * \param count Number of blocks to decrypt.
+ *
+ * The \a input and \a output buffers can be the same buffer for
+ * in-place decryption.
+ *
+ * \note The TK1 field of the key schedule may be modified on exit.
+ */
+void skinny_128_384_decrypt_blocks
+    (skinny_128_384_key_schedule_t *ks, const unsigned char *tk1,
+     unsigned char *output, const unsigned char *input, unsigned count);
+
+/**
+ * \brief Encrypts several 128-bit blocks with SKINNY-128-256, each with
+ * its own TK1 value.
+ *
+ * \param ks Points to the SKINNY-128-256 key schedule.
+ * \param tk1 Points to \a count TK1 values, 16 bytes for each block.
+ * \param output Output buffer which must be at least 16 * \a count bytes
+ * in length.
+ * \param input Input buffer which must be at least 16 * \a count bytes
+ * in length.
+ * \param count Number of blocks to encrypt.
+ *
+ * The \a input and \a output buffers can be the same buffer for
+ * in-place encryption.
+ *
+ * \note The TK1 field of the key schedule may be modified on exit.
+ */
+void skinny_128_256_encrypt_blocks
+    (skinny_128_256_key_schedule_t *ks, const unsigned char *tk1,
+     unsigned char *output, const unsigned char *input, unsigned count);
+
+/**
+ * \brief Decrypts several 128-bit blocks with SKINNY-128-256, each with
+ * its own TK1 value.
+ *
+ * \param ks Points to the SKINNY-128-256 key schedule.
+ * \param tk1 Points to \a count TK1 values, 16 bytes for each block.
+ * \param output Output buffer which must be at least 16 * \a count bytes
+ * in length.
+ * \param input Input buffer which must be at least 16 * \a count bytes
+ * in length.
+ * \param count Number of blocks to decrypt.
+ *
+ * The \a input and \a output buffers can be the same buffer for
+ * in-place decryption.
+ *
+ * \note The TK1 field of the key schedule may be modified on exit.
+ */
+void skinny_128_256_decrypt_blocks
+    (skinny_128_256_key_schedule_t *ks, const unsigned char *tk1,
+     unsigned char *output, const unsigned char *input, unsigned count);
+
+/**
+ * \brief Gets the name of the multi-block kernel that is in use.
+ *
+ * \return One of "AVX-512", "AVX2", "Vector", or "C".
+ *
+ * This function is intended for tests and benchmarks.
+ */
+const char *skinny_128_multi_block_variant(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -38,6 +38,11 @@ extern "C" {
 
 /* Utilities for implementing SKINNY-128 */
 
+/* Type of the words that the SKINNY-128 macros below operate on.  The
+ * multi-block kernels in internal-skinny128-lanes.h redefine this to be
+ * a vector with one block in each 32-bit lane */
+#define SKINNY128_WORD uint32_t
+
 #define skinny128_LFSR2(x) \
     do { \
         uint32_t _x = (x); \
@@ -77,8 +82,8 @@ extern "C" {
 #define skinny128_permute_tk_half(tk2, tk3) \
     do { \
         /* Permute the bottom half of the tweakey state in place, no swap */ \
-        uint32_t row2 = tk2; \
-        uint32_t row3 = tk3; \
+        SKINNY128_WORD row2 = tk2; \
+        SKINNY128_WORD row3 = tk3; \
         row3 = (row3 << 16) | (row3 >> 16); \
         tk2 = ((row2 >>  8) & 0x000000FFU) | \
               ((row2 << 16) & 0x00FF0000U) | \
@@ -109,8 +114,8 @@ extern "C" {
 #define skinny128_inv_permute_tk_half(tk0, tk1) \
     do { \
         /* Permute the top half of the tweakey state in place, no swap */ \
-        uint32_t row0 = tk0; \
-        uint32_t row1 = tk1; \
+        SKINNY128_WORD row0 = tk0; \
+        SKINNY128_WORD row1 = tk1; \
         tk0 = ((row0 >> 16) & 0x000000FFU) | \
               ((row0 <<  8) & 0x0000FF00U) | \
               ((row1 << 16) & 0x00FF0000U) | \
@@ -153,7 +158,7 @@ extern "C" {
  */
 #define skinny128_sbox(x) \
 do { \
-    uint32_t y; \
+    SKINNY128_WORD y; \
     \
     /* Mix the bits */ \
     x = ~x; \
@@ -208,7 +213,7 @@ do { \
  */
 #define skinny128_inv_sbox(x) \
 do { \
-    uint32_t y; \
+    SKINNY128_WORD y; \
     \
     /* Mix the bits */ \
     x = ~x; \
@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2020 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* Multi-state SPARKLE kernels.  We expect a number of macros to be defined
+ * before each inclusion of this file to configure a kernel:
+ *
+ * SPARKLE_LANES_NAME       Name of the kernel function; e.g. sparkle_384_x4.
+ * SPARKLE_LANES            Number of states that are permuted in parallel.
+ * SPARKLE_LANES_BRANCHES   Number of 64-bit branches in each state;
+ *                          6 for SPARKLE-384 or 8 for SPARKLE-512.
+ * SPARKLE_LANES_TARGET     Function attributes for the kernel, such as
+ *                          the instruction set to compile it for.
+ *
+ * The kernel places one state in each 32-bit lane of a vector, so each
+ * ARX-box evaluates the same branch of every state at once.  The branch
+ * loops have constant bounds and are expected to be unrolled by the
+ * compiler, which turns the branch permutation into register renames.
+ */
+
+#if defined(SPARKLE_LANES_NAME)
+
+#define SPARKLE_CONCAT_INNER(name,suffix) name##suffix
+#define SPARKLE_CONCAT(name,suffix) SPARKLE_CONCAT_INNER(name,suffix)
+#define SPARKLE_VEC_T SPARKLE_CONCAT(SPARKLE_LANES_NAME,_vec_t)
+#define SPARKLE_SET_T SPARKLE_CONCAT(SPARKLE_LANES_NAME,_set_t)
+#define SPARKLE_WORDS (SPARKLE_LANES_BRANCHES * 2)
+#define SPARKLE_HALF (SPARKLE_LANES_BRANCHES / 2)
+
+/* Vector type with one 32-bit lane per state */
+typedef uint32_t SPARKLE_VEC_T __attribute__((vector_size(SPARKLE_LANES * 4)));
+
+/* Words of all states, as vectors or as individual words */
+typedef union
+{
+    SPARKLE_VEC_T v[SPARKLE_WORDS];
+    uint32_t w[SPARKLE_WORDS][SPARKLE_LANES];
+
+} SPARKLE_SET_T;
+
+/* Alzette ARX-box on the same branch of all states */
+#define sparkle_vec_rotl(x, bits) (((x) << (bits)) | ((x) >> (32 - (bits))))
+#define sparkle_vec_alzette(x, y, k) \
+    do { \
+        (x) += sparkle_vec_rotl((y), 1); \
+        (y) ^= sparkle_vec_rotl((x), 8); \
+        (x) ^= (k); \
+        (x) += sparkle_vec_rotl((y), 15); \
+        (y) ^= sparkle_vec_rotl((x), 15); \
+        (x) ^= (k); \
+        (x) += (y); \
+        (y) ^= sparkle_vec_rotl((x), 1); \
+        (x) ^= (k); \
+        (x) += sparkle_vec_rotl((y), 8); \
+        (y) ^= sparkle_vec_rotl((x), 16); \
+        (x) ^= (k); \
+    } while (0)
+
+/**
+ * \brief Permutes up to SPARKLE_LANES SPARKLE states in parallel.
+ *
+ * \param states Points to the states to be permuted, with the words in
+ * little-endian byte order.
+ * \param count Number of states to permute, between 1 and SPARKLE_LANES.
+ * \param steps The number of steps to perform.
+ */
+static SPARKLE_LANES_TARGET void SPARKLE_LANES_NAME
+    (uint32_t (*states)[SPARKLE_WORDS], unsigned count, unsigned steps)
+{
+    SPARKLE_SET_T set;
+    SPARKLE_VEC_T x[SPARKLE_LANES_BRANCHES];
+    SPARKLE_VEC_T y[SPARKLE_LANES_BRANCHES];
+    SPARKLE_VEC_T nx[SPARKLE_HALF];
+    SPARKLE_VEC_T ny[SPARKLE_HALF];
+    SPARKLE_VEC_T tx, ty;
+    unsigned lane, posn, step, branch;
+
+    /* Transpose the states so that each vector holds one word of every
+     * state.  Unused lanes are zeroed and then discarded at the end */
+    if (count < SPARKLE_LANES)
+        memset(&set, 0, sizeof(set));
+    for (lane = 0; lane < count; ++lane) {
+        for (posn = 0; posn < SPARKLE_WORDS; ++posn) {
+#if defined(LW_UTIL_LITTLE_ENDIAN)
+            set.w[posn][lane] = states[lane][posn];
+#else
+            set.w[posn][lane] = le_load_word32
+                ((const uint8_t *)&(states[lane][posn]));
+#endif
+        }
+    }
+    for (branch = 0; branch < SPARKLE_LANES_BRANCHES; ++branch) {
+        x[branch] = set.v[branch * 2];
+        y[branch] = set.v[branch * 2 + 1];
+    }
+
+    /* Perform all requested steps */
+    for (step = 0; step < steps; ++step) {
+        /* Add round constants */
+        y[0] ^= sparkle_rc[step];
+        y[1] ^= step;
+
+        /* ARXbox layer */
+        for (branch = 0; branch < SPARKLE_LANES_BRANCHES; ++branch)
+            sparkle_vec_alzette(x[branch], y[branch], sparkle_rc[branch]);
+
+        /* Linear layer; the new left half is the right half XOR'ed with
+         * the left half and the mixed parity, rotated by one branch.  The
+         * old left half becomes the new right half */
+        tx = x[0];
+        ty = y[0];
+        for (branch = 1; branch < SPARKLE_HALF; ++branch) {
+            tx ^= x[branch];
+            ty ^= y[branch];
+        }
+        tx = sparkle_vec_rotl(tx ^ (tx << 16), 16);
+        ty = sparkle_vec_rotl(ty ^ (ty << 16), 16);
+        for (branch = 0; branch < SPARKLE_HALF; ++branch) {
+            posn = (branch + 1) % SPARKLE_HALF;
+            nx[branch] = x[SPARKLE_HALF + posn] ^ x[posn] ^ ty;
+            ny[branch] = y[SPARKLE_HALF + posn] ^ y[posn] ^ tx;
+        }
+        for (branch = 0; branch < SPARKLE_HALF; ++branch) {
+            x[SPARKLE_HALF + branch] = x[branch];
+            y[SPARKLE_HALF + branch] = y[branch];
+            x[branch] = nx[branch];
+            y[branch] = ny[branch];
+        }
+    }
+
+    /* Transpose the words back into the states */
+    for (branch = 0; branch < SPARKLE_LANES_BRANCHES; ++branch) {
+        set.v[branch * 2] = x[branch];
+        set.v[branch * 2 + 1] = y[branch];
+    }
+    for (lane = 0; lane < count; ++lane) {
+        for (posn = 0; posn < SPARKLE_WORDS; ++posn) {
+#if defined(LW_UTIL_LITTLE_ENDIAN)
+            states[lane][posn] = set.w[posn][lane];
+#else
+            le_store_word32((uint8_t *)&(states[lane][posn]),
+                            set.w[posn][lane]);
+#endif
+        }
+    }
+}
+
+#undef sparkle_vec_rotl
+#undef sparkle_vec_alzette
+
+#endif /* SPARKLE_LANES_NAME */
+
+/* Now undefine everything so that we can include this file again for
+ * another kernel */
+#undef SPARKLE_LANES_NAME
+#undef SPARKLE_LANES
+#undef SPARKLE_LANES_BRANCHES
+#undef SPARKLE_LANES_TARGET
+#undef SPARKLE_CONCAT_INNER
+#undef SPARKLE_CONCAT
+#undef SPARKLE_VEC_T
+#undef SPARKLE_SET_T
+#undef SPARKLE_WORDS
+#undef SPARKLE_HALF
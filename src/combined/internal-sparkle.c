@@ -21,6 +21,7 @@
  */
 
 #include "internal-sparkle.h"
+#include <string.h>
 
 /* Determine which versions should be accelerated with assembly code */
 #if defined(__AVR__)
@@ -37,7 +38,18 @@
 #define SPARKLE_512_ASM 0
 #endif
 
-#if !SPARKLE_256_ASM || !SPARKLE_384_ASM || !SPARKLE_512_ASM
+/* Use the vector kernel for single SPARKLE-512 states if the vector unit
+ * is available.  SPARKLE-256 and SPARKLE-384 are faster with the scalar
+ * code because the ARX-boxes do not fill the vectors and each step is
+ * limited by the latency of Alzette rather than the number of branches */
+#if !SPARKLE_512_ASM && SPARKLE_HAVE_X4 && defined(LW_UTIL_LITTLE_ENDIAN)
+#define SPARKLE_512_VECTOR 1
+#else
+#define SPARKLE_512_VECTOR 0
+#endif
+
+#if !SPARKLE_256_ASM || !SPARKLE_384_ASM || !SPARKLE_512_ASM || \
+        SPARKLE_HAVE_X4 || SPARKLE_HAVE_X8
 
 /* The 8 basic round constants from the specification */
 #define RC_0 0xB7E15162
@@ -79,7 +91,7 @@ static uint32_t const sparkle_rc[12] = {
         (x) ^= (k); \
     } while (0)
 
-#endif /* !SPARKLE_256_ASM || !SPARKLE_384_ASM || !SPARKLE_512_ASM */
+#endif /* Round constants and Alzette */
 
 #if !SPARKLE_256_ASM
 
@@ -275,7 +287,111 @@ void sparkle_384(uint32_t s[SPARKLE_384_STATE_SIZE], unsigned steps)
 
 #endif /* !SPARKLE_384_ASM */
 
-#if !SPARKLE_512_ASM
+#if SPARKLE_512_VECTOR
+
+/** @cond sparkle_512_vector */
+
+/* Vector with one 32-bit lane for each of four branches */
+typedef uint32_t sparkle_vec_t __attribute__((vector_size(16)));
+
+/* Rearrange the branches within a vector */
+#if defined(__clang__)
+#define sparkle_vec_shuffle(x, i0, i1, i2, i3) \
+    __builtin_shufflevector((x), (x), i0, i1, i2, i3)
+#else
+#define sparkle_vec_shuffle(x, i0, i1, i2, i3) \
+    __builtin_shuffle((x), (sparkle_vec_t){i0, i1, i2, i3})
+#endif
+
+/* Alzette ARX-box on four branches at once */
+#define sparkle_vec_rotl(x, bits) (((x) << (bits)) | ((x) >> (32 - (bits))))
+#define sparkle_vec_alzette(x, y, k) \
+    do { \
+        (x) += sparkle_vec_rotl((y), 1); \
+        (y) ^= sparkle_vec_rotl((x), 8); \
+        (x) ^= (k); \
+        (x) += sparkle_vec_rotl((y), 15); \
+        (y) ^= sparkle_vec_rotl((x), 15); \
+        (x) ^= (k); \
+        (x) += (y); \
+        (y) ^= sparkle_vec_rotl((x), 1); \
+        (x) ^= (k); \
+        (x) += sparkle_vec_rotl((y), 8); \
+        (y) ^= sparkle_vec_rotl((x), 16); \
+        (x) ^= (k); \
+    } while (0)
+
+/* XOR's all four branches of a vector together and applies the
+ * linear mixing function, leaving the result in every lane */
+#define sparkle_vec_parity(t, x) \
+    do { \
+        (t) = (x) ^ sparkle_vec_shuffle((x), 2, 3, 0, 1); \
+        (t) ^= sparkle_vec_shuffle((t), 1, 0, 3, 2); \
+        (t) = sparkle_vec_rotl((t) ^ ((t) << 16), 16); \
+    } while (0)
+
+/** @endcond */
+
+void sparkle_512(uint32_t s[SPARKLE_512_STATE_SIZE], unsigned steps)
+{
+    static sparkle_vec_t const kl = {RC_0, RC_1, RC_2, RC_3};
+    static sparkle_vec_t const kr = {RC_4, RC_5, RC_6, RC_7};
+    sparkle_vec_t xl, yl, xr, yr;
+    sparkle_vec_t tx, ty, t;
+    unsigned step;
+
+    /* Split the state into the x and y words of the left and right
+     * halves; the host is known to be little-endian */
+    xl = (sparkle_vec_t){s[0], s[2], s[4], s[6]};
+    yl = (sparkle_vec_t){s[1], s[3], s[5], s[7]};
+    xr = (sparkle_vec_t){s[8], s[10], s[12], s[14]};
+    yr = (sparkle_vec_t){s[9], s[11], s[13], s[15]};
+
+    /* Perform all requested steps */
+    for (step = 0; step < steps; ++step) {
+        /* Add round constants */
+        yl ^= (sparkle_vec_t){sparkle_rc[step], step, 0, 0};
+
+        /* ARXbox layer */
+        sparkle_vec_alzette(xl, yl, kl);
+        sparkle_vec_alzette(xr, yr, kr);
+
+        /* Linear layer */
+        sparkle_vec_parity(tx, xl);
+        sparkle_vec_parity(ty, yl);
+        t = sparkle_vec_shuffle(xl ^ xr, 1, 2, 3, 0) ^ ty;
+        xr = xl;
+        xl = t;
+        t = sparkle_vec_shuffle(yl ^ yr, 1, 2, 3, 0) ^ tx;
+        yr = yl;
+        yl = t;
+    }
+
+    /* Write the halves back to the SPARKLE-512 state */
+    s[0]  = xl[0];
+    s[1]  = yl[0];
+    s[2]  = xl[1];
+    s[3]  = yl[1];
+    s[4]  = xl[2];
+    s[5]  = yl[2];
+    s[6]  = xl[3];
+    s[7]  = yl[3];
+    s[8]  = xr[0];
+    s[9]  = yr[0];
+    s[10] = xr[1];
+    s[11] = yr[1];
+    s[12] = xr[2];
+    s[13] = yr[2];
+    s[14] = xr[3];
+    s[15] = yr[3];
+}
+
+#undef sparkle_vec_shuffle
+#undef sparkle_vec_rotl
+#undef sparkle_vec_alzette
+#undef sparkle_vec_parity
+
+#elif !SPARKLE_512_ASM
 
 void sparkle_512(uint32_t s[SPARKLE_512_STATE_SIZE], unsigned steps)
 {
@@ -407,3 +523,117 @@ void sparkle_512(uint32_t s[SPARKLE_512_STATE_SIZE], unsigned steps)
 }
 
 #endif /* !SPARKLE_512_ASM */
+
+/* 4-state kernels for 128-bit vector units */
+#if SPARKLE_HAVE_X4
+#define SPARKLE_LANES_NAME sparkle_384_x4
+#define SPARKLE_LANES 4
+#define SPARKLE_LANES_BRANCHES 6
+#define SPARKLE_LANES_TARGET
+#include "internal-sparkle-lanes.h"
+#define SPARKLE_LANES_NAME sparkle_512_x4
+#define SPARKLE_LANES 4
+#define SPARKLE_LANES_BRANCHES 8
+#define SPARKLE_LANES_TARGET
+#include "internal-sparkle-lanes.h"
+#endif
+
+/* 8-state kernels for AVX2 */
+#if SPARKLE_HAVE_X8
+#if defined(__AVX2__)
+#define SPARKLE_X8_TARGET
+#else
+#define SPARKLE_X8_TARGET LW_TARGET_AVX2
+#endif
+#define SPARKLE_LANES_NAME sparkle_384_x8
+#define SPARKLE_LANES 8
+#define SPARKLE_LANES_BRANCHES 6
+#define SPARKLE_LANES_TARGET SPARKLE_X8_TARGET
+#include "internal-sparkle-lanes.h"
+#define SPARKLE_LANES_NAME sparkle_512_x8
+#define SPARKLE_LANES 8
+#define SPARKLE_LANES_BRANCHES 8
+#define SPARKLE_LANES_TARGET SPARKLE_X8_TARGET
+#include "internal-sparkle-lanes.h"
+#endif
+
+/**
+ * \brief Determine if the 8-state kernels can be used on this CPU.
+ */
+#if SPARKLE_SIMD_DISPATCH && !defined(__AVX2__)
+#define sparkle_can_use_x8() (lw_simd_level() >= LW_SIMD_LEVEL_AVX2)
+#else
+#define sparkle_can_use_x8() (SPARKLE_HAVE_X8)
+#endif
+
+void sparkle_384_n
+    (uint32_t (*s)[SPARKLE_384_STATE_SIZE], unsigned count, unsigned steps)
+{
+#if SPARKLE_HAVE_X4 || SPARKLE_HAVE_X8
+    unsigned n;
+#endif
+#if SPARKLE_HAVE_X8
+    if (sparkle_can_use_x8()) {
+        while (count > 4) {
+            n = (count < 8) ? count : 8;
+            sparkle_384_x8(s, n, steps);
+            s += n;
+            count -= n;
+        }
+    }
+#endif
+#if SPARKLE_HAVE_X4
+    while (count > 1) {
+        n = (count < 4) ? count : 4;
+        sparkle_384_x4(s, n, steps);
+        s += n;
+        count -= n;
+    }
+#endif
+    while (count > 0) {
+        sparkle_384(s[0], steps);
+        ++s;
+        --count;
+    }
+}
+
+void sparkle_512_n
+    (uint32_t (*s)[SPARKLE_512_STATE_SIZE], unsigned count, unsigned steps)
+{
+#if SPARKLE_HAVE_X4 || SPARKLE_HAVE_X8
+    unsigned n;
+#endif
+#if SPARKLE_HAVE_X8
+    if (sparkle_can_use_x8()) {
+        while (count > 4) {
+            n = (count < 8) ? count : 8;
+            sparkle_512_x8(s, n, steps);
+            s += n;
+            count -= n;
+        }
+    }
+#endif
+#if SPARKLE_HAVE_X4
+    while (count > 1) {
+        n = (count < 4) ? count : 4;
+        sparkle_512_x4(s, n, steps);
+        s += n;
+        count -= n;
+    }
+#endif
+    while (count > 0) {
+        sparkle_512(s[0], steps);
+        ++s;
+        --count;
+    }
+}
+
+const char *sparkle_multi_variant(void)
+{
+    if (sparkle_can_use_x8())
+        return "AVX2";
+    else if (SPARKLE_HAVE_X4)
+        return "Vector";
+    else
+        return "C";
+}
@@ -75,6 +75,87 @@ void sparkle_384(uint32_t s[SPARKLE_384_STATE_SIZE], unsigned steps);
  */
 void sparkle_512(uint32_t s[SPARKLE_512_STATE_SIZE], unsigned steps);
 
+/**
+ * \brief Defined to 1 if the multi-state SPARKLE kernels are selected
+ * at runtime according to the features of the CPU.
+ */
+#if LW_SIMD_DISPATCH && !defined(SPARKLE_NO_SIMD_DISPATCH)
+#define SPARKLE_SIMD_DISPATCH 1
+#else
+#define SPARKLE_SIMD_DISPATCH 0
+#endif
+
+/**
+ * \brief Defined to 1 if there are vector kernels for the baseline
+ * 128-bit vector unit; SSE2 or NEON.
+ *
+ * This covers both the 4-state kernels and the single-state SPARKLE-512
+ * kernel that runs the ARX-boxes of four branches in one vector.
+ */
+#if !defined(__AVR__) && (defined(__GNUC__) || defined(__clang__)) && \
+        (defined(__SSE2__) || defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define SPARKLE_HAVE_X4 1
+#else
+#define SPARKLE_HAVE_X4 0
+#endif
+
+/**
+ * \brief Defined to 1 if there are 8-state SPARKLE kernels for AVX2.
+ */
+#if (defined(__GNUC__) || defined(__clang__)) && \
+        (defined(__AVX2__) || SPARKLE_SIMD_DISPATCH)
+#define SPARKLE_HAVE_X8 1
+#else
+#define SPARKLE_HAVE_X8 0
+#endif
+
+/**
+ * \brief Maximum number of SPARKLE states that are permuted in parallel
+ * by the widest multi-state kernel available on this platform.
+ */
+#if SPARKLE_HAVE_X8
+#define SPARKLE_MAX_LANES 8
+#elif SPARKLE_HAVE_X4
+#define SPARKLE_MAX_LANES 4
+#else
+#define SPARKLE_MAX_LANES 1
+#endif
+
+/**
+ * \brief Performs the SPARKLE-384 permutation on several states.
+ *
+ * \param s Points to an array of SPARKLE-384 states, with the words of
+ * each state in little-endian byte order.
+ * \param count Number of states in the array.
+ * \param steps The number of steps to perform, 7 or 11.
+ *
+ * The states are processed up to SPARKLE_MAX_LANES at a time, with one
+ * state in each 32-bit lane of a vector.
+ */
+void sparkle_384_n
+    (uint32_t (*s)[SPARKLE_384_STATE_SIZE], unsigned count, unsigned steps);
+
+/**
+ * \brief Performs the SPARKLE-512 permutation on several states.
+ *
+ * \param s Points to an array of SPARKLE-512 states, with the words of
+ * each state in little-endian byte order.
+ * \param count Number of states in the array.
+ * \param steps The number of steps to perform, 8 or 12.
+ *
+ * The states are processed up to SPARKLE_MAX_LANES at a time, with one
+ * state in each 32-bit lane of a vector.
+ */
+void sparkle_512_n
+    (uint32_t (*s)[SPARKLE_512_STATE_SIZE], unsigned count, unsigned steps);
+
+/**
+ * \brief Gets the name of the multi-state SPARKLE kernels that are in use.
+ *
+ * \return One of "AVX2", "Vector", or "C".
+ */
+const char *sparkle_multi_variant(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2020 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* We expect a number of macros to be defined before this file
+ * is included to configure the multi-lane Spongent-pi kernels.
+ *
+ * SPONGENT_LANES_NAME      Prefix for the names of the kernel functions.
+ * SPONGENT_LANES           Number of states that are permuted in parallel.
+ * SPONGENT_LANES_TARGET    Function attributes for the kernels, such as
+ *                          the instruction set to compile them for.
+ *
+ * The kernels are built from the same macros as spongent160_permute()
+ * and spongent176_permute(), applied to vectors with one state in each
+ * 32-bit lane.
+ */
+#if defined(SPONGENT_LANES_NAME)
+
+#define SPONGENT_CONCAT_INNER(name,suffix) name##suffix
+#define SPONGENT_CONCAT(name,suffix) SPONGENT_CONCAT_INNER(name,suffix)
+#define SPONGENT_VEC_T SPONGENT_CONCAT(SPONGENT_LANES_NAME,_vec_t)
+#define SPONGENT_SBOX SPONGENT_CONCAT(SPONGENT_LANES_NAME,_sbox)
+
+/* Vector type with one 32-bit lane per state */
+typedef uint32_t SPONGENT_VEC_T
+    __attribute__((vector_size(SPONGENT_LANES * 4)));
+
+/* S-box for the vector type */
+spongent_define_sbox(SPONGENT_SBOX, SPONGENT_VEC_T, SPONGENT_LANES_TARGET)
+
+/**
+ * \brief Permutes SPONGENT_LANES Spongent-pi[160] states in parallel.
+ *
+ * \param states Points to the states to be permuted.
+ */
+static SPONGENT_LANES_TARGET void SPONGENT_CONCAT(SPONGENT_LANES_NAME,_160)
+    (spongent160_state_t *states)
+{
+    const uint8_t *rc = spongent160_rc;
+    union {
+        SPONGENT_VEC_T v[5];
+        uint32_t w[5][SPONGENT_LANES];
+    } s;
+    SPONGENT_VEC_T x0, x1, x2, x3, x4;
+    SPONGENT_VEC_T t0, t1, t2, t3, t4;
+    unsigned lane, word;
+    uint8_t round;
+
+    /* Transpose the states into vector lanes */
+    for (lane = 0; lane < SPONGENT_LANES; ++lane) {
+        for (word = 0; word < 5; ++word)
+            s.w[word][lane] = le_load_word32(states[lane].B + word * 4);
+    }
+    x0 = s.v[0];
+    x1 = s.v[1];
+    x2 = s.v[2];
+    x3 = s.v[3];
+    x4 = s.v[4];
+
+    /* Perform the 80 rounds of Spongent-pi[160] */
+    for (round = 0; round < 80; ++round, rc += 2)
+        spongent160_round(SPONGENT_SBOX);
+
+    /* Transpose the vector lanes back into states */
+    s.v[0] = x0;
+    s.v[1] = x1;
+    s.v[2] = x2;
+    s.v[3] = x3;
+    s.v[4] = x4;
+    for (lane = 0; lane < SPONGENT_LANES; ++lane) {
+        for (word = 0; word < 5; ++word)
+            le_store_word32(states[lane].B + word * 4, s.w[word][lane]);
+    }
+}
+
+/**
+ * \brief Permutes SPONGENT_LANES Spongent-pi[176] states in parallel.
+ *
+ * \param states Points to the states to be permuted.
+ */
+static SPONGENT_LANES_TARGET void SPONGENT_CONCAT(SPONGENT_LANES_NAME,_176)
+    (spongent176_state_t *states)
+{
+    const uint8_t *rc = spongent176_rc;
+    union {
+        SPONGENT_VEC_T v[6];
+        uint32_t w[6][SPONGENT_LANES];
+    } s;
+    SPONGENT_VEC_T x0, x1, x2, x3, x4, x5;
+    SPONGENT_VEC_T t0, t1, t2, t3, t4, t5;
+    unsigned lane, word;
+    uint8_t round;
+
+    /* Transpose the states into vector lanes.  The last word only has
+     * 16 bits and the rest of it is always zero */
+    for (lane = 0; lane < SPONGENT_LANES; ++lane) {
+        for (word = 0; word < 5; ++word)
+            s.w[word][lane] = le_load_word32(states[lane].B + word * 4);
+        s.w[5][lane] = le_load_word16(states[lane].B + 20);
+    }
+    x0 = s.v[0];
+    x1 = s.v[1];
+    x2 = s.v[2];
+    x3 = s.v[3];
+    x4 = s.v[4];
+    x5 = s.v[5];
+
+    /* Perform the 90 rounds of Spongent-pi[176] */
+    for (round = 0; round < 90; ++round, rc += 2)
+        spongent176_round(SPONGENT_SBOX);
+
+    /* Transpose the vector lanes back into states */
+    s.v[0] = x0;
+    s.v[1] = x1;
+    s.v[2] = x2;
+    s.v[3] = x3;
+    s.v[4] = x4;
+    s.v[5] = x5;
+    for (lane = 0; lane < SPONGENT_LANES; ++lane) {
+        for (word = 0; word < 5; ++word)
+            le_store_word32(states[lane].B + word * 4, s.w[word][lane]);
+        le_store_word16(states[lane].B + 20, s.w[5][lane]);
+    }
+}
+
+#endif /* SPONGENT_LANES_NAME */
+
+/* Now undefine everything so that we can include this file again for
+ * another kernel width */
+#undef SPONGENT_LANES_NAME
+#undef SPONGENT_LANES
+#undef SPONGENT_LANES_TARGET
+#undef SPONGENT_CONCAT_INNER
+#undef SPONGENT_CONCAT
+#undef SPONGENT_VEC_T
+#undef SPONGENT_SBOX
@@ -37,55 +37,236 @@
  *
  * Note that spongent.ua numbers bits from highest to lowest, so x0 is the
  * high bit of each nibble and x3 is the low bit.
+ *
+ * The S-box is defined by a macro so that the multi-lane kernels can
+ * instantiate it for vector types.
  */
-static uint32_t spongent_sbox(uint32_t x3)
-{
-    uint32_t q0, q1, q2, q3, t0, t1, t2, t3;
-    uint32_t x2 = (x3 >> 1);
-    uint32_t x1 = (x2 >> 1);
-    uint32_t x0 = (x1 >> 1);
-    q0 = x0 ^ x2;
-    q1 = x1 ^ x2;
-    t0 = q0 & q1;
-    q2 = ~(x0 ^ x1 ^ x3 ^ t0);
-    t1 = q2 & ~x0;
-    q3 = x1 ^ t1;
-    t2 = q3 & (q3 ^ x2 ^ x3 ^ t0);
-    t3 = (x2 ^ t0) & ~(x1 ^ t0);
-    q0 = x1 ^ x2 ^ x3 ^ t2;
-    q1 = x0 ^ x2 ^ x3 ^ t0 ^ t1;
-    q2 = x0 ^ x1 ^ x2 ^ t1;
-    q3 = x0 ^ x3 ^ t0 ^ t3;
-    return ((q0 << 3) & 0x88888888U) | ((q1 << 2) & 0x44444444U) |
-           ((q2 << 1) & 0x22222222U) |  (q3       & 0x11111111U);
-}
+#define spongent_define_sbox(name, type, attrs) \
+    static attrs type name(type x3) \
+    { \
+        type q0, q1, q2, q3, t0, t1, t2, t3; \
+        type x2 = (x3 >> 1); \
+        type x1 = (x2 >> 1); \
+        type x0 = (x1 >> 1); \
+        q0 = x0 ^ x2; \
+        q1 = x1 ^ x2; \
+        t0 = q0 & q1; \
+        q2 = ~(x0 ^ x1 ^ x3 ^ t0); \
+        t1 = q2 & ~x0; \
+        q3 = x1 ^ t1; \
+        t2 = q3 & (q3 ^ x2 ^ x3 ^ t0); \
+        t3 = (x2 ^ t0) & ~(x1 ^ t0); \
+        q0 = x1 ^ x2 ^ x3 ^ t2; \
+        q1 = x0 ^ x2 ^ x3 ^ t0 ^ t1; \
+        q2 = x0 ^ x1 ^ x2 ^ t1; \
+        q3 = x0 ^ x3 ^ t0 ^ t3; \
+        return ((q0 << 3) & 0x88888888U) | ((q1 << 2) & 0x44444444U) | \
+               ((q2 << 1) & 0x22222222U) |  (q3       & 0x11111111U); \
+    }
+spongent_define_sbox(spongent_sbox, uint32_t, )
+
+/* Bit permutation helpers.  BCP = bit copy, BUP = move bit up,
+ * BDN = move bit down */
+#define BCP(x, bit) ((x) & (((uint32_t)1) << (bit)))
+#define BUP(x, from, to) \
+    (((x) << ((to) - (from))) & (((uint32_t)1) << (to)))
+#define BDN(x, from, to) \
+    (((x) >> ((from) - (to))) & (((uint32_t)1) << (to)))
+
+/**
+ * \brief Performs a single round of Spongent-pi[160].
+ *
+ * \param sbox Name of the function that applies the S-box to a word.
+ *
+ * The variables x0..x4, t0..t4, and "rc" must be in scope.  The state
+ * words may be scalars or vectors.
+ */
+#define spongent160_round(sbox) \
+    do { \
+        /* Add the round constant to front and back of the state */ \
+        x0 ^= (uint32_t)(rc[0]); \
+        x4 ^= ((uint32_t)(rc[1])) << 24; \
+        \
+        /* Apply the S-box to all 4-bit groups in the state */ \
+        t0 = sbox(x0); \
+        t1 = sbox(x1); \
+        t2 = sbox(x2); \
+        t3 = sbox(x3); \
+        t4 = sbox(x4); \
+        \
+        /* Permute the bits of the state.  Bit i is moved to (40 * i) % 159 \
+         * for all bits except the last which is left where it is */ \
+        x0 = BCP(t0,  0)     ^ BDN(t0,  4,  1) ^ BDN(t0,  8,  2) ^ \
+             BDN(t0, 12,  3) ^ BDN(t0, 16,  4) ^ BDN(t0, 20,  5) ^ \
+             BDN(t0, 24,  6) ^ BDN(t0, 28,  7) ^ BUP(t1,  0,  8) ^ \
+             BUP(t1,  4,  9) ^ BUP(t1,  8, 10) ^ BDN(t1, 12, 11) ^ \
+             BDN(t1, 16, 12) ^ BDN(t1, 20, 13) ^ BDN(t1, 24, 14) ^ \
+             BDN(t1, 28, 15) ^ BUP(t2,  0, 16) ^ BUP(t2,  4, 17) ^ \
+             BUP(t2,  8, 18) ^ BUP(t2, 12, 19) ^ BUP(t2, 16, 20) ^ \
+             BUP(t2, 20, 21) ^ BDN(t2, 24, 22) ^ BDN(t2, 28, 23) ^ \
+             BUP(t3,  0, 24) ^ BUP(t3,  4, 25) ^ BUP(t3,  8, 26) ^ \
+             BUP(t3, 12, 27) ^ BUP(t3, 16, 28) ^ BUP(t3, 20, 29) ^ \
+             BUP(t3, 24, 30) ^ BUP(t3, 28, 31); \
+        x1 = BUP(t0,  1,  8) ^ BUP(t0,  5,  9) ^ BUP(t0,  9, 10) ^ \
+             BDN(t0, 13, 11) ^ BDN(t0, 17, 12) ^ BDN(t0, 21, 13) ^ \
+             BDN(t0, 25, 14) ^ BDN(t0, 29, 15) ^ BUP(t1,  1, 16) ^ \
+             BUP(t1,  5, 17) ^ BUP(t1,  9, 18) ^ BUP(t1, 13, 19) ^ \
+             BUP(t1, 17, 20) ^ BCP(t1, 21)     ^ BDN(t1, 25, 22) ^ \
+             BDN(t1, 29, 23) ^ BUP(t2,  1, 24) ^ BUP(t2,  5, 25) ^ \
+             BUP(t2,  9, 26) ^ BUP(t2, 13, 27) ^ BUP(t2, 17, 28) ^ \
+             BUP(t2, 21, 29) ^ BUP(t2, 25, 30) ^ BUP(t2, 29, 31) ^ \
+             BCP(t4,  0)     ^ BDN(t4,  4,  1) ^ BDN(t4,  8,  2) ^ \
+             BDN(t4, 12,  3) ^ BDN(t4, 16,  4) ^ BDN(t4, 20,  5) ^ \
+             BDN(t4, 24,  6) ^ BDN(t4, 28,  7); \
+        x2 = BUP(t0,  2, 16) ^ BUP(t0,  6, 17) ^ BUP(t0, 10, 18) ^ \
+             BUP(t0, 14, 19) ^ BUP(t0, 18, 20) ^ BDN(t0, 22, 21) ^ \
+             BDN(t0, 26, 22) ^ BDN(t0, 30, 23) ^ BUP(t1,  2, 24) ^ \
+             BUP(t1,  6, 25) ^ BUP(t1, 10, 26) ^ BUP(t1, 14, 27) ^ \
+             BUP(t1, 18, 28) ^ BUP(t1, 22, 29) ^ BUP(t1, 26, 30) ^ \
+             BUP(t1, 30, 31) ^ BDN(t3,  1,  0) ^ BDN(t3,  5,  1) ^ \
+             BDN(t3,  9,  2) ^ BDN(t3, 13,  3) ^ BDN(t3, 17,  4) ^ \
+             BDN(t3, 21,  5) ^ BDN(t3, 25,  6) ^ BDN(t3, 29,  7) ^ \
+             BUP(t4,  1,  8) ^ BUP(t4,  5,  9) ^ BUP(t4,  9, 10) ^ \
+             BDN(t4, 13, 11) ^ BDN(t4, 17, 12) ^ BDN(t4, 21, 13) ^ \
+             BDN(t4, 25, 14) ^ BDN(t4, 29, 15); \
+        x3 = BUP(t0,  3, 24) ^ BUP(t0,  7, 25) ^ BUP(t0, 11, 26) ^ \
+             BUP(t0, 15, 27) ^ BUP(t0, 19, 28) ^ BUP(t0, 23, 29) ^ \
+             BUP(t0, 27, 30) ^ BCP(t0, 31)     ^ BDN(t2,  2,  0) ^ \
+             BDN(t2,  6,  1) ^ BDN(t2, 10,  2) ^ BDN(t2, 14,  3) ^ \
+             BDN(t2, 18,  4) ^ BDN(t2, 22,  5) ^ BDN(t2, 26,  6) ^ \
+             BDN(t2, 30,  7) ^ BUP(t3,  2,  8) ^ BUP(t3,  6,  9) ^ \
+             BCP(t3, 10)     ^ BDN(t3, 14, 11) ^ BDN(t3, 18, 12) ^ \
+             BDN(t3, 22, 13) ^ BDN(t3, 26, 14) ^ BDN(t3, 30, 15) ^ \
+             BUP(t4,  2, 16) ^ BUP(t4,  6, 17) ^ BUP(t4, 10, 18) ^ \
+             BUP(t4, 14, 19) ^ BUP(t4, 18, 20) ^ BDN(t4, 22, 21) ^ \
+             BDN(t4, 26, 22) ^ BDN(t4, 30, 23); \
+        x4 = BDN(t1,  3,  0) ^ BDN(t1,  7,  1) ^ BDN(t1, 11,  2) ^ \
+             BDN(t1, 15,  3) ^ BDN(t1, 19,  4) ^ BDN(t1, 23,  5) ^ \
+             BDN(t1, 27,  6) ^ BDN(t1, 31,  7) ^ BUP(t2,  3,  8) ^ \
+             BUP(t2,  7,  9) ^ BDN(t2, 11, 10) ^ BDN(t2, 15, 11) ^ \
+             BDN(t2, 19, 12) ^ BDN(t2, 23, 13) ^ BDN(t2, 27, 14) ^ \
+             BDN(t2, 31, 15) ^ BUP(t3,  3, 16) ^ BUP(t3,  7, 17) ^ \
+             BUP(t3, 11, 18) ^ BUP(t3, 15, 19) ^ BUP(t3, 19, 20) ^ \
+             BDN(t3, 23, 21) ^ BDN(t3, 27, 22) ^ BDN(t3, 31, 23) ^ \
+             BUP(t4,  3, 24) ^ BUP(t4,  7, 25) ^ BUP(t4, 11, 26) ^ \
+             BUP(t4, 15, 27) ^ BUP(t4, 19, 28) ^ BUP(t4, 23, 29) ^ \
+             BUP(t4, 27, 30) ^ BCP(t4, 31); \
+    } while (0)
+
+/**
+ * \brief Performs a single round of Spongent-pi[176].
+ *
+ * \param sbox Name of the function that applies the S-box to a word.
+ *
+ * The variables x0..x5, t0..t5, and "rc" must be in scope.  The state
+ * words may be scalars or vectors.
+ */
+#define spongent176_round(sbox) \
+    do { \
+        /* Add the round constant to front and back of the state */ \
+        x0 ^= (uint32_t)(rc[0]); \
+        x5 ^= ((uint32_t)(rc[1])) << 8; \
+        \
+        /* Apply the S-box to all 4-bit groups in the state */ \
+        t0 = sbox(x0); \
+        t1 = sbox(x1); \
+        t2 = sbox(x2); \
+        t3 = sbox(x3); \
+        t4 = sbox(x4); \
+        t5 = sbox(x5); \
+        \
+        /* Permute the bits of the state.  Bit i is moved to (44 * i) % 175 \
+         * for all bits except the last which is left where it is */ \
+        x0 = BCP(t0,  0)     ^ BDN(t0,  4,  1) ^ BDN(t0,  8,  2) ^ \
+             BDN(t0, 12,  3) ^ BDN(t0, 16,  4) ^ BDN(t0, 20,  5) ^ \
+             BDN(t0, 24,  6) ^ BDN(t0, 28,  7) ^ BUP(t1,  0,  8) ^ \
+             BUP(t1,  4,  9) ^ BUP(t1,  8, 10) ^ BDN(t1, 12, 11) ^ \
+             BDN(t1, 16, 12) ^ BDN(t1, 20, 13) ^ BDN(t1, 24, 14) ^ \
+             BDN(t1, 28, 15) ^ BUP(t2,  0, 16) ^ BUP(t2,  4, 17) ^ \
+             BUP(t2,  8, 18) ^ BUP(t2, 12, 19) ^ BUP(t2, 16, 20) ^ \
+             BUP(t2, 20, 21) ^ BDN(t2, 24, 22) ^ BDN(t2, 28, 23) ^ \
+             BUP(t3,  0, 24) ^ BUP(t3,  4, 25) ^ BUP(t3,  8, 26) ^ \
+             BUP(t3, 12, 27) ^ BUP(t3, 16, 28) ^ BUP(t3, 20, 29) ^ \
+             BUP(t3, 24, 30) ^ BUP(t3, 28, 31); \
+        x1 = BUP(t0,  1, 12) ^ BUP(t0,  5, 13) ^ BUP(t0,  9, 14) ^ \
+             BUP(t0, 13, 15) ^ BDN(t0, 17, 16) ^ BDN(t0, 21, 17) ^ \
+             BDN(t0, 25, 18) ^ BDN(t0, 29, 19) ^ BUP(t1,  1, 20) ^ \
+             BUP(t1,  5, 21) ^ BUP(t1,  9, 22) ^ BUP(t1, 13, 23) ^ \
+             BUP(t1, 17, 24) ^ BUP(t1, 21, 25) ^ BUP(t1, 25, 26) ^ \
+             BDN(t1, 29, 27) ^ BUP(t2,  1, 28) ^ BUP(t2,  5, 29) ^ \
+             BUP(t2,  9, 30) ^ BUP(t2, 13, 31) ^ BCP(t4,  0)     ^ \
+             BDN(t4,  4,  1) ^ BDN(t4,  8,  2) ^ BDN(t4, 12,  3) ^ \
+             BDN(t4, 16,  4) ^ BDN(t4, 20,  5) ^ BDN(t4, 24,  6) ^ \
+             BDN(t4, 28,  7) ^ BUP(t5,  0,  8) ^ BUP(t5,  4,  9) ^ \
+             BUP(t5,  8, 10) ^ BDN(t5, 12, 11); \
+        x2 = BUP(t0,  2, 24) ^ BUP(t0,  6, 25) ^ BUP(t0, 10, 26) ^ \
+             BUP(t0, 14, 27) ^ BUP(t0, 18, 28) ^ BUP(t0, 22, 29) ^ \
+             BUP(t0, 26, 30) ^ BUP(t0, 30, 31) ^ BDN(t2, 17,  0) ^ \
+             BDN(t2, 21,  1) ^ BDN(t2, 25,  2) ^ BDN(t2, 29,  3) ^ \
+             BUP(t3,  1,  4) ^ BCP(t3,  5)     ^ BDN(t3,  9,  6) ^ \
+             BDN(t3, 13,  7) ^ BDN(t3, 17,  8) ^ BDN(t3, 21,  9) ^ \
+             BDN(t3, 25, 10) ^ BDN(t3, 29, 11) ^ BUP(t4,  1, 12) ^ \
+             BUP(t4,  5, 13) ^ BUP(t4,  9, 14) ^ BUP(t4, 13, 15) ^ \
+             BDN(t4, 17, 16) ^ BDN(t4, 21, 17) ^ BDN(t4, 25, 18) ^ \
+             BDN(t4, 29, 19) ^ BUP(t5,  1, 20) ^ BUP(t5,  5, 21) ^ \
+             BUP(t5,  9, 22) ^ BUP(t5, 13, 23); \
+        x3 = BDN(t1,  2,  0) ^ BDN(t1,  6,  1) ^ BDN(t1, 10,  2) ^ \
+             BDN(t1, 14,  3) ^ BDN(t1, 18,  4) ^ BDN(t1, 22,  5) ^ \
+             BDN(t1, 26,  6) ^ BDN(t1, 30,  7) ^ BUP(t2,  2,  8) ^ \
+             BUP(t2,  6,  9) ^ BCP(t2, 10)     ^ BDN(t2, 14, 11) ^ \
+             BDN(t2, 18, 12) ^ BDN(t2, 22, 13) ^ BDN(t2, 26, 14) ^ \
+             BDN(t2, 30, 15) ^ BUP(t3,  2, 16) ^ BUP(t3,  6, 17) ^ \
+             BUP(t3, 10, 18) ^ BUP(t3, 14, 19) ^ BUP(t3, 18, 20) ^ \
+             BDN(t3, 22, 21) ^ BDN(t3, 26, 22) ^ BDN(t3, 30, 23) ^ \
+             BUP(t4,  2, 24) ^ BUP(t4,  6, 25) ^ BUP(t4, 10, 26) ^ \
+             BUP(t4, 14, 27) ^ BUP(t4, 18, 28) ^ BUP(t4, 22, 29) ^ \
+             BUP(t4, 26, 30) ^ BUP(t4, 30, 31); \
+        x4 = BUP(t0,  3,  4) ^ BDN(t0,  7,  5) ^ BDN(t0, 11,  6) ^ \
+             BDN(t0, 15,  7) ^ BDN(t0, 19,  8) ^ BDN(t0, 23,  9) ^ \
+             BDN(t0, 27, 10) ^ BDN(t0, 31, 11) ^ BUP(t1,  3, 12) ^ \
+             BUP(t1,  7, 13) ^ BUP(t1, 11, 14) ^ BCP(t1, 15)     ^ \
+             BDN(t1, 19, 16) ^ BDN(t1, 23, 17) ^ BDN(t1, 27, 18) ^ \
+             BDN(t1, 31, 19) ^ BUP(t2,  3, 20) ^ BUP(t2,  7, 21) ^ \
+             BUP(t2, 11, 22) ^ BUP(t2, 15, 23) ^ BUP(t2, 19, 24) ^ \
+             BUP(t2, 23, 25) ^ BDN(t2, 27, 26) ^ BDN(t2, 31, 27) ^ \
+             BUP(t3,  3, 28) ^ BUP(t3,  7, 29) ^ BUP(t3, 11, 30) ^ \
+             BUP(t3, 15, 31) ^ BDN(t5,  2,  0) ^ BDN(t5,  6,  1) ^ \
+             BDN(t5, 10,  2) ^ BDN(t5, 14,  3); \
+        x5 = BDN(t3, 19,  0) ^ BDN(t3, 23,  1) ^ BDN(t3, 27,  2) ^ \
+             BDN(t3, 31,  3) ^ BUP(t4,  3,  4) ^ BDN(t4,  7,  5) ^ \
+             BDN(t4, 11,  6) ^ BDN(t4, 15,  7) ^ BDN(t4, 19,  8) ^ \
+             BDN(t4, 23,  9) ^ BDN(t4, 27, 10) ^ BDN(t4, 31, 11) ^ \
+             BUP(t5,  3, 12) ^ BUP(t5,  7, 13) ^ BUP(t5, 11, 14) ^ \
+             BCP(t5, 15); \
+    } while (0)
+
+/* Round constants for Spongent-pi[160] */
+static uint8_t const spongent160_rc[] = {
+    0x75, 0xae, 0x6a, 0x56, 0x54, 0x2a, 0x29, 0x94,
+    0x53, 0xca, 0x27, 0xe4, 0x4f, 0xf2, 0x1f, 0xf8,
+    0x3e, 0x7c, 0x7d, 0xbe, 0x7a, 0x5e, 0x74, 0x2e,
+    0x68, 0x16, 0x50, 0x0a, 0x21, 0x84, 0x43, 0xc2,
+    0x07, 0xe0, 0x0e, 0x70, 0x1c, 0x38, 0x38, 0x1c,
+    0x71, 0x8e, 0x62, 0x46, 0x44, 0x22, 0x09, 0x90,
+    0x12, 0x48, 0x24, 0x24, 0x49, 0x92, 0x13, 0xc8,
+    0x26, 0x64, 0x4d, 0xb2, 0x1b, 0xd8, 0x36, 0x6c,
+    0x6d, 0xb6, 0x5a, 0x5a, 0x35, 0xac, 0x6b, 0xd6,
+    0x56, 0x6a, 0x2d, 0xb4, 0x5b, 0xda, 0x37, 0xec,
+    0x6f, 0xf6, 0x5e, 0x7a, 0x3d, 0xbc, 0x7b, 0xde,
+    0x76, 0x6e, 0x6c, 0x36, 0x58, 0x1a, 0x31, 0x8c,
+    0x63, 0xc6, 0x46, 0x62, 0x0d, 0xb0, 0x1a, 0x58,
+    0x34, 0x2c, 0x69, 0x96, 0x52, 0x4a, 0x25, 0xa4,
+    0x4b, 0xd2, 0x17, 0xe8, 0x2e, 0x74, 0x5d, 0xba,
+    0x3b, 0xdc, 0x77, 0xee, 0x6e, 0x76, 0x5c, 0x3a,
+    0x39, 0x9c, 0x73, 0xce, 0x66, 0x66, 0x4c, 0x32,
+    0x19, 0x98, 0x32, 0x4c, 0x65, 0xa6, 0x4a, 0x52,
+    0x15, 0xa8, 0x2a, 0x54, 0x55, 0xaa, 0x2b, 0xd4,
+    0x57, 0xea, 0x2f, 0xf4, 0x5f, 0xfa, 0x3f, 0xfc
+};
 
 void spongent160_permute(spongent160_state_t *state)
 {
-    static uint8_t const RC[] = {
-        /* Round constants for Spongent-pi[160] */
-        0x75, 0xae, 0x6a, 0x56, 0x54, 0x2a, 0x29, 0x94,
-        0x53, 0xca, 0x27, 0xe4, 0x4f, 0xf2, 0x1f, 0xf8,
-        0x3e, 0x7c, 0x7d, 0xbe, 0x7a, 0x5e, 0x74, 0x2e,
-        0x68, 0x16, 0x50, 0x0a, 0x21, 0x84, 0x43, 0xc2,
-        0x07, 0xe0, 0x0e, 0x70, 0x1c, 0x38, 0x38, 0x1c,
-        0x71, 0x8e, 0x62, 0x46, 0x44, 0x22, 0x09, 0x90,
-        0x12, 0x48, 0x24, 0x24, 0x49, 0x92, 0x13, 0xc8,
-        0x26, 0x64, 0x4d, 0xb2, 0x1b, 0xd8, 0x36, 0x6c,
-        0x6d, 0xb6, 0x5a, 0x5a, 0x35, 0xac, 0x6b, 0xd6,
-        0x56, 0x6a, 0x2d, 0xb4, 0x5b, 0xda, 0x37, 0xec,
-        0x6f, 0xf6, 0x5e, 0x7a, 0x3d, 0xbc, 0x7b, 0xde,
-        0x76, 0x6e, 0x6c, 0x36, 0x58, 0x1a, 0x31, 0x8c,
-        0x63, 0xc6, 0x46, 0x62, 0x0d, 0xb0, 0x1a, 0x58,
-        0x34, 0x2c, 0x69, 0x96, 0x52, 0x4a, 0x25, 0xa4,
-        0x4b, 0xd2, 0x17, 0xe8, 0x2e, 0x74, 0x5d, 0xba,
-        0x3b, 0xdc, 0x77, 0xee, 0x6e, 0x76, 0x5c, 0x3a,
-        0x39, 0x9c, 0x73, 0xce, 0x66, 0x66, 0x4c, 0x32,
-        0x19, 0x98, 0x32, 0x4c, 0x65, 0xa6, 0x4a, 0x52,
-        0x15, 0xa8, 0x2a, 0x54, 0x55, 0xaa, 0x2b, 0xd4,
-        0x57, 0xea, 0x2f, 0xf4, 0x5f, 0xfa, 0x3f, 0xfc
-    };
-    const uint8_t *rc = RC;
+    const uint8_t *rc = spongent160_rc;
     uint32_t x0, x1, x2, x3, x4;
     uint32_t t0, t1, t2, t3, t4;
     uint8_t round;
@@ -107,80 +288,7 @@ void spongent160_permute(spongent160_state_t *state)
 
     /* Perform the 80 rounds of Spongent-pi[160] */
     for (round = 0; round < 80; ++round, rc += 2) {
-        /* Add the round constant to front and back of the state */
-        x0 ^= rc[0];
-        x4 ^= ((uint32_t)(rc[1])) << 24;
-
-        /* Apply the S-box to all 4-bit groups in the state */
-        t0 = spongent_sbox(x0);
-        t1 = spongent_sbox(x1);
-        t2 = spongent_sbox(x2);
-        t3 = spongent_sbox(x3);
-        t4 = spongent_sbox(x4);
-
-        /* Permute the bits of the state.  Bit i is moved to (40 * i) % 159
-         * for all bits except the last which is left where it is.
-         * BCP = bit copy, BUP = move bit up, BDN = move bit down */
-        #define BCP(x, bit) ((x) & (((uint32_t)1) << (bit)))
-        #define BUP(x, from, to) \
-            (((x) << ((to) - (from))) & (((uint32_t)1) << (to)))
-        #define BDN(x, from, to) \
-            (((x) >> ((from) - (to))) & (((uint32_t)1) << (to)))
-        x0 = BCP(t0,  0)     ^ BDN(t0,  4,  1) ^ BDN(t0,  8,  2) ^
-             BDN(t0, 12,  3) ^ BDN(t0, 16,  4) ^ BDN(t0, 20,  5) ^
-             BDN(t0, 24,  6) ^ BDN(t0, 28,  7) ^ BUP(t1,  0,  8) ^
-             BUP(t1,  4,  9) ^ BUP(t1,  8, 10) ^ BDN(t1, 12, 11) ^
-             BDN(t1, 16, 12) ^ BDN(t1, 20, 13) ^ BDN(t1, 24, 14) ^
-             BDN(t1, 28, 15) ^ BUP(t2,  0, 16) ^ BUP(t2,  4, 17) ^
-             BUP(t2,  8, 18) ^ BUP(t2, 12, 19) ^ BUP(t2, 16, 20) ^
-             BUP(t2, 20, 21) ^ BDN(t2, 24, 22) ^ BDN(t2, 28, 23) ^
-             BUP(t3,  0, 24) ^ BUP(t3,  4, 25) ^ BUP(t3,  8, 26) ^
-             BUP(t3, 12, 27) ^ BUP(t3, 16, 28) ^ BUP(t3, 20, 29) ^
-             BUP(t3, 24, 30) ^ BUP(t3, 28, 31);
-        x1 = BUP(t0,  1,  8) ^ BUP(t0,  5,  9) ^ BUP(t0,  9, 10) ^
-             BDN(t0, 13, 11) ^ BDN(t0, 17, 12) ^ BDN(t0, 21, 13) ^
-             BDN(t0, 25, 14) ^ BDN(t0, 29, 15) ^ BUP(t1,  1, 16) ^
-             BUP(t1,  5, 17) ^ BUP(t1,  9, 18) ^ BUP(t1, 13, 19) ^
-             BUP(t1, 17, 20) ^ BCP(t1, 21)     ^ BDN(t1, 25, 22) ^
-             BDN(t1, 29, 23) ^ BUP(t2,  1, 24) ^ BUP(t2,  5, 25) ^
-             BUP(t2,  9, 26) ^ BUP(t2, 13, 27) ^ BUP(t2, 17, 28) ^
-             BUP(t2, 21, 29) ^ BUP(t2, 25, 30) ^ BUP(t2, 29, 31) ^
-             BCP(t4,  0)     ^ BDN(t4,  4,  1) ^ BDN(t4,  8,  2) ^
-             BDN(t4, 12,  3) ^ BDN(t4, 16,  4) ^ BDN(t4, 20,  5) ^
-             BDN(t4, 24,  6) ^ BDN(t4, 28,  7);
-        x2 = BUP(t0,  2, 16) ^ BUP(t0,  6, 17) ^ BUP(t0, 10, 18) ^
-             BUP(t0, 14, 19) ^ BUP(t0, 18, 20) ^ BDN(t0, 22, 21) ^
-             BDN(t0, 26, 22) ^ BDN(t0, 30, 23) ^ BUP(t1,  2, 24) ^
-             BUP(t1,  6, 25) ^ BUP(t1, 10, 26) ^ BUP(t1, 14, 27) ^
-             BUP(t1, 18, 28) ^ BUP(t1, 22, 29) ^ BUP(t1, 26, 30) ^
-             BUP(t1, 30, 31) ^ BDN(t3,  1,  0) ^ BDN(t3,  5,  1) ^
-             BDN(t3,  9,  2) ^ BDN(t3, 13,  3) ^ BDN(t3, 17,  4) ^
-             BDN(t3, 21,  5) ^ BDN(t3, 25,  6) ^ BDN(t3, 29,  7) ^
-             BUP(t4,  1,  8) ^ BUP(t4,  5,  9) ^ BUP(t4,  9, 10) ^
-             BDN(t4, 13, 11) ^ BDN(t4, 17, 12) ^ BDN(t4, 21, 13) ^
-             BDN(t4, 25, 14) ^ BDN(t4, 29, 15);
-        x3 = BUP(t0,  3, 24) ^ BUP(t0,  7, 25) ^ BUP(t0, 11, 26) ^
-             BUP(t0, 15, 27) ^ BUP(t0, 19, 28) ^ BUP(t0, 23, 29) ^
-             BUP(t0, 27, 30) ^ BCP(t0, 31)     ^ BDN(t2,  2,  0) ^
-             BDN(t2,  6,  1) ^ BDN(t2, 10,  2) ^ BDN(t2, 14,  3) ^
-             BDN(t2, 18,  4) ^ BDN(t2, 22,  5) ^ BDN(t2, 26,  6) ^
-             BDN(t2, 30,  7) ^ BUP(t3,  2,  8) ^ BUP(t3,  6,  9) ^
-             BCP(t3, 10)     ^ BDN(t3, 14, 11) ^ BDN(t3, 18, 12) ^
-             BDN(t3, 22, 13) ^ BDN(t3, 26, 14) ^ BDN(t3, 30, 15) ^
-             BUP(t4,  2, 16) ^ BUP(t4,  6, 17) ^ BUP(t4, 10, 18) ^
-             BUP(t4, 14, 19) ^ BUP(t4, 18, 20) ^ BDN(t4, 22, 21) ^
-             BDN(t4, 26, 22) ^ BDN(t4, 30, 23);
-        x4 = BDN(t1,  3,  0) ^ BDN(t1,  7,  1) ^ BDN(t1, 11,  2) ^
-             BDN(t1, 15,  3) ^ BDN(t1, 19,  4) ^ BDN(t1, 23,  5) ^
-             BDN(t1, 27,  6) ^ BDN(t1, 31,  7) ^ BUP(t2,  3,  8) ^
-             BUP(t2,  7,  9) ^ BDN(t2, 11, 10) ^ BDN(t2, 15, 11) ^
-             BDN(t2, 19, 12) ^ BDN(t2, 23, 13) ^ BDN(t2, 27, 14) ^
-             BDN(t2, 31, 15) ^ BUP(t3,  3, 16) ^ BUP(t3,  7, 17) ^
-             BUP(t3, 11, 18) ^ BUP(t3, 15, 19) ^ BUP(t3, 19, 20) ^
-             BDN(t3, 23, 21) ^ BDN(t3, 27, 22) ^ BDN(t3, 31, 23) ^
-             BUP(t4,  3, 24) ^ BUP(t4,  7, 25) ^ BUP(t4, 11, 26) ^
-             BUP(t4, 15, 27) ^ BUP(t4, 19, 28) ^ BUP(t4, 23, 29) ^
-             BUP(t4, 27, 30) ^ BCP(t4, 31);
+        spongent160_round(spongent_sbox);
     }
 
     /* Store the local variables back to the state in little-endian order */
@@ -199,35 +307,36 @@ void spongent160_permute(spongent160_state_t *state)
 #endif
 }
 
+/* Round constants for Spongent-pi[176] */
+static uint8_t const spongent176_rc[] = {
+    0x45, 0xa2, 0x0b, 0xd0, 0x16, 0x68, 0x2c, 0x34,
+    0x59, 0x9a, 0x33, 0xcc, 0x67, 0xe6, 0x4e, 0x72,
+    0x1d, 0xb8, 0x3a, 0x5c, 0x75, 0xae, 0x6a, 0x56,
+    0x54, 0x2a, 0x29, 0x94, 0x53, 0xca, 0x27, 0xe4,
+    0x4f, 0xf2, 0x1f, 0xf8, 0x3e, 0x7c, 0x7d, 0xbe,
+    0x7a, 0x5e, 0x74, 0x2e, 0x68, 0x16, 0x50, 0x0a,
+    0x21, 0x84, 0x43, 0xc2, 0x07, 0xe0, 0x0e, 0x70,
+    0x1c, 0x38, 0x38, 0x1c, 0x71, 0x8e, 0x62, 0x46,
+    0x44, 0x22, 0x09, 0x90, 0x12, 0x48, 0x24, 0x24,
+    0x49, 0x92, 0x13, 0xc8, 0x26, 0x64, 0x4d, 0xb2,
+    0x1b, 0xd8, 0x36, 0x6c, 0x6d, 0xb6, 0x5a, 0x5a,
+    0x35, 0xac, 0x6b, 0xd6, 0x56, 0x6a, 0x2d, 0xb4,
+    0x5b, 0xda, 0x37, 0xec, 0x6f, 0xf6, 0x5e, 0x7a,
+    0x3d, 0xbc, 0x7b, 0xde, 0x76, 0x6e, 0x6c, 0x36,
+    0x58, 0x1a, 0x31, 0x8c, 0x63, 0xc6, 0x46, 0x62,
+    0x0d, 0xb0, 0x1a, 0x58, 0x34, 0x2c, 0x69, 0x96,
+    0x52, 0x4a, 0x25, 0xa4, 0x4b, 0xd2, 0x17, 0xe8,
+    0x2e, 0x74, 0x5d, 0xba, 0x3b, 0xdc, 0x77, 0xee,
+    0x6e, 0x76, 0x5c, 0x3a, 0x39, 0x9c, 0x73, 0xce,
+    0x66, 0x66, 0x4c, 0x32, 0x19, 0x98, 0x32, 0x4c,
+    0x65, 0xa6, 0x4a, 0x52, 0x15, 0xa8, 0x2a, 0x54,
+    0x55, 0xaa, 0x2b, 0xd4, 0x57, 0xea, 0x2f, 0xf4,
+    0x5f, 0xfa, 0x3f, 0xfc
+};
+
 void spongent176_permute(spongent176_state_t *state)
 {
-    static uint8_t const RC[] = {
-        /* Round constants for Spongent-pi[176] */
-        0x45, 0xa2, 0x0b, 0xd0, 0x16, 0x68, 0x2c, 0x34,
-        0x59, 0x9a, 0x33, 0xcc, 0x67, 0xe6, 0x4e, 0x72,
-        0x1d, 0xb8, 0x3a, 0x5c, 0x75, 0xae, 0x6a, 0x56,
-        0x54, 0x2a, 0x29, 0x94, 0x53, 0xca, 0x27, 0xe4,
-        0x4f, 0xf2, 0x1f, 0xf8, 0x3e, 0x7c, 0x7d, 0xbe,
-        0x7a, 0x5e, 0x74, 0x2e, 0x68, 0x16, 0x50, 0x0a,
-        0x21, 0x84, 0x43, 0xc2, 0x07, 0xe0, 0x0e, 0x70,
-        0x1c, 0x38, 0x38, 0x1c, 0x71, 0x8e, 0x62, 0x46,
-        0x44, 0x22, 0x09, 0x90, 0x12, 0x48, 0x24, 0x24,
-        0x49, 0x92, 0x13, 0xc8, 0x26, 0x64, 0x4d, 0xb2,
-        0x1b, 0xd8, 0x36, 0x6c, 0x6d, 0xb6, 0x5a, 0x5a,
-        0x35, 0xac, 0x6b, 0xd6, 0x56, 0x6a, 0x2d, 0xb4,
-        0x5b, 0xda, 0x37, 0xec, 0x6f, 0xf6, 0x5e, 0x7a,
-        0x3d, 0xbc, 0x7b, 0xde, 0x76, 0x6e, 0x6c, 0x36,
-        0x58, 0x1a, 0x31, 0x8c, 0x63, 0xc6, 0x46, 0x62,
-        0x0d, 0xb0, 0x1a, 0x58, 0x34, 0x2c, 0x69, 0x96,
-        0x52, 0x4a, 0x25, 0xa4, 0x4b, 0xd2, 0x17, 0xe8,
-        0x2e, 0x74, 0x5d, 0xba, 0x3b, 0xdc, 0x77, 0xee,
-        0x6e, 0x76, 0x5c, 0x3a, 0x39, 0x9c, 0x73, 0xce,
-        0x66, 0x66, 0x4c, 0x32, 0x19, 0x98, 0x32, 0x4c,
-        0x65, 0xa6, 0x4a, 0x52, 0x15, 0xa8, 0x2a, 0x54,
-        0x55, 0xaa, 0x2b, 0xd4, 0x57, 0xea, 0x2f, 0xf4,
-        0x5f, 0xfa, 0x3f, 0xfc
-    };
-    const uint8_t *rc = RC;
+    const uint8_t *rc = spongent176_rc;
     uint32_t x0, x1, x2, x3, x4, x5;
     uint32_t t0, t1, t2, t3, t4, t5;
     uint8_t round;
@@ -251,82 +360,7 @@ void spongent176_permute(spongent176_state_t *state)
 
     /* Perform the 90 rounds of Spongent-pi[176] */
     for (round = 0; round < 90; ++round, rc += 2) {
-        /* Add the round constant to front and back of the state */
-        x0 ^= rc[0];
-        x5 ^= ((uint32_t)(rc[1])) << 8;
-
-        /* Apply the S-box to all 4-bit groups in the state */
-        t0 = spongent_sbox(x0);
-        t1 = spongent_sbox(x1);
-        t2 = spongent_sbox(x2);
-        t3 = spongent_sbox(x3);
-        t4 = spongent_sbox(x4);
-        t5 = spongent_sbox(x5);
-
-        /* Permute the bits of the state.  Bit i is moved to (44 * i) % 175
-         * for all bits except the last which is left where it is.
-         * BCP = bit copy, BUP = move bit up, BDN = move bit down */
-        x0 = BCP(t0,  0)     ^ BDN(t0,  4,  1) ^ BDN(t0,  8,  2) ^
-             BDN(t0, 12,  3) ^ BDN(t0, 16,  4) ^ BDN(t0, 20,  5) ^
-             BDN(t0, 24,  6) ^ BDN(t0, 28,  7) ^ BUP(t1,  0,  8) ^
-             BUP(t1,  4,  9) ^ BUP(t1,  8, 10) ^ BDN(t1, 12, 11) ^
-             BDN(t1, 16, 12) ^ BDN(t1, 20, 13) ^ BDN(t1, 24, 14) ^
-             BDN(t1, 28, 15) ^ BUP(t2,  0, 16) ^ BUP(t2,  4, 17) ^
-             BUP(t2,  8, 18) ^ BUP(t2, 12, 19) ^ BUP(t2, 16, 20) ^
-             BUP(t2, 20, 21) ^ BDN(t2, 24, 22) ^ BDN(t2, 28, 23) ^
-             BUP(t3,  0, 24) ^ BUP(t3,  4, 25) ^ BUP(t3,  8, 26) ^
-             BUP(t3, 12, 27) ^ BUP(t3, 16, 28) ^ BUP(t3, 20, 29) ^
-             BUP(t3, 24, 30) ^ BUP(t3, 28, 31);
-        x1 = BUP(t0,  1, 12) ^ BUP(t0,  5, 13) ^ BUP(t0,  9, 14) ^
-             BUP(t0, 13, 15) ^ BDN(t0, 17, 16) ^ BDN(t0, 21, 17) ^
-             BDN(t0, 25, 18) ^ BDN(t0, 29, 19) ^ BUP(t1,  1, 20) ^
-             BUP(t1,  5, 21) ^ BUP(t1,  9, 22) ^ BUP(t1, 13, 23) ^
-             BUP(t1, 17, 24) ^ BUP(t1, 21, 25) ^ BUP(t1, 25, 26) ^
-             BDN(t1, 29, 27) ^ BUP(t2,  1, 28) ^ BUP(t2,  5, 29) ^
-             BUP(t2,  9, 30) ^ BUP(t2, 13, 31) ^ BCP(t4,  0)     ^
-             BDN(t4,  4,  1) ^ BDN(t4,  8,  2) ^ BDN(t4, 12,  3) ^
-             BDN(t4, 16,  4) ^ BDN(t4, 20,  5) ^ BDN(t4, 24,  6) ^
-             BDN(t4, 28,  7) ^ BUP(t5,  0,  8) ^ BUP(t5,  4,  9) ^
-             BUP(t5,  8, 10) ^ BDN(t5, 12, 11);
-        x2 = BUP(t0,  2, 24) ^ BUP(t0,  6, 25) ^ BUP(t0, 10, 26) ^
-             BUP(t0, 14, 27) ^ BUP(t0, 18, 28) ^ BUP(t0, 22, 29) ^
-             BUP(t0, 26, 30) ^ BUP(t0, 30, 31) ^ BDN(t2, 17,  0) ^
-             BDN(t2, 21,  1) ^ BDN(t2, 25,  2) ^ BDN(t2, 29,  3) ^
-             BUP(t3,  1,  4) ^ BCP(t3,  5)     ^ BDN(t3,  9,  6) ^
-             BDN(t3, 13,  7) ^ BDN(t3, 17,  8) ^ BDN(t3, 21,  9) ^
-             BDN(t3, 25, 10) ^ BDN(t3, 29, 11) ^ BUP(t4,  1, 12) ^
-             BUP(t4,  5, 13) ^ BUP(t4,  9, 14) ^ BUP(t4, 13, 15) ^
-             BDN(t4, 17, 16) ^ BDN(t4, 21, 17) ^ BDN(t4, 25, 18) ^
-             BDN(t4, 29, 19) ^ BUP(t5,  1, 20) ^ BUP(t5,  5, 21) ^
-             BUP(t5,  9, 22) ^ BUP(t5, 13, 23);
-        x3 = BDN(t1,  2,  0) ^ BDN(t1,  6,  1) ^ BDN(t1, 10,  2) ^
-             BDN(t1, 14,  3) ^ BDN(t1, 18,  4) ^ BDN(t1, 22,  5) ^
-             BDN(t1, 26,  6) ^ BDN(t1, 30,  7) ^ BUP(t2,  2,  8) ^
-             BUP(t2,  6,  9) ^ BCP(t2, 10)     ^ BDN(t2, 14, 11) ^
-             BDN(t2, 18, 12) ^ BDN(t2, 22, 13) ^ BDN(t2, 26, 14) ^
-             BDN(t2, 30, 15) ^ BUP(t3,  2, 16) ^ BUP(t3,  6, 17) ^
-             BUP(t3, 10, 18) ^ BUP(t3, 14, 19) ^ BUP(t3, 18, 20) ^
-             BDN(t3, 22, 21) ^ BDN(t3, 26, 22) ^ BDN(t3, 30, 23) ^
-             BUP(t4,  2, 24) ^ BUP(t4,  6, 25) ^ BUP(t4, 10, 26) ^
-             BUP(t4, 14, 27) ^ BUP(t4, 18, 28) ^ BUP(t4, 22, 29) ^
-             BUP(t4, 26, 30) ^ BUP(t4, 30, 31);
-        x4 = BUP(t0,  3,  4) ^ BDN(t0,  7,  5) ^ BDN(t0, 11,  6) ^
-             BDN(t0, 15,  7) ^ BDN(t0, 19,  8) ^ BDN(t0, 23,  9) ^
-             BDN(t0, 27, 10) ^ BDN(t0, 31, 11) ^ BUP(t1,  3, 12) ^
-             BUP(t1,  7, 13) ^ BUP(t1, 11, 14) ^ BCP(t1, 15)     ^
-             BDN(t1, 19, 16) ^ BDN(t1, 23, 17) ^ BDN(t1, 27, 18) ^
-             BDN(t1, 31, 19) ^ BUP(t2,  3, 20) ^ BUP(t2,  7, 21) ^
-             BUP(t2, 11, 22) ^ BUP(t2, 15, 23) ^ BUP(t2, 19, 24) ^
-             BUP(t2, 23, 25) ^ BDN(t2, 27, 26) ^ BDN(t2, 31, 27) ^
-             BUP(t3,  3, 28) ^ BUP(t3,  7, 29) ^ BUP(t3, 11, 30) ^
-             BUP(t3, 15, 31) ^ BDN(t5,  2,  0) ^ BDN(t5,  6,  1) ^
-             BDN(t5, 10,  2) ^ BDN(t5, 14,  3);
-        x5 = BDN(t3, 19,  0) ^ BDN(t3, 23,  1) ^ BDN(t3, 27,  2) ^
-             BDN(t3, 31,  3) ^ BUP(t4,  3,  4) ^ BDN(t4,  7,  5) ^
-             BDN(t4, 11,  6) ^ BDN(t4, 15,  7) ^ BDN(t4, 19,  8) ^
-             BDN(t4, 23,  9) ^ BDN(t4, 27, 10) ^ BDN(t4, 31, 11) ^
-             BUP(t5,  3, 12) ^ BUP(t5,  7, 13) ^ BUP(t5, 11, 14) ^
-             BCP(t5, 15);
+        spongent176_round(spongent_sbox);
     }
 
     /* Store the local variables back to the state in little-endian order */
@@ -347,4 +381,129 @@ void spongent176_permute(spongent176_state_t *state)
 #endif
 }
 
+#if SPONGENT_VECTOR
+
+/* 128-bit kernels for the baseline vector unit; SSE2 or NEON */
+#if defined(__SSE2__) || defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SPONGENT_HAVE_X4 1
+#define SPONGENT_LANES_NAME spongent_permute_x4
+#define SPONGENT_LANES 4
+#define SPONGENT_LANES_TARGET
+#include "internal-spongent-lanes.h"
+#else
+#define SPONGENT_HAVE_X4 0
+#endif
+
+/* 256-bit kernels for AVX2 */
+#if defined(__AVX2__) || SPONGENT_SIMD_DISPATCH
+#define SPONGENT_HAVE_X8 1
+#define SPONGENT_LANES_NAME spongent_permute_x8
+#define SPONGENT_LANES 8
+#define SPONGENT_LANES_TARGET LW_TARGET_AVX2
+#include "internal-spongent-lanes.h"
+#else
+#define SPONGENT_HAVE_X8 0
+#endif
+
+/* 512-bit kernels for AVX-512 */
+#if defined(__AVX512F__) || SPONGENT_SIMD_DISPATCH
+#define SPONGENT_HAVE_X16 1
+#define SPONGENT_LANES_NAME spongent_permute_x16
+#define SPONGENT_LANES 16
+#define SPONGENT_LANES_TARGET LW_TARGET_AVX512
+#include "internal-spongent-lanes.h"
+#else
+#define SPONGENT_HAVE_X16 0
+#endif
+
+#endif /* SPONGENT_VECTOR */
+
 #endif /* !__AVR__ */
+
+/**
+ * \brief Permutes an array of states with the widest kernels available.
+ *
+ * \param states Points to the array of states.
+ * \param count Number of states in the array.
+ * \param name Name of the state size; 160 or 176.
+ *
+ * Expands to the body of spongent160_permute_n() or spongent176_permute_n().
+ */
+#define spongent_permute_lanes(states, count, name) \
+    do { \
+        spongent_permute_lanes_simd(states, count, name); \
+        spongent_permute_lanes_x4(states, count, name); \
+        while ((count) > 0) { \
+            spongent##name##_permute(states); \
+            ++(states); \
+            --(count); \
+        } \
+    } while (0)
+
+/* Permutes groups of lanes with a specific kernel */
+#define spongent_permute_group(states, count, name, width) \
+    do { \
+        while ((count) >= (width)) { \
+            spongent_permute_x##width##_##name(states); \
+            (states) += (width); \
+            (count) -= (width); \
+        } \
+    } while (0)
+
+#if SPONGENT_SIMD_DISPATCH
+#define spongent_permute_lanes_simd(states, count, name) \
+    do { \
+        int level = lw_simd_level(); \
+        if (level == LW_SIMD_LEVEL_AVX512) \
+            spongent_permute_group(states, count, name, 16); \
+        if (level >= LW_SIMD_LEVEL_AVX2) \
+            spongent_permute_group(states, count, name, 8); \
+    } while (0)
+#elif SPONGENT_VECTOR && SPONGENT_HAVE_X16
+#define spongent_permute_lanes_simd(states, count, name) \
+    do { \
+        spongent_permute_group(states, count, name, 16); \
+        spongent_permute_group(states, count, name, 8); \
+    } while (0)
+#elif SPONGENT_VECTOR && SPONGENT_HAVE_X8
+#define spongent_permute_lanes_simd(states, count, name) \
+    spongent_permute_group(states, count, name, 8)
+#else
+#define spongent_permute_lanes_simd(states, count, name) do { ; } while (0)
+#endif
+#if SPONGENT_VECTOR && SPONGENT_HAVE_X4
+#define spongent_permute_lanes_x4(states, count, name) \
+    spongent_permute_group(states, count, name, 4)
+#else
+#define spongent_permute_lanes_x4(states, count, name) do { ; } while (0)
+#endif
+
+void spongent160_permute_n(spongent160_state_t *states, unsigned count)
+{
+    spongent_permute_lanes(states, count, 160);
+}
+
+void spongent176_permute_n(spongent176_state_t *states, unsigned count)
+{
+    spongent_permute_lanes(states, count, 176);
+}
+
+const char *spongent_multi_lane_variant(void)
+{
+#if defined(__AVX512F__) && SPONGENT_VECTOR
+    return "AVX-512";
+#elif SPONGENT_SIMD_DISPATCH
+    static const char * const names[] = {"C", "AVX2", "AVX-512"};
+#if SPONGENT_HAVE_X4
+    if (lw_simd_level() == LW_SIMD_LEVEL_C)
+        return "Vector";
+#endif
+    return names[lw_simd_level()];
+#elif defined(__AVX2__) && SPONGENT_VECTOR
+    return "AVX2";
+#elif SPONGENT_VECTOR
+    return "Vector";
+#else
+    return "C";
+#endif
+}
@@ -84,6 +84,74 @@ void spongent160_permute(spongent160_state_t *state);
  */
 void spongent176_permute(spongent176_state_t *state);
 
+/**
+ * \brief Defined to 1 if the multi-lane Spongent-pi kernels are selected
+ * at runtime according to the features of the CPU.
+ */
+#if LW_SIMD_DISPATCH && !defined(SPONGENT_NO_SIMD_DISPATCH)
+#define SPONGENT_SIMD_DISPATCH 1
+#else
+#define SPONGENT_SIMD_DISPATCH 0
+#endif
+
+/**
+ * \brief Defined to 1 if the multi-lane Spongent-pi kernels can be built
+ * with the vector extensions of GCC and clang.
+ */
+#if !defined(__AVR__) && (defined(__GNUC__) || defined(__clang__)) && \
+        (defined(__SSE2__) || defined(__ARM_NEON) || defined(__ARM_NEON__) || \
+         SPONGENT_SIMD_DISPATCH)
+#define SPONGENT_VECTOR 1
+#else
+#define SPONGENT_VECTOR 0
+#endif
+
+/**
+ * \brief Number of Spongent-pi states that are permuted in parallel by
+ * the widest multi-lane kernel available on this platform.
+ *
+ * This is 16 when AVX-512 may be available, 8 for AVX2, 4 for other
+ * 128-bit vector units, and 1 when there are no vector kernels.
+ */
+#if defined(__AVX512F__) || SPONGENT_SIMD_DISPATCH
+#define SPONGENT_MAX_LANES 16
+#elif defined(__AVX2__) && SPONGENT_VECTOR
+#define SPONGENT_MAX_LANES 8
+#elif SPONGENT_VECTOR
+#define SPONGENT_MAX_LANES 4
+#else
+#define SPONGENT_MAX_LANES 1
+#endif
+
+/**
+ * \brief Permutes several Spongent-pi[160] states.
+ *
+ * \param states Points to an array of states to be permuted.
+ * \param count Number of states in the array.
+ *
+ * The states are processed SPONGENT_MAX_LANES at a time where possible,
+ * with any left-over states permuted one at a time.
+ */
+void spongent160_permute_n(spongent160_state_t *states, unsigned count);
+
+/**
+ * \brief Permutes several Spongent-pi[176] states.
+ *
+ * \param states Points to an array of states to be permuted.
+ * \param count Number of states in the array.
+ *
+ * The states are processed SPONGENT_MAX_LANES at a time where possible,
+ * with any left-over states permuted one at a time.
+ */
+void spongent176_permute_n(spongent176_state_t *states, unsigned count);
+
+/**
+ * \brief Gets the name of the multi-lane Spongent-pi kernel that is in use.
+ *
+ * \return One of "AVX-512", "AVX2", "Vector", or "C".
+ */
+const char *spongent_multi_lane_variant(void);
+
 #ifdef __cplusplus
 }
 #endif
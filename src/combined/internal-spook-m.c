@@ -20,8 +20,8 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
-#include "internal-spook.h"
 #include "internal-masking.h"
+#include "internal-spook.h"
 
 /**
  * \brief Round constants for the steps of Clyde-128.
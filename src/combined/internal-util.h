@@ -699,4 +699,36 @@
 #define rightRotate6_8(a)  (rightRotate_8((a), 6))
 #define rightRotate7_8(a)  (rightRotate_8((a), 7))
 
+
+/* Runtime selection of SIMD kernels.  On x86 with GCC or clang, kernels
+ * for wider instruction sets are compiled with function-level target
+ * attributes and selected at runtime by lw_simd_level().  This is not
+ * needed if the library is compiled with AVX-512 enabled, as the best
+ * kernels are then known at compile time.  Define LW_NO_SIMD_DISPATCH
+ * to only use the instruction sets that are enabled by the compiler flags */
+#if (defined(__x86_64__) || defined(__i386__)) && \
+        (defined(__GNUC__) || defined(__clang__)) && \
+        !defined(__AVX512F__) && !defined(LW_NO_SIMD_DISPATCH)
+#define LW_SIMD_DISPATCH 1
+#define LW_TARGET_AVX2 __attribute__((target("avx2")))
+#define LW_TARGET_AVX512 __attribute__((target("avx512f")))
+#else
+#define LW_SIMD_DISPATCH 0
+#define LW_TARGET_AVX2
+#define LW_TARGET_AVX512
+#endif
+
+/* SIMD kernel levels that can be returned by lw_simd_level() */
+#define LW_SIMD_LEVEL_C      0
+#define LW_SIMD_LEVEL_AVX2   1
+#define LW_SIMD_LEVEL_AVX512 2
+
+#if LW_SIMD_DISPATCH
+
+/* Gets the best SIMD kernel level for the running CPU.  The CPU is queried
+ * on the first call and the result is cached.  Implemented in aead-common.c */
+int lw_simd_level(void);
+
+#endif
+
 #endif
@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2020 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* Multi-state Xoodoo kernels.  We expect a number of macros to be defined
+ * before each inclusion of this file to configure a kernel:
+ *
+ * XOODOO_LANES_SUFFIX      Suffix to append to the kernel name; e.g. _x4.
+ * XOODOO_LANES             Number of states that are permuted in parallel.
+ * XOODOO_LANES_TARGET      Function attributes for the kernel, such as
+ *                          the instruction set to compile it for.
+ *
+ * The kernel places one state in each 32-bit lane of a vector, so each
+ * step of the permutation is applied to all of the states at once.
+ */
+
+#if defined(XOODOO_LANES_SUFFIX)
+
+#define XOODOO_CONCAT_INNER(name,suffix) name##suffix
+#define XOODOO_CONCAT(name,suffix) XOODOO_CONCAT_INNER(name,suffix)
+#define XOODOO_VEC_T XOODOO_CONCAT(xoodoo_vec,XOODOO_LANES_SUFFIX)
+#define XOODOO_SET_T XOODOO_CONCAT(xoodoo_set,XOODOO_LANES_SUFFIX)
+
+/* Vector type with one 32-bit lane per state */
+typedef uint32_t XOODOO_VEC_T __attribute__((vector_size(XOODOO_LANES * 4)));
+
+/* Words of all states, as vectors or as individual words */
+typedef union
+{
+    XOODOO_VEC_T v[12];
+    uint32_t w[12][XOODOO_LANES];
+
+} XOODOO_SET_T;
+
+/* Rotate all lanes of a vector left */
+#define xoodoo_vec_rotl(x, bits) (((x) << (bits)) | ((x) >> (32 - (bits))))
+
+/**
+ * \brief Permutes up to XOODOO_LANES Xoodoo states in parallel.
+ *
+ * \param states Points to the states to be permuted, in little-endian
+ * byte order.
+ * \param count Number of states to permute, between 1 and XOODOO_LANES.
+ */
+static XOODOO_LANES_TARGET void XOODOO_CONCAT
+    (xoodoo_permute_lanes,XOODOO_LANES_SUFFIX)
+    (xoodoo_state_t *states, unsigned count)
+{
+    static uint16_t const rc[XOODOO_ROUNDS] = {
+        0x0058, 0x0038, 0x03C0, 0x00D0, 0x0120, 0x0014,
+        0x0060, 0x002C, 0x0380, 0x00F0, 0x01A0, 0x0012
+    };
+    XOODOO_SET_T set;
+    XOODOO_VEC_T x00, x01, x02, x03;
+    XOODOO_VEC_T x10, x11, x12, x13;
+    XOODOO_VEC_T x20, x21, x22, x23;
+    XOODOO_VEC_T t1, t2;
+    unsigned lane, posn;
+    uint8_t round;
+
+    /* Transpose the states so that each vector holds one word of every
+     * state.  Unused lanes are zeroed and then discarded at the end */
+    if (count < XOODOO_LANES)
+        memset(&set, 0, sizeof(set));
+    for (lane = 0; lane < count; ++lane) {
+        for (posn = 0; posn < 12; ++posn) {
+#if defined(LW_UTIL_LITTLE_ENDIAN)
+            set.w[posn][lane] = states[lane].W[posn];
+#else
+            set.w[posn][lane] = le_load_word32(states[lane].B + posn * 4);
+#endif
+        }
+    }
+    x00 = set.v[0];
+    x01 = set.v[1];
+    x02 = set.v[2];
+    x03 = set.v[3];
+    x10 = set.v[4];
+    x11 = set.v[5];
+    x12 = set.v[6];
+    x13 = set.v[7];
+    x20 = set.v[8];
+    x21 = set.v[9];
+    x22 = set.v[10];
+    x23 = set.v[11];
+
+    /* Perform all permutation rounds; this is the same sequence of steps
+     * as the single-state version in internal-xoodoo.c */
+    for (round = 0; round < XOODOO_ROUNDS; ++round) {
+        /* Step theta: Mix column parity */
+        t1 = x03 ^ x13 ^ x23;
+        t2 = x00 ^ x10 ^ x20;
+        t1 = xoodoo_vec_rotl(t1, 5) ^ xoodoo_vec_rotl(t1, 14);
+        t2 = xoodoo_vec_rotl(t2, 5) ^ xoodoo_vec_rotl(t2, 14);
+        x00 ^= t1;
+        x10 ^= t1;
+        x20 ^= t1;
+        t1 = x01 ^ x11 ^ x21;
+        t1 = xoodoo_vec_rotl(t1, 5) ^ xoodoo_vec_rotl(t1, 14);
+        x01 ^= t2;
+        x11 ^= t2;
+        x21 ^= t2;
+        t2 = x02 ^ x12 ^ x22;
+        t2 = xoodoo_vec_rotl(t2, 5) ^ xoodoo_vec_rotl(t2, 14);
+        x02 ^= t1;
+        x12 ^= t1;
+        x22 ^= t1;
+        x03 ^= t2;
+        x13 ^= t2;
+        x23 ^= t2;
+
+        /* Step rho-west: Plane shift */
+        t1 = x13;
+        x13 = x12;
+        x12 = x11;
+        x11 = x10;
+        x10 = t1;
+        x20 = xoodoo_vec_rotl(x20, 11);
+        x21 = xoodoo_vec_rotl(x21, 11);
+        x22 = xoodoo_vec_rotl(x22, 11);
+        x23 = xoodoo_vec_rotl(x23, 11);
+
+        /* Step iota: Add the round constant to the state */
+        x00 ^= rc[round];
+
+        /* Step chi: Non-linear layer */
+        x00 ^= (~x10) & x20;
+        x10 ^= (~x20) & x00;
+        x20 ^= (~x00) & x10;
+        x01 ^= (~x11) & x21;
+        x11 ^= (~x21) & x01;
+        x21 ^= (~x01) & x11;
+        x02 ^= (~x12) & x22;
+        x12 ^= (~x22) & x02;
+        x22 ^= (~x02) & x12;
+        x03 ^= (~x13) & x23;
+        x13 ^= (~x23) & x03;
+        x23 ^= (~x03) & x13;
+
+        /* Step rho-east: Plane shift */
+        x10 = xoodoo_vec_rotl(x10, 1);
+        x11 = xoodoo_vec_rotl(x11, 1);
+        x12 = xoodoo_vec_rotl(x12, 1);
+        x13 = xoodoo_vec_rotl(x13, 1);
+        t1 = xoodoo_vec_rotl(x22, 8);
+        t2 = xoodoo_vec_rotl(x23, 8);
+        x22 = xoodoo_vec_rotl(x20, 8);
+        x23 = xoodoo_vec_rotl(x21, 8);
+        x20 = t1;
+        x21 = t2;
+    }
+
+    /* Transpose the words back into the states */
+    set.v[0] = x00;
+    set.v[1] = x01;
+    set.v[2] = x02;
+    set.v[3] = x03;
+    set.v[4] = x10;
+    set.v[5] = x11;
+    set.v[6] = x12;
+    set.v[7] = x13;
+    set.v[8] = x20;
+    set.v[9] = x21;
+    set.v[10] = x22;
+    set.v[11] = x23;
+    for (lane = 0; lane < count; ++lane) {
+        for (posn = 0; posn < 12; ++posn) {
+#if defined(LW_UTIL_LITTLE_ENDIAN)
+            states[lane].W[posn] = set.w[posn][lane];
+#else
+            le_store_word32(states[lane].B + posn * 4, set.w[posn][lane]);
+#endif
+        }
+    }
+}
+
+#undef xoodoo_vec_rotl
+
+#endif /* XOODOO_LANES_SUFFIX */
+
+/* Now undefine everything so that we can include this file again for
+ * another kernel width */
+#undef XOODOO_LANES_SUFFIX
+#undef XOODOO_LANES
+#undef XOODOO_LANES_TARGET
+#undef XOODOO_CONCAT_INNER
+#undef XOODOO_CONCAT
+#undef XOODOO_VEC_T
+#undef XOODOO_SET_T
@@ -21,6 +21,7 @@
  */
 
 #include "internal-xoodoo.h"
+#include <string.h>
 
 #if defined(__AVR__)
 #define XOODOO_ASM 1
@@ -172,3 +173,96 @@ void xoodoo_permute(xoodoo_state_t *state)
 }
 
 #endif /* !XOODOO_ASM */
+
+/* 4-state kernel for 128-bit vector units */
+#if XOODOO_HAVE_X4
+#define XOODOO_LANES_SUFFIX _x4
+#define XOODOO_LANES 4
+#define XOODOO_LANES_TARGET
+#include "internal-xoodoo-lanes.h"
+#endif
+
+/* 8-state kernel for AVX2 */
+#if XOODOO_HAVE_X8
+#define XOODOO_LANES_SUFFIX _x8
+#define XOODOO_LANES 8
+#if defined(__AVX2__)
+#define XOODOO_LANES_TARGET
+#else
+#define XOODOO_LANES_TARGET LW_TARGET_AVX2
+#endif
+#include "internal-xoodoo-lanes.h"
+#endif
+
+/**
+ * \brief Determine if the 8-state kernel can be used on this CPU.
+ */
+#if XOODOO_SIMD_DISPATCH && !defined(__AVX2__)
+#define xoodoo_can_use_x8() (lw_simd_level() >= LW_SIMD_LEVEL_AVX2)
+#else
+#define xoodoo_can_use_x8() (XOODOO_HAVE_X8)
+#endif
+
+void xoodoo_permute_x4(xoodoo_state_t states[4])
+{
+#if XOODOO_HAVE_X4
+    xoodoo_permute_lanes_x4(states, 4);
+#else
+    xoodoo_permute(&(states[0]));
+    xoodoo_permute(&(states[1]));
+    xoodoo_permute(&(states[2]));
+    xoodoo_permute(&(states[3]));
+#endif
+}
+
+void xoodoo_permute_x8(xoodoo_state_t states[8])
+{
+#if XOODOO_HAVE_X8
+    if (xoodoo_can_use_x8()) {
+        xoodoo_permute_lanes_x8(states, 8);
+        return;
+    }
+#endif
+    xoodoo_permute_x4(states);
+    xoodoo_permute_x4(states + 4);
+}
+
+void xoodoo_permute_n(xoodoo_state_t *states, unsigned count)
+{
+#if XOODOO_HAVE_X4 || XOODOO_HAVE_X8
+    unsigned n;
+#endif
+#if XOODOO_HAVE_X8
+    if (xoodoo_can_use_x8()) {
+        while (count > 4) {
+            n = (count < 8) ? count : 8;
+            xoodoo_permute_lanes_x8(states, n);
+            states += n;
+            count -= n;
+        }
+    }
+#endif
+#if XOODOO_HAVE_X4
+    while (count > 1) {
+        n = (count < 4) ? count : 4;
+        xoodoo_permute_lanes_x4(states, n);
+        states += n;
+        count -= n;
+    }
+#endif
+    while (count > 0) {
+        xoodoo_permute(states);
+        ++states;
+        --count;
+    }
+}
+
+const char *xoodoo_multi_variant(void)
+{
+    if (xoodoo_can_use_x8())
+        return "AVX2";
+    else if (XOODOO_HAVE_X4)
+        return "Vector";
+    else
+        return "C";
+}
@@ -76,6 +76,91 @@ typedef union
  */
 void xoodoo_permute(xoodoo_state_t *state);
 
+/**
+ * \brief Defined to 1 if the multi-state Xoodoo kernels are selected
+ * at runtime according to the features of the CPU.
+ */
+#if LW_SIMD_DISPATCH && !defined(XOODOO_NO_SIMD_DISPATCH)
+#define XOODOO_SIMD_DISPATCH 1
+#else
+#define XOODOO_SIMD_DISPATCH 0
+#endif
+
+/**
+ * \brief Defined to 1 if there is a 4-state Xoodoo kernel for the
+ * baseline 128-bit vector unit; SSE2 or NEON.
+ */
+#if !defined(__AVR__) && (defined(__GNUC__) || defined(__clang__)) && \
+        (defined(__SSE2__) || defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define XOODOO_HAVE_X4 1
+#else
+#define XOODOO_HAVE_X4 0
+#endif
+
+/**
+ * \brief Defined to 1 if there is an 8-state Xoodoo kernel for AVX2.
+ */
+#if (defined(__GNUC__) || defined(__clang__)) && \
+        (defined(__AVX2__) || XOODOO_SIMD_DISPATCH)
+#define XOODOO_HAVE_X8 1
+#else
+#define XOODOO_HAVE_X8 0
+#endif
+
+/**
+ * \brief Maximum number of Xoodoo states that are permuted in parallel
+ * by the widest multi-state kernel available on this platform.
+ */
+#if XOODOO_HAVE_X8
+#define XOODOO_MAX_LANES 8
+#elif XOODOO_HAVE_X4
+#define XOODOO_MAX_LANES 4
+#else
+#define XOODOO_MAX_LANES 1
+#endif
+
+/**
+ * \brief Permutes four Xoodoo states in parallel.
+ *
+ * \param states Points to the four states, which are assumed to be
+ * in little-endian byte order.
+ *
+ * Each of the twelve words of the states is placed in a 32-bit lane
+ * of a 128-bit vector so that the four permutations run side by side.
+ * Platforms without a suitable vector unit permute the states one
+ * at a time.
+ */
+void xoodoo_permute_x4(xoodoo_state_t states[4]);
+
+/**
+ * \brief Permutes eight Xoodoo states in parallel.
+ *
+ * \param states Points to the eight states, which are assumed to be
+ * in little-endian byte order.
+ *
+ * This uses 256-bit vectors if the CPU supports AVX2, or two calls
+ * to xoodoo_permute_x4() otherwise.
+ */
+void xoodoo_permute_x8(xoodoo_state_t states[8]);
+
+/**
+ * \brief Permutes several Xoodoo states.
+ *
+ * \param states Points to an array of states to be permuted, which are
+ * assumed to be in little-endian byte order.
+ * \param count Number of states in the array.
+ *
+ * The states are processed up to XOODOO_MAX_LANES at a time.
+ */
+void xoodoo_permute_n(xoodoo_state_t *states, unsigned count);
+
+/**
+ * \brief Gets the name of the multi-state Xoodoo kernels that are in use.
+ *
+ * \return One of "AVX2", "Vector", or "C".
+ */
+const char *xoodoo_multi_variant(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -25,6 +25,60 @@
 #include "internal-ascon.h"
 #include <string.h>
 
+/**
+ * \brief Encrypts a batch of packets with ISAP-K-128A.
+ *
+ * \param items Points to the descriptors for the packets.
+ * \param count Number of packets in the batch.
+ */
+static void isap_keccak_128a_batch_encrypt
+    (aead_batch_item_t *items, size_t count);
+
+/**
+ * \brief Decrypts a batch of packets with ISAP-K-128A.
+ *
+ * \param items Points to the descriptors for the packets.
+ * \param count Number of packets in the batch.
+ */
+static void isap_keccak_128a_batch_decrypt
+    (aead_batch_item_t *items, size_t count);
+
+/**
+ * \brief Encrypts a batch of packets with ISAP-K-128.
+ *
+ * \param items Points to the descriptors for the packets.
+ * \param count Number of packets in the batch.
+ */
+static void isap_keccak_128_batch_encrypt
+    (aead_batch_item_t *items, size_t count);
+
+/**
+ * \brief Decrypts a batch of packets with ISAP-K-128.
+ *
+ * \param items Points to the descriptors for the packets.
+ * \param count Number of packets in the batch.
+ */
+static void isap_keccak_128_batch_decrypt
+    (aead_batch_item_t *items, size_t count);
+
+/**
+ * \brief Batch functions for ISAP-K-128A, which re-key several packets
+ * at once with the multi-lane Keccak-p[400] permutation.
+ */
+static aead_batch_cipher_t const isap_keccak_128a_batch_cipher = {
+    isap_keccak_128a_batch_encrypt,
+    isap_keccak_128a_batch_decrypt
+};
+
+/**
+ * \brief Batch functions for ISAP-K-128, which re-key several packets
+ * at once with the multi-lane Keccak-p[400] permutation.
+ */
+static aead_batch_cipher_t const isap_keccak_128_batch_cipher = {
+    isap_keccak_128_batch_encrypt,
+    isap_keccak_128_batch_decrypt
+};
+
 aead_cipher_t const isap_keccak_128a_cipher = {
     "ISAP-K-128A",
     ISAP_KEY_SIZE,
@@ -32,7 +86,13 @@ aead_cipher_t const isap_keccak_128a_cipher = {
     ISAP_TAG_SIZE,
     AEAD_FLAG_SC_PROTECT_KEY,
     isap_keccak_128a_aead_encrypt,
-    isap_keccak_128a_aead_decrypt
+    isap_keccak_128a_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    &isap_keccak_128a_batch_cipher
 };
 
 aead_cipher_t const isap_ascon_128a_cipher = {
@@ -42,7 +102,13 @@ aead_cipher_t const isap_ascon_128a_cipher = {
     ISAP_TAG_SIZE,
     AEAD_FLAG_SC_PROTECT_KEY,
     isap_ascon_128a_aead_encrypt,
-    isap_ascon_128a_aead_decrypt
+    isap_ascon_128a_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_cipher_t const isap_keccak_128_cipher = {
@@ -52,7 +118,13 @@ aead_cipher_t const isap_keccak_128_cipher = {
     ISAP_TAG_SIZE,
     AEAD_FLAG_SC_PROTECT_KEY,
     isap_keccak_128_aead_encrypt,
-    isap_keccak_128_aead_decrypt
+    isap_keccak_128_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    &isap_keccak_128_batch_cipher
 };
 
 aead_cipher_t const isap_ascon_128_cipher = {
@@ -62,7 +134,13 @@ aead_cipher_t const isap_ascon_128_cipher = {
     ISAP_TAG_SIZE,
     AEAD_FLAG_SC_PROTECT_KEY,
     isap_ascon_128_aead_encrypt,
-    isap_ascon_128_aead_decrypt
+    isap_ascon_128_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 /* ISAP-K-128A */
@@ -74,6 +152,10 @@ aead_cipher_t const isap_ascon_128_cipher = {
 #define ISAP_sK 8
 #define ISAP_STATE keccakp_400_state_t
 #define ISAP_PERMUTE(s,r) keccakp_400_permute((s), (r))
+#define ISAP_PERMUTE_N(s,n,r) keccakp_400_permute_n((s), (n), (r))
+#define ISAP_ABSORB_BITS_N(s,n,d,b,r) \
+    keccakp_400_absorb_bits_n((s), (n), (d), (b), (r))
+#define ISAP_BATCH_LANES KECCAKP_400_MAX_LANES
 #include "internal-isap.h"
 
 /* ISAP-A-128A */
@@ -99,6 +181,10 @@ aead_cipher_t const isap_ascon_128_cipher = {
 #define ISAP_sK 12
 #define ISAP_STATE keccakp_400_state_t
 #define ISAP_PERMUTE(s,r) keccakp_400_permute((s), (r))
+#define ISAP_PERMUTE_N(s,n,r) keccakp_400_permute_n((s), (n), (r))
+#define ISAP_ABSORB_BITS_N(s,n,d,b,r) \
+    keccakp_400_absorb_bits_n((s), (n), (d), (b), (r))
+#define ISAP_BATCH_LANES KECCAKP_400_MAX_LANES
 #include "internal-isap.h"
 
 /* ISAP-A-128 */
@@ -24,6 +24,58 @@
 #include "internal-knot.h"
 #include <string.h>
 
+/**
+ * \brief Incremental AEAD functions for KNOT-AEAD-128-256.
+ */
+static aead_stream_cipher_t const knot_aead_128_256_stream_cipher = {
+    sizeof(knot_aead_state_t),
+    (aead_stream_init_t)knot_aead_128_256_stream_init,
+    (aead_stream_update_ad_t)knot_aead_stream_update_ad,
+    (aead_stream_crypt_t)knot_aead_stream_encrypt,
+    (aead_stream_crypt_t)knot_aead_stream_decrypt,
+    (aead_stream_encrypt_finalize_t)knot_aead_stream_encrypt_finalize,
+    (aead_stream_decrypt_finalize_t)knot_aead_stream_decrypt_finalize
+};
+
+/**
+ * \brief Incremental AEAD functions for KNOT-AEAD-128-384.
+ */
+static aead_stream_cipher_t const knot_aead_128_384_stream_cipher = {
+    sizeof(knot_aead_state_t),
+    (aead_stream_init_t)knot_aead_128_384_stream_init,
+    (aead_stream_update_ad_t)knot_aead_stream_update_ad,
+    (aead_stream_crypt_t)knot_aead_stream_encrypt,
+    (aead_stream_crypt_t)knot_aead_stream_decrypt,
+    (aead_stream_encrypt_finalize_t)knot_aead_stream_encrypt_finalize,
+    (aead_stream_decrypt_finalize_t)knot_aead_stream_decrypt_finalize
+};
+
+/**
+ * \brief Incremental AEAD functions for KNOT-AEAD-192-384.
+ */
+static aead_stream_cipher_t const knot_aead_192_384_stream_cipher = {
+    sizeof(knot_aead_state_t),
+    (aead_stream_init_t)knot_aead_192_384_stream_init,
+    (aead_stream_update_ad_t)knot_aead_stream_update_ad,
+    (aead_stream_crypt_t)knot_aead_stream_encrypt,
+    (aead_stream_crypt_t)knot_aead_stream_decrypt,
+    (aead_stream_encrypt_finalize_t)knot_aead_stream_encrypt_finalize,
+    (aead_stream_decrypt_finalize_t)knot_aead_stream_decrypt_finalize
+};
+
+/**
+ * \brief Incremental AEAD functions for KNOT-AEAD-256-512.
+ */
+static aead_stream_cipher_t const knot_aead_256_512_stream_cipher = {
+    sizeof(knot_aead_state_t),
+    (aead_stream_init_t)knot_aead_256_512_stream_init,
+    (aead_stream_update_ad_t)knot_aead_stream_update_ad,
+    (aead_stream_crypt_t)knot_aead_stream_encrypt,
+    (aead_stream_crypt_t)knot_aead_stream_decrypt,
+    (aead_stream_encrypt_finalize_t)knot_aead_stream_encrypt_finalize,
+    (aead_stream_decrypt_finalize_t)knot_aead_stream_decrypt_finalize
+};
+
 aead_cipher_t const knot_aead_128_256_cipher = {
     "KNOT-AEAD-128-256",
     KNOT_AEAD_128_KEY_SIZE,
@@ -31,7 +83,13 @@ aead_cipher_t const knot_aead_128_256_cipher = {
     KNOT_AEAD_128_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN,
     knot_aead_128_256_encrypt,
-    knot_aead_128_256_decrypt
+    knot_aead_128_256_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    &knot_aead_128_256_stream_cipher,
+    0  /* batch */
 };
 
 aead_cipher_t const knot_aead_128_384_cipher = {
@@ -41,7 +99,13 @@ aead_cipher_t const knot_aead_128_384_cipher = {
     KNOT_AEAD_128_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN,
     knot_aead_128_384_encrypt,
-    knot_aead_128_384_decrypt
+    knot_aead_128_384_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    &knot_aead_128_384_stream_cipher,
+    0  /* batch */
 };
 
 aead_cipher_t const knot_aead_192_384_cipher = {
@@ -51,7 +115,13 @@ aead_cipher_t const knot_aead_192_384_cipher = {
     KNOT_AEAD_192_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN,
     knot_aead_192_384_encrypt,
-    knot_aead_192_384_decrypt
+    knot_aead_192_384_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    &knot_aead_192_384_stream_cipher,
+    0  /* batch */
 };
 
 aead_cipher_t const knot_aead_256_512_cipher = {
@@ -61,7 +131,13 @@ aead_cipher_t const knot_aead_256_512_cipher = {
     KNOT_AEAD_256_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN,
     knot_aead_256_512_encrypt,
-    knot_aead_256_512_decrypt
+    knot_aead_256_512_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    &knot_aead_256_512_stream_cipher,
+    0  /* batch */
 };
 
 /**
@@ -501,3 +577,297 @@ int knot_aead_256_512_decrypt
     return aead_check_tag
         (m, clen, state.B, c + clen, KNOT_AEAD_256_TAG_SIZE);
 }
+
+/**
+ * \brief Parameters for a KNOT-AEAD variant in incremental mode.
+ */
+typedef struct
+{
+    knot_permute_t permute;     /**< Permutation function */
+    unsigned char state_size;   /**< Size of the permutation state */
+    unsigned char rate;         /**< Rate for absorbing and encrypting */
+    unsigned char rounds;       /**< Rounds for each block */
+    unsigned char final_rounds; /**< Rounds for generating the tag */
+    unsigned char tag_size;     /**< Size of the authentication tag */
+
+} knot_aead_stream_params_t;
+
+/**
+ * \brief Parameters for the KNOT-AEAD variants in incremental mode.
+ */
+static knot_aead_stream_params_t const knot_aead_stream_params[] = {
+    {(knot_permute_t)knot256_permute_6, 32, KNOT_AEAD_128_256_RATE,
+     28, 32, KNOT_AEAD_128_TAG_SIZE},
+    {(knot_permute_t)knot384_permute_7, 48, KNOT_AEAD_128_384_RATE,
+     28, 32, KNOT_AEAD_128_TAG_SIZE},
+    {(knot_permute_t)knot384_permute_7, 48, KNOT_AEAD_192_384_RATE,
+     40, 44, KNOT_AEAD_192_TAG_SIZE},
+    {(knot_permute_t)knot512_permute_7, 64, KNOT_AEAD_256_512_RATE,
+     52, 56, KNOT_AEAD_256_TAG_SIZE}
+};
+
+/**
+ * \brief Mode value for an incremental KNOT-AEAD state that has not
+ * absorbed any associated data yet.
+ */
+#define KNOT_STREAM_MODE_INIT 0
+
+/**
+ * \brief Mode value for an incremental KNOT-AEAD state that is absorbing
+ * associated data.
+ */
+#define KNOT_STREAM_MODE_AD 1
+
+/**
+ * \brief Mode value for an incremental KNOT-AEAD state that has
+ * processed at least one byte of payload.
+ */
+#define KNOT_STREAM_MODE_PAYLOAD 2
+
+void knot_aead_128_256_stream_init
+    (knot_aead_state_t *state, const unsigned char *npub,
+     const unsigned char *k)
+{
+    memcpy(state->s.state, npub, KNOT_AEAD_128_NONCE_SIZE);
+    memcpy(state->s.state + KNOT_AEAD_128_NONCE_SIZE, k,
+           KNOT_AEAD_128_KEY_SIZE);
+    knot256_permute_6((knot256_state_t *)(state->s.state), 52);
+    state->s.count = 0;
+    state->s.mode = KNOT_STREAM_MODE_INIT;
+    state->s.variant = 0;
+}
+
+void knot_aead_128_384_stream_init
+    (knot_aead_state_t *state, const unsigned char *npub,
+     const unsigned char *k)
+{
+    memcpy(state->s.state, npub, KNOT_AEAD_128_NONCE_SIZE);
+    memcpy(state->s.state + KNOT_AEAD_128_NONCE_SIZE, k,
+           KNOT_AEAD_128_KEY_SIZE);
+    memset(state->s.state + KNOT_AEAD_128_NONCE_SIZE + KNOT_AEAD_128_KEY_SIZE,
+           0, 47 - (KNOT_AEAD_128_NONCE_SIZE + KNOT_AEAD_128_KEY_SIZE));
+    state->s.state[47] = 0x80;
+    knot384_permute_7((knot384_state_t *)(state->s.state), 76);
+    state->s.count = 0;
+    state->s.mode = KNOT_STREAM_MODE_INIT;
+    state->s.variant = 1;
+}
+
+void knot_aead_192_384_stream_init
+    (knot_aead_state_t *state, const unsigned char *npub,
+     const unsigned char *k)
+{
+    memcpy(state->s.state, npub, KNOT_AEAD_192_NONCE_SIZE);
+    memcpy(state->s.state + KNOT_AEAD_192_NONCE_SIZE, k,
+           KNOT_AEAD_192_KEY_SIZE);
+    knot384_permute_7((knot384_state_t *)(state->s.state), 76);
+    state->s.count = 0;
+    state->s.mode = KNOT_STREAM_MODE_INIT;
+    state->s.variant = 2;
+}
+
+void knot_aead_256_512_stream_init
+    (knot_aead_state_t *state, const unsigned char *npub,
+     const unsigned char *k)
+{
+    memcpy(state->s.state, npub, KNOT_AEAD_256_NONCE_SIZE);
+    memcpy(state->s.state + KNOT_AEAD_256_NONCE_SIZE, k,
+           KNOT_AEAD_256_KEY_SIZE);
+    knot512_permute_7((knot512_state_t *)(state->s.state), 100);
+    state->s.count = 0;
+    state->s.mode = KNOT_STREAM_MODE_INIT;
+    state->s.variant = 3;
+}
+
+void knot_aead_stream_update_ad
+    (knot_aead_state_t *state, const unsigned char *ad,
+     unsigned long long adlen)
+{
+    const knot_aead_stream_params_t *params =
+        &(knot_aead_stream_params[state->s.variant]);
+    unsigned rate = params->rate;
+    unsigned temp;
+
+    /* Nothing to do if there is no associated data */
+    if (!adlen)
+        return;
+    state->s.mode = KNOT_STREAM_MODE_AD;
+
+    /* Handle the partial left-over block from last time */
+    if (state->s.count) {
+        temp = rate - state->s.count;
+        if (temp > adlen) {
+            temp = (unsigned)adlen;
+            lw_xor_block(state->s.state + state->s.count, ad, temp);
+            state->s.count += temp;
+            return;
+        }
+        lw_xor_block(state->s.state + state->s.count, ad, temp);
+        params->permute(state->s.state, params->rounds);
+        state->s.count = 0;
+        ad += temp;
+        adlen -= temp;
+    }
+
+    /* Process full blocks that are aligned at state->s.count == 0 */
+    while (adlen >= rate) {
+        lw_xor_block(state->s.state, ad, rate);
+        params->permute(state->s.state, params->rounds);
+        ad += rate;
+        adlen -= rate;
+    }
+
+    /* Process the left-over block; padding is deferred */
+    temp = (unsigned)adlen;
+    lw_xor_block(state->s.state, ad, temp);
+    state->s.count = temp;
+}
+
+/**
+ * \brief Finishes the associated data for an incremental KNOT-AEAD state.
+ *
+ * \param state The incremental AEAD state.
+ * \param params Parameters for the KNOT-AEAD variant.
+ */
+static void knot_aead_stream_end_ad
+    (knot_aead_state_t *state, const knot_aead_stream_params_t *params)
+{
+    if (state->s.mode == KNOT_STREAM_MODE_AD) {
+        state->s.state[state->s.count] ^= 0x01; /* Padding */
+        params->permute(state->s.state, params->rounds);
+        state->s.count = 0;
+    }
+    state->s.state[params->state_size - 1] ^= 0x80; /* Domain separation */
+}
+
+void knot_aead_stream_encrypt
+    (knot_aead_state_t *state, unsigned char *c,
+     const unsigned char *m, unsigned long long len)
+{
+    const knot_aead_stream_params_t *params =
+        &(knot_aead_stream_params[state->s.variant]);
+    unsigned rate = params->rate;
+    unsigned temp;
+
+    /* Switch to payload mode on the first byte of payload */
+    if (!len)
+        return;
+    if (state->s.mode != KNOT_STREAM_MODE_PAYLOAD) {
+        knot_aead_stream_end_ad(state, params);
+        state->s.mode = KNOT_STREAM_MODE_PAYLOAD;
+    }
+
+    /* Handle the partial left-over block from last time */
+    if (state->s.count) {
+        temp = rate - state->s.count;
+        if (temp > len) {
+            temp = (unsigned)len;
+            lw_xor_block_2_dest(c, state->s.state + state->s.count, m, temp);
+            state->s.count += temp;
+            return;
+        }
+        lw_xor_block_2_dest(c, state->s.state + state->s.count, m, temp);
+        params->permute(state->s.state, params->rounds);
+        state->s.count = 0;
+        c += temp;
+        m += temp;
+        len -= temp;
+    }
+
+    /* Process full blocks that are aligned at state->s.count == 0 */
+    while (len >= rate) {
+        lw_xor_block_2_dest(c, state->s.state, m, rate);
+        params->permute(state->s.state, params->rounds);
+        c += rate;
+        m += rate;
+        len -= rate;
+    }
+
+    /* Process the left-over block at the end of the input */
+    temp = (unsigned)len;
+    lw_xor_block_2_dest(c, state->s.state, m, temp);
+    state->s.count = temp;
+}
+
+void knot_aead_stream_decrypt
+    (knot_aead_state_t *state, unsigned char *m,
+     const unsigned char *c, unsigned long long len)
+{
+    const knot_aead_stream_params_t *params =
+        &(knot_aead_stream_params[state->s.variant]);
+    unsigned rate = params->rate;
+    unsigned temp;
+
+    /* Switch to payload mode on the first byte of payload */
+    if (!len)
+        return;
+    if (state->s.mode != KNOT_STREAM_MODE_PAYLOAD) {
+        knot_aead_stream_end_ad(state, params);
+        state->s.mode = KNOT_STREAM_MODE_PAYLOAD;
+    }
+
+    /* Handle the partial left-over block from last time */
+    if (state->s.count) {
+        temp = rate - state->s.count;
+        if (temp > len) {
+            temp = (unsigned)len;
+            lw_xor_block_swap(m, state->s.state + state->s.count, c, temp);
+            state->s.count += temp;
+            return;
+        }
+        lw_xor_block_swap(m, state->s.state + state->s.count, c, temp);
+        params->permute(state->s.state, params->rounds);
+        state->s.count = 0;
+        c += temp;
+        m += temp;
+        len -= temp;
+    }
+
+    /* Process full blocks that are aligned at state->s.count == 0 */
+    while (len >= rate) {
+        lw_xor_block_swap(m, state->s.state, c, rate);
+        params->permute(state->s.state, params->rounds);
+        c += rate;
+        m += rate;
+        len -= rate;
+    }
+
+    /* Process the left-over block at the end of the input */
+    temp = (unsigned)len;
+    lw_xor_block_swap(m, state->s.state, c, temp);
+    state->s.count = temp;
+}
+
+/**
+ * \brief Computes the authentication tag for an incremental KNOT-AEAD state.
+ *
+ * \param state The incremental AEAD state.
+ *
+ * \return The size of the authentication tag, which is left in the
+ * leading bytes of the state.
+ */
+static unsigned knot_aead_stream_compute_tag(knot_aead_state_t *state)
+{
+    const knot_aead_stream_params_t *params =
+        &(knot_aead_stream_params[state->s.variant]);
+    if (state->s.mode == KNOT_STREAM_MODE_PAYLOAD)
+        state->s.state[state->s.count] ^= 0x01; /* Padding */
+    else
+        knot_aead_stream_end_ad(state, params);
+    params->permute(state->s.state, params->final_rounds);
+    return params->tag_size;
+}
+
+void knot_aead_stream_encrypt_finalize
+    (knot_aead_state_t *state, unsigned char *tag)
+{
+    unsigned tag_size = knot_aead_stream_compute_tag(state);
+    memcpy(tag, state->s.state, tag_size);
+}
+
+int knot_aead_stream_decrypt_finalize
+    (knot_aead_state_t *state, const unsigned char *tag)
+{
+    unsigned tag_size = knot_aead_stream_compute_tag(state);
+    return aead_check_tag(0, 0, state->s.state, tag, tag_size);
+}
@@ -20,13 +20,14 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include "internal-masking.h"
 #include "knot-masked.h"
 #include "internal-knot.h"
 #include "internal-knot-m.h"
 #include <string.h>
 
 aead_cipher_t const knot_aead_128_256_masked_cipher = {
-    "KNOT-AEAD-128-256-Masked",
+    AEAD_MASKING_CIPHER_NAME("KNOT-AEAD-128-256-Masked"),
     KNOT_AEAD_MASKED_128_KEY_SIZE,
     KNOT_AEAD_MASKED_128_NONCE_SIZE,
     KNOT_AEAD_MASKED_128_TAG_SIZE,
@@ -36,11 +37,17 @@ aead_cipher_t const knot_aead_128_256_masked_cipher = {
     AEAD_FLAG_LITTLE_ENDIAN | AEAD_FLAG_SC_PROTECT_ALL,
 #endif
     knot_masked_128_256_aead_encrypt,
-    knot_masked_128_256_aead_decrypt
+    knot_masked_128_256_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_cipher_t const knot_aead_128_384_masked_cipher = {
-    "KNOT-AEAD-128-384-Masked",
+    AEAD_MASKING_CIPHER_NAME("KNOT-AEAD-128-384-Masked"),
     KNOT_AEAD_MASKED_128_KEY_SIZE,
     KNOT_AEAD_MASKED_128_NONCE_SIZE,
     KNOT_AEAD_MASKED_128_TAG_SIZE,
@@ -50,11 +57,17 @@ aead_cipher_t const knot_aead_128_384_masked_cipher = {
     AEAD_FLAG_LITTLE_ENDIAN | AEAD_FLAG_SC_PROTECT_ALL,
 #endif
     knot_masked_128_384_aead_encrypt,
-    knot_masked_128_384_aead_decrypt
+    knot_masked_128_384_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_cipher_t const knot_aead_192_384_masked_cipher = {
-    "KNOT-AEAD-192-384-Masked",
+    AEAD_MASKING_CIPHER_NAME("KNOT-AEAD-192-384-Masked"),
     KNOT_AEAD_MASKED_192_KEY_SIZE,
     KNOT_AEAD_MASKED_192_NONCE_SIZE,
     KNOT_AEAD_MASKED_192_TAG_SIZE,
@@ -64,11 +77,17 @@ aead_cipher_t const knot_aead_192_384_masked_cipher = {
     AEAD_FLAG_LITTLE_ENDIAN | AEAD_FLAG_SC_PROTECT_ALL,
 #endif
     knot_masked_192_384_aead_encrypt,
-    knot_masked_192_384_aead_decrypt
+    knot_masked_192_384_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_cipher_t const knot_aead_256_512_masked_cipher = {
-    "KNOT-AEAD-256-512-Masked",
+    AEAD_MASKING_CIPHER_NAME("KNOT-AEAD-256-512-Masked"),
     KNOT_AEAD_MASKED_256_KEY_SIZE,
     KNOT_AEAD_MASKED_256_NONCE_SIZE,
     KNOT_AEAD_MASKED_256_TAG_SIZE,
@@ -78,7 +97,13 @@ aead_cipher_t const knot_aead_256_512_masked_cipher = {
     AEAD_FLAG_LITTLE_ENDIAN | AEAD_FLAG_SC_PROTECT_ALL,
 #endif
     knot_masked_256_512_aead_encrypt,
-    knot_masked_256_512_aead_decrypt
+    knot_masked_256_512_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 /**
@@ -85,21 +85,93 @@ extern "C" {
  */
 extern aead_cipher_t const knot_aead_128_256_masked_cipher;
 
+/**
+ * \brief Meta-information block for the masked KNOT-AEAD-128-256 cipher with
+ * 2 shares.
+ */
+extern aead_cipher_t const knot_aead_128_256_masked_cipher_x2;
+
+/**
+ * \brief Meta-information block for the masked KNOT-AEAD-128-256 cipher with
+ * 3 shares.
+ */
+extern aead_cipher_t const knot_aead_128_256_masked_cipher_x3;
+
+/**
+ * \brief Meta-information block for the masked KNOT-AEAD-128-256 cipher with
+ * 4 shares.
+ */
+extern aead_cipher_t const knot_aead_128_256_masked_cipher_x4;
+
 /**
  * \brief Meta-information block for the masked KNOT-AEAD-128-384 cipher.
  */
 extern aead_cipher_t const knot_aead_128_384_masked_cipher;
 
+/**
+ * \brief Meta-information block for the masked KNOT-AEAD-128-384 cipher with
+ * 2 shares.
+ */
+extern aead_cipher_t const knot_aead_128_384_masked_cipher_x2;
+
+/**
+ * \brief Meta-information block for the masked KNOT-AEAD-128-384 cipher with
+ * 3 shares.
+ */
+extern aead_cipher_t const knot_aead_128_384_masked_cipher_x3;
+
+/**
+ * \brief Meta-information block for the masked KNOT-AEAD-128-384 cipher with
+ * 4 shares.
+ */
+extern aead_cipher_t const knot_aead_128_384_masked_cipher_x4;
+
 /**
  * \brief Meta-information block for the masked KNOT-AEAD-192-384 cipher.
  */
 extern aead_cipher_t const knot_aead_192_384_masked_cipher;
 
+/**
+ * \brief Meta-information block for the masked KNOT-AEAD-192-384 cipher with
+ * 2 shares.
+ */
+extern aead_cipher_t const knot_aead_192_384_masked_cipher_x2;
+
+/**
+ * \brief Meta-information block for the masked KNOT-AEAD-192-384 cipher with
+ * 3 shares.
+ */
+extern aead_cipher_t const knot_aead_192_384_masked_cipher_x3;
+
+/**
+ * \brief Meta-information block for the masked KNOT-AEAD-192-384 cipher with
+ * 4 shares.
+ */
+extern aead_cipher_t const knot_aead_192_384_masked_cipher_x4;
+
 /**
  * \brief Meta-information block for the masked KNOT-AEAD-256-512 cipher.
  */
 extern aead_cipher_t const knot_aead_256_512_masked_cipher;
 
+/**
+ * \brief Meta-information block for the masked KNOT-AEAD-256-512 cipher with
+ * 2 shares.
+ */
+extern aead_cipher_t const knot_aead_256_512_masked_cipher_x2;
+
+/**
+ * \brief Meta-information block for the masked KNOT-AEAD-256-512 cipher with
+ * 3 shares.
+ */
+extern aead_cipher_t const knot_aead_256_512_masked_cipher_x3;
+
+/**
+ * \brief Meta-information block for the masked KNOT-AEAD-256-512 cipher with
+ * 4 shares.
+ */
+extern aead_cipher_t const knot_aead_256_512_masked_cipher_x4;
+
 /**
  * \brief Encrypts and authenticates a packet with masked KNOT-AEAD-128-256.
  *
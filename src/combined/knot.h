@@ -119,6 +119,21 @@ extern "C" {
  */
 #define KNOT_HASH_512_SIZE 64
 
+/**
+ * \brief State information for the incremental KNOT-AEAD modes.
+ */
+typedef union
+{
+    struct {
+        unsigned char state[64]; /**< Current permutation state */
+        unsigned char count;     /**< Number of bytes in the current block */
+        unsigned char mode;      /**< Associated data or payload mode */
+        unsigned char variant;   /**< Identifies the KNOT-AEAD variant */
+    } s;                         /**< State */
+    unsigned long long align;    /**< For alignment of this structure */
+
+} knot_aead_state_t;
+
 /**
  * \brief Meta-information block for the KNOT-AEAD-128-256 cipher.
  */
@@ -396,6 +411,140 @@ int knot_aead_256_512_decrypt
      const unsigned char *npub,
      const unsigned char *k);
 
+/**
+ * \brief Initializes the state for an incremental KNOT-AEAD-128-256
+ * operation.
+ *
+ * \param state Incremental AEAD state to be initialized.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 16 bytes of the key to use to encrypt or
+ * decrypt the packet.
+ *
+ * \sa knot_aead_stream_update_ad(), knot_aead_stream_encrypt(),
+ * knot_aead_stream_decrypt()
+ */
+void knot_aead_128_256_stream_init
+    (knot_aead_state_t *state, const unsigned char *npub,
+     const unsigned char *k);
+
+/**
+ * \brief Initializes the state for an incremental KNOT-AEAD-128-384
+ * operation.
+ *
+ * \param state Incremental AEAD state to be initialized.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 16 bytes of the key to use to encrypt or
+ * decrypt the packet.
+ *
+ * \sa knot_aead_stream_update_ad(), knot_aead_stream_encrypt(),
+ * knot_aead_stream_decrypt()
+ */
+void knot_aead_128_384_stream_init
+    (knot_aead_state_t *state, const unsigned char *npub,
+     const unsigned char *k);
+
+/**
+ * \brief Initializes the state for an incremental KNOT-AEAD-192-384
+ * operation.
+ *
+ * \param state Incremental AEAD state to be initialized.
+ * \param npub Points to the public nonce for the packet which must
+ * be 24 bytes in length.
+ * \param k Points to the 24 bytes of the key to use to encrypt or
+ * decrypt the packet.
+ *
+ * \sa knot_aead_stream_update_ad(), knot_aead_stream_encrypt(),
+ * knot_aead_stream_decrypt()
+ */
+void knot_aead_192_384_stream_init
+    (knot_aead_state_t *state, const unsigned char *npub,
+     const unsigned char *k);
+
+/**
+ * \brief Initializes the state for an incremental KNOT-AEAD-256-512
+ * operation.
+ *
+ * \param state Incremental AEAD state to be initialized.
+ * \param npub Points to the public nonce for the packet which must
+ * be 32 bytes in length.
+ * \param k Points to the 32 bytes of the key to use to encrypt or
+ * decrypt the packet.
+ *
+ * \sa knot_aead_stream_update_ad(), knot_aead_stream_encrypt(),
+ * knot_aead_stream_decrypt()
+ */
+void knot_aead_256_512_stream_init
+    (knot_aead_state_t *state, const unsigned char *npub,
+     const unsigned char *k);
+
+/**
+ * \brief Absorbs more associated data into an incremental KNOT-AEAD state.
+ *
+ * \param state Incremental AEAD state to be updated.
+ * \param ad Points to the associated data to be absorbed.
+ * \param adlen Length of the associated data in bytes.
+ *
+ * All associated data must be absorbed before the payload is encrypted
+ * or decrypted.
+ */
+void knot_aead_stream_update_ad
+    (knot_aead_state_t *state, const unsigned char *ad,
+     unsigned long long adlen);
+
+/**
+ * \brief Encrypts more payload data with an incremental KNOT-AEAD state.
+ *
+ * \param state Incremental AEAD state to be updated.
+ * \param c Buffer to receive \a len bytes of ciphertext.
+ * \param m Points to the plaintext to be encrypted.
+ * \param len Number of bytes to be encrypted.
+ *
+ * \sa knot_aead_stream_encrypt_finalize()
+ */
+void knot_aead_stream_encrypt
+    (knot_aead_state_t *state, unsigned char *c,
+     const unsigned char *m, unsigned long long len);
+
+/**
+ * \brief Decrypts more payload data with an incremental KNOT-AEAD state.
+ *
+ * \param state Incremental AEAD state to be updated.
+ * \param m Buffer to receive \a len bytes of plaintext.
+ * \param c Points to the ciphertext to be decrypted.
+ * \param len Number of bytes to be decrypted.
+ *
+ * \sa knot_aead_stream_decrypt_finalize()
+ */
+void knot_aead_stream_decrypt
+    (knot_aead_state_t *state, unsigned char *m,
+     const unsigned char *c, unsigned long long len);
+
+/**
+ * \brief Finalizes an incremental KNOT-AEAD encryption operation.
+ *
+ * \param state Incremental AEAD state to be finalized.
+ * \param tag Buffer to receive the authentication tag, which is
+ * 16, 24, or 32 bytes in length depending upon the variant.
+ */
+void knot_aead_stream_encrypt_finalize
+    (knot_aead_state_t *state, unsigned char *tag);
+
+/**
+ * \brief Finalizes an incremental KNOT-AEAD decryption operation.
+ *
+ * \param state Incremental AEAD state to be finalized.
+ * \param tag Points to the 16, 24, or 32 byte authentication tag to be
+ * checked.
+ *
+ * \return 0 if the authentication tag is correct, or -1 otherwise.
+ * The plaintext that was returned by knot_aead_stream_decrypt() must
+ * be discarded if the authentication tag is incorrect.
+ */
+int knot_aead_stream_decrypt_finalize
+    (knot_aead_state_t *state, const unsigned char *tag);
+
 /**
  * \brief Hashes a block of input data with KNOT-HASH-256-256.
  *
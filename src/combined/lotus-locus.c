@@ -25,6 +25,23 @@
 #include "internal-util.h"
 #include <string.h>
 
+/**
+ * \brief Key context for LOTUS-AEAD and LOCUS-AEAD.
+ *
+ * The main key schedule is derived from the key XOR'ed with the nonce,
+ * so it cannot be cached.  Only the first half of Delta-N is cached,
+ * which is the encryption of the zero block under the key alone.
+ */
+typedef struct
+{
+    /** Raw key, for combining with the nonce */
+    unsigned char k[LOTUS_AEAD_KEY_SIZE];
+
+    /** Encryption of the zero block under the key with tweak 0 */
+    unsigned char L[GIFT64_BLOCK_SIZE];
+
+} lotus_locus_context_t;
+
 aead_cipher_t const lotus_aead_cipher = {
     "LOTUS-AEAD",
     LOTUS_AEAD_KEY_SIZE,
@@ -32,7 +49,13 @@ aead_cipher_t const lotus_aead_cipher = {
     LOTUS_AEAD_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN,
     lotus_aead_encrypt,
-    lotus_aead_decrypt
+    lotus_aead_decrypt,
+    sizeof(lotus_locus_context_t),
+    lotus_locus_aead_setup_key,
+    lotus_aead_encrypt_with_context,
+    lotus_aead_decrypt_with_context,
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_cipher_t const locus_aead_cipher = {
@@ -42,7 +65,13 @@ aead_cipher_t const locus_aead_cipher = {
     LOCUS_AEAD_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN,
     locus_aead_encrypt,
-    locus_aead_decrypt
+    locus_aead_decrypt,
+    sizeof(lotus_locus_context_t),
+    lotus_locus_aead_setup_key,
+    locus_aead_encrypt_with_context,
+    locus_aead_decrypt_with_context,
+    0, /* stream */
+    0  /* batch */
 };
 
 /**
@@ -65,7 +94,7 @@ STATIC_INLINE void lotus_or_locus_mul_2(gift64n_key_schedule_t *ks)
  *
  * \param ks Key schedule to initialize.
  * \param deltaN Delta-N value for the cipher state.
- * \param key Points to the 16-byte key for the cipher instance.
+ * \param ctx Points to the key context for the cipher instance.
  * \param nonce Points to the 16-byte key for the cipher instance.
  * \param T Points to a temporary buffer of LOTUS_AEAD_KEY_SIZE bytes
  * that will be destroyed during this function.
@@ -73,18 +102,26 @@ STATIC_INLINE void lotus_or_locus_mul_2(gift64n_key_schedule_t *ks)
 static void lotus_or_locus_init
     (gift64n_key_schedule_t *ks,
      unsigned char deltaN[GIFT64_BLOCK_SIZE],
-     const unsigned char *key,
+     const lotus_locus_context_t *ctx,
      const unsigned char *nonce,
      unsigned char *T)
 {
-    gift64n_init(ks, key);
-    memset(deltaN, 0, GIFT64_BLOCK_SIZE);
-    gift64t_encrypt(ks, deltaN, deltaN, GIFT64T_TWEAK_0);
-    lw_xor_block_2_src(T, key, nonce, LOTUS_AEAD_KEY_SIZE);
+    memcpy(deltaN, ctx->L, GIFT64_BLOCK_SIZE);
+    lw_xor_block_2_src(T, ctx->k, nonce, LOTUS_AEAD_KEY_SIZE);
     gift64n_init(ks, T);
     gift64t_encrypt(ks, deltaN, deltaN, GIFT64T_TWEAK_1);
 }
 
+void lotus_locus_aead_setup_key(void *ctx, const unsigned char *k)
+{
+    lotus_locus_context_t *context = (lotus_locus_context_t *)ctx;
+    gift64n_key_schedule_t ks;
+    gift64n_init(&ks, k);
+    memset(context->L, 0, GIFT64_BLOCK_SIZE);
+    gift64t_encrypt(&ks, context->L, context->L, GIFT64T_TWEAK_0);
+    memcpy(context->k, k, LOTUS_AEAD_KEY_SIZE);
+}
+
 /**
  * \brief Processes associated data for LOTUS-AEAD or LOCUS-AEAD.
  *
@@ -146,13 +183,13 @@ static void lotus_or_locus_gen_tag
     lw_xor_block_2_src(tag, W, deltaN, GIFT64_BLOCK_SIZE);
 }
 
-int lotus_aead_encrypt
+int lotus_aead_encrypt_with_context
     (unsigned char *c, unsigned long long *clen,
      const unsigned char *m, unsigned long long mlen,
      const unsigned char *ad, unsigned long long adlen,
      const unsigned char *nsec,
      const unsigned char *npub,
-     const unsigned char *k)
+     const void *ctx)
 {
     gift64n_key_schedule_t ks;
     unsigned char WV[GIFT64_BLOCK_SIZE * 2];
@@ -166,7 +203,8 @@ int lotus_aead_encrypt
     *clen = mlen + LOTUS_AEAD_TAG_SIZE;
 
     /* Initialize the state with the key and the nonce */
-    lotus_or_locus_init(&ks, deltaN, k, npub, WV);
+    lotus_or_locus_init
+        (&ks, deltaN, (const lotus_locus_context_t *)ctx, npub, WV);
     memset(WV, 0, sizeof(WV));
 
     /* Process the associated data */
@@ -227,13 +265,13 @@ int lotus_aead_encrypt
     return 0;
 }
 
-int lotus_aead_decrypt
+int lotus_aead_decrypt_with_context
     (unsigned char *m, unsigned long long *mlen,
      unsigned char *nsec,
      const unsigned char *c, unsigned long long clen,
      const unsigned char *ad, unsigned long long adlen,
      const unsigned char *npub,
-     const unsigned char *k)
+     const void *ctx)
 {
     gift64n_key_schedule_t ks;
     unsigned char WV[GIFT64_BLOCK_SIZE * 2];
@@ -250,7 +288,8 @@ int lotus_aead_decrypt
     *mlen = clen - LOTUS_AEAD_TAG_SIZE;
 
     /* Initialize the state with the key and the nonce */
-    lotus_or_locus_init(&ks, deltaN, k, npub, WV);
+    lotus_or_locus_init
+        (&ks, deltaN, (const lotus_locus_context_t *)ctx, npub, WV);
     memset(WV, 0, sizeof(WV));
 
     /* Process the associated data */
@@ -313,13 +352,13 @@ int lotus_aead_decrypt
     return aead_check_tag(mtemp, *mlen, WV, c, LOTUS_AEAD_TAG_SIZE);
 }
 
-int locus_aead_encrypt
+int locus_aead_encrypt_with_context
     (unsigned char *c, unsigned long long *clen,
      const unsigned char *m, unsigned long long mlen,
      const unsigned char *ad, unsigned long long adlen,
      const unsigned char *nsec,
      const unsigned char *npub,
-     const unsigned char *k)
+     const void *ctx)
 {
     gift64n_key_schedule_t ks;
     unsigned char WV[GIFT64_BLOCK_SIZE * 2];
@@ -332,7 +371,8 @@ int locus_aead_encrypt
     *clen = mlen + LOCUS_AEAD_TAG_SIZE;
 
     /* Initialize the state with the key and the nonce */
-    lotus_or_locus_init(&ks, deltaN, k, npub, WV);
+    lotus_or_locus_init
+        (&ks, deltaN, (const lotus_locus_context_t *)ctx, npub, WV);
     memset(WV, 0, sizeof(WV));
 
     /* Process the associated data */
@@ -372,13 +412,13 @@ int locus_aead_encrypt
     return 0;
 }
 
-int locus_aead_decrypt
+int locus_aead_decrypt_with_context
     (unsigned char *m, unsigned long long *mlen,
      unsigned char *nsec,
      const unsigned char *c, unsigned long long clen,
      const unsigned char *ad, unsigned long long adlen,
      const unsigned char *npub,
-     const unsigned char *k)
+     const void *ctx)
 {
     gift64n_key_schedule_t ks;
     unsigned char WV[GIFT64_BLOCK_SIZE * 2];
@@ -394,7 +434,8 @@ int locus_aead_decrypt
     *mlen = clen - LOCUS_AEAD_TAG_SIZE;
 
     /* Initialize the state with the key and the nonce */
-    lotus_or_locus_init(&ks, deltaN, k, npub, WV);
+    lotus_or_locus_init
+        (&ks, deltaN, (const lotus_locus_context_t *)ctx, npub, WV);
     memset(WV, 0, sizeof(WV));
 
     /* Process the associated data */
@@ -434,3 +475,59 @@ int locus_aead_decrypt
     lotus_or_locus_gen_tag(&ks, WV, deltaN, WV, WV + GIFT64_BLOCK_SIZE);
     return aead_check_tag(mtemp, *mlen, WV, c, LOCUS_AEAD_TAG_SIZE);
 }
+
+int lotus_aead_encrypt
+    (unsigned char *c, unsigned long long *clen,
+     const unsigned char *m, unsigned long long mlen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *nsec,
+     const unsigned char *npub,
+     const unsigned char *k)
+{
+    lotus_locus_context_t context;
+    lotus_locus_aead_setup_key(&context, k);
+    return lotus_aead_encrypt_with_context
+        (c, clen, m, mlen, ad, adlen, nsec, npub, &context);
+}
+
+int lotus_aead_decrypt
+    (unsigned char *m, unsigned long long *mlen,
+     unsigned char *nsec,
+     const unsigned char *c, unsigned long long clen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *npub,
+     const unsigned char *k)
+{
+    lotus_locus_context_t context;
+    lotus_locus_aead_setup_key(&context, k);
+    return lotus_aead_decrypt_with_context
+        (m, mlen, nsec, c, clen, ad, adlen, npub, &context);
+}
+
+int locus_aead_encrypt
+    (unsigned char *c, unsigned long long *clen,
+     const unsigned char *m, unsigned long long mlen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *nsec,
+     const unsigned char *npub,
+     const unsigned char *k)
+{
+    lotus_locus_context_t context;
+    lotus_locus_aead_setup_key(&context, k);
+    return locus_aead_encrypt_with_context
+        (c, clen, m, mlen, ad, adlen, nsec, npub, &context);
+}
+
+int locus_aead_decrypt
+    (unsigned char *m, unsigned long long *mlen,
+     unsigned char *nsec,
+     const unsigned char *c, unsigned long long clen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *npub,
+     const unsigned char *k)
+{
+    lotus_locus_context_t context;
+    lotus_locus_aead_setup_key(&context, k);
+    return locus_aead_decrypt_with_context
+        (m, mlen, nsec, c, clen, ad, adlen, npub, &context);
+}
@@ -32,7 +32,13 @@ aead_cipher_t const orange_zest_cipher = {
     ORANGE_ZEST_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN,
     orange_zest_aead_encrypt,
-    orange_zest_aead_decrypt
+    orange_zest_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_hash_algorithm_t const orangish_hash_algorithm = {
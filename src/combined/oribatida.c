@@ -51,7 +51,13 @@ aead_cipher_t const oribatida_256_cipher = {
     ORIBATIDA_256_TAG_SIZE,
     AEAD_FLAG_NONE,
     oribatida_256_aead_encrypt,
-    oribatida_256_aead_decrypt
+    oribatida_256_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_cipher_t const oribatida_192_cipher = {
@@ -61,7 +67,13 @@ aead_cipher_t const oribatida_192_cipher = {
     ORIBATIDA_192_TAG_SIZE,
     AEAD_FLAG_NONE,
     oribatida_192_aead_encrypt,
-    oribatida_192_aead_decrypt
+    oribatida_192_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 /* Definitions for domain separation values */
@@ -32,7 +32,13 @@ aead_cipher_t const photon_beetle_128_cipher = {
     PHOTON_BEETLE_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN,
     photon_beetle_128_aead_encrypt,
-    photon_beetle_128_aead_decrypt
+    photon_beetle_128_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_cipher_t const photon_beetle_32_cipher = {
@@ -42,7 +48,13 @@ aead_cipher_t const photon_beetle_32_cipher = {
     PHOTON_BEETLE_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN,
     photon_beetle_32_aead_encrypt,
-    photon_beetle_32_aead_decrypt
+    photon_beetle_32_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_hash_algorithm_t const photon_beetle_hash_algorithm = {
@@ -20,17 +20,24 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include "internal-masking.h"
 #include "pyjamask-masked.h"
 #include "internal-pyjamask-m.h"
 
 aead_cipher_t const pyjamask_masked_128_cipher = {
-    "Pyjamask-128-AEAD-Masked",
+    AEAD_MASKING_CIPHER_NAME("Pyjamask-128-AEAD-Masked"),
     PYJAMASK_128_MASKED_KEY_SIZE,
     PYJAMASK_128_MASKED_NONCE_SIZE,
     PYJAMASK_128_MASKED_TAG_SIZE,
     AEAD_FLAG_SC_PROTECT_ALL,
     pyjamask_masked_128_aead_encrypt,
-    pyjamask_masked_128_aead_decrypt
+    pyjamask_masked_128_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 #define OCB_ALG_NAME pyjamask_masked_128
@@ -23,16 +23,6 @@
 #include "pyjamask.h"
 #include "internal-pyjamask.h"
 
-aead_cipher_t const pyjamask_128_cipher = {
-    "Pyjamask-128-AEAD",
-    PYJAMASK_128_KEY_SIZE,
-    PYJAMASK_128_NONCE_SIZE,
-    PYJAMASK_128_TAG_SIZE,
-    AEAD_FLAG_NONE,
-    pyjamask_128_aead_encrypt,
-    pyjamask_128_aead_decrypt
-};
-
 #define OCB_ALG_NAME pyjamask_128
 #define OCB_BLOCK_SIZE 16
 #define OCB_NONCE_SIZE PYJAMASK_128_NONCE_SIZE
@@ -41,4 +31,24 @@ aead_cipher_t const pyjamask_128_cipher = {
 #define OCB_SETUP_KEY pyjamask_128_setup_key
 #define OCB_ENCRYPT_BLOCK pyjamask_128_encrypt
 #define OCB_DECRYPT_BLOCK pyjamask_128_decrypt
+#define OCB_ENCRYPT_BLOCKS pyjamask_128_encrypt_blocks
+#define OCB_DECRYPT_BLOCKS pyjamask_128_decrypt_blocks
+#define OCB_PARALLEL_BLOCKS PYJAMASK_MAX_LANES
+#define OCB_KEY_CONTEXT 1
 #include "internal-ocb.h"
+
+aead_cipher_t const pyjamask_128_cipher = {
+    "Pyjamask-128-AEAD",
+    PYJAMASK_128_KEY_SIZE,
+    PYJAMASK_128_NONCE_SIZE,
+    PYJAMASK_128_TAG_SIZE,
+    AEAD_FLAG_NONE,
+    pyjamask_128_aead_encrypt,
+    pyjamask_128_aead_decrypt,
+    sizeof(pyjamask_128_state_t),
+    pyjamask_128_aead_setup_key,
+    pyjamask_128_aead_encrypt_with_context,
+    pyjamask_128_aead_decrypt_with_context,
+    0, /* stream */
+    0  /* batch */
+};
@@ -23,16 +23,6 @@
 #include "pyjamask.h"
 #include "internal-pyjamask.h"
 
-aead_cipher_t const pyjamask_96_cipher = {
-    "Pyjamask-96-AEAD",
-    PYJAMASK_96_KEY_SIZE,
-    PYJAMASK_96_NONCE_SIZE,
-    PYJAMASK_96_TAG_SIZE,
-    AEAD_FLAG_NONE,
-    pyjamask_96_aead_encrypt,
-    pyjamask_96_aead_decrypt
-};
-
 #define OCB_ALG_NAME pyjamask_96
 #define OCB_BLOCK_SIZE 12
 #define OCB_NONCE_SIZE PYJAMASK_96_NONCE_SIZE
@@ -41,4 +31,24 @@ aead_cipher_t const pyjamask_96_cipher = {
 #define OCB_SETUP_KEY pyjamask_96_setup_key
 #define OCB_ENCRYPT_BLOCK pyjamask_96_encrypt
 #define OCB_DECRYPT_BLOCK pyjamask_96_decrypt
+#define OCB_ENCRYPT_BLOCKS pyjamask_96_encrypt_blocks
+#define OCB_DECRYPT_BLOCKS pyjamask_96_decrypt_blocks
+#define OCB_PARALLEL_BLOCKS PYJAMASK_MAX_LANES
+#define OCB_KEY_CONTEXT 1
 #include "internal-ocb.h"
+
+aead_cipher_t const pyjamask_96_cipher = {
+    "Pyjamask-96-AEAD",
+    PYJAMASK_96_KEY_SIZE,
+    PYJAMASK_96_NONCE_SIZE,
+    PYJAMASK_96_TAG_SIZE,
+    AEAD_FLAG_NONE,
+    pyjamask_96_aead_encrypt,
+    pyjamask_96_aead_decrypt,
+    sizeof(pyjamask_96_state_t),
+    pyjamask_96_aead_setup_key,
+    pyjamask_96_aead_encrypt_with_context,
+    pyjamask_96_aead_decrypt_with_context,
+    0, /* stream */
+    0  /* batch */
+};
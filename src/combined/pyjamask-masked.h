@@ -77,11 +77,47 @@ extern "C" {
  */
 extern aead_cipher_t const pyjamask_masked_128_cipher;
 
+/**
+ * \brief Meta-information block for Pyjamask-128-AEAD-Masked cipher with
+ * 2 shares.
+ */
+extern aead_cipher_t const pyjamask_masked_128_cipher_x2;
+
+/**
+ * \brief Meta-information block for Pyjamask-128-AEAD-Masked cipher with
+ * 3 shares.
+ */
+extern aead_cipher_t const pyjamask_masked_128_cipher_x3;
+
+/**
+ * \brief Meta-information block for Pyjamask-128-AEAD-Masked cipher with
+ * 4 shares.
+ */
+extern aead_cipher_t const pyjamask_masked_128_cipher_x4;
+
 /**
  * \brief Meta-information block for Pyjamask-96-AEAD-Masked cipher.
  */
 extern aead_cipher_t const pyjamask_masked_96_cipher;
 
+/**
+ * \brief Meta-information block for Pyjamask-96-AEAD-Masked cipher with
+ * 2 shares.
+ */
+extern aead_cipher_t const pyjamask_masked_96_cipher_x2;
+
+/**
+ * \brief Meta-information block for Pyjamask-96-AEAD-Masked cipher with
+ * 3 shares.
+ */
+extern aead_cipher_t const pyjamask_masked_96_cipher_x3;
+
+/**
+ * \brief Meta-information block for Pyjamask-96-AEAD-Masked cipher with
+ * 4 shares.
+ */
+extern aead_cipher_t const pyjamask_masked_96_cipher_x4;
+
 /**
  * \brief Encrypts and authenticates a packet with Pyjamask-128-AEAD-Masked.
  *
@@ -25,6 +25,41 @@
 #include "internal-util.h"
 #include <string.h>
 
+/**
+ * \brief Key context for Romulus-N1 and Romulus-M1.
+ *
+ * The nonce is part of the tweakey, so only the nonce-less key schedule
+ * can be cached.  The raw key is kept to re-derive the schedule once the
+ * nonce is known.
+ */
+typedef struct
+{
+    /** Key schedule for the key and no nonce */
+    skinny_128_384_key_schedule_t ks;
+
+    /** Raw key, for re-initializing the key schedule with a nonce */
+    unsigned char k[ROMULUS_KEY_SIZE];
+
+} romulus1_context_t;
+
+/**
+ * \brief Key context for Romulus-N2 and Romulus-M2.
+ */
+typedef romulus1_context_t romulus2_context_t;
+
+/**
+ * \brief Key context for Romulus-N3 and Romulus-M3.
+ *
+ * The nonce only occupies TK1, which is not expanded into the key
+ * schedule, so the nonce can be inserted into a copy of the cached schedule.
+ */
+typedef struct
+{
+    /** Key schedule for the key and no nonce */
+    skinny_128_256_key_schedule_t ks;
+
+} romulus3_context_t;
+
 aead_cipher_t const romulus_n1_cipher = {
     "Romulus-N1",
     ROMULUS_KEY_SIZE,
@@ -32,7 +67,13 @@ aead_cipher_t const romulus_n1_cipher = {
     ROMULUS_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN,
     romulus_n1_aead_encrypt,
-    romulus_n1_aead_decrypt
+    romulus_n1_aead_decrypt,
+    sizeof(romulus1_context_t),
+    romulus1_aead_setup_key,
+    romulus_n1_aead_encrypt_with_context,
+    romulus_n1_aead_decrypt_with_context,
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_cipher_t const romulus_n2_cipher = {
@@ -42,7 +83,13 @@ aead_cipher_t const romulus_n2_cipher = {
     ROMULUS_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN,
     romulus_n2_aead_encrypt,
-    romulus_n2_aead_decrypt
+    romulus_n2_aead_decrypt,
+    sizeof(romulus2_context_t),
+    romulus2_aead_setup_key,
+    romulus_n2_aead_encrypt_with_context,
+    romulus_n2_aead_decrypt_with_context,
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_cipher_t const romulus_n3_cipher = {
@@ -52,7 +99,13 @@ aead_cipher_t const romulus_n3_cipher = {
     ROMULUS_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN,
     romulus_n3_aead_encrypt,
-    romulus_n3_aead_decrypt
+    romulus_n3_aead_decrypt,
+    sizeof(romulus3_context_t),
+    romulus3_aead_setup_key,
+    romulus_n3_aead_encrypt_with_context,
+    romulus_n3_aead_decrypt_with_context,
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_cipher_t const romulus_m1_cipher = {
@@ -62,7 +115,13 @@ aead_cipher_t const romulus_m1_cipher = {
     ROMULUS_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN,
     romulus_m1_aead_encrypt,
-    romulus_m1_aead_decrypt
+    romulus_m1_aead_decrypt,
+    sizeof(romulus1_context_t),
+    romulus1_aead_setup_key,
+    romulus_m1_aead_encrypt_with_context,
+    romulus_m1_aead_decrypt_with_context,
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_cipher_t const romulus_m2_cipher = {
@@ -72,7 +131,13 @@ aead_cipher_t const romulus_m2_cipher = {
     ROMULUS_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN,
     romulus_m2_aead_encrypt,
-    romulus_m2_aead_decrypt
+    romulus_m2_aead_decrypt,
+    sizeof(romulus2_context_t),
+    romulus2_aead_setup_key,
+    romulus_m2_aead_encrypt_with_context,
+    romulus_m2_aead_decrypt_with_context,
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_cipher_t const romulus_m3_cipher = {
@@ -82,7 +147,13 @@ aead_cipher_t const romulus_m3_cipher = {
     ROMULUS_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN,
     romulus_m3_aead_encrypt,
-    romulus_m3_aead_decrypt
+    romulus_m3_aead_decrypt,
+    sizeof(romulus3_context_t),
+    romulus3_aead_setup_key,
+    romulus_m3_aead_encrypt_with_context,
+    romulus_m3_aead_decrypt_with_context,
+    0, /* stream */
+    0  /* batch */
 };
 
 /**
@@ -1478,14 +1549,35 @@ STATIC_INLINE void romulus_generate_tag
     }
 }
 
-int romulus_n1_aead_encrypt
+void romulus1_aead_setup_key(void *ctx, const unsigned char *k)
+{
+    romulus1_context_t *context = (romulus1_context_t *)ctx;
+    romulus1_init(&(context->ks), k, 0);
+    memcpy(context->k, k, ROMULUS_KEY_SIZE);
+}
+
+void romulus2_aead_setup_key(void *ctx, const unsigned char *k)
+{
+    romulus2_context_t *context = (romulus2_context_t *)ctx;
+    romulus2_init(&(context->ks), k, 0);
+    memcpy(context->k, k, ROMULUS_KEY_SIZE);
+}
+
+void romulus3_aead_setup_key(void *ctx, const unsigned char *k)
+{
+    romulus3_context_t *context = (romulus3_context_t *)ctx;
+    romulus3_init(&(context->ks), k, 0);
+}
+
+int romulus_n1_aead_encrypt_with_context
     (unsigned char *c, unsigned long long *clen,
      const unsigned char *m, unsigned long long mlen,
      const unsigned char *ad, unsigned long long adlen,
      const unsigned char *nsec,
      const unsigned char *npub,
-     const unsigned char *k)
+     const void *ctx)
 {
+    const romulus1_context_t *context = (const romulus1_context_t *)ctx;
     skinny_128_384_key_schedule_t ks;
     unsigned char S[16];
     (void)nsec;
@@ -1497,16 +1589,16 @@ int romulus_n1_aead_encrypt
     if (adlen > ROMULUS_DATA_LIMIT || mlen > ROMULUS_DATA_LIMIT)
         return -2;
 
-    /* Initialize the key schedule with the key and no nonce.  Associated
-     * data processing varies the nonce from block to block */
-    romulus1_init(&ks, k, 0);
+    /* Start with the cached key schedule for the key and no nonce.
+     * Associated data processing varies the nonce from block to block */
+    memcpy(&ks, &(context->ks), sizeof(ks));
 
     /* Process the associated data */
     memset(S, 0, sizeof(S));
     romulus_n1_process_ad(&ks, S, npub, ad, adlen);
 
     /* Re-initialize the key schedule with the key and nonce */
-    romulus1_init(&ks, k, npub);
+    romulus1_init(&ks, context->k, npub);
 
     /* Encrypts the plaintext to produce the ciphertext */
     romulus_n1_encrypt(&ks, S, c, m, mlen);
@@ -1516,14 +1608,15 @@ int romulus_n1_aead_encrypt
     return 0;
 }
 
-int romulus_n1_aead_decrypt
+int romulus_n1_aead_decrypt_with_context
     (unsigned char *m, unsigned long long *mlen,
      unsigned char *nsec,
      const unsigned char *c, unsigned long long clen,
      const unsigned char *ad, unsigned long long adlen,
      const unsigned char *npub,
-     const unsigned char *k)
+     const void *ctx)
 {
+    const romulus1_context_t *context = (const romulus1_context_t *)ctx;
     skinny_128_384_key_schedule_t ks;
     unsigned char S[16];
     (void)nsec;
@@ -1538,16 +1631,16 @@ int romulus_n1_aead_decrypt
             clen > (ROMULUS_DATA_LIMIT + ROMULUS_TAG_SIZE))
         return -2;
 
-    /* Initialize the key schedule with the key and no nonce.  Associated
-     * data processing varies the nonce from block to block */
-    romulus1_init(&ks, k, 0);
+    /* Start with the cached key schedule for the key and no nonce.
+     * Associated data processing varies the nonce from block to block */
+    memcpy(&ks, &(context->ks), sizeof(ks));
 
     /* Process the associated data */
     memset(S, 0, sizeof(S));
     romulus_n1_process_ad(&ks, S, npub, ad, adlen);
 
     /* Re-initialize the key schedule with the key and nonce */
-    romulus1_init(&ks, k, npub);
+    romulus1_init(&ks, context->k, npub);
 
     /* Decrypt the ciphertext to produce the plaintext */
     clen -= ROMULUS_TAG_SIZE;
@@ -1558,14 +1651,15 @@ int romulus_n1_aead_decrypt
     return aead_check_tag(m, clen, S, c + clen, ROMULUS_TAG_SIZE);
 }
 
-int romulus_n2_aead_encrypt
+int romulus_n2_aead_encrypt_with_context
     (unsigned char *c, unsigned long long *clen,
      const unsigned char *m, unsigned long long mlen,
      const unsigned char *ad, unsigned long long adlen,
      const unsigned char *nsec,
      const unsigned char *npub,
-     const unsigned char *k)
+     const void *ctx)
 {
+    const romulus2_context_t *context = (const romulus2_context_t *)ctx;
     skinny_128_384_key_schedule_t ks;
     unsigned char S[16];
     (void)nsec;
@@ -1577,16 +1671,16 @@ int romulus_n2_aead_encrypt
     if (adlen > ROMULUS_DATA_LIMIT || mlen > ROMULUS_DATA_LIMIT)
         return -2;
 
-    /* Initialize the key schedule with the key and no nonce.  Associated
-     * data processing varies the nonce from block to block */
-    romulus2_init(&ks, k, 0);
+    /* Start with the cached key schedule for the key and no nonce.
+     * Associated data processing varies the nonce from block to block */
+    memcpy(&ks, &(context->ks), sizeof(ks));
 
     /* Process the associated data */
     memset(S, 0, sizeof(S));
     romulus_n2_process_ad(&ks, S, npub, ad, adlen);
 
     /* Re-initialize the key schedule with the key and nonce */
-    romulus2_init(&ks, k, npub);
+    romulus2_init(&ks, context->k, npub);
 
     /* Encrypts the plaintext to produce the ciphertext */
     romulus_n2_encrypt(&ks, S, c, m, mlen);
@@ -1596,14 +1690,15 @@ int romulus_n2_aead_encrypt
     return 0;
 }
 
-int romulus_n2_aead_decrypt
+int romulus_n2_aead_decrypt_with_context
     (unsigned char *m, unsigned long long *mlen,
      unsigned char *nsec,
      const unsigned char *c, unsigned long long clen,
      const unsigned char *ad, unsigned long long adlen,
      const unsigned char *npub,
-     const unsigned char *k)
+     const void *ctx)
 {
+    const romulus2_context_t *context = (const romulus2_context_t *)ctx;
     skinny_128_384_key_schedule_t ks;
     unsigned char S[16];
     (void)nsec;
@@ -1618,16 +1713,16 @@ int romulus_n2_aead_decrypt
             clen > (ROMULUS_DATA_LIMIT + ROMULUS_TAG_SIZE))
         return -2;
 
-    /* Initialize the key schedule with the key and no nonce.  Associated
-     * data processing varies the nonce from block to block */
-    romulus2_init(&ks, k, 0);
+    /* Start with the cached key schedule for the key and no nonce.
+     * Associated data processing varies the nonce from block to block */
+    memcpy(&ks, &(context->ks), sizeof(ks));
 
     /* Process the associated data */
     memset(S, 0, sizeof(S));
     romulus_n2_process_ad(&ks, S, npub, ad, adlen);
 
     /* Re-initialize the key schedule with the key and nonce */
-    romulus2_init(&ks, k, npub);
+    romulus2_init(&ks, context->k, npub);
 
     /* Decrypt the ciphertext to produce the plaintext */
     clen -= ROMULUS_TAG_SIZE;
@@ -1638,14 +1733,15 @@ int romulus_n2_aead_decrypt
     return aead_check_tag(m, clen, S, c + clen, ROMULUS_TAG_SIZE);
 }
 
-int romulus_n3_aead_encrypt
+int romulus_n3_aead_encrypt_with_context
     (unsigned char *c, unsigned long long *clen,
      const unsigned char *m, unsigned long long mlen,
      const unsigned char *ad, unsigned long long adlen,
      const unsigned char *nsec,
      const unsigned char *npub,
-     const unsigned char *k)
+     const void *ctx)
 {
+    const romulus3_context_t *context = (const romulus3_context_t *)ctx;
     skinny_128_256_key_schedule_t ks;
     unsigned char S[16];
     (void)nsec;
@@ -1657,16 +1753,17 @@ int romulus_n3_aead_encrypt
     if (adlen > ROMULUS_DATA_LIMIT || mlen > ROMULUS_DATA_LIMIT)
         return -2;
 
-    /* Initialize the key schedule with the key and no nonce.  Associated
-     * data processing varies the nonce from block to block */
-    romulus3_init(&ks, k, 0);
+    /* Start with the cached key schedule for the key and no nonce.
+     * Associated data processing varies the nonce from block to block */
+    memcpy(&ks, &(context->ks), sizeof(ks));
 
     /* Process the associated data */
     memset(S, 0, sizeof(S));
     romulus_n3_process_ad(&ks, S, npub, ad, adlen);
 
-    /* Re-initialize the key schedule with the key and nonce */
-    romulus3_init(&ks, k, npub);
+    /* Reload the cached key schedule and insert the nonce into TK1 */
+    memcpy(&ks, &(context->ks), sizeof(ks));
+    memcpy(ks.TK1 + 4, npub, 12);
 
     /* Encrypts the plaintext to produce the ciphertext */
     romulus_n3_encrypt(&ks, S, c, m, mlen);
@@ -1676,14 +1773,15 @@ int romulus_n3_aead_encrypt
     return 0;
 }
 
-int romulus_n3_aead_decrypt
+int romulus_n3_aead_decrypt_with_context
     (unsigned char *m, unsigned long long *mlen,
      unsigned char *nsec,
      const unsigned char *c, unsigned long long clen,
      const unsigned char *ad, unsigned long long adlen,
      const unsigned char *npub,
-     const unsigned char *k)
+     const void *ctx)
 {
+    const romulus3_context_t *context = (const romulus3_context_t *)ctx;
     skinny_128_256_key_schedule_t ks;
     unsigned char S[16];
     (void)nsec;
@@ -1698,16 +1796,17 @@ int romulus_n3_aead_decrypt
             clen > (ROMULUS_DATA_LIMIT + ROMULUS_TAG_SIZE))
         return -2;
 
-    /* Initialize the key schedule with the key and no nonce.  Associated
-     * data processing varies the nonce from block to block */
-    romulus3_init(&ks, k, 0);
+    /* Start with the cached key schedule for the key and no nonce.
+     * Associated data processing varies the nonce from block to block */
+    memcpy(&ks, &(context->ks), sizeof(ks));
 
     /* Process the associated data */
     memset(S, 0, sizeof(S));
     romulus_n3_process_ad(&ks, S, npub, ad, adlen);
 
-    /* Re-initialize the key schedule with the key and nonce */
-    romulus3_init(&ks, k, npub);
+    /* Reload the cached key schedule and insert the nonce into TK1 */
+    memcpy(&ks, &(context->ks), sizeof(ks));
+    memcpy(ks.TK1 + 4, npub, 12);
 
     /* Decrypt the ciphertext to produce the plaintext */
     clen -= ROMULUS_TAG_SIZE;
@@ -1718,14 +1817,15 @@ int romulus_n3_aead_decrypt
     return aead_check_tag(m, clen, S, c + clen, ROMULUS_TAG_SIZE);
 }
 
-int romulus_m1_aead_encrypt
+int romulus_m1_aead_encrypt_with_context
     (unsigned char *c, unsigned long long *clen,
      const unsigned char *m, unsigned long long mlen,
      const unsigned char *ad, unsigned long long adlen,
      const unsigned char *nsec,
      const unsigned char *npub,
-     const unsigned char *k)
+     const void *ctx)
 {
+    const romulus1_context_t *context = (const romulus1_context_t *)ctx;
     skinny_128_384_key_schedule_t ks;
     unsigned char S[16];
     (void)nsec;
@@ -1737,9 +1837,9 @@ int romulus_m1_aead_encrypt
     if (adlen > ROMULUS_DATA_LIMIT || mlen > ROMULUS_DATA_LIMIT)
         return -2;
 
-    /* Initialize the key schedule with the key and no nonce.  Associated
-     * data processing varies the nonce from block to block */
-    romulus1_init(&ks, k, 0);
+    /* Start with the cached key schedule for the key and no nonce.
+     * Associated data processing varies the nonce from block to block */
+    memcpy(&ks, &(context->ks), sizeof(ks));
 
     /* Process the associated data and the plaintext message */
     memset(S, 0, sizeof(S));
@@ -1751,21 +1851,22 @@ int romulus_m1_aead_encrypt
     memcpy(c + mlen, S, ROMULUS_TAG_SIZE);
 
     /* Re-initialize the key schedule with the key and nonce */
-    romulus1_init(&ks, k, npub);
+    romulus1_init(&ks, context->k, npub);
 
     /* Encrypt the plaintext to produce the ciphertext */
     romulus_m1_encrypt(&ks, S, c, m, mlen);
     return 0;
 }
 
-int romulus_m1_aead_decrypt
+int romulus_m1_aead_decrypt_with_context
     (unsigned char *m, unsigned long long *mlen,
      unsigned char *nsec,
      const unsigned char *c, unsigned long long clen,
      const unsigned char *ad, unsigned long long adlen,
      const unsigned char *npub,
-     const unsigned char *k)
+     const void *ctx)
 {
+    const romulus1_context_t *context = (const romulus1_context_t *)ctx;
     skinny_128_384_key_schedule_t ks;
     unsigned char S[16];
     (void)nsec;
@@ -1781,7 +1882,7 @@ int romulus_m1_aead_decrypt
         return -2;
 
     /* Initialize the key schedule with the key and nonce */
-    romulus1_init(&ks, k, npub);
+    romulus1_init(&ks, context->k, npub);
 
     /* Decrypt the ciphertext to produce the plaintext, using the
      * authentication tag as the initialization vector for decryption */
@@ -1789,9 +1890,9 @@ int romulus_m1_aead_decrypt
     memcpy(S, c + clen, ROMULUS_TAG_SIZE);
     romulus_m1_decrypt(&ks, S, m, c, clen);
 
-    /* Re-initialize the key schedule with the key and no nonce.  Associated
-     * data processing varies the nonce from block to block */
-    romulus1_init(&ks, k, 0);
+    /* Reload the cached key schedule for the key and no nonce.
+     * Associated data processing varies the nonce from block to block */
+    memcpy(&ks, &(context->ks), sizeof(ks));
 
     /* Process the associated data */
     memset(S, 0, sizeof(S));
@@ -1802,14 +1903,15 @@ int romulus_m1_aead_decrypt
     return aead_check_tag(m, clen, S, c + clen, ROMULUS_TAG_SIZE);
 }
 
-int romulus_m2_aead_encrypt
+int romulus_m2_aead_encrypt_with_context
     (unsigned char *c, unsigned long long *clen,
      const unsigned char *m, unsigned long long mlen,
      const unsigned char *ad, unsigned long long adlen,
      const unsigned char *nsec,
      const unsigned char *npub,
-     const unsigned char *k)
+     const void *ctx)
 {
+    const romulus2_context_t *context = (const romulus2_context_t *)ctx;
     skinny_128_384_key_schedule_t ks;
     unsigned char S[16];
     (void)nsec;
@@ -1821,9 +1923,9 @@ int romulus_m2_aead_encrypt
     if (adlen > ROMULUS_DATA_LIMIT || mlen > ROMULUS_DATA_LIMIT)
         return -2;
 
-    /* Initialize the key schedule with the key and no nonce.  Associated
-     * data processing varies the nonce from block to block */
-    romulus2_init(&ks, k, 0);
+    /* Start with the cached key schedule for the key and no nonce.
+     * Associated data processing varies the nonce from block to block */
+    memcpy(&ks, &(context->ks), sizeof(ks));
 
     /* Process the associated data and the plaintext message */
     memset(S, 0, sizeof(S));
@@ -1835,21 +1937,22 @@ int romulus_m2_aead_encrypt
     memcpy(c + mlen, S, ROMULUS_TAG_SIZE);
 
     /* Re-initialize the key schedule with the key and nonce */
-    romulus2_init(&ks, k, npub);
+    romulus2_init(&ks, context->k, npub);
 
     /* Encrypt the plaintext to produce the ciphertext */
     romulus_m2_encrypt(&ks, S, c, m, mlen);
     return 0;
 }
 
-int romulus_m2_aead_decrypt
+int romulus_m2_aead_decrypt_with_context
     (unsigned char *m, unsigned long long *mlen,
      unsigned char *nsec,
      const unsigned char *c, unsigned long long clen,
      const unsigned char *ad, unsigned long long adlen,
      const unsigned char *npub,
-     const unsigned char *k)
+     const void *ctx)
 {
+    const romulus2_context_t *context = (const romulus2_context_t *)ctx;
     skinny_128_384_key_schedule_t ks;
     unsigned char S[16];
     (void)nsec;
@@ -1865,7 +1968,7 @@ int romulus_m2_aead_decrypt
         return -2;
 
     /* Initialize the key schedule with the key and nonce */
-    romulus2_init(&ks, k, npub);
+    romulus2_init(&ks, context->k, npub);
 
     /* Decrypt the ciphertext to produce the plaintext, using the
      * authentication tag as the initialization vector for decryption */
@@ -1873,9 +1976,9 @@ int romulus_m2_aead_decrypt
     memcpy(S, c + clen, ROMULUS_TAG_SIZE);
     romulus_m2_decrypt(&ks, S, m, c, clen);
 
-    /* Re-initialize the key schedule with the key and no nonce.  Associated
-     * data processing varies the nonce from block to block */
-    romulus2_init(&ks, k, 0);
+    /* Reload the cached key schedule for the key and no nonce.
+     * Associated data processing varies the nonce from block to block */
+    memcpy(&ks, &(context->ks), sizeof(ks));
 
     /* Process the associated data */
     memset(S, 0, sizeof(S));
@@ -1886,14 +1989,15 @@ int romulus_m2_aead_decrypt
     return aead_check_tag(m, clen, S, c + clen, ROMULUS_TAG_SIZE);
 }
 
-int romulus_m3_aead_encrypt
+int romulus_m3_aead_encrypt_with_context
     (unsigned char *c, unsigned long long *clen,
      const unsigned char *m, unsigned long long mlen,
      const unsigned char *ad, unsigned long long adlen,
      const unsigned char *nsec,
      const unsigned char *npub,
-     const unsigned char *k)
+     const void *ctx)
 {
+    const romulus3_context_t *context = (const romulus3_context_t *)ctx;
     skinny_128_256_key_schedule_t ks;
     unsigned char S[16];
     (void)nsec;
@@ -1905,12 +2009,9 @@ int romulus_m3_aead_encrypt
     if (adlen > ROMULUS_DATA_LIMIT || mlen > ROMULUS_DATA_LIMIT)
         return -2;
 
-    /* Initialize the key schedule with the key and nonce */
-    romulus3_init(&ks, k, npub);
-
-    /* Initialize the key schedule with the key and no nonce.  Associated
-     * data processing varies the nonce from block to block */
-    romulus3_init(&ks, k, 0);
+    /* Start with the cached key schedule for the key and no nonce.
+     * Associated data processing varies the nonce from block to block */
+    memcpy(&ks, &(context->ks), sizeof(ks));
 
     /* Process the associated data and the plaintext message */
     memset(S, 0, sizeof(S));
@@ -1921,22 +2022,24 @@ int romulus_m3_aead_encrypt
     romulus_generate_tag(S, S);
     memcpy(c + mlen, S, ROMULUS_TAG_SIZE);
 
-    /* Re-initialize the key schedule with the key and nonce */
-    romulus3_init(&ks, k, npub);
+    /* Reload the cached key schedule and insert the nonce into TK1 */
+    memcpy(&ks, &(context->ks), sizeof(ks));
+    memcpy(ks.TK1 + 4, npub, 12);
 
     /* Encrypt the plaintext to produce the ciphertext */
     romulus_m3_encrypt(&ks, S, c, m, mlen);
     return 0;
 }
 
-int romulus_m3_aead_decrypt
+int romulus_m3_aead_decrypt_with_context
     (unsigned char *m, unsigned long long *mlen,
      unsigned char *nsec,
      const unsigned char *c, unsigned long long clen,
      const unsigned char *ad, unsigned long long adlen,
      const unsigned char *npub,
-     const unsigned char *k)
+     const void *ctx)
 {
+    const romulus3_context_t *context = (const romulus3_context_t *)ctx;
     skinny_128_256_key_schedule_t ks;
     unsigned char S[16];
     (void)nsec;
@@ -1951,8 +2054,9 @@ int romulus_m3_aead_decrypt
             clen > (ROMULUS_DATA_LIMIT + ROMULUS_TAG_SIZE))
         return -2;
 
-    /* Initialize the key schedule with the key and nonce */
-    romulus3_init(&ks, k, npub);
+    /* Start with the cached key schedule and insert the nonce into TK1 */
+    memcpy(&ks, &(context->ks), sizeof(ks));
+    memcpy(ks.TK1 + 4, npub, 12);
 
     /* Decrypt the ciphertext to produce the plaintext, using the
      * authentication tag as the initialization vector for decryption */
@@ -1960,9 +2064,9 @@ int romulus_m3_aead_decrypt
     memcpy(S, c + clen, ROMULUS_TAG_SIZE);
     romulus_m3_decrypt(&ks, S, m, c, clen);
 
-    /* Re-initialize the key schedule with the key and no nonce.  Associated
-     * data processing varies the nonce from block to block */
-    romulus3_init(&ks, k, 0);
+    /* Reload the cached key schedule for the key and no nonce.
+     * Associated data processing varies the nonce from block to block */
+    memcpy(&ks, &(context->ks), sizeof(ks));
 
     /* Process the associated data */
     memset(S, 0, sizeof(S));
@@ -1972,3 +2076,171 @@ int romulus_m3_aead_decrypt
     romulus_generate_tag(S, S);
     return aead_check_tag(m, clen, S, c + clen, ROMULUS_TAG_SIZE);
 }
+
+int romulus_n1_aead_encrypt
+    (unsigned char *c, unsigned long long *clen,
+     const unsigned char *m, unsigned long long mlen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *nsec,
+     const unsigned char *npub,
+     const unsigned char *k)
+{
+    romulus1_context_t context;
+    romulus1_aead_setup_key(&context, k);
+    return romulus_n1_aead_encrypt_with_context
+        (c, clen, m, mlen, ad, adlen, nsec, npub, &context);
+}
+
+int romulus_n1_aead_decrypt
+    (unsigned char *m, unsigned long long *mlen,
+     unsigned char *nsec,
+     const unsigned char *c, unsigned long long clen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *npub,
+     const unsigned char *k)
+{
+    romulus1_context_t context;
+    romulus1_aead_setup_key(&context, k);
+    return romulus_n1_aead_decrypt_with_context
+        (m, mlen, nsec, c, clen, ad, adlen, npub, &context);
+}
+
+int romulus_n2_aead_encrypt
+    (unsigned char *c, unsigned long long *clen,
+     const unsigned char *m, unsigned long long mlen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *nsec,
+     const unsigned char *npub,
+     const unsigned char *k)
+{
+    romulus2_context_t context;
+    romulus2_aead_setup_key(&context, k);
+    return romulus_n2_aead_encrypt_with_context
+        (c, clen, m, mlen, ad, adlen, nsec, npub, &context);
+}
+
+int romulus_n2_aead_decrypt
+    (unsigned char *m, unsigned long long *mlen,
+     unsigned char *nsec,
+     const unsigned char *c, unsigned long long clen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *npub,
+     const unsigned char *k)
+{
+    romulus2_context_t context;
+    romulus2_aead_setup_key(&context, k);
+    return romulus_n2_aead_decrypt_with_context
+        (m, mlen, nsec, c, clen, ad, adlen, npub, &context);
+}
+
+int romulus_n3_aead_encrypt
+    (unsigned char *c, unsigned long long *clen,
+     const unsigned char *m, unsigned long long mlen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *nsec,
+     const unsigned char *npub,
+     const unsigned char *k)
+{
+    romulus3_context_t context;
+    romulus3_aead_setup_key(&context, k);
+    return romulus_n3_aead_encrypt_with_context
+        (c, clen, m, mlen, ad, adlen, nsec, npub, &context);
+}
+
+int romulus_n3_aead_decrypt
+    (unsigned char *m, unsigned long long *mlen,
+     unsigned char *nsec,
+     const unsigned char *c, unsigned long long clen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *npub,
+     const unsigned char *k)
+{
+    romulus3_context_t context;
+    romulus3_aead_setup_key(&context, k);
+    return romulus_n3_aead_decrypt_with_context
+        (m, mlen, nsec, c, clen, ad, adlen, npub, &context);
+}
+
+int romulus_m1_aead_encrypt
+    (unsigned char *c, unsigned long long *clen,
+     const unsigned char *m, unsigned long long mlen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *nsec,
+     const unsigned char *npub,
+     const unsigned char *k)
+{
+    romulus1_context_t context;
+    romulus1_aead_setup_key(&context, k);
+    return romulus_m1_aead_encrypt_with_context
+        (c, clen, m, mlen, ad, adlen, nsec, npub, &context);
+}
+
+int romulus_m1_aead_decrypt
+    (unsigned char *m, unsigned long long *mlen,
+     unsigned char *nsec,
+     const unsigned char *c, unsigned long long clen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *npub,
+     const unsigned char *k)
+{
+    romulus1_context_t context;
+    romulus1_aead_setup_key(&context, k);
+    return romulus_m1_aead_decrypt_with_context
+        (m, mlen, nsec, c, clen, ad, adlen, npub, &context);
+}
+
+int romulus_m2_aead_encrypt
+    (unsigned char *c, unsigned long long *clen,
+     const unsigned char *m, unsigned long long mlen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *nsec,
+     const unsigned char *npub,
+     const unsigned char *k)
+{
+    romulus2_context_t context;
+    romulus2_aead_setup_key(&context, k);
+    return romulus_m2_aead_encrypt_with_context
+        (c, clen, m, mlen, ad, adlen, nsec, npub, &context);
+}
+
+int romulus_m2_aead_decrypt
+    (unsigned char *m, unsigned long long *mlen,
+     unsigned char *nsec,
+     const unsigned char *c, unsigned long long clen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *npub,
+     const unsigned char *k)
+{
+    romulus2_context_t context;
+    romulus2_aead_setup_key(&context, k);
+    return romulus_m2_aead_decrypt_with_context
+        (m, mlen, nsec, c, clen, ad, adlen, npub, &context);
+}
+
+int romulus_m3_aead_encrypt
+    (unsigned char *c, unsigned long long *clen,
+     const unsigned char *m, unsigned long long mlen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *nsec,
+     const unsigned char *npub,
+     const unsigned char *k)
+{
+    romulus3_context_t context;
+    romulus3_aead_setup_key(&context, k);
+    return romulus_m3_aead_encrypt_with_context
+        (c, clen, m, mlen, ad, adlen, nsec, npub, &context);
+}
+
+int romulus_m3_aead_decrypt
+    (unsigned char *m, unsigned long long *mlen,
+     unsigned char *nsec,
+     const unsigned char *c, unsigned long long clen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *npub,
+     const unsigned char *k)
+{
+    romulus3_context_t context;
+    romulus3_aead_setup_key(&context, k);
+    return romulus_m3_aead_decrypt_with_context
+        (m, mlen, nsec, c, clen, ad, adlen, npub, &context);
+}
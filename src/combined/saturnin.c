@@ -23,6 +23,26 @@
 #include "saturnin.h"
 #include "internal-saturnin.h"
 #include <string.h>
+#if defined(LW_USE_PTHREADS)
+#include <pthread.h>
+#endif
+
+/**
+ * \brief Key context for SATURNIN-CTR-Cascade.
+ *
+ * Only the CTR mode key schedule can be cached.  The Cascade is keyed by
+ * its own chaining value for every block, so the raw key is kept to start
+ * the chain.
+ */
+typedef struct
+{
+    /** Key schedule for CTR mode */
+    saturnin_key_schedule_t ks;
+
+    /** Raw key, for starting the Cascade */
+    unsigned char k[SATURNIN_KEY_SIZE];
+
+} saturnin_context_t;
 
 aead_cipher_t const saturnin_cipher = {
     "SATURNIN-CTR-Cascade",
@@ -31,7 +51,39 @@ aead_cipher_t const saturnin_cipher = {
     SATURNIN_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN,
     saturnin_aead_encrypt,
-    saturnin_aead_decrypt
+    saturnin_aead_decrypt,
+    sizeof(saturnin_context_t),
+    saturnin_aead_setup_key,
+    saturnin_aead_encrypt_with_context,
+    saturnin_aead_decrypt_with_context,
+    0, /* stream */
+    0  /* batch */
+};
+
+/**
+ * \brief Encrypts a batch of packets with SATURNIN-Short.
+ *
+ * \param items Points to the descriptors for the packets.
+ * \param count Number of packets in the batch.
+ */
+static void saturnin_short_batch_encrypt
+    (aead_batch_item_t *items, size_t count);
+
+/**
+ * \brief Decrypts a batch of packets with SATURNIN-Short.
+ *
+ * \param items Points to the descriptors for the packets.
+ * \param count Number of packets in the batch.
+ */
+static void saturnin_short_batch_decrypt
+    (aead_batch_item_t *items, size_t count);
+
+/**
+ * \brief Batch AEAD functions for SATURNIN-Short.
+ */
+static aead_batch_cipher_t const saturnin_short_batch_cipher = {
+    saturnin_short_batch_encrypt,
+    saturnin_short_batch_decrypt
 };
 
 aead_cipher_t const saturnin_short_cipher = {
@@ -41,7 +93,13 @@ aead_cipher_t const saturnin_short_cipher = {
     SATURNIN_TAG_SIZE,
     AEAD_FLAG_NONE,
     saturnin_short_aead_encrypt,
-    saturnin_short_aead_decrypt
+    saturnin_short_aead_decrypt,
+    sizeof(saturnin_key_schedule_t),
+    saturnin_short_aead_setup_key,
+    saturnin_short_aead_encrypt_with_context,
+    saturnin_short_aead_decrypt_with_context,
+    0, /* stream */
+    &saturnin_short_batch_cipher
 };
 
 aead_hash_algorithm_t const saturnin_hash_algorithm = {
@@ -83,28 +141,40 @@ static void saturnin_block_encrypt_xor
  * \param mlen Length of the plaintext in bytes.
  * \param ks Points to the key schedule.
  * \param block Points to the pre-formatted nonce block.
+ * \param counter Counter value for the first block; 1 for a whole packet.
  */
 static void saturnin_ctr_encrypt
     (unsigned char *c, const unsigned char *m, unsigned long long mlen,
-     const saturnin_key_schedule_t *ks, unsigned char *block)
+     const saturnin_key_schedule_t *ks, unsigned char *block,
+     uint32_t counter)
 {
     /* Note: Specification requires a 95-bit counter but we only use 32-bit.
      * This limits the maximum packet size to 128Gb.  That should be OK */
-    uint32_t counter = 1;
-    unsigned char out[SATURNIN_BLOCK_SIZE];
-    while (mlen >= 32) {
-        be_store_word32(block + 28, counter);
-        saturnin_encrypt_block(ks, out, block, SATURNIN_DOMAIN_10_1);
-        lw_xor_block_2_src(c, out, m, 32);
-        c += 32;
-        m += 32;
-        mlen -= 32;
-        ++counter;
-    }
-    if (mlen > 0) {
-        be_store_word32(block + 28, counter);
-        saturnin_encrypt_block(ks, out, block, SATURNIN_DOMAIN_10_1);
-        lw_xor_block_2_src(c, out, m, (unsigned)mlen);
+    unsigned char out[SATURNIN_BLOCK_SIZE * SATURNIN_MAX_LANES];
+    unsigned count, index, len;
+    while (mlen > 0) {
+        /* Format up to SATURNIN_MAX_LANES counter blocks */
+        if (mlen >= sizeof(out))
+            count = SATURNIN_MAX_LANES;
+        else
+            count = (unsigned)((mlen + SATURNIN_BLOCK_SIZE - 1) /
+                               SATURNIN_BLOCK_SIZE);
+        for (index = 0; index < count; ++index, ++counter) {
+            be_store_word32(block + 28, counter);
+            memcpy(out + index * SATURNIN_BLOCK_SIZE, block,
+                   SATURNIN_BLOCK_SIZE);
+        }
+
+        /* Encrypt the counter blocks and XOR them with the input */
+        saturnin_encrypt_blocks
+            (ks, out, out, count, SATURNIN_DOMAIN_10_1);
+        len = count * SATURNIN_BLOCK_SIZE;
+        if (len > mlen)
+            len = (unsigned)mlen;
+        lw_xor_block_2_src(c, out, m, len);
+        c += len;
+        m += len;
+        mlen -= len;
     }
 }
 
@@ -136,15 +206,15 @@ static void saturnin_authenticate
     saturnin_block_encrypt_xor(block, tag, domain2);
 }
 
-int saturnin_aead_encrypt
+int saturnin_aead_encrypt_with_context
     (unsigned char *c, unsigned long long *clen,
      const unsigned char *m, unsigned long long mlen,
      const unsigned char *ad, unsigned long long adlen,
      const unsigned char *nsec,
      const unsigned char *npub,
-     const unsigned char *k)
+     const void *ctx)
 {
-    saturnin_key_schedule_t ks;
+    const saturnin_context_t *context = (const saturnin_context_t *)ctx;
     unsigned char block[32];
     unsigned char *tag;
     (void)nsec;
@@ -158,12 +228,11 @@ int saturnin_aead_encrypt
     memset(block + 17, 0, 15);
 
     /* Encrypt the plaintext in counter mode to produce the ciphertext */
-    saturnin_setup_key(&ks, k);
-    saturnin_ctr_encrypt(c, m, mlen, &ks, block);
+    saturnin_ctr_encrypt(c, m, mlen, &(context->ks), block, 1);
 
     /* Set the counter back to zero and then encrypt the nonce */
     tag = c + mlen;
-    memcpy(tag, k, 32);
+    memcpy(tag, context->k, 32);
     memset(block + 17, 0, 15);
     saturnin_block_encrypt_xor(block, tag, SATURNIN_DOMAIN_10_2);
 
@@ -175,15 +244,15 @@ int saturnin_aead_encrypt
     return 0;
 }
 
-int saturnin_aead_decrypt
+int saturnin_aead_decrypt_with_context
     (unsigned char *m, unsigned long long *mlen,
      unsigned char *nsec,
      const unsigned char *c, unsigned long long clen,
      const unsigned char *ad, unsigned long long adlen,
      const unsigned char *npub,
-     const unsigned char *k)
+     const void *ctx)
 {
-    saturnin_key_schedule_t ks;
+    const saturnin_context_t *context = (const saturnin_context_t *)ctx;
     unsigned char block[32];
     unsigned char tag[32];
     (void)nsec;
@@ -199,7 +268,7 @@ int saturnin_aead_decrypt
     memset(block + 17, 0, 15);
 
     /* Encrypt the nonce to initialize the authentication phase */
-    memcpy(tag, k, 32);
+    memcpy(tag, context->k, 32);
     saturnin_block_encrypt_xor(block, tag, SATURNIN_DOMAIN_10_2);
 
     /* Authenticate the associated data and the ciphertext */
@@ -212,15 +281,21 @@ int saturnin_aead_decrypt
     memcpy(block, npub, 16);
     block[16] = 0x80;
     memset(block + 17, 0, 15);
-    saturnin_setup_key(&ks, k);
-    saturnin_ctr_encrypt(m, c, *mlen, &ks, block);
+    saturnin_ctr_encrypt(m, c, *mlen, &(context->ks), block, 1);
 
     /* Check the authentication tag at the end of the message */
     return aead_check_tag
         (m, *mlen, tag, c + *mlen, SATURNIN_TAG_SIZE);
 }
 
-int saturnin_short_aead_encrypt
+void saturnin_aead_setup_key(void *ctx, const unsigned char *k)
+{
+    saturnin_context_t *context = (saturnin_context_t *)ctx;
+    saturnin_setup_key(&(context->ks), k);
+    memcpy(context->k, k, SATURNIN_KEY_SIZE);
+}
+
+int saturnin_aead_encrypt
     (unsigned char *c, unsigned long long *clen,
      const unsigned char *m, unsigned long long mlen,
      const unsigned char *ad, unsigned long long adlen,
@@ -228,8 +303,405 @@ int saturnin_short_aead_encrypt
      const unsigned char *npub,
      const unsigned char *k)
 {
+    saturnin_context_t context;
+    saturnin_aead_setup_key(&context, k);
+    return saturnin_aead_encrypt_with_context
+        (c, clen, m, mlen, ad, adlen, nsec, npub, &context);
+}
+
+int saturnin_aead_decrypt
+    (unsigned char *m, unsigned long long *mlen,
+     unsigned char *nsec,
+     const unsigned char *c, unsigned long long clen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *npub,
+     const unsigned char *k)
+{
+    saturnin_context_t context;
+    saturnin_aead_setup_key(&context, k);
+    return saturnin_aead_decrypt_with_context
+        (m, mlen, nsec, c, clen, ad, adlen, npub, &context);
+}
+
+/**
+ * \brief Size of the chunks of keystream that are handed to worker threads.
+ *
+ * Must be a multiple of the 32 byte block size.
+ */
+#define SATURNIN_PARALLEL_CHUNK_SIZE 16384
+
+#if defined(LW_USE_PTHREADS)
+
+/**
+ * \brief Shared state for a parallel SATURNIN-CTR-Cascade operation.
+ *
+ * Chunk i is handled by worker (i % threads), and each worker processes
+ * its chunks in increasing order.  So chunk i is finished once
+ * progress[i % threads] > i / threads.
+ */
+typedef struct
+{
+    pthread_mutex_t mutex;      /**< Protects the fields below */
+    pthread_cond_t cond;        /**< Signalled when any field changes */
+    const saturnin_key_schedule_t *ks; /**< Key schedule for CTR mode */
+    const unsigned char *npub;  /**< Nonce for the packet */
+    unsigned char *out;         /**< Output of CTR mode */
+    const unsigned char *in;    /**< Input to CTR mode */
+    unsigned long long len;     /**< Length of the CTR mode data */
+    unsigned long long chunks;  /**< Number of chunks */
+    unsigned long long gate;    /**< Chunks that may be processed so far */
+    unsigned threads;           /**< Number of worker threads */
+    int started;                /**< Non-zero once all workers exist */
+    int aborted;                /**< Non-zero if thread creation failed */
+    unsigned long long progress[SATURNIN_MAX_THREADS];
+                                /**< Chunks finished by each worker */
+
+} saturnin_parallel_t;
+
+/**
+ * \brief Arguments for a SATURNIN-CTR-Cascade worker thread.
+ */
+typedef struct
+{
+    saturnin_parallel_t *shared;    /**< Shared state */
+    unsigned index;                 /**< Index of this worker */
+
+} saturnin_worker_t;
+
+/**
+ * \brief Worker thread that generates CTR mode output for its chunks.
+ *
+ * \param arg Points to the saturnin_worker_t for this thread.
+ *
+ * \return Always NULL.
+ */
+static void *saturnin_ctr_worker(void *arg)
+{
+    saturnin_worker_t *worker = (saturnin_worker_t *)arg;
+    saturnin_parallel_t *shared = worker->shared;
+    unsigned long long chunk, offset, size;
+    unsigned char block[32];
+
+    /* Wait for all workers to be created */
+    pthread_mutex_lock(&(shared->mutex));
+    while (!shared->started && !shared->aborted)
+        pthread_cond_wait(&(shared->cond), &(shared->mutex));
+    pthread_mutex_unlock(&(shared->mutex));
+    if (shared->aborted)
+        return 0;
+
+    /* Process every chunk in this worker's stripe */
+    memcpy(block, shared->npub, 16);
+    block[16] = 0x80;
+    memset(block + 17, 0, 15);
+    for (chunk = worker->index; chunk < shared->chunks;
+            chunk += shared->threads) {
+        /* Wait until we are allowed to overwrite this chunk */
+        pthread_mutex_lock(&(shared->mutex));
+        while (chunk >= shared->gate)
+            pthread_cond_wait(&(shared->cond), &(shared->mutex));
+        pthread_mutex_unlock(&(shared->mutex));
+
+        /* Encrypt or decrypt the chunk */
+        offset = chunk * SATURNIN_PARALLEL_CHUNK_SIZE;
+        size = shared->len - offset;
+        if (size > SATURNIN_PARALLEL_CHUNK_SIZE)
+            size = SATURNIN_PARALLEL_CHUNK_SIZE;
+        saturnin_ctr_encrypt
+            (shared->out + offset, shared->in + offset, size, shared->ks,
+             block, (uint32_t)(offset / SATURNIN_BLOCK_SIZE + 1));
+
+        /* Report our progress to the authenticating thread */
+        pthread_mutex_lock(&(shared->mutex));
+        ++(shared->progress[worker->index]);
+        pthread_cond_broadcast(&(shared->cond));
+        pthread_mutex_unlock(&(shared->mutex));
+    }
+    return 0;
+}
+
+/**
+ * \brief Starts the worker threads for a parallel operation.
+ *
+ * \param shared The shared state, with all fields except the mutex,
+ * condition variable, and progress counters filled in.
+ * \param workers Array of SATURNIN_MAX_THREADS worker arguments.
+ * \param ids Array of SATURNIN_MAX_THREADS thread identifiers.
+ *
+ * \return Non-zero if all threads were started, or zero if the threads
+ * could not be started and the operation should be performed serially.
+ */
+static int saturnin_parallel_start
+    (saturnin_parallel_t *shared, saturnin_worker_t *workers, pthread_t *ids)
+{
+    unsigned index, created;
+    if (pthread_mutex_init(&(shared->mutex), 0) != 0)
+        return 0;
+    if (pthread_cond_init(&(shared->cond), 0) != 0) {
+        pthread_mutex_destroy(&(shared->mutex));
+        return 0;
+    }
+    shared->started = 0;
+    shared->aborted = 0;
+    memset(shared->progress, 0, sizeof(shared->progress));
+    for (created = 0; created < shared->threads; ++created) {
+        workers[created].shared = shared;
+        workers[created].index = created;
+        if (pthread_create(&(ids[created]), 0, saturnin_ctr_worker,
+                           &(workers[created])) != 0)
+            break;
+    }
+    pthread_mutex_lock(&(shared->mutex));
+    if (created == shared->threads)
+        shared->started = 1;
+    else
+        shared->aborted = 1;
+    pthread_cond_broadcast(&(shared->cond));
+    pthread_mutex_unlock(&(shared->mutex));
+    if (created == shared->threads)
+        return 1;
+    for (index = 0; index < created; ++index)
+        pthread_join(ids[index], 0);
+    pthread_cond_destroy(&(shared->cond));
+    pthread_mutex_destroy(&(shared->mutex));
+    return 0;
+}
+
+/**
+ * \brief Waits for the worker threads of a parallel operation to exit.
+ *
+ * \param shared The shared state.
+ * \param ids Array of thread identifiers.
+ */
+static void saturnin_parallel_finish
+    (saturnin_parallel_t *shared, pthread_t *ids)
+{
+    unsigned index;
+    for (index = 0; index < shared->threads; ++index)
+        pthread_join(ids[index], 0);
+    pthread_cond_destroy(&(shared->cond));
+    pthread_mutex_destroy(&(shared->mutex));
+}
+
+/**
+ * \brief Waits for a chunk to be finished by its worker thread.
+ *
+ * \param shared The shared state.
+ * \param chunk Index of the chunk to wait for.
+ */
+static void saturnin_parallel_wait
+    (saturnin_parallel_t *shared, unsigned long long chunk)
+{
+    unsigned long long *progress = &(shared->progress[chunk % shared->threads]);
+    unsigned long long needed = chunk / shared->threads + 1;
+    pthread_mutex_lock(&(shared->mutex));
+    while (*progress < needed)
+        pthread_cond_wait(&(shared->cond), &(shared->mutex));
+    pthread_mutex_unlock(&(shared->mutex));
+}
+
+/**
+ * \brief Allows worker threads to process chunks up to a limit.
+ *
+ * \param shared The shared state.
+ * \param gate Number of leading chunks that may now be processed.
+ */
+static void saturnin_parallel_open_gate
+    (saturnin_parallel_t *shared, unsigned long long gate)
+{
+    pthread_mutex_lock(&(shared->mutex));
+    shared->gate = gate;
+    pthread_cond_broadcast(&(shared->cond));
+    pthread_mutex_unlock(&(shared->mutex));
+}
+
+/**
+ * \brief Authenticates the full blocks of a chunk of ciphertext.
+ *
+ * \param tag Points to the authentication tag.
+ * \param c Points to the chunk of ciphertext.
+ * \param len Length of the chunk, which must be a multiple of 32.
+ */
+static void saturnin_authenticate_blocks
+    (unsigned char *tag, const unsigned char *c, unsigned long long len)
+{
+    while (len > 0) {
+        saturnin_block_encrypt_xor(c, tag, SATURNIN_DOMAIN_10_4);
+        c += 32;
+        len -= 32;
+    }
+}
+
+#endif /* LW_USE_PTHREADS */
+
+int saturnin_aead_encrypt_parallel
+    (unsigned char *c, unsigned long long *clen,
+     const unsigned char *m, unsigned long long mlen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *nsec,
+     const unsigned char *npub,
+     const unsigned char *k, unsigned threads)
+{
+#if defined(LW_USE_PTHREADS)
+    saturnin_parallel_t shared;
+    saturnin_worker_t workers[SATURNIN_MAX_THREADS];
+    pthread_t ids[SATURNIN_MAX_THREADS];
+    saturnin_key_schedule_t ks;
+    unsigned char block[32];
+    unsigned char tag[32];
+    unsigned long long chunk, last;
+
+    /* Use the serial version if parallelism would not help */
+    if (threads > SATURNIN_MAX_THREADS)
+        threads = SATURNIN_MAX_THREADS;
+    if (threads < 2 || mlen < 2 * SATURNIN_PARALLEL_CHUNK_SIZE) {
+        return saturnin_aead_encrypt
+            (c, clen, m, mlen, ad, adlen, nsec, npub, k);
+    }
+
+    /* Start the worker threads on the CTR mode encryption */
+    saturnin_setup_key(&ks, k);
+    shared.ks = &ks;
+    shared.npub = npub;
+    shared.out = c;
+    shared.in = m;
+    shared.len = mlen;
+    shared.chunks = (mlen + SATURNIN_PARALLEL_CHUNK_SIZE - 1) /
+                    SATURNIN_PARALLEL_CHUNK_SIZE;
+    shared.gate = shared.chunks;
+    shared.threads = threads;
+    if (!saturnin_parallel_start(&shared, workers, ids)) {
+        return saturnin_aead_encrypt
+            (c, clen, m, mlen, ad, adlen, nsec, npub, k);
+    }
+    *clen = mlen + SATURNIN_TAG_SIZE;
+
+    /* Encrypt the nonce and authenticate the associated data while the
+     * workers are generating the first chunks of ciphertext */
+    memcpy(block, npub, 16);
+    block[16] = 0x80;
+    memset(block + 17, 0, 15);
+    memcpy(tag, k, 32);
+    saturnin_block_encrypt_xor(block, tag, SATURNIN_DOMAIN_10_2);
+    saturnin_authenticate
+        (tag, block, ad, adlen, SATURNIN_DOMAIN_10_2, SATURNIN_DOMAIN_10_3);
+
+    /* Authenticate each chunk of ciphertext as it becomes available */
+    last = shared.chunks - 1;
+    for (chunk = 0; chunk < last; ++chunk) {
+        saturnin_parallel_wait(&shared, chunk);
+        saturnin_authenticate_blocks
+            (tag, c + chunk * SATURNIN_PARALLEL_CHUNK_SIZE,
+             SATURNIN_PARALLEL_CHUNK_SIZE);
+    }
+    saturnin_parallel_wait(&shared, last);
+    saturnin_authenticate
+        (tag, block, c + last * SATURNIN_PARALLEL_CHUNK_SIZE,
+         mlen - last * SATURNIN_PARALLEL_CHUNK_SIZE,
+         SATURNIN_DOMAIN_10_4, SATURNIN_DOMAIN_10_5);
+    saturnin_parallel_finish(&shared, ids);
+    memcpy(c + mlen, tag, SATURNIN_TAG_SIZE);
+    return 0;
+#else
+    (void)threads;
+    return saturnin_aead_encrypt(c, clen, m, mlen, ad, adlen, nsec, npub, k);
+#endif
+}
+
+int saturnin_aead_decrypt_parallel
+    (unsigned char *m, unsigned long long *mlen,
+     unsigned char *nsec,
+     const unsigned char *c, unsigned long long clen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *npub,
+     const unsigned char *k, unsigned threads)
+{
+#if defined(LW_USE_PTHREADS)
+    saturnin_parallel_t shared;
+    saturnin_worker_t workers[SATURNIN_MAX_THREADS];
+    pthread_t ids[SATURNIN_MAX_THREADS];
     saturnin_key_schedule_t ks;
     unsigned char block[32];
+    unsigned char tag[32];
+    unsigned long long chunk, last, len;
+    int in_place;
+
+    /* Use the serial version if parallelism would not help */
+    if (threads > SATURNIN_MAX_THREADS)
+        threads = SATURNIN_MAX_THREADS;
+    if (threads < 2 || clen < (2 * SATURNIN_PARALLEL_CHUNK_SIZE +
+                               SATURNIN_TAG_SIZE)) {
+        return saturnin_aead_decrypt
+            (m, mlen, nsec, c, clen, ad, adlen, npub, k);
+    }
+    len = clen - SATURNIN_TAG_SIZE;
+
+    /* Start the worker threads on the CTR mode decryption.  If we are
+     * decrypting in place, then the workers must not overwrite a chunk
+     * of ciphertext until the MAC has consumed it */
+    in_place = (m < c + clen && c < m + len);
+    saturnin_setup_key(&ks, k);
+    shared.ks = &ks;
+    shared.npub = npub;
+    shared.out = m;
+    shared.in = c;
+    shared.len = len;
+    shared.chunks = (len + SATURNIN_PARALLEL_CHUNK_SIZE - 1) /
+                    SATURNIN_PARALLEL_CHUNK_SIZE;
+    shared.gate = in_place ? 0 : shared.chunks;
+    shared.threads = threads;
+    if (!saturnin_parallel_start(&shared, workers, ids)) {
+        return saturnin_aead_decrypt
+            (m, mlen, nsec, c, clen, ad, adlen, npub, k);
+    }
+    *mlen = len;
+
+    /* Encrypt the nonce and authenticate the associated data */
+    memcpy(block, npub, 16);
+    block[16] = 0x80;
+    memset(block + 17, 0, 15);
+    memcpy(tag, k, 32);
+    saturnin_block_encrypt_xor(block, tag, SATURNIN_DOMAIN_10_2);
+    saturnin_authenticate
+        (tag, block, ad, adlen, SATURNIN_DOMAIN_10_2, SATURNIN_DOMAIN_10_3);
+
+    /* Authenticate the ciphertext, releasing chunks to the workers */
+    last = shared.chunks - 1;
+    for (chunk = 0; chunk < last; ++chunk) {
+        saturnin_authenticate_blocks
+            (tag, c + chunk * SATURNIN_PARALLEL_CHUNK_SIZE,
+             SATURNIN_PARALLEL_CHUNK_SIZE);
+        if (in_place)
+            saturnin_parallel_open_gate(&shared, chunk + 1);
+    }
+    saturnin_authenticate
+        (tag, block, c + last * SATURNIN_PARALLEL_CHUNK_SIZE,
+         len - last * SATURNIN_PARALLEL_CHUNK_SIZE,
+         SATURNIN_DOMAIN_10_4, SATURNIN_DOMAIN_10_5);
+    if (in_place)
+        saturnin_parallel_open_gate(&shared, shared.chunks);
+
+    /* Wait for the workers and then check the authentication tag.  The
+     * tag is copied out of the input first in case of overlap */
+    memcpy(block, c + len, SATURNIN_TAG_SIZE);
+    saturnin_parallel_finish(&shared, ids);
+    return aead_check_tag(m, len, tag, block, SATURNIN_TAG_SIZE);
+#else
+    (void)threads;
+    return saturnin_aead_decrypt(m, mlen, nsec, c, clen, ad, adlen, npub, k);
+#endif
+}
+
+int saturnin_short_aead_encrypt_with_context
+    (unsigned char *c, unsigned long long *clen,
+     const unsigned char *m, unsigned long long mlen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *nsec,
+     const unsigned char *npub,
+     const void *ctx)
+{
+    const saturnin_key_schedule_t *ks = (const saturnin_key_schedule_t *)ctx;
+    unsigned char block[32];
     unsigned temp;
     (void)nsec;
     (void)ad;
@@ -246,21 +718,20 @@ int saturnin_short_aead_encrypt
     memset(block + 17 + temp, 0, 15 - temp);
 
     /* Encrypt the input block to produce the output ciphertext */
-    saturnin_setup_key(&ks, k);
-    saturnin_encrypt_block(&ks, c, block, SATURNIN_DOMAIN_10_6);
+    saturnin_encrypt_block(ks, c, block, SATURNIN_DOMAIN_10_6);
     *clen = 32;
     return 0;
 }
 
-int saturnin_short_aead_decrypt
+int saturnin_short_aead_decrypt_with_context
     (unsigned char *m, unsigned long long *mlen,
      unsigned char *nsec,
      const unsigned char *c, unsigned long long clen,
      const unsigned char *ad, unsigned long long adlen,
      const unsigned char *npub,
-     const unsigned char *k)
+     const void *ctx)
 {
-    saturnin_key_schedule_t ks;
+    const saturnin_key_schedule_t *ks = (const saturnin_key_schedule_t *)ctx;
     unsigned char block[32];
     unsigned check1, check2, len;
     int index, result;
@@ -274,8 +745,7 @@ int saturnin_short_aead_decrypt
         return -1;
 
     /* Decrypt the ciphertext block */
-    saturnin_setup_key(&ks, k);
-    saturnin_decrypt_block(&ks, block, c, SATURNIN_DOMAIN_10_6);
+    saturnin_decrypt_block(ks, block, c, SATURNIN_DOMAIN_10_6);
 
     /* Verify that the output block starts with the nonce and that it is
      * padded correctly.  We need to do this very carefully to avoid leaking
@@ -310,6 +780,103 @@ int saturnin_short_aead_decrypt
     return ~result;
 }
 
+void saturnin_short_aead_setup_key(void *ctx, const unsigned char *k)
+{
+    saturnin_setup_key((saturnin_key_schedule_t *)ctx, k);
+}
+
+int saturnin_short_aead_encrypt
+    (unsigned char *c, unsigned long long *clen,
+     const unsigned char *m, unsigned long long mlen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *nsec,
+     const unsigned char *npub,
+     const unsigned char *k)
+{
+    saturnin_key_schedule_t ks;
+    saturnin_setup_key(&ks, k);
+    return saturnin_short_aead_encrypt_with_context
+        (c, clen, m, mlen, ad, adlen, nsec, npub, &ks);
+}
+
+int saturnin_short_aead_decrypt
+    (unsigned char *m, unsigned long long *mlen,
+     unsigned char *nsec,
+     const unsigned char *c, unsigned long long clen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *npub,
+     const unsigned char *k)
+{
+    saturnin_key_schedule_t ks;
+    saturnin_setup_key(&ks, k);
+    return saturnin_short_aead_decrypt_with_context
+        (m, mlen, nsec, c, clen, ad, adlen, npub, &ks);
+}
+
+static void saturnin_short_batch_encrypt
+    (aead_batch_item_t *items, size_t count)
+{
+    saturnin_key_schedule_t ks[SATURNIN_MAX_LANES];
+    unsigned char blocks[SATURNIN_BLOCK_SIZE * SATURNIN_MAX_LANES];
+    aead_batch_item_t *item[SATURNIN_MAX_LANES];
+    unsigned char *block;
+    unsigned lanes, lane, temp;
+    while (count > 0) {
+        /* Format the input blocks for up to SATURNIN_MAX_LANES packets,
+         * rejecting any packets with invalid parameters along the way */
+        lanes = 0;
+        while (lanes < SATURNIN_MAX_LANES && count > 0) {
+            if (items->adlen > 0 || items->inlen > 15) {
+                items->outlen = 0;
+                items->status = -2;
+            } else {
+                temp = (unsigned)(items->inlen);
+                block = blocks + lanes * SATURNIN_BLOCK_SIZE;
+                memcpy(block, items->npub, 16);
+                memcpy(block + 16, items->in, temp);
+                block[16 + temp] = 0x80; /* Padding */
+                memset(block + 17 + temp, 0, 15 - temp);
+                if (items->key)
+                    saturnin_setup_key(&(ks[lanes]), items->key);
+                else
+                    memcpy(&(ks[lanes]), items->ctx, sizeof(ks[lanes]));
+                item[lanes++] = items;
+            }
+            ++items;
+            --count;
+        }
+
+        /* Encrypt all of the blocks at once */
+        saturnin_encrypt_blocks_multi_key
+            (ks, blocks, blocks, lanes, SATURNIN_DOMAIN_10_6);
+        for (lane = 0; lane < lanes; ++lane) {
+            memcpy(item[lane]->out, blocks + lane * SATURNIN_BLOCK_SIZE,
+                   SATURNIN_BLOCK_SIZE);
+            item[lane]->outlen = SATURNIN_BLOCK_SIZE;
+            item[lane]->status = 0;
+        }
+    }
+}
+
+static void saturnin_short_batch_decrypt
+    (aead_batch_item_t *items, size_t count)
+{
+    /* There is no multi-block decryption kernel, so decrypt one at a time */
+    while (count > 0) {
+        if (items->key) {
+            items->status = saturnin_short_aead_decrypt
+                (items->out, &(items->outlen), 0, items->in, items->inlen,
+                 items->ad, items->adlen, items->npub, items->key);
+        } else {
+            items->status = saturnin_short_aead_decrypt_with_context
+                (items->out, &(items->outlen), 0, items->in, items->inlen,
+                 items->ad, items->adlen, items->npub, items->ctx);
+        }
+        ++items;
+        --count;
+    }
+}
+
 int saturnin_hash
     (unsigned char *out, const unsigned char *in, unsigned long long inlen)
 {
@@ -322,6 +889,62 @@ int saturnin_hash
     return 0;
 }
 
+void saturnin_hash_batch
+    (unsigned char * const *out, const unsigned char * const *in,
+     unsigned long long inlen, size_t count)
+{
+    saturnin_key_schedule_t ks[SATURNIN_MAX_LANES];
+    unsigned char blocks[SATURNIN_BLOCK_SIZE * SATURNIN_MAX_LANES];
+    unsigned char hash[SATURNIN_MAX_LANES][SATURNIN_HASH_SIZE];
+    unsigned long long posn;
+    unsigned lanes, lane, temp;
+    unsigned char *block;
+    while (count > 0) {
+        lanes = (count < SATURNIN_MAX_LANES) ? (unsigned)count
+                                             : SATURNIN_MAX_LANES;
+        memset(hash, 0, sizeof(hash));
+
+        /* Absorb the full blocks of all messages in parallel.  The block
+         * cipher is keyed with the chaining value of each message */
+        for (posn = 0; (inlen - posn) >= SATURNIN_BLOCK_SIZE;
+                posn += SATURNIN_BLOCK_SIZE) {
+            for (lane = 0; lane < lanes; ++lane) {
+                saturnin_setup_key(&(ks[lane]), hash[lane]);
+                memcpy(blocks + lane * SATURNIN_BLOCK_SIZE, in[lane] + posn,
+                       SATURNIN_BLOCK_SIZE);
+            }
+            saturnin_encrypt_blocks_multi_key
+                (ks, blocks, blocks, lanes, SATURNIN_DOMAIN_16_7);
+            for (lane = 0; lane < lanes; ++lane) {
+                lw_xor_block_2_src
+                    (hash[lane], blocks + lane * SATURNIN_BLOCK_SIZE,
+                     in[lane] + posn, SATURNIN_BLOCK_SIZE);
+            }
+        }
+
+        /* Pad and absorb the final blocks */
+        temp = (unsigned)(inlen - posn);
+        for (lane = 0; lane < lanes; ++lane) {
+            block = blocks + lane * SATURNIN_BLOCK_SIZE;
+            saturnin_setup_key(&(ks[lane]), hash[lane]);
+            memcpy(block, in[lane] + posn, temp);
+            block[temp] = 0x80;
+            memset(block + temp + 1, 0, 31 - temp);
+            memcpy(hash[lane], block, SATURNIN_BLOCK_SIZE);
+        }
+        saturnin_encrypt_blocks_multi_key
+            (ks, blocks, blocks, lanes, SATURNIN_DOMAIN_16_8);
+        for (lane = 0; lane < lanes; ++lane) {
+            lw_xor_block_2_src
+                (out[lane], hash[lane], blocks + lane * SATURNIN_BLOCK_SIZE,
+                 SATURNIN_HASH_SIZE);
+        }
+        out += lanes;
+        in += lanes;
+        count -= lanes;
+    }
+}
+
 void saturnin_hash_init(saturnin_hash_state_t *state)
 {
     memset(state, 0, sizeof(saturnin_hash_state_t));
@@ -157,6 +157,165 @@ int saturnin_aead_decrypt
      const unsigned char *npub,
      const unsigned char *k);
 
+/**
+ * \brief Sets up a precomputed key context for SATURNIN-CTR-Cascade.
+ *
+ * \param ctx Points to the key context to set up, which must be at least
+ * saturnin_cipher.context_size bytes in length and suitably
+ * aligned for any integer type.
+ * \param k Points to the 32 bytes of the key.
+ *
+ * \sa saturnin_aead_encrypt_with_context(),
+ * saturnin_aead_decrypt_with_context()
+ */
+void saturnin_aead_setup_key(void *ctx, const unsigned char *k);
+
+/**
+ * \brief Encrypts and authenticates a packet with SATURNIN-CTR-Cascade
+ * using a precomputed key context.
+ *
+ * \param c Buffer to receive the output.
+ * \param clen On exit, set to the length of the output which includes
+ * the ciphertext and the 32 byte authentication tag.
+ * \param m Buffer that contains the plaintext message to encrypt.
+ * \param mlen Length of the plaintext message in bytes.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param nsec Secret nonce - not used by this algorithm.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param ctx Points to the key context that was set up by
+ * saturnin_aead_setup_key().
+ *
+ * \return 0 on success, or a negative value if there was an error in
+ * the parameters.
+ *
+ * \sa saturnin_aead_decrypt_with_context(), saturnin_aead_setup_key()
+ */
+int saturnin_aead_encrypt_with_context
+    (unsigned char *c, unsigned long long *clen,
+     const unsigned char *m, unsigned long long mlen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *nsec,
+     const unsigned char *npub,
+     const void *ctx);
+
+/**
+ * \brief Decrypts and authenticates a packet with SATURNIN-CTR-Cascade
+ * using a precomputed key context.
+ *
+ * \param m Buffer to receive the plaintext message on output.
+ * \param mlen Receives the length of the plaintext message on output.
+ * \param nsec Secret nonce - not used by this algorithm.
+ * \param c Buffer that contains the ciphertext and authentication
+ * tag to decrypt.
+ * \param clen Length of the input data in bytes, which includes the
+ * ciphertext and the 32 byte authentication tag.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param ctx Points to the key context that was set up by
+ * saturnin_aead_setup_key().
+ *
+ * \return 0 on success, -1 if the authentication tag was incorrect,
+ * or some other negative number if there was an error in the parameters.
+ *
+ * \sa saturnin_aead_encrypt_with_context(), saturnin_aead_setup_key()
+ */
+int saturnin_aead_decrypt_with_context
+    (unsigned char *m, unsigned long long *mlen,
+     unsigned char *nsec,
+     const unsigned char *c, unsigned long long clen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *npub,
+     const void *ctx);
+
+/**
+ * \brief Maximum number of worker threads for the parallel
+ * SATURNIN-CTR-Cascade functions.
+ */
+#define SATURNIN_MAX_THREADS 16
+
+/**
+ * \brief Encrypts and authenticates a packet with SATURNIN-CTR-Cascade,
+ * generating the keystream on several worker threads.
+ *
+ * \param c Buffer to receive the output.
+ * \param clen On exit, set to the length of the output which includes
+ * the ciphertext and the 32 byte authentication tag.
+ * \param m Buffer that contains the plaintext message to encrypt.
+ * \param mlen Length of the plaintext message in bytes.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param nsec Secret nonce - not used by this algorithm.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 32 bytes of the key to use to encrypt the packet.
+ * \param threads Number of worker threads to use for the keystream,
+ * up to SATURNIN_MAX_THREADS.
+ *
+ * \return 0 on success, or a negative value if there was an error in
+ * the parameters.
+ *
+ * The counter blocks are split into chunks that the worker threads encrypt
+ * while the calling thread runs the Cascade MAC over the associated data
+ * and then over each chunk of ciphertext as it becomes available.  The
+ * output is identical to saturnin_aead_encrypt().
+ *
+ * Short packets, \a threads values less than 2, and builds without
+ * LW_USE_PTHREADS are handled by saturnin_aead_encrypt() directly.
+ *
+ * \sa saturnin_aead_decrypt_parallel()
+ */
+int saturnin_aead_encrypt_parallel
+    (unsigned char *c, unsigned long long *clen,
+     const unsigned char *m, unsigned long long mlen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *nsec,
+     const unsigned char *npub,
+     const unsigned char *k, unsigned threads);
+
+/**
+ * \brief Decrypts and authenticates a packet with SATURNIN-CTR-Cascade,
+ * generating the keystream on several worker threads.
+ *
+ * \param m Buffer to receive the plaintext message on output.
+ * \param mlen Receives the length of the plaintext message on output.
+ * \param nsec Secret nonce - not used by this algorithm.
+ * \param c Buffer that contains the ciphertext and authentication
+ * tag to decrypt.
+ * \param clen Length of the input data in bytes, which includes the
+ * ciphertext and the 32 byte authentication tag.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 32 bytes of the key to use to decrypt the packet.
+ * \param threads Number of worker threads to use for the keystream,
+ * up to SATURNIN_MAX_THREADS.
+ *
+ * \return 0 on success, -1 if the authentication tag was incorrect,
+ * or some other negative number if there was an error in the parameters.
+ *
+ * The Cascade MAC over the ciphertext runs on the calling thread at the
+ * same time as the worker threads decrypt.  For in-place decryption,
+ * each chunk is decrypted only after the MAC has consumed it.
+ *
+ * \sa saturnin_aead_encrypt_parallel()
+ */
+int saturnin_aead_decrypt_parallel
+    (unsigned char *m, unsigned long long *mlen,
+     unsigned char *nsec,
+     const unsigned char *c, unsigned long long clen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *npub,
+     const unsigned char *k, unsigned threads);
+
 /**
  * \brief Encrypts and authenticates a packet with SATURNIN-Short.
  *
@@ -216,6 +375,84 @@ int saturnin_short_aead_decrypt
      const unsigned char *npub,
      const unsigned char *k);
 
+/**
+ * \brief Sets up a precomputed key context for SATURNIN-Short.
+ *
+ * \param ctx Points to the key context to set up, which must be at least
+ * saturnin_short_cipher.context_size bytes in length and suitably
+ * aligned for any integer type.
+ * \param k Points to the 32 bytes of the key.
+ *
+ * \sa saturnin_short_aead_encrypt_with_context(),
+ * saturnin_short_aead_decrypt_with_context()
+ */
+void saturnin_short_aead_setup_key(void *ctx, const unsigned char *k);
+
+/**
+ * \brief Encrypts and authenticates a packet with SATURNIN-Short
+ * using a precomputed key context.
+ *
+ * \param c Buffer to receive the output.
+ * \param clen On exit, set to the length of the output which is always 32.
+ * \param m Buffer that contains the plaintext message to encrypt.
+ * \param mlen Length of the plaintext message in bytes, which must be
+ * less than or equal to 15 bytes.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes, which must be zero.
+ * \param nsec Secret nonce - not used by this algorithm.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param ctx Points to the key context that was set up by
+ * saturnin_short_aead_setup_key().
+ *
+ * \return 0 on success, or -2 if the caller supplied too many bytes of
+ * plaintext or they supplied associated data.
+ *
+ * \sa saturnin_short_aead_decrypt_with_context(),
+ * saturnin_short_aead_setup_key()
+ */
+int saturnin_short_aead_encrypt_with_context
+    (unsigned char *c, unsigned long long *clen,
+     const unsigned char *m, unsigned long long mlen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *nsec,
+     const unsigned char *npub,
+     const void *ctx);
+
+/**
+ * \brief Decrypts and authenticates a packet with SATURNIN-Short
+ * using a precomputed key context.
+ *
+ * \param m Buffer to receive the plaintext message on output.  There must
+ * be at least 15 bytes of space in this buffer even if the caller expects
+ * to receive less data than that.
+ * \param mlen Receives the length of the plaintext message on output.
+ * \param nsec Secret nonce - not used by this algorithm.
+ * \param c Buffer that contains the ciphertext to decrypt.
+ * \param clen Length of the input data in bytes, which must be 32.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes, which must be zero.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param ctx Points to the key context that was set up by
+ * saturnin_short_aead_setup_key().
+ *
+ * \return 0 on success, -1 if the authentication tag was incorrect,
+ * or -2 if the caller supplied associated data.
+ *
+ * \sa saturnin_short_aead_encrypt_with_context(),
+ * saturnin_short_aead_setup_key()
+ */
+int saturnin_short_aead_decrypt_with_context
+    (unsigned char *m, unsigned long long *mlen,
+     unsigned char *nsec,
+     const unsigned char *c, unsigned long long clen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *npub,
+     const void *ctx);
+
 /**
  * \brief Hashes a block of input data with SATURNIN to generate a hash value.
  *
@@ -230,6 +467,25 @@ int saturnin_short_aead_decrypt
 int saturnin_hash
     (unsigned char *out, const unsigned char *in, unsigned long long inlen);
 
+/**
+ * \brief Hashes several messages of the same length with SATURNIN.
+ *
+ * \param out Array of \a count pointers to buffers that receive the
+ * hash outputs, each at least SATURNIN_HASH_SIZE bytes in length.
+ * \param in Array of \a count pointers to the messages to be hashed.
+ * \param inlen Length of every message in bytes.
+ * \param count Number of messages to hash.
+ *
+ * The messages are hashed side by side so that the block cipher calls
+ * for different messages can share the multi-block Saturnin kernel.
+ * The results are the same as calling saturnin_hash() on each message.
+ *
+ * \sa saturnin_hash()
+ */
+void saturnin_hash_batch
+    (unsigned char * const *out, const unsigned char * const *in,
+     unsigned long long inlen, size_t count);
+
 /**
  * \brief Initializes the state for an SATURNIN-Hash hashing operation.
  *
@@ -32,7 +32,13 @@ aead_cipher_t const skinny_aead_m1_cipher = {
     SKINNY_AEAD_M1_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN,
     skinny_aead_m1_encrypt,
-    skinny_aead_m1_decrypt
+    skinny_aead_m1_decrypt,
+    sizeof(skinny_128_384_key_schedule_t),
+    skinny_aead_384_setup_key,
+    skinny_aead_m1_encrypt_with_context,
+    skinny_aead_m1_decrypt_with_context,
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_cipher_t const skinny_aead_m2_cipher = {
@@ -42,7 +48,13 @@ aead_cipher_t const skinny_aead_m2_cipher = {
     SKINNY_AEAD_M2_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN,
     skinny_aead_m2_encrypt,
-    skinny_aead_m2_decrypt
+    skinny_aead_m2_decrypt,
+    sizeof(skinny_128_384_key_schedule_t),
+    skinny_aead_384_setup_key,
+    skinny_aead_m2_encrypt_with_context,
+    skinny_aead_m2_decrypt_with_context,
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_cipher_t const skinny_aead_m3_cipher = {
@@ -52,7 +64,13 @@ aead_cipher_t const skinny_aead_m3_cipher = {
     SKINNY_AEAD_M3_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN,
     skinny_aead_m3_encrypt,
-    skinny_aead_m3_decrypt
+    skinny_aead_m3_decrypt,
+    sizeof(skinny_128_384_key_schedule_t),
+    skinny_aead_384_setup_key,
+    skinny_aead_m3_encrypt_with_context,
+    skinny_aead_m3_decrypt_with_context,
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_cipher_t const skinny_aead_m4_cipher = {
@@ -62,7 +80,13 @@ aead_cipher_t const skinny_aead_m4_cipher = {
     SKINNY_AEAD_M4_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN,
     skinny_aead_m4_encrypt,
-    skinny_aead_m4_decrypt
+    skinny_aead_m4_decrypt,
+    sizeof(skinny_128_384_key_schedule_t),
+    skinny_aead_384_setup_key,
+    skinny_aead_m4_encrypt_with_context,
+    skinny_aead_m4_decrypt_with_context,
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_cipher_t const skinny_aead_m5_cipher = {
@@ -72,7 +96,13 @@ aead_cipher_t const skinny_aead_m5_cipher = {
     SKINNY_AEAD_M5_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN,
     skinny_aead_m5_encrypt,
-    skinny_aead_m5_decrypt
+    skinny_aead_m5_decrypt,
+    sizeof(skinny_128_256_key_schedule_t),
+    skinny_aead_256_setup_key,
+    skinny_aead_m5_encrypt_with_context,
+    skinny_aead_m5_decrypt_with_context,
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_cipher_t const skinny_aead_m6_cipher = {
@@ -82,9 +112,30 @@ aead_cipher_t const skinny_aead_m6_cipher = {
     SKINNY_AEAD_M6_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN,
     skinny_aead_m6_encrypt,
-    skinny_aead_m6_decrypt
+    skinny_aead_m6_decrypt,
+    sizeof(skinny_128_256_key_schedule_t),
+    skinny_aead_256_setup_key,
+    skinny_aead_m6_encrypt_with_context,
+    skinny_aead_m6_decrypt_with_context,
+    0, /* stream */
+    0  /* batch */
 };
 
+/**
+ * \brief Number of blocks to gather before calling the multi-block
+ * SKINNY-128 kernels.
+ */
+#define SKINNY_AEAD_LANES SKINNY_128_MAX_LANES
+
+/**
+ * \brief Gets the number of full blocks to process in the next group.
+ *
+ * \param len Number of bytes that are left, at least one full block.
+ */
+#define skinny_aead_lanes(len) \
+    (((len) / SKINNY_128_BLOCK_SIZE) < SKINNY_AEAD_LANES ? \
+        (unsigned)((len) / SKINNY_128_BLOCK_SIZE) : SKINNY_AEAD_LANES)
+
 /* Domain separator prefixes for all of the SKINNY-AEAD family members */
 #define DOMAIN_SEP_M1 0x00
 #define DOMAIN_SEP_M2 0x10
@@ -154,16 +205,25 @@ static void skinny_aead_128_384_authenticate
      unsigned char tag[SKINNY_128_BLOCK_SIZE],
      const unsigned char *ad, unsigned long long adlen)
 {
-    unsigned char block[SKINNY_128_BLOCK_SIZE];
+    unsigned char block[SKINNY_AEAD_LANES * SKINNY_128_BLOCK_SIZE];
+    unsigned char tk1[SKINNY_AEAD_LANES * SKINNY_128_BLOCK_SIZE];
     uint64_t lfsr = 1;
+    unsigned count, index;
     skinny_aead_128_384_set_domain(ks, prefix | 2);
     while (adlen >= SKINNY_128_BLOCK_SIZE) {
-        skinny_aead_128_384_set_lfsr(ks, lfsr);
-        skinny_128_384_encrypt(ks, block, ad);
-        lw_xor_block(tag, block, SKINNY_128_BLOCK_SIZE);
-        ad += SKINNY_128_BLOCK_SIZE;
-        adlen -= SKINNY_128_BLOCK_SIZE;
-        skinny_aead_128_384_update_lfsr(lfsr);
+        count = skinny_aead_lanes(adlen);
+        for (index = 0; index < count; ++index) {
+            skinny_aead_128_384_set_lfsr(ks, lfsr);
+            memcpy(tk1 + index * SKINNY_128_BLOCK_SIZE, ks->TK1, 16);
+            skinny_aead_128_384_update_lfsr(lfsr);
+        }
+        skinny_128_384_encrypt_blocks(ks, tk1, block, ad, count);
+        for (index = 0; index < count; ++index) {
+            lw_xor_block(tag, block + index * SKINNY_128_BLOCK_SIZE,
+                         SKINNY_128_BLOCK_SIZE);
+        }
+        ad += count * SKINNY_128_BLOCK_SIZE;
+        adlen -= count * SKINNY_128_BLOCK_SIZE;
     }
     if (adlen > 0) {
         unsigned temp = (unsigned)adlen;
@@ -193,17 +253,24 @@ static void skinny_aead_128_384_encrypt
      const unsigned char *m, unsigned long long mlen)
 {
     unsigned char block[SKINNY_128_BLOCK_SIZE];
+    unsigned char tk1[SKINNY_AEAD_LANES * SKINNY_128_BLOCK_SIZE];
     uint64_t lfsr = 1;
+    unsigned count, index;
     memset(sum, 0, SKINNY_128_BLOCK_SIZE);
     skinny_aead_128_384_set_domain(ks, prefix | 0);
     while (mlen >= SKINNY_128_BLOCK_SIZE) {
-        skinny_aead_128_384_set_lfsr(ks, lfsr);
-        lw_xor_block(sum, m, SKINNY_128_BLOCK_SIZE);
-        skinny_128_384_encrypt(ks, c, m);
-        c += SKINNY_128_BLOCK_SIZE;
-        m += SKINNY_128_BLOCK_SIZE;
-        mlen -= SKINNY_128_BLOCK_SIZE;
-        skinny_aead_128_384_update_lfsr(lfsr);
+        count = skinny_aead_lanes(mlen);
+        for (index = 0; index < count; ++index) {
+            skinny_aead_128_384_set_lfsr(ks, lfsr);
+            memcpy(tk1 + index * SKINNY_128_BLOCK_SIZE, ks->TK1, 16);
+            lw_xor_block(sum, m + index * SKINNY_128_BLOCK_SIZE,
+                         SKINNY_128_BLOCK_SIZE);
+            skinny_aead_128_384_update_lfsr(lfsr);
+        }
+        skinny_128_384_encrypt_blocks(ks, tk1, c, m, count);
+        c += count * SKINNY_128_BLOCK_SIZE;
+        m += count * SKINNY_128_BLOCK_SIZE;
+        mlen -= count * SKINNY_128_BLOCK_SIZE;
     }
     skinny_aead_128_384_set_lfsr(ks, lfsr);
     if (mlen > 0) {
@@ -239,17 +306,26 @@ static void skinny_aead_128_384_decrypt
      const unsigned char *c, unsigned long long mlen)
 {
     unsigned char block[SKINNY_128_BLOCK_SIZE];
+    unsigned char tk1[SKINNY_AEAD_LANES * SKINNY_128_BLOCK_SIZE];
     uint64_t lfsr = 1;
+    unsigned count, index;
     memset(sum, 0, SKINNY_128_BLOCK_SIZE);
     skinny_aead_128_384_set_domain(ks, prefix | 0);
     while (mlen >= SKINNY_128_BLOCK_SIZE) {
-        skinny_aead_128_384_set_lfsr(ks, lfsr);
-        skinny_128_384_decrypt(ks, m, c);
-        lw_xor_block(sum, m, SKINNY_128_BLOCK_SIZE);
-        c += SKINNY_128_BLOCK_SIZE;
-        m += SKINNY_128_BLOCK_SIZE;
-        mlen -= SKINNY_128_BLOCK_SIZE;
-        skinny_aead_128_384_update_lfsr(lfsr);
+        count = skinny_aead_lanes(mlen);
+        for (index = 0; index < count; ++index) {
+            skinny_aead_128_384_set_lfsr(ks, lfsr);
+            memcpy(tk1 + index * SKINNY_128_BLOCK_SIZE, ks->TK1, 16);
+            skinny_aead_128_384_update_lfsr(lfsr);
+        }
+        skinny_128_384_decrypt_blocks(ks, tk1, m, c, count);
+        for (index = 0; index < count; ++index) {
+            lw_xor_block(sum, m + index * SKINNY_128_BLOCK_SIZE,
+                         SKINNY_128_BLOCK_SIZE);
+        }
+        c += count * SKINNY_128_BLOCK_SIZE;
+        m += count * SKINNY_128_BLOCK_SIZE;
+        mlen -= count * SKINNY_128_BLOCK_SIZE;
     }
     skinny_aead_128_384_set_lfsr(ks, lfsr);
     if (mlen > 0) {
@@ -269,6 +345,34 @@ static void skinny_aead_128_384_decrypt
     skinny_128_384_encrypt(ks, sum, sum);
 }
 
+/**
+ * \brief Sets the nonce in a copy of a cached SKINNY-128-384 key schedule.
+ *
+ * \param ks The key schedule, which was set up with a zero nonce.
+ * \param nonce Points to the nonce.
+ * \param nonce_len Length of the nonce in bytes.
+ *
+ * The nonce occupies TK2, so it is XOR'ed into the expanded schedule
+ * rather than expanding the key part of the tweakey again.
+ */
+static void skinny_aead_128_384_set_nonce
+    (skinny_128_384_key_schedule_t *ks, const unsigned char *nonce,
+     unsigned nonce_len)
+{
+    unsigned char tk2[16];
+    memcpy(tk2, nonce, nonce_len);
+    memset(tk2 + nonce_len, 0, 16 - nonce_len);
+    skinny_128_384_xor_tk2(ks, tk2);
+}
+
+void skinny_aead_384_setup_key(void *ctx, const unsigned char *k)
+{
+    unsigned char tk[48];
+    memset(tk, 0, 32);
+    memcpy(tk + 32, k, 16);
+    skinny_128_384_init((skinny_128_384_key_schedule_t *)ctx, tk);
+}
+
 int skinny_aead_m1_encrypt
     (unsigned char *c, unsigned long long *clen,
      const unsigned char *m, unsigned long long mlen,
@@ -328,6 +432,67 @@ int skinny_aead_m1_decrypt
     return aead_check_tag(m, *mlen, sum, c + *mlen, SKINNY_AEAD_M1_TAG_SIZE);
 }
 
+int skinny_aead_m1_encrypt_with_context
+    (unsigned char *c, unsigned long long *clen,
+     const unsigned char *m, unsigned long long mlen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *nsec,
+     const unsigned char *npub,
+     const void *ctx)
+{
+    skinny_128_384_key_schedule_t ks;
+    unsigned char sum[SKINNY_128_BLOCK_SIZE];
+    (void)nsec;
+
+    /* Set the length of the returned ciphertext */
+    *clen = mlen + SKINNY_AEAD_M1_TAG_SIZE;
+
+    /* Start with the cached key schedule and then add the nonce */
+    memcpy(&ks, ctx, sizeof(ks));
+    skinny_aead_128_384_set_nonce(&ks, npub, SKINNY_AEAD_M1_NONCE_SIZE);
+
+    /* Encrypt to plaintext to produce the ciphertext */
+    skinny_aead_128_384_encrypt(&ks, DOMAIN_SEP_M1, sum, c, m, mlen);
+
+    /* Process the associated data */
+    skinny_aead_128_384_authenticate(&ks, DOMAIN_SEP_M1, sum, ad, adlen);
+
+    /* Generate the authentication tag */
+    memcpy(c + mlen, sum, SKINNY_AEAD_M1_TAG_SIZE);
+    return 0;
+}
+
+int skinny_aead_m1_decrypt_with_context
+    (unsigned char *m, unsigned long long *mlen,
+     unsigned char *nsec,
+     const unsigned char *c, unsigned long long clen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *npub,
+     const void *ctx)
+{
+    skinny_128_384_key_schedule_t ks;
+    unsigned char sum[SKINNY_128_BLOCK_SIZE];
+    (void)nsec;
+
+    /* Validate the ciphertext length and set the return "mlen" value */
+    if (clen < SKINNY_AEAD_M1_TAG_SIZE)
+        return -1;
+    *mlen = clen - SKINNY_AEAD_M1_TAG_SIZE;
+
+    /* Start with the cached key schedule and then add the nonce */
+    memcpy(&ks, ctx, sizeof(ks));
+    skinny_aead_128_384_set_nonce(&ks, npub, SKINNY_AEAD_M1_NONCE_SIZE);
+
+    /* Decrypt to ciphertext to produce the plaintext */
+    skinny_aead_128_384_decrypt(&ks, DOMAIN_SEP_M1, sum, m, c, *mlen);
+
+    /* Process the associated data */
+    skinny_aead_128_384_authenticate(&ks, DOMAIN_SEP_M1, sum, ad, adlen);
+
+    /* Check the authentication tag */
+    return aead_check_tag(m, *mlen, sum, c + *mlen, SKINNY_AEAD_M1_TAG_SIZE);
+}
+
 int skinny_aead_m2_encrypt
     (unsigned char *c, unsigned long long *clen,
      const unsigned char *m, unsigned long long mlen,
@@ -387,6 +552,67 @@ int skinny_aead_m2_decrypt
     return aead_check_tag(m, *mlen, sum, c + *mlen, SKINNY_AEAD_M2_TAG_SIZE);
 }
 
+int skinny_aead_m2_encrypt_with_context
+    (unsigned char *c, unsigned long long *clen,
+     const unsigned char *m, unsigned long long mlen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *nsec,
+     const unsigned char *npub,
+     const void *ctx)
+{
+    skinny_128_384_key_schedule_t ks;
+    unsigned char sum[SKINNY_128_BLOCK_SIZE];
+    (void)nsec;
+
+    /* Set the length of the returned ciphertext */
+    *clen = mlen + SKINNY_AEAD_M2_TAG_SIZE;
+
+    /* Start with the cached key schedule and then add the nonce */
+    memcpy(&ks, ctx, sizeof(ks));
+    skinny_aead_128_384_set_nonce(&ks, npub, SKINNY_AEAD_M2_NONCE_SIZE);
+
+    /* Encrypt to plaintext to produce the ciphertext */
+    skinny_aead_128_384_encrypt(&ks, DOMAIN_SEP_M2, sum, c, m, mlen);
+
+    /* Process the associated data */
+    skinny_aead_128_384_authenticate(&ks, DOMAIN_SEP_M2, sum, ad, adlen);
+
+    /* Generate the authentication tag */
+    memcpy(c + mlen, sum, SKINNY_AEAD_M2_TAG_SIZE);
+    return 0;
+}
+
+int skinny_aead_m2_decrypt_with_context
+    (unsigned char *m, unsigned long long *mlen,
+     unsigned char *nsec,
+     const unsigned char *c, unsigned long long clen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *npub,
+     const void *ctx)
+{
+    skinny_128_384_key_schedule_t ks;
+    unsigned char sum[SKINNY_128_BLOCK_SIZE];
+    (void)nsec;
+
+    /* Validate the ciphertext length and set the return "mlen" value */
+    if (clen < SKINNY_AEAD_M2_TAG_SIZE)
+        return -1;
+    *mlen = clen - SKINNY_AEAD_M2_TAG_SIZE;
+
+    /* Start with the cached key schedule and then add the nonce */
+    memcpy(&ks, ctx, sizeof(ks));
+    skinny_aead_128_384_set_nonce(&ks, npub, SKINNY_AEAD_M2_NONCE_SIZE);
+
+    /* Decrypt to ciphertext to produce the plaintext */
+    skinny_aead_128_384_decrypt(&ks, DOMAIN_SEP_M2, sum, m, c, *mlen);
+
+    /* Process the associated data */
+    skinny_aead_128_384_authenticate(&ks, DOMAIN_SEP_M2, sum, ad, adlen);
+
+    /* Check the authentication tag */
+    return aead_check_tag(m, *mlen, sum, c + *mlen, SKINNY_AEAD_M2_TAG_SIZE);
+}
+
 int skinny_aead_m3_encrypt
     (unsigned char *c, unsigned long long *clen,
      const unsigned char *m, unsigned long long mlen,
@@ -446,6 +672,67 @@ int skinny_aead_m3_decrypt
     return aead_check_tag(m, *mlen, sum, c + *mlen, SKINNY_AEAD_M3_TAG_SIZE);
 }
 
+int skinny_aead_m3_encrypt_with_context
+    (unsigned char *c, unsigned long long *clen,
+     const unsigned char *m, unsigned long long mlen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *nsec,
+     const unsigned char *npub,
+     const void *ctx)
+{
+    skinny_128_384_key_schedule_t ks;
+    unsigned char sum[SKINNY_128_BLOCK_SIZE];
+    (void)nsec;
+
+    /* Set the length of the returned ciphertext */
+    *clen = mlen + SKINNY_AEAD_M3_TAG_SIZE;
+
+    /* Start with the cached key schedule and then add the nonce */
+    memcpy(&ks, ctx, sizeof(ks));
+    skinny_aead_128_384_set_nonce(&ks, npub, SKINNY_AEAD_M3_NONCE_SIZE);
+
+    /* Encrypt to plaintext to produce the ciphertext */
+    skinny_aead_128_384_encrypt(&ks, DOMAIN_SEP_M3, sum, c, m, mlen);
+
+    /* Process the associated data */
+    skinny_aead_128_384_authenticate(&ks, DOMAIN_SEP_M3, sum, ad, adlen);
+
+    /* Generate the authentication tag */
+    memcpy(c + mlen, sum, SKINNY_AEAD_M3_TAG_SIZE);
+    return 0;
+}
+
+int skinny_aead_m3_decrypt_with_context
+    (unsigned char *m, unsigned long long *mlen,
+     unsigned char *nsec,
+     const unsigned char *c, unsigned long long clen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *npub,
+     const void *ctx)
+{
+    skinny_128_384_key_schedule_t ks;
+    unsigned char sum[SKINNY_128_BLOCK_SIZE];
+    (void)nsec;
+
+    /* Validate the ciphertext length and set the return "mlen" value */
+    if (clen < SKINNY_AEAD_M3_TAG_SIZE)
+        return -1;
+    *mlen = clen - SKINNY_AEAD_M3_TAG_SIZE;
+
+    /* Start with the cached key schedule and then add the nonce */
+    memcpy(&ks, ctx, sizeof(ks));
+    skinny_aead_128_384_set_nonce(&ks, npub, SKINNY_AEAD_M3_NONCE_SIZE);
+
+    /* Decrypt to ciphertext to produce the plaintext */
+    skinny_aead_128_384_decrypt(&ks, DOMAIN_SEP_M3, sum, m, c, *mlen);
+
+    /* Process the associated data */
+    skinny_aead_128_384_authenticate(&ks, DOMAIN_SEP_M3, sum, ad, adlen);
+
+    /* Check the authentication tag */
+    return aead_check_tag(m, *mlen, sum, c + *mlen, SKINNY_AEAD_M3_TAG_SIZE);
+}
+
 int skinny_aead_m4_encrypt
     (unsigned char *c, unsigned long long *clen,
      const unsigned char *m, unsigned long long mlen,
@@ -505,6 +792,67 @@ int skinny_aead_m4_decrypt
     return aead_check_tag(m, *mlen, sum, c + *mlen, SKINNY_AEAD_M4_TAG_SIZE);
 }
 
+int skinny_aead_m4_encrypt_with_context
+    (unsigned char *c, unsigned long long *clen,
+     const unsigned char *m, unsigned long long mlen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *nsec,
+     const unsigned char *npub,
+     const void *ctx)
+{
+    skinny_128_384_key_schedule_t ks;
+    unsigned char sum[SKINNY_128_BLOCK_SIZE];
+    (void)nsec;
+
+    /* Set the length of the returned ciphertext */
+    *clen = mlen + SKINNY_AEAD_M4_TAG_SIZE;
+
+    /* Start with the cached key schedule and then add the nonce */
+    memcpy(&ks, ctx, sizeof(ks));
+    skinny_aead_128_384_set_nonce(&ks, npub, SKINNY_AEAD_M4_NONCE_SIZE);
+
+    /* Encrypt to plaintext to produce the ciphertext */
+    skinny_aead_128_384_encrypt(&ks, DOMAIN_SEP_M4, sum, c, m, mlen);
+
+    /* Process the associated data */
+    skinny_aead_128_384_authenticate(&ks, DOMAIN_SEP_M4, sum, ad, adlen);
+
+    /* Generate the authentication tag */
+    memcpy(c + mlen, sum, SKINNY_AEAD_M4_TAG_SIZE);
+    return 0;
+}
+
+int skinny_aead_m4_decrypt_with_context
+    (unsigned char *m, unsigned long long *mlen,
+     unsigned char *nsec,
+     const unsigned char *c, unsigned long long clen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *npub,
+     const void *ctx)
+{
+    skinny_128_384_key_schedule_t ks;
+    unsigned char sum[SKINNY_128_BLOCK_SIZE];
+    (void)nsec;
+
+    /* Validate the ciphertext length and set the return "mlen" value */
+    if (clen < SKINNY_AEAD_M4_TAG_SIZE)
+        return -1;
+    *mlen = clen - SKINNY_AEAD_M4_TAG_SIZE;
+
+    /* Start with the cached key schedule and then add the nonce */
+    memcpy(&ks, ctx, sizeof(ks));
+    skinny_aead_128_384_set_nonce(&ks, npub, SKINNY_AEAD_M4_NONCE_SIZE);
+
+    /* Decrypt to ciphertext to produce the plaintext */
+    skinny_aead_128_384_decrypt(&ks, DOMAIN_SEP_M4, sum, m, c, *mlen);
+
+    /* Process the associated data */
+    skinny_aead_128_384_authenticate(&ks, DOMAIN_SEP_M4, sum, ad, adlen);
+
+    /* Check the authentication tag */
+    return aead_check_tag(m, *mlen, sum, c + *mlen, SKINNY_AEAD_M4_TAG_SIZE);
+}
+
 /**
  * \brief Initialize the key and nonce for SKINNY-128-256 based AEAD schemes.
  *
@@ -570,16 +918,25 @@ static void skinny_aead_128_256_authenticate
      unsigned char tag[SKINNY_128_BLOCK_SIZE],
      const unsigned char *ad, unsigned long long adlen)
 {
-    unsigned char block[SKINNY_128_BLOCK_SIZE];
+    unsigned char block[SKINNY_AEAD_LANES * SKINNY_128_BLOCK_SIZE];
+    unsigned char tk1[SKINNY_AEAD_LANES * SKINNY_128_BLOCK_SIZE];
     uint32_t lfsr = 1;
+    unsigned count, index;
     skinny_aead_128_256_set_domain(ks, prefix | 2);
     while (adlen >= SKINNY_128_BLOCK_SIZE) {
-        skinny_aead_128_256_set_lfsr(ks, lfsr);
-        skinny_128_256_encrypt(ks, block, ad);
-        lw_xor_block(tag, block, SKINNY_128_BLOCK_SIZE);
-        ad += SKINNY_128_BLOCK_SIZE;
-        adlen -= SKINNY_128_BLOCK_SIZE;
-        skinny_aead_128_256_update_lfsr(lfsr);
+        count = skinny_aead_lanes(adlen);
+        for (index = 0; index < count; ++index) {
+            skinny_aead_128_256_set_lfsr(ks, lfsr);
+            memcpy(tk1 + index * SKINNY_128_BLOCK_SIZE, ks->TK1, 16);
+            skinny_aead_128_256_update_lfsr(lfsr);
+        }
+        skinny_128_256_encrypt_blocks(ks, tk1, block, ad, count);
+        for (index = 0; index < count; ++index) {
+            lw_xor_block(tag, block + index * SKINNY_128_BLOCK_SIZE,
+                         SKINNY_128_BLOCK_SIZE);
+        }
+        ad += count * SKINNY_128_BLOCK_SIZE;
+        adlen -= count * SKINNY_128_BLOCK_SIZE;
     }
     if (adlen > 0) {
         unsigned temp = (unsigned)adlen;
@@ -609,17 +966,24 @@ static void skinny_aead_128_256_encrypt
      const unsigned char *m, unsigned long long mlen)
 {
     unsigned char block[SKINNY_128_BLOCK_SIZE];
+    unsigned char tk1[SKINNY_AEAD_LANES * SKINNY_128_BLOCK_SIZE];
     uint32_t lfsr = 1;
+    unsigned count, index;
     memset(sum, 0, SKINNY_128_BLOCK_SIZE);
     skinny_aead_128_256_set_domain(ks, prefix | 0);
     while (mlen >= SKINNY_128_BLOCK_SIZE) {
-        skinny_aead_128_256_set_lfsr(ks, lfsr);
-        lw_xor_block(sum, m, SKINNY_128_BLOCK_SIZE);
-        skinny_128_256_encrypt(ks, c, m);
-        c += SKINNY_128_BLOCK_SIZE;
-        m += SKINNY_128_BLOCK_SIZE;
-        mlen -= SKINNY_128_BLOCK_SIZE;
-        skinny_aead_128_256_update_lfsr(lfsr);
+        count = skinny_aead_lanes(mlen);
+        for (index = 0; index < count; ++index) {
+            skinny_aead_128_256_set_lfsr(ks, lfsr);
+            memcpy(tk1 + index * SKINNY_128_BLOCK_SIZE, ks->TK1, 16);
+            lw_xor_block(sum, m + index * SKINNY_128_BLOCK_SIZE,
+                         SKINNY_128_BLOCK_SIZE);
+            skinny_aead_128_256_update_lfsr(lfsr);
+        }
+        skinny_128_256_encrypt_blocks(ks, tk1, c, m, count);
+        c += count * SKINNY_128_BLOCK_SIZE;
+        m += count * SKINNY_128_BLOCK_SIZE;
+        mlen -= count * SKINNY_128_BLOCK_SIZE;
     }
     skinny_aead_128_256_set_lfsr(ks, lfsr);
     if (mlen > 0) {
@@ -655,17 +1019,26 @@ static void skinny_aead_128_256_decrypt
      const unsigned char *c, unsigned long long mlen)
 {
     unsigned char block[SKINNY_128_BLOCK_SIZE];
+    unsigned char tk1[SKINNY_AEAD_LANES * SKINNY_128_BLOCK_SIZE];
     uint32_t lfsr = 1;
+    unsigned count, index;
     memset(sum, 0, SKINNY_128_BLOCK_SIZE);
     skinny_aead_128_256_set_domain(ks, prefix | 0);
     while (mlen >= SKINNY_128_BLOCK_SIZE) {
-        skinny_aead_128_256_set_lfsr(ks, lfsr);
-        skinny_128_256_decrypt(ks, m, c);
-        lw_xor_block(sum, m, SKINNY_128_BLOCK_SIZE);
-        c += SKINNY_128_BLOCK_SIZE;
-        m += SKINNY_128_BLOCK_SIZE;
-        mlen -= SKINNY_128_BLOCK_SIZE;
-        skinny_aead_128_256_update_lfsr(lfsr);
+        count = skinny_aead_lanes(mlen);
+        for (index = 0; index < count; ++index) {
+            skinny_aead_128_256_set_lfsr(ks, lfsr);
+            memcpy(tk1 + index * SKINNY_128_BLOCK_SIZE, ks->TK1, 16);
+            skinny_aead_128_256_update_lfsr(lfsr);
+        }
+        skinny_128_256_decrypt_blocks(ks, tk1, m, c, count);
+        for (index = 0; index < count; ++index) {
+            lw_xor_block(sum, m + index * SKINNY_128_BLOCK_SIZE,
+                         SKINNY_128_BLOCK_SIZE);
+        }
+        c += count * SKINNY_128_BLOCK_SIZE;
+        m += count * SKINNY_128_BLOCK_SIZE;
+        mlen -= count * SKINNY_128_BLOCK_SIZE;
     }
     skinny_aead_128_256_set_lfsr(ks, lfsr);
     if (mlen > 0) {
@@ -685,6 +1058,27 @@ static void skinny_aead_128_256_decrypt
     skinny_128_256_encrypt(ks, sum, sum);
 }
 
+/**
+ * \brief Sets the nonce in a copy of a cached SKINNY-128-256 key schedule.
+ *
+ * \param ks The key schedule, which was set up with a zero nonce.
+ * \param nonce Points to the nonce.
+ * \param nonce_len Length of the nonce in bytes.
+ *
+ * The nonce occupies TK1, which is not expanded into the key schedule,
+ * so it can be copied into place directly.
+ */
+#define skinny_aead_128_256_set_nonce(ks,nonce,nonce_len) \
+    memcpy((ks)->TK1 + 16 - (nonce_len), (nonce), (nonce_len))
+
+void skinny_aead_256_setup_key(void *ctx, const unsigned char *k)
+{
+    unsigned char tk[32];
+    memset(tk, 0, 16);
+    memcpy(tk + 16, k, 16);
+    skinny_128_256_init((skinny_128_256_key_schedule_t *)ctx, tk);
+}
+
 int skinny_aead_m5_encrypt
     (unsigned char *c, unsigned long long *clen,
      const unsigned char *m, unsigned long long mlen,
@@ -744,6 +1138,67 @@ int skinny_aead_m5_decrypt
     return aead_check_tag(m, *mlen, sum, c + *mlen, SKINNY_AEAD_M5_TAG_SIZE);
 }
 
+int skinny_aead_m5_encrypt_with_context
+    (unsigned char *c, unsigned long long *clen,
+     const unsigned char *m, unsigned long long mlen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *nsec,
+     const unsigned char *npub,
+     const void *ctx)
+{
+    skinny_128_256_key_schedule_t ks;
+    unsigned char sum[SKINNY_128_BLOCK_SIZE];
+    (void)nsec;
+
+    /* Set the length of the returned ciphertext */
+    *clen = mlen + SKINNY_AEAD_M5_TAG_SIZE;
+
+    /* Start with the cached key schedule and then add the nonce */
+    memcpy(&ks, ctx, sizeof(ks));
+    skinny_aead_128_256_set_nonce(&ks, npub, SKINNY_AEAD_M5_NONCE_SIZE);
+
+    /* Encrypt to plaintext to produce the ciphertext */
+    skinny_aead_128_256_encrypt(&ks, DOMAIN_SEP_M5, sum, c, m, mlen);
+
+    /* Process the associated data */
+    skinny_aead_128_256_authenticate(&ks, DOMAIN_SEP_M5, sum, ad, adlen);
+
+    /* Generate the authentication tag */
+    memcpy(c + mlen, sum, SKINNY_AEAD_M5_TAG_SIZE);
+    return 0;
+}
+
+int skinny_aead_m5_decrypt_with_context
+    (unsigned char *m, unsigned long long *mlen,
+     unsigned char *nsec,
+     const unsigned char *c, unsigned long long clen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *npub,
+     const void *ctx)
+{
+    skinny_128_256_key_schedule_t ks;
+    unsigned char sum[SKINNY_128_BLOCK_SIZE];
+    (void)nsec;
+
+    /* Validate the ciphertext length and set the return "mlen" value */
+    if (clen < SKINNY_AEAD_M5_TAG_SIZE)
+        return -1;
+    *mlen = clen - SKINNY_AEAD_M5_TAG_SIZE;
+
+    /* Start with the cached key schedule and then add the nonce */
+    memcpy(&ks, ctx, sizeof(ks));
+    skinny_aead_128_256_set_nonce(&ks, npub, SKINNY_AEAD_M5_NONCE_SIZE);
+
+    /* Decrypt to ciphertext to produce the plaintext */
+    skinny_aead_128_256_decrypt(&ks, DOMAIN_SEP_M5, sum, m, c, *mlen);
+
+    /* Process the associated data */
+    skinny_aead_128_256_authenticate(&ks, DOMAIN_SEP_M5, sum, ad, adlen);
+
+    /* Check the authentication tag */
+    return aead_check_tag(m, *mlen, sum, c + *mlen, SKINNY_AEAD_M5_TAG_SIZE);
+}
+
 int skinny_aead_m6_encrypt
     (unsigned char *c, unsigned long long *clen,
      const unsigned char *m, unsigned long long mlen,
@@ -802,3 +1257,64 @@ int skinny_aead_m6_decrypt
     /* Check the authentication tag */
     return aead_check_tag(m, *mlen, sum, c + *mlen, SKINNY_AEAD_M6_TAG_SIZE);
 }
+
+int skinny_aead_m6_encrypt_with_context
+    (unsigned char *c, unsigned long long *clen,
+     const unsigned char *m, unsigned long long mlen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *nsec,
+     const unsigned char *npub,
+     const void *ctx)
+{
+    skinny_128_256_key_schedule_t ks;
+    unsigned char sum[SKINNY_128_BLOCK_SIZE];
+    (void)nsec;
+
+    /* Set the length of the returned ciphertext */
+    *clen = mlen + SKINNY_AEAD_M6_TAG_SIZE;
+
+    /* Start with the cached key schedule and then add the nonce */
+    memcpy(&ks, ctx, sizeof(ks));
+    skinny_aead_128_256_set_nonce(&ks, npub, SKINNY_AEAD_M6_NONCE_SIZE);
+
+    /* Encrypt to plaintext to produce the ciphertext */
+    skinny_aead_128_256_encrypt(&ks, DOMAIN_SEP_M6, sum, c, m, mlen);
+
+    /* Process the associated data */
+    skinny_aead_128_256_authenticate(&ks, DOMAIN_SEP_M6, sum, ad, adlen);
+
+    /* Generate the authentication tag */
+    memcpy(c + mlen, sum, SKINNY_AEAD_M6_TAG_SIZE);
+    return 0;
+}
+
+int skinny_aead_m6_decrypt_with_context
+    (unsigned char *m, unsigned long long *mlen,
+     unsigned char *nsec,
+     const unsigned char *c, unsigned long long clen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *npub,
+     const void *ctx)
+{
+    skinny_128_256_key_schedule_t ks;
+    unsigned char sum[SKINNY_128_BLOCK_SIZE];
+    (void)nsec;
+
+    /* Validate the ciphertext length and set the return "mlen" value */
+    if (clen < SKINNY_AEAD_M6_TAG_SIZE)
+        return -1;
+    *mlen = clen - SKINNY_AEAD_M6_TAG_SIZE;
+
+    /* Start with the cached key schedule and then add the nonce */
+    memcpy(&ks, ctx, sizeof(ks));
+    skinny_aead_128_256_set_nonce(&ks, npub, SKINNY_AEAD_M6_NONCE_SIZE);
+
+    /* Decrypt to ciphertext to produce the plaintext */
+    skinny_aead_128_256_decrypt(&ks, DOMAIN_SEP_M6, sum, m, c, *mlen);
+
+    /* Process the associated data */
+    skinny_aead_128_256_authenticate(&ks, DOMAIN_SEP_M6, sum, ad, adlen);
+
+    /* Check the authentication tag */
+    return aead_check_tag(m, *mlen, sum, c + *mlen, SKINNY_AEAD_M6_TAG_SIZE);
+}
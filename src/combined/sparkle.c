@@ -24,6 +24,58 @@
 #include "internal-sparkle.h"
 #include <string.h>
 
+/**
+ * \brief Incremental AEAD functions for Schwaemm256-128.
+ */
+static aead_stream_cipher_t const schwaemm_256_128_stream_cipher = {
+    sizeof(schwaemm_aead_state_t),
+    (aead_stream_init_t)schwaemm_256_128_aead_stream_init,
+    (aead_stream_update_ad_t)schwaemm_aead_stream_update_ad,
+    (aead_stream_crypt_t)schwaemm_aead_stream_encrypt,
+    (aead_stream_crypt_t)schwaemm_aead_stream_decrypt,
+    (aead_stream_encrypt_finalize_t)schwaemm_aead_stream_encrypt_finalize,
+    (aead_stream_decrypt_finalize_t)schwaemm_aead_stream_decrypt_finalize
+};
+
+/**
+ * \brief Incremental AEAD functions for Schwaemm192-192.
+ */
+static aead_stream_cipher_t const schwaemm_192_192_stream_cipher = {
+    sizeof(schwaemm_aead_state_t),
+    (aead_stream_init_t)schwaemm_192_192_aead_stream_init,
+    (aead_stream_update_ad_t)schwaemm_aead_stream_update_ad,
+    (aead_stream_crypt_t)schwaemm_aead_stream_encrypt,
+    (aead_stream_crypt_t)schwaemm_aead_stream_decrypt,
+    (aead_stream_encrypt_finalize_t)schwaemm_aead_stream_encrypt_finalize,
+    (aead_stream_decrypt_finalize_t)schwaemm_aead_stream_decrypt_finalize
+};
+
+/**
+ * \brief Incremental AEAD functions for Schwaemm128-128.
+ */
+static aead_stream_cipher_t const schwaemm_128_128_stream_cipher = {
+    sizeof(schwaemm_aead_state_t),
+    (aead_stream_init_t)schwaemm_128_128_aead_stream_init,
+    (aead_stream_update_ad_t)schwaemm_aead_stream_update_ad,
+    (aead_stream_crypt_t)schwaemm_aead_stream_encrypt,
+    (aead_stream_crypt_t)schwaemm_aead_stream_decrypt,
+    (aead_stream_encrypt_finalize_t)schwaemm_aead_stream_encrypt_finalize,
+    (aead_stream_decrypt_finalize_t)schwaemm_aead_stream_decrypt_finalize
+};
+
+/**
+ * \brief Incremental AEAD functions for Schwaemm256-256.
+ */
+static aead_stream_cipher_t const schwaemm_256_256_stream_cipher = {
+    sizeof(schwaemm_aead_state_t),
+    (aead_stream_init_t)schwaemm_256_256_aead_stream_init,
+    (aead_stream_update_ad_t)schwaemm_aead_stream_update_ad,
+    (aead_stream_crypt_t)schwaemm_aead_stream_encrypt,
+    (aead_stream_crypt_t)schwaemm_aead_stream_decrypt,
+    (aead_stream_encrypt_finalize_t)schwaemm_aead_stream_encrypt_finalize,
+    (aead_stream_decrypt_finalize_t)schwaemm_aead_stream_decrypt_finalize
+};
+
 aead_cipher_t const schwaemm_256_128_cipher = {
     "Schwaemm256-128",
     SCHWAEMM_256_128_KEY_SIZE,
@@ -31,7 +83,13 @@ aead_cipher_t const schwaemm_256_128_cipher = {
     SCHWAEMM_256_128_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN,
     schwaemm_256_128_aead_encrypt,
-    schwaemm_256_128_aead_decrypt
+    schwaemm_256_128_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    &schwaemm_256_128_stream_cipher,
+    0  /* batch */
 };
 
 aead_cipher_t const schwaemm_192_192_cipher = {
@@ -41,7 +99,13 @@ aead_cipher_t const schwaemm_192_192_cipher = {
     SCHWAEMM_192_192_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN,
     schwaemm_192_192_aead_encrypt,
-    schwaemm_192_192_aead_decrypt
+    schwaemm_192_192_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    &schwaemm_192_192_stream_cipher,
+    0  /* batch */
 };
 
 aead_cipher_t const schwaemm_128_128_cipher = {
@@ -51,7 +115,13 @@ aead_cipher_t const schwaemm_128_128_cipher = {
     SCHWAEMM_128_128_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN,
     schwaemm_128_128_aead_encrypt,
-    schwaemm_128_128_aead_decrypt
+    schwaemm_128_128_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    &schwaemm_128_128_stream_cipher,
+    0  /* batch */
 };
 
 aead_cipher_t const schwaemm_256_256_cipher = {
@@ -61,7 +131,13 @@ aead_cipher_t const schwaemm_256_256_cipher = {
     SCHWAEMM_256_256_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN,
     schwaemm_256_256_aead_encrypt,
-    schwaemm_256_256_aead_decrypt
+    schwaemm_256_256_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    &schwaemm_256_256_stream_cipher,
+    0  /* batch */
 };
 
 aead_hash_algorithm_t const esch_256_hash_algorithm = {
@@ -874,6 +950,280 @@ int schwaemm_256_256_aead_decrypt
         (mtemp, *mlen, SCHWAEMM_256_256_RIGHT(s), c, SCHWAEMM_256_256_TAG_SIZE);
 }
 
+/**
+ * \brief Parameters for a Schwaemm variant in incremental mode.
+ */
+typedef struct
+{
+    void (*permute)(uint32_t *s, unsigned steps); /**< SPARKLE permutation */
+    unsigned char state_words;  /**< Number of words in the state */
+    unsigned char rate;         /**< Rate in bytes */
+    unsigned char capacity;     /**< Capacity in bytes */
+    unsigned char slim_steps;   /**< Steps for intermediate blocks */
+    unsigned char big_steps;    /**< Steps for the final block of a phase */
+    unsigned char domain;       /**< Base domain separator value */
+    unsigned char key_size;     /**< Size of the key and the nonce */
+    unsigned char tag_size;     /**< Size of the authentication tag */
+
+} schwaemm_stream_params_t;
+
+/**
+ * \brief Parameters for the Schwaemm variants in incremental mode.
+ */
+static schwaemm_stream_params_t const schwaemm_stream_params[] = {
+    {sparkle_384, SPARKLE_384_STATE_SIZE, SCHWAEMM_256_128_RATE, 16,
+     7, 11, 0x04, SCHWAEMM_256_128_KEY_SIZE, SCHWAEMM_256_128_TAG_SIZE},
+    {sparkle_384, SPARKLE_384_STATE_SIZE, SCHWAEMM_192_192_RATE, 24,
+     7, 11, 0x08, SCHWAEMM_192_192_KEY_SIZE, SCHWAEMM_192_192_TAG_SIZE},
+    {sparkle_256, SPARKLE_256_STATE_SIZE, SCHWAEMM_128_128_RATE, 16,
+     7, 10, 0x04, SCHWAEMM_128_128_KEY_SIZE, SCHWAEMM_128_128_TAG_SIZE},
+    {sparkle_512, SPARKLE_512_STATE_SIZE, SCHWAEMM_256_256_RATE, 32,
+     8, 12, 0x10, SCHWAEMM_256_256_KEY_SIZE, SCHWAEMM_256_256_TAG_SIZE}
+};
+
+#define SCHWAEMM_STREAM_MODE_INIT 0
+#define SCHWAEMM_STREAM_MODE_AD 1
+#define SCHWAEMM_STREAM_MODE_PAYLOAD 2
+
+/**
+ * \brief Initializes an incremental Schwaemm state for a specific variant.
+ *
+ * \param state The incremental AEAD state.
+ * \param npub Points to the nonce.
+ * \param k Points to the key.
+ * \param variant Index of the variant in schwaemm_stream_params.
+ */
+static void schwaemm_aead_stream_init
+    (schwaemm_aead_state_t *state, const unsigned char *npub,
+     const unsigned char *k, unsigned char variant)
+{
+    const schwaemm_stream_params_t *params = &(schwaemm_stream_params[variant]);
+    memcpy(state->s.state, npub, params->rate);
+    memcpy(state->s.state + params->rate, k, params->key_size);
+    memcpy(state->s.key, k, params->key_size);
+    params->permute((uint32_t *)(state->s.state), params->big_steps);
+    state->s.count = 0;
+    state->s.mode = SCHWAEMM_STREAM_MODE_INIT;
+    state->s.variant = variant;
+}
+
+void schwaemm_256_128_aead_stream_init
+    (schwaemm_aead_state_t *state, const unsigned char *npub,
+     const unsigned char *k)
+{
+    schwaemm_aead_stream_init(state, npub, k, 0);
+}
+
+void schwaemm_192_192_aead_stream_init
+    (schwaemm_aead_state_t *state, const unsigned char *npub,
+     const unsigned char *k)
+{
+    schwaemm_aead_stream_init(state, npub, k, 1);
+}
+
+void schwaemm_128_128_aead_stream_init
+    (schwaemm_aead_state_t *state, const unsigned char *npub,
+     const unsigned char *k)
+{
+    schwaemm_aead_stream_init(state, npub, k, 2);
+}
+
+void schwaemm_256_256_aead_stream_init
+    (schwaemm_aead_state_t *state, const unsigned char *npub,
+     const unsigned char *k)
+{
+    schwaemm_aead_stream_init(state, npub, k, 3);
+}
+
+/**
+ * \brief Performs the rho1 and rate whitening steps for any Schwaemm variant
+ * and then absorbs the buffered block.
+ *
+ * \param state The incremental AEAD state.
+ * \param params Parameters for the Schwaemm variant.
+ */
+static void schwaemm_aead_stream_rho
+    (schwaemm_aead_state_t *state, const schwaemm_stream_params_t *params)
+{
+    uint32_t *s = (uint32_t *)(state->s.state);
+    unsigned rate_words = params->rate / 4;
+    unsigned cap_words = params->capacity / 4;
+    unsigned half = rate_words / 2;
+    unsigned index;
+    uint32_t t;
+    for (index = 0; index < half; ++index) {
+        t = s[index];
+        s[index] = s[index + half] ^ s[rate_words + (index % cap_words)];
+        s[index + half] ^=
+            t ^ s[rate_words + ((index + half) % cap_words)];
+    }
+    lw_xor_block(state->s.state, state->s.block, state->s.count);
+}
+
+/**
+ * \brief Absorbs a full buffered block that is not the last in its phase.
+ *
+ * \param state The incremental AEAD state.
+ * \param params Parameters for the Schwaemm variant.
+ */
+static void schwaemm_aead_stream_absorb_block
+    (schwaemm_aead_state_t *state, const schwaemm_stream_params_t *params)
+{
+    schwaemm_aead_stream_rho(state, params);
+    params->permute((uint32_t *)(state->s.state), params->slim_steps);
+    state->s.count = 0;
+}
+
+/**
+ * \brief Absorbs the buffered block as the last block in its phase.
+ *
+ * \param state The incremental AEAD state.
+ * \param params Parameters for the Schwaemm variant.
+ * \param domain Domain separator for the phase; incremented for full blocks.
+ */
+static void schwaemm_aead_stream_absorb_last
+    (schwaemm_aead_state_t *state, const schwaemm_stream_params_t *params,
+     unsigned char domain)
+{
+    uint32_t *s = (uint32_t *)(state->s.state);
+    if (state->s.count == params->rate)
+        ++domain;
+    s[params->state_words - 1] ^= DOMAIN(domain);
+    schwaemm_aead_stream_rho(state, params);
+    if (state->s.count < params->rate)
+        state->s.state[state->s.count] ^= 0x80;
+    params->permute(s, params->big_steps);
+    state->s.count = 0;
+}
+
+void schwaemm_aead_stream_update_ad
+    (schwaemm_aead_state_t *state, const unsigned char *ad,
+     unsigned long long adlen)
+{
+    const schwaemm_stream_params_t *params =
+        &(schwaemm_stream_params[state->s.variant]);
+    unsigned temp;
+    if (!adlen)
+        return;
+    state->s.mode = SCHWAEMM_STREAM_MODE_AD;
+
+    /* The last block is processed differently, so a full block is
+     * not absorbed until we know that more data follows it */
+    while (adlen > 0) {
+        if (state->s.count == params->rate)
+            schwaemm_aead_stream_absorb_block(state, params);
+        temp = params->rate - state->s.count;
+        if (temp > adlen)
+            temp = (unsigned)adlen;
+        memcpy(state->s.block + state->s.count, ad, temp);
+        state->s.count += temp;
+        ad += temp;
+        adlen -= temp;
+    }
+}
+
+void schwaemm_aead_stream_encrypt
+    (schwaemm_aead_state_t *state, unsigned char *c,
+     const unsigned char *m, unsigned long long len)
+{
+    const schwaemm_stream_params_t *params =
+        &(schwaemm_stream_params[state->s.variant]);
+    unsigned temp;
+    if (!len)
+        return;
+    if (state->s.mode != SCHWAEMM_STREAM_MODE_PAYLOAD) {
+        if (state->s.mode == SCHWAEMM_STREAM_MODE_AD)
+            schwaemm_aead_stream_absorb_last(state, params, params->domain);
+        state->s.mode = SCHWAEMM_STREAM_MODE_PAYLOAD;
+    }
+    while (len > 0) {
+        if (state->s.count == params->rate)
+            schwaemm_aead_stream_absorb_block(state, params);
+        temp = params->rate - state->s.count;
+        if (temp > len)
+            temp = (unsigned)len;
+        memcpy(state->s.block + state->s.count, m, temp);
+        lw_xor_block_2_src
+            (c, state->s.state + state->s.count,
+             state->s.block + state->s.count, temp);
+        state->s.count += temp;
+        c += temp;
+        m += temp;
+        len -= temp;
+    }
+}
+
+void schwaemm_aead_stream_decrypt
+    (schwaemm_aead_state_t *state, unsigned char *m,
+     const unsigned char *c, unsigned long long len)
+{
+    const schwaemm_stream_params_t *params =
+        &(schwaemm_stream_params[state->s.variant]);
+    unsigned temp;
+    if (!len)
+        return;
+    if (state->s.mode != SCHWAEMM_STREAM_MODE_PAYLOAD) {
+        if (state->s.mode == SCHWAEMM_STREAM_MODE_AD)
+            schwaemm_aead_stream_absorb_last(state, params, params->domain);
+        state->s.mode = SCHWAEMM_STREAM_MODE_PAYLOAD;
+    }
+    while (len > 0) {
+        if (state->s.count == params->rate)
+            schwaemm_aead_stream_absorb_block(state, params);
+        temp = params->rate - state->s.count;
+        if (temp > len)
+            temp = (unsigned)len;
+        lw_xor_block_2_src
+            (state->s.block + state->s.count,
+             state->s.state + state->s.count, c, temp);
+        memcpy(m, state->s.block + state->s.count, temp);
+        state->s.count += temp;
+        c += temp;
+        m += temp;
+        len -= temp;
+    }
+}
+
+/**
+ * \brief Computes the authentication tag for an incremental Schwaemm state.
+ *
+ * \param state The incremental AEAD state.
+ *
+ * \return The size of the authentication tag, which is left in the
+ * state immediately after the rate bytes.
+ */
+static unsigned schwaemm_aead_stream_compute_tag(schwaemm_aead_state_t *state)
+{
+    const schwaemm_stream_params_t *params =
+        &(schwaemm_stream_params[state->s.variant]);
+    if (state->s.mode == SCHWAEMM_STREAM_MODE_PAYLOAD)
+        schwaemm_aead_stream_absorb_last(state, params, params->domain + 2);
+    else if (state->s.mode == SCHWAEMM_STREAM_MODE_AD)
+        schwaemm_aead_stream_absorb_last(state, params, params->domain);
+    lw_xor_block(state->s.state + params->rate, state->s.key,
+                 params->tag_size);
+    return params->tag_size;
+}
+
+void schwaemm_aead_stream_encrypt_finalize
+    (schwaemm_aead_state_t *state, unsigned char *tag)
+{
+    const schwaemm_stream_params_t *params =
+        &(schwaemm_stream_params[state->s.variant]);
+    unsigned tag_size = schwaemm_aead_stream_compute_tag(state);
+    memcpy(tag, state->s.state + params->rate, tag_size);
+}
+
+int schwaemm_aead_stream_decrypt_finalize
+    (schwaemm_aead_state_t *state, const unsigned char *tag)
+{
+    const schwaemm_stream_params_t *params =
+        &(schwaemm_stream_params[state->s.variant]);
+    unsigned tag_size = schwaemm_aead_stream_compute_tag(state);
+    return aead_check_tag
+        (0, 0, state->s.state + params->rate, tag, tag_size);
+}
+
 /**
  * \brief Rate at which bytes are processed by Esch256.
  */
@@ -951,6 +1301,60 @@ int esch_256_hash
     return 0;
 }
 
+void esch_256_hash_batch
+    (unsigned char * const *out, const unsigned char * const *in,
+     unsigned long long inlen, size_t count)
+{
+    uint32_t s[SPARKLE_MAX_LANES][SPARKLE_384_STATE_SIZE];
+    uint32_t block[ESCH_256_RATE / 4];
+    unsigned long long posn;
+    unsigned lanes, lane, temp;
+    uint32_t *st;
+    while (count > 0) {
+        lanes = (count < SPARKLE_MAX_LANES) ? (unsigned)count
+                                            : SPARKLE_MAX_LANES;
+        memset(s, 0, sizeof(s[0]) * lanes);
+
+        /* Absorb all blocks except the last, which may be full */
+        for (posn = 0; (inlen - posn) > ESCH_256_RATE;
+                posn += ESCH_256_RATE) {
+            for (lane = 0; lane < lanes; ++lane) {
+                st = s[lane];
+                memcpy(block, in[lane] + posn, ESCH_256_RATE);
+                esch_256_m3(st, block, 0x00);
+            }
+            sparkle_384_n(s, lanes, 7);
+        }
+
+        /* Pad and absorb the last blocks */
+        temp = (unsigned)(inlen - posn);
+        for (lane = 0; lane < lanes; ++lane) {
+            st = s[lane];
+            if (temp == ESCH_256_RATE) {
+                memcpy(block, in[lane] + posn, ESCH_256_RATE);
+                esch_256_m3(st, block, 0x02);
+            } else {
+                memcpy(block, in[lane] + posn, temp);
+                ((unsigned char *)block)[temp] = 0x80;
+                memset(((unsigned char *)block) + temp + 1, 0,
+                       ESCH_256_RATE - temp - 1);
+                esch_256_m3(st, block, 0x01);
+            }
+        }
+        sparkle_384_n(s, lanes, 11);
+
+        /* Generate the hash values */
+        for (lane = 0; lane < lanes; ++lane)
+            memcpy(out[lane], s[lane], ESCH_256_RATE);
+        sparkle_384_n(s, lanes, 7);
+        for (lane = 0; lane < lanes; ++lane)
+            memcpy(out[lane] + ESCH_256_RATE, s[lane], ESCH_256_RATE);
+        out += lanes;
+        in += lanes;
+        count -= lanes;
+    }
+}
+
 void esch_256_hash_init(esch_256_hash_state_t *state)
 {
     memset(state, 0, sizeof(esch_256_hash_state_t));
@@ -1082,6 +1486,65 @@ int esch_384_hash
     return 0;
 }
 
+void esch_384_hash_batch
+    (unsigned char * const *out, const unsigned char * const *in,
+     unsigned long long inlen, size_t count)
+{
+    uint32_t s[SPARKLE_MAX_LANES][SPARKLE_512_STATE_SIZE];
+    uint32_t block[ESCH_384_RATE / 4];
+    unsigned long long posn;
+    unsigned lanes, lane, temp;
+    uint32_t *st;
+    while (count > 0) {
+        lanes = (count < SPARKLE_MAX_LANES) ? (unsigned)count
+                                            : SPARKLE_MAX_LANES;
+        memset(s, 0, sizeof(s[0]) * lanes);
+
+        /* Absorb all blocks except the last, which may be full */
+        for (posn = 0; (inlen - posn) > ESCH_384_RATE;
+                posn += ESCH_384_RATE) {
+            for (lane = 0; lane < lanes; ++lane) {
+                st = s[lane];
+                memcpy(block, in[lane] + posn, ESCH_384_RATE);
+                esch_384_m4(st, block, 0x00);
+            }
+            sparkle_512_n(s, lanes, 8);
+        }
+
+        /* Pad and absorb the last blocks */
+        temp = (unsigned)(inlen - posn);
+        for (lane = 0; lane < lanes; ++lane) {
+            st = s[lane];
+            if (temp == ESCH_384_RATE) {
+                memcpy(block, in[lane] + posn, ESCH_384_RATE);
+                esch_384_m4(st, block, 0x02);
+            } else {
+                memcpy(block, in[lane] + posn, temp);
+                ((unsigned char *)block)[temp] = 0x80;
+                memset(((unsigned char *)block) + temp + 1, 0,
+                       ESCH_384_RATE - temp - 1);
+                esch_384_m4(st, block, 0x01);
+            }
+        }
+        sparkle_512_n(s, lanes, 12);
+
+        /* Generate the hash values */
+        for (lane = 0; lane < lanes; ++lane)
+            memcpy(out[lane], s[lane], ESCH_384_RATE);
+        sparkle_512_n(s, lanes, 8);
+        for (lane = 0; lane < lanes; ++lane)
+            memcpy(out[lane] + ESCH_384_RATE, s[lane], ESCH_384_RATE);
+        sparkle_512_n(s, lanes, 8);
+        for (lane = 0; lane < lanes; ++lane) {
+            memcpy(out[lane] + ESCH_384_RATE * 2, s[lane],
+                   ESCH_384_RATE);
+        }
+        out += lanes;
+        in += lanes;
+        count -= lanes;
+    }
+}
+
 void esch_384_hash_init(esch_384_hash_state_t *state)
 {
     memset(state, 0, sizeof(esch_384_hash_state_t));
@@ -178,6 +178,23 @@ typedef union
 
 } esch_384_hash_state_t;
 
+/**
+ * \brief State information for the incremental Schwaemm AEAD modes.
+ */
+typedef union
+{
+    struct {
+        unsigned char state[64];    /**< Current permutation state */
+        unsigned char block[32];    /**< Partial input data block */
+        unsigned char key[32];      /**< Key for generating the tag */
+        unsigned char count;        /**< Number of bytes in the current block */
+        unsigned char mode;         /**< Associated data or payload mode */
+        unsigned char variant;      /**< Identifies the Schwaemm variant */
+    } s;                            /**< State */
+    unsigned long long align;       /**< For alignment of this structure */
+
+} schwaemm_aead_state_t;
+
 /**
  * \brief Encrypts and authenticates a packet with Schwaemm256-128.
  *
@@ -414,6 +431,136 @@ int schwaemm_256_256_aead_decrypt
      const unsigned char *npub,
      const unsigned char *k);
 
+/**
+ * \brief Initializes the state for an incremental Schwaemm256-128 operation.
+ *
+ * \param state Incremental AEAD state to be initialized.
+ * \param npub Points to the public nonce for the packet which must
+ * be 32 bytes in length.
+ * \param k Points to the 16 bytes of the key to use to encrypt or
+ * decrypt the packet.
+ *
+ * \sa schwaemm_aead_stream_update_ad(), schwaemm_aead_stream_encrypt(),
+ * schwaemm_aead_stream_decrypt()
+ */
+void schwaemm_256_128_aead_stream_init
+    (schwaemm_aead_state_t *state, const unsigned char *npub,
+     const unsigned char *k);
+
+/**
+ * \brief Initializes the state for an incremental Schwaemm192-192 operation.
+ *
+ * \param state Incremental AEAD state to be initialized.
+ * \param npub Points to the public nonce for the packet which must
+ * be 24 bytes in length.
+ * \param k Points to the 24 bytes of the key to use to encrypt or
+ * decrypt the packet.
+ *
+ * \sa schwaemm_aead_stream_update_ad(), schwaemm_aead_stream_encrypt(),
+ * schwaemm_aead_stream_decrypt()
+ */
+void schwaemm_192_192_aead_stream_init
+    (schwaemm_aead_state_t *state, const unsigned char *npub,
+     const unsigned char *k);
+
+/**
+ * \brief Initializes the state for an incremental Schwaemm128-128 operation.
+ *
+ * \param state Incremental AEAD state to be initialized.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 16 bytes of the key to use to encrypt or
+ * decrypt the packet.
+ *
+ * \sa schwaemm_aead_stream_update_ad(), schwaemm_aead_stream_encrypt(),
+ * schwaemm_aead_stream_decrypt()
+ */
+void schwaemm_128_128_aead_stream_init
+    (schwaemm_aead_state_t *state, const unsigned char *npub,
+     const unsigned char *k);
+
+/**
+ * \brief Initializes the state for an incremental Schwaemm256-256 operation.
+ *
+ * \param state Incremental AEAD state to be initialized.
+ * \param npub Points to the public nonce for the packet which must
+ * be 32 bytes in length.
+ * \param k Points to the 32 bytes of the key to use to encrypt or
+ * decrypt the packet.
+ *
+ * \sa schwaemm_aead_stream_update_ad(), schwaemm_aead_stream_encrypt(),
+ * schwaemm_aead_stream_decrypt()
+ */
+void schwaemm_256_256_aead_stream_init
+    (schwaemm_aead_state_t *state, const unsigned char *npub,
+     const unsigned char *k);
+
+/**
+ * \brief Absorbs more associated data into an incremental Schwaemm state.
+ *
+ * \param state Incremental AEAD state to be updated.
+ * \param ad Points to the associated data to be absorbed.
+ * \param adlen Length of the associated data in bytes.
+ *
+ * All associated data must be absorbed before the payload is encrypted
+ * or decrypted.
+ */
+void schwaemm_aead_stream_update_ad
+    (schwaemm_aead_state_t *state, const unsigned char *ad,
+     unsigned long long adlen);
+
+/**
+ * \brief Encrypts more payload data with an incremental Schwaemm state.
+ *
+ * \param state Incremental AEAD state to be updated.
+ * \param c Buffer to receive \a len bytes of ciphertext.
+ * \param m Points to the plaintext to be encrypted.
+ * \param len Number of bytes to be encrypted.
+ *
+ * \sa schwaemm_aead_stream_encrypt_finalize()
+ */
+void schwaemm_aead_stream_encrypt
+    (schwaemm_aead_state_t *state, unsigned char *c,
+     const unsigned char *m, unsigned long long len);
+
+/**
+ * \brief Decrypts more payload data with an incremental Schwaemm state.
+ *
+ * \param state Incremental AEAD state to be updated.
+ * \param m Buffer to receive \a len bytes of plaintext.
+ * \param c Points to the ciphertext to be decrypted.
+ * \param len Number of bytes to be decrypted.
+ *
+ * \sa schwaemm_aead_stream_decrypt_finalize()
+ */
+void schwaemm_aead_stream_decrypt
+    (schwaemm_aead_state_t *state, unsigned char *m,
+     const unsigned char *c, unsigned long long len);
+
+/**
+ * \brief Finalizes an incremental Schwaemm encryption operation.
+ *
+ * \param state Incremental AEAD state to be finalized.
+ * \param tag Buffer to receive the authentication tag, which is
+ * 16, 24, or 32 bytes in length depending upon the variant.
+ */
+void schwaemm_aead_stream_encrypt_finalize
+    (schwaemm_aead_state_t *state, unsigned char *tag);
+
+/**
+ * \brief Finalizes an incremental Schwaemm decryption operation.
+ *
+ * \param state Incremental AEAD state to be finalized.
+ * \param tag Points to the 16, 24, or 32 byte authentication tag to be
+ * checked.
+ *
+ * \return 0 if the authentication tag is correct, or -1 otherwise.
+ * The plaintext that was returned by schwaemm_aead_stream_decrypt() must
+ * be discarded if the authentication tag is incorrect.
+ */
+int schwaemm_aead_stream_decrypt_finalize
+    (schwaemm_aead_state_t *state, const unsigned char *tag);
+
 /**
  * \brief Hashes a block of input data with Esch256 to generate a hash value.
  *
@@ -428,6 +575,25 @@ int schwaemm_256_256_aead_decrypt
 int esch_256_hash
     (unsigned char *out, const unsigned char *in, unsigned long long inlen);
 
+/**
+ * \brief Hashes several messages of the same length with Esch256.
+ *
+ * \param out Array of \a count pointers to buffers that receive the
+ * hash outputs, each at least ESCH_256_HASH_SIZE bytes in length.
+ * \param in Array of \a count pointers to the messages to be hashed.
+ * \param inlen Length of every message in bytes.
+ * \param count Number of messages to hash.
+ *
+ * The messages are hashed side by side so that the SPARKLE permutations
+ * for different messages can share the multi-state kernels.  The results
+ * are the same as calling esch_256_hash() on each message.
+ *
+ * \sa esch_256_hash()
+ */
+void esch_256_hash_batch
+    (unsigned char * const *out, const unsigned char * const *in,
+     unsigned long long inlen, size_t count);
+
 /**
  * \brief Initializes the state for an Esch256 hashing operation.
  *
@@ -475,6 +641,25 @@ void esch_256_hash_finalize
 int esch_384_hash
     (unsigned char *out, const unsigned char *in, unsigned long long inlen);
 
+/**
+ * \brief Hashes several messages of the same length with Esch384.
+ *
+ * \param out Array of \a count pointers to buffers that receive the
+ * hash outputs, each at least ESCH_384_HASH_SIZE bytes in length.
+ * \param in Array of \a count pointers to the messages to be hashed.
+ * \param inlen Length of every message in bytes.
+ * \param count Number of messages to hash.
+ *
+ * The messages are hashed side by side so that the SPARKLE permutations
+ * for different messages can share the multi-state kernels.  The results
+ * are the same as calling esch_384_hash() on each message.
+ *
+ * \sa esch_384_hash()
+ */
+void esch_384_hash_batch
+    (unsigned char * const *out, const unsigned char * const *in,
+     unsigned long long inlen, size_t count);
+
 /**
  * \brief Initializes the state for an Esch384 hashing operation.
  *
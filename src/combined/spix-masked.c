@@ -20,6 +20,7 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include "internal-masking.h"
 #include "spix-masked.h"
 #include "internal-sliscp-light.h"
 #include "internal-sliscp-light-m.h"
@@ -27,7 +28,7 @@
 #include <string.h>
 
 aead_cipher_t const spix_masked_cipher = {
-    "SPIX-Masked",
+    AEAD_MASKING_CIPHER_NAME("SPIX-Masked"),
     SPIX_MASKED_KEY_SIZE,
     SPIX_MASKED_NONCE_SIZE,
     SPIX_MASKED_TAG_SIZE,
@@ -37,7 +38,13 @@ aead_cipher_t const spix_masked_cipher = {
     AEAD_FLAG_SC_PROTECT_ALL,
 #endif
     spix_masked_aead_encrypt,
-    spix_masked_aead_decrypt
+    spix_masked_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 /**
@@ -54,6 +54,21 @@ extern "C" {
  */
 extern aead_cipher_t const spix_masked_cipher;
 
+/**
+ * \brief Meta-information block for the masked SPIX cipher with 2 shares.
+ */
+extern aead_cipher_t const spix_masked_cipher_x2;
+
+/**
+ * \brief Meta-information block for the masked SPIX cipher with 3 shares.
+ */
+extern aead_cipher_t const spix_masked_cipher_x3;
+
+/**
+ * \brief Meta-information block for the masked SPIX cipher with 4 shares.
+ */
+extern aead_cipher_t const spix_masked_cipher_x4;
+
 /**
  * \brief Encrypts and authenticates a packet with masked SPIX.
  *
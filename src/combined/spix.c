@@ -43,7 +43,13 @@ aead_cipher_t const spix_cipher = {
     SPIX_TAG_SIZE,
     AEAD_FLAG_NONE,
     spix_aead_encrypt,
-    spix_aead_decrypt
+    spix_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 /* Indices of where a rate byte is located in the state.  We don't
@@ -20,6 +20,7 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include "internal-masking.h"
 #include "spoc-masked.h"
 #include "internal-sliscp-light-m.h"
 #include "internal-util.h"
@@ -48,23 +49,35 @@
 #define SPOC_64_MASKED_RATE 8
 
 aead_cipher_t const spoc_128_masked_cipher = {
-    "SpoC-128-Masked",
+    AEAD_MASKING_CIPHER_NAME("SpoC-128-Masked"),
     SPOC_MASKED_KEY_SIZE,
     SPOC_MASKED_NONCE_SIZE,
     SPOC_128_MASKED_TAG_SIZE,
     AEAD_FLAG_SC_PROTECT_ALL,
     spoc_128_masked_aead_encrypt,
-    spoc_128_masked_aead_decrypt
+    spoc_128_masked_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_cipher_t const spoc_64_masked_cipher = {
-    "SpoC-64-Masked",
+    AEAD_MASKING_CIPHER_NAME("SpoC-64-Masked"),
     SPOC_MASKED_KEY_SIZE,
     SPOC_MASKED_NONCE_SIZE,
     SPOC_64_MASKED_TAG_SIZE,
     AEAD_FLAG_SC_PROTECT_ALL,
     spoc_64_masked_aead_encrypt,
-    spoc_64_masked_aead_decrypt
+    spoc_64_masked_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 /**
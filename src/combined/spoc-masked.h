@@ -59,11 +59,44 @@ extern "C" {
  */
 extern aead_cipher_t const spoc_128_masked_cipher;
 
+/**
+ * \brief Meta-information block for the masked SpoC-128 cipher with
+ * 2 shares.
+ */
+extern aead_cipher_t const spoc_128_masked_cipher_x2;
+
+/**
+ * \brief Meta-information block for the masked SpoC-128 cipher with
+ * 3 shares.
+ */
+extern aead_cipher_t const spoc_128_masked_cipher_x3;
+
+/**
+ * \brief Meta-information block for the masked SpoC-128 cipher with
+ * 4 shares.
+ */
+extern aead_cipher_t const spoc_128_masked_cipher_x4;
+
 /**
  * \brief Meta-information block for the masked SpoC-64 cipher.
  */
 extern aead_cipher_t const spoc_64_masked_cipher;
 
+/**
+ * \brief Meta-information block for the masked SpoC-64 cipher with 2 shares.
+ */
+extern aead_cipher_t const spoc_64_masked_cipher_x2;
+
+/**
+ * \brief Meta-information block for the masked SpoC-64 cipher with 3 shares.
+ */
+extern aead_cipher_t const spoc_64_masked_cipher_x3;
+
+/**
+ * \brief Meta-information block for the masked SpoC-64 cipher with 4 shares.
+ */
+extern aead_cipher_t const spoc_64_masked_cipher_x4;
+
 /**
  * \brief Encrypts and authenticates a packet with masked SpoC-128.
  *
@@ -54,7 +54,13 @@ aead_cipher_t const spoc_128_cipher = {
     SPOC_128_TAG_SIZE,
     AEAD_FLAG_NONE,
     spoc_128_aead_encrypt,
-    spoc_128_aead_decrypt
+    spoc_128_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_cipher_t const spoc_64_cipher = {
@@ -64,7 +70,13 @@ aead_cipher_t const spoc_64_cipher = {
     SPOC_64_TAG_SIZE,
     AEAD_FLAG_NONE,
     spoc_64_aead_encrypt,
-    spoc_64_aead_decrypt
+    spoc_64_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 /* Indices of where a rate byte is located to help with padding */
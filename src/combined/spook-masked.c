@@ -20,6 +20,7 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include "internal-masking.h"
 #include "spook-masked.h"
 #include "internal-spook.h"
 #include "internal-util.h"
@@ -27,43 +28,67 @@
 #include <string.h>
 
 aead_cipher_t const spook_128_512_su_masked_cipher = {
-    "Spook-128-512-su-masked",
+    AEAD_MASKING_CIPHER_NAME("Spook-128-512-su-masked"),
     SPOOK_MASKED_SU_KEY_SIZE,
     SPOOK_MASKED_NONCE_SIZE,
     SPOOK_MASKED_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN | AEAD_FLAG_SC_PROTECT_KEY,
     spook_128_512_su_masked_aead_encrypt,
-    spook_128_512_su_masked_aead_decrypt
+    spook_128_512_su_masked_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_cipher_t const spook_128_384_su_masked_cipher = {
-    "Spook-128-384-su-masked",
+    AEAD_MASKING_CIPHER_NAME("Spook-128-384-su-masked"),
     SPOOK_MASKED_SU_KEY_SIZE,
     SPOOK_MASKED_NONCE_SIZE,
     SPOOK_MASKED_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN | AEAD_FLAG_SC_PROTECT_KEY,
     spook_128_384_su_masked_aead_encrypt,
-    spook_128_384_su_masked_aead_decrypt
+    spook_128_384_su_masked_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_cipher_t const spook_128_512_mu_masked_cipher = {
-    "Spook-128-512-mu-masked",
+    AEAD_MASKING_CIPHER_NAME("Spook-128-512-mu-masked"),
     SPOOK_MASKED_MU_KEY_SIZE,
     SPOOK_MASKED_NONCE_SIZE,
     SPOOK_MASKED_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN | AEAD_FLAG_SC_PROTECT_KEY,
     spook_128_512_mu_masked_aead_encrypt,
-    spook_128_512_mu_masked_aead_decrypt
+    spook_128_512_mu_masked_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_cipher_t const spook_128_384_mu_masked_cipher = {
-    "Spook-128-384-mu-masked",
+    AEAD_MASKING_CIPHER_NAME("Spook-128-384-mu-masked"),
     SPOOK_MASKED_MU_KEY_SIZE,
     SPOOK_MASKED_NONCE_SIZE,
     SPOOK_MASKED_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN | AEAD_FLAG_SC_PROTECT_KEY,
     spook_128_384_mu_masked_aead_encrypt,
-    spook_128_384_mu_masked_aead_decrypt
+    spook_128_384_mu_masked_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 /**
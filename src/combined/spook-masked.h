@@ -86,21 +86,93 @@ extern "C" {
  */
 extern aead_cipher_t const spook_128_512_su_masked_cipher;
 
+/**
+ * \brief Meta-information block for the masked Spook-128-512-su cipher with
+ * 2 shares.
+ */
+extern aead_cipher_t const spook_128_512_su_masked_cipher_x2;
+
+/**
+ * \brief Meta-information block for the masked Spook-128-512-su cipher with
+ * 3 shares.
+ */
+extern aead_cipher_t const spook_128_512_su_masked_cipher_x3;
+
+/**
+ * \brief Meta-information block for the masked Spook-128-512-su cipher with
+ * 4 shares.
+ */
+extern aead_cipher_t const spook_128_512_su_masked_cipher_x4;
+
 /**
  * \brief Meta-information block for the masked Spook-128-384-su cipher.
  */
 extern aead_cipher_t const spook_128_384_su_masked_cipher;
 
+/**
+ * \brief Meta-information block for the masked Spook-128-384-su cipher with
+ * 2 shares.
+ */
+extern aead_cipher_t const spook_128_384_su_masked_cipher_x2;
+
+/**
+ * \brief Meta-information block for the masked Spook-128-384-su cipher with
+ * 3 shares.
+ */
+extern aead_cipher_t const spook_128_384_su_masked_cipher_x3;
+
+/**
+ * \brief Meta-information block for the masked Spook-128-384-su cipher with
+ * 4 shares.
+ */
+extern aead_cipher_t const spook_128_384_su_masked_cipher_x4;
+
 /**
  * \brief Meta-information block for the masked Spook-128-512-mu cipher.
  */
 extern aead_cipher_t const spook_128_512_mu_masked_cipher;
 
+/**
+ * \brief Meta-information block for the masked Spook-128-512-mu cipher with
+ * 2 shares.
+ */
+extern aead_cipher_t const spook_128_512_mu_masked_cipher_x2;
+
+/**
+ * \brief Meta-information block for the masked Spook-128-512-mu cipher with
+ * 3 shares.
+ */
+extern aead_cipher_t const spook_128_512_mu_masked_cipher_x3;
+
+/**
+ * \brief Meta-information block for the masked Spook-128-512-mu cipher with
+ * 4 shares.
+ */
+extern aead_cipher_t const spook_128_512_mu_masked_cipher_x4;
+
 /**
  * \brief Meta-information block for the masked Spook-128-384-mu cipher.
  */
 extern aead_cipher_t const spook_128_384_mu_masked_cipher;
 
+/**
+ * \brief Meta-information block for the masked Spook-128-384-mu cipher with
+ * 2 shares.
+ */
+extern aead_cipher_t const spook_128_384_mu_masked_cipher_x2;
+
+/**
+ * \brief Meta-information block for the masked Spook-128-384-mu cipher with
+ * 3 shares.
+ */
+extern aead_cipher_t const spook_128_384_mu_masked_cipher_x3;
+
+/**
+ * \brief Meta-information block for the masked Spook-128-384-mu cipher with
+ * 4 shares.
+ */
+extern aead_cipher_t const spook_128_384_mu_masked_cipher_x4;
+
 /**
  * \brief Encrypts and authenticates a packet with masked Spook-128-512-su.
  *
@@ -32,7 +32,13 @@ aead_cipher_t const spook_128_512_su_cipher = {
     SPOOK_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN,
     spook_128_512_su_aead_encrypt,
-    spook_128_512_su_aead_decrypt
+    spook_128_512_su_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_cipher_t const spook_128_384_su_cipher = {
@@ -42,7 +48,13 @@ aead_cipher_t const spook_128_384_su_cipher = {
     SPOOK_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN,
     spook_128_384_su_aead_encrypt,
-    spook_128_384_su_aead_decrypt
+    spook_128_384_su_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_cipher_t const spook_128_512_mu_cipher = {
@@ -52,7 +64,13 @@ aead_cipher_t const spook_128_512_mu_cipher = {
     SPOOK_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN,
     spook_128_512_mu_aead_encrypt,
-    spook_128_512_mu_aead_decrypt
+    spook_128_512_mu_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_cipher_t const spook_128_384_mu_cipher = {
@@ -62,7 +80,13 @@ aead_cipher_t const spook_128_384_mu_cipher = {
     SPOOK_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN,
     spook_128_384_mu_aead_encrypt,
-    spook_128_384_mu_aead_decrypt
+    spook_128_384_mu_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 /**
@@ -24,6 +24,19 @@
 #include "internal-subterranean.h"
 #include <string.h>
 
+/**
+ * \brief Incremental AEAD functions for Subterranean.
+ */
+static aead_stream_cipher_t const subterranean_stream_cipher = {
+    sizeof(subterranean_aead_state_t),
+    (aead_stream_init_t)subterranean_aead_stream_init,
+    (aead_stream_update_ad_t)subterranean_aead_stream_update_ad,
+    (aead_stream_crypt_t)subterranean_aead_stream_encrypt,
+    (aead_stream_crypt_t)subterranean_aead_stream_decrypt,
+    (aead_stream_encrypt_finalize_t)subterranean_aead_stream_encrypt_finalize,
+    (aead_stream_decrypt_finalize_t)subterranean_aead_stream_decrypt_finalize
+};
+
 aead_cipher_t const subterranean_cipher = {
     "Subterranean",
     SUBTERRANEAN_KEY_SIZE,
@@ -31,7 +44,13 @@ aead_cipher_t const subterranean_cipher = {
     SUBTERRANEAN_TAG_SIZE,
     AEAD_FLAG_NONE,
     subterranean_aead_encrypt,
-    subterranean_aead_decrypt
+    subterranean_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    &subterranean_stream_cipher,
+    0  /* batch */
 };
 
 aead_hash_algorithm_t const subterranean_hash_algorithm = {
@@ -181,6 +200,197 @@ int subterranean_aead_decrypt
     return aead_check_tag(mtemp, *mlen, tag, c + clen, SUBTERRANEAN_TAG_SIZE);
 }
 
+#define SUBTERRANEAN_STREAM_MODE_AD 0
+#define SUBTERRANEAN_STREAM_MODE_PAYLOAD 1
+
+void subterranean_aead_stream_init
+    (subterranean_aead_state_t *state, const unsigned char *npub,
+     const unsigned char *k)
+{
+    subterranean_state_t *st = (subterranean_state_t *)(state->s.state);
+    memset(state, 0, sizeof(subterranean_aead_state_t));
+    subterranean_absorb(st, k, SUBTERRANEAN_KEY_SIZE);
+    subterranean_absorb(st, npub, SUBTERRANEAN_NONCE_SIZE);
+    subterranean_blank(st);
+    state->s.mode = SUBTERRANEAN_STREAM_MODE_AD;
+}
+
+void subterranean_aead_stream_update_ad
+    (subterranean_aead_state_t *state, const unsigned char *ad,
+     unsigned long long adlen)
+{
+    subterranean_state_t *st = (subterranean_state_t *)(state->s.state);
+
+    /* Top up the partial block from last time */
+    while (state->s.count > 0 && state->s.count < 4 && adlen > 0) {
+        state->s.block[state->s.count++] = *ad++;
+        --adlen;
+    }
+    if (state->s.count == 4) {
+        subterranean_duplex_4(st, le_load_word32(state->s.block));
+        state->s.count = 0;
+    }
+
+    /* Absorb full words directly from the input */
+    while (adlen >= 4) {
+        subterranean_duplex_4(st, le_load_word32(ad));
+        ad += 4;
+        adlen -= 4;
+    }
+
+    /* Save the left-over bytes for next time */
+    while (adlen > 0) {
+        state->s.block[state->s.count++] = *ad++;
+        --adlen;
+    }
+}
+
+/**
+ * \brief Switches an incremental Subterranean state into payload mode.
+ *
+ * \param state The incremental AEAD state.
+ */
+static void subterranean_aead_stream_start_payload
+    (subterranean_aead_state_t *state)
+{
+    subterranean_state_t *st = (subterranean_state_t *)(state->s.state);
+    subterranean_duplex_n(st, state->s.block, state->s.count);
+    state->s.count = 0;
+    state->s.mode = SUBTERRANEAN_STREAM_MODE_PAYLOAD;
+    le_store_word32(state->s.ks, subterranean_extract(st));
+}
+
+/**
+ * \brief Absorbs a byte of plaintext into an incremental Subterranean state.
+ *
+ * \param state The incremental AEAD state.
+ * \param m The plaintext byte.
+ *
+ * The keystream for the next word is generated when a word is completed.
+ */
+static void subterranean_aead_stream_absorb_byte
+    (subterranean_aead_state_t *state, unsigned char m)
+{
+    subterranean_state_t *st = (subterranean_state_t *)(state->s.state);
+    state->s.block[state->s.count++] = m;
+    if (state->s.count == 4) {
+        subterranean_duplex_4(st, le_load_word32(state->s.block));
+        state->s.count = 0;
+        le_store_word32(state->s.ks, subterranean_extract(st));
+    }
+}
+
+void subterranean_aead_stream_encrypt
+    (subterranean_aead_state_t *state, unsigned char *c,
+     const unsigned char *m, unsigned long long len)
+{
+    subterranean_state_t *st = (subterranean_state_t *)(state->s.state);
+    uint32_t x1, x2;
+    if (state->s.mode != SUBTERRANEAN_STREAM_MODE_PAYLOAD)
+        subterranean_aead_stream_start_payload(state);
+
+    /* Top up the partial block from last time */
+    while (state->s.count != 0 && len > 0) {
+        unsigned char mb = *m++;
+        *c++ = mb ^ state->s.ks[state->s.count];
+        subterranean_aead_stream_absorb_byte(state, mb);
+        --len;
+    }
+
+    /* Process full words directly from the input */
+    if (len >= 4) {
+        while (len >= 4) {
+            x1 = le_load_word32(m);
+            x2 = subterranean_extract(st) ^ x1;
+            subterranean_duplex_4(st, x1);
+            le_store_word32(c, x2);
+            c += 4;
+            m += 4;
+            len -= 4;
+        }
+        le_store_word32(state->s.ks, subterranean_extract(st));
+    }
+
+    /* Process the left-over bytes */
+    while (len > 0) {
+        unsigned char mb = *m++;
+        *c++ = mb ^ state->s.ks[state->s.count];
+        subterranean_aead_stream_absorb_byte(state, mb);
+        --len;
+    }
+}
+
+void subterranean_aead_stream_decrypt
+    (subterranean_aead_state_t *state, unsigned char *m,
+     const unsigned char *c, unsigned long long len)
+{
+    subterranean_state_t *st = (subterranean_state_t *)(state->s.state);
+    uint32_t x;
+    if (state->s.mode != SUBTERRANEAN_STREAM_MODE_PAYLOAD)
+        subterranean_aead_stream_start_payload(state);
+
+    /* Top up the partial block from last time */
+    while (state->s.count != 0 && len > 0) {
+        unsigned char mb = *c++ ^ state->s.ks[state->s.count];
+        *m++ = mb;
+        subterranean_aead_stream_absorb_byte(state, mb);
+        --len;
+    }
+
+    /* Process full words directly from the input */
+    if (len >= 4) {
+        while (len >= 4) {
+            x = le_load_word32(c) ^ subterranean_extract(st);
+            subterranean_duplex_4(st, x);
+            le_store_word32(m, x);
+            c += 4;
+            m += 4;
+            len -= 4;
+        }
+        le_store_word32(state->s.ks, subterranean_extract(st));
+    }
+
+    /* Process the left-over bytes */
+    while (len > 0) {
+        unsigned char mb = *c++ ^ state->s.ks[state->s.count];
+        *m++ = mb;
+        subterranean_aead_stream_absorb_byte(state, mb);
+        --len;
+    }
+}
+
+/**
+ * \brief Computes the authentication tag for an incremental
+ * Subterranean state.
+ *
+ * \param state The incremental AEAD state.
+ * \param tag Buffer to receive the authentication tag.
+ */
+static void subterranean_aead_stream_compute_tag
+    (subterranean_aead_state_t *state, unsigned char *tag)
+{
+    subterranean_state_t *st = (subterranean_state_t *)(state->s.state);
+    if (state->s.mode != SUBTERRANEAN_STREAM_MODE_PAYLOAD)
+        subterranean_aead_stream_start_payload(state);
+    subterranean_duplex_n(st, state->s.block, state->s.count);
+    subterranean_blank(st);
+    subterranean_squeeze(st, tag, SUBTERRANEAN_TAG_SIZE);
+}
+
+void subterranean_aead_stream_encrypt_finalize
+    (subterranean_aead_state_t *state, unsigned char *tag)
+{
+    subterranean_aead_stream_compute_tag(state, tag);
+}
+
+int subterranean_aead_stream_decrypt_finalize
+    (subterranean_aead_state_t *state, const unsigned char *tag)
+{
+    unsigned char computed[SUBTERRANEAN_TAG_SIZE];
+    subterranean_aead_stream_compute_tag(state, computed);
+    return aead_check_tag(0, 0, computed, tag, SUBTERRANEAN_TAG_SIZE);
+}
+
 int subterranean_hash
     (unsigned char *out, const unsigned char *in, unsigned long long inlen)
 {
@@ -66,6 +66,22 @@ extern "C" {
  */
 #define SUBTERRANEAN_HASH_SIZE 32
 
+/**
+ * \brief State information for the incremental Subterranean AEAD mode.
+ */
+typedef union
+{
+    struct {
+        unsigned char state[40]; /**< Current Subterranean state */
+        unsigned char block[4];  /**< Bytes of the block to be absorbed */
+        unsigned char ks[4];     /**< Keystream for the current block */
+        unsigned char count;     /**< Number of bytes in the current block */
+        unsigned char mode;      /**< Associated data or payload mode */
+    } s;                         /**< State */
+    unsigned long long align;    /**< For alignment of this structure */
+
+} subterranean_aead_state_t;
+
 /**
  * \brief Meta-information block for the Subterranean cipher.
  */
@@ -145,6 +161,86 @@ int subterranean_aead_decrypt
      const unsigned char *npub,
      const unsigned char *k);
 
+/**
+ * \brief Initializes the state for an incremental Subterranean operation.
+ *
+ * \param state Incremental AEAD state to be initialized.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 16 bytes of the key to use to encrypt or
+ * decrypt the packet.
+ *
+ * \sa subterranean_aead_stream_update_ad(),
+ * subterranean_aead_stream_encrypt(), subterranean_aead_stream_decrypt()
+ */
+void subterranean_aead_stream_init
+    (subterranean_aead_state_t *state, const unsigned char *npub,
+     const unsigned char *k);
+
+/**
+ * \brief Absorbs more associated data into an incremental Subterranean state.
+ *
+ * \param state Incremental AEAD state to be updated.
+ * \param ad Points to the associated data to be absorbed.
+ * \param adlen Length of the associated data in bytes.
+ *
+ * All associated data must be absorbed before the payload is encrypted
+ * or decrypted.
+ */
+void subterranean_aead_stream_update_ad
+    (subterranean_aead_state_t *state, const unsigned char *ad,
+     unsigned long long adlen);
+
+/**
+ * \brief Encrypts more payload data with an incremental Subterranean state.
+ *
+ * \param state Incremental AEAD state to be updated.
+ * \param c Buffer to receive \a len bytes of ciphertext.
+ * \param m Points to the plaintext to be encrypted.
+ * \param len Number of bytes to be encrypted.
+ *
+ * \sa subterranean_aead_stream_encrypt_finalize()
+ */
+void subterranean_aead_stream_encrypt
+    (subterranean_aead_state_t *state, unsigned char *c,
+     const unsigned char *m, unsigned long long len);
+
+/**
+ * \brief Decrypts more payload data with an incremental Subterranean state.
+ *
+ * \param state Incremental AEAD state to be updated.
+ * \param m Buffer to receive \a len bytes of plaintext.
+ * \param c Points to the ciphertext to be decrypted.
+ * \param len Number of bytes to be decrypted.
+ *
+ * \sa subterranean_aead_stream_decrypt_finalize()
+ */
+void subterranean_aead_stream_decrypt
+    (subterranean_aead_state_t *state, unsigned char *m,
+     const unsigned char *c, unsigned long long len);
+
+/**
+ * \brief Finalizes an incremental Subterranean encryption operation.
+ *
+ * \param state Incremental AEAD state to be finalized.
+ * \param tag Buffer to receive the 16 byte authentication tag.
+ */
+void subterranean_aead_stream_encrypt_finalize
+    (subterranean_aead_state_t *state, unsigned char *tag);
+
+/**
+ * \brief Finalizes an incremental Subterranean decryption operation.
+ *
+ * \param state Incremental AEAD state to be finalized.
+ * \param tag Points to the 16 byte authentication tag to be checked.
+ *
+ * \return 0 if the authentication tag is correct, or -1 otherwise.
+ * The plaintext that was returned by subterranean_aead_stream_decrypt() must
+ * be discarded if the authentication tag is incorrect.
+ */
+int subterranean_aead_stream_decrypt_finalize
+    (subterranean_aead_state_t *state, const unsigned char *tag);
+
 /**
  * \brief Hashes a block of input data with Subterranean.
  *
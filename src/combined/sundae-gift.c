@@ -25,6 +25,23 @@
 #include "internal-util.h"
 #include <string.h>
 
+/**
+ * \brief Declares the batch AEAD functions for a SUNDAE-GIFT variant.
+ *
+ * \param name Prefix for the variant; e.g. sundae_gift_0.
+ */
+#define SUNDAE_GIFT_BATCH_CIPHER(name) \
+    static void name##_batch_encrypt(aead_batch_item_t *items, size_t count); \
+    static void name##_batch_decrypt(aead_batch_item_t *items, size_t count); \
+    static aead_batch_cipher_t const name##_batch_cipher = { \
+        name##_batch_encrypt, \
+        name##_batch_decrypt \
+    }
+SUNDAE_GIFT_BATCH_CIPHER(sundae_gift_0);
+SUNDAE_GIFT_BATCH_CIPHER(sundae_gift_64);
+SUNDAE_GIFT_BATCH_CIPHER(sundae_gift_96);
+SUNDAE_GIFT_BATCH_CIPHER(sundae_gift_128);
+
 aead_cipher_t const sundae_gift_0_cipher = {
     "SUNDAE-GIFT-0",
     SUNDAE_GIFT_KEY_SIZE,
@@ -32,7 +49,13 @@ aead_cipher_t const sundae_gift_0_cipher = {
     SUNDAE_GIFT_TAG_SIZE,
     AEAD_FLAG_NONE,
     sundae_gift_0_aead_encrypt,
-    sundae_gift_0_aead_decrypt
+    sundae_gift_0_aead_decrypt,
+    sizeof(gift128b_key_schedule_t),
+    sundae_gift_aead_setup_key,
+    sundae_gift_0_aead_encrypt_with_context,
+    sundae_gift_0_aead_decrypt_with_context,
+    0, /* stream */
+    &sundae_gift_0_batch_cipher
 };
 
 aead_cipher_t const sundae_gift_64_cipher = {
@@ -42,7 +65,13 @@ aead_cipher_t const sundae_gift_64_cipher = {
     SUNDAE_GIFT_TAG_SIZE,
     AEAD_FLAG_NONE,
     sundae_gift_64_aead_encrypt,
-    sundae_gift_64_aead_decrypt
+    sundae_gift_64_aead_decrypt,
+    sizeof(gift128b_key_schedule_t),
+    sundae_gift_aead_setup_key,
+    sundae_gift_64_aead_encrypt_with_context,
+    sundae_gift_64_aead_decrypt_with_context,
+    0, /* stream */
+    &sundae_gift_64_batch_cipher
 };
 
 aead_cipher_t const sundae_gift_96_cipher = {
@@ -52,7 +81,13 @@ aead_cipher_t const sundae_gift_96_cipher = {
     SUNDAE_GIFT_TAG_SIZE,
     AEAD_FLAG_NONE,
     sundae_gift_96_aead_encrypt,
-    sundae_gift_96_aead_decrypt
+    sundae_gift_96_aead_decrypt,
+    sizeof(gift128b_key_schedule_t),
+    sundae_gift_aead_setup_key,
+    sundae_gift_96_aead_encrypt_with_context,
+    sundae_gift_96_aead_decrypt_with_context,
+    0, /* stream */
+    &sundae_gift_96_batch_cipher
 };
 
 aead_cipher_t const sundae_gift_128_cipher = {
@@ -62,7 +97,13 @@ aead_cipher_t const sundae_gift_128_cipher = {
     SUNDAE_GIFT_TAG_SIZE,
     AEAD_FLAG_NONE,
     sundae_gift_128_aead_encrypt,
-    sundae_gift_128_aead_decrypt
+    sundae_gift_128_aead_decrypt,
+    sizeof(gift128b_key_schedule_t),
+    sundae_gift_aead_setup_key,
+    sundae_gift_128_aead_encrypt_with_context,
+    sundae_gift_128_aead_decrypt_with_context,
+    0, /* stream */
+    &sundae_gift_128_batch_cipher
 };
 
 /* Multiply a block value by 2 in the special byte field */
@@ -129,19 +170,19 @@ static int sundae_gift_aead_encrypt
      const unsigned char *m, unsigned long long mlen,
      const unsigned char *ad, unsigned long long adlen,
      const unsigned char *npub, unsigned npublen,
-     const unsigned char *k, unsigned char domainsep)
+     const gift128b_key_schedule_t *ks, unsigned char domainsep)
 {
-    gift128b_key_schedule_t ks;
+    gift128b_key_schedule_t temp;
     unsigned char V[16];
     unsigned char T[16];
     unsigned char P[16];
 
+    /* Expand the key schedule once for the whole packet */
+    ks = gift128b_expand_schedule(ks, &temp);
+
     /* Compute the length of the output ciphertext */
     *clen = mlen + SUNDAE_GIFT_TAG_SIZE;
 
-    /* Set the key schedule */
-    gift128b_init(&ks, k);
-
     /* Format and encrypt the initial domain separation block */
     if (adlen > 0)
         domainsep |= 0x80;
@@ -149,13 +190,13 @@ static int sundae_gift_aead_encrypt
         domainsep |= 0x40;
     V[0] = domainsep;
     memset(V + 1, 0, sizeof(V) - 1);
-    gift128b_encrypt(&ks, T, V);
+    gift128b_encrypt(ks, T, V);
 
     /* Authenticate the nonce and the associated data */
-    sundae_gift_aead_mac(&ks, T, npub, npublen, ad, adlen);
+    sundae_gift_aead_mac(ks, T, npub, npublen, ad, adlen);
 
     /* Authenticate the plaintext */
-    sundae_gift_aead_mac(&ks, T, 0, 0, m, mlen);
+    sundae_gift_aead_mac(ks, T, 0, 0, m, mlen);
 
     /* Encrypt the plaintext to produce the ciphertext.  We need to be
      * careful how we manage the data because we could be doing in-place
@@ -165,7 +206,7 @@ static int sundae_gift_aead_encrypt
      * ciphertext or tag from the previous block */
     memcpy(V, T, 16);
     while (mlen >= 16) {
-        gift128b_encrypt(&ks, V, V);
+        gift128b_encrypt(ks, V, V);
         lw_xor_block_2_src(P, V, m, 16);
         memcpy(c, T, 16);
         memcpy(T, P, 16);
@@ -175,7 +216,7 @@ static int sundae_gift_aead_encrypt
     }
     if (mlen > 0) {
         unsigned leftover = (unsigned)mlen;
-        gift128b_encrypt(&ks, V, V);
+        gift128b_encrypt(ks, V, V);
         lw_xor_block(V, m, leftover);
         memcpy(c, T, 16);
         memcpy(c + 16, V, leftover);
@@ -190,22 +231,22 @@ static int sundae_gift_aead_decrypt
      const unsigned char *c, unsigned long long clen,
      const unsigned char *ad, unsigned long long adlen,
      const unsigned char *npub, unsigned npublen,
-     const unsigned char *k, unsigned char domainsep)
+     const gift128b_key_schedule_t *ks, unsigned char domainsep)
 {
-    gift128b_key_schedule_t ks;
+    gift128b_key_schedule_t temp;
     unsigned char V[16];
     unsigned char T[16];
     unsigned char *mtemp;
     unsigned long len;
 
+    /* Expand the key schedule once for the whole packet */
+    ks = gift128b_expand_schedule(ks, &temp);
+
     /* Bail out if the ciphertext is too short */
     if (clen < SUNDAE_GIFT_TAG_SIZE)
         return -1;
     len = *mlen = clen - SUNDAE_GIFT_TAG_SIZE;
 
-    /* Set the key schedule */
-    gift128b_init(&ks, k);
-
     /* Decrypt the ciphertext to produce the plaintext, using the
      * tag as the initialization vector for the decryption process */
     memcpy(T, c, SUNDAE_GIFT_TAG_SIZE);
@@ -213,14 +254,14 @@ static int sundae_gift_aead_decrypt
     mtemp = m;
     memcpy(V, T, 16);
     while (len >= 16) {
-        gift128b_encrypt(&ks, V, V);
+        gift128b_encrypt(ks, V, V);
         lw_xor_block_2_src(mtemp, c, V, 16);
         c += 16;
         mtemp += 16;
         len -= 16;
     }
     if (len > 0) {
-        gift128b_encrypt(&ks, V, V);
+        gift128b_encrypt(ks, V, V);
         lw_xor_block_2_src(mtemp, c, V, (unsigned)len);
     }
 
@@ -231,18 +272,23 @@ static int sundae_gift_aead_decrypt
         domainsep |= 0x40;
     V[0] = domainsep;
     memset(V + 1, 0, sizeof(V) - 1);
-    gift128b_encrypt(&ks, V, V);
+    gift128b_encrypt(ks, V, V);
 
     /* Authenticate the nonce and the associated data */
-    sundae_gift_aead_mac(&ks, V, npub, npublen, ad, adlen);
+    sundae_gift_aead_mac(ks, V, npub, npublen, ad, adlen);
 
     /* Authenticate the plaintext */
-    sundae_gift_aead_mac(&ks, V, 0, 0, m, *mlen);
+    sundae_gift_aead_mac(ks, V, 0, 0, m, *mlen);
 
     /* Check the authentication tag */
     return aead_check_tag(m, *mlen, T, V, 16);
 }
 
+void sundae_gift_aead_setup_key(void *ctx, const unsigned char *k)
+{
+    gift128b_init((gift128b_key_schedule_t *)ctx, k);
+}
+
 int sundae_gift_0_aead_encrypt
     (unsigned char *c, unsigned long long *clen,
      const unsigned char *m, unsigned long long mlen,
@@ -250,11 +296,28 @@ int sundae_gift_0_aead_encrypt
      const unsigned char *nsec,
      const unsigned char *npub,
      const unsigned char *k)
+{
+    gift128b_key_schedule_t ks;
+    (void)nsec;
+    (void)npub;
+    gift128b_init(&ks, k);
+    return sundae_gift_aead_encrypt
+        (c, clen, m, mlen, ad, adlen, 0, 0, &ks, 0x00);
+}
+
+int sundae_gift_0_aead_encrypt_with_context
+    (unsigned char *c, unsigned long long *clen,
+     const unsigned char *m, unsigned long long mlen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *nsec,
+     const unsigned char *npub,
+     const void *ctx)
 {
     (void)nsec;
     (void)npub;
     return sundae_gift_aead_encrypt
-        (c, clen, m, mlen, ad, adlen, 0, 0, k, 0x00);
+        (c, clen, m, mlen, ad, adlen, 0, 0,
+         (const gift128b_key_schedule_t *)ctx, 0x00);
 }
 
 int sundae_gift_0_aead_decrypt
@@ -264,11 +327,28 @@ int sundae_gift_0_aead_decrypt
      const unsigned char *ad, unsigned long long adlen,
      const unsigned char *npub,
      const unsigned char *k)
+{
+    gift128b_key_schedule_t ks;
+    (void)nsec;
+    (void)npub;
+    gift128b_init(&ks, k);
+    return sundae_gift_aead_decrypt
+        (m, mlen, c, clen, ad, adlen, 0, 0, &ks, 0x00);
+}
+
+int sundae_gift_0_aead_decrypt_with_context
+    (unsigned char *m, unsigned long long *mlen,
+     unsigned char *nsec,
+     const unsigned char *c, unsigned long long clen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *npub,
+     const void *ctx)
 {
     (void)nsec;
     (void)npub;
     return sundae_gift_aead_decrypt
-        (m, mlen, c, clen, ad, adlen, 0, 0, k, 0x00);
+        (m, mlen, c, clen, ad, adlen, 0, 0,
+         (const gift128b_key_schedule_t *)ctx, 0x00);
 }
 
 int sundae_gift_64_aead_encrypt
@@ -278,11 +358,28 @@ int sundae_gift_64_aead_encrypt
      const unsigned char *nsec,
      const unsigned char *npub,
      const unsigned char *k)
+{
+    gift128b_key_schedule_t ks;
+    (void)nsec;
+    gift128b_init(&ks, k);
+    return sundae_gift_aead_encrypt
+        (c, clen, m, mlen, ad, adlen,
+         npub, SUNDAE_GIFT_64_NONCE_SIZE, &ks, 0x90);
+}
+
+int sundae_gift_64_aead_encrypt_with_context
+    (unsigned char *c, unsigned long long *clen,
+     const unsigned char *m, unsigned long long mlen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *nsec,
+     const unsigned char *npub,
+     const void *ctx)
 {
     (void)nsec;
     return sundae_gift_aead_encrypt
         (c, clen, m, mlen, ad, adlen,
-         npub, SUNDAE_GIFT_64_NONCE_SIZE, k, 0x90);
+         npub, SUNDAE_GIFT_64_NONCE_SIZE,
+         (const gift128b_key_schedule_t *)ctx, 0x90);
 }
 
 int sundae_gift_64_aead_decrypt
@@ -292,11 +389,28 @@ int sundae_gift_64_aead_decrypt
      const unsigned char *ad, unsigned long long adlen,
      const unsigned char *npub,
      const unsigned char *k)
+{
+    gift128b_key_schedule_t ks;
+    (void)nsec;
+    gift128b_init(&ks, k);
+    return sundae_gift_aead_decrypt
+        (m, mlen, c, clen, ad, adlen,
+         npub, SUNDAE_GIFT_64_NONCE_SIZE, &ks, 0x90);
+}
+
+int sundae_gift_64_aead_decrypt_with_context
+    (unsigned char *m, unsigned long long *mlen,
+     unsigned char *nsec,
+     const unsigned char *c, unsigned long long clen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *npub,
+     const void *ctx)
 {
     (void)nsec;
     return sundae_gift_aead_decrypt
         (m, mlen, c, clen, ad, adlen,
-         npub, SUNDAE_GIFT_64_NONCE_SIZE, k, 0x90);
+         npub, SUNDAE_GIFT_64_NONCE_SIZE,
+         (const gift128b_key_schedule_t *)ctx, 0x90);
 }
 
 int sundae_gift_96_aead_encrypt
@@ -306,11 +420,28 @@ int sundae_gift_96_aead_encrypt
      const unsigned char *nsec,
      const unsigned char *npub,
      const unsigned char *k)
+{
+    gift128b_key_schedule_t ks;
+    (void)nsec;
+    gift128b_init(&ks, k);
+    return sundae_gift_aead_encrypt
+        (c, clen, m, mlen, ad, adlen,
+         npub, SUNDAE_GIFT_96_NONCE_SIZE, &ks, 0xA0);
+}
+
+int sundae_gift_96_aead_encrypt_with_context
+    (unsigned char *c, unsigned long long *clen,
+     const unsigned char *m, unsigned long long mlen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *nsec,
+     const unsigned char *npub,
+     const void *ctx)
 {
     (void)nsec;
     return sundae_gift_aead_encrypt
         (c, clen, m, mlen, ad, adlen,
-         npub, SUNDAE_GIFT_96_NONCE_SIZE, k, 0xA0);
+         npub, SUNDAE_GIFT_96_NONCE_SIZE,
+         (const gift128b_key_schedule_t *)ctx, 0xA0);
 }
 
 int sundae_gift_96_aead_decrypt
@@ -320,11 +451,28 @@ int sundae_gift_96_aead_decrypt
      const unsigned char *ad, unsigned long long adlen,
      const unsigned char *npub,
      const unsigned char *k)
+{
+    gift128b_key_schedule_t ks;
+    (void)nsec;
+    gift128b_init(&ks, k);
+    return sundae_gift_aead_decrypt
+        (m, mlen, c, clen, ad, adlen,
+         npub, SUNDAE_GIFT_96_NONCE_SIZE, &ks, 0xA0);
+}
+
+int sundae_gift_96_aead_decrypt_with_context
+    (unsigned char *m, unsigned long long *mlen,
+     unsigned char *nsec,
+     const unsigned char *c, unsigned long long clen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *npub,
+     const void *ctx)
 {
     (void)nsec;
     return sundae_gift_aead_decrypt
         (m, mlen, c, clen, ad, adlen,
-         npub, SUNDAE_GIFT_96_NONCE_SIZE, k, 0xA0);
+         npub, SUNDAE_GIFT_96_NONCE_SIZE,
+         (const gift128b_key_schedule_t *)ctx, 0xA0);
 }
 
 int sundae_gift_128_aead_encrypt
@@ -334,11 +482,28 @@ int sundae_gift_128_aead_encrypt
      const unsigned char *nsec,
      const unsigned char *npub,
      const unsigned char *k)
+{
+    gift128b_key_schedule_t ks;
+    (void)nsec;
+    gift128b_init(&ks, k);
+    return sundae_gift_aead_encrypt
+        (c, clen, m, mlen, ad, adlen,
+         npub, SUNDAE_GIFT_128_NONCE_SIZE, &ks, 0xB0);
+}
+
+int sundae_gift_128_aead_encrypt_with_context
+    (unsigned char *c, unsigned long long *clen,
+     const unsigned char *m, unsigned long long mlen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *nsec,
+     const unsigned char *npub,
+     const void *ctx)
 {
     (void)nsec;
     return sundae_gift_aead_encrypt
         (c, clen, m, mlen, ad, adlen,
-         npub, SUNDAE_GIFT_128_NONCE_SIZE, k, 0xB0);
+         npub, SUNDAE_GIFT_128_NONCE_SIZE,
+         (const gift128b_key_schedule_t *)ctx, 0xB0);
 }
 
 int sundae_gift_128_aead_decrypt
@@ -348,9 +513,291 @@ int sundae_gift_128_aead_decrypt
      const unsigned char *ad, unsigned long long adlen,
      const unsigned char *npub,
      const unsigned char *k)
+{
+    gift128b_key_schedule_t ks;
+    (void)nsec;
+    gift128b_init(&ks, k);
+    return sundae_gift_aead_decrypt
+        (m, mlen, c, clen, ad, adlen,
+         npub, SUNDAE_GIFT_128_NONCE_SIZE, &ks, 0xB0);
+}
+
+int sundae_gift_128_aead_decrypt_with_context
+    (unsigned char *m, unsigned long long *mlen,
+     unsigned char *nsec,
+     const unsigned char *c, unsigned long long clen,
+     const unsigned char *ad, unsigned long long adlen,
+     const unsigned char *npub,
+     const void *ctx)
 {
     (void)nsec;
     return sundae_gift_aead_decrypt
         (m, mlen, c, clen, ad, adlen,
-         npub, SUNDAE_GIFT_128_NONCE_SIZE, k, 0xB0);
+         npub, SUNDAE_GIFT_128_NONCE_SIZE,
+         (const gift128b_key_schedule_t *)ctx, 0xB0);
+}
+
+/**
+ * \brief Computes the MAC over the concatenation of two data buffers for
+ * all packets in a batch.
+ *
+ * \param ks Key schedules for the packets, one per lane.
+ * \param V Rolling MAC state for each packet.
+ * \param data1 Points to the first data buffers, or NULL if \a data1len
+ * is zero.
+ * \param data1len Length of the first data buffers; at most 16.
+ * \param data2 Points to the second data buffers.
+ * \param data2len Length of the second data buffers.
+ */
+static void sundae_gift_batch_mac
+    (const gift128b_multi_key_schedule_t *ks, unsigned char V[][16],
+     const unsigned char * const *data1, unsigned data1len,
+     const unsigned char * const *data2, unsigned long long data2len)
+{
+    unsigned long long posn;
+    unsigned len, lane;
+
+    /* Nothing to do if the input is empty */
+    if (!data1len && !data2len)
+        return;
+
+    /* Format the first block */
+    len = 16 - data1len;
+    if (len > data2len)
+        len = (unsigned)data2len;
+    for (lane = 0; lane < ks->lanes; ++lane) {
+        if (data1len)
+            lw_xor_block(V[lane], data1[lane], data1len);
+        lw_xor_block(V[lane] + data1len, data2[lane], len);
+    }
+    posn = len;
+    len += data1len;
+
+    /* Process as many full blocks as we can, except the last */
+    while (posn < data2len) {
+        gift128b_encrypt_multi(ks, V[0]);
+        len = 16;
+        if (len > (data2len - posn))
+            len = (unsigned)(data2len - posn);
+        for (lane = 0; lane < ks->lanes; ++lane)
+            lw_xor_block(V[lane], data2[lane] + posn, len);
+        posn += len;
+    }
+
+    /* Pad and process the last block */
+    for (lane = 0; lane < ks->lanes; ++lane) {
+        if (len < 16) {
+            V[lane][len] ^= 0x80;
+            sundae_gift_multiply(V[lane]);
+        } else {
+            sundae_gift_multiply(V[lane]);
+            sundae_gift_multiply(V[lane]);
+        }
+    }
+    gift128b_encrypt_multi(ks, V[0]);
+}
+
+/**
+ * \brief Encrypts or decrypts up to GIFT128_MAX_LANES packets in parallel.
+ *
+ * \param ks Key schedules for the packets, one per lane.
+ * \param out Points to the output buffers for the packets.
+ * \param in Points to the input buffers for the packets.
+ * \param len Length of the payload of each packet, excluding the tag.
+ * \param ad Points to the associated data buffers for the packets.
+ * \param adlen Length of the associated data for each packet.
+ * \param npub Points to the nonces for the packets.
+ * \param npublen Length of the nonces.
+ * \param domainsep Domain separation value for the variant.
+ * \param status Returns the tag check result for each packet on decrypt.
+ * \param decrypt Non-zero to decrypt, zero to encrypt.
+ *
+ * The tag comes first in SUNDAE-GIFT, so the output of encryption is
+ * the tag followed by the ciphertext.
+ */
+static void sundae_gift_batch_crypt
+    (const gift128b_multi_key_schedule_t *ks,
+     unsigned char * const *out, const unsigned char * const *in,
+     unsigned long long len,
+     const unsigned char * const *ad, unsigned long long adlen,
+     const unsigned char * const *npub, unsigned npublen,
+     unsigned char domainsep, int *status, int decrypt)
+{
+    unsigned char V[GIFT128_MAX_LANES][16];
+    unsigned char T[GIFT128_MAX_LANES][16];
+    unsigned char P[16];
+    unsigned long long posn;
+    unsigned lane, temp;
+
+    /* Format the domain separation byte */
+    if (adlen > 0)
+        domainsep |= 0x80;
+    if (len > 0)
+        domainsep |= 0x40;
+
+    /* Decryption starts with the payload, using the tag from the start
+     * of the packet as the initialization vector */
+    if (decrypt) {
+        for (lane = 0; lane < ks->lanes; ++lane) {
+            memcpy(T[lane], in[lane], SUNDAE_GIFT_TAG_SIZE);
+            memcpy(V[lane], T[lane], 16);
+        }
+        for (posn = 0; (posn + 16) <= len; posn += 16) {
+            gift128b_encrypt_multi(ks, V[0]);
+            for (lane = 0; lane < ks->lanes; ++lane) {
+                lw_xor_block_2_src
+                    (out[lane] + posn, in[lane] + SUNDAE_GIFT_TAG_SIZE + posn,
+                     V[lane], 16);
+            }
+        }
+        if (posn < len) {
+            temp = (unsigned)(len - posn);
+            gift128b_encrypt_multi(ks, V[0]);
+            for (lane = 0; lane < ks->lanes; ++lane) {
+                lw_xor_block_2_src
+                    (out[lane] + posn, in[lane] + SUNDAE_GIFT_TAG_SIZE + posn,
+                     V[lane], temp);
+            }
+        }
+    }
+
+    /* Format and encrypt the initial domain separation block */
+    for (lane = 0; lane < ks->lanes; ++lane) {
+        V[lane][0] = domainsep;
+        memset(V[lane] + 1, 0, 15);
+    }
+    gift128b_encrypt_multi(ks, V[0]);
+
+    /* Authenticate the nonce, the associated data, and the plaintext */
+    sundae_gift_batch_mac(ks, V, npub, npublen, ad, adlen);
+    if (decrypt) {
+        sundae_gift_batch_mac
+            (ks, V, 0, 0, (const unsigned char * const *)out, len);
+        for (lane = 0; lane < ks->lanes; ++lane) {
+            status[lane] = aead_check_tag
+                (out[lane], len, T[lane], V[lane], SUNDAE_GIFT_TAG_SIZE);
+        }
+        return;
+    }
+    sundae_gift_batch_mac(ks, V, 0, 0, in, len);
+
+    /* Encrypt the plaintext with the tag as the initialization vector.
+     * The ciphertext is one block behind the plaintext in the output,
+     * so we delay each block by one to support in-place encryption */
+    memcpy(T, V, ks->lanes * 16);
+    for (posn = 0; (posn + 16) <= len; posn += 16) {
+        gift128b_encrypt_multi(ks, V[0]);
+        for (lane = 0; lane < ks->lanes; ++lane) {
+            lw_xor_block_2_src(P, V[lane], in[lane] + posn, 16);
+            memcpy(out[lane] + posn, T[lane], 16);
+            memcpy(T[lane], P, 16);
+        }
+    }
+    if (posn < len) {
+        temp = (unsigned)(len - posn);
+        gift128b_encrypt_multi(ks, V[0]);
+        for (lane = 0; lane < ks->lanes; ++lane) {
+            lw_xor_block(V[lane], in[lane] + posn, temp);
+            memcpy(out[lane] + posn, T[lane], 16);
+            memcpy(out[lane] + posn + 16, V[lane], temp);
+        }
+    } else {
+        for (lane = 0; lane < ks->lanes; ++lane)
+            memcpy(out[lane] + posn, T[lane], 16);
+    }
+    for (lane = 0; lane < ks->lanes; ++lane)
+        status[lane] = 0;
 }
+
+/**
+ * \brief Encrypts or decrypts a batch of packets with SUNDAE-GIFT, using
+ * the multi-block GIFT-128 kernels for runs of packets that have the
+ * same lengths.
+ *
+ * \param items Points to the descriptors for the packets.
+ * \param count Number of packets in the batch.
+ * \param npublen Length of the nonces for the variant.
+ * \param domainsep Domain separation value for the variant.
+ * \param decrypt Non-zero to decrypt, zero to encrypt.
+ */
+static void sundae_gift_batch_items
+    (aead_batch_item_t *items, size_t count, unsigned npublen,
+     unsigned char domainsep, int decrypt)
+{
+    gift128b_key_schedule_t schedules[GIFT128_MAX_LANES];
+    const gift128b_key_schedule_t *keys[GIFT128_MAX_LANES];
+    gift128b_multi_key_schedule_t ks;
+    unsigned char *out[GIFT128_MAX_LANES];
+    const unsigned char *in[GIFT128_MAX_LANES];
+    const unsigned char *ad[GIFT128_MAX_LANES];
+    const unsigned char *npub[GIFT128_MAX_LANES];
+    int status[GIFT128_MAX_LANES];
+    unsigned long long inlen, adlen, len;
+    unsigned lanes, lane;
+    while (count > 0) {
+        /* A ciphertext that is too short to contain a tag fails by itself */
+        inlen = items[0].inlen;
+        adlen = items[0].adlen;
+        if (decrypt && inlen < SUNDAE_GIFT_TAG_SIZE) {
+            items[0].outlen = 0;
+            items[0].status = -1;
+            ++items;
+            --count;
+            continue;
+        }
+
+        /* Collect a run of packets with the same lengths */
+        lanes = 0;
+        do {
+            out[lanes] = items[lanes].out;
+            in[lanes] = items[lanes].in;
+            ad[lanes] = items[lanes].ad;
+            npub[lanes] = items[lanes].npub;
+            if (items[lanes].key) {
+                gift128b_init(&(schedules[lanes]), items[lanes].key);
+                keys[lanes] = &(schedules[lanes]);
+            } else {
+                keys[lanes] = gift128b_expand_schedule
+                    ((const gift128b_key_schedule_t *)(items[lanes].ctx),
+                     &(schedules[lanes]));
+            }
+            ++lanes;
+        } while (lanes < GIFT128_MAX_LANES && lanes < count &&
+                 items[lanes].inlen == inlen && items[lanes].adlen == adlen);
+
+        /* Process the run of packets */
+        gift128b_multi_init(&ks, keys, lanes);
+        len = decrypt ? (inlen - SUNDAE_GIFT_TAG_SIZE) : inlen;
+        sundae_gift_batch_crypt
+            (&ks, out, in, len, ad, adlen, npub, npublen, domainsep,
+             status, decrypt);
+        for (lane = 0; lane < lanes; ++lane) {
+            items[lane].outlen =
+                decrypt ? len : (len + SUNDAE_GIFT_TAG_SIZE);
+            items[lane].status = status[lane];
+        }
+        items += lanes;
+        count -= lanes;
+    }
+}
+
+/**
+ * \brief Defines the batch AEAD functions for a SUNDAE-GIFT variant.
+ *
+ * \param name Prefix for the variant; e.g. sundae_gift_0.
+ * \param npublen Length of the nonces for the variant.
+ * \param domainsep Domain separation value for the variant.
+ */
+#define SUNDAE_GIFT_BATCH_FUNCS(name, npublen, domainsep) \
+    static void name##_batch_encrypt(aead_batch_item_t *items, size_t count) \
+    { \
+        sundae_gift_batch_items(items, count, (npublen), (domainsep), 0); \
+    } \
+    static void name##_batch_decrypt(aead_batch_item_t *items, size_t count) \
+    { \
+        sundae_gift_batch_items(items, count, (npublen), (domainsep), 1); \
+    }
+SUNDAE_GIFT_BATCH_FUNCS(sundae_gift_0, SUNDAE_GIFT_0_NONCE_SIZE, 0x00)
+SUNDAE_GIFT_BATCH_FUNCS(sundae_gift_64, SUNDAE_GIFT_64_NONCE_SIZE, 0x90)
+SUNDAE_GIFT_BATCH_FUNCS(sundae_gift_96, SUNDAE_GIFT_96_NONCE_SIZE, 0xA0)
+SUNDAE_GIFT_BATCH_FUNCS(sundae_gift_128, SUNDAE_GIFT_128_NONCE_SIZE, 0xB0)
@@ -20,38 +20,57 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include "internal-masking.h"
 #include "tinyjambu-masked.h"
 #include "internal-tinyjambu-m.h"
 #include "internal-util.h"
 
 aead_cipher_t const tiny_jambu_128_masked_cipher = {
-    "TinyJAMBU-128-Masked",
+    AEAD_MASKING_CIPHER_NAME("TinyJAMBU-128-Masked"),
     TINY_JAMBU_MASKED_128_KEY_SIZE,
     TINY_JAMBU_MASKED_NONCE_SIZE,
     TINY_JAMBU_MASKED_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN | AEAD_FLAG_SC_PROTECT_ALL,
     tiny_jambu_128_masked_aead_encrypt,
-    tiny_jambu_128_masked_aead_decrypt
+    tiny_jambu_128_masked_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_cipher_t const tiny_jambu_192_masked_cipher = {
-    "TinyJAMBU-192-Masked",
+    AEAD_MASKING_CIPHER_NAME("TinyJAMBU-192-Masked"),
     TINY_JAMBU_MASKED_192_KEY_SIZE,
     TINY_JAMBU_MASKED_NONCE_SIZE,
     TINY_JAMBU_MASKED_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN | AEAD_FLAG_SC_PROTECT_ALL,
     tiny_jambu_192_masked_aead_encrypt,
-    tiny_jambu_192_masked_aead_decrypt
+    tiny_jambu_192_masked_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_cipher_t const tiny_jambu_256_masked_cipher = {
-    "TinyJAMBU-256-Masked",
+    AEAD_MASKING_CIPHER_NAME("TinyJAMBU-256-Masked"),
     TINY_JAMBU_MASKED_256_KEY_SIZE,
     TINY_JAMBU_MASKED_NONCE_SIZE,
     TINY_JAMBU_MASKED_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN | AEAD_FLAG_SC_PROTECT_ALL,
     tiny_jambu_256_masked_aead_encrypt,
-    tiny_jambu_256_masked_aead_decrypt
+    tiny_jambu_256_masked_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 /**
@@ -64,16 +64,70 @@ extern "C" {
  */
 extern aead_cipher_t const tiny_jambu_128_masked_cipher;
 
+/**
+ * \brief Meta-information block for the masked TinyJAMBU-128 cipher with
+ * 2 shares.
+ */
+extern aead_cipher_t const tiny_jambu_128_masked_cipher_x2;
+
+/**
+ * \brief Meta-information block for the masked TinyJAMBU-128 cipher with
+ * 3 shares.
+ */
+extern aead_cipher_t const tiny_jambu_128_masked_cipher_x3;
+
+/**
+ * \brief Meta-information block for the masked TinyJAMBU-128 cipher with
+ * 4 shares.
+ */
+extern aead_cipher_t const tiny_jambu_128_masked_cipher_x4;
+
 /**
  * \brief Meta-information block for the masked TinyJAMBU-192 cipher.
  */
 extern aead_cipher_t const tiny_jambu_192_masked_cipher;
 
+/**
+ * \brief Meta-information block for the masked TinyJAMBU-192 cipher with
+ * 2 shares.
+ */
+extern aead_cipher_t const tiny_jambu_192_masked_cipher_x2;
+
+/**
+ * \brief Meta-information block for the masked TinyJAMBU-192 cipher with
+ * 3 shares.
+ */
+extern aead_cipher_t const tiny_jambu_192_masked_cipher_x3;
+
+/**
+ * \brief Meta-information block for the masked TinyJAMBU-192 cipher with
+ * 4 shares.
+ */
+extern aead_cipher_t const tiny_jambu_192_masked_cipher_x4;
+
 /**
  * \brief Meta-information block for the masked TinyJAMBU-256 cipher.
  */
 extern aead_cipher_t const tiny_jambu_256_masked_cipher;
 
+/**
+ * \brief Meta-information block for the masked TinyJAMBU-256 cipher with
+ * 2 shares.
+ */
+extern aead_cipher_t const tiny_jambu_256_masked_cipher_x2;
+
+/**
+ * \brief Meta-information block for the masked TinyJAMBU-256 cipher with
+ * 3 shares.
+ */
+extern aead_cipher_t const tiny_jambu_256_masked_cipher_x3;
+
+/**
+ * \brief Meta-information block for the masked TinyJAMBU-256 cipher with
+ * 4 shares.
+ */
+extern aead_cipher_t const tiny_jambu_256_masked_cipher_x4;
+
 /**
  * \brief Encrypts and authenticates a packet with masked TinyJAMBU-128.
  *
@@ -32,7 +32,13 @@ aead_cipher_t const tiny_jambu_128_cipher = {
     TINY_JAMBU_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN,
     tiny_jambu_128_aead_encrypt,
-    tiny_jambu_128_aead_decrypt
+    tiny_jambu_128_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_cipher_t const tiny_jambu_192_cipher = {
@@ -42,7 +48,13 @@ aead_cipher_t const tiny_jambu_192_cipher = {
     TINY_JAMBU_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN,
     tiny_jambu_192_aead_encrypt,
-    tiny_jambu_192_aead_decrypt
+    tiny_jambu_192_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 aead_cipher_t const tiny_jambu_256_cipher = {
@@ -52,7 +64,13 @@ aead_cipher_t const tiny_jambu_256_cipher = {
     TINY_JAMBU_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN,
     tiny_jambu_256_aead_encrypt,
-    tiny_jambu_256_aead_decrypt
+    tiny_jambu_256_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 /**
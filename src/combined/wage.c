@@ -31,7 +31,13 @@ aead_cipher_t const wage_cipher = {
     WAGE_TAG_SIZE,
     AEAD_FLAG_NONE,
     wage_aead_encrypt,
-    wage_aead_decrypt
+    wage_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 /**
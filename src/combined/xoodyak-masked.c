@@ -20,13 +20,14 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include "internal-masking.h"
 #include "xoodyak-masked.h"
 #include "internal-xoodoo.h"
 #include "internal-xoodoo-m.h"
 #include <string.h>
 
 aead_cipher_t const xoodyak_masked_cipher = {
-    "Xoodyak-Masked",
+    AEAD_MASKING_CIPHER_NAME("Xoodyak-Masked"),
     XOODYAK_MASKED_KEY_SIZE,
     XOODYAK_MASKED_NONCE_SIZE,
     XOODYAK_MASKED_TAG_SIZE,
@@ -36,7 +37,13 @@ aead_cipher_t const xoodyak_masked_cipher = {
     AEAD_FLAG_LITTLE_ENDIAN | AEAD_FLAG_SC_PROTECT_ALL,
 #endif
     xoodyak_masked_aead_encrypt,
-    xoodyak_masked_aead_decrypt
+    xoodyak_masked_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    0, /* stream */
+    0  /* batch */
 };
 
 /**
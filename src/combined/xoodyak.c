@@ -24,6 +24,43 @@
 #include "internal-xoodoo.h"
 #include <string.h>
 
+/**
+ * \brief Encrypts a batch of packets with Xoodyak.
+ *
+ * \param items Points to the descriptors for the packets.
+ * \param count Number of packets in the batch.
+ */
+static void xoodyak_batch_encrypt(aead_batch_item_t *items, size_t count);
+
+/**
+ * \brief Decrypts a batch of packets with Xoodyak.
+ *
+ * \param items Points to the descriptors for the packets.
+ * \param count Number of packets in the batch.
+ */
+static void xoodyak_batch_decrypt(aead_batch_item_t *items, size_t count);
+
+/**
+ * \brief Batch AEAD functions for Xoodyak.
+ */
+static aead_batch_cipher_t const xoodyak_batch_cipher = {
+    xoodyak_batch_encrypt,
+    xoodyak_batch_decrypt
+};
+
+/**
+ * \brief Incremental AEAD functions for Xoodyak.
+ */
+static aead_stream_cipher_t const xoodyak_stream_cipher = {
+    sizeof(xoodyak_aead_state_t),
+    (aead_stream_init_t)xoodyak_aead_stream_init,
+    (aead_stream_update_ad_t)xoodyak_aead_stream_update_ad,
+    (aead_stream_crypt_t)xoodyak_aead_stream_encrypt,
+    (aead_stream_crypt_t)xoodyak_aead_stream_decrypt,
+    (aead_stream_encrypt_finalize_t)xoodyak_aead_stream_encrypt_finalize,
+    (aead_stream_decrypt_finalize_t)xoodyak_aead_stream_decrypt_finalize
+};
+
 aead_cipher_t const xoodyak_cipher = {
     "Xoodyak",
     XOODYAK_KEY_SIZE,
@@ -31,7 +68,13 @@ aead_cipher_t const xoodyak_cipher = {
     XOODYAK_TAG_SIZE,
     AEAD_FLAG_LITTLE_ENDIAN,
     xoodyak_aead_encrypt,
-    xoodyak_aead_decrypt
+    xoodyak_aead_decrypt,
+    0, /* context_size */
+    0, /* setup_key */
+    0, /* encrypt_with_context */
+    0, /* decrypt_with_context */
+    &xoodyak_stream_cipher,
+    &xoodyak_batch_cipher
 };
 
 aead_hash_algorithm_t const xoodyak_hash_algorithm = {
@@ -217,6 +260,338 @@ int xoodyak_aead_decrypt
     return aead_check_tag(mtemp, *mlen, state.B, c, XOODYAK_TAG_SIZE);
 }
 
+/**
+ * \brief Absorbs data into several Xoodoo permutation states in lock-step.
+ *
+ * \param states Points to the Xoodoo permutation states, which must all
+ * be in the "down" phase.
+ * \param lanes Number of states.
+ * \param data Points to the data to be absorbed for each state.
+ * \param len Length of the data to be absorbed for every state.
+ *
+ * This is equivalent to calling xoodyak_absorb() on each state.
+ */
+static void xoodyak_absorb_n
+    (xoodoo_state_t *states, unsigned lanes,
+     const unsigned char * const *data, unsigned long long len)
+{
+    uint8_t domain = 0x03;
+    unsigned long long posn = 0;
+    unsigned temp, lane;
+    while ((len - posn) > XOODYAK_ABSORB_RATE) {
+        xoodoo_permute_n(states, lanes);
+        for (lane = 0; lane < lanes; ++lane) {
+            lw_xor_block(states[lane].B, data[lane] + posn,
+                         XOODYAK_ABSORB_RATE);
+            states[lane].B[XOODYAK_ABSORB_RATE] ^= 0x01; /* Padding */
+            states[lane].B[sizeof(states[lane].B) - 1] ^= domain;
+        }
+        posn += XOODYAK_ABSORB_RATE;
+        domain = 0x00;
+    }
+    temp = (unsigned)(len - posn);
+    xoodoo_permute_n(states, lanes);
+    for (lane = 0; lane < lanes; ++lane) {
+        lw_xor_block(states[lane].B, data[lane] + posn, temp);
+        states[lane].B[temp] ^= 0x01; /* Padding */
+        states[lane].B[sizeof(states[lane].B) - 1] ^= domain;
+    }
+}
+
+/**
+ * \brief Encrypts or decrypts a single packet from a batch with Xoodyak.
+ *
+ * \param item The packet to process.
+ * \param decrypt Non-zero to decrypt, zero to encrypt.
+ */
+static void xoodyak_batch_single(aead_batch_item_t *item, int decrypt)
+{
+    /* Xoodyak has no key schedule, so a key context is a raw key */
+    const unsigned char *k = item->key;
+    if (!k)
+        k = (const unsigned char *)(item->ctx);
+    if (decrypt) {
+        item->status = xoodyak_aead_decrypt
+            (item->out, &(item->outlen), 0, item->in, item->inlen,
+             item->ad, item->adlen, item->npub, k);
+    } else {
+        item->status = xoodyak_aead_encrypt
+            (item->out, &(item->outlen), item->in, item->inlen,
+             item->ad, item->adlen, 0, item->npub, k);
+    }
+}
+
+/**
+ * \brief Encrypts or decrypts a batch of packets with Xoodyak, permuting
+ * the states for runs of packets with the same lengths side by side.
+ *
+ * \param items Points to the descriptors for the packets.
+ * \param count Number of packets in the batch.
+ * \param decrypt Non-zero to decrypt, zero to encrypt.
+ */
+static void xoodyak_batch_items
+    (aead_batch_item_t *items, size_t count, int decrypt)
+{
+    xoodoo_state_t states[XOODOO_MAX_LANES];
+    const unsigned char *npub[XOODOO_MAX_LANES];
+    const unsigned char *ad[XOODOO_MAX_LANES];
+    const unsigned char *k;
+    unsigned long long inlen, adlen, len, posn;
+    unsigned lanes, lane, temp;
+    uint8_t domain;
+    while (count > 0) {
+        /* Measure the run of packets with the same lengths */
+        inlen = items[0].inlen;
+        adlen = items[0].adlen;
+        lanes = 1;
+        while (lanes < XOODOO_MAX_LANES && lanes < count &&
+                items[lanes].inlen == inlen && items[lanes].adlen == adlen)
+            ++lanes;
+
+        /* Lone packets and invalid lengths are handled one at a time */
+        if (lanes == 1 || (decrypt && inlen < XOODYAK_TAG_SIZE)) {
+            for (lane = 0; lane < lanes; ++lane)
+                xoodyak_batch_single(&(items[lane]), decrypt);
+            items += lanes;
+            count -= lanes;
+            continue;
+        }
+
+        /* Initialize the states with the keys */
+        for (lane = 0; lane < lanes; ++lane) {
+            k = items[lane].key;
+            if (!k)
+                k = (const unsigned char *)(items[lane].ctx);
+            memcpy(states[lane].B, k, XOODYAK_KEY_SIZE);
+            memset(states[lane].B + XOODYAK_KEY_SIZE, 0,
+                   sizeof(states[lane].B) - XOODYAK_KEY_SIZE);
+            states[lane].B[XOODYAK_KEY_SIZE + 1] = 0x01; /* Padding */
+            states[lane].B[sizeof(states[lane].B) - 1] = 0x02; /* Domain */
+            npub[lane] = items[lane].npub;
+            ad[lane] = items[lane].ad;
+        }
+
+        /* Absorb the nonces and associated data */
+        xoodyak_absorb_n(states, lanes, npub, XOODYAK_NONCE_SIZE);
+        xoodyak_absorb_n(states, lanes, ad, adlen);
+
+        /* Encrypt or decrypt the payloads */
+        len = decrypt ? (inlen - XOODYAK_TAG_SIZE) : inlen;
+        domain = 0x80;
+        posn = 0;
+        for (;;) {
+            temp = ((len - posn) > XOODYAK_SQUEEZE_RATE)
+                ? XOODYAK_SQUEEZE_RATE : (unsigned)(len - posn);
+            for (lane = 0; lane < lanes; ++lane)
+                states[lane].B[sizeof(states[lane].B) - 1] ^= domain;
+            xoodoo_permute_n(states, lanes);
+            for (lane = 0; lane < lanes; ++lane) {
+                if (decrypt) {
+                    lw_xor_block_swap
+                        (items[lane].out + posn, states[lane].B,
+                         items[lane].in + posn, temp);
+                } else {
+                    lw_xor_block_2_dest
+                        (items[lane].out + posn, states[lane].B,
+                         items[lane].in + posn, temp);
+                }
+                states[lane].B[temp] ^= 0x01; /* Padding */
+            }
+            posn += temp;
+            domain = 0;
+            if (temp < XOODYAK_SQUEEZE_RATE || posn >= len)
+                break;
+        }
+
+        /* Generate or check the authentication tags */
+        for (lane = 0; lane < lanes; ++lane)
+            states[lane].B[sizeof(states[lane].B) - 1] ^= 0x40; /* Domain */
+        xoodoo_permute_n(states, lanes);
+        for (lane = 0; lane < lanes; ++lane) {
+            if (decrypt) {
+                items[lane].outlen = len;
+                items[lane].status = aead_check_tag
+                    (items[lane].out, len, states[lane].B,
+                     items[lane].in + len, XOODYAK_TAG_SIZE);
+            } else {
+                memcpy(items[lane].out + len, states[lane].B,
+                       XOODYAK_TAG_SIZE);
+                items[lane].outlen = len + XOODYAK_TAG_SIZE;
+                items[lane].status = 0;
+            }
+        }
+        items += lanes;
+        count -= lanes;
+    }
+}
+
+static void xoodyak_batch_encrypt(aead_batch_item_t *items, size_t count)
+{
+    xoodyak_batch_items(items, count, 0);
+}
+
+static void xoodyak_batch_decrypt(aead_batch_item_t *items, size_t count)
+{
+    xoodyak_batch_items(items, count, 1);
+}
+
+#define XOODYAK_STREAM_MODE_INIT 0
+#define XOODYAK_STREAM_MODE_AD 1
+#define XOODYAK_STREAM_MODE_PAYLOAD 2
+
+#define xoodoo_stream_permute(state) \
+    xoodoo_permute((xoodoo_state_t *)((state)->s.state))
+
+void xoodyak_aead_stream_init
+    (xoodyak_aead_state_t *state, const unsigned char *npub,
+     const unsigned char *k)
+{
+    xoodoo_state_t *xstate = (xoodoo_state_t *)(state->s.state);
+    uint8_t phase;
+
+    /* Initialize the state with the key */
+    memcpy(state->s.state, k, XOODYAK_KEY_SIZE);
+    memset(state->s.state + XOODYAK_KEY_SIZE, 0,
+           sizeof(state->s.state) - XOODYAK_KEY_SIZE);
+    state->s.state[XOODYAK_KEY_SIZE + 1] = 0x01; /* Padding */
+    state->s.state[sizeof(state->s.state) - 1] = 0x02; /* Domain separation */
+    phase = XOODYAK_PHASE_DOWN;
+
+    /* Absorb the nonce; the associated data block is started lazily */
+    xoodyak_absorb(xstate, &phase, npub, XOODYAK_NONCE_SIZE);
+    state->s.count = 0;
+    state->s.mode = XOODYAK_STREAM_MODE_INIT;
+    state->s.domain = 0x03;
+}
+
+void xoodyak_aead_stream_update_ad
+    (xoodyak_aead_state_t *state, const unsigned char *ad,
+     unsigned long long adlen)
+{
+    unsigned temp;
+
+    /* Start the first associated data block */
+    if (state->s.mode == XOODYAK_STREAM_MODE_INIT) {
+        xoodoo_stream_permute(state);
+        state->s.mode = XOODYAK_STREAM_MODE_AD;
+    }
+
+    /* A full block is only closed off once we know that more data follows
+     * because the last block of associated data may be a full block */
+    while (adlen > 0) {
+        if (state->s.count >= XOODYAK_ABSORB_RATE) {
+            state->s.state[XOODYAK_ABSORB_RATE] ^= 0x01; /* Padding */
+            state->s.state[sizeof(state->s.state) - 1] ^= state->s.domain;
+            xoodoo_stream_permute(state);
+            state->s.count = 0;
+            state->s.domain = 0x00;
+        }
+        temp = XOODYAK_ABSORB_RATE - state->s.count;
+        if (temp > adlen)
+            temp = (unsigned)adlen;
+        lw_xor_block(state->s.state + state->s.count, ad, temp);
+        state->s.count += temp;
+        ad += temp;
+        adlen -= temp;
+    }
+}
+
+/**
+ * \brief Switches an incremental Xoodyak state into payload mode.
+ *
+ * \param state The incremental AEAD state.
+ */
+static void xoodyak_aead_stream_start_payload(xoodyak_aead_state_t *state)
+{
+    /* Pad the last associated data block, which may be empty */
+    if (state->s.mode == XOODYAK_STREAM_MODE_INIT)
+        xoodoo_stream_permute(state);
+    state->s.state[state->s.count] ^= 0x01; /* Padding */
+    state->s.state[sizeof(state->s.state) - 1] ^= state->s.domain;
+
+    /* Generate the keystream for the first payload block */
+    state->s.state[sizeof(state->s.state) - 1] ^= 0x80;
+    xoodoo_stream_permute(state);
+    state->s.count = 0;
+    state->s.mode = XOODYAK_STREAM_MODE_PAYLOAD;
+}
+
+void xoodyak_aead_stream_encrypt
+    (xoodyak_aead_state_t *state, unsigned char *c,
+     const unsigned char *m, unsigned long long len)
+{
+    unsigned temp;
+    if (state->s.mode != XOODYAK_STREAM_MODE_PAYLOAD)
+        xoodyak_aead_stream_start_payload(state);
+    while (len > 0) {
+        if (state->s.count >= XOODYAK_SQUEEZE_RATE) {
+            state->s.state[XOODYAK_SQUEEZE_RATE] ^= 0x01; /* Padding */
+            xoodoo_stream_permute(state);
+            state->s.count = 0;
+        }
+        temp = XOODYAK_SQUEEZE_RATE - state->s.count;
+        if (temp > len)
+            temp = (unsigned)len;
+        lw_xor_block_2_dest(c, state->s.state + state->s.count, m, temp);
+        state->s.count += temp;
+        c += temp;
+        m += temp;
+        len -= temp;
+    }
+}
+
+void xoodyak_aead_stream_decrypt
+    (xoodyak_aead_state_t *state, unsigned char *m,
+     const unsigned char *c, unsigned long long len)
+{
+    unsigned temp;
+    if (state->s.mode != XOODYAK_STREAM_MODE_PAYLOAD)
+        xoodyak_aead_stream_start_payload(state);
+    while (len > 0) {
+        if (state->s.count >= XOODYAK_SQUEEZE_RATE) {
+            state->s.state[XOODYAK_SQUEEZE_RATE] ^= 0x01; /* Padding */
+            xoodoo_stream_permute(state);
+            state->s.count = 0;
+        }
+        temp = XOODYAK_SQUEEZE_RATE - state->s.count;
+        if (temp > len)
+            temp = (unsigned)len;
+        lw_xor_block_swap(m, state->s.state + state->s.count, c, temp);
+        state->s.count += temp;
+        c += temp;
+        m += temp;
+        len -= temp;
+    }
+}
+
+/**
+ * \brief Computes the authentication tag for an incremental Xoodyak state.
+ *
+ * \param state The incremental AEAD state.
+ */
+static void xoodyak_aead_stream_compute_tag(xoodyak_aead_state_t *state)
+{
+    if (state->s.mode != XOODYAK_STREAM_MODE_PAYLOAD)
+        xoodyak_aead_stream_start_payload(state);
+    state->s.state[state->s.count] ^= 0x01; /* Padding */
+    state->s.state[sizeof(state->s.state) - 1] ^= 0x40; /* Domain separation */
+    xoodoo_stream_permute(state);
+}
+
+void xoodyak_aead_stream_encrypt_finalize
+    (xoodyak_aead_state_t *state, unsigned char *tag)
+{
+    xoodyak_aead_stream_compute_tag(state);
+    memcpy(tag, state->s.state, XOODYAK_TAG_SIZE);
+}
+
+int xoodyak_aead_stream_decrypt_finalize
+    (xoodyak_aead_state_t *state, const unsigned char *tag)
+{
+    xoodyak_aead_stream_compute_tag(state);
+    return aead_check_tag(0, 0, state->s.state, tag, XOODYAK_TAG_SIZE);
+}
+
 int xoodyak_hash
     (unsigned char *out, const unsigned char *in, unsigned long long inlen)
 {
@@ -227,6 +602,56 @@ int xoodyak_hash
     return 0;
 }
 
+void xoodyak_hash_batch
+    (unsigned char * const *out, const unsigned char * const *in,
+     unsigned long long inlen, size_t count)
+{
+    xoodoo_state_t states[XOODOO_MAX_LANES];
+    unsigned long long posn;
+    unsigned lanes, lane, temp;
+    uint8_t domain;
+    while (count > 0) {
+        lanes = (count < XOODOO_MAX_LANES) ? (unsigned)count
+                                           : XOODOO_MAX_LANES;
+        memset(states, 0, sizeof(xoodoo_state_t) * lanes);
+
+        /* Absorb all blocks except the last, which may be full */
+        domain = 0x01;
+        for (posn = 0; (inlen - posn) > XOODYAK_HASH_RATE;
+                posn += XOODYAK_HASH_RATE) {
+            for (lane = 0; lane < lanes; ++lane) {
+                lw_xor_block(states[lane].B, in[lane] + posn,
+                             XOODYAK_HASH_RATE);
+                states[lane].B[XOODYAK_HASH_RATE] ^= 0x01; /* Padding */
+                states[lane].B[sizeof(states[lane].B) - 1] ^= domain;
+            }
+            xoodoo_permute_n(states, lanes);
+            domain = 0x00;
+        }
+
+        /* Pad the last block and squeeze out the two halves of each hash */
+        temp = (unsigned)(inlen - posn);
+        for (lane = 0; lane < lanes; ++lane) {
+            lw_xor_block(states[lane].B, in[lane] + posn, temp);
+            states[lane].B[temp] ^= 0x01; /* Padding */
+            states[lane].B[sizeof(states[lane].B) - 1] ^= domain;
+        }
+        xoodoo_permute_n(states, lanes);
+        for (lane = 0; lane < lanes; ++lane) {
+            memcpy(out[lane], states[lane].B, XOODYAK_HASH_RATE);
+            states[lane].B[0] ^= 0x01; /* Padding */
+        }
+        xoodoo_permute_n(states, lanes);
+        for (lane = 0; lane < lanes; ++lane) {
+            memcpy(out[lane] + XOODYAK_HASH_RATE, states[lane].B,
+                   XOODYAK_HASH_SIZE - XOODYAK_HASH_RATE);
+        }
+        out += lanes;
+        in += lanes;
+        count -= lanes;
+    }
+}
+
 #define XOODYAK_HASH_MODE_INIT_ABSORB 0
 #define XOODYAK_HASH_MODE_ABSORB 1
 #define XOODYAK_HASH_MODE_SQUEEZE 2
@@ -87,6 +87,21 @@ typedef union
 
 } xoodyak_hash_state_t;
 
+/**
+ * \brief State information for the incremental Xoodyak AEAD mode.
+ */
+typedef union
+{
+    struct {
+        unsigned char state[48]; /**< Current permutation state */
+        unsigned char count;     /**< Number of bytes in the current block */
+        unsigned char mode;      /**< Associated data or payload mode */
+        unsigned char domain;    /**< Domain separator for the next block */
+    } s;                         /**< State */
+    unsigned long long align;    /**< For alignment of this structure */
+
+} xoodyak_aead_state_t;
+
 /**
  * \brief Meta-information block for the Xoodyak cipher.
  */
@@ -156,6 +171,86 @@ int xoodyak_aead_decrypt
      const unsigned char *npub,
      const unsigned char *k);
 
+/**
+ * \brief Initializes the state for an incremental Xoodyak operation.
+ *
+ * \param state Incremental AEAD state to be initialized.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 16 bytes of the key to use to encrypt or
+ * decrypt the packet.
+ *
+ * \sa xoodyak_aead_stream_update_ad(), xoodyak_aead_stream_encrypt(),
+ * xoodyak_aead_stream_decrypt()
+ */
+void xoodyak_aead_stream_init
+    (xoodyak_aead_state_t *state, const unsigned char *npub,
+     const unsigned char *k);
+
+/**
+ * \brief Absorbs more associated data into an incremental Xoodyak state.
+ *
+ * \param state Incremental AEAD state to be updated.
+ * \param ad Points to the associated data to be absorbed.
+ * \param adlen Length of the associated data in bytes.
+ *
+ * All associated data must be absorbed before the payload is encrypted
+ * or decrypted.
+ */
+void xoodyak_aead_stream_update_ad
+    (xoodyak_aead_state_t *state, const unsigned char *ad,
+     unsigned long long adlen);
+
+/**
+ * \brief Encrypts more payload data with an incremental Xoodyak state.
+ *
+ * \param state Incremental AEAD state to be updated.
+ * \param c Buffer to receive \a len bytes of ciphertext.
+ * \param m Points to the plaintext to be encrypted.
+ * \param len Number of bytes to be encrypted.
+ *
+ * \sa xoodyak_aead_stream_encrypt_finalize()
+ */
+void xoodyak_aead_stream_encrypt
+    (xoodyak_aead_state_t *state, unsigned char *c,
+     const unsigned char *m, unsigned long long len);
+
+/**
+ * \brief Decrypts more payload data with an incremental Xoodyak state.
+ *
+ * \param state Incremental AEAD state to be updated.
+ * \param m Buffer to receive \a len bytes of plaintext.
+ * \param c Points to the ciphertext to be decrypted.
+ * \param len Number of bytes to be decrypted.
+ *
+ * \sa xoodyak_aead_stream_decrypt_finalize()
+ */
+void xoodyak_aead_stream_decrypt
+    (xoodyak_aead_state_t *state, unsigned char *m,
+     const unsigned char *c, unsigned long long len);
+
+/**
+ * \brief Finalizes an incremental Xoodyak encryption operation.
+ *
+ * \param state Incremental AEAD state to be finalized.
+ * \param tag Buffer to receive the 16 byte authentication tag.
+ */
+void xoodyak_aead_stream_encrypt_finalize
+    (xoodyak_aead_state_t *state, unsigned char *tag);
+
+/**
+ * \brief Finalizes an incremental Xoodyak decryption operation.
+ *
+ * \param state Incremental AEAD state to be finalized.
+ * \param tag Points to the 16 byte authentication tag to be checked.
+ *
+ * \return 0 if the authentication tag is correct, or -1 otherwise.
+ * The plaintext that was returned by xoodyak_aead_stream_decrypt() must
+ * be discarded if the authentication tag is incorrect.
+ */
+int xoodyak_aead_stream_decrypt_finalize
+    (xoodyak_aead_state_t *state, const unsigned char *tag);
+
 /**
  * \brief Hashes a block of input data with Xoodyak to generate a hash value.
  *
@@ -170,6 +265,25 @@ int xoodyak_aead_decrypt
 int xoodyak_hash
     (unsigned char *out, const unsigned char *in, unsigned long long inlen);
 
+/**
+ * \brief Hashes several messages of the same length with Xoodyak.
+ *
+ * \param out Array of \a count pointers to buffers that receive the
+ * hash outputs, each at least XOODYAK_HASH_SIZE bytes in length.
+ * \param in Array of \a count pointers to the messages to be hashed.
+ * \param inlen Length of every message in bytes.
+ * \param count Number of messages to hash.
+ *
+ * The messages are hashed side by side so that the Xoodoo permutations
+ * for different messages can share the multi-state kernels.  The results
+ * are the same as calling xoodyak_hash() on each message.
+ *
+ * \sa xoodyak_hash()
+ */
+void xoodyak_hash_batch
+    (unsigned char * const *out, const unsigned char * const *in,
+     unsigned long long inlen, size_t count);
+
 /**
  * \brief Initializes the state for a Xoodyak hashing operation.
  *
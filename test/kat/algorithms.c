@@ -73,8 +73,17 @@ static const aead_cipher_t *const ciphers[] = {
     &ascon128a_cipher,
     &ascon80pq_cipher,
     &ascon128_masked_cipher,
+    &ascon128_masked_cipher_x2,
+    &ascon128_masked_cipher_x3,
+    &ascon128_masked_cipher_x4,
     &ascon128a_masked_cipher,
+    &ascon128a_masked_cipher_x2,
+    &ascon128a_masked_cipher_x3,
+    &ascon128a_masked_cipher_x4,
     &ascon80pq_masked_cipher,
+    &ascon80pq_masked_cipher_x2,
+    &ascon80pq_masked_cipher_x3,
+    &ascon80pq_masked_cipher_x4,
     &comet_128_cham_cipher,
     &comet_64_cham_cipher,
     &comet_64_speck_cipher,
@@ -97,8 +106,14 @@ static const aead_cipher_t *const ciphers[] = {
     &gascon80pq_cipher,
     &gift_cofb_cipher,
     &gift_cofb_masked_cipher,
+    &gift_cofb_masked_cipher_x2,
+    &gift_cofb_masked_cipher_x3,
+    &gift_cofb_masked_cipher_x4,
     &gimli24_cipher,
     &gimli24_masked_cipher,
+    &gimli24_masked_cipher_x2,
+    &gimli24_masked_cipher_x3,
+    &gimli24_masked_cipher_x4,
     &grain128_aead_cipher,
     &hyena_v1_cipher,
     &hyena_v2_cipher,
@@ -111,9 +126,21 @@ static const aead_cipher_t *const ciphers[] = {
     &knot_aead_192_384_cipher,
     &knot_aead_256_512_cipher,
     &knot_aead_128_256_masked_cipher,
+    &knot_aead_128_256_masked_cipher_x2,
+    &knot_aead_128_256_masked_cipher_x3,
+    &knot_aead_128_256_masked_cipher_x4,
     &knot_aead_128_384_masked_cipher,
+    &knot_aead_128_384_masked_cipher_x2,
+    &knot_aead_128_384_masked_cipher_x3,
+    &knot_aead_128_384_masked_cipher_x4,
     &knot_aead_192_384_masked_cipher,
+    &knot_aead_192_384_masked_cipher_x2,
+    &knot_aead_192_384_masked_cipher_x3,
+    &knot_aead_192_384_masked_cipher_x4,
     &knot_aead_256_512_masked_cipher,
+    &knot_aead_256_512_masked_cipher_x2,
+    &knot_aead_256_512_masked_cipher_x3,
+    &knot_aead_256_512_masked_cipher_x4,
     &locus_aead_cipher,
     &lotus_aead_cipher,
     &orange_zest_cipher,
@@ -124,7 +151,13 @@ static const aead_cipher_t *const ciphers[] = {
     &pyjamask_128_cipher,
     &pyjamask_96_cipher,
     &pyjamask_masked_128_cipher,
+    &pyjamask_masked_128_cipher_x2,
+    &pyjamask_masked_128_cipher_x3,
+    &pyjamask_masked_128_cipher_x4,
     &pyjamask_masked_96_cipher,
+    &pyjamask_masked_96_cipher_x2,
+    &pyjamask_masked_96_cipher_x3,
+    &pyjamask_masked_96_cipher_x4,
     &romulus_m1_cipher,
     &romulus_m2_cipher,
     &romulus_m3_cipher,
@@ -145,18 +178,39 @@ static const aead_cipher_t *const ciphers[] = {
     &skinny_aead_m6_cipher,
     &spix_cipher,
     &spix_masked_cipher,
+    &spix_masked_cipher_x2,
+    &spix_masked_cipher_x3,
+    &spix_masked_cipher_x4,
     &spoc_128_cipher,
     &spoc_64_cipher,
     &spoc_128_masked_cipher,
+    &spoc_128_masked_cipher_x2,
+    &spoc_128_masked_cipher_x3,
+    &spoc_128_masked_cipher_x4,
     &spoc_64_masked_cipher,
+    &spoc_64_masked_cipher_x2,
+    &spoc_64_masked_cipher_x3,
+    &spoc_64_masked_cipher_x4,
     &spook_128_512_su_cipher,
     &spook_128_384_su_cipher,
     &spook_128_512_mu_cipher,
     &spook_128_384_mu_cipher,
     &spook_128_512_su_masked_cipher,
+    &spook_128_512_su_masked_cipher_x2,
+    &spook_128_512_su_masked_cipher_x3,
+    &spook_128_512_su_masked_cipher_x4,
     &spook_128_384_su_masked_cipher,
+    &spook_128_384_su_masked_cipher_x2,
+    &spook_128_384_su_masked_cipher_x3,
+    &spook_128_384_su_masked_cipher_x4,
     &spook_128_512_mu_masked_cipher,
+    &spook_128_512_mu_masked_cipher_x2,
+    &spook_128_512_mu_masked_cipher_x3,
+    &spook_128_512_mu_masked_cipher_x4,
     &spook_128_384_mu_masked_cipher,
+    &spook_128_384_mu_masked_cipher_x2,
+    &spook_128_384_mu_masked_cipher_x3,
+    &spook_128_384_mu_masked_cipher_x4,
     &subterranean_cipher,
     &sundae_gift_0_cipher,
     &sundae_gift_64_cipher,
@@ -166,11 +220,23 @@ static const aead_cipher_t *const ciphers[] = {
     &tiny_jambu_192_cipher,
     &tiny_jambu_256_cipher,
     &tiny_jambu_128_masked_cipher,
+    &tiny_jambu_128_masked_cipher_x2,
+    &tiny_jambu_128_masked_cipher_x3,
+    &tiny_jambu_128_masked_cipher_x4,
     &tiny_jambu_192_masked_cipher,
+    &tiny_jambu_192_masked_cipher_x2,
+    &tiny_jambu_192_masked_cipher_x3,
+    &tiny_jambu_192_masked_cipher_x4,
     &tiny_jambu_256_masked_cipher,
+    &tiny_jambu_256_masked_cipher_x2,
+    &tiny_jambu_256_masked_cipher_x3,
+    &tiny_jambu_256_masked_cipher_x4,
     &wage_cipher,
     &xoodyak_cipher,
     &xoodyak_masked_cipher,
+    &xoodyak_masked_cipher_x2,
+    &xoodyak_masked_cipher_x3,
+    &xoodyak_masked_cipher_x4,
     0
 };
 
@@ -218,6 +284,22 @@ const aead_hash_algorithm_t *find_hash_algorithm(const char *name)
     return 0;
 }
 
+const aead_cipher_t *get_cipher(int index)
+{
+    int count = (int)(sizeof(ciphers) / sizeof(ciphers[0])) - 1;
+    if (index < 0 || index >= count)
+        return 0;
+    return ciphers[index];
+}
+
+const aead_hash_algorithm_t *get_hash_algorithm(int index)
+{
+    int count = (int)(sizeof(hashes) / sizeof(hashes[0])) - 1;
+    if (index < 0 || index >= count)
+        return 0;
+    return hashes[index];
+}
+
 static void print_cipher_details(const aead_cipher_t *cipher)
 {
     printf("%-30s %8u   %8u   %8u\n",
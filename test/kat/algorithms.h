@@ -27,6 +27,8 @@
 
 const aead_cipher_t *find_cipher(const char *name);
 const aead_hash_algorithm_t *find_hash_algorithm(const char *name);
+const aead_cipher_t *get_cipher(int index);
+const aead_hash_algorithm_t *get_hash_algorithm(int index);
 void print_algorithm_names(void);
 
 #endif
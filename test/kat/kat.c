@@ -25,6 +25,7 @@
 #include <stdlib.h>
 #include <stdarg.h>
 #include "aead-common.h"
+#include "aead-cache.h"
 #include "algorithms.h"
 
 /* Dynamically-allocated test string that was converted from hexadecimal */
@@ -187,6 +188,287 @@ static int test_all_zeroes(const unsigned char *buf, unsigned long long len)
     return 1;
 }
 
+/* Fragment sizes for testing incremental AEAD modes */
+static unsigned const test_fragments[] = {1, 3, 8, 2, 13, 32, 5, 24, 16, 7};
+
+/* Gets the size of the next fragment for an incremental AEAD test */
+static unsigned long long test_next_fragment
+    (unsigned long long remaining, int byte_at_a_time, unsigned *index)
+{
+    unsigned long long size;
+    if (byte_at_a_time) {
+        size = 1;
+    } else {
+        size = test_fragments[*index];
+        *index = (*index + 1) % (sizeof(test_fragments) / sizeof(unsigned));
+    }
+    return size < remaining ? size : remaining;
+}
+
+/* Test the incremental AEAD functions of a cipher on a test vector */
+static int test_cipher_stream
+    (const aead_cipher_t *alg, const test_vector_t *vec,
+     const test_string_t *key, const test_string_t *nonce,
+     const test_string_t *plaintext, const test_string_t *ciphertext,
+     const test_string_t *ad, unsigned char *temp, int byte_at_a_time)
+{
+    const aead_stream_cipher_t *stream = alg->stream;
+    unsigned long long posn, size;
+    unsigned long long mlen = ciphertext->size - alg->tag_len;
+    unsigned index = 0;
+    void *state;
+    int result;
+
+    /* Allocate the incremental state */
+    state = malloc(stream->state_size);
+    if (!state)
+        exit(2);
+
+    /* Encrypt the plaintext in fragments */
+    memset(temp, 0xAA, ciphertext->size);
+    (*(stream->init))(state, nonce->data, key->data);
+    for (posn = 0; posn < ad->size; posn += size) {
+        size = test_next_fragment(ad->size - posn, byte_at_a_time, &index);
+        (*(stream->update_ad))(state, ad->data + posn, size);
+    }
+    for (posn = 0; posn < mlen; posn += size) {
+        size = test_next_fragment(mlen - posn, byte_at_a_time, &index);
+        (*(stream->encrypt))
+            (state, temp + posn, plaintext->data + posn, size);
+    }
+    (*(stream->encrypt_finalize))(state, temp + mlen);
+    if (!test_compare(temp, ciphertext->data, ciphertext->size)) {
+        test_print_error(alg->name, vec, "incremental encryption failed");
+        free(state);
+        return 0;
+    }
+
+    /* Decrypt the ciphertext in place in fragments */
+    memcpy(temp, ciphertext->data, ciphertext->size);
+    (*(stream->init))(state, nonce->data, key->data);
+    for (posn = 0; posn < ad->size; posn += size) {
+        size = test_next_fragment(ad->size - posn, byte_at_a_time, &index);
+        (*(stream->update_ad))(state, ad->data + posn, size);
+    }
+    for (posn = 0; posn < mlen; posn += size) {
+        size = test_next_fragment(mlen - posn, byte_at_a_time, &index);
+        (*(stream->decrypt))(state, temp + posn, temp + posn, size);
+    }
+    result = (*(stream->decrypt_finalize))(state, ciphertext->data + mlen);
+    if (result != 0 || !test_compare(temp, plaintext->data, mlen)) {
+        test_print_error(alg->name, vec, "incremental decryption failed");
+        free(state);
+        return 0;
+    }
+
+    /* Check that a corrupted tag is detected */
+    (*(stream->init))(state, nonce->data, key->data);
+    (*(stream->update_ad))(state, ad->data, ad->size);
+    (*(stream->decrypt))(state, temp, ciphertext->data, mlen);
+    memcpy(temp + mlen, ciphertext->data + mlen, alg->tag_len);
+    temp[ciphertext->size - 1] ^= 0x01; /* Corrupt last byte of the tag */
+    result = (*(stream->decrypt_finalize))(state, temp + mlen);
+    if (result != -1) {
+        test_print_error(alg->name, vec, "incremental tag check failed");
+        free(state);
+        return 0;
+    }
+    free(state);
+    return 1;
+}
+
+/* Number of packets to process in a batch test; larger than the
+ * number of lanes in the multi-lane kernels to exercise left-overs */
+#define TEST_BATCH_SIZE 9
+
+/* Test the batch AEAD functions of a cipher on a test vector */
+static int test_cipher_batch
+    (const aead_cipher_t *alg, const test_vector_t *vec,
+     const test_string_t *key, const test_string_t *nonce,
+     const test_string_t *plaintext, const test_string_t *ciphertext,
+     const test_string_t *ad)
+{
+    aead_batch_item_t items[TEST_BATCH_SIZE];
+    unsigned long long mlen = plaintext->size;
+    unsigned char *out;
+    void *ctx;
+    unsigned index;
+    int ok = 1;
+
+    /* Allocate the output buffers and the key context */
+    out = malloc(ciphertext->size * TEST_BATCH_SIZE);
+    ctx = malloc(aead_context_size(alg));
+    if (!out || !ctx)
+        exit(2);
+    aead_setup_key(alg, ctx, key->data);
+
+    /* Encrypt the same packet several times, alternating between
+     * raw keys and key contexts */
+    memset(out, 0xAA, ciphertext->size * TEST_BATCH_SIZE);
+    memset(items, 0, sizeof(items));
+    for (index = 0; index < TEST_BATCH_SIZE; ++index) {
+        items[index].key = (index & 1) ? 0 : key->data;
+        items[index].ctx = ctx;
+        items[index].npub = nonce->data;
+        items[index].ad = ad->data;
+        items[index].adlen = ad->size;
+        items[index].in = plaintext->data;
+        items[index].inlen = mlen;
+        items[index].out = out + index * ciphertext->size;
+        items[index].status = -2;
+    }
+    if (aead_batch_encrypt(alg, items, TEST_BATCH_SIZE) != 0)
+        ok = 0;
+    for (index = 0; index < TEST_BATCH_SIZE && ok; ++index) {
+        if (items[index].status != 0 ||
+                items[index].outlen != ciphertext->size ||
+                !test_compare(items[index].out, ciphertext->data,
+                              ciphertext->size))
+            ok = 0;
+    }
+    if (!ok) {
+        test_print_error(alg->name, vec, "batch encryption failed");
+        free(out);
+        free(ctx);
+        return 0;
+    }
+
+    /* Decrypt in place, with a corrupted tag on the last packet */
+    out[ciphertext->size * TEST_BATCH_SIZE - 1] ^= 0x01;
+    for (index = 0; index < TEST_BATCH_SIZE; ++index) {
+        items[index].in = items[index].out;
+        items[index].inlen = ciphertext->size;
+        items[index].status = -2;
+    }
+    if (aead_batch_decrypt(alg, items, TEST_BATCH_SIZE) != -1)
+        ok = 0;
+    for (index = 0; index < TEST_BATCH_SIZE && ok; ++index) {
+        if (index == (TEST_BATCH_SIZE - 1)) {
+            if (items[index].status != -1 ||
+                    !test_all_zeroes(items[index].out, mlen))
+                ok = 0;
+        } else if (items[index].status != 0 ||
+                   items[index].outlen != mlen ||
+                   !test_compare(items[index].out, plaintext->data, mlen)) {
+            ok = 0;
+        }
+    }
+    if (!ok)
+        test_print_error(alg->name, vec, "batch decryption failed");
+    free(out);
+    free(ctx);
+    return ok;
+}
+
+/* Number of distinct keys to cycle through the key context cache,
+ * which has room for one less than this to force evictions */
+#define TEST_CACHE_KEYS 3
+
+/* Test the key context cache with a cipher on a test vector */
+static int test_cipher_cache
+    (const aead_cipher_t *alg, const test_vector_t *vec,
+     const test_string_t *key, const test_string_t *nonce,
+     const test_string_t *plaintext, const test_string_t *ciphertext,
+     const test_string_t *ad)
+{
+    aead_key_cache_t *cache;
+    aead_key_cache_stats_t stats;
+    unsigned char *temp;
+    unsigned char *other_key;
+    unsigned long long len;
+    size_t entry_size;
+    unsigned round, index;
+    int result;
+    int ok = 1;
+
+    /* Find the size of a cache entry for this cipher and then create
+     * a cache that can hold all but one of the keys */
+    temp = malloc(ciphertext->size);
+    other_key = malloc(alg->key_len);
+    cache = aead_key_cache_new(65536);
+    if (!cache || !temp || !other_key)
+        exit(2);
+    aead_key_cache_encrypt
+        (cache, alg, temp, &len, plaintext->data, plaintext->size,
+         ad->data, ad->size, nonce->data, key->data);
+    aead_key_cache_get_stats(cache, &stats);
+    entry_size = stats.bytes;
+    aead_key_cache_free(cache);
+    cache = aead_key_cache_new(entry_size * (TEST_CACHE_KEYS - 1));
+    if (!cache)
+        exit(2);
+
+    /* Encrypt and decrypt with the real key twice in a row, and then with
+     * other keys to push the real key out of the cache, several times over */
+    for (round = 0; round < 2 && ok; ++round) {
+        memset(temp, 0xAA, ciphertext->size);
+        len = 0xBADBEEF;
+        result = aead_key_cache_encrypt
+            (cache, alg, temp, &len, plaintext->data, plaintext->size,
+             ad->data, ad->size, nonce->data, key->data);
+        if (result != 0 || len != ciphertext->size ||
+                !test_compare(temp, ciphertext->data, len)) {
+            test_print_error(alg->name, vec, "key cache encryption failed");
+            ok = 0;
+            break;
+        }
+        memset(temp, 0xAA, ciphertext->size);
+        len = 0xBADBEEF;
+        result = aead_key_cache_decrypt
+            (cache, alg, temp, &len, ciphertext->data, ciphertext->size,
+             ad->data, ad->size, nonce->data, key->data);
+        if (result != 0 || len != plaintext->size ||
+                !test_compare(temp, plaintext->data, len)) {
+            test_print_error(alg->name, vec, "key cache decryption failed");
+            ok = 0;
+            break;
+        }
+        for (index = 1; index < TEST_CACHE_KEYS; ++index) {
+            memcpy(other_key, key->data, alg->key_len);
+            other_key[0] ^= (unsigned char)index;
+            result = aead_key_cache_decrypt
+                (cache, alg, temp, &len, ciphertext->data, ciphertext->size,
+                 ad->data, ad->size, nonce->data, other_key);
+            if (result != -1) {
+                test_print_error(alg->name, vec, "key cache used wrong key");
+                ok = 0;
+                break;
+            }
+        }
+    }
+
+    /* Check the statistics: every use of the real key after the first
+     * in each round is a hit and everything else is a miss */
+    aead_key_cache_get_stats(cache, &stats);
+    if (ok && alg->setup_key) {
+        if (stats.hits != 2 || stats.misses != 2 * TEST_CACHE_KEYS ||
+                stats.evictions != 2 * TEST_CACHE_KEYS - 2 ||
+                stats.entries != TEST_CACHE_KEYS - 1 ||
+                stats.bytes > stats.budget || stats.bypasses != 0) {
+            test_print_error(alg->name, vec, "key cache statistics incorrect");
+            ok = 0;
+        }
+    } else if (ok) {
+        if (stats.hits != 0 || stats.misses != 0 || stats.entries != 0 ||
+                stats.bypasses != 2 * (TEST_CACHE_KEYS + 1)) {
+            test_print_error(alg->name, vec, "key cache statistics incorrect");
+            ok = 0;
+        }
+    }
+
+    /* Check that clearing the cache removes all entries */
+    aead_key_cache_clear(cache);
+    aead_key_cache_get_stats(cache, &stats);
+    if (ok && (stats.entries != 0 || stats.bytes != 0)) {
+        test_print_error(alg->name, vec, "key cache was not cleared");
+        ok = 0;
+    }
+    aead_key_cache_free(cache);
+    free(temp);
+    free(other_key);
+    return ok;
+}
+
 /* Test a cipher algorithm on a specific test vector */
 static int test_cipher_inner
     (const aead_cipher_t *alg, const test_vector_t *vec)
@@ -198,6 +480,7 @@ static int test_cipher_inner
     const test_string_t *ad;
     unsigned char *temp1;
     unsigned char *temp2;
+    void *ctx;
     unsigned long long len;
     int result;
 
@@ -326,6 +609,65 @@ static int test_cipher_inner
         return 0;
     }
 
+    /* Test encryption and decryption with a precomputed key context */
+    ctx = malloc(aead_context_size(alg));
+    if (!ctx)
+        exit(2);
+    aead_setup_key(alg, ctx, key->data);
+    memset(temp1, 0xAA, ciphertext->size);
+    len = 0xBADBEEF;
+    result = aead_encrypt_with_context
+        (alg, temp1, &len, plaintext->data, plaintext->size,
+         ad->data, ad->size, nonce->data, ctx);
+    if (result != 0 || len != ciphertext->size ||
+            !test_compare(temp1, ciphertext->data, len)) {
+        test_print_error(alg->name, vec, "key context encryption failed");
+        free(ctx);
+        free(temp1);
+        free(temp2);
+        return 0;
+    }
+    memset(temp1, 0xAA, ciphertext->size);
+    len = 0xBADBEEF;
+    result = aead_decrypt_with_context
+        (alg, temp1, &len, ciphertext->data, ciphertext->size,
+         ad->data, ad->size, nonce->data, ctx);
+    if (result != 0 || len != plaintext->size ||
+            !test_compare(temp1, plaintext->data, len)) {
+        test_print_error(alg->name, vec, "key context decryption failed");
+        free(ctx);
+        free(temp1);
+        free(temp2);
+        return 0;
+    }
+    free(ctx);
+
+    /* Test the batch functions */
+    if (!test_cipher_batch(alg, vec, key, nonce, plaintext, ciphertext, ad)) {
+        free(temp1);
+        free(temp2);
+        return 0;
+    }
+
+    /* Test the key context cache */
+    if (!test_cipher_cache(alg, vec, key, nonce, plaintext, ciphertext, ad)) {
+        free(temp1);
+        free(temp2);
+        return 0;
+    }
+
+    /* Test the incremental functions if the cipher has them */
+    if (alg->stream) {
+        if (!test_cipher_stream(alg, vec, key, nonce, plaintext,
+                                ciphertext, ad, temp1, 1) ||
+                !test_cipher_stream(alg, vec, key, nonce, plaintext,
+                                    ciphertext, ad, temp1, 0)) {
+            free(temp1);
+            free(temp2);
+            return 0;
+        }
+    }
+
     /* All tests passed for this test vector */
     free(temp1);
     free(temp2);
@@ -0,0 +1,554 @@
+/*
+ * Copyright (C) 2020 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#if !defined(_POSIX_C_SOURCE) || _POSIX_C_SOURCE < 199309L
+#undef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include "aead-common.h"
+#include "algorithms.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAVE_TSC 1
+#endif
+
+/* Maximum number of entries in a size sweep */
+#define MAX_SIZES 16
+
+/* Maximum number of timing samples that we will take for a measurement */
+#define MAX_SAMPLES 101
+
+/* Command-line parameters */
+static unsigned msg_sizes[MAX_SIZES] = {16, 64, 256, 1024, 8192};
+static unsigned num_msg_sizes = 5;
+static unsigned ad_sizes[MAX_SIZES] = {0, 16, 64};
+static unsigned num_ad_sizes = 3;
+static unsigned hash_sizes[MAX_SIZES] = {16, 64, 256, 1024, 8192};
+static unsigned num_hash_sizes = 5;
+static int num_samples = 15;
+static int num_warmup = 3;
+static long sample_time_us = 1000;
+static int use_tsc = 1;
+static int ciphers_only = 0;
+static int hashes_only = 0;
+
+/* Buffers for the input and output data */
+static unsigned char key[64];
+static unsigned char nonce[64];
+static unsigned char *ad_buf = 0;
+static unsigned char *pt_buf = 0;
+static unsigned char *ct_buf = 0;
+static unsigned char *out_buf = 0;
+static unsigned max_data_size = 0;
+
+/**
+ * \brief Reads the current value of the monotonic nanosecond clock.
+ *
+ * \return The clock value in nanoseconds.
+ */
+static unsigned long long bench_nanoseconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((unsigned long long)ts.tv_sec) * 1000000000ULL +
+           (unsigned long long)ts.tv_nsec;
+}
+
+/**
+ * \brief Reads the current value of the benchmark clock.
+ *
+ * \return The time stamp counter if it is available and selected,
+ * or the monotonic clock in nanoseconds otherwise.
+ */
+static unsigned long long bench_ticks(void)
+{
+#if defined(BENCH_HAVE_TSC)
+    if (use_tsc) {
+        /* Serialize with lfence so that the measured code does not
+         * get reordered across the counter read */
+        unsigned long long ticks;
+        _mm_lfence();
+        ticks = __rdtsc();
+        _mm_lfence();
+        return ticks;
+    }
+#endif
+    return bench_nanoseconds();
+}
+
+/**
+ * \brief Operation that is being benchmarked.
+ */
+typedef struct
+{
+    const aead_cipher_t *cipher;        /**< Cipher to encrypt/decrypt with */
+    const aead_hash_algorithm_t *hash;  /**< Hash algorithm to measure */
+    int decrypt;                        /**< Non-zero to measure decryption */
+    unsigned mlen;                      /**< Length of the message */
+    unsigned adlen;                     /**< Length of the associated data */
+    unsigned long long clen;            /**< Length of the ciphertext */
+
+} bench_op_t;
+
+/**
+ * \brief Runs a benchmarked operation a number of times.
+ *
+ * \param op The operation to run.
+ * \param iterations Number of iterations.
+ *
+ * \return Zero on success or non-zero if the operation failed.
+ */
+static int bench_run(const bench_op_t *op, unsigned long iterations)
+{
+    unsigned long long len;
+    int result = 0;
+    while (iterations > 0) {
+        if (op->hash) {
+            result |= (*(op->hash->hash))(out_buf, pt_buf, op->mlen);
+        } else if (op->decrypt) {
+            result |= (*(op->cipher->decrypt))
+                (out_buf, &len, 0, ct_buf, op->clen,
+                 ad_buf, op->adlen, nonce, key);
+        } else {
+            result |= (*(op->cipher->encrypt))
+                (out_buf, &len, pt_buf, op->mlen,
+                 ad_buf, op->adlen, 0, nonce, key);
+        }
+        --iterations;
+    }
+    return result;
+}
+
+/**
+ * \brief Compares two timing samples for qsort().
+ */
+static int compare_samples(const void *a, const void *b)
+{
+    double x = *((const double *)a);
+    double y = *((const double *)b);
+    return (x < y) ? -1 : ((x > y) ? 1 : 0);
+}
+
+/**
+ * \brief Measures the number of clock ticks for a single operation.
+ *
+ * \param op The operation to measure.
+ * \param ticks Returns the number of ticks per operation.
+ *
+ * \return Zero on success or non-zero if the operation failed.
+ *
+ * The number of iterations per sample is calibrated during the warmup
+ * phase so that each sample takes roughly "sample_time_us" microseconds.
+ * The samples are sorted and anything outside the Tukey fences
+ * (1.5 x the inter-quartile range beyond the quartiles) is rejected as
+ * an outlier caused by interrupts or context switches.  The remaining
+ * samples are averaged.
+ */
+static int bench_measure(const bench_op_t *op, double *ticks)
+{
+    double samples[MAX_SAMPLES];
+    unsigned long iterations = 1;
+    unsigned long long start, elapsed;
+    double q1, q3, iqr, low, high, sum;
+    int index, count;
+
+    /* Warm up the caches and branch predictors, and calibrate */
+    for (index = 0; index < num_warmup; ++index) {
+        start = bench_nanoseconds();
+        if (bench_run(op, iterations) != 0)
+            return -1;
+        elapsed = bench_nanoseconds() - start;
+        if (elapsed < 1)
+            elapsed = 1;
+        iterations = (unsigned long)
+            ((iterations * sample_time_us * 1000ULL) / elapsed);
+        if (iterations < 1)
+            iterations = 1;
+    }
+
+    /* Collect the samples */
+    for (index = 0; index < num_samples; ++index) {
+        start = bench_ticks();
+        if (bench_run(op, iterations) != 0)
+            return -1;
+        elapsed = bench_ticks() - start;
+        samples[index] = ((double)elapsed) / iterations;
+    }
+
+    /* Reject outliers and average the rest */
+    qsort(samples, num_samples, sizeof(double), compare_samples);
+    q1 = samples[num_samples / 4];
+    q3 = samples[(num_samples * 3) / 4];
+    iqr = q3 - q1;
+    low = q1 - 1.5 * iqr;
+    high = q3 + 1.5 * iqr;
+    sum = 0;
+    count = 0;
+    for (index = 0; index < num_samples; ++index) {
+        if (samples[index] >= low && samples[index] <= high) {
+            sum += samples[index];
+            ++count;
+        }
+    }
+    *ticks = (count > 0) ? (sum / count) : samples[num_samples / 2];
+    return 0;
+}
+
+/**
+ * \brief Prints the result of a measurement.
+ *
+ * \param ticks Number of ticks per operation, or negative if failed.
+ * \param bytes Number of bytes that were processed by the operation.
+ */
+static void print_result(double ticks, unsigned bytes)
+{
+    if (ticks < 0)
+        printf("  %10s", "n/a");
+    else if (bytes == 0)
+        printf("  %10.0f", ticks);
+    else
+        printf("  %10.2f", ticks / bytes);
+}
+
+/**
+ * \brief Benchmarks an AEAD cipher across the message and AD size sweep.
+ *
+ * \param cipher The cipher to benchmark.
+ */
+static void bench_cipher(const aead_cipher_t *cipher)
+{
+    unsigned long long len;
+    bench_op_t op;
+    double ticks;
+    unsigned m, a;
+
+    printf("%s:\n", cipher->name);
+    memset(&op, 0, sizeof(op));
+    op.cipher = cipher;
+    for (a = 0; a < num_ad_sizes; ++a) {
+        for (m = 0; m < num_msg_sizes; ++m) {
+            op.mlen = msg_sizes[m];
+            op.adlen = ad_sizes[a];
+            printf("   %6u %6u", op.mlen, op.adlen);
+
+            /* Encryption; also produces the ciphertext to decrypt */
+            op.decrypt = 0;
+            if ((*(cipher->encrypt))
+                    (ct_buf, &op.clen, pt_buf, op.mlen,
+                     ad_buf, op.adlen, 0, nonce, key) != 0) {
+                /* Some ciphers have a limit on the packet size */
+                print_result(-1, 0);
+                print_result(-1, 0);
+                printf("\n");
+                continue;
+            }
+            if (bench_measure(&op, &ticks) != 0)
+                ticks = -1;
+            print_result(ticks, op.mlen + op.adlen);
+
+            /* Decryption, which also verifies the round trip */
+            op.decrypt = 1;
+            if ((*(cipher->decrypt))
+                    (out_buf, &len, 0, ct_buf, op.clen,
+                     ad_buf, op.adlen, nonce, key) != 0 ||
+                    len != op.mlen || memcmp(out_buf, pt_buf, op.mlen) != 0) {
+                printf("  %10s\n", "FAILED");
+                continue;
+            }
+            if (bench_measure(&op, &ticks) != 0)
+                ticks = -1;
+            print_result(ticks, op.mlen + op.adlen);
+            printf("\n");
+        }
+    }
+    printf("\n");
+}
+
+/**
+ * \brief Benchmarks a hash algorithm across the message size sweep.
+ *
+ * \param hash The hash algorithm to benchmark.
+ */
+static void bench_hash(const aead_hash_algorithm_t *hash)
+{
+    bench_op_t op;
+    double ticks;
+    unsigned m;
+
+    printf("%s:\n", hash->name);
+    memset(&op, 0, sizeof(op));
+    op.hash = hash;
+    for (m = 0; m < num_hash_sizes; ++m) {
+        op.mlen = hash_sizes[m];
+        printf("   %6u       ", op.mlen);
+        if (bench_measure(&op, &ticks) != 0)
+            ticks = -1;
+        print_result(ticks, op.mlen);
+        printf("\n");
+    }
+    printf("\n");
+}
+
+/**
+ * \brief Parses a comma-separated list of sizes.
+ *
+ * \param name1 The name of the option from the command-line.
+ * \param name2 The name of the option we are looking for.
+ * \param sizes Array to fill with the sizes.
+ * \param num_sizes Returns the number of sizes that were parsed.
+ *
+ * \return Non-zero if the option was parsed or zero if \a name1 is
+ * not the same as \a name2.
+ */
+static int parse_sizes
+    (const char *name1, const char *name2, unsigned *sizes,
+     unsigned *num_sizes)
+{
+    size_t len = strlen(name2);
+    const char *value;
+    char *end;
+    if (strlen(name1) <= len)
+        return 0;
+    if (strncmp(name1, name2, len) != 0 || name1[len] != '=')
+        return 0;
+    value = name1 + len + 1;
+    *num_sizes = 0;
+    while (*value != '\0' && *num_sizes < MAX_SIZES) {
+        long size = strtol(value, &end, 10);
+        if (end == value)
+            break;
+        if (size < 0)
+            size = 0; /* Sanity check */
+        else if (size > 1048576)
+            size = 1048576; /* Sanity check */
+        sizes[(*num_sizes)++] = (unsigned)size;
+        value = end;
+        if (*value == ',')
+            ++value;
+    }
+    return 1;
+}
+
+/**
+ * \brief Parses a numeric option.
+ *
+ * \param name1 The name of the option from the command-line.
+ * \param name2 The name of the option we are looking for.
+ * \param value The value to return if \a name1 is the same as \a name2.
+ * \param min_value Minimum value for the option.
+ * \param max_value Maximum value for the option.
+ *
+ * \return Non-zero if the option was parsed or zero if \a name1 is
+ * not the same as \a name2.
+ */
+static int parse_option
+    (const char *name1, const char *name2, long *value,
+     long min_value, long max_value)
+{
+    size_t len = strlen(name2);
+    if (strlen(name1) <= len)
+        return 0;
+    if (strncmp(name1, name2, len) != 0 || name1[len] != '=')
+        return 0;
+    *value = atol(name1 + len + 1);
+    if (*value < min_value)
+        *value = min_value; /* Sanity check */
+    else if (*value > max_value)
+        *value = max_value; /* Sanity check */
+    return 1;
+}
+
+/**
+ * \brief Prints usage information for this program.
+ *
+ * \param progname Name of the program from the argv[0] argument.
+ */
+static void usage(const char *progname)
+{
+    fprintf(stderr, "Usage: %s [options] [ALGORITHM ...]\n\n", progname);
+
+    fprintf(stderr, "Benchmarks all algorithms if none are named.\n\n");
+
+    fprintf(stderr, "Options:\n");
+    fprintf(stderr, "    --msg-sizes=N,N,...\n");
+    fprintf(stderr, "        Plaintext sizes for ciphers, default is 16,64,256,1024,8192.\n\n");
+
+    fprintf(stderr, "    --ad-sizes=N,N,...\n");
+    fprintf(stderr, "        Associated data sizes for ciphers, default is 0,16,64.\n\n");
+
+    fprintf(stderr, "    --hash-sizes=N,N,...\n");
+    fprintf(stderr, "        Input sizes for hash algorithms, default is 16,64,256,1024,8192.\n\n");
+
+    fprintf(stderr, "    --samples=N\n");
+    fprintf(stderr, "        Number of timing samples per measurement, default is 15.\n\n");
+
+    fprintf(stderr, "    --warmup=N\n");
+    fprintf(stderr, "        Number of warmup/calibration rounds, default is 3.\n\n");
+
+    fprintf(stderr, "    --sample-time=US\n");
+    fprintf(stderr, "        Target duration of each sample in microseconds, default is 1000.\n\n");
+
+    fprintf(stderr, "    --ns\n");
+    fprintf(stderr, "        Report nanoseconds per byte from clock_gettime() rather than\n");
+    fprintf(stderr, "        cycles per byte from the CPU's time stamp counter.\n\n");
+
+    fprintf(stderr, "    --ciphers\n");
+    fprintf(stderr, "    --hashes\n");
+    fprintf(stderr, "        Only benchmark the AEAD ciphers or the hash algorithms.\n");
+
+    print_algorithm_names();
+}
+
+/**
+ * \brief Allocates the data buffers based on the requested sizes.
+ */
+static void allocate_buffers(void)
+{
+    unsigned index;
+    for (index = 0; index < num_msg_sizes; ++index) {
+        if (msg_sizes[index] > max_data_size)
+            max_data_size = msg_sizes[index];
+    }
+    for (index = 0; index < num_ad_sizes; ++index) {
+        if (ad_sizes[index] > max_data_size)
+            max_data_size = ad_sizes[index];
+    }
+    for (index = 0; index < num_hash_sizes; ++index) {
+        if (hash_sizes[index] > max_data_size)
+            max_data_size = hash_sizes[index];
+    }
+    ad_buf = (unsigned char *)malloc(max_data_size + 1);
+    pt_buf = (unsigned char *)malloc(max_data_size + 1);
+    ct_buf = (unsigned char *)malloc(max_data_size + 256);
+    out_buf = (unsigned char *)malloc(max_data_size + 256);
+    if (!ad_buf || !pt_buf || !ct_buf || !out_buf) {
+        fprintf(stderr, "Out of memory\n");
+        exit(1);
+    }
+    for (index = 0; index < max_data_size; ++index) {
+        ad_buf[index] = (unsigned char)(index * 7);
+        pt_buf[index] = (unsigned char)index;
+    }
+    for (index = 0; index < sizeof(key); ++index)
+        key[index] = (unsigned char)index;
+    for (index = 0; index < sizeof(nonce); ++index)
+        nonce[index] = (unsigned char)(0x80 + index);
+}
+
+int main(int argc, char *argv[])
+{
+    const aead_cipher_t *cipher;
+    const aead_hash_algorithm_t *hash;
+    const char *progname = argv[0];
+    const char *units;
+    long value;
+    int index;
+
+    /* Process the options */
+    while (argc > 1 && !strncmp(argv[1], "--", 2)) {
+        const char *name = argv[1] + 2;
+        ++argv;
+        --argc;
+        if (*name == '\0') /* "--" on its own terminates the options */
+            break;
+        if (parse_sizes(name, "msg-sizes", msg_sizes, &num_msg_sizes))
+            continue;
+        if (parse_sizes(name, "ad-sizes", ad_sizes, &num_ad_sizes))
+            continue;
+        if (parse_sizes(name, "hash-sizes", hash_sizes, &num_hash_sizes))
+            continue;
+        if (parse_option(name, "samples", &value, 1, MAX_SAMPLES)) {
+            num_samples = (int)value;
+            continue;
+        }
+        if (parse_option(name, "warmup", &value, 1, 100)) {
+            num_warmup = (int)value;
+            continue;
+        }
+        if (parse_option(name, "sample-time", &value, 1, 10000000)) {
+            sample_time_us = value;
+            continue;
+        }
+        if (!strcmp(name, "ns")) {
+            use_tsc = 0;
+            continue;
+        }
+        if (!strcmp(name, "ciphers")) {
+            ciphers_only = 1;
+            continue;
+        }
+        if (!strcmp(name, "hashes")) {
+            hashes_only = 1;
+            continue;
+        }
+        if (strcmp(name, "help") != 0)
+            fprintf(stderr, "Unknown option '--%s'\n", name);
+        usage(progname);
+        return 1;
+    }
+#if !defined(BENCH_HAVE_TSC)
+    use_tsc = 0;
+#endif
+    units = use_tsc ? "cycles/byte" : "ns/byte";
+    allocate_buffers();
+
+    /* Print the column headings */
+    printf("Units: %s (operations on 0 bytes are reported per call)\n\n",
+           units);
+    printf("   %6s %6s  %10s  %10s\n", "MsgLen", "AdLen", "Encrypt", "Decrypt");
+    printf("\n");
+
+    /* Benchmark the named algorithms or everything */
+    if (argc > 1) {
+        for (index = 1; index < argc; ++index) {
+            if ((cipher = find_cipher(argv[index])) != 0) {
+                bench_cipher(cipher);
+            } else if ((hash = find_hash_algorithm(argv[index])) != 0) {
+                bench_hash(hash);
+            } else {
+                fprintf(stderr, "Unknown algorithm name '%s'\n", argv[index]);
+                return 1;
+            }
+        }
+    } else {
+        if (!hashes_only) {
+            for (index = 0; (cipher = get_cipher(index)) != 0; ++index)
+                bench_cipher(cipher);
+        }
+        if (!ciphers_only) {
+            for (index = 0; (hash = get_hash_algorithm(index)) != 0; ++index)
+                bench_hash(hash);
+        }
+    }
+
+    /* Clean up and exit */
+    free(ad_buf);
+    free(pt_buf);
+    free(ct_buf);
+    free(out_buf);
+    return 0;
+}
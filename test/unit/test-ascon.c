@@ -114,11 +114,143 @@ static void test_ascon_sliced(void)
 
 #endif
 
+static void test_ascon_multi_lane(void)
+{
+    ascon_x4_state_t state4;
+    ascon_x8_state_t state8;
+    uint8_t output[40];
+    unsigned lane, word;
+    int ok;
+
+    printf("    Multi-lane kernel: %s\n", ascon_multi_lane_variant());
+    printf("    Permutation x4 ... ");
+    fflush(stdout);
+    for (lane = 0; lane < 4; ++lane) {
+        for (word = 0; word < 5; ++word) {
+            state4.S[word][lane] = be_load_word64(ascon_input + word * 8);
+        }
+    }
+    ascon_permute_x4(&state4, 0);
+    ok = 1;
+    for (lane = 0; lane < 4; ++lane) {
+        for (word = 0; word < 5; ++word)
+            be_store_word64(output + word * 8, state4.S[word][lane]);
+        if (memcmp(output, ascon_output_12, sizeof(ascon_output_12)) != 0)
+            ok = 0;
+    }
+    if (!ok) {
+        printf("failed\n");
+        test_exit_result = 1;
+    } else {
+        printf("ok\n");
+    }
+
+    printf("    Permutation x8 ... ");
+    fflush(stdout);
+    for (lane = 0; lane < 8; ++lane) {
+        for (word = 0; word < 5; ++word) {
+            state8.S[word][lane] = be_load_word64(ascon_input + word * 8);
+        }
+    }
+    ascon_permute_x8(&state8, 4);
+    ok = 1;
+    for (lane = 0; lane < 8; ++lane) {
+        for (word = 0; word < 5; ++word)
+            be_store_word64(output + word * 8, state8.S[word][lane]);
+        if (memcmp(output, ascon_output_8, sizeof(ascon_output_8)) != 0)
+            ok = 0;
+    }
+    if (!ok) {
+        printf("failed\n");
+        test_exit_result = 1;
+    } else {
+        printf("ok\n");
+    }
+}
+
+#define ASCON_BATCH_COUNT 11
+#define ASCON_BATCH_MAX_LEN 37
+
+static void test_ascon_batch(void)
+{
+    static unsigned char const lengths[] = {0, 1, 7, 8, 9, 16, 37};
+    unsigned char keys[ASCON_BATCH_COUNT][16];
+    unsigned char nonces[ASCON_BATCH_COUNT][16];
+    unsigned char ads[ASCON_BATCH_COUNT][ASCON_BATCH_MAX_LEN];
+    unsigned char plaintexts[ASCON_BATCH_COUNT][ASCON_BATCH_MAX_LEN];
+    unsigned char outputs[ASCON_BATCH_COUNT][ASCON_BATCH_MAX_LEN + 16];
+    unsigned char expected[ASCON_BATCH_MAX_LEN + 16];
+    const unsigned char *k[ASCON_BATCH_COUNT];
+    const unsigned char *npub[ASCON_BATCH_COUNT];
+    const unsigned char *ad[ASCON_BATCH_COUNT];
+    const unsigned char *m[ASCON_BATCH_COUNT];
+    const unsigned char *cin[ASCON_BATCH_COUNT];
+    unsigned char *out[ASCON_BATCH_COUNT];
+    int results[ASCON_BATCH_COUNT];
+    unsigned long long len;
+    unsigned index, posn, count;
+    int ok = 1;
+
+    printf("    Batch Encrypt/Decrypt ... ");
+    fflush(stdout);
+    for (index = 0; index < ASCON_BATCH_COUNT; ++index) {
+        for (posn = 0; posn < 16; ++posn) {
+            keys[index][posn] = (unsigned char)(index * 17 + posn);
+            nonces[index][posn] = (unsigned char)(index * 5 + posn * 3);
+        }
+        for (posn = 0; posn < ASCON_BATCH_MAX_LEN; ++posn) {
+            ads[index][posn] = (unsigned char)(index + posn * 7);
+            plaintexts[index][posn] = (unsigned char)(index * 3 + posn);
+        }
+        k[index] = keys[index];
+        npub[index] = nonces[index];
+        ad[index] = ads[index];
+        m[index] = plaintexts[index];
+        cin[index] = outputs[index];
+        out[index] = outputs[index];
+    }
+    for (count = 0; count < sizeof(lengths) && ok; ++count) {
+        /* Use a different number of packets each time to exercise
+         * both the multi-lane path and the left-over packets */
+        unsigned mlen = lengths[count];
+        unsigned adlen = lengths[sizeof(lengths) - 1 - count];
+        unsigned packets = ASCON_BATCH_COUNT - count;
+        ascon128_aead_encrypt_batch
+            (out, m, mlen, ad, adlen, npub, k, packets);
+        for (index = 0; index < packets; ++index) {
+            ascon128_aead_encrypt
+                (expected, &len, m[index], mlen, ad[index], adlen,
+                 0, npub[index], k[index]);
+            if (memcmp(expected, outputs[index], mlen + 16) != 0)
+                ok = 0;
+        }
+        outputs[packets - 1][0] ^= 0x01;
+        if (ascon128_aead_decrypt_batch
+                (out, cin, mlen + 16, ad, adlen, npub, k,
+                 results, packets) != -1)
+            ok = 0;
+        for (index = 0; index < packets; ++index) {
+            if (results[index] != (index == (packets - 1) ? -1 : 0))
+                ok = 0;
+            else if (index != (packets - 1) &&
+                     memcmp(outputs[index], plaintexts[index], mlen) != 0)
+                ok = 0;
+        }
+    }
+    if (!ok) {
+        printf("failed\n");
+        test_exit_result = 1;
+    } else {
+        printf("ok\n");
+    }
+}
+
 static void test_ascon_masked(void)
 {
     ascon_masked_state_t state;
     ascon_state_t unmasked;
 
+    printf("    Masked kernel: %s\n", ascon_masked_variant());
     printf("    Masked Permutation 12 ... ");
     fflush(stdout);
     memcpy(unmasked.B, ascon_input, sizeof(ascon_input));
@@ -161,6 +293,8 @@ void test_ascon(void)
 #if ASCON_SLICED
     test_ascon_sliced();
 #endif
+    test_ascon_multi_lane();
+    test_ascon_batch();
     test_ascon_masked();
     test_aead_cipher_end(&ascon128_cipher);
 }
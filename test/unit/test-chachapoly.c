@@ -233,10 +233,71 @@ static void test_chachapoly_vector
     }
 }
 
+#define LONG_PLAINTEXT_LEN 1500
+
+/* Test that long packets, which are encrypted several blocks at a time,
+ * produce the same keystream as the prefixes that are encrypted one
+ * block at a time */
+static int test_chachapoly_long_inner(const aead_cipher_t *cipher)
+{
+    static unsigned const prefixes[] = {
+        1, 63, 64, 100, 255, 256, 300, 511, 512, 777, 1023, 1024, 1300
+    };
+    static unsigned char plaintext[LONG_PLAINTEXT_LEN];
+    static unsigned char ciphertext[LONG_PLAINTEXT_LEN + CHACHAPOLY_TAG_SIZE];
+    static unsigned char temp[LONG_PLAINTEXT_LEN + CHACHAPOLY_TAG_SIZE];
+    unsigned char key[CHACHAPOLY_KEY_SIZE];
+    unsigned char nonce[CHACHAPOLY_NONCE_SIZE];
+    unsigned long long len;
+    unsigned index;
+
+    /* Encrypt the full packet */
+    for (index = 0; index < sizeof(key); ++index)
+        key[index] = (unsigned char)(index * 7 + 1);
+    for (index = 0; index < sizeof(nonce); ++index)
+        nonce[index] = (unsigned char)(0xA0 + index);
+    for (index = 0; index < LONG_PLAINTEXT_LEN; ++index)
+        plaintext[index] = (unsigned char)(index * 13);
+    (*(cipher->encrypt))
+        (ciphertext, &len, plaintext, LONG_PLAINTEXT_LEN,
+         0, 0, 0, nonce, key);
+
+    /* Compare against the prefixes */
+    for (index = 0; index < sizeof(prefixes) / sizeof(prefixes[0]); ++index) {
+        (*(cipher->encrypt))
+            (temp, &len, plaintext, prefixes[index], 0, 0, 0, nonce, key);
+        if (test_memcmp(temp, ciphertext, prefixes[index]) != 0)
+            return 0;
+    }
+
+    /* Decrypt the full packet */
+    if ((*(cipher->decrypt))
+            (temp, &len, 0, ciphertext,
+             LONG_PLAINTEXT_LEN + CHACHAPOLY_TAG_SIZE,
+             0, 0, nonce, key) != 0 || len != LONG_PLAINTEXT_LEN ||
+            test_memcmp(temp, plaintext, LONG_PLAINTEXT_LEN) != 0)
+        return 0;
+    return 1;
+}
+
+static void test_chachapoly_long(const aead_cipher_t *cipher)
+{
+    printf("    Long Packets ... ");
+    fflush(stdout);
+
+    if (test_chachapoly_long_inner(cipher)) {
+        printf("ok\n");
+    } else {
+        printf("failed\n");
+        test_exit_result = 1;
+    }
+}
+
 void test_chachapoly(void)
 {
     test_aead_cipher_start(&internal_chachapoly_cipher);
     test_chachapoly_vector
         (&internal_chachapoly_cipher, &testVectorChaChaPoly_1);
+    test_chachapoly_long(&internal_chachapoly_cipher);
     test_aead_cipher_end(&internal_chachapoly_cipher);
 }
@@ -321,3 +321,125 @@ void test_hash
         test_exit_result = 1;
     }
 }
+
+/* Number of states or messages to process at once in the multi-state and
+ * batch hashing tests.  This is more than twice the widest 16-lane kernel,
+ * and odd so that there is always a partial group of states at the end */
+#define TEST_MULTI_STATES 37
+
+/* Maximum size of a permutation state in the multi-state tests */
+#define TEST_MULTI_MAX_STATE_SIZE 64
+
+/* Maximum message length in the batch hashing tests */
+#define TEST_BATCH_MAX_LEN 100
+
+/* Maximum hash output length in the batch hashing tests */
+#define TEST_BATCH_MAX_HASH_LEN 64
+
+void test_permute_multi_state
+    (const char *name, const char *variant, size_t state_size,
+     test_permute_t permute, test_permute_n_t permute_n,
+     test_permute_t permute_x4, test_permute_t permute_x8)
+{
+    static uint32_t states
+        [TEST_MULTI_STATES * TEST_MULTI_MAX_STATE_SIZE / 4];
+    static uint32_t expected
+        [TEST_MULTI_STATES * TEST_MULTI_MAX_STATE_SIZE / 4];
+    unsigned char *s = (unsigned char *)states;
+    unsigned char *e = (unsigned char *)expected;
+    unsigned count, index, posn;
+    int ok = 1;
+
+    printf("    %s (%s) ... ", name, variant);
+    fflush(stdout);
+    if (state_size > TEST_MULTI_MAX_STATE_SIZE) {
+        printf("state too large\n");
+        test_exit_result = 1;
+        return;
+    }
+
+    /* Try every number of states up to the maximum, with different
+     * contents for each state and each count */
+    for (count = 1; count <= TEST_MULTI_STATES; ++count) {
+        for (index = 0; index < count; ++index) {
+            for (posn = 0; posn < state_size; ++posn) {
+                s[index * state_size + posn] =
+                    (unsigned char)(index * 7 + posn * 3 + count);
+            }
+            memcpy(e + index * state_size, s + index * state_size,
+                   state_size);
+            (*permute)(e + index * state_size);
+        }
+        (*permute_n)(states, count);
+        if (memcmp(states, expected, count * state_size) != 0)
+            ok = 0;
+    }
+
+    /* Run the fixed-width kernels directly over the first 12 states */
+    if (permute_x4 && permute_x8) {
+        (*permute_x4)(s);
+        (*permute_x8)(s + 4 * state_size);
+        for (index = 0; index < 12; ++index)
+            (*permute)(e + index * state_size);
+        if (memcmp(states, expected, 12 * state_size) != 0)
+            ok = 0;
+    }
+
+    if (!ok) {
+        printf("failed\n");
+        test_exit_result = 1;
+    } else {
+        printf("ok\n");
+    }
+}
+
+void test_hash_batch
+    (const aead_hash_algorithm_t *hash, test_hash_batch_t batch,
+     unsigned rate)
+{
+    static unsigned char messages[TEST_MULTI_STATES][TEST_BATCH_MAX_LEN];
+    static unsigned char hashes[TEST_MULTI_STATES][TEST_BATCH_MAX_HASH_LEN];
+    unsigned long long lengths[6];
+    unsigned char *out[TEST_MULTI_STATES];
+    const unsigned char *in[TEST_MULTI_STATES];
+    unsigned char expected[TEST_BATCH_MAX_HASH_LEN];
+    unsigned index, posn, len;
+    int ok = 1;
+
+    printf("    %s Batch ... ", hash->name);
+    fflush(stdout);
+    if (hash->hash_len > TEST_BATCH_MAX_HASH_LEN) {
+        printf("hash too large\n");
+        test_exit_result = 1;
+        return;
+    }
+
+    /* Empty, single byte, either side of the rate, and several blocks */
+    lengths[0] = 0;
+    lengths[1] = 1;
+    lengths[2] = rate - 1;
+    lengths[3] = rate;
+    lengths[4] = rate + 1;
+    lengths[5] = TEST_BATCH_MAX_LEN;
+
+    for (index = 0; index < TEST_MULTI_STATES; ++index) {
+        for (posn = 0; posn < TEST_BATCH_MAX_LEN; ++posn)
+            messages[index][posn] = (unsigned char)(index * 3 + posn * 5);
+        out[index] = hashes[index];
+        in[index] = messages[index];
+    }
+    for (len = 0; len < sizeof(lengths) / sizeof(lengths[0]); ++len) {
+        (*batch)(out, in, lengths[len], TEST_MULTI_STATES);
+        for (index = 0; index < TEST_MULTI_STATES; ++index) {
+            (*hash->hash)(expected, messages[index], lengths[len]);
+            if (memcmp(hashes[index], expected, hash->hash_len) != 0)
+                ok = 0;
+        }
+    }
+    if (!ok) {
+        printf("failed\n");
+        test_exit_result = 1;
+    } else {
+        printf("ok\n");
+    }
+}
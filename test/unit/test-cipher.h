@@ -134,4 +134,28 @@ void test_hash
     (const aead_hash_algorithm_t *hash,
      const aead_hash_test_vector_t *test_vector);
 
+/* Permutes a single state */
+typedef void (*test_permute_t)(void *state);
+
+/* Permutes "count" states that are stored side by side */
+typedef void (*test_permute_n_t)(void *states, unsigned count);
+
+/* Tests a multi-state permutation kernel against the single-state version.
+ * The fixed-width "permute_x4" and "permute_x8" kernels may be NULL */
+void test_permute_multi_state
+    (const char *name, const char *variant, size_t state_size,
+     test_permute_t permute, test_permute_n_t permute_n,
+     test_permute_t permute_x4, test_permute_t permute_x8);
+
+/* Hashes "count" messages of the same length at once */
+typedef void (*test_hash_batch_t)
+    (unsigned char * const *out, const unsigned char * const *in,
+     unsigned long long inlen, size_t count);
+
+/* Tests a batch hashing function against hashing one message at a time.
+ * The message lengths straddle the "rate" of the hash algorithm */
+void test_hash_batch
+    (const aead_hash_algorithm_t *hash, test_hash_batch_t batch,
+     unsigned rate);
+
 #endif
@@ -24,6 +24,7 @@
 #include "internal-gift128-m.h"
 #include "test-cipher.h"
 #include <stdio.h>
+#include <string.h>
 
 /* Information block for the GIFT-128 block cipher (bit-sliced version) */
 static block_cipher_t const gift128b = {
@@ -43,6 +44,38 @@ static block_cipher_t const gift128n = {
     (block_cipher_decrypt_t)gift128n_decrypt
 };
 
+static void gift128b_init_tiny
+    (gift128b_key_schedule_t *ks, const unsigned char *key)
+{
+    gift128b_init_variant(ks, key, GIFT128_VARIANT_TINY);
+}
+
+static void gift128n_init_tiny
+    (gift128n_key_schedule_t *ks, const unsigned char *key)
+{
+    gift128n_init_variant(ks, key, GIFT128_VARIANT_TINY);
+}
+
+/* Information block for GIFT-128 (bit-sliced) with a tiny key schedule
+ * that is selected at runtime */
+static block_cipher_t const gift128b_tiny = {
+    "GIFT-128-b-tiny",
+    sizeof(gift128b_key_schedule_t),
+    (block_cipher_init_t)gift128b_init_tiny,
+    (block_cipher_encrypt_t)gift128b_encrypt,
+    (block_cipher_decrypt_t)gift128b_decrypt
+};
+
+/* Information block for GIFT-128 (nibble-based) with a tiny key schedule
+ * that is selected at runtime */
+static block_cipher_t const gift128n_tiny = {
+    "GIFT-128-n-tiny",
+    sizeof(gift128n_key_schedule_t),
+    (block_cipher_init_t)gift128n_init_tiny,
+    (block_cipher_encrypt_t)gift128n_encrypt,
+    (block_cipher_decrypt_t)gift128n_decrypt
+};
+
 /* Information block for the masked GIFT-128 block cipher (bit-sliced) */
 static block_cipher_t const gift128b_masked = {
     "GIFT-128-b-masked",
@@ -175,6 +208,15 @@ static block_cipher_t const gift128t = {
     (block_cipher_decrypt_t)gift128t_decrypt_wrapper
 };
 
+/* Information block for TweGIFT-128 with a tiny key schedule */
+static block_cipher_t const gift128t_tiny = {
+    "TweGIFT-128-tiny",
+    sizeof(gift128n_key_schedule_t),
+    (block_cipher_init_t)gift128n_init_tiny,
+    (block_cipher_encrypt_t)gift128t_encrypt_wrapper,
+    (block_cipher_decrypt_t)gift128t_decrypt_wrapper
+};
+
 static void gift128t_encrypt_wrapper_masked
     (const gift128n_masked_key_schedule_t *ks, unsigned char *output,
      const unsigned char *input)
@@ -245,6 +287,95 @@ static block_cipher_test_vector_128_t const gift128t_4 = {
     /* tweak = 0 */
 };
 
+static void test_gift128_multi_block(void)
+{
+    static uint32_t const tweaks[] = {
+        GIFT128T_TWEAK_0, GIFT128T_TWEAK_4, GIFT128T_TWEAK_11
+    };
+    gift128b_key_schedule_t schedules[GIFT128_MAX_LANES];
+    const gift128b_key_schedule_t *keys[GIFT128_MAX_LANES];
+    gift128b_multi_key_schedule_t ks;
+    unsigned char key[16];
+    unsigned char input[GIFT128_MAX_LANES * 16];
+    unsigned char output[GIFT128_MAX_LANES * 16];
+    unsigned char expected[GIFT128_MAX_LANES * 16];
+    uint32_t words[GIFT128_MAX_LANES][4];
+    uint32_t expected_words[GIFT128_MAX_LANES][4];
+    unsigned count, lane, index, tweak;
+    int ok = 1;
+
+    printf("    Multi-Block (%s) ... ", gift128_multi_block_variant());
+    fflush(stdout);
+
+    /* Give every lane a different key and block, except that the last
+     * lane repeats the first key to check shared keys.  Odd lanes use
+     * tiny key schedules to check that they are expanded correctly */
+    for (lane = 0; lane < GIFT128_MAX_LANES; ++lane) {
+        for (index = 0; index < 16; ++index) {
+            key[index] = (unsigned char)(lane * 31 + index * 7 + 1);
+            input[lane * 16 + index] = (unsigned char)(lane * 13 + index * 5);
+        }
+        gift128b_init_variant
+            (&schedules[lane], key,
+             (lane & 1) ? GIFT128_VARIANT_TINY : GIFT128_VARIANT_FULL);
+        keys[lane] = &schedules[lane];
+    }
+    if (GIFT128_MAX_LANES > 1)
+        keys[GIFT128_MAX_LANES - 1] = &schedules[0];
+
+    for (count = 1; count <= GIFT128_MAX_LANES; ++count) {
+        gift128b_multi_init(&ks, keys, count);
+
+        /* Bit-sliced GIFT-128 on bytes */
+        memcpy(output, input, count * 16);
+        gift128b_encrypt_multi(&ks, output);
+        for (lane = 0; lane < count; ++lane) {
+            gift128b_encrypt
+                (keys[lane], expected + lane * 16, input + lane * 16);
+        }
+        if (memcmp(output, expected, count * 16) != 0)
+            ok = 0;
+
+        /* Bit-sliced GIFT-128 on pre-loaded words */
+        memcpy(words, input, count * 16);
+        gift128b_encrypt_preloaded_multi(&ks, words);
+        for (lane = 0; lane < count; ++lane) {
+            memcpy(expected_words[lane], input + lane * 16, 16);
+            gift128b_encrypt_preloaded
+                (keys[lane], expected_words[lane], expected_words[lane]);
+        }
+        if (memcmp(words, expected_words, count * 16) != 0)
+            ok = 0;
+
+        /* Nibble-based GIFT-128 and TweGIFT-128 */
+        for (tweak = 0; tweak < sizeof(tweaks) / sizeof(tweaks[0]); ++tweak) {
+            memcpy(output, input, count * 16);
+            gift128t_encrypt_multi(&ks, output, tweaks[tweak]);
+            for (lane = 0; lane < count; ++lane) {
+                gift128t_encrypt
+                    (keys[lane], expected + lane * 16, input + lane * 16,
+                     tweaks[tweak]);
+            }
+            if (memcmp(output, expected, count * 16) != 0)
+                ok = 0;
+        }
+        memcpy(output, input, count * 16);
+        gift128n_encrypt_multi(&ks, output);
+        for (lane = 0; lane < count; ++lane) {
+            gift128n_encrypt
+                (keys[lane], expected + lane * 16, input + lane * 16);
+        }
+        if (memcmp(output, expected, count * 16) != 0)
+            ok = 0;
+    }
+    if (!ok) {
+        printf("failed\n");
+        test_exit_result = 1;
+    } else {
+        printf("ok\n");
+    }
+}
+
 void test_gift128(void)
 {
     test_block_cipher_start(&gift128b);
@@ -253,6 +384,7 @@ void test_gift128(void)
     test_block_cipher_128(&gift128b, &gift128b_3);
     test_block_cipher_128(&gift128b, &gift128b_4);
     test_block_cipher_128(&gift128b, &gift128b_5);
+    test_gift128_multi_block();
     test_block_cipher_end(&gift128b);
 
     test_block_cipher_start(&gift128n);
@@ -273,6 +405,29 @@ void test_gift128(void)
     test_block_cipher_128(&gift128t, &gift128t_4);
     test_block_cipher_128(&gift128n, &gift128t_4);
     test_block_cipher_end(&gift128t);
+
+    test_block_cipher_start(&gift128b_tiny);
+    test_block_cipher_128(&gift128b_tiny, &gift128b_1);
+    test_block_cipher_128(&gift128b_tiny, &gift128b_2);
+    test_block_cipher_128(&gift128b_tiny, &gift128b_3);
+    test_block_cipher_128(&gift128b_tiny, &gift128b_4);
+    test_block_cipher_128(&gift128b_tiny, &gift128b_5);
+    test_block_cipher_end(&gift128b_tiny);
+
+    test_block_cipher_start(&gift128n_tiny);
+    test_block_cipher_128(&gift128n_tiny, &gift128n_1);
+    test_block_cipher_128(&gift128n_tiny, &gift128n_2);
+    test_block_cipher_128(&gift128n_tiny, &gift128n_3);
+    test_block_cipher_end(&gift128n_tiny);
+
+    test_block_cipher_start(&gift128t_tiny);
+    gift128t_tweak_value = GIFT128T_TWEAK_0;
+    test_block_cipher_128(&gift128t_tiny, &gift128t_1);
+    gift128t_tweak_value = GIFT128T_TWEAK_11;
+    test_block_cipher_128(&gift128t_tiny, &gift128t_2);
+    gift128t_tweak_value = GIFT128T_TWEAK_4;
+    test_block_cipher_128(&gift128t_tiny, &gift128t_3);
+    test_block_cipher_end(&gift128t_tiny);
 }
 
 void test_gift128_masked(void)
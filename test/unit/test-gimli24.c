@@ -62,6 +62,148 @@ static void test_gimli24_permutation(void)
     }
 }
 
+static void gimli24_permute_1(void *state)
+{
+    gimli24_permute((uint32_t *)state);
+}
+
+static void gimli24_permute_n_states(void *states, unsigned count)
+{
+    gimli24_permute_n((uint32_t (*)[12])states, count);
+}
+
+static void gimli24_permute_4(void *states)
+{
+    gimli24_permute_x4((uint32_t (*)[12])states);
+}
+
+static void gimli24_permute_8(void *states)
+{
+    gimli24_permute_x8((uint32_t (*)[12])states);
+}
+
+/* Runs of packets in the batch AEAD test: number of packets, payload
+ * length, and associated data length.  The batch hook permutes runs of
+ * packets with the same lengths side by side, so the runs exercise full
+ * and partial groups of lanes, lone packets, and runs that are broken
+ * by a change in the associated data length alone */
+static unsigned const gimli24_batch_runs[][3] = {
+    {GIMLI24_MAX_LANES * 2 + 3, 17, 5},
+    {1,                         0,  0},
+    {3,                         16, 16},
+    {2,                         16, 15},
+    {1,                         48, 0},
+    {GIMLI24_MAX_LANES + 1,     47, 33},
+    {2,                         3,  48}
+};
+#define GIMLI24_BATCH_RUNS \
+    (sizeof(gimli24_batch_runs) / sizeof(gimli24_batch_runs[0]))
+#define GIMLI24_BATCH_COUNT (GIMLI24_MAX_LANES * 3 + 13)
+#define GIMLI24_BATCH_MAX_LEN 48
+
+/* Checks the batch AEAD hook against one packet at a time */
+static void test_gimli24_aead_batch(void)
+{
+    static aead_batch_item_t items[GIMLI24_BATCH_COUNT];
+    static unsigned char keys[GIMLI24_BATCH_COUNT][GIMLI24_KEY_SIZE];
+    static unsigned char nonces[GIMLI24_BATCH_COUNT][GIMLI24_NONCE_SIZE];
+    static unsigned char ads[GIMLI24_BATCH_COUNT][GIMLI24_BATCH_MAX_LEN];
+    static unsigned char plaintexts
+        [GIMLI24_BATCH_COUNT][GIMLI24_BATCH_MAX_LEN];
+    static unsigned char ciphertexts
+        [GIMLI24_BATCH_COUNT][GIMLI24_BATCH_MAX_LEN + GIMLI24_TAG_SIZE];
+    static unsigned char outputs
+        [GIMLI24_BATCH_COUNT][GIMLI24_BATCH_MAX_LEN + GIMLI24_TAG_SIZE];
+    unsigned long long clen;
+    unsigned index, posn, run, left;
+    int ok = 1;
+
+    printf("    Batch Encrypt/Decrypt ... ");
+    fflush(stdout);
+
+    /* Set up the packets and encrypt them one at a time for reference.
+     * Every third packet uses a key context instead of a raw key */
+    memset(items, 0, sizeof(items));
+    run = 0;
+    left = gimli24_batch_runs[0][0];
+    for (index = 0; index < GIMLI24_BATCH_COUNT; ++index) {
+        while (left == 0 && run < (GIMLI24_BATCH_RUNS - 1))
+            left = gimli24_batch_runs[++run][0];
+        --left;
+        for (posn = 0; posn < GIMLI24_KEY_SIZE; ++posn)
+            keys[index][posn] = (unsigned char)(index * 11 + posn);
+        for (posn = 0; posn < GIMLI24_NONCE_SIZE; ++posn)
+            nonces[index][posn] = (unsigned char)(index ^ (posn * 29));
+        for (posn = 0; posn < GIMLI24_BATCH_MAX_LEN; ++posn) {
+            ads[index][posn] = (unsigned char)(index * 13 + posn);
+            plaintexts[index][posn] = (unsigned char)(posn * 17 - index);
+        }
+        items[index].key = (index % 3) ? keys[index] : 0;
+        items[index].ctx = keys[index];
+        items[index].npub = nonces[index];
+        items[index].ad = ads[index];
+        items[index].adlen = gimli24_batch_runs[run][2];
+        items[index].in = plaintexts[index];
+        items[index].inlen = gimli24_batch_runs[run][1];
+        items[index].out = outputs[index];
+        items[index].status = -2;
+        gimli24_aead_encrypt
+            (ciphertexts[index], &clen, plaintexts[index],
+             items[index].inlen, ads[index], items[index].adlen,
+             0, nonces[index], keys[index]);
+    }
+    if (left != 0 || run != (GIMLI24_BATCH_RUNS - 1)) {
+        printf("bad run table\n");
+        test_exit_result = 1;
+        return;
+    }
+
+    /* Encrypt the whole batch and compare */
+    if (aead_batch_encrypt(&gimli24_cipher, items, GIMLI24_BATCH_COUNT) != 0)
+        ok = 0;
+    for (index = 0; index < GIMLI24_BATCH_COUNT && ok; ++index) {
+        clen = items[index].inlen + GIMLI24_TAG_SIZE;
+        if (items[index].status != 0 || items[index].outlen != clen ||
+                memcmp(outputs[index], ciphertexts[index], clen) != 0)
+            ok = 0;
+    }
+
+    /* Decrypt in place.  Corrupt the tag of one packet in each long run,
+     * and cut the final run short of a full tag so that it is rejected */
+    for (index = 0; index < GIMLI24_BATCH_COUNT; ++index) {
+        items[index].in = outputs[index];
+        items[index].inlen = items[index].outlen;
+        if (index == 2 || index == GIMLI24_BATCH_COUNT - 5)
+            outputs[index][items[index].inlen - 1] ^= 0x01;
+        if (index >= GIMLI24_BATCH_COUNT - 2)
+            items[index].inlen = GIMLI24_TAG_SIZE - 1;
+        items[index].status = -2;
+    }
+    if (ok && aead_batch_decrypt
+            (&gimli24_cipher, items, GIMLI24_BATCH_COUNT) != -1)
+        ok = 0;
+    for (index = 0; index < GIMLI24_BATCH_COUNT && ok; ++index) {
+        if (index == 2 || index == GIMLI24_BATCH_COUNT - 5 ||
+                index >= GIMLI24_BATCH_COUNT - 2) {
+            if (items[index].status != -1)
+                ok = 0;
+        } else if (items[index].status != 0 ||
+                   items[index].outlen !=
+                        items[index].inlen - GIMLI24_TAG_SIZE ||
+                   memcmp(outputs[index], plaintexts[index],
+                          items[index].outlen) != 0) {
+            ok = 0;
+        }
+    }
+
+    if (!ok) {
+        printf("failed\n");
+        test_exit_result = 1;
+    } else {
+        printf("ok\n");
+    }
+}
+
 static void test_gimli24_masked(void)
 {
     mask_uint32_t state[12];
@@ -87,6 +229,11 @@ void test_gimli24(void)
 {
     test_aead_cipher_start(&gimli24_cipher);
     test_gimli24_permutation();
+    test_permute_multi_state
+        ("Multi-State", gimli24_multi_variant(), 48, gimli24_permute_1,
+         gimli24_permute_n_states, gimli24_permute_4, gimli24_permute_8);
+    test_hash_batch(&gimli24_hash_algorithm, gimli24_hash_batch, 16);
+    test_gimli24_aead_batch();
     test_gimli24_masked();
     test_aead_cipher_end(&gimli24_cipher);
 }
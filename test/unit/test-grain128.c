@@ -20,6 +20,7 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include "grain128.h"
 #include "internal-grain128.h"
 #include "test-cipher.h"
 #include <stdio.h>
@@ -49,6 +50,8 @@ static unsigned char const grain_1_sr[8] = {
     0xe1, 0x02, 0xd6, 0xd5, 0x3d, 0x4c, 0x4b, 0x73,
 };
 
+#if !GRAIN128_WORD64
+
 static void grain128_to_bytes
     (unsigned char *out, const uint32_t *in, unsigned count)
 {
@@ -60,6 +63,8 @@ static void grain128_to_bytes
     }
 }
 
+#endif
+
 static void grain128_to_bytes_64
     (unsigned char *out, const uint64_t *in, unsigned count)
 {
@@ -71,6 +76,106 @@ static void grain128_to_bytes_64
     }
 }
 
+/* Runs of packets with the same lengths in the batch test.  The first
+ * run is longer than the widest multi-session kernel and the last run
+ * is too short to use the kernels at all */
+#define GRAIN128_BATCH_COUNT 350
+#define GRAIN128_BATCH_MAX_LEN 40
+static unsigned const grain128_batch_runs[][3] = {
+    /* packets, plaintext length, associated data length */
+    {270, 23, 9},
+    {72,  0,  0},
+    {8,   40, 40}
+};
+
+static void test_grain128_batch(void)
+{
+    static aead_batch_item_t items[GRAIN128_BATCH_COUNT];
+    static unsigned char keys[GRAIN128_BATCH_COUNT][16];
+    static unsigned char nonces[GRAIN128_BATCH_COUNT][12];
+    static unsigned char ads[GRAIN128_BATCH_COUNT][GRAIN128_BATCH_MAX_LEN];
+    static unsigned char plaintexts[GRAIN128_BATCH_COUNT][GRAIN128_BATCH_MAX_LEN];
+    static unsigned char outputs[GRAIN128_BATCH_COUNT][GRAIN128_BATCH_MAX_LEN + 8];
+    unsigned char expected[GRAIN128_BATCH_MAX_LEN + 8];
+    unsigned long long len;
+    unsigned index, posn, run, left;
+    int ok = 1;
+
+#if GRAIN128_MULTI
+    printf("    Multi-session kernel: %s\n", grain128_multi_variant());
+#endif
+    printf("    Batch Encrypt/Decrypt ... ");
+    fflush(stdout);
+
+    /* Set up the packets, with a different key and nonce for each */
+    memset(items, 0, sizeof(items));
+    run = 0;
+    left = grain128_batch_runs[0][0];
+    for (index = 0; index < GRAIN128_BATCH_COUNT; ++index) {
+        if (left == 0)
+            left = grain128_batch_runs[++run][0];
+        --left;
+        for (posn = 0; posn < 16; ++posn)
+            keys[index][posn] = (unsigned char)(index * 17 + posn);
+        for (posn = 0; posn < 12; ++posn)
+            nonces[index][posn] = (unsigned char)((index >> 8) + posn * 3);
+        nonces[index][11] ^= (unsigned char)index;
+        for (posn = 0; posn < GRAIN128_BATCH_MAX_LEN; ++posn) {
+            ads[index][posn] = (unsigned char)(index + posn * 7);
+            plaintexts[index][posn] = (unsigned char)(index * 3 + posn);
+        }
+        items[index].key = (index % 3) ? keys[index] : 0;
+        items[index].ctx = keys[index];
+        items[index].npub = nonces[index];
+        items[index].ad = ads[index];
+        items[index].adlen = grain128_batch_runs[run][2];
+        items[index].in = plaintexts[index];
+        items[index].inlen = grain128_batch_runs[run][1];
+        items[index].out = outputs[index];
+    }
+
+    /* Encrypt the batch and compare with one packet at a time */
+    if (aead_batch_encrypt
+            (&grain128_aead_cipher, items, GRAIN128_BATCH_COUNT) != 0)
+        ok = 0;
+    for (index = 0; index < GRAIN128_BATCH_COUNT && ok; ++index) {
+        grain128_aead_encrypt
+            (expected, &len, plaintexts[index], items[index].inlen,
+             ads[index], items[index].adlen, 0, nonces[index], keys[index]);
+        if (items[index].status != 0 || items[index].outlen != len ||
+                memcmp(expected, outputs[index], len) != 0)
+            ok = 0;
+    }
+
+    /* Decrypt in place, with corrupted tags in some of the packets */
+    for (index = 0; index < GRAIN128_BATCH_COUNT; ++index) {
+        items[index].in = outputs[index];
+        items[index].inlen = items[index].outlen;
+        if ((index % 41) == 5)
+            outputs[index][items[index].outlen - 1] ^= 0x40;
+    }
+    if (ok && aead_batch_decrypt
+            (&grain128_aead_cipher, items, GRAIN128_BATCH_COUNT) != -1)
+        ok = 0;
+    for (index = 0; index < GRAIN128_BATCH_COUNT && ok; ++index) {
+        if ((index % 41) == 5) {
+            if (items[index].status != -1)
+                ok = 0;
+        } else if (items[index].status != 0 ||
+                   items[index].outlen != items[index].inlen - 8 ||
+                   memcmp(outputs[index], plaintexts[index],
+                          items[index].outlen) != 0) {
+            ok = 0;
+        }
+    }
+    if (!ok) {
+        printf("failed\n");
+        test_exit_result = 1;
+    } else {
+        printf("ok\n");
+    }
+}
+
 void test_grain128(void)
 {
     grain128_state_t state;
@@ -82,9 +187,15 @@ void test_grain128(void)
     printf("    Test Vector ... ");
     fflush(stdout);
     grain128_setup(&state, grain_1_key, grain_1_nonce);
+#if GRAIN128_WORD64
+    grain128_to_bytes_64(bytes, state.lfsr, 2);
+    failure =  test_memcmp(bytes, grain_1_lfsr, sizeof(grain_1_lfsr));
+    grain128_to_bytes_64(bytes, state.nfsr, 2);
+#else
     grain128_to_bytes(bytes, state.lfsr, 4);
     failure =  test_memcmp(bytes, grain_1_lfsr, sizeof(grain_1_lfsr));
     grain128_to_bytes(bytes, state.nfsr, 4);
+#endif
     failure |= test_memcmp(bytes, grain_1_nfsr, sizeof(grain_1_nfsr));
     grain128_to_bytes_64(bytes, &state.accum, 1);
     failure |= test_memcmp(bytes, grain_1_accum, sizeof(grain_1_accum));
@@ -97,5 +208,7 @@ void test_grain128(void)
         test_exit_result = 1;
     }
 
+    test_grain128_batch();
+
     printf("\n");
 }
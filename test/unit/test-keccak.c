@@ -90,10 +90,99 @@ static void test_keccakp_400(void)
     fflush(stdout);
 }
 
+/* Single and multi-state wrappers for Keccak-p[200] and Keccak-p[400] */
+static void keccakp_200_permute_1(void *state)
+{
+    keccakp_200_permute((keccakp_200_state_t *)state);
+}
+
+static void keccakp_200_permute_n_states(void *states, unsigned count)
+{
+    keccakp_200_permute_n((keccakp_200_state_t *)states, count);
+}
+
+static void keccakp_400_permute_1(void *state)
+{
+    keccakp_400_permute((keccakp_400_state_t *)state, 20);
+}
+
+static void keccakp_400_permute_n_states(void *states, unsigned count)
+{
+    keccakp_400_permute_n((keccakp_400_state_t *)states, count, 20);
+}
+
+static void keccakp_400_permute_1_12(void *state)
+{
+    keccakp_400_permute((keccakp_400_state_t *)state, 12);
+}
+
+static void keccakp_400_permute_n_states_12(void *states, unsigned count)
+{
+    keccakp_400_permute_n((keccakp_400_state_t *)states, count, 12);
+}
+
+#define KECCAK_TEST_STATES 37
+
+/* Checks that absorbing bits into several Keccak-p[400] states at once
+ * gives the same result as absorbing into each state separately */
+static void test_keccakp_400_absorb_bits(void)
+{
+    static keccakp_400_state_t states[KECCAK_TEST_STATES];
+    static keccakp_400_state_t expected[KECCAK_TEST_STATES];
+    static unsigned char input[KECCAK_TEST_STATES][3];
+    const unsigned char *data[KECCAK_TEST_STATES];
+    unsigned count, index, posn, rounds, bit;
+    int ok = 1;
+
+    printf("    Keccak-p[400] Absorb Bits (%s) ... ",
+           keccak_multi_lane_variant());
+    fflush(stdout);
+    for (count = 1; count <= KECCAK_TEST_STATES; ++count) {
+        rounds = 1 + count % 20;
+        for (index = 0; index < count; ++index) {
+            for (posn = 0; posn < KECCAKP_400_STATE_SIZE; ++posn) {
+                states[index].B[posn] =
+                    (unsigned char)(index * 5 + posn * 3 + count);
+            }
+            for (posn = 0; posn < sizeof(input[0]); ++posn)
+                input[index][posn] = (unsigned char)(index * 11 + posn + count);
+            expected[index] = states[index];
+            data[index] = input[index];
+            for (bit = 0; bit < 20; ++bit) {
+                expected[index].B[0] ^=
+                    (data[index][bit / 8] << (bit % 8)) & 0x80;
+                keccakp_400_permute(&(expected[index]), rounds);
+            }
+        }
+        keccakp_400_absorb_bits_n(states, count, data, 20, rounds);
+        if (memcmp(states, expected, count * sizeof(states[0])))
+            ok = 0;
+    }
+    if (!ok) {
+        printf("failed\n");
+        test_exit_result = 1;
+    } else {
+        printf("ok\n");
+    }
+}
+
 void test_keccak(void)
 {
     printf("Keccak:\n");
     test_keccakp_200();
     test_keccakp_400();
+    test_permute_multi_state
+        ("Keccak-p[200] Multi-State", keccak_multi_lane_variant(),
+         sizeof(keccakp_200_state_t), keccakp_200_permute_1,
+         keccakp_200_permute_n_states, 0, 0);
+    test_permute_multi_state
+        ("Keccak-p[400] Multi-State", keccak_multi_lane_variant(),
+         sizeof(keccakp_400_state_t), keccakp_400_permute_1,
+         keccakp_400_permute_n_states, 0, 0);
+    test_permute_multi_state
+        ("Keccak-p[400] Multi-State 12 Rounds", keccak_multi_lane_variant(),
+         sizeof(keccakp_400_state_t), keccakp_400_permute_1_12,
+         keccakp_400_permute_n_states_12, 0, 0);
+    test_keccakp_400_absorb_bits();
     printf("\n");
 }
@@ -23,6 +23,15 @@
 #include "internal-masking.h"
 #include "test-cipher.h"
 #include <stdio.h>
+#include <string.h>
+#if defined(__linux__)
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+#if defined(LW_USE_PTHREADS)
+#include <pthread.h>
+#endif
 
 /* Test the 2-share version of masked words */
 #define MASK_NAME(a, b) a##_x2_##b
@@ -270,6 +279,252 @@
 #undef mask_test_swap
 #undef mask_test_swap_move
 
+/* ------------------ random number generator contexts ------------------ */
+
+/* Determine if a block of random words is all-zeroes */
+static int test_random_is_zero(const uint32_t *words, unsigned count)
+{
+    uint32_t x = 0;
+    while (count > 0) {
+        x |= *words++;
+        --count;
+    }
+    return x == 0;
+}
+
+/* Test that a context that is all-zeroes is seeded before it is used,
+ * rather than returning its empty output block */
+static int test_random_ctx_zero(void)
+{
+    aead_random_ctx_t ctx;
+    uint32_t out[16];
+    unsigned index;
+    memset(&ctx, 0, sizeof(ctx));
+    for (index = 0; index < 16; ++index)
+        out[index] = aead_random_ctx_generate_32(&ctx);
+    aead_random_ctx_finish(&ctx);
+    return !test_random_is_zero(out, 16);
+}
+
+/* Test that initializing a context does not depend upon its prior
+ * contents, such as garbage from the stack */
+static int test_random_ctx_init(void)
+{
+    static uint32_t const constants[4] = {
+        0x61707865, 0x3320646e, 0x79622d32, 0x6b206574
+    };
+    aead_random_ctx_t ctx;
+    int ok;
+    memset(&ctx, 0xFF, sizeof(ctx));
+    aead_random_ctx_init(&ctx);
+    ok = ctx.seeded == 1 &&
+         memcmp(ctx.state, constants, sizeof(constants)) == 0;
+    aead_random_ctx_finish(&ctx);
+    return ok;
+}
+
+#if defined(LW_USE_PTHREADS)
+
+/* Generates words from the default context of a new thread, which has
+ * not called aead_random_init() */
+static void *test_random_thread_func(void *arg)
+{
+    uint32_t *out = (uint32_t *)arg;
+    unsigned index;
+    for (index = 0; index < 16; ++index)
+        out[index] = aead_random_generate_32();
+    return 0;
+}
+
+/* Test that the default context of a new thread is seeded on first use */
+static int test_random_thread_default(void)
+{
+    uint32_t out[16];
+    pthread_t thread;
+    memset(out, 0, sizeof(out));
+    if (pthread_create(&thread, 0, test_random_thread_func, out) != 0)
+        return 0;
+    pthread_join(thread, 0);
+    return !test_random_is_zero(out, 16);
+}
+
+#endif
+
+/* Test that explicit random contexts are reproducible from a seed and
+ * are independent of each other and of the default context */
+static int test_random_ctx_seed(void)
+{
+    static unsigned char const seed[32] = {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+        0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+        0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+    };
+    aead_random_ctx_t ctx1;
+    aead_random_ctx_t ctx2;
+    uint32_t out1[40];
+    uint32_t out2[40];
+    int index;
+    aead_random_ctx_set_seed(&ctx1, seed);
+    aead_random_ctx_set_seed(&ctx2, seed);
+    for (index = 0; index < 40; ++index) {
+        out1[index] = aead_random_ctx_generate_32(&ctx1);
+        aead_random_generate_32();
+    }
+    aead_random_ctx_generate(&ctx2, out2, sizeof(out2));
+    aead_random_ctx_finish(&ctx1);
+    aead_random_ctx_finish(&ctx2);
+    return memcmp(out1, out2, sizeof(out1)) == 0;
+}
+
+/* Test that a pool of random words produces the same output as a
+ * context with the same seed, across more than one refill */
+static int test_random_pool(void)
+{
+    static unsigned char const seed[32] = {
+        0x1f, 0x1e, 0x1d, 0x1c, 0x1b, 0x1a, 0x19, 0x18,
+        0x17, 0x16, 0x15, 0x14, 0x13, 0x12, 0x11, 0x10,
+        0x0f, 0x0e, 0x0d, 0x0c, 0x0b, 0x0a, 0x09, 0x08,
+        0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01, 0x00
+    };
+    aead_random_ctx_t ctx1;
+    aead_random_ctx_t ctx2;
+    aead_random_pool_t pool;
+    uint32_t out1[AEAD_RANDOM_POOL_WORDS * 2];
+    uint32_t out2[AEAD_RANDOM_POOL_WORDS * 2];
+    int index;
+    aead_random_ctx_set_seed(&ctx1, seed);
+    aead_random_ctx_set_seed(&ctx2, seed);
+    aead_random_pool_init(&pool, &ctx1);
+    for (index = 0; index < (AEAD_RANDOM_POOL_WORDS * 2); ++index)
+        out1[index] = aead_random_pool_generate_32(&pool);
+    aead_random_ctx_generate(&ctx2, out2, AEAD_RANDOM_POOL_WORDS * 8);
+    aead_random_pool_finish(&pool);
+    aead_random_ctx_finish(&ctx1);
+    aead_random_ctx_finish(&ctx2);
+    return memcmp(out1, out2, AEAD_RANDOM_POOL_WORDS * 8) == 0;
+}
+
+/* Test that a pool produces the same output as a context with the same
+ * seed across the point where the PRNG is re-keyed, 256 blocks in */
+static int test_random_pool_rekey(void)
+{
+    static unsigned char const seed[32] = {
+        0x5a, 0x5a, 0x5a, 0x5a, 0xa5, 0xa5, 0xa5, 0xa5,
+        0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+        0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff,
+        0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef
+    };
+    aead_random_ctx_t ctx1;
+    aead_random_ctx_t ctx2;
+    aead_random_pool_t pool;
+    uint32_t out1[16];
+    uint32_t out2[16];
+    int index, ok = 1;
+    aead_random_ctx_set_seed(&ctx1, seed);
+    aead_random_ctx_set_seed(&ctx2, seed);
+    aead_random_pool_init(&pool, &ctx1);
+
+    /* Start off unaligned with the pool so that the batches in the pool
+     * are not a multiple of the re-key interval */
+    aead_random_ctx_generate(&ctx1, out1, sizeof(out1));
+    aead_random_ctx_generate(&ctx2, out2, sizeof(out2));
+
+    /* Generate 600 blocks so that the PRNG is re-keyed twice */
+    for (index = 0; index < 600 && ok; ++index) {
+        int posn;
+        for (posn = 0; posn < 16; ++posn)
+            out1[posn] = aead_random_pool_generate_32(&pool);
+        aead_random_ctx_generate(&ctx2, out2, sizeof(out2));
+        if (memcmp(out1, out2, sizeof(out1)) != 0)
+            ok = 0;
+    }
+    aead_random_pool_finish(&pool);
+    aead_random_ctx_finish(&ctx1);
+    aead_random_ctx_finish(&ctx2);
+    return ok;
+}
+
+/* Test that seeding the default context also discards the words that
+ * the masked ciphers have already buffered from the previous seed */
+static int test_random_pool_set_seed(void)
+{
+    static unsigned char const seed[32] = {
+        0x10, 0x32, 0x54, 0x76, 0x98, 0xba, 0xdc, 0xfe,
+        0xef, 0xcd, 0xab, 0x89, 0x67, 0x45, 0x23, 0x01,
+        0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff,
+        0x0f, 0x0f, 0x0f, 0x0f, 0xf0, 0xf0, 0xf0, 0xf0
+    };
+    uint32_t out1[4];
+    uint32_t out2[4];
+    int index;
+    aead_random_set_seed(seed);
+    for (index = 0; index < 4; ++index)
+        out1[index] = aead_random_pool_generate_32(&aead_random_default_pool);
+    aead_random_set_seed(seed);
+    for (index = 0; index < 4; ++index)
+        out2[index] = aead_random_pool_generate_32(&aead_random_default_pool);
+    aead_random_reseed();
+    return memcmp(out1, out2, sizeof(out1)) == 0;
+}
+
+#if defined(__linux__)
+
+/* Test that a child process does not repeat the output of its parent,
+ * from a context or from words that were buffered in a pool before fork() */
+static int test_random_ctx_fork(void)
+{
+    aead_random_ctx_t ctx;
+    aead_random_pool_t pool;
+    uint32_t parent[12];
+    uint32_t child[12];
+    int fds[2];
+    pid_t pid;
+    int status;
+    int index;
+    aead_random_ctx_init(&ctx);
+    aead_random_pool_init(&pool, &ctx);
+    aead_random_ctx_generate_32(&ctx);
+    aead_random_pool_generate_32(&pool);
+    aead_random_pool_generate_32(&aead_random_default_pool);
+    if (pipe(fds) < 0)
+        return 0;
+    pid = fork();
+    if (pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return 0;
+    } else if (pid == 0) {
+        aead_random_ctx_generate(&ctx, child, sizeof(uint32_t) * 4);
+        for (index = 4; index < 8; ++index)
+            child[index] = aead_random_pool_generate_32(&pool);
+        for (index = 8; index < 12; ++index) {
+            child[index] =
+                aead_random_pool_generate_32(&aead_random_default_pool);
+        }
+        if (write(fds[1], child, sizeof(child)) != sizeof(child))
+            _exit(1);
+        _exit(0);
+    }
+    aead_random_ctx_generate(&ctx, parent, sizeof(uint32_t) * 4);
+    for (index = 4; index < 8; ++index)
+        parent[index] = aead_random_pool_generate_32(&pool);
+    for (index = 8; index < 12; ++index)
+        parent[index] = aead_random_pool_generate_32(&aead_random_default_pool);
+    close(fds[1]);
+    if (read(fds[0], child, sizeof(child)) != sizeof(child))
+        memcpy(child, parent, sizeof(child));
+    close(fds[0]);
+    waitpid(pid, &status, 0);
+    aead_random_pool_finish(&pool);
+    aead_random_ctx_finish(&ctx);
+    return memcmp(parent, child, sizeof(uint32_t) * 4) != 0 &&
+           memcmp(parent + 4, child + 4, sizeof(uint32_t) * 4) != 0 &&
+           memcmp(parent + 8, child + 8, sizeof(uint32_t) * 4) != 0;
+}
+
+#endif
+
 /* ------------------ high-level test harness ------------------ */
 
 /* Runs a masking test function multiple times because we'll get
@@ -552,6 +807,21 @@ void test_masking(void)
     test_masking_run("uint16-generic-swap-move", test_uint16_generic_swap_move);
     test_masking_run("uint32-generic-swap-move", test_uint32_generic_swap_move);
     test_masking_run("uint64-generic-swap-move", test_uint64_generic_swap_move);
+    test_masking_run("random-ctx-zero", test_random_ctx_zero);
+#if defined(LW_USE_PTHREADS)
+    test_masking_run("random-thread-default", test_random_thread_default);
+#endif
+    if (aead_random_is_prng()) {
+        /* Seeding only gives reproducible output with the ChaCha20 PRNG */
+        test_masking_run("random-ctx-init", test_random_ctx_init);
+        test_masking_run("random-ctx-seed", test_random_ctx_seed);
+        test_masking_run("random-pool", test_random_pool);
+        test_masking_run("random-pool-rekey", test_random_pool_rekey);
+        test_masking_run("random-pool-set-seed", test_random_pool_set_seed);
+    }
+#if defined(__linux__)
+    test_masking_run("random-ctx-fork", test_random_ctx_fork);
+#endif
 
     printf("\n");
 }
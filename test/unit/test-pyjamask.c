@@ -22,7 +22,10 @@
 
 #include "internal-pyjamask.h"
 #include "internal-pyjamask-m.h"
+#include "pyjamask.h"
+#include "pyjamask-masked.h"
 #include "test-cipher.h"
+#include <stdio.h>
 #include <string.h>
 
 /* Information block for the Pyjamask-128 block cipher */
@@ -83,10 +86,116 @@ static block_cipher_test_vector_128_t const pyjamask_96_1 = {
      0x27, 0x07, 0x3d, 0xa6}
 };
 
+/* Number of blocks to test with; not a multiple of any kernel width */
+#define PYJAMASK_TEST_BLOCKS 37
+
+static void test_pyjamask_multi_block(void)
+{
+    static unsigned char input[PYJAMASK_TEST_BLOCKS * 16];
+    static unsigned char output[PYJAMASK_TEST_BLOCKS * 16];
+    static unsigned char expected[PYJAMASK_TEST_BLOCKS * 16];
+    pyjamask_128_key_schedule_t ks128;
+    pyjamask_96_key_schedule_t ks96;
+    unsigned count, index;
+    int ok = 1;
+
+    printf("    Multi-Block (%s) ... ", pyjamask_multi_block_variant());
+    fflush(stdout);
+    pyjamask_128_setup_key(&ks128, pyjamask_128_1.key);
+    pyjamask_96_setup_key(&ks96, pyjamask_96_1.key);
+    for (index = 0; index < sizeof(input); ++index)
+        input[index] = (unsigned char)(index * 7 + 3);
+    for (count = 1; count <= PYJAMASK_TEST_BLOCKS; ++count) {
+        /* Pyjamask-128 encryption and in-place decryption */
+        for (index = 0; index < count; ++index) {
+            pyjamask_128_encrypt
+                (&ks128, expected + index * 16, input + index * 16);
+        }
+        pyjamask_128_encrypt_blocks(&ks128, output, input, count);
+        if (memcmp(output, expected, count * 16) != 0)
+            ok = 0;
+        pyjamask_128_decrypt_blocks(&ks128, output, output, count);
+        if (memcmp(output, input, count * 16) != 0)
+            ok = 0;
+
+        /* Pyjamask-96 encryption and in-place decryption */
+        for (index = 0; index < count; ++index) {
+            pyjamask_96_encrypt
+                (&ks96, expected + index * 12, input + index * 12);
+        }
+        pyjamask_96_encrypt_blocks(&ks96, output, input, count);
+        if (memcmp(output, expected, count * 12) != 0)
+            ok = 0;
+        pyjamask_96_decrypt_blocks(&ks96, output, output, count);
+        if (memcmp(output, input, count * 12) != 0)
+            ok = 0;
+    }
+    if (!ok) {
+        printf("failed\n");
+        test_exit_result = 1;
+    } else {
+        printf("ok\n");
+    }
+}
+
+/* The masked OCB instantiations encrypt one block at a time, so they
+ * can check the grouped OCB code paths on messages of many blocks */
+static int test_pyjamask_ocb_cipher
+    (const aead_cipher_t *cipher, const aead_cipher_t *serial)
+{
+    static unsigned char m[PYJAMASK_TEST_BLOCKS * 16 + 5];
+    static unsigned char c1[sizeof(m) + 16];
+    static unsigned char c2[sizeof(m) + 16];
+    unsigned char key[16];
+    unsigned char nonce[16];
+    unsigned long long len1, len2;
+    unsigned mlen, index;
+
+    for (index = 0; index < sizeof(key); ++index) {
+        key[index] = (unsigned char)(index + 11);
+        nonce[index] = (unsigned char)(index * 3);
+    }
+    for (index = 0; index < sizeof(m); ++index)
+        m[index] = (unsigned char)(index * 5 + 1);
+    for (mlen = 0; mlen <= sizeof(m); mlen += 7) {
+        /* Use the message as associated data as well to cover both paths */
+        cipher->encrypt(c1, &len1, m, mlen, m, mlen, 0, nonce, key);
+        serial->encrypt(c2, &len2, m, mlen, m, mlen, 0, nonce, key);
+        if (len1 != len2 || memcmp(c1, c2, (size_t)len1) != 0)
+            return 0;
+        if (cipher->decrypt(c2, &len2, 0, c1, len1, m, mlen, nonce, key) != 0)
+            return 0;
+        if (len2 != mlen || memcmp(c2, m, mlen) != 0)
+            return 0;
+    }
+    return 1;
+}
+
+static void test_pyjamask_ocb(void)
+{
+    int ok = 1;
+    printf("    OCB Long Messages ... ");
+    fflush(stdout);
+    if (!test_pyjamask_ocb_cipher
+            (&pyjamask_128_cipher, &pyjamask_masked_128_cipher))
+        ok = 0;
+    if (!test_pyjamask_ocb_cipher
+            (&pyjamask_96_cipher, &pyjamask_masked_96_cipher))
+        ok = 0;
+    if (!ok) {
+        printf("failed\n");
+        test_exit_result = 1;
+    } else {
+        printf("ok\n");
+    }
+}
+
 void test_pyjamask(void)
 {
     test_block_cipher_start(&pyjamask_128);
     test_block_cipher_128(&pyjamask_128, &pyjamask_128_1);
+    test_pyjamask_multi_block();
+    test_pyjamask_ocb();
     test_block_cipher_end(&pyjamask_128);
 
     test_block_cipher_start(&pyjamask_96);
@@ -21,8 +21,10 @@
  */
 
 #include "internal-saturnin.h"
+#include "saturnin.h"
 #include "test-cipher.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 /* Test vectors for Saturnin created with the reference code */
@@ -48,6 +50,143 @@ static unsigned char const saturnin_test_ciphertext[SATURNIN_BLOCK_SIZE] = {
     0xe0, 0x67, 0xac, 0xf4, 0x91, 0xf6, 0xba, 0xfd
 };
 
+#define SATURNIN_TEST_BLOCKS 37
+
+/* Checks the multi-block kernels against single block encryption */
+static void test_saturnin_multi_block(void)
+{
+    static saturnin_key_schedule_t ks[SATURNIN_TEST_BLOCKS];
+    static unsigned char input[SATURNIN_TEST_BLOCKS * SATURNIN_BLOCK_SIZE];
+    static unsigned char output[SATURNIN_TEST_BLOCKS * SATURNIN_BLOCK_SIZE];
+    static unsigned char expected[SATURNIN_TEST_BLOCKS * SATURNIN_BLOCK_SIZE];
+    unsigned char key[32];
+    unsigned count, index, posn;
+    int ok = 1;
+
+    printf("    Multi-Block (%s) ... ", saturnin_multi_block_variant());
+    fflush(stdout);
+    for (index = 0; index < SATURNIN_TEST_BLOCKS; ++index) {
+        for (posn = 0; posn < 32; ++posn) {
+            key[posn] = (unsigned char)(saturnin_test_key[posn] + index);
+            input[index * 32 + posn] = (unsigned char)(index * 9 + posn);
+        }
+        saturnin_setup_key(&(ks[index]), key);
+    }
+    for (count = 1; count <= SATURNIN_TEST_BLOCKS; ++count) {
+        /* Same key for every block */
+        for (index = 0; index < count; ++index) {
+            saturnin_encrypt_block
+                (&(ks[0]), expected + index * 32, input + index * 32,
+                 SATURNIN_DOMAIN_10_1);
+        }
+        saturnin_encrypt_blocks
+            (&(ks[0]), output, input, count, SATURNIN_DOMAIN_10_1);
+        if (memcmp(output, expected, count * 32) != 0)
+            ok = 0;
+
+        /* Different key for every block, encrypted in-place */
+        for (index = 0; index < count; ++index) {
+            saturnin_encrypt_block
+                (&(ks[index]), expected + index * 32, input + index * 32,
+                 SATURNIN_DOMAIN_16_7);
+        }
+        memcpy(output, input, count * 32);
+        saturnin_encrypt_blocks_multi_key
+            (ks, output, output, count, SATURNIN_DOMAIN_16_7);
+        if (memcmp(output, expected, count * 32) != 0)
+            ok = 0;
+    }
+    if (!ok) {
+        printf("failed\n");
+        test_exit_result = 1;
+    } else {
+        printf("ok\n");
+    }
+}
+
+/* Checks the parallel CTR-Cascade mode against the serial version */
+static int test_saturnin_parallel_length
+    (unsigned long long mlen, unsigned threads)
+{
+    static unsigned char const nonce[16] = {
+        0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+        0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff
+    };
+    static unsigned char const ad[5] = {0x01, 0x02, 0x03, 0x04, 0x05};
+    unsigned char *plaintext = malloc(mlen);
+    unsigned char *expected = malloc(mlen + SATURNIN_TAG_SIZE);
+    unsigned char *actual = malloc(mlen + SATURNIN_TAG_SIZE);
+    unsigned long long posn, clen, len;
+    int ok = 1;
+    if (!plaintext || !expected || !actual) {
+        free(plaintext);
+        free(expected);
+        free(actual);
+        return 0;
+    }
+    for (posn = 0; posn < mlen; ++posn)
+        plaintext[posn] = (unsigned char)(posn * 7 + (posn >> 8));
+
+    /* Encrypt serially and in parallel and compare */
+    saturnin_aead_encrypt
+        (expected, &clen, plaintext, mlen, ad, sizeof(ad), 0,
+         nonce, saturnin_test_key);
+    memset(actual, 0xAA, mlen + SATURNIN_TAG_SIZE);
+    if (saturnin_aead_encrypt_parallel
+            (actual, &len, plaintext, mlen, ad, sizeof(ad), 0,
+             nonce, saturnin_test_key, threads) != 0 || len != clen ||
+            memcmp(actual, expected, clen) != 0)
+        ok = 0;
+
+    /* Encrypt in place */
+    memcpy(actual, plaintext, mlen);
+    if (saturnin_aead_encrypt_parallel
+            (actual, &len, actual, mlen, ad, sizeof(ad), 0,
+             nonce, saturnin_test_key, threads) != 0 || len != clen ||
+            memcmp(actual, expected, clen) != 0)
+        ok = 0;
+
+    /* Decrypt in place */
+    if (saturnin_aead_decrypt_parallel
+            (actual, &len, 0, actual, clen, ad, sizeof(ad),
+             nonce, saturnin_test_key, threads) != 0 || len != mlen ||
+            memcmp(actual, plaintext, mlen) != 0)
+        ok = 0;
+
+    /* Decrypt into a separate buffer with a corrupted tag */
+    expected[clen - 1] ^= 0x01;
+    if (saturnin_aead_decrypt_parallel
+            (actual, &len, 0, expected, clen, ad, sizeof(ad),
+             nonce, saturnin_test_key, threads) != -1)
+        ok = 0;
+
+    free(plaintext);
+    free(expected);
+    free(actual);
+    return ok;
+}
+
+static void test_saturnin_parallel(void)
+{
+    int ok = 1;
+    printf("    Parallel CTR-Cascade ... ");
+    fflush(stdout);
+    if (!test_saturnin_parallel_length(100, 4))
+        ok = 0;
+    if (!test_saturnin_parallel_length(3 * 16384 + 45, 4))
+        ok = 0;
+    if (!test_saturnin_parallel_length(5 * 16384, 3))
+        ok = 0;
+    if (!test_saturnin_parallel_length(9 * 16384 + 32, 16))
+        ok = 0;
+    if (!ok) {
+        printf("failed\n");
+        test_exit_result = 1;
+    } else {
+        printf("ok\n");
+    }
+}
+
 void test_saturnin(void)
 {
     saturnin_key_schedule_t ks;
@@ -82,5 +221,9 @@ void test_saturnin(void)
         printf("ok\n");
     }
 
+    test_saturnin_multi_block();
+    test_hash_batch(&saturnin_hash_algorithm, saturnin_hash_batch, 32);
+    test_saturnin_parallel();
+
     printf("\n");
 }
@@ -123,10 +123,68 @@ static block_cipher_t const skinny128_256_tk_full = {
     (block_cipher_decrypt_t)0
 };
 
+/* Number of blocks to test with; not a multiple of any kernel width */
+#define SKINNY128_TEST_BLOCKS 37
+
+static void test_skinny128_multi_block(void)
+{
+    static unsigned char tk1[SKINNY128_TEST_BLOCKS * 16];
+    static unsigned char input[SKINNY128_TEST_BLOCKS * 16];
+    static unsigned char output[SKINNY128_TEST_BLOCKS * 16];
+    static unsigned char expected[SKINNY128_TEST_BLOCKS * 16];
+    skinny_128_384_key_schedule_t ks384;
+    skinny_128_256_key_schedule_t ks256;
+    unsigned count, index;
+    int ok = 1;
+
+    printf("    Multi-Block (%s) ... ", skinny_128_multi_block_variant());
+    fflush(stdout);
+    skinny_128_384_init(&ks384, skinny128_384_1.key);
+    skinny_128_256_init(&ks256, skinny128_256_1.key);
+    for (index = 0; index < sizeof(input); ++index) {
+        input[index] = (unsigned char)(index * 7 + 3);
+        tk1[index] = (unsigned char)(index * 13 + 5);
+    }
+    for (count = 1; count <= SKINNY128_TEST_BLOCKS; ++count) {
+        /* SKINNY-128-384 with a different TK1 for every block */
+        for (index = 0; index < count; ++index) {
+            memcpy(ks384.TK1, tk1 + index * 16, 16);
+            skinny_128_384_encrypt
+                (&ks384, expected + index * 16, input + index * 16);
+        }
+        skinny_128_384_encrypt_blocks(&ks384, tk1, output, input, count);
+        if (memcmp(output, expected, count * 16) != 0)
+            ok = 0;
+        skinny_128_384_decrypt_blocks(&ks384, tk1, output, output, count);
+        if (memcmp(output, input, count * 16) != 0)
+            ok = 0;
+
+        /* SKINNY-128-256 with a different TK1 for every block */
+        for (index = 0; index < count; ++index) {
+            memcpy(ks256.TK1, tk1 + index * 16, 16);
+            skinny_128_256_encrypt
+                (&ks256, expected + index * 16, input + index * 16);
+        }
+        skinny_128_256_encrypt_blocks(&ks256, tk1, output, input, count);
+        if (memcmp(output, expected, count * 16) != 0)
+            ok = 0;
+        skinny_128_256_decrypt_blocks(&ks256, tk1, output, output, count);
+        if (memcmp(output, input, count * 16) != 0)
+            ok = 0;
+    }
+    if (!ok) {
+        printf("failed\n");
+        test_exit_result = 1;
+    } else {
+        printf("ok\n");
+    }
+}
+
 void test_skinny128(void)
 {
     test_block_cipher_start(&skinny128_256);
     test_block_cipher_128(&skinny128_256, &skinny128_256_1);
+    test_skinny128_multi_block();
     test_block_cipher_end(&skinny128_256);
 
     test_block_cipher_start(&skinny128_256_tk_full);
@@ -21,6 +21,7 @@
  */
 
 #include "internal-sparkle.h"
+#include "sparkle.h"
 #include "test-cipher.h"
 #include <stdio.h>
 #include <string.h>
@@ -75,6 +76,28 @@ static unsigned char const sparkle512_output[] = {
     0x46, 0xf1, 0xcc, 0xbd, 0xfb, 0x8d, 0x09, 0xf1
 };
 
+/* Single and multi-state wrappers for SPARKLE-384 and SPARKLE-512
+ * with a fixed number of steps */
+static void sparkle_384_1(void *state)
+{
+    sparkle_384((uint32_t *)state, 11);
+}
+
+static void sparkle_384_n_states(void *states, unsigned count)
+{
+    sparkle_384_n((uint32_t (*)[SPARKLE_384_STATE_SIZE])states, count, 11);
+}
+
+static void sparkle_512_1(void *state)
+{
+    sparkle_512((uint32_t *)state, 8);
+}
+
+static void sparkle_512_n_states(void *states, unsigned count)
+{
+    sparkle_512_n((uint32_t (*)[SPARKLE_512_STATE_SIZE])states, count, 8);
+}
+
 void test_sparkle(void)
 {
     uint32_t state256[SPARKLE_256_STATE_SIZE];
@@ -116,5 +139,16 @@ void test_sparkle(void)
         test_exit_result = 1;
     }
 
+    test_permute_multi_state
+        ("SPARKLE-384 Multi-State", sparkle_multi_variant(),
+         SPARKLE_384_STATE_SIZE * 4, sparkle_384_1, sparkle_384_n_states,
+         0, 0);
+    test_permute_multi_state
+        ("SPARKLE-512 Multi-State", sparkle_multi_variant(),
+         SPARKLE_512_STATE_SIZE * 4, sparkle_512_1, sparkle_512_n_states,
+         0, 0);
+    test_hash_batch(&esch_256_hash_algorithm, esch_256_hash_batch, 16);
+    test_hash_batch(&esch_384_hash_algorithm, esch_384_hash_batch, 16);
+
     printf("\n");
 }
@@ -47,6 +47,34 @@ static unsigned char const spongent176_output[] = {
     0xee, 0xd9, 0xe8, 0xd8, 0x66, 0x26
 };
 
+/* Single and multi-state wrappers for Spongent-pi.  The padding bytes
+ * of Spongent-pi[176] are cleared because they must be zero */
+static void spongent160_permute_1(void *state)
+{
+    spongent160_permute((spongent160_state_t *)state);
+}
+
+static void spongent160_permute_n_states(void *states, unsigned count)
+{
+    spongent160_permute_n((spongent160_state_t *)states, count);
+}
+
+static void spongent176_permute_1(void *state)
+{
+    spongent176_state_t *s = (spongent176_state_t *)state;
+    s->W[5] = 0;
+    spongent176_permute(s);
+}
+
+static void spongent176_permute_n_states(void *states, unsigned count)
+{
+    spongent176_state_t *s = (spongent176_state_t *)states;
+    unsigned index;
+    for (index = 0; index < count; ++index)
+        s[index].W[5] = 0;
+    spongent176_permute_n(s, count);
+}
+
 void test_spongent(void)
 {
     spongent160_state_t state160;
@@ -76,5 +104,14 @@ void test_spongent(void)
         test_exit_result = 1;
     }
 
+    test_permute_multi_state
+        ("Spongent-pi[160] Multi-State", spongent_multi_lane_variant(),
+         sizeof(spongent160_state_t), spongent160_permute_1,
+         spongent160_permute_n_states, 0, 0);
+    test_permute_multi_state
+        ("Spongent-pi[176] Multi-State", spongent_multi_lane_variant(),
+         sizeof(spongent176_state_t), spongent176_permute_1,
+         spongent176_permute_n_states, 0, 0);
+
     printf("\n");
 }
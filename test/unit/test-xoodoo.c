@@ -22,6 +22,7 @@
 
 #include "internal-xoodoo.h"
 #include "internal-xoodoo-m.h"
+#include "xoodyak.h"
 #include "test-cipher.h"
 #include <stdio.h>
 #include <string.h>
@@ -61,6 +62,26 @@ static void test_xoodoo_permutation(void)
     }
 }
 
+static void xoodoo_permute_1(void *state)
+{
+    xoodoo_permute((xoodoo_state_t *)state);
+}
+
+static void xoodoo_permute_n_states(void *states, unsigned count)
+{
+    xoodoo_permute_n((xoodoo_state_t *)states, count);
+}
+
+static void xoodoo_permute_4(void *states)
+{
+    xoodoo_permute_x4((xoodoo_state_t *)states);
+}
+
+static void xoodoo_permute_8(void *states)
+{
+    xoodoo_permute_x8((xoodoo_state_t *)states);
+}
+
 static void test_xoodoo_masked_permutation(void)
 {
     mask_uint32_t masked[12];
@@ -85,6 +106,11 @@ void test_xoodoo(void)
 {
     printf("Xoodoo:\n");
     test_xoodoo_permutation();
+    test_permute_multi_state
+        ("Multi-State", xoodoo_multi_variant(), sizeof(xoodoo_state_t),
+         xoodoo_permute_1, xoodoo_permute_n_states, xoodoo_permute_4,
+         xoodoo_permute_8);
+    test_hash_batch(&xoodyak_hash_algorithm, xoodyak_hash_batch, 16);
     test_xoodoo_masked_permutation();
     printf("\n");
 }